@@ -0,0 +1,68 @@
+// Global operator new replacement counting heap allocations for bench::suite
+// Linked into every benchmark executable; deallocation is not counted.
+
+#include "bench.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocations { 0 };
+
+void* allocate(std::size_t size, std::size_t alignment = 0) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(size == 0) size = 1;
+    void* p = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1))
+                                                    : std::malloc(size);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+void* try_allocate(std::size_t size, std::size_t alignment = 0) noexcept {
+    try {
+        return allocate(size, alignment);
+    } catch(...) {
+        return nullptr;
+    }
+}
+
+}  // namespace
+
+namespace asyncle::bench {
+
+uint64_t allocation_count() noexcept { return allocations.load(std::memory_order_relaxed); }
+
+}  // namespace asyncle::bench
+
+void* operator new(std::size_t size) { return allocate(size); }
+
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return try_allocate(size); }
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return try_allocate(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,212 @@
+#ifndef ASYNCLE_BENCH_BENCH_HPP
+#define ASYNCLE_BENCH_BENCH_HPP
+
+// Minimal benchmark harness shared by the bench/ executables
+//
+// Each case runs op() in batches sized so that one batch takes about
+// min_time / samples; the median batch gives ns/op and, with bytes_per_op,
+// GB/s. Heap allocations are counted by the operator new replacement in
+// alloc_counter.cpp and reported per op.
+//
+// Command line (every bench executable):
+//   --filter=<substring>      Run only matching cases
+//   --format=table|csv|json   Output format (default table)
+//   --min-time=<ms>           Time budget per case (default 200)
+//   --<key>=<value>           Suite-specific settings, read with suite::value()
+//
+// Usage:
+//   asyncle::bench::suite suite("format.json", argc, argv);
+//   suite.run("small/parse", message.size(), [&] { ... });
+//   return suite.finish();
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace asyncle::bench {
+
+// Heap allocations made by this process so far (alloc_counter.cpp)
+uint64_t allocation_count() noexcept;
+
+// Keep a value observable so the optimizer cannot drop the work producing it
+template <typename T>
+inline void do_not_optimize(T const& value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+enum class output_format { table, csv, json };
+
+struct options {
+    std::string                   filter;
+    output_format                 format      = output_format::table;
+    double                        min_time_ms = 200;
+    std::vector<std::string_view> args;  // Every argument, for suite-specific --key=value settings
+};
+
+inline options parse_options(int argc, char** argv) {
+    options out;
+    for(int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        out.args.push_back(arg);
+        if(arg.starts_with("--filter=")) {
+            out.filter = arg.substr(9);
+        } else if(arg == "--format=csv") {
+            out.format = output_format::csv;
+        } else if(arg == "--format=json") {
+            out.format = output_format::json;
+        } else if(arg.starts_with("--min-time=")) {
+            out.min_time_ms = std::strtod(argv[i] + 11, nullptr);
+        }
+    }
+    return out;
+}
+
+struct measurement {
+    std::string name;
+    uint64_t    bytes_per_op  = 0;
+    uint64_t    iterations    = 0;  // Ops timed across all samples
+    double      ns_per_op     = 0;  // Median sample
+    double      gb_per_s      = 0;  // 0 when bytes_per_op is 0
+    double      allocs_per_op = 0;
+};
+
+class suite {
+    static constexpr int samples = 5;
+
+    std::string              name_;
+    options                  options_;
+    std::vector<measurement> results_;
+    std::vector<std::string> context_;  // "key", "value" pairs describing the build or host
+    bool                     header_printed_ = false;
+
+    public:
+    suite(std::string name, int argc, char** argv): name_(std::move(name)), options_(parse_options(argc, argv)) {}
+
+    const options& config() const noexcept { return options_; }
+
+    bool selected(std::string_view name) const noexcept {
+        return options_.filter.empty() || name.find(options_.filter) != std::string_view::npos;
+    }
+
+    // Value of a suite-specific --key=value argument, or fallback when absent
+    std::string_view value(std::string_view key, std::string_view fallback = {}) const noexcept {
+        for(std::string_view arg : options_.args) {
+            if(arg.size() >= key.size() + 3 && arg.starts_with("--") && arg.substr(2, key.size()) == key
+               && arg[key.size() + 2] == '=') {
+                return arg.substr(key.size() + 3);
+            }
+        }
+        return fallback;
+    }
+
+    // Describe the configuration results depend on (kernel, implementation, flags)
+    void context(std::string key, std::string value) {
+        context_.push_back(std::move(key));
+        context_.push_back(std::move(value));
+    }
+
+    // Time op; bytes_per_op is the input or output size one call processes
+    template <typename Op>
+    void run(std::string_view name, uint64_t bytes_per_op, Op&& op) {
+        if(!selected(name)) return;
+        using clock = std::chrono::steady_clock;
+
+        // Warm caches and pools, then grow the batch until one takes a sample's share of the budget
+        op();
+        double   target = options_.min_time_ms * 1e6 / samples;
+        uint64_t batch  = 1;
+        for(;;) {
+            auto start = clock::now();
+            for(uint64_t i = 0; i < batch; ++i) { op(); }
+            double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            if(elapsed >= target || batch >= (uint64_t { 1 } << 30)) break;
+            batch = elapsed <= 0 ? batch * 10 : std::max(batch * 2, static_cast<uint64_t>(batch * target / elapsed));
+        }
+
+        double   per_op[samples];
+        uint64_t allocations = allocation_count();
+        for(double& sample : per_op) {
+            auto start = clock::now();
+            for(uint64_t i = 0; i < batch; ++i) { op(); }
+            sample = std::chrono::duration<double, std::nano>(clock::now() - start).count() / static_cast<double>(batch);
+        }
+        allocations = allocation_count() - allocations;
+        std::sort(per_op, per_op + samples);
+
+        measurement m;
+        m.name          = std::string(name);
+        m.bytes_per_op  = bytes_per_op;
+        m.iterations    = batch * samples;
+        m.ns_per_op     = per_op[samples / 2];
+        m.gb_per_s      = bytes_per_op ? static_cast<double>(bytes_per_op) / m.ns_per_op : 0;
+        m.allocs_per_op = static_cast<double>(allocations) / static_cast<double>(m.iterations);
+        results_.push_back(std::move(m));
+        if(options_.format == output_format::table) print_row(results_.back());
+    }
+
+    // Record a case that cannot run in this build
+    void skip(std::string_view name, std::string_view reason) {
+        if(selected(name) && options_.format == output_format::table) {
+            print_header();
+            std::printf("%-40.*s skipped: %.*s\n", static_cast<int>(name.size()), name.data(),
+                        static_cast<int>(reason.size()), reason.data());
+        }
+    }
+
+    const std::vector<measurement>& results() const noexcept { return results_; }
+
+    // Print csv/json output; returns the process exit code
+    int finish() const {
+        if(options_.format == output_format::csv) {
+            std::printf("suite,name,bytes_per_op,iterations,ns_per_op,gb_per_s,allocs_per_op\n");
+            for(auto const& m : results_) {
+                std::printf("%s,%s,%llu,%llu,%.3f,%.4f,%.3f\n", name_.c_str(), m.name.c_str(),
+                            static_cast<unsigned long long>(m.bytes_per_op),
+                            static_cast<unsigned long long>(m.iterations), m.ns_per_op, m.gb_per_s, m.allocs_per_op);
+            }
+        } else if(options_.format == output_format::json) {
+            std::printf("{\"suite\": \"%s\", \"context\": {", name_.c_str());
+            for(size_t i = 0; i < context_.size(); i += 2) {
+                std::printf("%s\"%s\": \"%s\"", i ? ", " : "", context_[i].c_str(), context_[i + 1].c_str());
+            }
+            std::printf("}, \"results\": [");
+            for(size_t i = 0; i < results_.size(); ++i) {
+                auto const& m = results_[i];
+                std::printf("%s\n  {\"name\": \"%s\", \"bytes_per_op\": %llu, \"iterations\": %llu, "
+                            "\"ns_per_op\": %.3f, \"gb_per_s\": %.4f, \"allocs_per_op\": %.3f}",
+                            i ? "," : "", m.name.c_str(), static_cast<unsigned long long>(m.bytes_per_op),
+                            static_cast<unsigned long long>(m.iterations), m.ns_per_op, m.gb_per_s, m.allocs_per_op);
+            }
+            std::printf("\n]}\n");
+        }
+        return 0;
+    }
+
+    private:
+    void print_header() {
+        if(header_printed_) return;
+        header_printed_ = true;
+        std::printf("== %s ==\n", name_.c_str());
+        for(size_t i = 0; i < context_.size(); i += 2) {
+            std::printf("# %s: %s\n", context_[i].c_str(), context_[i + 1].c_str());
+        }
+        std::printf("%-40s %12s %10s %12s\n", "case", "ns/op", "GB/s", "allocs/op");
+    }
+
+    void print_row(measurement const& m) {
+        print_header();
+        std::printf("%-40s %12.1f %10.3f %12.2f\n", m.name.c_str(), m.ns_per_op, m.gb_per_s, m.allocs_per_op);
+    }
+};
+
+}  // namespace asyncle::bench
+
+#endif  // ASYNCLE_BENCH_BENCH_HPP
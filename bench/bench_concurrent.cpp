@@ -0,0 +1,293 @@
+// asyncle::concurrent queue and pool costs across thread counts: messages
+// through an spsc_ring (one push/take at a time and in batches, one producer
+// and one consumer thread) and through an mpmc_queue with N producers and N
+// consumers, the round trip from work_stealing_pool::submit() to the task
+// running for each worker count, and the time to drain a burst of small tasks.
+// timers/* compare a mutex-guarded std::priority_queue of deadlines (cancel
+// marks an entry, which is dropped when it surfaces) with io::timer_wheel.
+// The regression runner (scripts/bench-compare.py) runs this suite in CI, so
+// case names are stable: add cases, do not rename them.
+//
+// Each queue op moves 65536 16-byte messages, so items/s = 65536e9 / ns_per_op;
+// thread start-up is included. Consumers yield when the queue is empty, so
+// with fewer CPUs than threads the cases measure hand-offs, not scaling.
+// A timer op schedules 4096 deadlines spread over ~4 s of 1 ms ticks, then
+// cancels them all (operations finishing in time) or fires them all.
+//
+// Suite settings:
+//   --sweep=<n,n,...>   Producer/consumer pairs and pool workers to run (default 1,2,4)
+
+#include "bench.hpp"
+#include <asyncle/concurrent/mpmc_queue.hpp>
+#include <asyncle/concurrent/spsc_ring.hpp>
+#include <asyncle/concurrent/thread_pool.hpp>
+#include <asyncle/io/timer_wheel.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct message {
+    uint64_t sequence;
+    uint64_t payload;
+};
+
+constexpr uint64_t items = uint64_t { 1 } << 16;
+
+std::vector<size_t> parse_counts(std::string_view list) {
+    std::vector<size_t> counts;
+    while(!list.empty()) {
+        size_t      comma = list.find(',');
+        std::string item(list.substr(0, comma));
+        if(size_t n = std::strtoull(item.c_str(), nullptr, 10); n > 0) counts.push_back(n);
+        list = comma == std::string_view::npos ? std::string_view {} : list.substr(comma + 1);
+    }
+    if(counts.empty()) counts = { 1, 2, 4 };
+    return counts;
+}
+
+void run_spsc(asyncle::bench::suite& suite) {
+    asyncle::concurrent::spsc_ring<message, 4096> ring;
+
+    suite.run("queue/spsc/push_take/threads=2", items * sizeof(message), [&] {
+        std::thread producer([&] {
+            for(uint64_t i = 0; i < items;) {
+                if(ring.push(message { i, i })) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        uint64_t sum = 0;
+        message  m {};
+        for(uint64_t got = 0; got < items;) {
+            if(ring.take(m)) {
+                sum += m.sequence;
+                ++got;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        asyncle::bench::do_not_optimize(sum);
+    });
+
+    suite.run("queue/spsc/batch_64/threads=2", items * sizeof(message), [&] {
+        std::thread producer([&] {
+            message batch[64];
+            for(uint64_t i = 0; i < items;) {
+                for(uint64_t j = 0; j < 64; ++j) batch[j] = message { i + j, i + j };
+                size_t sent = 0;
+                while(sent < 64) {
+                    size_t n = ring.push_batch(std::span<const message>(batch).subspan(sent));
+                    if(n == 0) std::this_thread::yield();
+                    sent += n;
+                }
+                i += 64;
+            }
+        });
+        uint64_t sum = 0;
+        message  batch[64];
+        for(uint64_t got = 0; got < items;) {
+            size_t n = ring.take_batch(batch);
+            if(n == 0) std::this_thread::yield();
+            for(size_t j = 0; j < n; ++j) sum += batch[j].sequence;
+            got += n;
+        }
+        producer.join();
+        asyncle::bench::do_not_optimize(sum);
+    });
+}
+
+// pairs producers and pairs consumers; items are split evenly between producers
+void run_mpmc(asyncle::bench::suite& suite, const std::vector<size_t>& counts) {
+    asyncle::concurrent::mpmc_queue<message, 4096> queue;
+
+    for(size_t pairs : counts) {
+        suite.run("queue/mpmc/push_take/pairs=" + std::to_string(pairs), items * sizeof(message), [&] {
+            std::atomic<uint64_t>    taken { 0 };
+            std::atomic<uint64_t>    sink { 0 };
+            std::vector<std::thread> threads;
+            const uint64_t           share = items / pairs;
+            for(size_t p = 0; p < pairs; ++p) {
+                uint64_t first = p * share;
+                uint64_t last  = p + 1 == pairs ? items : first + share;
+                threads.emplace_back([&queue, first, last] {
+                    for(uint64_t i = first; i < last;) {
+                        if(queue.push(message { i, i })) {
+                            ++i;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+            for(size_t c = 0; c < pairs; ++c) {
+                threads.emplace_back([&] {
+                    uint64_t sum = 0;
+                    message  m {};
+                    while(taken.load(std::memory_order_relaxed) < items) {
+                        if(queue.take(m)) {
+                            sum += m.sequence;
+                            taken.fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                    sink.fetch_add(sum, std::memory_order_relaxed);
+                });
+            }
+            for(auto& t : threads) t.join();
+            asyncle::bench::do_not_optimize(sink.load());
+        });
+    }
+}
+
+// submit_latency: one op submits a task and waits for it to run, so ns/op is
+// the wake-up plus hand-off cost. drain_1000: 1000 empty tasks, then wait_idle()
+void run_pool(asyncle::bench::suite& suite, const std::vector<size_t>& counts) {
+    for(size_t workers : counts) {
+        asyncle::concurrent::work_stealing_pool pool({ .workers = workers });
+        const std::string                       suffix = "/workers=" + std::to_string(pool.worker_count());
+
+        std::atomic<uint32_t> done { 0 };
+        suite.run("pool/submit_latency" + suffix, 0, [&] {
+            uint32_t before = done.load(std::memory_order_relaxed);
+            auto     queued = pool.submit([&done] {
+                done.fetch_add(1, std::memory_order_release);
+                done.notify_one();
+            });
+            if(!queued) return;
+            done.wait(before, std::memory_order_acquire);
+        });
+
+        std::atomic<uint64_t> ran { 0 };
+        suite.run("pool/drain_1000" + suffix, 0, [&] {
+            for(int i = 0; i < 1000; ++i) {
+                if(!pool.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); })) {
+                    ran.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            pool.wait_idle();
+        });
+        asyncle::bench::do_not_optimize(ran.load());
+    }
+}
+
+constexpr size_t timer_count = 4096;
+
+struct heap_timer {
+    uint64_t tick;
+    uint32_t id;
+
+    bool operator>(const heap_timer& other) const noexcept { return tick > other.tick; }
+};
+
+// The usual shared timer: one lock around a heap; cancelled ids are skipped when popped
+class locked_timer_queue {
+    std::mutex                                                               lock_;
+    std::priority_queue<heap_timer, std::vector<heap_timer>, std::greater<>> heap_;
+    std::vector<uint8_t>                                                     cancelled_;
+
+    public:
+    explicit locked_timer_queue(size_t ids): cancelled_(ids) {}
+
+    void schedule(uint32_t id, uint64_t tick) {
+        std::lock_guard guard(lock_);
+        cancelled_[id] = 0;
+        heap_.push(heap_timer { tick, id });
+    }
+
+    void cancel(uint32_t id) {
+        std::lock_guard guard(lock_);
+        cancelled_[id] = 1;
+    }
+
+    template <typename F>
+    size_t advance(uint64_t now, F&& fire) {
+        size_t          fired = 0;
+        std::lock_guard guard(lock_);
+        while(!heap_.empty() && heap_.top().tick <= now) {
+            uint32_t id = heap_.top().id;
+            heap_.pop();
+            if(!cancelled_[id]) {
+                fire(id);
+                ++fired;
+            }
+        }
+        return fired;
+    }
+};
+
+struct wheel_timer: asyncle::io::timer_node {
+    uint32_t id = 0;
+};
+
+void run_timers(asyncle::bench::suite& suite) {
+    std::vector<uint64_t> ticks(timer_count);
+    uint64_t              x = 0x9e3779b97f4a7c15ull;
+    for(auto& t : ticks) {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        t = 1 + x % 4096;
+    }
+    const uint64_t horizon = 4097;
+
+    uint64_t           base = 0;
+    locked_timer_queue heap(timer_count);
+    suite.run("timers/priority_queue_mutex/schedule_cancel/n=4096", 0, [&] {
+        for(uint32_t i = 0; i < timer_count; ++i) heap.schedule(i, base + ticks[i]);
+        for(uint32_t i = 0; i < timer_count; ++i) heap.cancel(i);
+        base += horizon;
+        heap.advance(base, [](uint32_t) {});  // Drop the cancelled entries
+    });
+    suite.run("timers/priority_queue_mutex/schedule_fire/n=4096", 0, [&] {
+        for(uint32_t i = 0; i < timer_count; ++i) heap.schedule(i, base + ticks[i]);
+        uint64_t sum = 0;
+        base += horizon;
+        heap.advance(base, [&](uint32_t id) { sum += id; });
+        asyncle::bench::do_not_optimize(sum);
+    });
+
+    asyncle::io::timer_wheel wheel;
+    std::vector<wheel_timer> nodes(timer_count);
+    for(uint32_t i = 0; i < timer_count; ++i) nodes[i].id = i;
+    suite.run("timers/timer_wheel/schedule_cancel/n=4096", 0, [&] {
+        const uint64_t now = wheel.now();
+        for(uint32_t i = 0; i < timer_count; ++i) wheel.schedule(nodes[i], now + ticks[i]);
+        for(auto& node : nodes) wheel.cancel(node);
+        wheel.advance(now + horizon, [](asyncle::io::timer_node&) {});
+    });
+    suite.run("timers/timer_wheel/schedule_fire/n=4096", 0, [&] {
+        const uint64_t now = wheel.now();
+        for(uint32_t i = 0; i < timer_count; ++i) wheel.schedule(nodes[i], now + ticks[i]);
+        uint64_t sum = 0;
+        wheel.advance(now + horizon, [&](asyncle::io::timer_node& n) { sum += static_cast<wheel_timer&>(n).id; });
+        asyncle::bench::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("concurrent", argc, argv);
+
+    const auto counts = parse_counts(suite.value("sweep", "1,2,4"));
+    suite.context("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+    suite.context("items_per_op", std::to_string(items));
+
+    run_spsc(suite);
+    run_mpmc(suite, counts);
+    run_pool(suite, counts);
+    run_timers(suite);
+    return suite.finish();
+}
@@ -0,0 +1,86 @@
+// format::csv throughput over a 32 MiB table with some quoted fields: a
+// byte-at-a-time state machine as the baseline, the bitmask tokenizer with the
+// scalar and the SIMD kernel, binding rows to a struct, and binding across a
+// work_stealing_pool with parse_parallel (--workers=N, default 4).
+
+#include "bench.hpp"
+#include <asyncle/format/csv.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+namespace csv = asyncle::format::csv;
+
+struct order {
+    int64_t          id;
+    std::string_view customer;
+    double           amount;
+    int32_t          quantity;
+    std::string_view note;
+};
+
+std::string make_table(size_t bytes) {
+    std::string out;
+    out.reserve(bytes + 256);
+    for(int64_t i = 0; out.size() < bytes; ++i) {
+        out += std::to_string(i);
+        out += i % 5 == 0 ? ",\"Smith, J\"," : ",customer-42,";
+        out += std::to_string(i % 1000) + ".25,";
+        out += std::to_string(i % 17);
+        out += i % 11 == 0 ? ",\"multi\nline \"\"note\"\"\"\n" : ",ok\n";
+    }
+    return out;
+}
+
+// Byte-at-a-time RFC 4180 field splitting: the usual hand-written loop
+size_t naive_fields(std::string_view text) {
+    size_t fields = 0;
+    bool   quoted = false;
+    for(char c : text) {
+        if(c == '"') {
+            quoted = !quoted;
+        } else if(!quoted && (c == ',' || c == '\n')) {
+            ++fields;
+        }
+    }
+    return fields;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("format.csv", argc, argv);
+
+    const std::string text  = make_table(size_t { 32 } << 20);
+    const uint64_t    bytes = text.size();
+    suite.context("kernel", csv::kernel_name());
+
+    suite.run("csv/naive_split", bytes, [&] { asyncle::bench::do_not_optimize(naive_fields(text)); });
+
+    csv::field_index rows;
+    suite.run("csv/tokenize/scalar", bytes, [&] {
+        asyncle::bench::do_not_optimize(rows.assign(text, {}, ::format::csv::detail::scalar_table));
+    });
+    suite.run(std::string("csv/tokenize/") + csv::kernel_name(), bytes, [&] {
+        asyncle::bench::do_not_optimize(csv::tokenize(text, rows));
+    });
+
+    std::vector<order> orders;
+    suite.run("csv/load_rows", bytes, [&] {
+        orders.clear();
+        asyncle::bench::do_not_optimize(csv::load_rows(text, orders));
+    });
+
+    const size_t workers = std::strtoull(std::string(suite.value("workers", "4")).c_str(), nullptr, 10);
+    asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = workers });
+    suite.context("workers", std::to_string(pool.worker_count()));
+    suite.run("csv/load_parallel", bytes, [&] {
+        asyncle::bench::do_not_optimize(csv::load_parallel<order>(text, pool));
+    });
+
+    return suite.finish();
+}
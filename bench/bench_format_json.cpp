@@ -0,0 +1,257 @@
+// format::json parsing throughput over three corpora: small messages, one large
+// array, and NDJSON. Each case parses and touches a few fields of every record,
+// since on-demand parsing does no work for values that are never read. The
+// dom/* cases (built-in, no backend) patch a mutable_document and write it
+// back by splicing unchanged spans or by writing every value again.
+
+#include "bench.hpp"
+#include <cstdint>
+#include <cstring>
+#include <format/json.hpp>
+#include <format/json/dom.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+std::string small_message() {
+    return R"({"id": 48213, "ts": 1700000000123, "user": {"name": "alice", "roles": ["admin", "ops"]},)"
+           R"( "route": {"tenant": "acme", "shard": 7, "region": "eu-west"},)"
+           R"( "payload": "aGVsbG8gd29ybGQgaGVsbG8gd29ybGQgaGVsbG8gd29ybGQ=", "trace": false})";
+}
+
+std::string large_array(int count) {
+    std::string out = "[";
+    for(int i = 0; i < count; ++i) {
+        if(i) out += ",\n";
+        out += R"({"id": )" + std::to_string(i) + R"(, "price": )" + std::to_string(i * 0.25)
+             + R"(, "name": "item-)" + std::to_string(i) + R"(", "tags": ["new", "sale"], "stock": )"
+             + std::to_string(i % 97) + "}";
+    }
+    return out + "]";
+}
+
+// Writes every value again, as a full-struct save would, for comparison with splicing
+void rewrite(format::json::dom_value value, std::string& out) {
+    using format::json::dom_type;
+    switch(value.type()) {
+    case dom_type::null   : out += "null"; break;
+    case dom_type::boolean: out += value.get_bool().value() ? "true" : "false"; break;
+    case dom_type::number : out += value.get_number_text().value(); break;
+    case dom_type::string :
+        out += '"';
+        out += value.get_string().value();
+        out += '"';
+        break;
+    case dom_type::array :
+    case dom_type::object: {
+        const bool object = value.is_object();
+        out += object ? '{' : '[';
+        bool first = true;
+        for(auto child : value) {
+            if(!std::exchange(first, false)) out += ',';
+            if(object) {
+                out += '"';
+                out += child.key();
+                out += "\":";
+            }
+            rewrite(child, out);
+        }
+        out += object ? '}' : ']';
+    }
+    }
+}
+
+// Parse, patch one or two fields, and write back: spliced versus rewritten,
+// with the document (and its chunks) reused or made per message
+void run_dom(asyncle::bench::suite& suite, const std::string& small, const std::string& large) {
+    format::json::mutable_document doc;
+    std::string                    out;
+    auto patch_small = [&] { (void)doc.root()["route"]["shard"].set_int64(9); };
+    auto patch_large = [&] {
+        (void)doc.root().at(100)["price"].set_double(99.5);
+        (void)doc.root().at(15000)["stock"].set_int64(0);
+    };
+    for(bool splice : { true, false }) {
+        const std::string mode = splice ? "patch_splice" : "patch_rewrite";
+        suite.run("dom/small/" + mode, small.size(), [&] {
+            (void)doc.parse(small);
+            patch_small();
+            out.clear();
+            if(splice) (void)doc.serialize(out);
+            else rewrite(doc.root(), out);
+            asyncle::bench::do_not_optimize(out.size());
+        });
+        suite.run("dom/large_array/" + mode, large.size(), [&] {
+            (void)doc.parse(large);
+            patch_large();
+            out.clear();
+            if(splice) (void)doc.serialize(out);
+            else rewrite(doc.root(), out);
+            asyncle::bench::do_not_optimize(out.size());
+        });
+    }
+    suite.run("dom/small/document_per_message", small.size(), [&] {
+        format::json::mutable_document fresh(small);
+        (void)fresh.root()["route"]["shard"].set_int64(9);
+        asyncle::bench::do_not_optimize(fresh.serialize());
+    });
+}
+
+}  // namespace
+
+#ifdef FORMAT_HAS_SIMDJSON
+
+namespace {
+
+std::string ndjson(int count) {
+    std::string out;
+    auto        message = small_message();
+    for(int i = 0; i < count; ++i) {
+        out += message;
+        out += '\n';
+    }
+    return out;
+}
+
+// Copy text into a buffer followed by input_padding bytes of slack
+struct padded_copy {
+    std::unique_ptr<char[]> data;
+    size_t                  length;
+
+    explicit padded_copy(std::string_view text):
+        data(new char[text.size() + format::json::input_padding]()),
+        length(text.size()) {
+        std::memcpy(data.get(), text.data(), text.size());
+    }
+
+    format::json::padded_input input() const noexcept {
+        return { data.get(), length, length + format::json::input_padding };
+    }
+};
+
+struct route_fields {
+    int64_t          id    = 0;
+    int64_t          shard = 0;
+    std::string_view tenant;
+};
+
+template <typename Document>
+int64_t read_message(Document& doc) {
+    int64_t id    = doc["id"].get_int64().value();
+    int64_t shard = doc["route"]["shard"].get_int64().value();
+    return id + shard;
+}
+
+template <typename Document>
+double sum_array(Document& doc) {
+    double total = 0;
+    for(auto item : doc.get_array()) {
+        simdjson::ondemand::object object = item.get_object().value();
+        total += static_cast<double>(object["id"].get_int64().value()) + object["price"].get_double().value();
+    }
+    return total;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("format.json", argc, argv);
+    // On-demand parsing runs the kernel selected at compile time: "fallback" without -march
+    suite.context("simdjson", SIMDJSON_VERSION);
+    suite.context("ondemand_kernel", simdjson::builtin_implementation()->name());
+
+    const std::string small   = small_message();
+    const std::string large   = large_array(20000);
+    const std::string records = ndjson(20000);
+    run_dom(suite, small, large);
+    padded_copy       small_padded(small);
+    padded_copy       large_padded(large);
+    padded_copy       records_padded(records);
+
+    format::json::parser_pool pool;
+
+    // Small messages: per-call parser vs pooled parsers
+    suite.run("small/parse_copy", small.size(), [&] {
+        auto doc      = format::json::parse(small);
+        auto document = doc.iterate().value();
+        asyncle::bench::do_not_optimize(read_message(document));
+    });
+    suite.run("small/parse_in_place", small.size(), [&] {
+        auto doc      = format::json::parse(small_padded.input());
+        auto document = doc.iterate().value();
+        asyncle::bench::do_not_optimize(read_message(document));
+    });
+    suite.run("small/pool_acquire_per_message", small.size(), [&] {
+        auto lease    = pool.acquire();
+        auto document = lease.iterate(small).value();
+        asyncle::bench::do_not_optimize(read_message(document));
+    });
+    {
+        auto lease = pool.acquire();
+        suite.run("small/pool_lease_held", small.size(), [&] {
+            auto document = lease.iterate(small).value();
+            asyncle::bench::do_not_optimize(read_message(document));
+        });
+        suite.run("small/extract_pointers", small.size(), [&] {
+            using format::json::field;
+            route_fields out;
+            auto         found = format::json::extract<field<"/id", &route_fields::id>,
+                                                       field<"/route/tenant", &route_fields::tenant>,
+                                                       field<"/route/shard", &route_fields::shard>>(lease, small, out);
+            asyncle::bench::do_not_optimize(found);
+            asyncle::bench::do_not_optimize(out.shard);
+        });
+    }
+
+    // One large array of objects
+    suite.run("large_array/parse_copy", large.size(), [&] {
+        auto doc      = format::json::parse(large);
+        auto document = doc.iterate().value();
+        asyncle::bench::do_not_optimize(sum_array(document));
+    });
+    suite.run("large_array/parse_in_place", large.size(), [&] {
+        auto doc      = format::json::parse(large_padded.input());
+        auto document = doc.iterate().value();
+        asyncle::bench::do_not_optimize(sum_array(document));
+    });
+    {
+        auto lease = pool.acquire();
+        suite.run("large_array/pool_lease_held", large.size(), [&] {
+            auto document = lease.iterate(large).value();
+            asyncle::bench::do_not_optimize(sum_array(document));
+        });
+    }
+
+    // NDJSON: chunked streaming vs one in-place pass
+    format::json::document_stream stream;
+    auto                          on_record = [](auto& doc) { asyncle::bench::do_not_optimize(read_message(doc)); };
+    suite.run("ndjson/document_stream_1MiB_chunks", records.size(), [&] {
+        constexpr size_t chunk = size_t { 1 } << 20;
+        for(size_t offset = 0; offset < records.size(); offset += chunk) {
+            stream.feed(std::string_view(records).substr(offset, chunk), on_record);
+        }
+        stream.finish(on_record);
+    });
+    {
+        auto lease = pool.acquire();
+        suite.run("ndjson/for_each_document_in_place", records.size(), [&] {
+            lease.for_each_document(records_padded.input(), on_record);
+        });
+    }
+
+    return suite.finish();
+}
+
+#else
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("format.json", argc, argv);
+    run_dom(suite, small_message(), large_array(20000));
+    suite.skip("format.json/simdjson", "built without simdjson (FORMAT_ENABLE_SIMDJSON=ON)");
+    return suite.finish();
+}
+
+#endif  // FORMAT_HAS_SIMDJSON
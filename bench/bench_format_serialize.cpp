@@ -0,0 +1,205 @@
+// format::serialize save/load throughput for json_tag and beve_tag, over one
+// small message and a large batch, comparing fresh results with save_into into
+// reused buffers. The schema JSON serializer runs with or without Glaze,
+// against a hand-written std::string builder as the baseline.
+
+#include "bench.hpp"
+#include <cstdint>
+#include <format/serialize.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct route {
+    std::string tenant;
+    int32_t     shard;
+    std::string region;
+};
+
+struct message {
+    int64_t                  id;
+    int64_t                  ts;
+    std::string              user;
+    std::vector<std::string> roles;
+    route                    target;
+    std::vector<double>      samples;
+    bool                     trace;
+};
+
+struct batch {
+    std::vector<message> messages;
+};
+
+}  // namespace
+
+// The same layout for the schema serializer; message itself stays with Glaze
+template <>
+struct format::serialize::json_schema_for<route> {
+    using type = json_fields<json_field<"tenant", &route::tenant>,
+                             json_field<"shard", &route::shard>,
+                             json_field<"region", &route::region>>;
+};
+
+namespace {
+
+struct schema_message: message {
+    using json_schema = format::serialize::json_fields<
+      format::serialize::json_field<"id", &message::id>,
+      format::serialize::json_field<"ts", &message::ts>,
+      format::serialize::json_field<"user", &message::user>,
+      format::serialize::json_field<"roles", &message::roles>,
+      format::serialize::json_field<"target", &message::target>,
+      format::serialize::json_field<"samples", &message::samples>,
+      format::serialize::json_field<"trace", &message::trace>>;
+};
+
+struct schema_batch {
+    std::vector<schema_message> messages;
+
+    using json_schema =
+      format::serialize::json_fields<format::serialize::json_field<"messages", &schema_batch::messages>>;
+};
+
+// Baseline: append with std::to_string and a byte-at-a-time escape
+void naive_string(std::string& out, const std::string& s) {
+    out += '"';
+    for(char c : s) {
+        if(c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+void naive_message(std::string& out, const message& m) {
+    out += "{\"id\":" + std::to_string(m.id) + ",\"ts\":" + std::to_string(m.ts) + ",\"user\":";
+    naive_string(out, m.user);
+    out += ",\"roles\":[";
+    for(size_t i = 0; i < m.roles.size(); ++i) {
+        if(i) out += ',';
+        naive_string(out, m.roles[i]);
+    }
+    out += "],\"target\":{\"tenant\":";
+    naive_string(out, m.target.tenant);
+    out += ",\"shard\":" + std::to_string(m.target.shard) + ",\"region\":";
+    naive_string(out, m.target.region);
+    out += "},\"samples\":[";
+    for(size_t i = 0; i < m.samples.size(); ++i) {
+        if(i) out += ',';
+        out += std::to_string(m.samples[i]);
+    }
+    out += "],\"trace\":";
+    out += m.trace ? "true}" : "false}";
+}
+
+message make_message(int64_t i) {
+    return message { i,
+                     1700000000123 + i,
+                     "user-" + std::to_string(i),
+                     { "admin", "ops" },
+                     route { "acme", static_cast<int32_t>(i % 16), "eu-west" },
+                     { 0.5 * i, 1.5, 2.25, 3.0 },
+                     (i & 1) != 0 };
+}
+
+template <typename T>
+void run_schema(asyncle::bench::suite& suite, std::string_view corpus, T const& value, auto&& naive) {
+    using format::serialize::json_tag;
+
+    std::string  name   = std::string(corpus) + "/schema_json";
+    auto         saved  = format::serialize::save(value, json_tag {}).value();
+    const size_t length = saved.size();
+
+    std::string baseline;
+    suite.run(name + "/naive_string", length, [&] {
+        baseline.clear();
+        naive(baseline);
+        asyncle::bench::do_not_optimize(baseline.data());
+    });
+    suite.run(name + "/save", length, [&] {
+        asyncle::bench::do_not_optimize(format::serialize::save(value, json_tag {}));
+    });
+
+    auto reused = saved;
+    suite.run(name + "/save_into_reused", length, [&] {
+        asyncle::bench::do_not_optimize(format::serialize::save_into(value, reused, json_tag {}));
+        asyncle::bench::do_not_optimize(reused.data());
+    });
+
+    std::vector<std::byte> fixed(length * 2);
+    suite.run(name + "/save_into_span", length, [&] {
+        asyncle::bench::do_not_optimize(format::serialize::save_into(value, std::span<std::byte>(fixed), json_tag {}));
+    });
+}
+
+#ifdef FORMAT_HAS_GLAZE
+
+template <typename T, typename Tag>
+void run_format(asyncle::bench::suite& suite, std::string_view corpus, T const& value, Tag tag) {
+    using format::serialize::load;
+    using format::serialize::save;
+    using format::serialize::save_into;
+
+    std::string  name   = std::string(corpus) + (format::serialize::text_format<Tag> ? "/json" : "/beve");
+    auto         saved  = save(value, tag).value();
+    const size_t length = saved.size();
+
+    suite.run(name + "/save", length, [&] { asyncle::bench::do_not_optimize(save(value, tag)); });
+
+    auto reused = saved;
+    suite.run(name + "/save_into_reused", length, [&] {
+        asyncle::bench::do_not_optimize(save_into(value, reused, tag));
+        asyncle::bench::do_not_optimize(reused.data());
+    });
+
+    std::vector<std::byte> fixed(length * 2);
+    suite.run(name + "/save_into_span", length, [&] {
+        asyncle::bench::do_not_optimize(save_into(value, std::span<std::byte>(fixed), tag));
+    });
+
+    if constexpr(format::serialize::text_format<Tag>) {
+        suite.run(name + "/load", length, [&] { asyncle::bench::do_not_optimize(load<T>(saved, tag)); });
+    } else {
+        suite.run(name + "/load", length, [&] {
+            asyncle::bench::do_not_optimize(load<T>(std::span<const std::byte>(saved), tag));
+        });
+    }
+}
+
+#endif  // FORMAT_HAS_GLAZE
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("format.serialize", argc, argv);
+
+    message      small = make_message(48213);
+    batch        large;
+    schema_batch schema_large;
+    for(int64_t i = 0; i < 10000; ++i) {
+        large.messages.push_back(make_message(i));
+        schema_large.messages.push_back(schema_message { make_message(i) });
+    }
+
+    run_schema(suite, "small", schema_message { small }, [&](std::string& out) { naive_message(out, small); });
+    run_schema(suite, "large_batch", schema_large, [&](std::string& out) {
+        out += "{\"messages\":[";
+        for(size_t i = 0; i < large.messages.size(); ++i) {
+            if(i) out += ',';
+            naive_message(out, large.messages[i]);
+        }
+        out += "]}";
+    });
+
+#ifdef FORMAT_HAS_GLAZE
+    run_format(suite, "small", small, format::serialize::json_tag {});
+    run_format(suite, "small", small, format::serialize::beve_tag {});
+    run_format(suite, "large_batch", large, format::serialize::json_tag {});
+    run_format(suite, "large_batch", large, format::serialize::beve_tag {});
+#else
+    suite.skip("format.serialize/glaze", "built without Glaze (FORMAT_ENABLE_GLAZE=ON)");
+#endif
+
+    return suite.finish();
+}
@@ -0,0 +1,565 @@
+// asyncle::hardware kernels on cold memory: a random-index gather over a table
+// much larger than L3 and a batch of hash-table probes, each run plainly and
+// through the prefetch pipeline at the default distance. Also the hot-path
+// cost of one shared atomic counter versus a sharded_counter, from one thread
+// and from several (thread start-up is included in the contended cases), the
+// cost of a timestamp from steady_clock versus cycle_clock, reads of a
+// small shared config through shared_mutex versus seqlock, random lookups
+// in concurrent::hash_map versus a mutex-sharded unordered_map, and
+// allocate/free churn through new/delete versus concurrent::object_pool,
+// wrapping plus calling a handler through std::function versus
+// dynamic_worker, and CRC32C (byte table, slicing-by-8, and the dispatched
+// instruction kernel) and XXH64 over warm 4 KiB and 1 MiB blocks, and a
+// scoring pass that reads 2 of 12 fields per record from an array of structs
+// versus a soa_vector (for_each and zip), and moving 32-byte messages through
+// an spsc_ring one push/take at a time versus memcpy'd batches (push_batch,
+// and try_push with a span), the cost of each memory barrier after a store,
+// and writing a dirtied block back with cache_flush_range, and probing the
+// memory and cache capabilities versus reading the per-process snapshot.
+//
+// Suite settings:
+//   --table-size=<MiB>   Table size (default 256); keep it well above L3
+//   --threads=<n>        Threads for the contended counter, config-read, map and pool cases (default 4)
+//   --map-entries=<n>    Entries in the map lookup cases (default 4000000)
+
+#include "bench.hpp"
+#include <asyncle/base/dynamic_worker.hpp>
+#include <asyncle/concurrent/hash_map.hpp>
+#include <asyncle/concurrent/object_pool.hpp>
+#include <asyncle/concurrent/seqlock.hpp>
+#include <asyncle/concurrent/sharded.hpp>
+#include <asyncle/concurrent/spsc_ring.hpp>
+#include <asyncle/hardware/checksum.hpp>
+#include <asyncle/hardware/clock.hpp>
+#include <asyncle/hardware/layout.hpp>
+#include <asyncle/hardware/memory.hpp>
+#include <asyncle/hardware/prefetch.hpp>
+#include <asyncle/io/mmap.hpp>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace asyncle::hardware;
+
+struct row {
+    uint64_t key;
+    uint64_t amount;
+    char     payload[48];
+};
+
+// Open addressing, one row per slot; keys are their own hash mixed down
+struct table {
+    std::vector<row> slots;
+    uint64_t         mask;
+
+    explicit table(size_t size): slots(size), mask(size - 1) {
+        for(size_t i = 0; i < size; ++i) slots[i] = { i, i & 0xff, {} };
+    }
+
+    static uint64_t mix(uint64_t key) noexcept { return (key * 0x9e3779b97f4a7c15ull) >> 17; }
+
+    const row& bucket_for(uint64_t key) const noexcept { return slots[mix(key) & mask]; }
+};
+
+void run_prefetch(asyncle::bench::suite& suite, size_t table_bytes) {
+    size_t rows = 1;
+    while(rows * 2 * sizeof(row) <= table_bytes) rows *= 2;
+    table t(rows);
+
+    const size_t          probes = 1 << 20;
+    std::vector<uint32_t> ids(probes);
+    std::mt19937_64       rng(42);
+    for(auto& id : ids) id = static_cast<uint32_t>(rng() & t.mask);
+
+    suite.context("table_rows", std::to_string(rows));
+    suite.context("prefetch_distance", std::to_string(prefetch_distance()));
+
+    for(size_t distance : { size_t(0), prefetch_distance() }) {
+        std::string label = distance ? "prefetched" : "plain";
+
+        suite.run("prefetch/gather/" + label, probes * sizeof(row), [&] {
+            uint64_t total = 0;
+            prefetch_gather(
+              std::span<const uint32_t>(ids), t.slots.data(), [&](const row& r, size_t) { total += r.amount; },
+              sizeof(row), distance);
+            asyncle::bench::do_not_optimize(total);
+        });
+
+        suite.run("prefetch/hash_probe/" + label, probes * sizeof(row), [&] {
+            uint64_t matches = 0;
+            for_each_prefetched(
+              ids, [&](uint32_t key) { return &t.bucket_for(key); },
+              [&](uint32_t key) { matches += t.bucket_for(key).amount == (key & 0xff); }, distance);
+            asyncle::bench::do_not_optimize(matches);
+        });
+    }
+}
+
+// Each op is 1000 increments per thread
+void run_counters(asyncle::bench::suite& suite, size_t threads) {
+    using asyncle::concurrent::shard_by;
+    using asyncle::concurrent::sharded_counter;
+    constexpr int per_op = 1000;
+
+    std::atomic<int64_t> shared { 0 };
+    sharded_counter      by_thread(shard_by::thread);
+    sharded_counter      by_cpu(shard_by::cpu);
+
+    auto bump_shared = [&] {
+        for(int i = 0; i < per_op; ++i) shared.fetch_add(1, std::memory_order_relaxed);
+    };
+    auto bump_thread = [&] {
+        for(int i = 0; i < per_op; ++i) by_thread.add();
+    };
+    auto bump_cpu = [&] {
+        for(int i = 0; i < per_op; ++i) by_cpu.add();
+    };
+
+    suite.run("counter/shared_atomic/threads=1", 0, bump_shared);
+    suite.run("counter/sharded_thread/threads=1", 0, bump_thread);
+    suite.run("counter/sharded_cpu/threads=1", 0, bump_cpu);
+
+    auto fan_out = [&](auto& body) {
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+        for(auto& w : workers) w.join();
+    };
+    std::string suffix = "/threads=" + std::to_string(threads);
+    suite.run("counter/shared_atomic" + suffix, 0, [&] { fan_out(bump_shared); });
+    suite.run("counter/sharded_thread" + suffix, 0, [&] { fan_out(bump_thread); });
+    suite.run("counter/sharded_cpu" + suffix, 0, [&] { fan_out(bump_cpu); });
+    asyncle::bench::do_not_optimize(shared.load() + by_thread.value() + by_cpu.value());
+}
+
+// Each op is 1000 timestamps (or timed empty scopes)
+void run_clocks(asyncle::bench::suite& suite) {
+    using asyncle::concurrent::sharded_histogram;
+    constexpr int per_op = 1000;
+
+    suite.context("ticks_per_ns", std::to_string(cycle_clock::calibration().ticks_per_ns));
+
+    suite.run("clock/steady_clock_now", 0, [&] {
+        for(int i = 0; i < per_op; ++i) asyncle::bench::do_not_optimize(std::chrono::steady_clock::now());
+    });
+    suite.run("clock/cycle_clock_ticks", 0, [&] {
+        for(int i = 0; i < per_op; ++i) asyncle::bench::do_not_optimize(cycle_clock::ticks());
+    });
+    suite.run("clock/cycle_clock_ticks_begin", 0, [&] {
+        for(int i = 0; i < per_op; ++i) asyncle::bench::do_not_optimize(cycle_clock::ticks_begin());
+    });
+    suite.run("clock/cycle_clock_ticks_end", 0, [&] {
+        for(int i = 0; i < per_op; ++i) asyncle::bench::do_not_optimize(cycle_clock::ticks_end());
+    });
+
+    sharded_histogram latency;
+    suite.run("clock/scoped_timer_histogram", 0, [&] {
+        for(int i = 0; i < per_op; ++i) scoped_timer timed(latency);
+    });
+    asyncle::bench::do_not_optimize(latency.snapshot().count);
+}
+
+// Each op is 1000 reads of a 48-byte config per thread
+void run_config_reads(asyncle::bench::suite& suite, size_t threads) {
+    struct config {
+        uint64_t version;
+        uint64_t routes[5];
+    };
+    constexpr int per_op = 1000;
+
+    config                               plain {};
+    std::shared_mutex                    guard;
+    asyncle::concurrent::seqlock<config> sequenced;
+    std::atomic<uint64_t>                sink { 0 };
+
+    auto read_locked = [&] {
+        uint64_t sum = 0;
+        for(int i = 0; i < per_op; ++i) {
+            std::shared_lock lock(guard);
+            sum += plain.routes[i % 5];
+        }
+        sink.fetch_add(sum, std::memory_order_relaxed);
+    };
+    auto read_sequenced = [&] {
+        uint64_t sum = 0;
+        for(int i = 0; i < per_op; ++i) sum += sequenced.load().routes[i % 5];
+        sink.fetch_add(sum, std::memory_order_relaxed);
+    };
+
+    suite.run("config_read/shared_mutex/threads=1", 0, read_locked);
+    suite.run("config_read/seqlock/threads=1", 0, read_sequenced);
+
+    auto fan_out = [&](auto& body) {
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+        for(auto& w : workers) w.join();
+    };
+    std::string suffix = "/threads=" + std::to_string(threads);
+    suite.run("config_read/shared_mutex" + suffix, 0, [&] { fan_out(read_locked); });
+    suite.run("config_read/seqlock" + suffix, 0, [&] { fan_out(read_sequenced); });
+    asyncle::bench::do_not_optimize(sink.load());
+}
+
+// Each op is 1000 random lookups per thread, about 7 in 8 of them hits
+void run_maps(asyncle::bench::suite& suite, size_t entries, size_t threads) {
+    struct session {
+        uint64_t id;
+        uint64_t expires;
+        uint32_t hits;
+    };
+    constexpr int    per_op = 1000;
+    constexpr size_t shards = 64;
+
+    struct locked_shard {
+        std::mutex                             guard;
+        std::unordered_map<uint64_t, session> map;
+    };
+
+    asyncle::concurrent::hash_map<uint64_t, session> concurrent(entries);
+    std::vector<locked_shard>                        sharded(shards);
+    for(uint64_t id = 0; id < entries; ++id) {
+        concurrent.insert(id * 8, { id, id, 0 });
+        sharded[id % shards].map.emplace(id * 8, session { id, id, 0 });
+    }
+    const uint64_t key_space = entries * 8 + entries;  // Some keys miss
+    std::atomic<uint64_t> sink { 0 };
+
+    auto lookups = [&](auto&& find) {
+        return [&, find] {
+            uint64_t x   = 0x9e3779b97f4a7c15ull ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+            uint64_t sum = 0;
+            for(int i = 0; i < per_op; ++i) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                sum += find((x % key_space) & ~uint64_t(7));
+            }
+            sink.fetch_add(sum, std::memory_order_relaxed);
+        };
+    };
+    auto find_concurrent = lookups([&](uint64_t key) -> uint64_t {
+        session s;
+        return concurrent.find(key, s) ? s.expires : 0;
+    });
+    auto find_sharded = lookups([&](uint64_t key) -> uint64_t {
+        locked_shard&   shard = sharded[(key / 8) % shards];
+        std::lock_guard lock(shard.guard);
+        auto            it = shard.map.find(key);
+        return it != shard.map.end() ? it->second.expires : 0;
+    });
+
+    suite.context("map_entries", std::to_string(entries));
+    suite.run("map_find/hash_map/threads=1", 0, find_concurrent);
+    suite.run("map_find/sharded_unordered_map/threads=1", 0, find_sharded);
+
+    auto fan_out = [&](auto& body) {
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+        for(auto& w : workers) w.join();
+    };
+    std::string suffix = "/threads=" + std::to_string(threads);
+    suite.run("map_find/hash_map" + suffix, 0, [&] { fan_out(find_concurrent); });
+    suite.run("map_find/sharded_unordered_map" + suffix, 0, [&] { fan_out(find_sharded); });
+    asyncle::bench::do_not_optimize(sink.load());
+}
+
+// Each op allocates and frees 1000 64-byte messages per thread, in bursts of 50
+void run_pools(asyncle::bench::suite& suite, size_t threads) {
+    struct message {
+        uint64_t sequence;
+        uint64_t payload[7];
+    };
+    constexpr int per_op = 1000;
+    constexpr int burst  = 50;
+
+    asyncle::concurrent::object_pool<message> pool;
+    std::atomic<uint64_t>                     sink { 0 };
+
+    auto churn = [&](auto&& create, auto&& destroy) {
+        return [&, create, destroy] {
+            message* live[burst];
+            uint64_t sum = 0;
+            for(int round = 0; round < per_op / burst; ++round) {
+                for(int i = 0; i < burst; ++i) live[i] = create(round * burst + i);
+                for(int i = 0; i < burst; ++i) {
+                    sum += live[i]->sequence;
+                    destroy(live[i]);
+                }
+            }
+            sink.fetch_add(sum, std::memory_order_relaxed);
+        };
+    };
+    auto heap   = churn([](uint64_t n) { return new message { n, {} }; }, [](message* m) { delete m; });
+    auto pooled = churn([&](uint64_t n) { return pool.construct(message { n, {} }); },
+                        [&](message* m) { pool.destroy(m); });
+
+    suite.run("alloc_free/new_delete/threads=1", 0, heap);
+    suite.run("alloc_free/object_pool/threads=1", 0, pooled);
+
+    auto fan_out = [&](auto& body) {
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+        for(auto& w : workers) w.join();
+    };
+    std::string suffix = "/threads=" + std::to_string(threads);
+    suite.run("alloc_free/new_delete" + suffix, 0, [&] { fan_out(heap); });
+    suite.run("alloc_free/object_pool" + suffix, 0, [&] { fan_out(pooled); });
+    asyncle::bench::do_not_optimize(sink.load());
+}
+
+// Each op wraps a 40-byte handler and sends it 16 messages, as a per-message
+// plugin hop does; std::function allocates for state this size
+struct dispatch_error {
+    int code;
+};
+
+using dispatch_command = asyncle::command<dispatch_error, asyncle::type_map<uint64_t, uint64_t>>;
+
+struct weigher {
+    uint64_t weights[5];
+
+    asyncle::expected<uint64_t, dispatch_error> work(dispatch_command, const uint64_t& v) const {
+        return v * weights[v % 5];
+    }
+};
+
+void run_dispatch(asyncle::bench::suite& suite) {
+    constexpr uint64_t per_op = 16;
+    weigher            handler { { 1, 3, 5, 7, 11 } };
+    uint64_t           sink = 0;
+
+    suite.run("dispatch/std_function", 0, [&] {
+        std::function<asyncle::expected<uint64_t, dispatch_error>(const uint64_t&)> fn =
+          [h = handler](const uint64_t& v) { return h.work(dispatch_command {}, v); };
+        asyncle::bench::do_not_optimize(fn);
+        for(uint64_t i = 0; i < per_op; ++i) sink += *fn(i);
+    });
+    suite.run("dispatch/dynamic_worker", 0, [&] {
+        asyncle::dynamic_worker<dispatch_command, const uint64_t&> worker(handler);
+        asyncle::bench::do_not_optimize(worker);
+        for(uint64_t i = 0; i < per_op; ++i) sink += *asyncle::work(worker, dispatch_command {}, i);
+    });
+    suite.run("dispatch/dynamic_worker_work_as", 0, [&] {
+        asyncle::dynamic_worker<dispatch_command, const uint64_t&> worker(handler);
+        asyncle::bench::do_not_optimize(worker);
+        for(uint64_t i = 0; i < per_op; ++i) sink += *worker.work_as<weigher>(dispatch_command {}, i);
+    });
+    asyncle::bench::do_not_optimize(sink);
+}
+
+void run_checksums(asyncle::bench::suite& suite) {
+    std::vector<unsigned char> data(1 << 20);
+    for(size_t i = 0; i < data.size(); ++i) data[i] = static_cast<unsigned char>(i * 2654435761u >> 13);
+
+    auto bytewise = [](uint32_t crc, const void* p, size_t n) noexcept {
+        const auto& table = asyncle::hardware::detail::crc32c_tables[0];
+        for(size_t i = 0; i < n; ++i) crc = table[(crc ^ static_cast<const unsigned char*>(p)[i]) & 0xff] ^ (crc >> 8);
+        return crc;
+    };
+    for(size_t block : { size_t { 4096 }, data.size() }) {
+        const std::string size = block == 4096 ? "/4K" : "/1M";
+        suite.run("checksum/crc32c_bytewise" + size, block, [&] {
+            asyncle::bench::do_not_optimize(bytewise(~0u, data.data(), block));
+        });
+        suite.run("checksum/crc32c_slicing8" + size, block, [&] {
+            asyncle::bench::do_not_optimize(asyncle::hardware::detail::crc32c_scalar(~0u, data.data(), block));
+        });
+        suite.run("checksum/crc32c" + size, block, [&] {
+            asyncle::bench::do_not_optimize(asyncle::hardware::crc32c(data.data(), block));
+        });
+        suite.run("checksum/xxh64" + size, block, [&] {
+            asyncle::bench::do_not_optimize(asyncle::hardware::xxh64(data.data(), block));
+        });
+    }
+}
+
+// Twelve fields per record; the scoring pass reads weight and signal and
+// writes score, so the AoS loop drags 96-byte records through the cache for
+// 12 useful bytes
+struct record {
+    uint64_t id;
+    uint64_t owner;
+    double   created;
+    double   updated;
+    float    weight;
+    float    signal;
+    float    score;
+    int32_t  region;
+    int32_t  category;
+    int32_t  flags;
+    double   balance;
+    double   limit;
+    uint64_t checksum;
+};
+
+enum record_field : size_t { weight, signal, score };
+
+void run_layout(asyncle::bench::suite& suite) {
+    constexpr size_t                count = size_t { 4 } << 20;
+    std::vector<record>             aos(count);
+    soa_vector<float, float, float> soa(count);
+    for(size_t i = 0; i < count; ++i) {
+        aos[i].weight      = static_cast<float>(i % 97) * 0.25f;
+        aos[i].signal      = static_cast<float>(i % 13);
+        soa.get<weight>(i) = aos[i].weight;
+        soa.get<signal>(i) = aos[i].signal;
+    }
+    const uint64_t useful = count * 3 * sizeof(float);
+
+    suite.run("layout/score/array_of_structs", useful, [&] {
+        for(auto& r : aos) r.score = r.weight * r.signal + 1.0f;
+        asyncle::bench::do_not_optimize(aos[count / 2].score);
+    });
+    suite.run("layout/score/soa_for_each", useful, [&] {
+        soa.for_each<weight, signal, score>([](float w, float s, float& out) { out = w * s + 1.0f; });
+        asyncle::bench::do_not_optimize(soa.get<score>(count / 2));
+    });
+    suite.run("layout/score/soa_zip", useful, [&] {
+        for(auto [w, s, out] : soa.zip<weight, signal, score>()) out = w * s + 1.0f;
+        asyncle::bench::do_not_optimize(soa.get<score>(count / 2));
+    });
+}
+
+// Each op sends 4096 messages through a 1024-slot ring in bursts of 256 on one
+// thread, so only the copy cost differs
+void run_queue_batches(asyncle::bench::suite& suite) {
+    struct message {
+        uint64_t sequence;
+        uint64_t payload[3];
+    };
+    constexpr size_t count = 4096;
+    constexpr size_t burst = 256;
+
+    asyncle::concurrent::spsc_ring<message, 1024> ring;
+    std::vector<message>                          input(count);
+    std::vector<message>                          output(burst);
+    for(size_t i = 0; i < count; ++i) input[i] = message { i, { i, i, i } };
+    const uint64_t bytes = count * sizeof(message);
+
+    suite.run("queue/spsc/push_take_each", bytes, [&] {
+        uint64_t sum = 0;
+        for(size_t at = 0; at < count; at += burst) {
+            for(size_t i = 0; i < burst; ++i) ring.push(input[at + i]);
+            for(size_t i = 0; i < burst; ++i) ring.take(output[i]);
+            sum += output[burst - 1].sequence;
+        }
+        asyncle::bench::do_not_optimize(sum);
+    });
+    suite.run("queue/spsc/push_take_batch", bytes, [&] {
+        uint64_t sum = 0;
+        for(size_t at = 0; at < count; at += burst) {
+            ring.push_batch(std::span<const message>(input).subspan(at, burst));
+            ring.take_batch(output);
+            sum += output[burst - 1].sequence;
+        }
+        asyncle::bench::do_not_optimize(sum);
+    });
+    suite.run("queue/spsc/try_push_span", bytes, [&] {
+        uint64_t sum = 0;
+        for(size_t at = 0; at < count; at += burst) {
+            auto pushed = asyncle::try_push(ring, std::span<const message>(input).subspan(at, burst));
+            ring.take_batch(output);
+            sum += output[burst - 1].sequence + (pushed ? 1 : 0);
+        }
+        asyncle::bench::do_not_optimize(sum);
+    });
+}
+
+// Each op is 1000 barriers, each after a relaxed store to a shared word (the
+// fence has pending stores to order), and a plain-store loop for reference
+void run_barriers(asyncle::bench::suite& suite) {
+    constexpr int         per_op = 1000;
+    std::atomic<uint64_t> word { 0 };
+
+    auto fenced = [&](auto&& barrier) {
+        return [&, barrier] {
+            for(int i = 0; i < per_op; ++i) {
+                word.store(i, std::memory_order_relaxed);
+                barrier();
+            }
+        };
+    };
+    suite.run("barrier/none", 0, fenced([] {}));
+    suite.run("barrier/compiler", 0, fenced([] { compiler_barrier(); }));
+    suite.run("barrier/acquire", 0, fenced([] { memory_barrier_acquire(); }));
+    suite.run("barrier/release", 0, fenced([] { memory_barrier_release(); }));
+    suite.run("barrier/seq_cst", 0, fenced([] { memory_barrier_seq_cst(); }));
+    suite.run("barrier/cpu_relax", 0, fenced([] { cpu_relax(); }));
+    asyncle::bench::do_not_optimize(word.load());
+}
+
+// Each op dirties a block and writes it back with cache_flush_range; the
+// write_only cases are the same stores without the flush
+void run_cache_flush(asyncle::bench::suite& suite) {
+    for(size_t size : { size_t { 4 } << 10, size_t { 256 } << 10 }) {
+        std::vector<uint64_t> block(size / sizeof(uint64_t));
+        const std::string     suffix = "/" + std::to_string(size >> 10) + "KiB";
+        uint64_t              round  = 0;
+
+        suite.run("cache/write_only" + suffix, size, [&] {
+            ++round;
+            for(size_t i = 0; i < block.size(); i += cache_line_size / sizeof(uint64_t)) block[i] = round;
+            compiler_barrier();
+        });
+        suite.run("cache/write_flush_range" + suffix, size, [&] {
+            ++round;
+            for(size_t i = 0; i < block.size(); i += cache_line_size / sizeof(uint64_t)) block[i] = round;
+            cache_flush_range(block.data(), size);
+        });
+        asyncle::bench::do_not_optimize(block[0]);
+    }
+}
+
+// probe: what every call cost before the snapshot; snapshot: what hot paths pay now
+void run_capabilities(asyncle::bench::suite& suite) {
+    suite.run("caps/memory/probe", 0, [] {
+        asyncle::bench::do_not_optimize(platform::mmap::query_capabilities().system_page_size);
+    });
+    suite.run("caps/memory/snapshot", 0, [] {
+        asyncle::bench::do_not_optimize(asyncle::io::mmap::capabilities().system_page_size);
+    });
+    size_t length = 1;
+    suite.run("caps/memory/align_to_page", 0, [&] {
+        asyncle::bench::do_not_optimize(asyncle::io::mmap::align_to_page(length));
+        length = (length * 7 + 1) & 0xfffff;
+    });
+    suite.run("caps/cache/probe", 0, [] { asyncle::bench::do_not_optimize(detect_cache_info().l1_line_size); });
+    suite.run("caps/cache/snapshot", 0, [] { asyncle::bench::do_not_optimize(cpu_cache_info().l1_line_size); });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    asyncle::bench::suite suite("hardware", argc, argv);
+
+    const size_t size_mib = std::strtoull(std::string(suite.value("table-size", "256")).c_str(), nullptr, 10);
+    run_prefetch(suite, (size_mib ? size_mib : 256) << 20);
+
+    const size_t threads = std::strtoull(std::string(suite.value("threads", "4")).c_str(), nullptr, 10);
+    run_counters(suite, threads ? threads : 4);
+    run_clocks(suite);
+    run_config_reads(suite, threads ? threads : 4);
+
+    const size_t map_entries = std::strtoull(std::string(suite.value("map-entries", "4000000")).c_str(), nullptr, 10);
+    run_maps(suite, map_entries ? map_entries : 4000000, threads ? threads : 4);
+    run_pools(suite, threads ? threads : 4);
+    run_dispatch(suite);
+    run_checksums(suite);
+    run_layout(suite);
+    run_queue_batches(suite);
+    run_barriers(suite);
+    run_cache_flush(suite);
+    run_capabilities(suite);
+    return suite.finish();
+}
@@ -0,0 +1,813 @@
+// asyncle::io throughput over one scratch file: buffered and O_DIRECT reads,
+// readv, io_ring at several queue depths, mmap under each access_pattern,
+// sendfile/splice/copy_file_range, a child process's stdout (read, spliced
+// into a file, or redirected to it), and a request round trip through a warm
+// process_pool versus a spawn per request or a pair of shm_rings, and filling
+// an mmap'd output file with memcpy versus non-temporal stream_copy, growing a
+// mapped file by remapping it whole versus growable_mapping, faulting in an evicted file in
+// random order versus prewarm() first, loading it as a verified snapshot on
+// one thread versus across the pool, copying and scanning a sparse file
+// whole versus by data extent, small records written one call each versus
+// through a double-buffered writer, splitting the file into '\n' records with
+// std::getline versus record_reader, walking a directory tree on one thread versus
+// the work-stealing pool (statx one by one or batched through io_uring),
+// journal appends from one thread (one sync per record) versus eight (group
+// commit), 256 shards read one after another versus through
+// read_scheduler, and log text written and read plainly versus lz4-framed by
+// compressed_writer/compressed_reader.
+//
+// Every case moves the whole file (or, for the process pipe, the same number
+// of bytes), so GB/s compares across cases. Buffered cases read a warm page
+// cache; the direct and ring cases on O_DIRECT descriptors measure the device.
+//
+// Suite settings:
+//   --file-size=<MiB>   Scratch file size (default 64)
+//   --dir=<path>        Where to create it (default $TMPDIR or /tmp); O_DIRECT
+//                       cases are skipped on filesystems that reject it
+
+#include "bench.hpp"
+#include <algorithm>
+#include <asyncle/hardware/bulk.hpp>
+#include <asyncle/io/buffer_pool.hpp>
+#include <asyncle/io/buffered_writer.hpp>
+#include <asyncle/io/capture.hpp>
+#include <asyncle/io/compressed_file.hpp>
+#include <asyncle/io/extents.hpp>
+#include <asyncle/io/file.hpp>
+#include <asyncle/io/growable_mapping.hpp>
+#include <asyncle/io/journal.hpp>
+#include <asyncle/io/mmap.hpp>
+#include <asyncle/io/process.hpp>
+#include <asyncle/io/process_pool.hpp>
+#include <asyncle/io/read_scheduler.hpp>
+#include <asyncle/io/shm_ring.hpp>
+#include <asyncle/io/snapshot.hpp>
+#include <asyncle/io/record_reader.hpp>
+#include <asyncle/io/residency.hpp>
+#include <asyncle/io/ring.hpp>
+#include <asyncle/io/stream.hpp>
+#include <asyncle/io/tree_walk.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <poll.h>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace asyncle::io;
+constexpr size_t block_sizes[]  = { 4096, 64 * 1024, 1024 * 1024 };
+constexpr size_t queue_depths[] = { 1, 4, 16, 64 };
+
+std::string block_label(size_t bs) {
+    return bs >= 1024 * 1024 ? std::to_string(bs >> 20) + "M" : std::to_string(bs >> 10) + "K";
+}
+
+access_mode mode(access_mode a, access_mode b) {
+    return static_cast<access_mode>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+access_mode mode(access_mode a, access_mode b, access_mode c) { return mode(mode(a, b), c); }
+
+// Fill path with size bytes of non-zero data in 1 MiB writes
+bool create_scratch(const std::string& path, size_t size) {
+    file out(path.c_str(), mode(access_mode::write_only, access_mode::create, access_mode::truncate));
+    if(!out) return false;
+    std::vector<char> chunk(1024 * 1024);
+    for(size_t i = 0; i < chunk.size(); ++i) chunk[i] = static_cast<char>(i * 31 + 7);
+    for(size_t offset = 0; offset < size; offset += chunk.size()) {
+        if(!out.write(chunk.data(), std::min(chunk.size(), size - offset), offset)) return false;
+    }
+    return static_cast<bool>(out.sync());
+}
+
+// Sequential pread over the whole file, one block per call
+void run_reads(asyncle::bench::suite& suite, std::string_view kind, file& in, size_t size, dio_buffer_pool& pool) {
+    for(size_t bs : block_sizes) {
+        dio_buffer buffer = pool.acquire();
+        suite.run("file/" + std::string(kind) + "/bs=" + block_label(bs), size, [&] {
+            for(uint64_t offset = 0; offset < size; offset += bs) {
+                asyncle::bench::do_not_optimize(in.read(buffer.data, bs, offset));
+            }
+        });
+        pool.release(buffer);
+    }
+}
+
+// Sequential preadv, 16 contiguous blocks per call
+void run_readv(asyncle::bench::suite& suite, file& in, size_t size) {
+    constexpr size_t vector = 16;
+    for(size_t bs : block_sizes) {
+        if(bs * vector > size) continue;
+        std::vector<char> target(bs * vector);
+        io_request        reqs[vector];
+        suite.run("file/readv16/bs=" + block_label(bs), size, [&] {
+            for(uint64_t offset = 0; offset + bs * vector <= size; offset += bs * vector) {
+                for(size_t i = 0; i < vector; ++i) {
+                    reqs[i]        = io_request {};
+                    reqs[i].buffer = target.data() + i * bs;
+                    reqs[i].offset = offset + i * bs;
+                    reqs[i].length = bs;
+                }
+                asyncle::bench::do_not_optimize(in.readv(reqs, vector));
+            }
+        });
+    }
+}
+
+// Whole-file reads through io_ring with depth requests kept in flight
+void run_ring(asyncle::bench::suite& suite, std::string_view kind, file& in, size_t size, size_t bs) {
+    for(size_t depth : queue_depths) {
+        std::string name = "ring/" + std::string(kind) + "/bs=" + block_label(bs) + "/qd=" + std::to_string(depth);
+        if(!suite.selected(name)) continue;
+
+        io_ring ring(static_cast<uint32_t>(depth));
+        auto    pool = dio_buffer_pool::for_file(in, bs, static_cast<uint32_t>(depth));
+        if(!ring.is_open() || !pool.is_valid()) {
+            suite.skip(name, "io_ring unavailable");
+            continue;
+        }
+
+        std::vector<dio_buffer>    slots(depth);
+        std::vector<io_completion> done(depth);
+        for(auto& slot : slots) slot = pool.acquire();
+        const uint64_t blocks = size / bs;
+
+        suite.run(name, blocks * bs, [&] {
+            uint64_t next = 0, completed = 0;
+            for(size_t s = 0; s < depth && next < blocks; ++s, ++next) {
+                io_request req = slots[s].request(next * bs, bs);
+                in.queue_read(ring, &req, 1, s);
+            }
+            ring.submit();
+            while(completed < blocks) {
+                auto n = ring.complete(done.data(), done.size(), 1);
+                if(!n) break;
+                for(size_t i = 0; i < n.value(); ++i, ++completed) {
+                    if(next == blocks) continue;
+                    uint64_t   s   = done[i].user_data;
+                    io_request req = slots[s].request(next++ * bs, bs);
+                    in.queue_read(ring, &req, 1, s);
+                }
+                ring.submit();
+            }
+        });
+    }
+}
+
+// Map, touch one byte per page in sequential or shuffled order, unmap
+void run_mmap(asyncle::bench::suite& suite, file& in, size_t size) {
+    const size_t        page  = mmap::page_size();
+    std::vector<size_t> order(size / page);
+    for(size_t i = 0; i < order.size(); ++i) order[i] = i * page;
+    std::vector<size_t> shuffled = order;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+
+    const std::pair<access_pattern, const char*> patterns[] = {
+        { access_pattern::normal_access, "normal" },
+        { access_pattern::sequential_access, "sequential" },
+        { access_pattern::random_access, "random" },
+    };
+    for(auto [pattern, label] : patterns) {
+        for(bool random_order : { false, true }) {
+            auto const& pages = random_order ? shuffled : order;
+            suite.run(std::string("mmap/") + label + (random_order ? "/random_pages" : "/sequential_pages"), size, [&] {
+                mmap map(in, size, 0, mmap_access::access_mode::read);
+                map.advise(pattern);
+                const auto* base = static_cast<const volatile unsigned char*>(map.data());
+                unsigned    sum  = 0;
+                for(size_t offset : pages) sum += base[offset];
+                asyncle::bench::do_not_optimize(sum);
+            });
+        }
+    }
+}
+
+// Kernel-side copies into a second file: sendfile, copy_file_range, and splice through a pipe
+void run_zero_copy(asyncle::bench::suite& suite, file& in, size_t size, const std::string& copy_path) {
+    file out(copy_path.c_str(), mode(access_mode::read_write, access_mode::create, access_mode::truncate));
+    if(!out) {
+        suite.skip("zero_copy", "cannot open destination");
+        return;
+    }
+
+    suite.run("zero_copy/sendfile_to_file", size, [&] {
+        uint64_t offset = 0;
+        out.seek(0);
+        while(offset < size) {
+            auto sent = in.sendfile_to(out, &offset, size - offset);
+            if(!sent || sent.value() == 0) break;
+        }
+    });
+
+    stream_transfer stream;
+    suite.run("zero_copy/copy_file_range", size, [&] {
+        asyncle::bench::do_not_optimize(stream.copy(in, 0, out, 0, size));
+    });
+
+    // file::splice_to needs a pipe on one side: file -> pipe -> file, one pipe's worth at a time
+    int fds[2];
+    if(::pipe(fds) != 0) {
+        suite.skip("zero_copy/splice_via_pipe", "pipe() failed");
+        return;
+    }
+    file         pipe_out { platform::file::file_handle(fds[0]) };
+    file         pipe_in { platform::file::file_handle(fds[1]) };
+    const size_t chunk = static_cast<size_t>(::fcntl(fds[1], F_GETPIPE_SZ));
+    suite.run("zero_copy/splice_via_pipe", size, [&] {
+        uint64_t in_offset = 0, out_offset = 0;
+        while(in_offset < size) {
+            auto filled = in.splice_to(pipe_in, &in_offset, nullptr, std::min(chunk, size - in_offset));
+            if(!filled || filled.value() == 0) break;
+            for(size_t pending = filled.value(); pending > 0;) {
+                auto drained = pipe_out.splice_to(out, nullptr, &out_offset, pending);
+                if(!drained || drained.value() == 0) return;
+                pending -= drained.value();
+            }
+        }
+    });
+}
+
+// Spawn `head -c size /dev/zero`: drain its stdout at each block size, splice
+// it into a file, or let the child write the file directly
+void run_process_pipe(asyncle::bench::suite& suite, size_t size, const std::string& copy_path) {
+    const std::string command = "exec head -c " + std::to_string(size) + " /dev/zero";
+    const char* const args[]  = { "sh", "-c", command.c_str(), nullptr };
+    std::vector<char> buffer(block_sizes[std::size(block_sizes) - 1]);
+    for(size_t bs : block_sizes) {
+        suite.run("process/read_stdout/bs=" + block_label(bs), size, [&] {
+            process child("/bin/sh", args, pipe_mode::inherit, pipe_mode::pipe, pipe_mode::inherit);
+            for(;;) {
+                auto got = child.read_stdout(buffer.data(), bs);
+                if(got) {
+                    if(got.value() == 0) break;
+                    continue;
+                }
+                // Parent ends of the pipes are non-blocking
+                if(got.error().code != platform::process::error_code::would_block) break;
+                pollfd ready { child.stdout_pipe().fd, POLLIN, 0 };
+                ::poll(&ready, 1, -1);
+            }
+            asyncle::bench::do_not_optimize(child.wait());
+        });
+    }
+
+    file out(copy_path.c_str(), mode(access_mode::read_write, access_mode::create, access_mode::truncate));
+    if(!out) return;
+    suite.run("process/splice_stdout_to_file", size, [&] {
+        process  child("/bin/sh", args, pipe_mode::inherit, pipe_mode::pipe, pipe_mode::inherit);
+        uint64_t offset = 0;
+        bool     eof    = false;
+        while(drain_output(child.stdout_pipe(), out, &offset, eof) && !eof) {
+            pollfd ready { child.stdout_pipe().fd, POLLIN, 0 };
+            ::poll(&ready, 1, -1);
+        }
+        asyncle::bench::do_not_optimize(child.wait());
+    });
+    suite.run("process/redirect_stdout_to_file", size, [&] {
+        spawn_request req {};
+        req.executable = "/bin/sh";
+        req.args       = args;
+        req.redirect_stdout(out.fd());
+        out.seek(0);
+        process child(req);
+        asyncle::bench::do_not_optimize(child.wait());
+    });
+}
+
+// Worker side of the pool cases (this binary run with --pool-worker): echo each frame
+int run_echo_worker() {
+    std::vector<std::byte> request;
+    while(read_frame(request)) {
+        if(!write_frame(request)) return 1;
+    }
+    return 0;
+}
+
+// Worker side of the shm_ring case (--shm-worker <request fd> <reply fd>): echo each message
+int run_shm_echo_worker(int request_fd, int reply_fd) {
+    shm_ring requests, replies;
+    if(!requests.attach(request_fd) || !replies.attach(reply_fd)) return 1;
+    for(auto ready = requests.wait_readable(); ready && *ready; ready = requests.wait_readable()) {
+        auto sent = replies.send(requests.peek());
+        if(!sent || !*sent) return 1;
+        requests.release();
+    }
+    return 0;
+}
+
+// One small request answered by a fresh child (spawn, exchange, exit, reap)
+// versus by a child kept warm in a process_pool, or reading and answering
+// through two shm_rings without a system call while both sides are awake
+void run_process_pool(asyncle::bench::suite& suite) {
+    const char* const args[] = { "/proc/self/exe", "--pool-worker", nullptr };
+    const std::string request(256, 'q');
+    std::string       reply;
+
+    suite.run("process/request/spawn_per_call", request.size(), [&] {
+        process_pool once({ .executable = args[0], .args = args, .workers = 1 });
+        asyncle::bench::do_not_optimize(once.call(request, reply));
+    });
+
+    process_pool pool({ .executable = args[0], .args = args, .workers = 1 });
+    if(!pool.ready()) {
+        suite.skip("process/request/pool_call", "cannot spawn /proc/self/exe");
+        return;
+    }
+    suite.run("process/request/pool_call", request.size(), [&] {
+        asyncle::bench::do_not_optimize(pool.call(request, reply));
+    });
+
+    shm_ring requests, replies;
+    if(!requests.create(size_t { 1 } << 16) || !replies.create(size_t { 1 } << 16)) {
+        suite.skip("process/request/shm_ring", "memfd_create unavailable");
+        return;
+    }
+    spawn_request req {};
+    auto          request_fd = std::to_string(requests.share_with(req));
+    auto          reply_fd   = std::to_string(replies.share_with(req));
+    const char*   shm_args[] = { "/proc/self/exe", "--shm-worker", request_fd.c_str(), reply_fd.c_str(), nullptr };
+    req.executable           = shm_args[0];
+    req.args                 = shm_args;
+    process worker(req);
+    const auto payload = std::as_bytes(std::span<const char>(request.data(), request.size()));
+    suite.run("process/request/shm_ring", request.size(), [&] {
+        requests.send(payload);
+        replies.wait_readable();
+        asyncle::bench::do_not_optimize(replies.peek().size());
+        replies.release();
+    });
+    requests.close_writing();
+    worker.wait();
+}
+
+// Copy the file's bytes into a shared mapping of a second file with regular and
+// non-temporal stores; the same 4 MiB "working set" is summed after each copy,
+// so the gap includes what the regular stores evicted from the cache
+void run_mapped_copy(asyncle::bench::suite& suite, file& in, size_t size, const std::string& copy_path) {
+    file out(copy_path.c_str(), mode(access_mode::read_write, access_mode::create, access_mode::truncate));
+    if(!out || !out.truncate(size)) {
+        suite.skip("memory/copy_to_mapped_file", "cannot create destination");
+        return;
+    }
+    mmap source(in, size, 0, mmap_access::access_mode::read);
+    mmap target(out, size, 0, mmap_access::access_mode::read_write);
+    if(!source.is_mapped() || !target.is_mapped()) {
+        suite.skip("memory/copy_to_mapped_file", "mmap failed");
+        return;
+    }
+    std::vector<uint64_t> hot((4 << 20) / sizeof(uint64_t), 1);
+
+    const std::pair<const char*, void (*)(void*, const void*, size_t) noexcept> copies[] = {
+        { "memcpy", [](void* d, const void* s, size_t n) noexcept { std::memcpy(d, s, n); } },
+        { "stream_copy", asyncle::hardware::stream_copy },
+    };
+    for(auto [label, copy] : copies) {
+        suite.run(std::string("memory/copy_to_mapped_file/") + label, size, [&] {
+            copy(target.data(), source.data(), size);
+            uint64_t sum = 0;
+            for(uint64_t v : hot) sum += v;
+            asyncle::bench::do_not_optimize(sum);
+        });
+    }
+}
+
+// Grow a file from empty to 16 MiB in 64 KiB steps, writing each new chunk
+// through the mapping: unmap and map the whole file per step, or extend a
+// growable_mapping in place
+void run_mapped_growth(asyncle::bench::suite& suite, const std::string& copy_path) {
+    constexpr size_t step  = 64 * 1024;
+    constexpr size_t total = 16 << 20;
+    auto             fresh = [&] {
+        return file(copy_path.c_str(), mode(access_mode::read_write, access_mode::create, access_mode::truncate));
+    };
+
+    suite.run("mmap/grow/remap_whole_file", total, [&] {
+        file out = fresh();
+        mmap view;
+        for(size_t size = step; size <= total; size += step) {
+            out.truncate(size);
+            view.unmap();
+            view.map_file(out, size, 0, mmap_access::access_mode::read_write);
+            std::memset(view.as<char>() + size - step, 1, step);
+        }
+    });
+    suite.run("mmap/grow/growable_mapping", total, [&] {
+        file             out = fresh();
+        growable_mapping view(out, total);
+        for(size_t size = step; size <= total; size += step) {
+            view.grow(size);
+            std::memset(view.as<char>() + size - step, 1, step);
+        }
+    });
+}
+
+// Touch every page of an evicted file in a random order: straight through the
+// page faults, or after prewarm() made it resident with 1 or 4 readers
+void run_prewarm(asyncle::bench::suite& suite, file& in, size_t size) {
+    const size_t        page = mmap::page_size();
+    std::vector<size_t> order(size / page);
+    for(size_t i = 0; i < order.size(); ++i) order[i] = i * page;
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(7));
+
+    mmap view;
+    if(!view.map_file(in, size) || !asyncle::io::evict(in)) {
+        suite.skip("mmap/cold", "cannot map or evict the scratch file");
+        return;
+    }
+    auto touch = [&] {
+        uint64_t sum = 0;
+        for(size_t at : order) sum += view.as<const unsigned char>()[at];
+        asyncle::bench::do_not_optimize(sum);
+    };
+
+    suite.run("mmap/cold/random_faults", size, [&] {
+        view.evict();
+        touch();
+    });
+    for(size_t concurrency : { size_t { 1 }, size_t { 4 } }) {
+        suite.run("mmap/cold/prewarm/concurrency=" + std::to_string(concurrency), size, [&] {
+            view.evict();
+            asyncle::bench::do_not_optimize(asyncle::io::prewarm(in, 0, 0, { .concurrency = concurrency }));
+            touch();
+        });
+    }
+}
+
+// Cold-start a verified snapshot of the evicted file: map it with MAP_POPULATE
+// and CRC32C it on one thread, versus load_snapshot() on a 4-worker pool
+void run_snapshot(asyncle::bench::suite& suite, file& in, size_t size) {
+    if(!asyncle::io::evict(in)) {
+        suite.skip("snapshot", "cannot evict the scratch file");
+        return;
+    }
+    suite.run("snapshot/map_populate_then_crc32c", size, [&] {
+        asyncle::io::evict(in);
+        memory_request req {};
+        req.length   = size;
+        req.backing  = backing_type::file_backed;
+        req.access   = mmap_access::access_mode::read;
+        req.sharing  = sharing_mode::shared;
+        req.populate = mmap_access::populate_strategy::prefault;
+        mmap view(in, req);
+        asyncle::bench::do_not_optimize(asyncle::io::crc32c(view));
+    });
+
+    asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+    for(size_t concurrency : { size_t { 1 }, size_t { 4 } }) {
+        suite.run("snapshot/load_snapshot/concurrency=" + std::to_string(concurrency), size, [&] {
+            asyncle::io::evict(in);
+            asyncle::bench::do_not_optimize(asyncle::io::load_snapshot(in, pool, { .concurrency = concurrency }));
+        });
+    }
+}
+
+// A file with 1 MiB of data every 8 MiB: copy_file_range over the whole range
+// (holes read and written back as zeros) versus sparse_copy, and scan_data
+void run_sparse(asyncle::bench::suite& suite, size_t size, const std::string& copy_path) {
+    const std::string sparse_path = copy_path + ".sparse";
+    const auto        fresh = mode(access_mode::read_write, access_mode::create, access_mode::truncate);
+    file              in(sparse_path.c_str(), fresh);
+    file              out(copy_path.c_str(), fresh);
+    std::vector<char> data(1 << 20, 's');
+    bool              ready = in && out && in.truncate(size);
+    for(size_t at = 0; ready && at < size; at += 8 << 20) ready = in.write(data.data(), data.size(), at).has_value();
+    if(!ready) {
+        suite.skip("sparse", "cannot create a sparse file next to " + copy_path);
+        ::unlink(sparse_path.c_str());
+        return;
+    }
+
+    stream_transfer stream;
+    suite.run("sparse/copy_file_range", size, [&] {
+        out.truncate(0);
+        asyncle::bench::do_not_optimize(stream.copy(in, 0, out, 0, size));
+    });
+    suite.run("sparse/sparse_copy", size, [&] {
+        out.truncate(0);
+        asyncle::bench::do_not_optimize(asyncle::io::sparse_copy(in, out));
+    });
+    suite.run("sparse/scan_data", size, [&] {
+        uint64_t sum = 0;
+        asyncle::io::scan_data(in, [&](uint64_t, std::span<const std::byte> bytes) {
+            for(size_t i = 0; i < bytes.size(); i += 4096) sum += static_cast<uint64_t>(bytes[i]);
+        });
+        asyncle::bench::do_not_optimize(sum);
+    });
+    ::unlink(sparse_path.c_str());
+}
+
+// The scratch file split on '\n' (one every 256 bytes): std::getline, then
+// record_reader through pread blocks and through the mmap window
+void run_records(asyncle::bench::suite& suite, const std::string& path, file& in, size_t size) {
+    suite.run("records/getline", size, [&] {
+        std::ifstream stream(path, std::ios::binary);
+        std::string   line;
+        uint64_t      total = 0;
+        while(std::getline(stream, line)) total += line.size();
+        asyncle::bench::do_not_optimize(total);
+    });
+    for(record_source source : { record_source::read, record_source::mapped }) {
+        const size_t block = source == record_source::read ? size_t { 1 } << 20 : size_t { 16 } << 20;
+        suite.run(source == record_source::read ? "records/record_reader/read" : "records/record_reader/mapped",
+                  size,
+                  [&] {
+                      record_reader reader(in, { .block_size = block, .source = source });
+                      uint64_t      total = 0;
+                      reader.for_each([&](std::string_view record) { total += record.size(); });
+                      asyncle::bench::do_not_optimize(total);
+                  });
+    }
+}
+
+// 8 MiB of 64-byte records appended to a truncated file: one write per record,
+// then buffered_writer with the writer thread and inline
+void run_buffered_writer(asyncle::bench::suite& suite, const std::string& copy_path) {
+    file out(copy_path.c_str(), mode(access_mode::write_only, access_mode::create, access_mode::truncate));
+    if(!out) {
+        suite.skip("writer", "cannot create " + copy_path);
+        return;
+    }
+    constexpr size_t record = 64, total = size_t { 8 } << 20;
+    const std::vector<char> data(record, 'r');
+
+    suite.run("writer/per_record_write", total, [&] {
+        out.truncate(0);
+        for(uint64_t at = 0; at < total; at += record) {
+            asyncle::bench::do_not_optimize(out.write(data.data(), record, at));
+        }
+    });
+    for(bool background : { true, false }) {
+        suite.run(background ? "writer/buffered/background" : "writer/buffered/inline", total, [&] {
+            out.truncate(0);
+            buffered_writer writer(out, { .buffer_size = 256 * 1024, .background = background });
+            for(size_t at = 0; at < total; at += record) {
+                asyncle::bench::do_not_optimize(writer.write(data.data(), record));
+            }
+            asyncle::bench::do_not_optimize(writer.close());
+        });
+    }
+}
+
+// A 64 x 256 file tree walked with statx per entry: on the calling thread
+// (pool stopped), then on four workers, per-entry statx versus ring batches
+void run_tree_walk(asyncle::bench::suite& suite, const std::string& root) {
+    constexpr int dirs = 64, files = 256;
+    bool          ready = ::mkdir(root.c_str(), 0700) == 0;
+    for(int d = 0; ready && d < dirs; ++d) {
+        const std::string sub = root + "/d" + std::to_string(d);
+        ready                 = ::mkdir(sub.c_str(), 0700) == 0;
+        for(int f = 0; ready && f < files; ++f) {
+            ready = static_cast<bool>(file((sub + "/f" + std::to_string(f)).c_str(),
+                                           mode(access_mode::write_only, access_mode::create)));
+        }
+    }
+
+    if(ready) {
+        asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+        auto walk = [&](std::string_view name, bool use_ring) {
+            suite.run(name, 0, [&] {
+                std::atomic<uint64_t> bytes { 0 };
+                walk_tree(root.c_str(), pool, [&](const walk_entry& e) {
+                    bytes.fetch_add(e.info.size, std::memory_order_relaxed);
+                }, { .use_ring = use_ring });
+                asyncle::bench::do_not_optimize(bytes.load());
+            });
+        };
+        walk("tree_walk/parallel/statx", false);
+        walk("tree_walk/parallel/ring", true);
+        pool.stop();
+        walk("tree_walk/serial/statx", false);
+        walk("tree_walk/serial/ring", true);
+    } else {
+        suite.skip("tree_walk", "cannot create a tree in " + root);
+    }
+
+    for(int d = 0; d < dirs; ++d) {
+        const std::string sub = root + "/d" + std::to_string(d);
+        for(int f = 0; f < files; ++f) ::unlink((sub + "/f" + std::to_string(f)).c_str());
+        ::rmdir(sub.c_str());
+    }
+    ::rmdir(root.c_str());
+}
+
+// 256 shards splitting size between them, each opened and read whole per op:
+// one pread loop per shard, or a reused read_scheduler with a driver and two
+// consumers (inline pread or io_ring, depth 32 on the one device)
+void run_scan(asyncle::bench::suite& suite, const std::string& dir, size_t size) {
+    constexpr int            shards = 256;
+    const size_t             shard  = size / shards;
+    bool                     ready  = ::mkdir(dir.c_str(), 0700) == 0;
+    std::vector<std::string> paths;
+    for(int i = 0; ready && i < shards; ++i) {
+        paths.push_back(dir + "/shard" + std::to_string(i));
+        ready = create_scratch(paths.back(), shard);
+    }
+
+    if(ready) {
+        constexpr size_t  block = 256 * 1024;
+        std::vector<char> buffer(block);
+        suite.run("scan/serial_pread/shards=256", shards * shard, [&] {
+            uint64_t sum = 0;
+            for(const auto& path : paths) {
+                file in(path.c_str(), access_mode::read_only);
+                for(uint64_t offset = 0;; offset += block) {
+                    auto got = in.read(buffer.data(), block, offset);
+                    if(!got || *got == 0) break;
+                    sum += static_cast<uint8_t>(buffer[0]);
+                }
+            }
+            asyncle::bench::do_not_optimize(sum);
+        });
+
+        for(bool ring : { false, true }) {
+            const std::string name = std::string("scan/read_scheduler/") + (ring ? "ring" : "pread") + "/shards=256";
+            if(!suite.selected(name)) continue;
+            read_scheduler scan({ .block_size = block, .buffers = 64, .use_ring = ring });
+            suite.run(name, shards * shard, [&] {
+                for(const auto& path : paths) scan.add(path.c_str());
+                std::atomic<uint64_t>    sum { 0 };
+                std::vector<std::thread> consumers;
+                for(int c = 0; c < 2; ++c) {
+                    consumers.emplace_back([&] {
+                        read_chunk chunk;
+                        while(scan.next(chunk)) {
+                            sum.fetch_add(static_cast<uint8_t>(chunk.data[0]), std::memory_order_relaxed);
+                            scan.release(chunk);
+                        }
+                    });
+                }
+                scan.run();
+                for(auto& t : consumers) t.join();
+                asyncle::bench::do_not_optimize(sum.load());
+            });
+        }
+    } else {
+        suite.skip("scan", "cannot create shards in " + dir);
+    }
+
+    for(const auto& path : paths) ::unlink(path.c_str());
+    ::rmdir(dir.c_str());
+}
+
+// Log-like text the size of the scratch file, written plainly versus through
+// compressed_writer (lz4, inline or on a 4-worker pool), then read back whole
+// versus decoded inline or ahead on the pool. GB/s counts raw bytes, so the
+// compressed cases win only where the device, not the codec, is the limit.
+void run_compressed(asyncle::bench::suite& suite, size_t size, const std::string& copy_path) {
+    std::vector<char> raw;
+    raw.reserve(size);
+    for(uint64_t i = 0; raw.size() < size; ++i) {
+        auto line = "ts=" + std::to_string(1700000000 + i / 8) + " id=" + std::to_string(i * 2654435761u % 100003)
+                  + " op=get status=200\n";
+        raw.insert(raw.end(), line.begin(), line.end());
+    }
+    raw.resize(size);
+
+    const auto        rw = mode(access_mode::read_write, access_mode::create, access_mode::truncate);
+    std::vector<char> back(size);
+    suite.run("compressed/plain_write", size, [&] {
+        file out(copy_path.c_str(), rw);
+        asyncle::bench::do_not_optimize(out.write_all(raw.data(), raw.size(), 0));
+    });
+    {
+        file plain(copy_path.c_str(), access_mode::read_only);
+        suite.run("compressed/plain_read", size,
+                  [&] { asyncle::bench::do_not_optimize(plain.read(back.data(), back.size(), 0)); });
+    }
+
+    asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+    for(bool pooled : { false, true }) {
+        suite.run(std::string("compressed/write/lz4/") + (pooled ? "pool" : "inline"), size, [&] {
+            file              out(copy_path.c_str(), rw);
+            compressed_writer writer(out, {}, pooled ? &pool : nullptr);
+            asyncle::bench::do_not_optimize(writer.write(raw.data(), raw.size()));
+            asyncle::bench::do_not_optimize(writer.finish());
+        });
+    }
+
+    file in(copy_path.c_str(), access_mode::read_only);
+    if(auto stored = in.size(); stored && *stored) {
+        suite.context("compressed_ratio", std::to_string(static_cast<double>(size) / *stored));
+    }
+    suite.run("compressed/read/lz4/inline", size, [&] {
+        compressed_reader reader(in);
+        asyncle::bench::do_not_optimize(reader.read(back.data(), back.size(), 0));
+    });
+    suite.run("compressed/read/lz4/pool", size, [&] {
+        compressed_reader reader(in);
+        uint64_t          sum = 0;
+        asyncle::bench::do_not_optimize(reader.for_each_block(
+          pool, [&](uint64_t, std::span<const std::byte> block) { sum += static_cast<uint8_t>(block[0]); }));
+        asyncle::bench::do_not_optimize(sum);
+    });
+}
+
+// 256-byte journal records appended by 1 or 8 threads, 64 each per op; every
+// append waits for its sync, so the gap is what group commit saves
+void run_journal(asyncle::bench::suite& suite, const std::string& dir) {
+    if(::mkdir(dir.c_str(), 0700) != 0) {
+        suite.skip("journal/append", "cannot create " + dir);
+        return;
+    }
+    const std::vector<std::byte> record(256, std::byte { 'j' });
+    constexpr int                per_thread = 64;
+    for(int threads : { 1, 8 }) {
+        asyncle::io::journal wal;
+        if(!wal.open(dir.c_str())) {
+            suite.skip("journal/append", "cannot open journal in " + dir);
+            break;
+        }
+        suite.run("journal/append/threads=" + std::to_string(threads), threads * per_thread * record.size(), [&] {
+            std::vector<std::thread> appenders;
+            for(int t = 0; t < threads; ++t) {
+                appenders.emplace_back([&] {
+                    for(int i = 0; i < per_thread; ++i) asyncle::bench::do_not_optimize(wal.append(record));
+                });
+            }
+            for(auto& a : appenders) a.join();
+        });
+    }
+    for(uint64_t sequence = 0;; ++sequence) {
+        if(::unlink(asyncle::io::detail::journal_segment_path(dir, "wal", sequence).c_str()) != 0) break;
+    }
+    ::rmdir(dir.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if(argc > 1 && std::strcmp(argv[1], "--pool-worker") == 0) return run_echo_worker();
+    if(argc > 3 && std::strcmp(argv[1], "--shm-worker") == 0) {
+        return run_shm_echo_worker(std::atoi(argv[2]), std::atoi(argv[3]));
+    }
+
+    asyncle::bench::suite suite("io", argc, argv);
+
+    const char*  tmp      = std::getenv("TMPDIR");
+    std::string  dir      = std::string(suite.value("dir", tmp && *tmp ? tmp : "/tmp"));
+    const size_t size_mib = std::strtoull(std::string(suite.value("file-size", "64")).c_str(), nullptr, 10);
+    const size_t size     = (size_mib ? size_mib : 64) << 20;
+    std::string  path     = dir + "/asyncle_bench_io." + std::to_string(::getpid()) + ".dat";
+    std::string  copy     = path + ".copy";
+
+    utsname host {};
+    ::uname(&host);
+    suite.context("kernel", host.release);
+    suite.context("page_size", std::to_string(mmap::page_size()));
+    suite.context("file_size", std::to_string(size));
+    suite.context("dir", dir);
+
+    if(!create_scratch(path, size)) {
+        suite.skip("io", "cannot create scratch file in " + dir);
+        return suite.finish();
+    }
+
+    {
+        file buffered(path.c_str(), access_mode::read_only);
+        auto buffered_pool = dio_buffer_pool::for_file(buffered, block_sizes[std::size(block_sizes) - 1], 1);
+        run_reads(suite, "read_buffered", buffered, size, buffered_pool);
+        run_readv(suite, buffered, size);
+
+        file direct(path.c_str(), mode(access_mode::read_only, access_mode::direct));
+        if(direct) {
+            auto direct_pool = dio_buffer_pool::for_file(direct, block_sizes[std::size(block_sizes) - 1], 1);
+            run_reads(suite, "read_direct", direct, size, direct_pool);
+            run_ring(suite, "direct", direct, size, 64 * 1024);
+        } else {
+            suite.skip("file/read_direct", "O_DIRECT not supported in " + dir);
+        }
+        run_ring(suite, "buffered", buffered, size, 64 * 1024);
+
+        run_mmap(suite, buffered, size);
+        run_zero_copy(suite, buffered, size, copy);
+        run_mapped_copy(suite, buffered, size, copy);
+        run_mapped_growth(suite, copy);
+        run_prewarm(suite, buffered, size);
+        run_snapshot(suite, buffered, size);
+        run_records(suite, path, buffered, size);
+    }
+    run_buffered_writer(suite, copy);
+    run_compressed(suite, size, copy);
+    run_sparse(suite, size, copy);
+    run_process_pipe(suite, size, copy);
+    run_process_pool(suite);
+    run_tree_walk(suite, path + ".tree");
+    run_scan(suite, path + ".shards", size);
+    run_journal(suite, path + ".journal");
+
+    ::unlink(copy.c_str());
+    ::unlink(path.c_str());
+    return suite.finish();
+}
@@ -0,0 +1,374 @@
+#ifndef ASYNCLE_ASYNC_TASK_HPP
+#define ASYNCLE_ASYNC_TASK_HPP
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asyncle::async {
+
+// ============================================================================
+// Awaitable Traits
+// ============================================================================
+
+namespace detail {
+
+template <typename A>
+concept has_member_co_await = requires(A&& a) { std::forward<A>(a).operator co_await(); };
+
+template <typename A>
+decltype(auto) get_awaiter(A&& a) {
+    if constexpr(has_member_co_await<A>) {
+        return std::forward<A>(a).operator co_await();
+    } else {
+        return std::forward<A>(a);
+    }
+}
+
+}  // namespace detail
+
+// Type produced by co_await on an A
+template <typename A>
+using await_result_t = decltype(detail::get_awaiter(std::declval<A>()).await_resume());
+
+template <typename A>
+concept awaitable = requires(A&& a) {
+    { detail::get_awaiter(std::forward<A>(a)).await_ready() } -> std::convertible_to<bool>;
+    detail::get_awaiter(std::forward<A>(a)).await_resume();
+};
+
+// ============================================================================
+// Task
+// ============================================================================
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+// Resumes whoever awaited the task, or nobody when it was started directly
+struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+        std::coroutine_handle<> next = self.promise().continuation;
+        return next ? next : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct promise_base {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr      exception;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    void rethrow_if_failed() const {
+        if(exception) std::rethrow_exception(exception);
+    }
+};
+
+template <typename T>
+struct task_promise: promise_base {
+    std::optional<T> value;
+
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    requires std::is_constructible_v<T, U&&>
+    void return_value(U&& v) {
+        value.emplace(std::forward<U>(v));
+    }
+
+    T take() {
+        rethrow_if_failed();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct task_promise<void>: promise_base {
+    task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take() const { rethrow_if_failed(); }
+};
+
+}  // namespace detail
+
+// Lazy coroutine: the body starts when the task is awaited (or start()ed) and
+// resumes its awaiter through symmetric transfer when it finishes (a tail call
+// in optimized builds, so long chains of tasks do not grow the stack). A task
+// runs on whichever thread resumes it: after co_await on a ring read it
+// continues on the thread that polled the ring, after co_await
+// schedule(pool) on a pool worker.
+//
+//   task<size_t> copy(ring_scheduler& ring, file& in, file& out);
+//   size_t copied = ring.run(copy(ring, in, out));      // Drive to completion
+//
+// Exceptions escaping the body are rethrown from co_await (or result()).
+template <typename T>
+class [[nodiscard]] task {
+    public:
+    using promise_type = detail::task_promise<T>;
+    using value_type   = T;
+
+    private:
+    std::coroutine_handle<promise_type> handle_;
+
+    public:
+    task() noexcept = default;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept: handle_(handle) {}
+
+    task(task&& other) noexcept: handle_(std::exchange(other.handle_, nullptr)) {}
+
+    task& operator=(task&& other) noexcept {
+        if(this != &other) {
+            if(handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    task(const task&)            = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if(handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return awaiter { handle_ };
+    }
+
+    // Run the body on this thread up to its first suspension, with nobody to
+    // resume at the end; a driver then polls done()
+    void start() {
+        if(handle_ && !handle_.done()) handle_.resume();
+    }
+
+    // Only meaningful on the thread that drives the task (see sync_wait otherwise)
+    bool done() const noexcept { return !handle_ || handle_.done(); }
+
+    // Value of a finished task; rethrows what escaped the body
+    T result() { return handle_.promise().take(); }
+
+    bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+    explicit operator bool() const noexcept { return valid(); }
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Completion Signalling
+// ============================================================================
+
+namespace detail {
+
+// Eager-on-resume coroutine that reports completion through a callback from
+// whichever thread finished it; the frame is destroyed by its owner
+struct notifying_task {
+    struct promise_type {
+        void (*notify)(void*) = nullptr;
+        void* context         = nullptr;
+
+        notifying_task get_return_object() noexcept {
+            return notifying_task { std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        auto final_suspend() const noexcept {
+            struct notify_awaiter {
+                bool await_ready() const noexcept { return false; }
+
+                void await_suspend(std::coroutine_handle<promise_type> self) const noexcept {
+                    self.promise().notify(self.promise().context);
+                }
+
+                void await_resume() const noexcept {}
+            };
+            return notify_awaiter {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept { std::terminate(); }  // The body catches everything
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Result of an awaited A, or what it threw
+template <typename A>
+struct awaited_slot {
+    using result_type = await_result_t<A>;
+    using stored_type = std::conditional_t<std::is_void_v<result_type>, bool, std::remove_reference_t<result_type>>;
+
+    std::optional<stored_type> value;
+    std::exception_ptr         failure;
+
+    result_type take() {
+        if(failure) std::rethrow_exception(failure);
+        if constexpr(!std::is_void_v<result_type>) return std::move(*value);
+    }
+};
+
+// Await a into slot inside a notifying_task (not started yet)
+template <typename A>
+notifying_task await_into(A&& a, awaited_slot<A>& slot) {
+    try {
+        if constexpr(std::is_void_v<await_result_t<A>>) {
+            co_await std::forward<A>(a);
+            slot.value.emplace(true);
+        } else {
+            slot.value.emplace(co_await std::forward<A>(a));
+        }
+    } catch(...) {
+        slot.failure = std::current_exception();
+    }
+}
+
+// Completion signal for sync_wait; notified under the lock so the waiter
+// cannot return (and free it) until the notifier has let go of it
+struct sync_signal {
+    std::mutex              lock;
+    std::condition_variable ready;
+    bool                    done = false;
+};
+
+}  // namespace detail
+
+// ============================================================================
+// Blocking Wait
+// ============================================================================
+
+// Block the calling thread until a completes on any thread and return its
+// result. For awaitables completed by a pool or another thread; one that
+// needs this thread to poll a ring must go through that driver's run()
+// instead, or it never finishes. Not for use on a pool worker.
+template <typename A>
+requires awaitable<A>
+await_result_t<A> sync_wait(A&& a) {
+    detail::sync_signal     signal;
+    detail::awaited_slot<A> slot;
+    detail::notifying_task  waiter = detail::await_into(std::forward<A>(a), slot);
+
+    waiter.handle.promise().context = &signal;
+    waiter.handle.promise().notify  = [](void* context) noexcept {
+        auto*           s = static_cast<detail::sync_signal*>(context);
+        std::lock_guard guard(s->lock);
+        s->done = true;
+        s->ready.notify_one();
+    };
+    waiter.handle.resume();
+    {
+        std::unique_lock guard(signal.lock);
+        signal.ready.wait(guard, [&] { return signal.done; });
+    }
+    waiter.handle.destroy();
+    return slot.take();
+}
+
+// ============================================================================
+// Joining
+// ============================================================================
+
+// Start every task at once and finish when the last one does, yielding their
+// results in order. The tasks run up to their first suspension inside the
+// await, so on a ring_scheduler their first operations share one submit; the
+// joining coroutine continues on whichever thread finishes the last task.
+// The first exception (in task order) is rethrown once all have finished.
+template <typename T>
+task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> when_all(std::vector<task<T>> tasks) {
+    struct join_state {
+        std::atomic<size_t>     remaining;
+        std::coroutine_handle<> parent;
+    };
+
+    struct join_awaiter {
+        join_state&                          state;
+        std::vector<detail::notifying_task>& children;
+
+        bool await_ready() const noexcept { return false; }
+
+        // The extra count held here keeps a child that finishes inline from
+        // resuming the parent before it has suspended
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            state.parent = awaiting;
+            for(auto& child : children) child.handle.resume();
+            return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::vector<detail::awaited_slot<task<T>>> slots(tasks.size());
+    std::vector<detail::notifying_task>        children;
+    join_state                                 state { tasks.size() + 1, {} };
+
+    children.reserve(tasks.size());
+    for(size_t i = 0; i < tasks.size(); ++i) {
+        children.push_back(detail::await_into(std::move(tasks[i]), slots[i]));
+        children.back().handle.promise().context = &state;
+        children.back().handle.promise().notify  = [](void* context) noexcept {
+            auto* joined = static_cast<join_state*>(context);
+            if(joined->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) joined->parent.resume();
+        };
+    }
+
+    co_await join_awaiter { state, children };
+    for(auto& child : children) child.handle.destroy();
+
+    if constexpr(std::is_void_v<T>) {
+        for(auto& slot : slots) slot.take();
+    } else {
+        std::vector<T> results;
+        results.reserve(slots.size());
+        for(auto& slot : slots) results.push_back(slot.take());
+        co_return results;
+    }
+}
+
+}  // namespace asyncle::async
+
+#endif  // ASYNCLE_ASYNC_TASK_HPP
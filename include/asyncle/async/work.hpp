@@ -0,0 +1,159 @@
+#ifndef ASYNCLE_ASYNC_WORK_HPP
+#define ASYNCLE_ASYNC_WORK_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../concurrent/thread_pool.hpp"
+#include "task.hpp"
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle::async {
+
+// Anything that runs submitted tasks through work(ex, submit_command {}, fn),
+// such as concurrent::work_stealing_pool
+template <typename E>
+concept executor = requires(E& ex, void (*fn)()) {
+    { asyncle::work(ex, concurrent::submit_command {}, fn) };
+};
+
+namespace detail {
+
+template <typename E, typename F>
+bool submit_to(E& ex, F&& fn) {
+    return asyncle::work(ex, concurrent::submit_command {}, std::forward<F>(fn)).has_value();
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Executor Hops
+// ============================================================================
+
+// co_await schedule(pool) continues the coroutine on a pool worker. When the
+// pool rejects the task (stopped or full) it continues inline and the await
+// yields false, so callers that must not block can tell.
+template <executor E>
+class schedule_awaiter {
+    E&   ex_;
+    bool queued_ = false;
+
+    public:
+    explicit schedule_awaiter(E& ex) noexcept: ex_(ex) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    // queued_ is set before the submit: once queued, the worker may resume
+    // (and destroy) the awaiting frame before submit_to even returns
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        queued_ = true;
+        if(detail::submit_to(ex_, [awaiting] { awaiting.resume(); })) return true;
+        queued_ = false;
+        return false;
+    }
+
+    bool await_resume() const noexcept { return queued_; }
+};
+
+template <executor E>
+schedule_awaiter<E> schedule(E& ex) noexcept {
+    return schedule_awaiter<E>(ex);
+}
+
+// co_await offload(pool, fn) runs fn() on a pool worker and continues there
+// with its result. A rejected task runs inline, as parse_parallel does, so
+// the result is always produced; exceptions from fn are rethrown at the await.
+template <executor E, typename F>
+class offload_awaiter {
+    using result_type = std::invoke_result_t<F&>;
+    using stored_type = std::conditional_t<std::is_void_v<result_type>, bool, result_type>;
+
+    E&                         ex_;
+    F                          fn_;
+    std::optional<stored_type> value_;
+    std::exception_ptr         failure_;
+
+    void run() noexcept {
+        try {
+            if constexpr(std::is_void_v<result_type>) {
+                fn_();
+                value_.emplace(true);
+            } else {
+                value_.emplace(fn_());
+            }
+        } catch(...) {
+            failure_ = std::current_exception();
+        }
+    }
+
+    public:
+    offload_awaiter(E& ex, F fn): ex_(ex), fn_(std::move(fn)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        if(detail::submit_to(ex_, [this, awaiting] {
+               run();
+               awaiting.resume();
+           })) {
+            return true;
+        }
+        run();
+        return false;
+    }
+
+    result_type await_resume() {
+        if(failure_) std::rethrow_exception(failure_);
+        if constexpr(!std::is_void_v<result_type>) return std::move(*value_);
+    }
+};
+
+template <executor E, typename F>
+requires std::is_invocable_v<std::decay_t<F>&>
+offload_awaiter<E, std::decay_t<F>> offload(E& ex, F&& fn) {
+    return offload_awaiter<E, std::decay_t<F>>(ex, std::forward<F>(fn));
+}
+
+// ============================================================================
+// CPO: async_work
+// ============================================================================
+
+// Asynchronous form of work(obj, cmd, payload): co_await async_work(sched,
+// obj, cmd, payload) yields the same cmd_result_t<Cmd, P> that work returns.
+//
+// The scheduler decides how the operation completes. A scheduler with a
+// native form for obj supplies it through
+//   tag_invoke(async_work_t, Sched&, T&, Cmd, P&&) -> awaitable
+// (a ring_scheduler reads and writes files through io_uring, a
+// pipe_scheduler waits for pipe readiness). Any other executor runs the
+// synchronous work(obj, cmd, payload) on one of its threads, so every
+// workable object gets an async form for free.
+//
+// The payload is moved into the operation and obj must outlive the await.
+struct async_work_t {
+    template <class S, class T, class Cmd, class P>
+    requires(cmd_accepts_v<Cmd, P> && tag_invocable<async_work_t, S&, T&, Cmd, P &&>)
+    auto operator()(S& sched, T& obj, Cmd cmd, P&& payload) const
+      -> tag_invoke_result_t<async_work_t, S&, T&, Cmd, P&&> {
+        return tag_invoke(*this, sched, obj, cmd, std::forward<P>(payload));
+    }
+
+    template <class S, class T, class Cmd, class P>
+    requires(cmd_accepts_v<Cmd, P> && !tag_invocable<async_work_t, S&, T&, Cmd, P &&> && executor<S>
+             && requires(T& o, Cmd c, std::decay_t<P>& p) { asyncle::work(o, c, std::move(p)); })
+    auto operator()(S& sched, T& obj, Cmd cmd, P&& payload) const {
+        return offload(sched, [&obj, cmd, p = std::decay_t<P>(std::forward<P>(payload))]() mutable {
+            return asyncle::work(obj, cmd, std::move(p));
+        });
+    }
+};
+
+inline constexpr async_work_t async_work {};
+
+}  // namespace asyncle::async
+
+#endif  // ASYNCLE_ASYNC_WORK_HPP
@@ -3,7 +3,9 @@
 
 #include "../compat.hpp"
 #include "../meta/entries.hpp"
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace asyncle {
 
@@ -19,6 +21,16 @@ struct command {
 
     template <class P>
     using result_t = std::conditional_t<accepts<P>, expected<payload_t<P>, error_type>, void>;
+
+    // Flat table view: payload P selects entry index_of<P> (entry_count when
+    // it selects none), and entry I yields result_at<I>
+    static constexpr std::size_t entry_count = sizeof...(Entries);
+
+    template <class P>
+    static constexpr std::size_t index_of = first_match<P, Entries...>::index;
+
+    template <std::size_t I>
+    using result_at = expected<entry_mapped_t<pack_element_t<I, Entries...>>, error_type>;
 };
 
 template <class Cmd>
@@ -29,6 +41,26 @@ using cmd_result_t = typename Cmd::template result_t<P>;
 template <class Cmd, class P>
 inline constexpr bool cmd_accepts_v = Cmd::template accepts<P>;
 
+template <class Cmd>
+concept indexed_command = requires {
+    { Cmd::entry_count } -> std::convertible_to<std::size_t>;
+};
+
+// Runtime dispatch on an entry index: fn(std::integral_constant<size_t, I>)
+// is reached through one constexpr table of thunks, which compiles to an
+// indexed jump instead of a chain of compares. Every instantiation of fn must
+// return the same type; index must be below Cmd::entry_count.
+template <indexed_command Cmd, class F>
+requires(Cmd::entry_count > 0)
+constexpr decltype(auto) dispatch_entry(std::size_t index, F&& fn) {
+    using result = decltype(fn(std::integral_constant<std::size_t, 0> {}));
+    using thunk  = result (*)(F&);
+    return [&]<std::size_t... I>(std::index_sequence<I...>) -> result {
+        constexpr thunk table[] = { [](F& f) -> result { return f(std::integral_constant<std::size_t, I> {}); }... };
+        return table[index](fn);
+    }(std::make_index_sequence<Cmd::entry_count> {});
+}
+
 template <class T>
 concept is_command = requires {
     typename T::error_type;
@@ -2,6 +2,10 @@
 #define ASYNCLE_CPO_HPP
 
 #include "command.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -39,6 +43,60 @@ struct work_t {
 
 inline constexpr work_t work {};
 
+// CPO: work_batch
+// Batch form of work: runs cmd on every payload and stores item i's result in
+// results[i], returning how many leading items got a result (the shorter of
+// the two ranges unless the object stops early; later results are untouched).
+// Payloads are passed as lvalues, as in work(obj, cmd, payloads[i]).
+//
+//   io_request             writes[64];
+//   file_result<io_result> done[64];
+//   size_t n = work_batch(file, write_command {}, writes, done);   // One pwritev for contiguous writes
+//
+// Objects amortize per-call fixed costs (one syscall, one CAS, one lock for
+// N items) through
+//   tag_invoke(work_batch_t, T&, Cmd, std::span<P>, std::span<cmd_result_t<Cmd, P>>) -> size_t
+// or a work_batch(cmd, payloads, results) member; anything else falls back
+// to one work() call per item.
+struct work_batch_t {
+    template <class Ps>
+    using payload_of = std::remove_reference_t<std::ranges::range_reference_t<Ps>>;
+
+    template <class Rs>
+    using result_of = std::remove_reference_t<std::ranges::range_reference_t<Rs>>;
+
+    template <class T, class Cmd, class P, class R>
+    static constexpr bool has_tag_invoke = tag_invocable<work_batch_t, T&, Cmd, std::span<P>, std::span<R>>;
+
+    template <class T, class Cmd, class P, class R>
+    static constexpr bool has_member = requires(T& o, Cmd c, std::span<P> ps, std::span<R> rs) {
+        { o.work_batch(c, ps, rs) } -> std::convertible_to<size_t>;
+    };
+
+    template <class T, class Cmd, class P>
+    static constexpr bool has_work = requires(T& o, Cmd c, P& p) { work_t {}(o, c, p); };
+
+    template <class T, class Cmd, std::ranges::contiguous_range Ps, std::ranges::contiguous_range Rs>
+    requires(cmd_accepts_v<Cmd, payload_of<Ps>&> && std::same_as<result_of<Rs>, cmd_result_t<Cmd, payload_of<Ps>&>>
+             && (has_tag_invoke<T, Cmd, payload_of<Ps>, result_of<Rs>>
+                 || has_member<T, Cmd, payload_of<Ps>, result_of<Rs>> || has_work<T, Cmd, payload_of<Ps>>))
+    constexpr size_t operator()(T& obj, Cmd cmd, Ps&& payloads, Rs&& results) const {
+        std::span<payload_of<Ps>> items(payloads);
+        std::span<result_of<Rs>>  out(results);
+        if constexpr(has_tag_invoke<T, Cmd, payload_of<Ps>, result_of<Rs>>) {
+            return tag_invoke(*this, obj, cmd, items, out);
+        } else if constexpr(has_member<T, Cmd, payload_of<Ps>, result_of<Rs>>) {
+            return obj.work_batch(cmd, items, out);
+        } else {
+            size_t count = std::min(items.size(), out.size());
+            for(size_t i = 0; i < count; ++i) out[i] = work_t {}(obj, cmd, items[i]);
+            return count;
+        }
+    }
+};
+
+inline constexpr work_batch_t work_batch {};
+
 // CPO: can_work
 struct can_work_t {
     template <class T, class Cmd>
@@ -0,0 +1,209 @@
+#ifndef ASYNCLE_DYNAMIC_WORKER_HPP
+#define ASYNCLE_DYNAMIC_WORKER_HPP
+
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/arch/current.hpp"
+#include "command.hpp"
+#include "cpo.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle {
+
+// ============================================================================
+// Type-Erased Worker
+// ============================================================================
+
+// What dynamic_worker erases: the work half of workable, for any payload
+// form (workable itself also asks for can_work and aggregate payloads)
+template <class T, class Cmd, class P>
+concept erasable_worker = requires(T& t, Cmd cmd, P&& payload) {
+    { asyncle::work(t, cmd, std::forward<P>(payload)) } -> std::same_as<cmd_result_t<Cmd, P>>;
+};
+
+// dynamic_worker<Cmd, P> holds any erasable_worker<T, Cmd, P> chosen at
+// runtime and answers work/can_work itself, so code written against the
+// CPOs takes either form. can_work forwards to the object when it has one
+// and reports TRUE otherwise.
+//
+//   dynamic_worker<write_command, const io_request&> sink(io::file {...});
+//   auto wrote = work(sink, write_command {}, req);     // One indirect call
+//
+// Objects that fit the inline buffer and move without throwing live inside
+// the worker, which is then exactly one cache line; anything else goes to the
+// heap. Dispatch is one call through a static per-type table (no
+// std::function, no allocation for small handlers).
+//
+// When the likely types are known, work_as<A, B>(cmd, payload) compares the
+// table pointer and calls the concrete work directly, so the compiler can
+// inline it; target<T>() gives the object itself.
+//
+// P is the payload as work receives it: const io_request& for lvalue
+// payloads, a value type to take ownership.
+template <class Cmd, class P, std::size_t Size = hardware::cache_line_size - sizeof(void*)>
+requires(is_command<Cmd> && cmd_accepts_v<Cmd, P>)
+class dynamic_worker {
+    public:
+    using command_type = Cmd;
+    using result_type  = cmd_result_t<Cmd, P>;
+
+    static constexpr std::size_t inline_size = Size;
+
+    template <class T>
+    static constexpr bool stores_inline = sizeof(T) <= Size && alignof(T) <= alignof(std::max_align_t)
+                                       && std::is_nothrow_move_constructible_v<T>;
+
+    private:
+    struct vtable {
+        result_type (*work)(void* storage, Cmd cmd, P&& payload);
+        check_status (*can_work)(void* storage, Cmd cmd);
+        void (*relocate)(void* from, void* to) noexcept;  // Move into to and destroy from
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <class T>
+    struct model {
+        static T& get(void* storage) noexcept {
+            if constexpr(stores_inline<T>) {
+                return *std::launder(static_cast<T*>(storage));
+            } else {
+                return **static_cast<T**>(storage);
+            }
+        }
+
+        static result_type work(void* storage, Cmd cmd, P&& payload) {
+            return asyncle::work(get(storage), cmd, std::forward<P>(payload));
+        }
+
+        static check_status can_work(void* storage, Cmd cmd) {
+            if constexpr(requires { { asyncle::can_work(get(storage), cmd) } -> checkable; }) {
+                return asyncle::can_work(get(storage), cmd);
+            } else {
+                return check_status::TRUE;
+            }
+        }
+
+        static void relocate(void* from, void* to) noexcept {
+            if constexpr(stores_inline<T>) {
+                T& source = get(from);
+                ::new(to) T(std::move(source));
+                source.~T();
+            } else {
+                *static_cast<T**>(to) = *static_cast<T**>(from);
+            }
+        }
+
+        static void destroy(void* storage) noexcept {
+            if constexpr(stores_inline<T>) {
+                get(storage).~T();
+            } else {
+                delete *static_cast<T**>(storage);
+            }
+        }
+
+        static constexpr vtable table { &work, &can_work, &relocate, &destroy };
+    };
+
+    alignas(std::max_align_t) std::byte storage_[Size];
+    const vtable*                       vtable_ = nullptr;
+
+    template <class T, class... Args>
+    void construct(Args&&... args) {
+        if constexpr(stores_inline<T>) {
+            ::new(static_cast<void*>(storage_)) T(std::forward<Args>(args)...);
+        } else {
+            static_assert(Size >= sizeof(T*), "inline buffer cannot hold a pointer");
+            ::new(static_cast<void*>(storage_)) T*(new T(std::forward<Args>(args)...));
+        }
+        vtable_ = &model<T>::table;
+    }
+
+    public:
+    // Constructors
+    dynamic_worker() noexcept = default;
+
+    template <class T>
+    requires(!std::same_as<std::remove_cvref_t<T>, dynamic_worker>
+             && erasable_worker<std::remove_cvref_t<T>, Cmd, P>
+             && std::constructible_from<std::remove_cvref_t<T>, T &&>)
+    dynamic_worker(T&& obj) {
+        construct<std::remove_cvref_t<T>>(std::forward<T>(obj));
+    }
+
+    template <class T, class... Args>
+    requires(erasable_worker<T, Cmd, P> && std::constructible_from<T, Args && ...>)
+    explicit dynamic_worker(std::in_place_type_t<T>, Args&&... args) {
+        construct<T>(std::forward<Args>(args)...);
+    }
+
+    dynamic_worker(dynamic_worker&& other) noexcept: vtable_(other.vtable_) {
+        if(vtable_) vtable_->relocate(other.storage_, storage_);
+        other.vtable_ = nullptr;
+    }
+
+    dynamic_worker& operator=(dynamic_worker&& other) noexcept {
+        if(this != &other) {
+            reset();
+            vtable_ = other.vtable_;
+            if(vtable_) vtable_->relocate(other.storage_, storage_);
+            other.vtable_ = nullptr;
+        }
+        return *this;
+    }
+
+    dynamic_worker(const dynamic_worker&)            = delete;
+    dynamic_worker& operator=(const dynamic_worker&) = delete;
+
+    // Destructor
+    ~dynamic_worker() { reset(); }
+
+    template <class T, class... Args>
+    requires(erasable_worker<T, Cmd, P> && std::constructible_from<T, Args && ...>)
+    T& emplace(Args&&... args) {
+        reset();
+        construct<T>(std::forward<Args>(args)...);
+        return model<T>::get(storage_);
+    }
+
+    void reset() noexcept {
+        if(vtable_) vtable_->destroy(storage_);
+        vtable_ = nullptr;
+    }
+
+    // State queries
+    explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+    template <class T>
+    bool holds() const noexcept {
+        return vtable_ == &model<T>::table;
+    }
+
+    // The stored object when it is a T, nullptr otherwise
+    template <class T>
+    T* target() noexcept {
+        return holds<T>() ? &model<T>::get(storage_) : nullptr;
+    }
+
+    // Operations (the worker must not be empty)
+    result_type work(Cmd cmd, P&& payload) { return vtable_->work(storage_, cmd, std::forward<P>(payload)); }
+
+    check_status can_work(Cmd cmd) { return vtable_->can_work(storage_, cmd); }
+
+    // Direct call when the object is one of T, Ts..., the table otherwise
+    template <class T, class... Ts>
+    result_type work_as(Cmd cmd, P&& payload) {
+        if(holds<T>()) return asyncle::work(model<T>::get(storage_), cmd, std::forward<P>(payload));
+        if constexpr(sizeof...(Ts) > 0) {
+            return work_as<Ts...>(cmd, std::forward<P>(payload));
+        } else {
+            return work(cmd, std::forward<P>(payload));
+        }
+    }
+};
+
+}  // namespace asyncle
+
+#endif  // ASYNCLE_DYNAMIC_WORKER_HPP
@@ -0,0 +1,162 @@
+#ifndef ASYNCLE_CONCURRENT_CHASE_LEV_DEQUE_HPP
+#define ASYNCLE_CONCURRENT_CHASE_LEV_DEQUE_HPP
+
+#include "../hardware/memory.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace asyncle::concurrent {
+
+// Growable work-stealing deque (Chase-Lev, with the C11 orderings from
+// Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+// The owning thread pushes and takes at the bottom (LIFO, no CAS unless racing
+// for the last element); any thread may steal from the top (FIFO, one CAS).
+// Elements must be trivially copyable and lock-free atomic (task pointers).
+//
+// Growing copies into a buffer twice the size. Old buffers may still be read by
+// in-flight stealers, so they are kept on a retired list until destruction.
+template <typename T>
+class chase_lev_deque {
+    static_assert(std::is_trivially_copyable_v<T>, "Elements must be trivially copyable");
+    static_assert(std::atomic<T>::is_always_lock_free, "Elements must be lock-free atomics");
+
+    struct buffer {
+        int64_t         mask;
+        std::atomic<T>* slots;
+        buffer*         retired;  // Previous (smaller) buffer
+
+        int64_t capacity() const noexcept { return mask + 1; }
+
+        T load(int64_t index) const noexcept { return slots[index & mask].load(std::memory_order_relaxed); }
+
+        void store(int64_t index, T value) noexcept { slots[index & mask].store(value, std::memory_order_relaxed); }
+    };
+
+    hardware::cache_padded<std::atomic<int64_t>> top_ { int64_t { 0 } };
+    hardware::cache_padded<std::atomic<int64_t>> bottom_ { int64_t { 0 } };
+    std::atomic<buffer*>                         buffer_ { nullptr };
+
+    static buffer* allocate(int64_t capacity, buffer* retired) noexcept {
+        auto* b = new(std::nothrow) buffer { capacity - 1, nullptr, retired };
+        if(!b) return nullptr;
+        b->slots = new(std::nothrow) std::atomic<T>[static_cast<size_t>(capacity)];
+        if(!b->slots) {
+            delete b;
+            return nullptr;
+        }
+        return b;
+    }
+
+    // Owner only: double the buffer, keeping [top, bottom)
+    buffer* grow(buffer* old, int64_t top, int64_t bottom) noexcept {
+        buffer* b = allocate(old->capacity() * 2, old);
+        if(!b) return nullptr;
+        for(int64_t i = top; i < bottom; ++i) { b->store(i, old->load(i)); }
+        buffer_.store(b, std::memory_order_release);
+        return b;
+    }
+
+    public:
+    using value_type = T;
+
+    // Constructors
+    // capacity is rounded up to a power of two; allocation failure leaves is_valid() false
+    explicit chase_lev_deque(size_t capacity = 256) noexcept {
+        int64_t size = 2;
+        while(size < static_cast<int64_t>(capacity)) { size <<= 1; }
+        buffer_.store(allocate(size, nullptr), std::memory_order_relaxed);
+    }
+
+    // Shared between threads by reference; never copied or moved
+    chase_lev_deque(const chase_lev_deque&)            = delete;
+    chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+    // Destructor
+    ~chase_lev_deque() {
+        buffer* b = buffer_.load(std::memory_order_relaxed);
+        while(b) {
+            buffer* next = b->retired;
+            delete[] b->slots;
+            delete b;
+            b = next;
+        }
+    }
+
+    // Owner operations
+    // Returns false only when growing the buffer failed
+    bool push(T value) noexcept {
+        int64_t bottom = bottom_->load(std::memory_order_relaxed);
+        int64_t top    = top_->load(std::memory_order_acquire);
+        buffer* b      = buffer_.load(std::memory_order_relaxed);
+        if(bottom - top > b->mask) {
+            b = grow(b, top, bottom);
+            if(!b) return false;
+        }
+        b->store(bottom, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_->store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Newest element; false when empty or a stealer won the last element
+    bool take(T& out) noexcept {
+        int64_t bottom = bottom_->load(std::memory_order_relaxed) - 1;
+        buffer* b      = buffer_.load(std::memory_order_relaxed);
+        bottom_->store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_->load(std::memory_order_relaxed);
+
+        if(top > bottom) {
+            bottom_->store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = b->load(bottom);
+        if(top == bottom) {
+            // Last element: race stealers for it
+            bool won =
+              top_->compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_->store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread: oldest element; false when empty or another thread won the race
+    bool steal(T& out) noexcept {
+        int64_t top = top_->load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_->load(std::memory_order_acquire);
+        if(top >= bottom) return false;
+
+        buffer* b     = buffer_.load(std::memory_order_acquire);
+        T       value = b->load(top);
+        if(!top_->compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // State queries (approximate while other threads are running)
+    size_t size() const noexcept {
+        int64_t bottom = bottom_->load(std::memory_order_relaxed);
+        int64_t top    = top_->load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_t capacity() const noexcept {
+        return static_cast<size_t>(buffer_.load(std::memory_order_relaxed)->capacity());
+    }
+
+    bool is_valid() const noexcept { return buffer_.load(std::memory_order_relaxed) != nullptr; }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_CHASE_LEV_DEQUE_HPP
@@ -0,0 +1,507 @@
+#ifndef ASYNCLE_CONCURRENT_HASH_MAP_HPP
+#define ASYNCLE_CONCURRENT_HASH_MAP_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../compat.hpp"
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/memory.hpp"
+#include "seqlock.hpp"
+#include "sharded.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define ASYNCLE_MAP_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ASYNCLE_MAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace asyncle::concurrent {
+
+namespace detail {
+
+// Tag bytes: empty, deleted (tombstone), or 0x80 | 7 hash bits for a full slot
+inline constexpr uint8_t tag_empty   = 0x00;
+inline constexpr uint8_t tag_deleted = 0x01;
+
+// Bit j set for every byte j of the 16-byte group (lo then hi) equal to tag
+inline uint32_t match_group(uint64_t lo, uint64_t hi, uint8_t tag) noexcept {
+#if defined(ASYNCLE_MAP_SSE2)
+    __m128i group = _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag)))));
+#elif defined(ASYNCLE_MAP_NEON)
+    static constexpr uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t group = vcombine_u8(vcreate_u8(lo), vcreate_u8(hi));
+    uint8x16_t bits  = vandq_u8(vceqq_u8(group, vdupq_n_u8(tag)), vld1q_u8(weights));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) | static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8;
+#else
+    // SWAR: 0x80 in every byte equal to tag, then gather the high bits
+    auto bytes_equal = [tag](uint64_t word) noexcept -> uint32_t {
+        constexpr uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+        uint64_t           x    = word ^ (0x0101010101010101ull * tag);
+        uint64_t           zero = ~(((x & low7) + low7) | x | low7);
+        return static_cast<uint32_t>(((zero >> 7) * 0x0102040810204080ull) >> 56);
+    };
+    return bytes_equal(lo) | bytes_equal(hi) << 8;
+#endif
+}
+
+// Final mix of murmur3: std::hash is the identity for integers
+constexpr uint64_t mix_hash(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace detail
+
+// Outcome of hash_map::insert / insert_or_assign
+enum class insert_status : uint8_t {
+    inserted = 0,  // Key was absent and is now mapped
+    assigned = 1,  // Key was present; insert_or_assign replaced its value
+    exists   = 2,  // Key was present; insert left it alone
+    full     = 3   // No free slot on the key's probe path
+};
+
+// Concurrent open-addressing hash map for trivially copyable keys and
+// values, SwissTable style. Each bucket is one cache line: an 8-byte control
+// word with a 32-bit version and 4 tag bytes, a second word with 8 more tags,
+// and 12 32-bit hash fingerprints. A lookup matches all 12 tags with one
+// SSE2/NEON compare, checks the fingerprint and only then touches the entry
+// array, so a miss costs one line and a hit usually two.
+//
+//   hash_map<uint64_t, session> sessions(50'000'000);
+//   sessions.insert(id, s);                        // Any thread
+//   if(auto s = sessions.get(id)) serve(*s);       // Lock-free, never writes shared memory
+//   sessions.erase(id);
+//
+// Lookups are optimistic: they read a bucket between two loads of its
+// version and retry only when a writer touched that bucket meanwhile.
+// Writers lock the key's home bucket (version odd) for the whole operation,
+// so writers of one key serialize. A writer also locks the bucket it changes
+// when that is further along the probe path. Keys and values are stored as
+// relaxed atomic words (see seqlock), so a racing read is discarded rather
+// than undefined.
+//
+// Capacity is fixed at construction and the table never rehashes. Size it
+// for the peak entry count: buckets are allocated so that the count fills at
+// most 7/8 of the slots. Inserts past that point slow down, and they return
+// insert_status::full once a probe path has no free slot. Erased slots become
+// tombstones and are reused by later inserts.
+//
+// CPOs: make(map, key) looks a key up, try_push(map, std::pair{key, value})
+// inserts, and try_take(map, pair) erases pair.first and fills pair.second.
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class hash_map {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+                  "hash_map stores keys and values as atomic words");
+    static_assert(hardware::cache_line_size >= 64, "bucket layout needs a 64-byte line");
+
+    public:
+    using key_type    = K;
+    using mapped_type = V;
+    using value_type  = std::pair<K, V>;
+
+    static constexpr size_t slots_per_bucket = 12;
+
+    private:
+    static constexpr uint64_t version_mask = 0xffffffffull;
+
+    // Slot s has its tag in byte s + 4 of the control words (bytes 0-3 are the version)
+    static constexpr uint32_t slot_bits = ((1u << slots_per_bucket) - 1) << 4;
+
+    struct alignas(hardware::cache_line_size) bucket {
+        std::atomic<uint64_t> control[2];  // Version (low 32 bits) and tags
+        std::atomic<uint32_t> fingerprint[slots_per_bucket];
+    };
+
+    static_assert(sizeof(bucket) == hardware::cache_line_size);
+
+    struct entry {
+        detail::atomic_words<K> key;
+        detail::atomic_words<V> value;
+    };
+
+    // Tags of one bucket, as read
+    struct group {
+        uint64_t lo;
+        uint64_t hi;
+
+        // Slot mask (bit s for slot s) of tags equal to tag
+        uint32_t match(uint8_t tag) const noexcept { return (detail::match_group(lo, hi, tag) & slot_bits) >> 4; }
+
+        uint32_t free_slots() const noexcept { return match(detail::tag_empty) | match(detail::tag_deleted); }
+
+        bool has_empty() const noexcept { return match(detail::tag_empty) != 0; }
+
+        bool is_full(size_t slot) const noexcept {
+            size_t byte = slot + 4;
+            return (((byte < 8 ? lo : hi) >> (byte % 8 * 8)) & 0x80) != 0;
+        }
+
+        void set_tag(size_t slot, uint8_t tag) noexcept {
+            size_t    byte  = slot + 4;
+            uint64_t& word  = byte < 8 ? lo : hi;
+            unsigned  shift = static_cast<unsigned>(byte % 8) * 8;
+            word            = (word & ~(uint64_t(0xff) << shift)) | (uint64_t(tag) << shift);
+        }
+    };
+
+    // Where a key lives: home bucket, tag and fingerprint
+    struct probe {
+        size_t   home;
+        uint8_t  tag;
+        uint32_t fingerprint;
+    };
+
+    // Writer hold on one bucket; tags are edited in the local copy and
+    // published with the version bump on release
+    class locked_bucket {
+        bucket* b_ = nullptr;
+        group   tags_ {};
+
+        public:
+        locked_bucket() = default;
+
+        locked_bucket(const locked_bucket&)            = delete;
+        locked_bucket& operator=(const locked_bucket&) = delete;
+
+        ~locked_bucket() { release(); }
+
+        bool try_acquire(bucket& b) noexcept {
+            uint64_t lo = b.control[0].load(std::memory_order_relaxed);
+            if(lo & 1) return false;
+            if(!b.control[0].compare_exchange_strong(lo, bump(lo), std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+                return false;
+            }
+            // Readers that see any change below also see the odd version
+            hardware::memory_barrier_release();
+            b_    = &b;
+            tags_ = { bump(lo), b.control[1].load(std::memory_order_relaxed) };
+            return true;
+        }
+
+        void acquire(bucket& b) noexcept {
+            for(int spins = 0; !try_acquire(b); detail::backoff(spins)) {}
+        }
+
+        void release() noexcept {
+            if(!b_) return;
+            b_->control[1].store(tags_.hi, std::memory_order_relaxed);
+            b_->control[0].store(bump(tags_.lo), std::memory_order_release);
+            b_ = nullptr;
+        }
+
+        bool holds(const bucket& b) const noexcept { return b_ == &b; }
+
+        const group& tags() const noexcept { return tags_; }
+
+        // Tag writes go straight to the bucket too, so a concurrent writer of
+        // another key scanning this bucket sees the slot as taken
+        void set_tag(size_t slot, uint8_t tag) noexcept {
+            tags_.set_tag(slot, tag);
+            b_->control[0].store(tags_.lo, std::memory_order_relaxed);
+            b_->control[1].store(tags_.hi, std::memory_order_relaxed);
+        }
+    };
+
+    std::unique_ptr<bucket[]>      buckets_;
+    std::unique_ptr<entry[]>       entries_;
+    size_t                         mask_;
+    sharded_counter                size_;
+    [[no_unique_address]] Hash     hash_;
+    [[no_unique_address]] KeyEqual equal_;
+
+    // Advance the version half of the control word without touching the tags
+    static uint64_t bump(uint64_t lo) noexcept {
+        return (lo & ~version_mask) | ((lo + 1) & version_mask);
+    }
+
+    static size_t bucket_count_for(size_t capacity) noexcept {
+        size_t slots   = capacity + capacity / 7 + 1;  // capacity / (7/8)
+        size_t buckets = (slots + slots_per_bucket - 1) / slots_per_bucket;
+        return std::bit_ceil(buckets < 2 ? size_t { 2 } : buckets);
+    }
+
+    probe locate(const K& key) const noexcept {
+        uint64_t h = detail::mix_hash(static_cast<uint64_t>(hash_(key)));
+        return { static_cast<size_t>(h >> 7) & mask_, static_cast<uint8_t>(0x80 | (h & 0x7f)),
+                 static_cast<uint32_t>(h >> 32) };
+    }
+
+    entry& entry_at(size_t index, size_t slot) const noexcept { return entries_[index * slots_per_bucket + slot]; }
+
+    group read_tags(const bucket& b) const noexcept {
+        return { b.control[0].load(std::memory_order_acquire), b.control[1].load(std::memory_order_relaxed) };
+    }
+
+    // Slot of key within bucket index according to tags, or -1
+    int find_slot(size_t index, const group& tags, const probe& p, const K& key) const noexcept {
+        const bucket& b = buckets_[index];
+        for(uint32_t hits = tags.match(p.tag); hits; hits &= hits - 1) {
+            int slot = std::countr_zero(hits);
+            if(b.fingerprint[slot].load(std::memory_order_relaxed) != p.fingerprint) continue;
+            if(equal_(entry_at(index, slot).key.load(), key)) return slot;
+        }
+        return -1;
+    }
+
+    // Writer-side search along the probe path of key, with its home bucket held:
+    // where key is, and the first free slot before the path ends
+    struct found {
+        size_t index      = SIZE_MAX;
+        int    slot       = -1;
+        size_t free_index = SIZE_MAX;
+    };
+
+    found search(const probe& p, const K& key, const locked_bucket& home) const noexcept {
+        found out;
+        for(size_t step = 0; step <= mask_; ++step) {
+            size_t index = (p.home + step) & mask_;
+            group  tags  = home.holds(buckets_[index]) ? home.tags() : read_tags(buckets_[index]);
+            int    slot  = find_slot(index, tags, p, key);
+            if(slot >= 0) {
+                out.index = index;
+                out.slot  = slot;
+                return out;
+            }
+            if(out.free_index == SIZE_MAX && tags.free_slots()) out.free_index = index;
+            if(tags.has_empty()) break;
+        }
+        return out;
+    }
+
+    // The write side of every mutation: lock the home bucket, find the key,
+    // lock the bucket to change, and hand both to fn. fn returns false to
+    // request a retry (the target bucket changed under it).
+    template <typename Fn>
+    auto mutate(const K& key, Fn&& fn) {
+        probe p = locate(key);
+        for(int spins = 0;; detail::backoff(spins)) {
+            locked_bucket home;
+            home.acquire(buckets_[p.home]);
+            found          where  = search(p, key, home);
+            size_t         index  = where.slot >= 0 ? where.index : where.free_index;
+            locked_bucket  other;
+            locked_bucket* target = &home;
+            if(index != SIZE_MAX && index != p.home) {
+                // Never wait on a second bucket while holding one: retry instead
+                if(!other.try_acquire(buckets_[index])) continue;
+                target = &other;
+            }
+            if(auto result = fn(p, where, index, *target)) return *result;
+        }
+    }
+
+    void write_entry(size_t index, int slot, const probe& p, const K& key, const V& value,
+                     locked_bucket& target) noexcept {
+        entry& e = entry_at(index, slot);
+        e.key.store(key);
+        e.value.store(value);
+        buckets_[index].fingerprint[slot].store(p.fingerprint, std::memory_order_relaxed);
+        target.set_tag(static_cast<size_t>(slot), p.tag);
+    }
+
+    insert_status emplace(const K& key, const V& value, bool assign) noexcept {
+        return mutate(key, [&](const probe& p, const found& where, size_t index,
+                               locked_bucket& target) -> std::optional<insert_status> {
+            if(where.slot >= 0) {
+                if(!assign) return insert_status::exists;
+                entry_at(index, where.slot).value.store(value);
+                return insert_status::assigned;
+            }
+            if(index == SIZE_MAX) return insert_status::full;
+            // The free slot seen before locking may have been taken since
+            uint32_t free = target.tags().free_slots();
+            if(!free) return std::nullopt;
+            write_entry(index, std::countr_zero(free), p, key, value, target);
+            size_.add();
+            return insert_status::inserted;
+        });
+    }
+
+    public:
+    explicit hash_map(size_t capacity, Hash hash = Hash(), KeyEqual equal = KeyEqual()):
+        mask_(bucket_count_for(capacity) - 1),
+        hash_(std::move(hash)),
+        equal_(std::move(equal)) {
+        buckets_.reset(new bucket[mask_ + 1]());
+        entries_.reset(new entry[(mask_ + 1) * slots_per_bucket]());
+    }
+
+    // Shared between threads by reference; never copied or moved
+    hash_map(const hash_map&)            = delete;
+    hash_map& operator=(const hash_map&) = delete;
+
+    // Lookups (any thread, lock-free)
+
+    bool find(const K& key, V& out) const noexcept {
+        probe p = locate(key);
+        for(size_t step = 0; step <= mask_; ++step) {
+            size_t        index = (p.home + step) & mask_;
+            const bucket& b     = buckets_[index];
+            for(int spins = 0;; detail::backoff(spins)) {
+                group tags = read_tags(b);
+                if(tags.lo & 1) continue;
+                int slot = find_slot(index, tags, p, key);
+                if(slot < 0) {
+                    if(tags.has_empty()) return false;
+                    break;
+                }
+                V value = entry_at(index, slot).value.load();
+                hardware::memory_barrier_acquire();
+                if(b.control[0].load(std::memory_order_relaxed) != tags.lo) continue;
+                out = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::optional<V> get(const K& key) const noexcept {
+        V out;
+        if(!find(key, out)) return std::nullopt;
+        return out;
+    }
+
+    bool contains(const K& key) const noexcept {
+        V out;
+        return find(key, out);
+    }
+
+    // Pull the key's home bucket toward the cache ahead of a lookup
+    void prefetch(const K& key) const noexcept { hardware::prefetch_read(&buckets_[locate(key).home]); }
+
+    // Updates (any thread)
+
+    insert_status insert(const K& key, const V& value) noexcept { return emplace(key, value, false); }
+
+    insert_status insert_or_assign(const K& key, const V& value) noexcept { return emplace(key, value, true); }
+
+    // Edit the value of a present key in place; fn(V&) must not throw
+    template <typename Fn>
+    bool update(const K& key, Fn&& fn) noexcept {
+        return mutate(key, [&](const probe&, const found& where, size_t index, locked_bucket&) -> std::optional<bool> {
+            if(where.slot < 0) return false;
+            entry& e     = entry_at(index, where.slot);
+            V      value = e.value.load();
+            fn(value);
+            e.value.store(value);
+            return true;
+        });
+    }
+
+    // Remove key, copying its value to out
+    bool take(const K& key, V& out) noexcept {
+        return mutate(key, [&](const probe&, const found& where, size_t index,
+                               locked_bucket& target) -> std::optional<bool> {
+            if(where.slot < 0) return false;
+            out = entry_at(index, where.slot).value.load();
+            // A bucket that still has an empty slot never ended a probe path,
+            // so the slot can go back to empty instead of a tombstone
+            target.set_tag(static_cast<size_t>(where.slot),
+                           target.tags().has_empty() ? detail::tag_empty : detail::tag_deleted);
+            size_.sub();
+            return true;
+        });
+    }
+
+    bool erase(const K& key) noexcept {
+        V out;
+        return take(key, out);
+    }
+
+    // Every entry, each copied consistently; entries inserted or erased
+    // during the walk may or may not be visited
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for(size_t index = 0; index <= mask_; ++index) {
+            const bucket& b = buckets_[index];
+            for(size_t slot = 0; slot < slots_per_bucket; ++slot) {
+                for(int spins = 0;; detail::backoff(spins)) {
+                    group tags = read_tags(b);
+                    if(tags.lo & 1) continue;
+                    if(tags.is_full(slot)) {
+                        K key   = entry_at(index, slot).key.load();
+                        V value = entry_at(index, slot).value.load();
+                        hardware::memory_barrier_acquire();
+                        if(b.control[0].load(std::memory_order_relaxed) != tags.lo) continue;
+                        fn(key, value);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    // State queries (approximate while other threads are running)
+    size_t size() const noexcept {
+        int64_t n = size_.value();
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_t bucket_count() const noexcept { return mask_ + 1; }
+
+    // Total slots; inserts slow down as size() approaches it
+    size_t slot_count() const noexcept { return bucket_count() * slots_per_bucket; }
+
+    // CPO integration: make(map, key) is a lookup; a missing key reports error false
+    template <typename P>
+    struct key_like: std::bool_constant<std::is_convertible_v<P, K>> {};
+
+    using make_command_type = command<bool, pred_map<key_like, V>>;
+
+    template <typename P>
+    requires std::is_convertible_v<P, K>
+    friend expected<V, bool> tag_invoke(make_command_type, hash_map& map, P&& key) noexcept {
+        V out;
+        if(map.find(static_cast<K>(std::forward<P>(key)), out)) return expected<V, bool>(out);
+        return expected<V, bool>(unexpect, false);
+    }
+
+    // CPO integration: can_push/can_take
+    friend check_status tag_invoke(can_work_t, const hash_map& map, default_push_command) noexcept {
+        return map.size() < map.slot_count() ? check_status::TRUE : check_status::FALSE;
+    }
+
+    friend check_status tag_invoke(can_work_t, const hash_map& map, default_take_command) noexcept {
+        return map.empty() ? check_status::FALSE : check_status::TRUE;
+    }
+
+    // CPO integration: try_push inserts a pair (error false when the key exists
+    // or the table is full); try_take erases pair.first and fills pair.second
+    template <typename U>
+    requires std::is_convertible_v<U, value_type>
+    friend expected<bool, bool> tag_invoke(default_push_command, hash_map& map, U&& item) noexcept {
+        value_type kv = std::forward<U>(item);
+        if(map.insert(kv.first, kv.second) == insert_status::inserted) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+
+    template <typename U>
+    requires std::same_as<std::remove_cvref_t<U>, value_type> && (!std::is_const_v<std::remove_reference_t<U>>)
+    friend expected<bool, bool> tag_invoke(default_take_command, hash_map& map, U&& out) noexcept {
+        if(map.take(out.first, out.second)) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_HASH_MAP_HPP
@@ -0,0 +1,91 @@
+#ifndef ASYNCLE_CONCURRENT_HISTOGRAM_HPP
+#define ASYNCLE_CONCURRENT_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asyncle::concurrent {
+
+// ============================================================================
+// HDR Bucket Layout
+// ============================================================================
+
+// Log-linear buckets over the whole uint64 range, HdrHistogram style: values
+// below 16 get a bucket each, then every power of two is split into 16 equal
+// buckets. The width of a bucket is at most 1/16 of its lower bound, so any
+// reported value is within 6.25% of the recorded one, from nanoseconds to
+// centuries, in 976 counters.
+namespace histogram_layout {
+
+inline constexpr unsigned sub_bucket_bits = 4;
+inline constexpr size_t   sub_buckets     = size_t(1) << sub_bucket_bits;
+inline constexpr size_t   bucket_count    = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+constexpr size_t bucket_of(uint64_t value) noexcept {
+    if(value < sub_buckets) return static_cast<size_t>(value);
+    unsigned shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits - 1;
+    return (shift + 1) * sub_buckets + static_cast<size_t>((value >> shift) - sub_buckets);
+}
+
+// Smallest and largest value that land in bucket
+constexpr uint64_t lowest_in(size_t bucket) noexcept {
+    if(bucket < sub_buckets) return bucket;
+    unsigned shift = static_cast<unsigned>(bucket / sub_buckets) - 1;
+    return static_cast<uint64_t>(bucket % sub_buckets + sub_buckets) << shift;
+}
+
+constexpr uint64_t highest_in(size_t bucket) noexcept {
+    if(bucket < sub_buckets) return bucket;
+    unsigned shift = static_cast<unsigned>(bucket / sub_buckets) - 1;
+    return lowest_in(bucket) + ((uint64_t(1) << shift) - 1);
+}
+
+}  // namespace histogram_layout
+
+// Per-bucket counts summed over all shards of a sharded_histogram
+//
+//   auto latency = reads.snapshot();
+//   report(latency.count, latency.percentile(0.5), latency.percentile(0.99), latency.max());
+struct histogram_snapshot {
+    std::vector<uint64_t> counts;  // Indexed by histogram_layout::bucket_of; empty when nothing was recorded
+    uint64_t              count = 0;
+    uint64_t              sum   = 0;
+
+    double mean() const noexcept { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+    // Value at or below which a fraction q of the samples fall, reported as the
+    // top of its bucket (never understates a latency); 0 when empty
+    uint64_t percentile(double q) const noexcept {
+        if(count == 0) return 0;
+        q             = std::clamp(q, 0.0, 1.0);
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(count) + 0.5));
+        uint64_t seen = 0;
+        for(size_t b = 0; b < counts.size(); ++b) {
+            seen += counts[b];
+            if(seen >= rank) return histogram_layout::highest_in(b);
+        }
+        return max();
+    }
+
+    // Bucket bounds of the smallest and largest samples
+    uint64_t min() const noexcept {
+        for(size_t b = 0; b < counts.size(); ++b) {
+            if(counts[b]) return histogram_layout::lowest_in(b);
+        }
+        return 0;
+    }
+
+    uint64_t max() const noexcept {
+        for(size_t b = counts.size(); b-- > 0;) {
+            if(counts[b]) return histogram_layout::highest_in(b);
+        }
+        return 0;
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_HISTOGRAM_HPP
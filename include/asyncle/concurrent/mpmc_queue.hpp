@@ -0,0 +1,256 @@
+#ifndef ASYNCLE_CONCURRENT_MPMC_QUEUE_HPP
+#define ASYNCLE_CONCURRENT_MPMC_QUEUE_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../compat.hpp"
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/memory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle::concurrent {
+
+// Bounded lock-free multi-producer/multi-consumer queue (Vyukov).
+// Every slot carries a sequence number that says whose turn it is: seq == pos
+// means free for the producer claiming pos, seq == pos + 1 means filled for the
+// consumer claiming pos. Producers and consumers only contend on their own
+// position counter (one CAS per operation) and on the slot they claimed.
+// Slots are cache-line aligned so neighbouring slots never share a line.
+//
+// Exposes the same CPO surface as spsc_ring (try_push/try_take/can_push/can_take
+// through tag_invoke), so code written against pushable/takeable accepts either.
+template <typename T, size_t Capacity>
+class mpmc_queue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_nothrow_destructible_v<T>, "Elements must be nothrow destructible");
+
+    public:
+    using value_type = T;
+
+    private:
+    static constexpr size_t mask = Capacity - 1;
+
+    struct alignas(hardware::cache_line_size) slot {
+        std::atomic<size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    hardware::cache_padded<std::atomic<size_t>> enqueue_pos_ { size_t { 0 } };
+    hardware::cache_padded<std::atomic<size_t>> dequeue_pos_ { size_t { 0 } };
+    slot                                        slots_[Capacity];
+
+    static intptr_t distance(size_t sequence, size_t pos) noexcept {
+        return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    }
+
+    // Claim the slot for the next push; nullptr when the queue is full
+    slot* claim_push(size_t& pos) noexcept {
+        pos = enqueue_pos_->load(std::memory_order_relaxed);
+        while(true) {
+            slot*    s   = &slots_[pos & mask];
+            intptr_t dif = distance(s->sequence.load(std::memory_order_acquire), pos);
+            if(dif == 0) {
+                if(enqueue_pos_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return s;
+            } else if(dif < 0) {
+                return nullptr;  // Consumer has not freed this slot yet
+            } else {
+                pos = enqueue_pos_->load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claim the slot for the next take; nullptr when the queue is empty
+    slot* claim_take(size_t& pos) noexcept {
+        pos = dequeue_pos_->load(std::memory_order_relaxed);
+        while(true) {
+            slot*    s   = &slots_[pos & mask];
+            intptr_t dif = distance(s->sequence.load(std::memory_order_acquire), pos + 1);
+            if(dif == 0) {
+                if(dequeue_pos_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return s;
+            } else if(dif < 0) {
+                return nullptr;  // Producer has not filled this slot yet
+            } else {
+                pos = dequeue_pos_->load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claim up to want consecutive slots with one CAS; returns how many (0 = full/empty).
+    // Slots whose sequence reads ready(pos + i) can only change hands through
+    // the position counter, so one successful CAS owns the whole run.
+    template <size_t Ready>
+    size_t claim_run(hardware::cache_padded<std::atomic<size_t>>& counter, size_t& pos, size_t want) noexcept {
+        pos = counter->load(std::memory_order_relaxed);
+        while(true) {
+            size_t   run   = 0;
+            intptr_t first = 0;
+            for(; run < want; ++run) {
+                size_t   at  = pos + run;
+                intptr_t dif = distance(slots_[at & mask].sequence.load(std::memory_order_acquire), at + Ready);
+                if(run == 0) first = dif;
+                if(dif != 0) break;
+            }
+            if(run == 0) {
+                if(first < 0) return 0;
+                pos = counter->load(std::memory_order_relaxed);
+                continue;
+            }
+            if(counter->compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) return run;
+        }
+    }
+
+    public:
+    // Constructors
+    mpmc_queue() noexcept {
+        for(size_t i = 0; i < Capacity; ++i) { slots_[i].sequence.store(i, std::memory_order_relaxed); }
+    }
+
+    // Shared between threads by reference; never copied or moved
+    mpmc_queue(const mpmc_queue&)            = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    // Destructor
+    ~mpmc_queue() {
+        size_t head = dequeue_pos_->load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_->load(std::memory_order_relaxed);
+        for(; head != tail; ++head) { std::destroy_at(slots_[head & mask].get()); }
+    }
+
+    // Producer operations (any thread)
+    template <typename... Args>
+    requires std::is_nothrow_constructible_v<T, Args...>
+    bool emplace(Args&&... args) noexcept {
+        size_t pos;
+        slot*  s = claim_push(pos);
+        if(!s) return false;
+        std::construct_at(s->get(), std::forward<Args>(args)...);
+        s->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename U>
+    requires std::is_nothrow_constructible_v<T, U>
+    bool push(U&& value) noexcept {
+        return emplace(std::forward<U>(value));
+    }
+
+    // Copy as many leading elements as fit, claiming their slots with a single CAS
+    size_t push_batch(std::span<const T> values) noexcept
+    requires std::is_nothrow_copy_constructible_v<T>
+    {
+        size_t pos;
+        size_t count = values.empty() ? 0 : claim_run<0>(enqueue_pos_, pos, values.size());
+        for(size_t i = 0; i < count; ++i) {
+            slot& s = slots_[(pos + i) & mask];
+            std::construct_at(s.get(), values[i]);
+            s.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer operations (any thread)
+    bool take(T& out) noexcept
+    requires std::is_nothrow_move_assignable_v<T>
+    {
+        size_t pos;
+        slot*  s = claim_take(pos);
+        if(!s) return false;
+        T* item = s->get();
+        out     = std::move(*item);
+        std::destroy_at(item);
+        s->sequence.store(pos + Capacity, std::memory_order_release);  // Free for the producer one lap later
+        return true;
+    }
+
+    // Move up to out.size() elements into out, claiming their slots with a single CAS
+    size_t take_batch(std::span<T> out) noexcept
+    requires std::is_nothrow_move_assignable_v<T>
+    {
+        size_t pos;
+        size_t count = out.empty() ? 0 : claim_run<1>(dequeue_pos_, pos, out.size());
+        for(size_t i = 0; i < count; ++i) {
+            slot& s    = slots_[(pos + i) & mask];
+            T*    item = s.get();
+            out[i]     = std::move(*item);
+            std::destroy_at(item);
+            s.sequence.store(pos + i + Capacity, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // State queries (approximate while other threads are running)
+    size_t size() const noexcept {
+        size_t tail = enqueue_pos_->load(std::memory_order_acquire);
+        size_t head = dequeue_pos_->load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    bool full() const noexcept { return size() >= Capacity; }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+    // CPO integration: can_push/can_take
+    friend check_status tag_invoke(can_work_t, const mpmc_queue& queue, default_push_command) noexcept {
+        return queue.full() ? check_status::FALSE : check_status::TRUE;
+    }
+
+    friend check_status tag_invoke(can_work_t, const mpmc_queue& queue, default_take_command) noexcept {
+        return queue.empty() ? check_status::FALSE : check_status::TRUE;
+    }
+
+    // CPO integration: try_push/try_take; a full or empty queue reports error false
+    template <typename U>
+    requires std::is_nothrow_constructible_v<T, U>
+    friend expected<bool, bool> tag_invoke(default_push_command, mpmc_queue& queue, U&& value) noexcept {
+        if(queue.emplace(std::forward<U>(value))) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+
+    // An rvalue target (try_take(queue, T {})) takes and drops the oldest element
+    template <typename U>
+    requires std::same_as<std::remove_cvref_t<U>, T> && (!std::is_const_v<std::remove_reference_t<U>>)
+    friend expected<bool, bool> tag_invoke(default_take_command, mpmc_queue& queue, U&& out) noexcept {
+        if(queue.take(out)) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+
+    // CPO integration: work_batch with the push/take commands (one CAS per batch);
+    // items past a full or empty queue report error false
+    template <typename U>
+    requires std::same_as<std::remove_const_t<U>, T>
+    friend size_t tag_invoke(work_batch_t, mpmc_queue& queue, default_push_command, std::span<U> values,
+                             std::span<expected<bool, bool>> results) noexcept {
+        size_t count  = std::min(values.size(), results.size());
+        size_t pushed = queue.push_batch(std::span<const T>(values.data(), count));
+        for(size_t i = 0; i < count; ++i) {
+            results[i] = i < pushed ? expected<bool, bool>(true) : expected<bool, bool>(unexpect, false);
+        }
+        return count;
+    }
+
+    friend size_t tag_invoke(work_batch_t, mpmc_queue& queue, default_take_command, std::span<T> out,
+                             std::span<expected<bool, bool>> results) noexcept {
+        size_t count = std::min(out.size(), results.size());
+        size_t taken = queue.take_batch(out.first(count));
+        for(size_t i = 0; i < count; ++i) {
+            results[i] = i < taken ? expected<bool, bool>(true) : expected<bool, bool>(unexpect, false);
+        }
+        return count;
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_MPMC_QUEUE_HPP
@@ -0,0 +1,426 @@
+#ifndef ASYNCLE_CONCURRENT_OBJECT_POOL_HPP
+#define ASYNCLE_CONCURRENT_OBJECT_POOL_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../compat.hpp"
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/memory.hpp"
+#include "../io/mmap.hpp"
+#include "../meta/entries.hpp"
+#include "reclaim.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asyncle::concurrent {
+
+// Pool error codes
+enum class pool_error : uint8_t {
+    no_memory,  // A slab could not be mapped, or max_slabs is reached and every block is out
+};
+
+// Object pool options
+struct object_pool_options {
+    size_t                           slab_size     = size_t(2) << 20;  // Bytes mapped at a time
+    size_t                           max_slabs     = 0;                // 0 = grow without limit
+    size_t                           magazine_size = 32;               // Blocks per magazine; a thread caches two
+    io::mmap_access::page_preference pages =
+      io::mmap_access::page_preference::system_default;  // prefer_large / transparent_large for huge pages
+    bool prefault = false;                               // Fault slab pages in when they are mapped
+};
+
+namespace detail {
+
+// Free blocks linked through their first word
+struct free_chain {
+    void*  head  = nullptr;
+    size_t count = 0;
+
+    static void*& link(void* block) noexcept { return *static_cast<void**>(block); }
+
+    void push(void* block) noexcept {
+        link(block) = head;
+        head        = block;
+        ++count;
+    }
+
+    void* pop() noexcept {
+        void* block = head;
+        head        = link(block);
+        --count;
+        return block;
+    }
+
+    bool empty() const noexcept { return count == 0; }
+};
+
+// Slabs and depot shared by every thread using one pool. Threads reach it
+// through local_record(), so it lives until the pool and every thread that
+// touched it are gone.
+class block_pool_state {
+    public:
+    struct alignas(hardware::cache_line_size) record {
+        // Owner thread only: blocks are handed out from loaded, and previous is
+        // a full or empty spare swapped in before going to the depot
+        free_chain        loaded;
+        free_chain        previous;
+        std::atomic<bool> in_use { false };
+        record*           next = nullptr;
+    };
+
+    const size_t              stride;
+    const size_t              magazine_size;
+    const object_pool_options options;
+    record_list<record>       records;
+
+    private:
+    std::mutex            depot_mutex_;
+    void*                 full_       = nullptr;  // Full magazines, heads linked through their second word
+    size_t                full_count_ = 0;
+    free_chain            loose_;  // Blocks of partial magazines left by exited threads
+    std::vector<io::mmap> slabs_;
+    char*                 bump_     = nullptr;  // Uncarved part of the newest slab
+    char*                 bump_end_ = nullptr;
+    std::atomic<size_t>   capacity_ { 0 };
+
+    static void*& next_magazine(void* head) noexcept { return static_cast<void**>(head)[1]; }
+
+    bool map_slab() noexcept {
+        if(options.max_slabs != 0 && slabs_.size() >= options.max_slabs) return false;
+        io::memory_request req {};
+        req.length    = std::max(options.slab_size, stride);
+        req.backing   = io::backing_type::anonymous;
+        req.access    = io::mmap_access::access_mode::read_write;
+        req.sharing   = io::sharing_mode::private_cow;
+        req.page_pref = options.pages;
+        req.populate  = options.prefault ? io::mmap_access::populate_strategy::prefault
+                                         : io::mmap_access::populate_strategy::none;
+        io::mmap slab(req);
+        if(!slab.is_mapped()) return false;
+
+        size_t blocks = slab.size() / stride;
+        char*  base   = static_cast<char*>(slab.data());
+        try {
+            slabs_.push_back(std::move(slab));
+        } catch(...) {
+            return false;
+        }
+        bump_     = base;
+        bump_end_ = base + blocks * stride;
+        capacity_.fetch_add(blocks, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Up to one magazine of fresh blocks; depot lock held
+    free_chain carve() noexcept {
+        free_chain chain;
+        if(bump_ == bump_end_ && !map_slab()) return chain;
+        while(chain.count < magazine_size && bump_ != bump_end_) {
+            chain.push(bump_);
+            bump_ += stride;
+        }
+        return chain;
+    }
+
+    public:
+    // Blocks hold the free-list links, so they are at least two pointers wide and pointer aligned
+    static size_t stride_for(size_t block_size, size_t alignment) noexcept {
+        alignment = std::max(alignment, alignof(void*));
+        return (std::max({ block_size, 2 * sizeof(void*), alignment }) + alignment - 1) & ~(alignment - 1);
+    }
+
+    block_pool_state(size_t block_size, size_t alignment, const object_pool_options& opts):
+        stride(stride_for(block_size, alignment)),
+        magazine_size(std::max<size_t>(opts.magazine_size, 1)),
+        options(opts) {}
+
+    block_pool_state(const block_pool_state&)            = delete;
+    block_pool_state& operator=(const block_pool_state&) = delete;
+
+    record* acquire() { return records.acquire(); }
+
+    void release(record* r) noexcept {
+        deposit(std::exchange(r->loaded, free_chain {}));
+        deposit(std::exchange(r->previous, free_chain {}));
+        r->in_use.store(false, std::memory_order_release);
+    }
+
+    // A full magazine from the depot, else leftovers, else fresh blocks; empty when out of memory
+    free_chain refill() noexcept {
+        std::lock_guard lock(depot_mutex_);
+        free_chain      chain;
+        if(full_) {
+            chain.head  = full_;
+            chain.count = magazine_size;
+            full_       = next_magazine(full_);
+            --full_count_;
+        } else if(!loose_.empty()) {
+            while(chain.count < magazine_size && !loose_.empty()) chain.push(loose_.pop());
+        } else {
+            chain = carve();
+        }
+        return chain;
+    }
+
+    void deposit(free_chain chain) noexcept {
+        if(chain.empty()) return;
+        std::lock_guard lock(depot_mutex_);
+        if(chain.count == magazine_size) {
+            next_magazine(chain.head) = full_;
+            full_                     = chain.head;
+            ++full_count_;
+        } else {
+            while(!chain.empty()) loose_.push(chain.pop());
+        }
+    }
+
+    // True while a thread without cached blocks can still get one
+    bool can_allocate() noexcept {
+        std::lock_guard lock(depot_mutex_);
+        return full_ || !loose_.empty() || bump_ != bump_end_ || options.max_slabs == 0
+            || slabs_.size() < options.max_slabs;
+    }
+
+    size_t capacity() const noexcept { return capacity_.load(std::memory_order_relaxed); }
+
+    size_t slab_count() noexcept {
+        std::lock_guard lock(depot_mutex_);
+        return slabs_.size();
+    }
+
+    // Blocks in the depot, not counting those cached by threads
+    size_t depot_blocks() noexcept {
+        std::lock_guard lock(depot_mutex_);
+        return full_count_ * magazine_size + loose_.count;
+    }
+};
+
+}  // namespace detail
+
+// Fixed-size block allocator in the style of Bonwick's magazines. Each thread
+// caches up to two magazines of free blocks, so allocate and deallocate are a
+// thread-local pointer push or pop; only when both magazines are empty (or
+// full) does the thread swap one with the shared depot under a mutex, once
+// per magazine_size operations. Blocks are carved from slabs mapped through
+// io::mmap, optionally on huge pages, and are never returned to the system
+// until the pool and every thread that used it are gone.
+//
+//   block_pool pool(sizeof(order), alignof(order));
+//   void*      block = pool.allocate();       // nullptr when out of memory
+//   pool.deallocate(block);                   // From any thread
+//
+// A block may be freed by a different thread than the one that allocated it;
+// it joins the freeing thread's cache. Pools are neither copyable nor
+// movable, since outstanding blocks refer back to them. The first call from
+// each thread registers it with the pool and may allocate (and throw
+// bad_alloc); a destroyed pool's slabs stay mapped until the threads that
+// used it exit or register with another pool.
+class block_pool {
+    using state  = detail::block_pool_state;
+    using record = state::record;
+
+    std::shared_ptr<state> state_;
+
+    public:
+    // Type aliases for result types and error handling
+    using error_type = pool_error;
+    template <typename T>
+    using result_type = expected<T, pool_error>;
+
+    // alignment must be a power of two no larger than the page size
+    block_pool(size_t block_size, size_t alignment = alignof(std::max_align_t),
+               const object_pool_options& options = {}):
+        state_(std::make_shared<state>(block_size, alignment, options)) {}
+
+    block_pool(const block_pool&)            = delete;
+    block_pool& operator=(const block_pool&) = delete;
+
+    // A block of block_size() bytes, or nullptr when out of memory
+    void* allocate() {
+        record* r = detail::local_record(state_);
+        if(r->loaded.empty()) {
+            if(!r->previous.empty()) {
+                std::swap(r->loaded, r->previous);
+            } else {
+                r->loaded = state_->refill();
+                if(r->loaded.empty()) return nullptr;
+            }
+        }
+        return r->loaded.pop();
+    }
+
+    void deallocate(void* block) {
+        record* r = detail::local_record(state_);
+        if(r->loaded.count >= state_->magazine_size) {
+            if(!r->previous.empty()) state_->deposit(std::exchange(r->previous, detail::free_chain {}));
+            std::swap(r->loaded, r->previous);
+        }
+        r->loaded.push(block);
+    }
+
+    // State queries (approximate while other threads are running)
+    size_t block_size() const noexcept { return state_->stride; }
+
+    size_t magazine_size() const noexcept { return state_->magazine_size; }
+
+    size_t capacity() const noexcept { return state_->capacity(); }
+
+    size_t slab_count() const noexcept { return state_->slab_count(); }
+
+    size_t depot_blocks() const noexcept { return state_->depot_blocks(); }
+
+    bool can_allocate() const noexcept { return state_->can_allocate(); }
+};
+
+// Owning handle to an object in a block_pool; destroys it and returns the
+// block on destruction, like unique_ptr with a pool deleter
+template <typename T>
+class pooled {
+    T*          ptr_  = nullptr;
+    block_pool* pool_ = nullptr;
+
+    public:
+    using element_type = T;
+
+    pooled() noexcept = default;
+
+    pooled(T* ptr, block_pool& pool) noexcept: ptr_(ptr), pool_(&pool) {}
+
+    pooled(pooled&& other) noexcept:
+        ptr_(std::exchange(other.ptr_, nullptr)),
+        pool_(std::exchange(other.pool_, nullptr)) {}
+
+    pooled& operator=(pooled&& other) noexcept {
+        if(this != &other) {
+            reset();
+            ptr_  = std::exchange(other.ptr_, nullptr);
+            pool_ = std::exchange(other.pool_, nullptr);
+        }
+        return *this;
+    }
+
+    pooled(const pooled&)            = delete;
+    pooled& operator=(const pooled&) = delete;
+
+    ~pooled() { reset(); }
+
+    void reset() {
+        if(ptr_) {
+            ptr_->~T();
+            pool_->deallocate(std::exchange(ptr_, nullptr));
+        }
+    }
+
+    // Give up ownership; the caller destroys the object and returns the block
+    T* release() noexcept { return std::exchange(ptr_, nullptr); }
+
+    T* get() const noexcept { return ptr_; }
+
+    T& operator*() const noexcept { return *ptr_; }
+
+    T* operator->() const noexcept { return ptr_; }
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+};
+
+namespace detail {
+
+template <typename T, typename Tuple>
+struct constructible_from_tuple: std::false_type {};
+
+template <typename T, typename... Args>
+struct constructible_from_tuple<T, std::tuple<Args...>>: std::is_constructible<T, Args...> {};
+
+}  // namespace detail
+
+// Pool of T on a block_pool sized and aligned for T.
+//
+//   object_pool<order> orders;
+//   auto o = orders.create(id, price);        // expected<pooled<order>, pool_error>
+//   auto p = asyncle::make(orders, id);       // Same through the make CPO
+//   auto q = asyncle::make(orders, std::tuple { id, price });
+//
+// make(pool, arg) constructs T from arg, or from the elements of a std::tuple.
+// A constructor that throws leaves the block in the pool and rethrows.
+template <typename T>
+class object_pool {
+    block_pool blocks_;
+
+    public:
+    // Type aliases for result types and error handling
+    using value_type = T;
+    using error_type = pool_error;
+    template <typename U>
+    using result_type = expected<U, pool_error>;
+
+    explicit object_pool(const object_pool_options& options = {}): blocks_(sizeof(T), alignof(T), options) {}
+
+    object_pool(const object_pool&)            = delete;
+    object_pool& operator=(const object_pool&) = delete;
+
+    // Raw construct/destroy pair, nullptr when out of memory
+    template <typename... Args>
+    T* construct(Args&&... args) {
+        void* block = blocks_.allocate();
+        if(!block) return nullptr;
+        try {
+            return ::new(block) T(std::forward<Args>(args)...);
+        } catch(...) {
+            blocks_.deallocate(block);
+            throw;
+        }
+    }
+
+    void destroy(T* ptr) {
+        if(!ptr) return;
+        ptr->~T();
+        blocks_.deallocate(ptr);
+    }
+
+    template <typename... Args>
+    result_type<pooled<T>> create(Args&&... args) {
+        T* ptr = construct(std::forward<Args>(args)...);
+        if(!ptr) return result_type<pooled<T>>(unexpect, pool_error::no_memory);
+        return result_type<pooled<T>>(pooled<T>(ptr, blocks_));
+    }
+
+    block_pool& blocks() noexcept { return blocks_; }
+
+    const block_pool& blocks() const noexcept { return blocks_; }
+
+    // CPO integration: make(pool, arg) -> expected<pooled<T>, pool_error>
+    template <typename P>
+    struct constructs:
+        std::bool_constant<std::is_constructible_v<T, P>
+                           || detail::constructible_from_tuple<T, std::remove_cvref_t<P>>::value> {};
+
+    using make_command_type = command<pool_error, pred_map<constructs, pooled<T>>>;
+
+    template <typename P>
+    requires constructs<P>::value
+    friend result_type<pooled<T>> tag_invoke(make_command_type, object_pool& pool, P&& arg) {
+        if constexpr(std::is_constructible_v<T, P>) {
+            return pool.create(std::forward<P>(arg));
+        } else {
+            return std::apply([&](auto&&... args) { return pool.create(std::forward<decltype(args)>(args)...); },
+                              std::forward<P>(arg));
+        }
+    }
+
+    friend check_status tag_invoke(can_work_t, const object_pool& pool, make_command_type) noexcept {
+        return pool.blocks_.can_allocate() ? check_status::TRUE : check_status::FALSE;
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_OBJECT_POOL_HPP
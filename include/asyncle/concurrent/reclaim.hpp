@@ -0,0 +1,557 @@
+#ifndef ASYNCLE_CONCURRENT_RECLAIM_HPP
+#define ASYNCLE_CONCURRENT_RECLAIM_HPP
+
+#include "../hardware/memory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace asyncle::concurrent {
+
+// ============================================================================
+// Shared Machinery
+// ============================================================================
+
+namespace detail {
+
+// An object handed to a domain for deferred destruction
+struct retired_ptr {
+    void*    ptr;
+    void     (*deleter)(void*);
+    uint64_t epoch;  // Global epoch at retire time (epoch domains only)
+
+    void destroy() const noexcept { deleter(ptr); }
+};
+
+template <typename T>
+void delete_object(void* ptr) noexcept {
+    delete static_cast<T*>(ptr);
+}
+
+// Destroy the entries of list that expired() accepts. They are moved out
+// first, so a deleter may retire more objects into the same list.
+template <typename Pred>
+size_t destroy_if(std::vector<retired_ptr>& list, Pred&& expired) {
+    auto keep = std::stable_partition(list.begin(), list.end(), [&](const retired_ptr& p) { return !expired(p); });
+    std::vector<retired_ptr> doomed(keep, list.end());
+    list.erase(keep, list.end());
+    for(const auto& p : doomed) p.destroy();
+    return doomed.size();
+}
+
+// Grow-only lock-free list of records owned by a domain. A record is claimed
+// through its in_use flag and handed back later, so records are reused
+// across thread churn instead of accumulating.
+template <typename Record>
+class record_list {
+    std::atomic<Record*> head_ { nullptr };
+    std::atomic<size_t>  size_ { 0 };
+
+    public:
+    record_list() = default;
+
+    record_list(const record_list&)            = delete;
+    record_list& operator=(const record_list&) = delete;
+
+    ~record_list() {
+        Record* r = head_.load(std::memory_order_relaxed);
+        while(r) delete std::exchange(r, r->next);
+    }
+
+    Record* acquire() {
+        for(Record* r = head(); r; r = r->next) {
+            bool expected = false;
+            if(!r->in_use.load(std::memory_order_relaxed)
+               && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        Record* fresh = new Record();
+        fresh->in_use.store(true, std::memory_order_relaxed);
+        Record* top = head_.load(std::memory_order_relaxed);
+        do {
+            fresh->next = top;
+        } while(!head_.compare_exchange_weak(top, fresh, std::memory_order_release, std::memory_order_relaxed));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return fresh;
+    }
+
+    Record* head() const noexcept { return head_.load(std::memory_order_acquire); }
+
+    size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for(Record* r = head(); r; r = r->next) fn(*r);
+    }
+};
+
+// Records the calling thread holds, one per domain state it has touched,
+// handed back at thread exit. Entries share ownership of the state, so a
+// domain destroyed while other threads still hold records stays valid until
+// the last of them exits.
+template <typename State>
+class thread_records {
+    using record = typename State::record;
+
+    struct entry {
+        std::shared_ptr<State> state;
+        record*                rec;
+    };
+
+    std::vector<entry> entries_;
+    const State*       last_state_  = nullptr;
+    record*            last_record_ = nullptr;
+
+    public:
+    ~thread_records() {
+        for(auto& e : entries_) e.state->release(e.rec);
+    }
+
+    record* find(const std::shared_ptr<State>& state) {
+        if(state.get() == last_state_) return last_record_;
+        auto it = std::find_if(entries_.begin(), entries_.end(), [&](const entry& e) { return e.state == state; });
+        if(it == entries_.end()) {
+            // Drop states whose domain is gone and that no other thread holds
+            std::erase_if(entries_, [](entry& e) {
+                if(e.state.use_count() != 1) return false;
+                e.state->release(e.rec);
+                return true;
+            });
+            entries_.push_back({ state, state->acquire() });
+            it = entries_.end() - 1;
+        }
+        last_state_  = it->state.get();
+        last_record_ = it->rec;
+        return last_record_;
+    }
+};
+
+template <typename State>
+typename State::record* local_record(const std::shared_ptr<State>& state) {
+    thread_local thread_records<State> records;
+    return records.find(state);
+}
+
+// Objects left behind by exited threads, freed by whichever thread collects next
+class orphan_list {
+    std::mutex               mutex_;
+    std::vector<retired_ptr> list_;
+    std::atomic<bool>        nonempty_ { false };
+
+    public:
+    ~orphan_list() {
+        for(const auto& p : list_) p.destroy();
+    }
+
+    void adopt(std::vector<retired_ptr>& from) {
+        if(from.empty()) return;
+        std::lock_guard lock(mutex_);
+        list_.insert(list_.end(), from.begin(), from.end());
+        from.clear();
+        nonempty_.store(true, std::memory_order_relaxed);
+    }
+
+    // Skips rather than waits when another thread is already collecting
+    template <typename Pred>
+    size_t collect(Pred&& expired) {
+        if(!nonempty_.load(std::memory_order_relaxed)) return 0;
+        std::unique_lock lock(mutex_, std::try_to_lock);
+        if(!lock) return 0;
+        std::vector<retired_ptr> pending;
+        pending.swap(list_);
+        lock.unlock();
+        size_t freed = destroy_if(pending, expired);
+        lock.lock();
+        list_.insert(list_.end(), pending.begin(), pending.end());
+        nonempty_.store(!list_.empty(), std::memory_order_relaxed);
+        return freed;
+    }
+};
+
+}  // namespace detail
+
+// ============================================================================
+// Epoch-Based Reclamation
+// ============================================================================
+
+namespace detail {
+
+struct epoch_state {
+    struct alignas(hardware::cache_line_size) record {
+        // Global epoch announced while pinned, 0 while quiescent; the only
+        // field other threads read, on its own line
+        hardware::cache_padded<std::atomic<uint64_t>> epoch { uint64_t { 0 } };
+        std::atomic<bool>                             in_use { false };
+        record*                                       next = nullptr;
+
+        // Owner thread only
+        uint32_t                 depth = 0;
+        size_t                   collect_at = 0;
+        std::vector<retired_ptr> retired;
+    };
+
+    hardware::cache_padded<std::atomic<uint64_t>> global { uint64_t { 1 } };
+    record_list<record>                           records;
+    orphan_list                                   orphans;
+
+    ~epoch_state() {
+        records.for_each([](record& r) {
+            for(const auto& p : r.retired) p.destroy();
+        });
+    }
+
+    record* acquire() { return records.acquire(); }
+
+    void release(record* r) {
+        r->epoch->store(0, std::memory_order_release);
+        orphans.adopt(r->retired);
+        r->in_use.store(false, std::memory_order_release);
+    }
+};
+
+}  // namespace detail
+
+// Keeps the calling thread pinned to the epoch it entered (see epoch_domain).
+// Guards nest and stay on the thread that created them.
+class epoch_guard {
+    using record = detail::epoch_state::record;
+
+    record* record_ = nullptr;
+
+    friend class epoch_domain;
+
+    explicit epoch_guard(record* r) noexcept: record_(r) {}
+
+    public:
+    epoch_guard(epoch_guard&& other) noexcept: record_(std::exchange(other.record_, nullptr)) {}
+
+    epoch_guard(const epoch_guard&)            = delete;
+    epoch_guard& operator=(const epoch_guard&) = delete;
+    epoch_guard& operator=(epoch_guard&&)      = delete;
+
+    ~epoch_guard() { unpin(); }
+
+    // Leave the critical section early
+    void unpin() noexcept {
+        if(record_ && --record_->depth == 0) record_->epoch->store(0, std::memory_order_release);
+        record_ = nullptr;
+    }
+
+    bool pinned() const noexcept { return record_ != nullptr; }
+};
+
+// Epoch-based reclamation: readers pin the current epoch around each access
+// to shared nodes, and writers retire unlinked nodes instead of deleting
+// them. A node retired in epoch e is destroyed once the global epoch reaches
+// e + 2, by which point every thread that could have seen it has unpinned.
+// The epoch advances only when every pinned thread has announced the current
+// one.
+//
+//   epoch_domain& ebr = epoch_domain::global();
+//   {
+//       epoch_guard guard = ebr.pin();            // Reader: one store + fence
+//       for(node* n = head.load(std::memory_order_acquire); n; n = n->next.load(...)) visit(n);
+//   }
+//   node* old = pop_front();                      // Writer, after unlinking
+//   ebr.retire(old);                              // delete old, later
+//
+// Pinning is cheap and never blocks, but a thread that stays pinned stops the
+// epoch and with it all reclamation, so memory is unbounded while a reader
+// stalls. Use hazard_domain when that bound matters.
+//
+// Each thread gets a cache-padded record the first time it touches a domain.
+// Retired objects go on that thread's list and are freed in batches of
+// collect_threshold, from retire() or collect(); the list of an exited thread
+// is adopted by the next thread that collects.
+class epoch_domain {
+    using state  = detail::epoch_state;
+    using record = state::record;
+
+    std::shared_ptr<state> state_;
+
+    record* local() const { return detail::local_record(state_); }
+
+    public:
+    // Retired objects per thread between reclamation attempts
+    static constexpr size_t collect_threshold = 64;
+
+    epoch_domain(): state_(std::make_shared<state>()) {}
+
+    epoch_domain(const epoch_domain&)            = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    // Process-wide domain, never destroyed
+    static epoch_domain& global() {
+        static epoch_domain* const domain = new epoch_domain();
+        return *domain;
+    }
+
+    // Enter a read-side critical section; nodes reachable now stay valid
+    // until the guard is gone
+    epoch_guard pin() {
+        record* r = local();
+        if(r->depth++ == 0) {
+            r->epoch->store(state_->global->load(std::memory_order_relaxed), std::memory_order_relaxed);
+            // Announce before any shared pointer is read
+            hardware::full_barrier();
+        }
+        return epoch_guard(r);
+    }
+
+    // Destroy ptr with deleter once no pinned thread can still reach it.
+    // Call after ptr has been unlinked from every shared structure.
+    void retire(void* ptr, void (*deleter)(void*)) {
+        record* r = local();
+        hardware::full_barrier();
+        r->retired.push_back({ ptr, deleter, state_->global->load(std::memory_order_relaxed) });
+        if(r->retired.size() >= r->collect_at + collect_threshold) collect();
+    }
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(const_cast<void*>(static_cast<const void*>(ptr)), &detail::delete_object<T>);
+    }
+
+    // Advance the global epoch when every pinned thread is in the current one
+    bool try_advance() noexcept {
+        uint64_t current = state_->global->load(std::memory_order_relaxed);
+        hardware::full_barrier();
+        bool blocked = false;
+        state_->records.for_each([&](const record& r) {
+            uint64_t announced = r.epoch->load(std::memory_order_relaxed);
+            if(announced != 0 && announced != current) blocked = true;
+        });
+        return !blocked
+            && state_->global->compare_exchange_strong(current, current + 1, std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed);
+    }
+
+    // Try to advance, then free this thread's (and exited threads') expired
+    // objects; returns how many were destroyed
+    size_t collect() {
+        record* r = local();
+        try_advance();
+        uint64_t now     = state_->global->load(std::memory_order_acquire);
+        auto     expired = [now](const detail::retired_ptr& p) { return p.epoch + 2 <= now; };
+        size_t   freed   = detail::destroy_if(r->retired, expired);
+        freed += state_->orphans.collect(expired);
+        r->collect_at = r->retired.size();
+        return freed;
+    }
+
+    // Objects this thread retired that are not destroyed yet
+    size_t pending() const { return local()->retired.size(); }
+
+    uint64_t epoch() const noexcept { return state_->global->load(std::memory_order_relaxed); }
+};
+
+// ============================================================================
+// Hazard Pointers
+// ============================================================================
+
+namespace detail {
+
+struct hazard_state {
+    struct alignas(hardware::cache_line_size) slot {
+        std::atomic<const void*> protected_ptr { nullptr };
+        std::atomic<bool>        in_use { false };
+        slot*                    next = nullptr;
+    };
+
+    struct alignas(hardware::cache_line_size) record {
+        std::atomic<bool> in_use { false };
+        record*           next = nullptr;
+
+        // Owner thread only
+        size_t                   scan_at = 0;
+        std::vector<retired_ptr> retired;
+    };
+
+    record_list<slot>   slots;
+    record_list<record> records;
+    orphan_list         orphans;
+
+    ~hazard_state() {
+        records.for_each([](record& r) {
+            for(const auto& p : r.retired) p.destroy();
+        });
+    }
+
+    // Sorted snapshot of every published hazard
+    std::vector<const void*> hazards() const {
+        hardware::full_barrier();
+        std::vector<const void*> out;
+        out.reserve(slots.size());
+        slots.for_each([&](const slot& s) {
+            if(const void* p = s.protected_ptr.load(std::memory_order_relaxed)) out.push_back(p);
+        });
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    size_t scan(std::vector<retired_ptr>& list) {
+        auto protect = hazards();
+        auto expired = [&](const retired_ptr& p) { return !std::binary_search(protect.begin(), protect.end(), p.ptr); };
+        return destroy_if(list, expired) + orphans.collect(expired);
+    }
+
+    record* acquire() { return records.acquire(); }
+
+    void release(record* r) {
+        scan(r->retired);
+        orphans.adopt(r->retired);
+        r->in_use.store(false, std::memory_order_release);
+    }
+};
+
+}  // namespace detail
+
+// One published hazard: while it protects a pointer, no hazard_domain scan
+// destroys that object. Owns a slot of its domain until destroyed; the
+// domain must outlive it. Movable, not copyable.
+class hazard_pointer {
+    using slot = detail::hazard_state::slot;
+
+    slot* slot_ = nullptr;
+
+    friend class hazard_domain;
+
+    explicit hazard_pointer(slot* s) noexcept: slot_(s) {}
+
+    public:
+    hazard_pointer() noexcept = default;
+
+    hazard_pointer(hazard_pointer&& other) noexcept: slot_(std::exchange(other.slot_, nullptr)) {}
+
+    hazard_pointer& operator=(hazard_pointer&& other) noexcept {
+        if(this != &other) {
+            release();
+            slot_ = std::exchange(other.slot_, nullptr);
+        }
+        return *this;
+    }
+
+    hazard_pointer(const hazard_pointer&)            = delete;
+    hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+    ~hazard_pointer() { release(); }
+
+    bool empty() const noexcept { return slot_ == nullptr; }
+
+    // Load src and protect the result, retrying until the published hazard
+    // matches what src still holds
+    template <typename T>
+    T* protect(const std::atomic<T*>& src) noexcept {
+        T* ptr = src.load(std::memory_order_relaxed);
+        while(!try_protect(ptr, src)) {}
+        return ptr;
+    }
+
+    // Protect ptr, which the caller read from src. False (ptr updated to the
+    // current value, nothing protected) when src changed in between.
+    template <typename T>
+    bool try_protect(T*& ptr, const std::atomic<T*>& src) noexcept {
+        T* seen = ptr;
+        reset_protection(seen);
+        // Publish before re-reading src
+        hardware::full_barrier();
+        ptr = src.load(std::memory_order_acquire);
+        if(ptr == seen) return true;
+        reset_protection();
+        return false;
+    }
+
+    template <typename T>
+    void reset_protection(const T* ptr) noexcept {
+        slot_->protected_ptr.store(ptr, std::memory_order_release);
+    }
+
+    void reset_protection(std::nullptr_t = nullptr) noexcept {
+        slot_->protected_ptr.store(nullptr, std::memory_order_release);
+    }
+
+    private:
+    void release() noexcept {
+        if(!slot_) return;
+        slot_->protected_ptr.store(nullptr, std::memory_order_release);
+        slot_->in_use.store(false, std::memory_order_release);
+        slot_ = nullptr;
+    }
+};
+
+// Hazard-pointer reclamation: a reader publishes the exact node it is about
+// to dereference, and a retired node is destroyed only once no hazard
+// pointer names it. Memory stays bounded however long a reader stalls: at
+// most one node per live hazard pointer plus scan_threshold per thread waits
+// for destruction. Readers pay a store and a fence per protected node, more
+// than an epoch pin, for that bound.
+//
+//   hazard_domain& hp_domain = hazard_domain::global();
+//   hazard_pointer hp = hp_domain.make_hazard_pointer();  // Reuse across operations
+//   node* top = hp.protect(head);                          // Safe to dereference
+//   ...
+//   hp_domain.retire(unlinked);                            // Destroyed once unprotected
+//
+// Acquiring a hazard pointer scans the domain's slots for a free one, so
+// keep them for the life of a worker or an operation loop rather than
+// creating one per node.
+class hazard_domain {
+    using state = detail::hazard_state;
+
+    std::shared_ptr<state> state_;
+
+    public:
+    // Minimum retired objects per thread between scans (doubled slot count when larger)
+    static constexpr size_t scan_threshold = 64;
+
+    hazard_domain(): state_(std::make_shared<state>()) {}
+
+    hazard_domain(const hazard_domain&)            = delete;
+    hazard_domain& operator=(const hazard_domain&) = delete;
+
+    // Process-wide domain, never destroyed
+    static hazard_domain& global() {
+        static hazard_domain* const domain = new hazard_domain();
+        return *domain;
+    }
+
+    hazard_pointer make_hazard_pointer() { return hazard_pointer(state_->slots.acquire()); }
+
+    // Destroy ptr with deleter once no hazard pointer protects it. Call after
+    // ptr has been unlinked from every shared structure.
+    void retire(void* ptr, void (*deleter)(void*)) {
+        auto* r = detail::local_record(state_);
+        r->retired.push_back({ ptr, deleter, 0 });
+        if(r->retired.size() >= r->scan_at + std::max(scan_threshold, 2 * state_->slots.size())) collect();
+    }
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(const_cast<void*>(static_cast<const void*>(ptr)), &detail::delete_object<T>);
+    }
+
+    // Scan the hazards now and destroy this thread's (and exited threads')
+    // unprotected objects; returns how many were destroyed
+    size_t collect() {
+        auto*  r     = detail::local_record(state_);
+        size_t freed = state_->scan(r->retired);
+        r->scan_at   = r->retired.size();
+        return freed;
+    }
+
+    // Objects this thread retired that are not destroyed yet
+    size_t pending() const { return detail::local_record(state_)->retired.size(); }
+
+    // Hazard slots ever created (live hazard_pointers plus free slots)
+    size_t slot_count() const noexcept { return state_->slots.size(); }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_RECLAIM_HPP
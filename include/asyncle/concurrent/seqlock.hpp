@@ -0,0 +1,165 @@
+#ifndef ASYNCLE_CONCURRENT_SEQLOCK_HPP
+#define ASYNCLE_CONCURRENT_SEQLOCK_HPP
+
+#include "../hardware/memory.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace asyncle::concurrent {
+
+namespace detail {
+
+// Trivially copyable T held as relaxed atomic words, so a copy racing with a
+// writer yields a torn value to be discarded rather than undefined behaviour
+template <typename T>
+class atomic_words {
+    static_assert(std::is_trivially_copyable_v<T>, "atomic_words copies T bytewise");
+
+    static constexpr size_t count = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct words {
+        uint64_t w[count];
+    };
+
+    struct bytes {
+        unsigned char b[sizeof(T)];
+    };
+
+    std::atomic<uint64_t> words_[count];
+
+    public:
+    void store(const T& value) noexcept {
+        words staged {};
+        std::memcpy(staged.w, &value, sizeof(T));
+        for(size_t i = 0; i < count; ++i) words_[i].store(staged.w[i], std::memory_order_relaxed);
+    }
+
+    T load() const noexcept {
+        words staged;
+        for(size_t i = 0; i < count; ++i) staged.w[i] = words_[i].load(std::memory_order_relaxed);
+        bytes out;
+        std::memcpy(out.b, staged.w, sizeof(T));
+        return std::bit_cast<T>(out);
+    }
+};
+
+// Spins before yielding to a writer that may have been preempted mid-write
+inline constexpr int spins_before_yield = 64;
+
+inline void backoff(int& spins) noexcept {
+    if(++spins < spins_before_yield) {
+        hardware::cpu_relax();
+    } else {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace detail
+
+// Sequence lock for small read-mostly values (config snapshots, routing
+// entries, quote tops). Writers make the sequence odd, store the value and
+// make it even again; readers copy the value between two reads of the
+// sequence and retry when it moved or was odd. A read never writes shared
+// memory, so any number of readers keep the line in shared state and scale
+// with cores, unlike shared_mutex whose reader count bounces between them.
+//
+//   seqlock<route_config> config;
+//   config.store(next);                    // Control thread, about once a second
+//   route_config now = config.load();      // Every worker, every message
+//
+// The value is copied on every read, so keep T small (a few cache lines) and
+// publish large tables by pointer instead. T must be trivially copyable; it
+// is stored as relaxed atomic words, so a torn copy is never undefined
+// behaviour, only discarded. Writers serialize among themselves on the
+// sequence, and readers are wait-free of each other but may retry while a
+// write is in progress.
+template <typename T>
+class alignas(hardware::cache_line_size) seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock copies T bytewise");
+
+    std::atomic<uint64_t>   sequence_ { 0 };
+    detail::atomic_words<T> data_;
+
+    // Make the sequence odd; returns the even value it had
+    uint64_t begin_write() noexcept {
+        int      spins = 0;
+        uint64_t seq   = sequence_.load(std::memory_order_relaxed);
+        for(;;) {
+            if((seq & 1) == 0 && sequence_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                                 std::memory_order_relaxed)) {
+                break;
+            }
+            detail::backoff(spins);
+            seq = sequence_.load(std::memory_order_relaxed);
+        }
+        // Readers that see any of the new words also see the odd sequence
+        hardware::memory_barrier_release();
+        return seq;
+    }
+
+    void end_write(uint64_t seq) noexcept { sequence_.store(seq + 2, std::memory_order_release); }
+
+    public:
+    using value_type = T;
+
+    seqlock() noexcept: seqlock(T {}) {}
+
+    explicit seqlock(const T& initial) noexcept { data_.store(initial); }
+
+    seqlock(const seqlock&)            = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    // Consistent copy of the current value; retries while a write overlaps
+    T load() const noexcept {
+        for(int spins = 0;; detail::backoff(spins)) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if(before & 1) continue;
+            T copy = data_.load();
+            hardware::memory_barrier_acquire();
+            if(sequence_.load(std::memory_order_relaxed) == before) return copy;
+        }
+    }
+
+    // Single attempt: false when a writer was active or finished during the copy
+    bool try_load(T& out) const noexcept {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if(before & 1) return false;
+        T copy = data_.load();
+        hardware::memory_barrier_acquire();
+        if(sequence_.load(std::memory_order_relaxed) != before) return false;
+        out = copy;
+        return true;
+    }
+
+    void store(const T& value) noexcept {
+        uint64_t seq = begin_write();
+        data_.store(value);
+        end_write(seq);
+    }
+
+    // Read-modify-write under the writer side: fn(T&) edits the current value
+    // in place and the result is published as one update. fn must not throw
+    // (readers would spin on the odd sequence forever), so this is noexcept.
+    template <typename Fn>
+    void update(Fn&& fn) noexcept {
+        uint64_t seq   = begin_write();
+        T        value = data_.load();
+        fn(value);
+        data_.store(value);
+        end_write(seq);
+    }
+
+    // Even, and bumped by 2 per completed write: readers that keep a copy can
+    // compare versions to skip re-reading an unchanged value
+    uint64_t version() const noexcept { return sequence_.load(std::memory_order_acquire) & ~uint64_t(1); }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_SEQLOCK_HPP
@@ -0,0 +1,260 @@
+#ifndef ASYNCLE_CONCURRENT_SHARDED_HPP
+#define ASYNCLE_CONCURRENT_SHARDED_HPP
+
+#include "../hardware/affinity.hpp"
+#include "../hardware/memory.hpp"
+#include "../hardware/topology.hpp"
+#include "histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace asyncle::concurrent {
+
+// How a sharded structure picks the slot of the calling thread
+enum class shard_by : uint8_t {
+    thread = 0,  // Per-thread index assigned round-robin on first use; no syscall, stable
+    cpu    = 1   // Current CPU (rseq cpu_id / getcpu); fewer slots than threads, shared on migration
+};
+
+namespace detail {
+
+// Small dense id per thread, handed out in creation order
+inline size_t thread_shard_id() noexcept {
+    static std::atomic<size_t> next { 0 };
+    thread_local const size_t  id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+// One slot per possible CPU number, so cpu ids index directly
+inline size_t default_shard_count() noexcept {
+    static const size_t count = [] {
+        size_t highest = 0;
+        for(const auto& loc : hardware::cpu_topology::current().cpus()) highest = std::max<size_t>(highest, loc.cpu);
+        return highest + 1;
+    }();
+    return count;
+}
+
+}  // namespace detail
+
+// One cache_padded<T> per shard; each thread works on its own slot and
+// readers visit all of them. Slots are distinct cache lines, so writers on
+// different shards never contend for a line. Two threads can land on the same
+// slot (more threads than shards, or shard_by::cpu after a migration), so T
+// must tolerate concurrent use, typically through relaxed atomics.
+//
+//   per_cpu<std::atomic<uint64_t>> bytes;
+//   bytes.local().fetch_add(n, std::memory_order_relaxed);             // Hot path
+//   bytes.for_each([&](const auto& s) { total += s.load(std::memory_order_relaxed); });
+template <typename T>
+class per_cpu {
+    std::unique_ptr<hardware::cache_padded<T>[]> slots_;
+    size_t                                       count_;
+    shard_by                                     mode_;
+
+    public:
+    using value_type = T;
+
+    explicit per_cpu(shard_by mode = shard_by::thread, size_t shards = detail::default_shard_count()):
+        slots_(new hardware::cache_padded<T>[shards ? shards : 1]),
+        count_(shards ? shards : 1),
+        mode_(mode) {}
+
+    per_cpu(const per_cpu&)            = delete;
+    per_cpu& operator=(const per_cpu&) = delete;
+
+    // Slot index of the calling thread
+    size_t index() const noexcept {
+        if(mode_ == shard_by::cpu) {
+            uint32_t cpu = hardware::fast_cpu_id();
+            if(cpu != UINT32_MAX) return cpu < count_ ? cpu : cpu % count_;
+        }
+        return detail::thread_shard_id() % count_;
+    }
+
+    T& local() noexcept { return slots_[index()].value; }
+
+    T& operator[](size_t shard) noexcept { return slots_[shard].value; }
+
+    const T& operator[](size_t shard) const noexcept { return slots_[shard].value; }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        for(size_t i = 0; i < count_; ++i) fn(slots_[i].value);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for(size_t i = 0; i < count_; ++i) fn(static_cast<const T&>(slots_[i].value));
+    }
+
+    size_t size() const noexcept { return count_; }
+
+    shard_by mode() const noexcept { return mode_; }
+};
+
+// Counter whose increments never touch a shared cache line. value() sums the
+// shards: it sees every increment that happened-before the call, and any
+// subset of concurrent ones (a relaxed snapshot, fine for metrics).
+//
+//   sharded_counter requests;
+//   requests.add();              // From any thread, ~1 ns uncontended
+//   report(requests.value());    // From the metrics thread
+class sharded_counter {
+    per_cpu<std::atomic<int64_t>> shards_;
+
+    public:
+    explicit sharded_counter(shard_by mode = shard_by::thread, size_t shards = detail::default_shard_count()):
+        shards_(mode, shards) {}
+
+    void add(int64_t n = 1) noexcept { shards_.local().fetch_add(n, std::memory_order_relaxed); }
+
+    void sub(int64_t n = 1) noexcept { add(-n); }
+
+    int64_t value() const noexcept {
+        int64_t total = 0;
+        shards_.for_each([&](const std::atomic<int64_t>& s) { total += s.load(std::memory_order_relaxed); });
+        return total;
+    }
+
+    // Sum and zero in one pass; increments racing with it land in this or the next period
+    int64_t exchange_reset() noexcept {
+        int64_t total = 0;
+        shards_.for_each([&](std::atomic<int64_t>& s) { total += s.exchange(0, std::memory_order_relaxed); });
+        return total;
+    }
+
+    void reset() noexcept { exchange_reset(); }
+
+    size_t shards() const noexcept { return shards_.size(); }
+};
+
+// Aggregate of recorded samples
+struct stat_summary {
+    uint64_t count = 0;
+    int64_t  sum   = 0;
+    int64_t  min   = std::numeric_limits<int64_t>::max();  // max() / min() while empty
+    int64_t  max   = std::numeric_limits<int64_t>::min();
+
+    double mean() const noexcept { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+// Count, sum, min and max of samples (latencies, sizes), sharded like
+// sharded_counter. The four fields of one shard are updated independently,
+// so a snapshot racing with record() may be off by the in-flight samples.
+class sharded_stat {
+    struct slot {
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<int64_t>  sum { 0 };
+        std::atomic<int64_t>  min { std::numeric_limits<int64_t>::max() };
+        std::atomic<int64_t>  max { std::numeric_limits<int64_t>::min() };
+    };
+
+    per_cpu<slot> shards_;
+
+    // CAS only when the sample moves the bound, so steady-state records are plain loads
+    static void lower(std::atomic<int64_t>& field, int64_t value) noexcept {
+        int64_t seen = field.load(std::memory_order_relaxed);
+        while(value < seen && !field.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    }
+
+    static void raise(std::atomic<int64_t>& field, int64_t value) noexcept {
+        int64_t seen = field.load(std::memory_order_relaxed);
+        while(value > seen && !field.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    }
+
+    public:
+    explicit sharded_stat(shard_by mode = shard_by::thread, size_t shards = detail::default_shard_count()):
+        shards_(mode, shards) {}
+
+    void record(int64_t value) noexcept {
+        slot& s = shards_.local();
+        s.count.fetch_add(1, std::memory_order_relaxed);
+        s.sum.fetch_add(value, std::memory_order_relaxed);
+        lower(s.min, value);
+        raise(s.max, value);
+    }
+
+    stat_summary snapshot() const noexcept {
+        stat_summary out;
+        shards_.for_each([&](const slot& s) {
+            out.count += s.count.load(std::memory_order_relaxed);
+            out.sum += s.sum.load(std::memory_order_relaxed);
+            out.min = std::min(out.min, s.min.load(std::memory_order_relaxed));
+            out.max = std::max(out.max, s.max.load(std::memory_order_relaxed));
+        });
+        return out;
+    }
+
+    void reset() noexcept {
+        shards_.for_each([](slot& s) {
+            s.count.store(0, std::memory_order_relaxed);
+            s.sum.store(0, std::memory_order_relaxed);
+            s.min.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+            s.max.store(std::numeric_limits<int64_t>::min(), std::memory_order_relaxed);
+        });
+    }
+
+    size_t shards() const noexcept { return shards_.size(); }
+};
+
+// Lock-free HDR-style histogram (see histogram_layout): record() is one
+// relaxed increment of a bucket in the caller's shard plus one add to its sum,
+// with no CAS and no shared line. Each shard holds the full 976 buckets
+// (~8 KiB), so size the shard count to the threads that record, not to the
+// machine, when many histograms are live.
+//
+//   sharded_histogram read_ns(shard_by::cpu);
+//   read_ns.record(elapsed_ns);
+//   auto p99 = read_ns.snapshot().percentile(0.99);
+class sharded_histogram {
+    struct slot {
+        std::atomic<uint64_t> sum { 0 };
+        std::atomic<uint64_t> counts[histogram_layout::bucket_count] {};
+    };
+
+    per_cpu<slot> shards_;
+
+    public:
+    explicit sharded_histogram(shard_by mode = shard_by::thread, size_t shards = detail::default_shard_count()):
+        shards_(mode, shards) {}
+
+    void record(uint64_t value, uint64_t times = 1) noexcept {
+        slot& s = shards_.local();
+        s.counts[histogram_layout::bucket_of(value)].fetch_add(times, std::memory_order_relaxed);
+        s.sum.fetch_add(value * times, std::memory_order_relaxed);
+    }
+
+    // Relaxed like sharded_counter::value(); counts stays empty while no sample was recorded
+    histogram_snapshot snapshot() const {
+        histogram_snapshot out;
+        out.counts.assign(histogram_layout::bucket_count, 0);
+        shards_.for_each([&](const slot& s) {
+            out.sum += s.sum.load(std::memory_order_relaxed);
+            for(size_t b = 0; b < histogram_layout::bucket_count; ++b) {
+                uint64_t n = s.counts[b].load(std::memory_order_relaxed);
+                out.counts[b] += n;
+                out.count += n;
+            }
+        });
+        if(out.count == 0) out.counts.clear();
+        return out;
+    }
+
+    void reset() noexcept {
+        shards_.for_each([](slot& s) {
+            s.sum.store(0, std::memory_order_relaxed);
+            for(auto& c : s.counts) c.store(0, std::memory_order_relaxed);
+        });
+    }
+
+    size_t shards() const noexcept { return shards_.size(); }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_SHARDED_HPP
@@ -0,0 +1,295 @@
+#ifndef ASYNCLE_CONCURRENT_SPSC_RING_HPP
+#define ASYNCLE_CONCURRENT_SPSC_RING_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../compat.hpp"
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/memory.hpp"
+#include "../meta/dispatch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle::concurrent {
+
+// Bounded lock-free single-producer/single-consumer ring.
+// Head (consumer) and tail (producer) indices live on separate cache lines and
+// each side keeps a cached copy of the other's index, so the shared lines are
+// only touched when the cached view says the ring looks full or empty.
+// Indices grow monotonically and are masked into the power-of-two slot array.
+//
+// Exactly one thread may push and exactly one thread may take at a time.
+// Plugs into asyncle::try_push/try_take (default_push_command/default_take_command)
+// through tag_invoke, so it satisfies pushable<spsc_ring, T> / takeable<spsc_ring, T>.
+// Batches of trivially copyable elements are copied with at most two memcpy
+// calls (element_dispatch); try_push also accepts a range of T, pushed in bulk
+// when the range is contiguous (range_dispatch).
+template <typename T, size_t Capacity>
+class spsc_ring {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_nothrow_destructible_v<T>, "Elements must be nothrow destructible");
+
+    public:
+    using value_type = T;
+
+    private:
+    static constexpr size_t mask = Capacity - 1;
+
+    // Consumer side
+    hardware::cache_padded<std::atomic<size_t>> head_ { size_t { 0 } };
+    hardware::cache_padded<size_t>              cached_tail_ { size_t { 0 } };
+
+    // Producer side
+    hardware::cache_padded<std::atomic<size_t>> tail_ { size_t { 0 } };
+    hardware::cache_padded<size_t>              cached_head_ { size_t { 0 } };
+
+    alignas(hardware::cache_line_size) alignas(T) std::byte storage_[sizeof(T) * Capacity];
+
+    T* slot(size_t index) noexcept { return std::launder(reinterpret_cast<T*>(storage_ + (index & mask) * sizeof(T))); }
+
+    // Free slots visible to the producer, refreshing the cached head only when needed
+    size_t writable(size_t tail, size_t wanted) noexcept {
+        size_t free_slots = Capacity - (tail - cached_head_.get());
+        if(free_slots < wanted) {
+            cached_head_.get() = head_->load(std::memory_order_acquire);
+            free_slots         = Capacity - (tail - cached_head_.get());
+        }
+        return free_slots;
+    }
+
+    // Filled slots visible to the consumer, refreshing the cached tail only when needed
+    size_t readable(size_t head, size_t wanted) noexcept {
+        size_t filled = cached_tail_.get() - head;
+        if(filled < wanted) {
+            cached_tail_.get() = tail_->load(std::memory_order_acquire);
+            filled             = cached_tail_.get() - head;
+        }
+        return filled;
+    }
+
+    // What push_range() constructs from: the elements of an owning rvalue range
+    // are moved from, everything else is copied
+    template <typename R>
+    using range_element_t = std::conditional_t<
+      !std::is_lvalue_reference_v<R> && !std::ranges::borrowed_range<R>,
+      std::ranges::range_rvalue_reference_t<R>,
+      std::ranges::range_reference_t<R>>;
+
+    // Trivially copyable batches: the run from index to the end of the slot
+    // array, then the rest from its start
+    void copy_in(size_t index, const T* from, size_t count) noexcept {
+        size_t first = std::min(count, Capacity - (index & mask));
+        std::memcpy(storage_ + (index & mask) * sizeof(T), from, first * sizeof(T));
+        if(count > first) std::memcpy(storage_, from + first, (count - first) * sizeof(T));
+    }
+
+    void copy_out(size_t index, T* to, size_t count) noexcept {
+        size_t first = std::min(count, Capacity - (index & mask));
+        std::memcpy(to, storage_ + (index & mask) * sizeof(T), first * sizeof(T));
+        if(count > first) std::memcpy(to + first, storage_, (count - first) * sizeof(T));
+    }
+
+    public:
+    // Constructors
+    spsc_ring() noexcept = default;
+
+    // Shared between threads by reference; never copied or moved
+    spsc_ring(const spsc_ring&)            = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    // Destructor
+    ~spsc_ring() {
+        size_t head = head_->load(std::memory_order_relaxed);
+        size_t tail = tail_->load(std::memory_order_relaxed);
+        for(; head != tail; ++head) { std::destroy_at(slot(head)); }
+    }
+
+    // Producer operations
+    template <typename... Args>
+    requires std::is_nothrow_constructible_v<T, Args...>
+    bool emplace(Args&&... args) noexcept {
+        size_t tail = tail_->load(std::memory_order_relaxed);
+        if(writable(tail, 1) == 0) return false;
+        std::construct_at(slot(tail), std::forward<Args>(args)...);
+        tail_->store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename U>
+    requires std::is_nothrow_constructible_v<T, U>
+    bool push(U&& value) noexcept {
+        return emplace(std::forward<U>(value));
+    }
+
+    // Copy as many leading elements as fit; publishes them with a single release store
+    size_t push_batch(std::span<const T> values) noexcept
+    requires std::is_nothrow_copy_constructible_v<T>
+    {
+        size_t tail  = tail_->load(std::memory_order_relaxed);
+        size_t count = writable(tail, values.size());
+        if(count > values.size()) count = values.size();
+        if constexpr(dispatches_to<element_dispatch, T, trivial_copy_path>) {
+            copy_in(tail, values.data(), count);
+        } else {
+            for(size_t i = 0; i < count; ++i) { std::construct_at(slot(tail + i), values[i]); }
+        }
+        if(count) tail_->store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Push leading elements of values while they fit. Contiguous ranges of
+    // trivially copyable T go through push_batch; other ranges are walked, and
+    // an owning rvalue range has its elements moved out.
+    template <std::ranges::forward_range R>
+    requires std::same_as<std::ranges::range_value_t<R>, T>
+          && std::is_nothrow_constructible_v<T, range_element_t<R>>
+    size_t push_range(R&& values) noexcept {
+        if constexpr(bulk_copyable_range<R>) {
+            return push_batch(std::span<const T>(std::ranges::data(values), std::ranges::size(values)));
+        } else {
+            size_t tail   = tail_->load(std::memory_order_relaxed);
+            size_t wanted = Capacity;
+            if constexpr(std::ranges::sized_range<R>) wanted = std::ranges::size(values);
+            size_t room  = writable(tail, wanted);
+            size_t count = 0;
+            for(auto&& value : values) {
+                if(count == room) break;
+                std::construct_at(slot(tail + count), static_cast<range_element_t<R>>(value));
+                ++count;
+            }
+            if(count) tail_->store(tail + count, std::memory_order_release);
+            return count;
+        }
+    }
+
+    // Consumer operations
+    bool take(T& out) noexcept
+    requires std::is_nothrow_move_assignable_v<T>
+    {
+        size_t head = head_->load(std::memory_order_relaxed);
+        if(readable(head, 1) == 0) return false;
+        T* item = slot(head);
+        out     = std::move(*item);
+        std::destroy_at(item);
+        head_->store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Move up to out.size() elements into out; frees the slots with a single release store
+    size_t take_batch(std::span<T> out) noexcept
+    requires std::is_nothrow_move_assignable_v<T>
+    {
+        size_t head  = head_->load(std::memory_order_relaxed);
+        size_t count = readable(head, out.size());
+        if(count > out.size()) count = out.size();
+        if constexpr(dispatches_to<element_dispatch, T, trivial_copy_path>) {
+            copy_out(head, out.data(), count);
+        } else {
+            for(size_t i = 0; i < count; ++i) {
+                T* item = slot(head + i);
+                out[i]  = std::move(*item);
+                std::destroy_at(item);
+            }
+        }
+        if(count) head_->store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Oldest element without removing it (consumer only); nullptr when empty
+    T* front() noexcept {
+        size_t head = head_->load(std::memory_order_relaxed);
+        return readable(head, 1) ? slot(head) : nullptr;
+    }
+
+    // State queries (approximate while the other side is running, but always
+    // within [0, Capacity], for observers on any thread too)
+    size_t size() const noexcept {
+        // head first: it never passes the tail read after it
+        size_t head = head_->load(std::memory_order_acquire);
+        size_t tail = tail_->load(std::memory_order_acquire);
+        size_t used = tail > head ? tail - head : 0;
+        return used < Capacity ? used : Capacity;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    bool full() const noexcept { return size() >= Capacity; }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+    // CPO integration: can_push/can_take
+    friend check_status tag_invoke(can_work_t, const spsc_ring& ring, default_push_command) noexcept {
+        return ring.full() ? check_status::FALSE : check_status::TRUE;
+    }
+
+    friend check_status tag_invoke(can_work_t, const spsc_ring& ring, default_take_command) noexcept {
+        return ring.empty() ? check_status::FALSE : check_status::TRUE;
+    }
+
+    // CPO integration: try_push/try_take; a full or empty ring reports error false
+    template <typename U>
+    requires std::is_nothrow_constructible_v<T, U>
+    friend expected<bool, bool> tag_invoke(default_push_command, spsc_ring& ring, U&& value) noexcept {
+        if(ring.emplace(std::forward<U>(value))) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+
+    // A range of T is pushed whole or not at all: error false when the free
+    // slots cannot take every element (push_range() pushes a prefix instead)
+    template <std::ranges::forward_range R>
+    requires(!std::is_constructible_v<T, R>) && requires(spsc_ring& r, R&& values) {
+        r.push_range(std::forward<R>(values));
+    }
+    friend expected<bool, bool> tag_invoke(default_push_command, spsc_ring& ring, R&& values) noexcept {
+        size_t wanted = static_cast<size_t>(std::ranges::distance(values));
+        if(ring.writable(ring.tail_->load(std::memory_order_relaxed), wanted) < wanted) {
+            return expected<bool, bool>(unexpect, false);
+        }
+        ring.push_range(std::forward<R>(values));
+        return expected<bool, bool>(true);
+    }
+
+    // An rvalue target (try_take(ring, T {})) takes and drops the oldest element
+    template <typename U>
+    requires std::same_as<std::remove_cvref_t<U>, T> && (!std::is_const_v<std::remove_reference_t<U>>)
+    friend expected<bool, bool> tag_invoke(default_take_command, spsc_ring& ring, U&& out) noexcept {
+        if(ring.take(out)) return expected<bool, bool>(true);
+        return expected<bool, bool>(unexpect, false);
+    }
+
+    // CPO integration: work_batch with the push/take commands (one release store
+    // per batch); items past a full or empty ring report error false
+    template <typename U>
+    requires std::same_as<std::remove_const_t<U>, T>
+    friend size_t tag_invoke(work_batch_t, spsc_ring& ring, default_push_command, std::span<U> values,
+                             std::span<expected<bool, bool>> results) noexcept {
+        size_t count  = std::min(values.size(), results.size());
+        size_t pushed = ring.push_batch(std::span<const T>(values.data(), count));
+        for(size_t i = 0; i < count; ++i) {
+            results[i] = i < pushed ? expected<bool, bool>(true) : expected<bool, bool>(unexpect, false);
+        }
+        return count;
+    }
+
+    friend size_t tag_invoke(work_batch_t, spsc_ring& ring, default_take_command, std::span<T> out,
+                             std::span<expected<bool, bool>> results) noexcept {
+        size_t count = std::min(out.size(), results.size());
+        size_t taken = ring.take_batch(out.first(count));
+        for(size_t i = 0; i < count; ++i) {
+            results[i] = i < taken ? expected<bool, bool>(true) : expected<bool, bool>(unexpect, false);
+        }
+        return count;
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_SPSC_RING_HPP
@@ -0,0 +1,352 @@
+#ifndef ASYNCLE_CONCURRENT_THREAD_POOL_HPP
+#define ASYNCLE_CONCURRENT_THREAD_POOL_HPP
+
+#include "../../platform/hardware.hpp"
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../compat.hpp"
+#include "../concepts/utility_concepts.hpp"
+#include "../hardware/memory.hpp"
+#include "../meta/entries.hpp"
+#include "chase_lev_deque.hpp"
+#include "mpmc_queue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle::concurrent {
+
+// Executor error codes
+enum class executor_error : uint8_t {
+    stopped,       // Pool not running (never started or shutting down)
+    queue_full,    // External submission queue is full
+    no_memory,     // Task allocation failed
+    start_failed,  // Worker threads could not be created
+};
+
+// Tasks are move-constructible callables taking no arguments
+template <class T>
+struct pred_task: std::bool_constant<std::is_invocable_v<T&> && std::is_move_constructible_v<T>> {};
+
+// work(pool, submit_command {}, task) -> expected<bool, executor_error>; true = queued
+using submit_command = command<executor_error, pred_map<pred_task, bool>>;
+
+// Thread pool options
+struct pool_options {
+    size_t  workers        = 0;      // 0 = one per available CPU
+    size_t  deque_capacity = 256;    // Initial per-worker deque size (grows on demand)
+    bool    pin_workers    = false;  // Pin worker i to the i-th CPU of the process affinity mask
+    int32_t numa_node      = -1;     // >= 0: use and pin to only this node's allowed CPUs
+};
+
+// Work-stealing thread pool.
+// Each worker owns a Chase-Lev deque: tasks submitted from a worker go to the
+// bottom of its own deque (LIFO, cache-warm), idle workers steal from the top of
+// a randomly chosen victim (FIFO, oldest and usually largest work first).
+// Submissions from outside the pool go through a shared MPMC injection queue.
+// Idle workers park on an atomic epoch and are woken only when someone is parked.
+//
+// Tasks must not throw; an escaping exception terminates the process.
+class work_stealing_pool {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = executor_error;
+    template <typename T>
+    using result_type = expected<T, executor_error>;
+
+    static constexpr size_t injection_capacity = 4096;
+
+    private:
+    struct task_base {
+        void (*invoke)(task_base*) noexcept;
+    };
+
+    template <typename F>
+    struct task_impl: task_base {
+        F fn;
+
+        template <typename U>
+        explicit task_impl(U&& f): task_base { &run }, fn(std::forward<U>(f)) {}
+
+        static void run(task_base* base) noexcept {
+            auto* self = static_cast<task_impl*>(base);
+            self->fn();
+            delete self;
+        }
+    };
+
+    struct alignas(hardware::cache_line_size) worker {
+        chase_lev_deque<task_base*> deque;
+        uint64_t                    rng;
+        std::thread                 thread;
+
+        explicit worker(size_t capacity) noexcept: deque(capacity), rng(0) {}
+    };
+
+    using injection_queue = mpmc_queue<task_base*, injection_capacity>;
+
+    worker*                          workers_      = nullptr;  // Raw storage; workers are placement-constructed
+    std::unique_ptr<injection_queue> injection_;
+    size_t                           worker_count_ = 0;
+
+    hardware::cache_padded<std::atomic<uint32_t>> epoch_ { uint32_t { 0 } };      // Bumped on every submission
+    hardware::cache_padded<std::atomic<uint32_t>> sleepers_ { uint32_t { 0 } };   // Workers parked on epoch_
+    hardware::cache_padded<std::atomic<size_t>>   outstanding_ { size_t { 0 } };  // Submitted but not finished
+    std::atomic<bool>                             running_ { false };
+
+    // Identity of the calling thread when it is one of our workers
+    static inline thread_local work_stealing_pool* current_pool_   = nullptr;
+    static inline thread_local size_t              current_worker_ = 0;
+
+    static uint64_t next_random(uint64_t& state) noexcept {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    task_base* find_task(size_t self) noexcept {
+        task_base* task = nullptr;
+        if(workers_[self].deque.take(task)) return task;
+        if(injection_->take(task)) return task;
+
+        // Random starting victim, then sweep every other worker once
+        size_t start = static_cast<size_t>(next_random(workers_[self].rng) % worker_count_);
+        for(size_t i = 0; i < worker_count_; ++i) {
+            size_t victim = (start + i) % worker_count_;
+            if(victim != self && workers_[victim].deque.steal(task)) return task;
+        }
+        return nullptr;
+    }
+
+    void run_task(task_base* task) noexcept {
+        task->invoke(task);
+        if(outstanding_->fetch_sub(1, std::memory_order_acq_rel) == 1) { outstanding_->notify_all(); }
+    }
+
+    void worker_main(size_t self, size_t cpu, bool pin) noexcept {
+        current_pool_   = this;
+        current_worker_ = self;
+        if(pin) { platform::hardware::pin_current_thread(cpu); }
+
+        constexpr int spin_rounds = 64;
+        while(true) {
+            uint32_t   seen = epoch_->load(std::memory_order_seq_cst);
+            task_base* task = nullptr;
+            for(int spin = 0; spin < spin_rounds && !task; ++spin) {
+                task = find_task(self);
+                if(!task && spin >= spin_rounds / 2) std::this_thread::yield();
+            }
+            if(task) {
+                run_task(task);
+                continue;
+            }
+            if(!running_.load(std::memory_order_acquire)) break;  // stop() runs whatever is left
+
+            // Park until the epoch moves; a submission after `seen` was read makes wait() return at once
+            sleepers_->fetch_add(1, std::memory_order_seq_cst);
+            epoch_->wait(seen, std::memory_order_seq_cst);
+            sleepers_->fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        current_pool_ = nullptr;
+    }
+
+    void wake_one() noexcept {
+        epoch_->fetch_add(1, std::memory_order_seq_cst);
+        if(sleepers_->load(std::memory_order_seq_cst) > 0) { epoch_->notify_one(); }
+    }
+
+    void wake_all() noexcept {
+        epoch_->fetch_add(1, std::memory_order_seq_cst);
+        epoch_->notify_all();
+    }
+
+    result_type<bool> enqueue(task_base* task) noexcept {
+        outstanding_->fetch_add(1, std::memory_order_relaxed);
+        bool queued = false;
+        if(current_pool_ == this) { queued = workers_[current_worker_].deque.push(task); }
+        if(!queued) { queued = injection_->push(task); }
+        if(!queued) {
+            outstanding_->fetch_sub(1, std::memory_order_relaxed);
+            return result_type<bool>(unexpect, executor_error::queue_full);
+        }
+        wake_one();
+        return result_type<bool>(true);
+    }
+
+    public:
+    // Constructors
+    // Starts the workers immediately; check is_running() for failure
+    explicit work_stealing_pool(const pool_options& options = {}) noexcept { start(options); }
+
+    // Workers hold a pointer to the pool; never copied or moved
+    work_stealing_pool(const work_stealing_pool&)            = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    // Destructor
+    ~work_stealing_pool() { stop(); }
+
+    // Core operations
+    result_type<bool> start(const pool_options& options = {}) noexcept {
+        if(running_.load(std::memory_order_acquire) || workers_) {
+            return result_type<bool>(unexpect, executor_error::start_failed);
+        }
+
+        // CPUs of the affinity mask, used for the default size and for pinning
+        constexpr size_t max_cpus = 1024;
+        auto             cpus     = std::unique_ptr<size_t[]>(new(std::nothrow) size_t[max_cpus]);
+        if(!cpus) return result_type<bool>(unexpect, executor_error::no_memory);
+        size_t cpu_count = platform::hardware::available_cpus(cpus.get(), max_cpus);
+        if(cpu_count > max_cpus) cpu_count = max_cpus;
+        if(options.numa_node >= 0) {
+            cpu_count = node_cpus(static_cast<uint32_t>(options.numa_node), cpus.get(), max_cpus);
+            if(cpu_count == 0) return result_type<bool>(unexpect, executor_error::start_failed);
+        }
+        if(cpu_count == 0) {
+            cpus[0]   = 0;
+            cpu_count = 1;
+        }
+
+        size_t count = options.workers ? options.workers : cpu_count;
+        injection_.reset(new(std::nothrow) injection_queue());
+        workers_ = static_cast<worker*>(
+          ::operator new[](count * sizeof(worker), std::align_val_t { alignof(worker) }, std::nothrow));
+        if(!injection_ || !workers_) {
+            if(workers_) ::operator delete[](workers_, std::align_val_t { alignof(worker) });
+            workers_ = nullptr;
+            injection_.reset();
+            return result_type<bool>(unexpect, executor_error::no_memory);
+        }
+        return launch(options, count, cpus.get(), cpu_count);
+    }
+
+    // Finish every queued task, then join the workers
+    void stop() noexcept {
+        if(!workers_) return;
+        running_.store(false, std::memory_order_release);
+        wake_all();
+        for(size_t i = 0; i < worker_count_; ++i) {
+            if(workers_[i].thread.joinable()) workers_[i].thread.join();
+        }
+
+        // Tasks that raced with shutdown; the workers are gone, so run them here
+        task_base* task = nullptr;
+        while(injection_->take(task)) { run_task(task); }
+        for(size_t i = 0; i < worker_count_; ++i) {
+            while(workers_[i].deque.take(task)) { run_task(task); }
+        }
+        destroy_workers(worker_count_);
+        injection_.reset();
+        worker_count_ = 0;
+    }
+
+    // Queue a task; from a worker thread it lands on that worker's own deque
+    template <typename F>
+    requires pred_task<std::decay_t<F>>::value
+    result_type<bool> submit(F&& fn) noexcept {
+        if(!running_.load(std::memory_order_acquire)) return result_type<bool>(unexpect, executor_error::stopped);
+
+        task_base* task = nullptr;
+        try {
+            task = new(std::nothrow) task_impl<std::decay_t<F>>(std::forward<F>(fn));
+        } catch(...) {
+            task = nullptr;  // Throwing copy of the callable
+        }
+        if(!task) return result_type<bool>(unexpect, executor_error::no_memory);
+
+        auto queued = enqueue(task);
+        if(!queued) delete static_cast<task_impl<std::decay_t<F>>*>(task);
+        return queued;
+    }
+
+    // Block until every submitted task has finished (must not be called from a task)
+    void wait_idle() const noexcept {
+        size_t pending = outstanding_->load(std::memory_order_acquire);
+        while(pending != 0) {
+            outstanding_->wait(pending, std::memory_order_acquire);
+            pending = outstanding_->load(std::memory_order_acquire);
+        }
+    }
+
+    // State queries
+    size_t worker_count() const noexcept { return worker_count_; }
+
+    size_t pending() const noexcept { return outstanding_->load(std::memory_order_relaxed); }
+
+    bool is_running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    explicit operator bool() const noexcept { return is_running(); }
+
+    // Index of the calling worker in this pool, or -1 when called from elsewhere
+    std::ptrdiff_t current_worker() const noexcept {
+        return current_pool_ == this ? static_cast<std::ptrdiff_t>(current_worker_) : -1;
+    }
+
+    // CPO integration: work(pool, submit_command {}, task) / can_work(pool, submit_command {})
+    template <typename F>
+    requires pred_task<std::decay_t<F>>::value
+    friend result_type<bool> tag_invoke(submit_command, work_stealing_pool& pool, F&& fn) noexcept {
+        return pool.submit(std::forward<F>(fn));
+    }
+
+    friend check_status tag_invoke(can_work_t, const work_stealing_pool& pool, submit_command) noexcept {
+        return pool.is_running() ? check_status::TRUE : check_status::FALSE;
+    }
+
+    private:
+    // Allowed CPUs of one NUMA node, in OS order
+    static size_t node_cpus(uint32_t node, size_t* cpus, size_t max_count) noexcept {
+        auto locations = std::unique_ptr<platform::hardware::cpu_location[]>(
+          new(std::nothrow) platform::hardware::cpu_location[max_count]);
+        if(!locations) return 0;
+        size_t total = platform::hardware::detect_cpu_topology(locations.get(), max_count);
+        size_t count = 0;
+        for(size_t i = 0; i < total && i < max_count; ++i) {
+            if(locations[i].node == node && locations[i].allowed) cpus[count++] = locations[i].cpu;
+        }
+        return count;
+    }
+
+    result_type<bool> launch(const pool_options& options, size_t count, const size_t* cpus, size_t cpu_count) noexcept {
+        for(size_t i = 0; i < count; ++i) {
+            new(&workers_[i]) worker(options.deque_capacity);
+            workers_[i].rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+            if(!workers_[i].deque.is_valid()) {
+                destroy_workers(i + 1);
+                injection_.reset();
+                return result_type<bool>(unexpect, executor_error::no_memory);
+            }
+        }
+
+        worker_count_ = count;
+        running_.store(true, std::memory_order_release);
+        for(size_t i = 0; i < count; ++i) {
+            try {
+                bool pin           = options.pin_workers || options.numa_node >= 0;
+                workers_[i].thread = std::thread([this, i, cpu = cpus[i % cpu_count], pin] { worker_main(i, cpu, pin); });
+            } catch(...) {
+                // Keep the workers that did start; stop() joins them
+                stop();
+                return result_type<bool>(unexpect, executor_error::start_failed);
+            }
+        }
+        return result_type<bool>(true);
+    }
+
+    void destroy_workers(size_t count) noexcept {
+        for(size_t i = 0; i < count; ++i) { workers_[i].~worker(); }
+        ::operator delete[](workers_, std::align_val_t { alignof(worker) });
+        workers_ = nullptr;
+    }
+};
+
+}  // namespace asyncle::concurrent
+
+#endif  // ASYNCLE_CONCURRENT_THREAD_POOL_HPP
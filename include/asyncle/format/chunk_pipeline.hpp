@@ -0,0 +1,161 @@
+#ifndef ASYNCLE_FORMAT_CHUNK_PIPELINE_HPP
+#define ASYNCLE_FORMAT_CHUNK_PIPELINE_HPP
+
+// asyncle::format::detail::run_chunks - Bounded chunk window over a pool
+//
+// The shared engine behind json::parse_parallel and csv::parse_parallel. The
+// calling thread cuts [offset, length) into chunks with next_end(begin) and
+// keeps up to window of them out on the pool. Each task fills one chunk's
+// values with fill(values, begin, end) and hands the chunk back through a
+// bounded queue. The calling thread then hands the values to consume, either
+// in chunk order or as chunks complete.
+//
+// Workers keep the queue and its completion counter alive through a
+// shared_ptr. That way, signalling after the last chunk is pushed never
+// touches the caller's frame. run_chunks does not return or rethrow until
+// every submitted chunk has come back, so fill and everything it references
+// only need to outlive the call.
+
+#include "../concurrent/mpmc_queue.hpp"
+#include "../concurrent/thread_pool.hpp"
+#include "../hardware/memory.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace asyncle::format::detail {
+
+// Upper bound on chunks worked on ahead of the consumer
+inline constexpr size_t max_chunks_in_flight = 256;
+
+template <typename Error>
+struct chunk_outcome {
+    size_t total   = 0;  // Values consumed
+    Error  failure = Error::none;
+};
+
+template <typename T, typename Error>
+struct chunk_slot {
+    size_t         index = 0;
+    size_t         begin = 0;
+    size_t         end   = 0;
+    std::vector<T> values;
+    Error          status = Error::none;
+};
+
+// Owned jointly by the caller and every task it submits
+template <typename T, typename Error>
+struct chunk_window_state {
+    using slot_type = chunk_slot<T, Error>;
+
+    std::unique_ptr<slot_type[]>                                  slots;
+    concurrent::mpmc_queue<slot_type*, max_chunks_in_flight>      done;
+    hardware::cache_padded<std::atomic<size_t>>                   completed { size_t { 0 } };
+
+    explicit chunk_window_state(size_t window): slots(new slot_type[window]) {}
+
+    // Fill one chunk and hand it back; runs on a worker, or inline when the pool rejects the task
+    template <typename Fill>
+    void run(Fill& fill, slot_type* c) noexcept {
+        try {
+            c->status = fill(c->values, c->begin, c->end);
+        } catch(...) {
+            c->status = Error::capacity_exceeded;  // Allocation failure while collecting values
+        }
+        // The push releases the chunk to the caller; only this state is touched afterwards
+        while(!done.push(c)) {}  // Never full: at most window <= capacity chunks are out
+        completed->fetch_add(1, std::memory_order_release);
+        completed->notify_one();
+    }
+
+    // Block until a chunk comes back
+    slot_type* take() noexcept {
+        slot_type* c = nullptr;
+        for(;;) {
+            size_t seen = completed->load(std::memory_order_acquire);
+            if(done.take(c)) return c;
+            completed->wait(seen, std::memory_order_acquire);
+        }
+    }
+};
+
+// Run fill over every chunk of [offset, length) on pool and feed the values to
+// consume; stops submitting at the first failed chunk and reports its status
+template <typename T, typename Error, typename NextEnd, typename Fill, typename Consume>
+chunk_outcome<Error> run_chunks(
+  concurrent::work_stealing_pool& pool,
+  size_t                          offset,
+  size_t                          length,
+  size_t                          window,
+  bool                            ordered,
+  NextEnd&&                       next_end,
+  Fill&&                          fill,
+  Consume&&                       consume) {
+    using state_type = chunk_window_state<T, Error>;
+    using slot_type  = typename state_type::slot_type;
+
+    if(window == 0) window = 1;
+    if(window > max_chunks_in_flight) window = max_chunks_in_flight;
+
+    auto                         state = std::make_shared<state_type>(window);
+    std::unique_ptr<slot_type*[]> parked(new slot_type*[window]());  // Ordered reassembly
+    std::vector<slot_type*>      free_slots;
+    for(size_t i = window; i > 0; --i) { free_slots.push_back(&state->slots[i - 1]); }
+
+    size_t               submitted = 0;
+    size_t               returned  = 0;
+    size_t               delivered = 0;
+    chunk_outcome<Error> out;
+
+    auto deliver = [&](slot_type* c) {
+        ++delivered;
+        if(c->status != Error::none && out.failure == Error::none) out.failure = c->status;
+        if(out.failure == Error::none) {
+            for(auto& value : c->values) { consume(std::move(value)); }
+            out.total += c->values.size();
+        }
+        c->values.clear();  // Keeps capacity for the next chunk in this slot
+        c->status = Error::none;
+        free_slots.push_back(c);
+    };
+
+    try {
+        for(;;) {
+            // Keep the window full
+            while(out.failure == Error::none && offset < length && !free_slots.empty()) {
+                slot_type* c = free_slots.back();
+                free_slots.pop_back();
+                c->index = submitted;
+                c->begin = offset;
+                c->end = offset = next_end(offset);
+                ++submitted;
+                if(!pool.submit([state, &fill, c] { state->run(fill, c); })) state->run(fill, c);
+            }
+            if(returned == submitted) break;
+
+            slot_type* c = state->take();
+            ++returned;
+            if(!ordered) {
+                deliver(c);
+                continue;
+            }
+            parked[c->index % window] = c;
+            while(slot_type* next = parked[delivered % window]) {
+                if(next->index != delivered) break;
+                parked[delivered % window] = nullptr;
+                deliver(next);
+            }
+        }
+    } catch(...) {
+        // Tasks still reference fill; let them finish before unwinding past it
+        for(; returned < submitted; ++returned) state->take();
+        throw;
+    }
+    return out;
+}
+
+}  // namespace asyncle::format::detail
+
+#endif  // ASYNCLE_FORMAT_CHUNK_PIPELINE_HPP
@@ -0,0 +1,216 @@
+#ifndef ASYNCLE_FORMAT_CSV_HPP
+#define ASYNCLE_FORMAT_CSV_HPP
+
+// asyncle::format::csv - Mapped CSV files and multi-core loading
+//
+// mapped_csv maps a file read-only so the tokenizer indexes the page cache in
+// place. parse_parallel() cuts a text into chunks of about chunk_size bytes,
+// each ending at a row boundary. Because a quoted field may hold newlines, the
+// boundaries are found on the calling thread: a quote-parity scan (the
+// tokenizer's classification pass, without the field index) from the start of
+// each chunk. Each chunk then becomes one pool task that tokenizes it and
+// maps every row to a value. Finished chunks come back through the bounded
+// queue shared with json::parse_parallel (chunk_pipeline.hpp), and the calling
+// thread hands each chunk's values to the consumer, in text order or as chunks
+// complete.
+//
+// At most in_flight chunks are worked on ahead of the consumer, which bounds
+// memory. map runs concurrently on pool workers and must be thread-safe;
+// consume runs only on the calling thread, which must not itself be a pool
+// worker. When the pool rejects a task, the chunk is parsed inline.
+//
+// Usage:
+//   struct trade { std::string_view symbol; int64_t qty; double price; };
+//   auto file   = csv::mapped_csv::open("trades.csv");
+//   auto trades = csv::load_parallel<trade>(file->view(), pool, { .header = true });
+
+#include "../concurrent/thread_pool.hpp"
+#include "../io/file.hpp"
+#include "../io/mmap.hpp"
+#include "chunk_pipeline.hpp"
+#include <cstddef>
+#include <format/csv.hpp>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asyncle::format::csv {
+
+// Re-export foundation types
+using ::format::csv::append_row;
+using ::format::csv::bind_row;
+using ::format::csv::column_count_v;
+using ::format::csv::dialect;
+using ::format::csv::error;
+using ::format::csv::expected;
+using ::format::csv::field_index;
+using ::format::csv::kernel_name;
+using ::format::csv::load_rows;
+using ::format::csv::result;
+using ::format::csv::row;
+using ::format::csv::row_end;
+using ::format::csv::row_type;
+using ::format::csv::tokenize;
+using ::format::csv::unescape;
+using ::format::csv::unexpect;
+using ::format::csv::unquote;
+
+class mapped_csv {
+    io::mmap map_;
+    size_t   length_ = 0;
+    bool     open_   = false;
+
+    public:
+    mapped_csv() noexcept = default;
+
+    mapped_csv(mapped_csv&& other) noexcept:
+        map_(std::move(other.map_)),
+        length_(std::exchange(other.length_, 0)),
+        open_(std::exchange(other.open_, false)) {}
+
+    mapped_csv& operator=(mapped_csv&& other) noexcept {
+        if(this != &other) {
+            map_    = std::move(other.map_);
+            length_ = std::exchange(other.length_, 0);
+            open_   = std::exchange(other.open_, false);
+        }
+        return *this;
+    }
+
+    mapped_csv(const mapped_csv&)            = delete;
+    mapped_csv& operator=(const mapped_csv&) = delete;
+
+    // Map path read-only; io_error when it cannot be opened, sized or mapped
+    static result<mapped_csv> open(const char* path) noexcept {
+        io::file f;
+        if(!f.open(path)) return result<mapped_csv>(unexpect, error::io_error);
+        auto size = f.size();
+        if(!size) return result<mapped_csv>(unexpect, error::io_error);
+
+        mapped_csv out;
+        out.length_ = static_cast<size_t>(*size);
+        if(out.length_ > 0) {
+            io::memory_request req {};
+            req.length  = out.length_;
+            req.backing = io::backing_type::file_backed;
+            req.access  = io::mmap_access::access_mode::read;
+            req.sharing = io::sharing_mode::private_cow;
+            req.pattern = io::access_pattern::sequential_access;
+            if(!out.map_.map(req, f.fd())) return result<mapped_csv>(unexpect, error::io_error);
+        }
+        out.open_ = true;
+        return result<mapped_csv>(std::move(out));
+    }
+
+    std::string_view view() const noexcept {
+        return length_ ? std::string_view(static_cast<const char*>(map_.data()), length_) : std::string_view();
+    }
+
+    size_t size() const noexcept { return length_; }
+
+    const io::mmap& mapping() const noexcept { return map_; }
+
+    bool is_valid() const noexcept { return open_; }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+// Upper bound on chunks worked on ahead of the consumer
+inline constexpr size_t max_in_flight = ::asyncle::format::detail::max_chunks_in_flight;
+
+struct parallel_options {
+    size_t chunk_size = size_t { 4 } << 20;  // Target bytes per task; extended to the next row end
+    size_t in_flight  = 0;                   // Chunks ahead of the consumer (0 = 4 per worker)
+    bool   ordered    = true;                // Deliver in text order rather than completion order
+    bool   skip_blank = true;                // Drop blank lines instead of mapping them
+};
+
+namespace detail {
+
+// Per-worker field index; keeps its capacity from chunk to chunk
+inline field_index& chunk_index() {
+    thread_local field_index rows;
+    return rows;
+}
+
+}  // namespace detail
+
+// Map every row of text across pool with map(const row&) -> result<V>, and
+// pass the values to consume(V&&); returns the number of rows consumed. Blank
+// lines are skipped unless options.skip_blank is cleared, and so is the first
+// row when d.header is set.
+template <typename Map, typename Consume>
+result<size_t> parse_parallel(
+  std::string_view                text,
+  concurrent::work_stealing_pool& pool,
+  Map&&                           map,
+  Consume&&                       consume,
+  const dialect&                  d       = {},
+  const parallel_options&         options = {}) {
+    using mapped_type = std::remove_cvref_t<std::invoke_result_t<Map&, const row&>>;
+    using value_type  = typename mapped_type::value_type;
+
+    size_t window = options.in_flight ? options.in_flight : 4 * (pool.worker_count() ? pool.worker_count() : 1);
+    if(window > max_in_flight) window = max_in_flight;
+    // Offsets within a chunk are 32-bit
+    size_t chunk_size = options.chunk_size ? options.chunk_size : 1;
+    if(chunk_size > (size_t { 1 } << 30)) chunk_size = size_t { 1 } << 30;
+
+    auto outcome = ::asyncle::format::detail::run_chunks<value_type, error>(
+      pool,
+      d.header ? row_end(text, 0, 0, d) : 0,
+      text.size(),
+      window,
+      options.ordered,
+      [&](size_t offset) { return row_end(text, offset, offset + chunk_size - 1, d); },
+      [&](std::vector<value_type>& values, size_t begin, size_t end) {
+          field_index& rows      = detail::chunk_index();
+          auto         tokenized = rows.assign(text.substr(begin, end - begin), d);
+          if(!tokenized) return tokenized.error();
+          for(size_t i = 0; i < rows.row_count(); ++i) {
+              const row r = rows.row(i);
+              if(options.skip_blank && r.blank()) continue;
+              auto value = map(r);
+              if(!value) return value.error();
+              values.push_back(std::move(*value));
+          }
+          return error::none;
+      },
+      consume);
+
+    if(outcome.failure != error::none) return result<size_t>(unexpect, outcome.failure);
+    return result<size_t>(outcome.total);
+}
+
+// Bind every row of text to a T across pool, in text order. std::string_view
+// members view text, which must outlive the result.
+template <row_type T>
+result<std::vector<T>> load_parallel(
+  std::string_view                text,
+  concurrent::work_stealing_pool& pool,
+  const dialect&                  d       = {},
+  const parallel_options&         options = {}) {
+    std::vector<T>   out;
+    parallel_options ordered = options;
+    ordered.ordered          = true;
+    ordered.skip_blank       = !::format::csv::detail::binds_blank<T>();  // As load_rows
+    auto loaded              = parse_parallel(
+      text,
+      pool,
+      [quote = d.quote](const row& r) -> result<T> {
+          T    value {};
+          auto e = bind_row(r, value, quote);
+          if(e != error::none) return result<T>(unexpect, e);
+          return result<T>(std::move(value));
+      },
+      [&out](T&& value) { out.push_back(std::move(value)); },
+      d,
+      ordered);
+    if(!loaded) return result<std::vector<T>>(unexpect, loaded.error());
+    return result<std::vector<T>>(std::move(out));
+}
+
+}  // namespace asyncle::format::csv
+
+#endif  // ASYNCLE_FORMAT_CSV_HPP
@@ -28,16 +28,30 @@
 
 #include "../base/cpo.hpp"
 #include "../concepts/operation_concepts.hpp"
+#include "../instrument.hpp"
+#include <cstddef>
+#include <format/json/dom.hpp>     // Mutable DOM for read-modify-write
 #include <format/json/parser.hpp>  // Unified parser interface
 #include <string_view>
 
 namespace asyncle::format::json {
 
 // Re-export foundation types (all abstract)
+using ::format::json::document_stream;  // Incremental NDJSON parsing
+using ::format::json::dom_type;
+using ::format::json::dom_value;
 using ::format::json::error;
 using ::format::json::error_string;
+using ::format::json::extract;  // One-pass typed field extraction
+using ::format::json::field;
+using ::format::json::input_padding;  // Slack required for in-place parsing
+using ::format::json::json_pointer;
+using ::format::json::mutable_document;  // Parse, patch, write back unchanged spans verbatim
+using ::format::json::padded_input;
 using ::format::json::parser;  // The unified parser type (implementation-agnostic)
 using ::format::json::parser_caps;
+using ::format::json::parser_lease;  // RAII lease on a pooled parser
+using ::format::json::parser_pool;   // Reusable parsers for high message rates
 using ::format::json::source_lifetime;
 
 template <typename T>
@@ -48,11 +62,19 @@ using result = ::format::json::result<T>;
 class parser_operation {
     public:
     explicit parser_operation(std::string_view data, source_lifetime lifetime = source_lifetime::stable):
-        data_(data),
+        input_ { data.data(), data.size(), data.size() },
+        lifetime_(lifetime) {}
+
+    // Caller buffer with slack after the document - parse() skips the copy
+    explicit parser_operation(padded_input input, source_lifetime lifetime = source_lifetime::persistent):
+        input_(input),
         lifetime_(lifetime) {}
 
     // Access configuration
-    std::string_view data() const noexcept { return data_; }
+    std::string_view data() const noexcept { return input_.view(); }
+
+    // True when parse() will read the source in place instead of copying it
+    bool in_place() const noexcept { return input_.has_padding(); }
 
     source_lifetime lifetime() const noexcept { return lifetime_; }
 
@@ -61,17 +83,25 @@ class parser_operation {
 
     // Parse operation - returns format::json::parser instance
     // Implementation is selected by format library, not asyncle
-    parser parse() const { return parser { data_ }; }
+    // Padded sources are parsed in place and must outlive the returned parser
+    // Timed as instrument::op::json_parse; on-demand parsers defer the real work
+    // to iteration, so this covers input preparation only (load/from_json time
+    // the whole parse)
+    parser parse() const {
+        instrument::scope timed(instrument::op::json_parse);
+        parser            doc { input_ };
+        timed.done(true, input_.length);
+        return doc;
+    }
 
     // Alternative: could return result if we want error handling here
     // result<parser> try_parse() const { ... }
 
-    // Future: async parse
-    // auto parse_async() -> async_operation<parser>;
+    // Offloaded parsing: see parse_async in json_async.hpp
 
     private:
-    std::string_view data_;
-    source_lifetime  lifetime_;
+    padded_input    input_;
+    source_lifetime lifetime_;
 };
 
 // Builder for parser operation
@@ -80,7 +110,18 @@ class parser_builder {
     parser_builder() = default;
 
     parser_builder& source(std::string_view data) noexcept {
-        data_ = data;
+        input_ = padded_input { data.data(), data.size(), data.size() };
+        return *this;
+    }
+
+    // capacity counts readable bytes from data; at least input_padding past length avoids the copy
+    parser_builder& padded_source(const char* data, size_t length, size_t capacity) noexcept {
+        input_ = padded_input { data, length, capacity };
+        return *this;
+    }
+
+    parser_builder& source(padded_input input) noexcept {
+        input_ = input;
         return *this;
     }
 
@@ -89,11 +130,11 @@ class parser_builder {
         return *this;
     }
 
-    parser_operation make() && { return parser_operation { data_, lifetime_ }; }
+    parser_operation make() && { return parser_operation { input_, lifetime_ }; }
 
     private:
-    std::string_view data_;
-    source_lifetime  lifetime_ = source_lifetime::stable;
+    padded_input    input_;
+    source_lifetime lifetime_ = source_lifetime::stable;
 };
 
 // Factory function - NO template parameters, NO implementation knowledge!
@@ -106,7 +147,10 @@ inline constexpr parser_caps capabilities() noexcept { return ::format::json::pa
 inline constexpr bool has_parser() noexcept { return ::format::json::has_parser_impl; }
 
 // Convenience: Direct parse (bypasses builder)
-inline parser parse(std::string_view data) { return ::format::json::parse(data); }
+inline parser parse(std::string_view data) { return parser_operation(data).parse(); }
+
+// Convenience: In-place parse of a padded buffer
+inline parser parse(padded_input input) { return parser_operation(input).parse(); }
 
 }  // namespace asyncle::format::json
 
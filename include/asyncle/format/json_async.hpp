@@ -0,0 +1,50 @@
+#ifndef ASYNCLE_FORMAT_JSON_ASYNC_HPP
+#define ASYNCLE_FORMAT_JSON_ASYNC_HPP
+
+// asyncle::format::json - JSON parsing offloaded to an executor
+//
+// parse_async and extract_async run the parse on a pool worker with a leased
+// parser and complete there, so an I/O coroutine can hand a buffer to the CPU
+// stage without blocking its own thread:
+//
+//   task<size_t> ingest(ring_scheduler& ring, work_stealing_pool& pool, parser_pool& parsers, file& in) {
+//       auto got   = co_await ring.read(in, request);
+//       auto count = co_await parse_async(pool, parsers, input,
+//                                         [&](auto& doc) { ids.push_back(doc["id"].get_int64().value()); });
+//       co_await ring.schedule();                        // Back to the ring thread for the next read
+//       co_return count ? *count : 0;
+//   }
+//
+// The input (and anything fn captures) must stay valid until the await
+// finishes. fn runs on the worker, one document at a time.
+
+#include "../async/work.hpp"
+#include "json.hpp"
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+namespace asyncle::format::json {
+
+// Parse every document of input (NDJSON or a single document) on ex, calling
+// fn(doc) for each; yields the document count
+template <async::executor E, typename F>
+auto parse_async(E& ex, parser_pool& parsers, padded_input input, F&& fn, size_t batch_size = 0) {
+    return async::offload(ex, [&parsers, input, batch_size, fn = std::forward<F>(fn)]() mutable -> result<size_t> {
+        auto lease = parsers.acquire();
+        return lease.for_each_document(input, fn, batch_size);
+    });
+}
+
+// One-pass typed extraction of Fields into out (see extract) on ex
+template <typename... Fields, async::executor E, typename T>
+auto extract_async(E& ex, parser_pool& parsers, std::string_view json, T& out) {
+    return async::offload(ex, [&parsers, json, &out]() -> result<size_t> {
+        auto lease = parsers.acquire();
+        return extract<Fields...>(lease, json, out);
+    });
+}
+
+}  // namespace asyncle::format::json
+
+#endif  // ASYNCLE_FORMAT_JSON_ASYNC_HPP
@@ -0,0 +1,181 @@
+#ifndef ASYNCLE_FORMAT_JSON_FILE_HPP
+#define ASYNCLE_FORMAT_JSON_FILE_HPP
+
+// asyncle::format::json::mapped_json - Parse JSON files in place through mmap
+//
+// The file is mapped read-only with the mapping rounded up so that at least
+// input_padding readable bytes follow the last document byte. Usually the
+// padding lands in the zero-filled tail of the file's last page; when the file
+// ends within input_padding of a page boundary, one anonymous zero page is
+// placed right behind the file mapping instead. Either way the parser reads the
+// page cache directly and the file is never copied.
+//
+// Usage:
+//   auto file = asyncle::format::json::mapped_json::open("catalog.json");
+//   if(!file) { /* file->error() == error::io_error */ }
+//   auto doc    = file->parse();  // Lives no longer than the mapped_json
+//   auto result = doc.iterate();
+//
+// stream_documents() feeds newline-delimited JSON from a file (read() chunks) or
+// a sliding mmap window (mapped_reader) through a document_stream;
+// stream_data_documents() maps only the data extents of a sparse file.
+
+#include "../io/extents.hpp"
+#include "../io/file.hpp"
+#include "../io/mapped_reader.hpp"
+#include "../io/mmap.hpp"
+#include "json.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace asyncle::format::json {
+
+class mapped_json {
+    io::mmap map_;         // Whole span: file pages plus padding tail
+    size_t   length_ = 0;  // Document bytes (file size)
+
+    public:
+    mapped_json() noexcept = default;
+
+    mapped_json(mapped_json&& other) noexcept: map_(std::move(other.map_)), length_(std::exchange(other.length_, 0)) {}
+
+    mapped_json& operator=(mapped_json&& other) noexcept {
+        if(this != &other) {
+            map_    = std::move(other.map_);
+            length_ = std::exchange(other.length_, 0);
+        }
+        return *this;
+    }
+
+    mapped_json(const mapped_json&)            = delete;
+    mapped_json& operator=(const mapped_json&) = delete;
+
+    // Map path read-only; io_error when it cannot be opened, sized or mapped
+    static result<mapped_json> open(const char* path) noexcept {
+        io::file f;
+        if(!f.open(path)) return result<mapped_json>(unexpect, error::io_error);
+        auto size = f.size();
+        if(!size) return result<mapped_json>(unexpect, error::io_error);
+
+        mapped_json out;
+        out.length_ = static_cast<size_t>(*size);
+
+        // Reserve file pages plus padding as zero pages, then overlay the file at the start
+        // The single region unmaps both; the file mapping keeps its own reference to the file
+        io::memory_request reserve {};
+        reserve.length  = io::mmap::align_to_page(out.length_ + input_padding);
+        reserve.backing = io::backing_type::anonymous;
+        reserve.access  = io::mmap_access::access_mode::read;
+        reserve.sharing = io::sharing_mode::private_cow;
+        if(!out.map_.map(reserve)) return result<mapped_json>(unexpect, error::io_error);
+
+        if(out.length_ > 0) {
+            io::memory_request req {};
+            req.length       = out.length_;
+            req.address_hint = out.map_.data();
+            req.placement    = io::placement_strategy::fixed_address;
+            req.backing      = io::backing_type::file_backed;
+            req.access       = io::mmap_access::access_mode::read;
+            req.sharing      = io::sharing_mode::private_cow;
+            req.pattern      = io::access_pattern::sequential_access;
+            if(!platform::mmap::map_memory(f.fd(), req)) return result<mapped_json>(unexpect, error::io_error);
+        }
+        return result<mapped_json>(std::move(out));
+    }
+
+    // Document with its readable slack, ready for in-place parsing
+    padded_input input() const noexcept {
+        return padded_input { static_cast<const char*>(map_.data()), length_, map_.size() };
+    }
+
+    std::string_view view() const noexcept { return input().view(); }
+
+    // Parse in place; the returned parser must not outlive this mapping
+    parser parse() const { return parser { input() }; }
+
+    size_t size() const noexcept { return length_; }
+
+    const io::mmap& mapping() const noexcept { return map_; }
+
+    bool is_valid() const noexcept { return map_.is_mapped(); }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+// Parse every NDJSON document in f, reading chunk_size bytes at a time from the current position
+// Returns the number of documents parsed
+template <typename F>
+result<size_t>
+  stream_documents(const io::file& f, document_stream& stream, F&& on_document, size_t chunk_size = 1 << 20) {
+    std::unique_ptr<char[]> chunk(new(std::nothrow) char[chunk_size]);
+    if(!chunk) return result<size_t>(unexpect, error::capacity_exceeded);
+
+    size_t total = 0;
+    for(;;) {
+        auto read = f.read(chunk.get(), chunk_size);
+        if(!read) return result<size_t>(unexpect, error::io_error);
+        if(*read == 0) break;
+        auto parsed = stream.feed(std::string_view(chunk.get(), *read), on_document);
+        if(!parsed) return parsed;
+        total += *parsed;
+    }
+    auto parsed = stream.finish(on_document);
+    if(!parsed) return parsed;
+    return result<size_t>(total + *parsed);
+}
+
+// Same over a sliding mmap window; pages behind the cursor are released as it advances
+template <typename F>
+result<size_t> stream_documents(io::mapped_reader& reader, document_stream& stream, F&& on_document) {
+    size_t total = 0;
+    for(;;) {
+        auto view = reader.next();
+        if(!view) return result<size_t>(unexpect, error::io_error);
+        if(view->empty()) break;
+        auto parsed =
+          stream.feed(std::string_view(reinterpret_cast<const char*>(view->data()), view->size()), on_document);
+        if(!parsed) return parsed;
+        total += *parsed;
+    }
+    auto parsed = stream.finish(on_document);
+    if(!parsed) return parsed;
+    return result<size_t>(total + *parsed);
+}
+
+// Same over only the data extents of a sparse f (io::scan_data), so holes are
+// never read. NUL bytes ending each piece are dropped: an extent ends on a block
+// boundary, zero-filled past the last record written, and valid JSON never
+// contains a raw NUL.
+template <typename F>
+result<size_t> stream_data_documents(
+  const io::file&  f,
+  document_stream& stream,
+  F&&              on_document,
+  size_t           window_size = io::mapped_reader::default_window_size) {
+    size_t         total = 0;
+    result<size_t> failed(size_t { 0 });
+    auto           scanned = io::scan_data(
+      f,
+      [&](uint64_t, std::span<const std::byte> bytes) {
+          if(!failed) return;
+          std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+          while(!text.empty() && text.back() == '\0') text.remove_suffix(1);
+          if(text.empty()) return;
+          auto parsed = stream.feed(text, on_document);
+          if(parsed) total += *parsed;
+          else failed = parsed;
+      },
+      window_size);
+    if(!scanned) return result<size_t>(unexpect, error::io_error);
+    if(!failed) return failed;
+    auto parsed = stream.finish(on_document);
+    if(!parsed) return parsed;
+    return result<size_t>(total + *parsed);
+}
+
+}  // namespace asyncle::format::json
+
+#endif  // ASYNCLE_FORMAT_JSON_FILE_HPP
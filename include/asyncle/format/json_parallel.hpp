@@ -0,0 +1,92 @@
+#ifndef ASYNCLE_FORMAT_JSON_PARALLEL_HPP
+#define ASYNCLE_FORMAT_JSON_PARALLEL_HPP
+
+// asyncle::format::json::parse_parallel - Multi-core NDJSON ingest
+//
+// A mapped file is cut into chunks of about chunk_size bytes, each extended to
+// the next newline. Every chunk becomes one pool task that leases a parser
+// and parses the chunk in place (the mapping's padding covers the last chunk;
+// the following bytes of the file cover the others). The task maps each
+// document to a value. Finished chunks come back through a bounded queue
+// (chunk_pipeline.hpp), and the calling thread hands each chunk's values to
+// the consumer, either in file order or as chunks complete.
+//
+// At most in_flight chunks are parsed ahead of the consumer, which bounds
+// memory. map runs concurrently on pool workers and must be thread-safe;
+// consume runs only on the calling thread, which must not itself be a pool worker.
+//
+// Usage:
+//   auto file = mapped_json::open("events.ndjson");
+//   work_stealing_pool pool;
+//   parser_pool        parsers;
+//   auto count = parse_parallel(*file, pool, parsers,
+//       [](auto& doc) { return doc["id"].get_int64().value(); },  // On workers
+//       [&](int64_t id) { ids.push_back(id); });                    // In order, on this thread
+
+#include "../concurrent/thread_pool.hpp"
+#include "chunk_pipeline.hpp"
+#include "json.hpp"
+#include "json_file.hpp"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace asyncle::format::json {
+
+// Upper bound on chunks parsed ahead of the consumer
+inline constexpr size_t max_in_flight = ::asyncle::format::detail::max_chunks_in_flight;
+
+struct parallel_options {
+    size_t chunk_size = size_t { 4 } << 20;  // Target bytes per task; extended to the next newline
+    size_t in_flight  = 0;                   // Chunks ahead of the consumer (0 = 4 per worker)
+    bool   ordered    = true;                // Deliver in file order rather than completion order
+    size_t batch_size = document_stream::default_batch_size;  // Largest single record
+};
+
+// Parse every record of file across pool; returns the number of records consumed
+template <typename Map, typename Consume>
+result<size_t> parse_parallel(
+  const mapped_json&              file,
+  concurrent::work_stealing_pool& pool,
+  parser_pool&                    parsers,
+  Map&&                           map,
+  Consume&&                       consume,
+  const parallel_options&         options = {}) {
+    using value_type = std::remove_cvref_t<std::invoke_result_t<Map&, parser_lease::document_type&>>;
+
+    const padded_input input = file.input();
+    if(!file.is_valid()) return result<size_t>(unexpect, error::io_error);
+
+    size_t window = options.in_flight ? options.in_flight : 4 * (pool.worker_count() ? pool.worker_count() : 1);
+    if(window > max_in_flight) window = max_in_flight;
+    size_t chunk_size = options.chunk_size ? options.chunk_size : 1;
+
+    auto outcome = ::asyncle::format::detail::run_chunks<value_type, error>(
+      pool,
+      0,
+      input.length,
+      window,
+      options.ordered,
+      [&](size_t offset) noexcept {
+          size_t end = offset + chunk_size < input.length ? offset + chunk_size : input.length;
+          if(end == input.length) return end;
+          const void* newline = std::memchr(input.data + end, '\n', input.length - end);
+          return newline ? static_cast<size_t>(static_cast<const char*>(newline) - input.data) + 1 : input.length;
+      },
+      [&](std::vector<value_type>& values, size_t begin, size_t end) {
+          auto         lease  = parsers.acquire();
+          padded_input part   = { input.data + begin, end - begin, input.capacity - begin };
+          auto         parsed = lease.for_each_document(
+            part, [&](parser_lease::document_type& doc) { values.push_back(map(doc)); }, options.batch_size);
+          return parsed ? error::none : parsed.error();
+      },
+      consume);
+
+    if(outcome.failure != error::none) return result<size_t>(unexpect, outcome.failure);
+    return result<size_t>(outcome.total);
+}
+
+}  // namespace asyncle::format::json
+
+#endif  // ASYNCLE_FORMAT_JSON_PARALLEL_HPP
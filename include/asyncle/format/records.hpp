@@ -0,0 +1,458 @@
+#ifndef ASYNCLE_FORMAT_RECORDS_HPP
+#define ASYNCLE_FORMAT_RECORDS_HPP
+
+// asyncle::format records - Flat binary record files read in place through mmap
+//
+// A record file holds fixed-width, trivially copyable records that are used
+// straight from the page cache without deserialization:
+//
+//   [record_header, padded to data_offset][records ...][block checksums]
+//
+// The header carries a magic, a version, the schema hash of the record type,
+// the record size and alignment, the record count, the offsets of the data and
+// of the checksum table, and its own checksum. Records are grouped into blocks
+// of block_records, each covered by one 64-bit XXH64 checksum.
+//
+// Opening a record_view maps the file and validates only the header, so it
+// costs the same for 40 records or 40M. verify() checks the block checksums
+// when the data itself must be trusted.
+//
+// The schema hash covers the record's size and alignment, the size and offset
+// of each member (aggregates of up to 16 members), an optional
+// `static constexpr std::string_view schema_name` and an optional
+// `static constexpr uint64_t schema_version`. None of it depends on the
+// compiler, so files move between builds. Name a record to keep it apart from
+// other types with the same layout; bump the version when the meaning of the
+// fields changes but the layout does not.
+//
+// Usage:
+//   asyncle::format::record_writer<Entry> out(file, expected_count);
+//   for(auto const& e : entries) out.append(e);
+//   out.finish();
+//
+//   auto view = asyncle::format::record_view<Entry>::open("entries.rec");
+//   if(view) { for(auto const& e : *view) use(e); }
+
+#include "../hardware/checksum.hpp"
+#include "../io/file.hpp"
+#include "../io/mmap.hpp"
+#include "../meta/dispatch.hpp"
+#include "serialize.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asyncle::format {
+
+// Records stored and read back as raw bytes
+template <typename T>
+concept flat_record = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && !std::is_empty_v<T>;
+
+namespace detail {
+
+// Block checksums for record files
+using hardware::xxh64;
+
+constexpr uint64_t fnv1a(std::string_view text, uint64_t h = 0xCBF29CE484222325ull) noexcept {
+    for(char c : text) { h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull; }
+    return h;
+}
+
+constexpr uint64_t fnv1a_word(uint64_t h, uint64_t word) noexcept { return (h ^ word) * 0x100000001B3ull; }
+
+// Converts to any member type, to probe aggregate initialization
+struct any_member {
+    template <typename U>
+    operator U() const;
+};
+
+// Each probe is braced, so an array member takes one probe instead of one per element
+template <typename T, size_t... I>
+constexpr bool initializable_with(std::index_sequence<I...>) {
+    return requires { T { { (static_cast<void>(I), any_member {}) }... }; };
+}
+
+template <typename T, size_t N = 0>
+constexpr size_t count_members() {
+    if constexpr(N > 16) {
+        return N;
+    } else if constexpr(initializable_with<T>(std::make_index_sequence<N + 1> {})) {
+        return count_members<T, N + 1>();
+    } else {
+        return N;
+    }
+}
+
+// Member references of row for N = count_members<T>(); only used unevaluated
+template <size_t N, typename T>
+auto tie_members(T& row) {
+    // clang-format off
+    if constexpr(N == 1) { auto& [a] = row; return std::tie(a); }
+    else if constexpr(N == 2) { auto& [a, b] = row; return std::tie(a, b); }
+    else if constexpr(N == 3) { auto& [a, b, c] = row; return std::tie(a, b, c); }
+    else if constexpr(N == 4) { auto& [a, b, c, d] = row; return std::tie(a, b, c, d); }
+    else if constexpr(N == 5) { auto& [a, b, c, d, e] = row; return std::tie(a, b, c, d, e); }
+    else if constexpr(N == 6) { auto& [a, b, c, d, e, f] = row; return std::tie(a, b, c, d, e, f); }
+    else if constexpr(N == 7) { auto& [a, b, c, d, e, f, g] = row; return std::tie(a, b, c, d, e, f, g); }
+    else if constexpr(N == 8) { auto& [a, b, c, d, e, f, g, h] = row; return std::tie(a, b, c, d, e, f, g, h); }
+    else if constexpr(N == 9) {
+        auto& [a, b, c, d, e, f, g, h, i] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i);
+    } else if constexpr(N == 10) {
+        auto& [a, b, c, d, e, f, g, h, i, j] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j);
+    } else if constexpr(N == 11) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k);
+    } else if constexpr(N == 12) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l);
+    } else if constexpr(N == 13) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m);
+    } else if constexpr(N == 14) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n);
+    } else if constexpr(N == 15) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o);
+    } else {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p);
+    }
+    // clang-format on
+}
+
+// Mix the size and offset of every member, laid out in declaration order
+template <typename... M>
+constexpr uint64_t member_layout_hash(uint64_t h, std::type_identity<std::tuple<M&...>>) noexcept {
+    uint64_t offset = 0;
+    ((offset = (offset + alignof(M) - 1) / alignof(M) * alignof(M),
+      h      = fnv1a_word(fnv1a_word(h, offset), sizeof(M)),
+      offset += sizeof(M)),
+     ...);
+    return h;
+}
+
+template <typename T>
+constexpr uint64_t layout_hash(uint64_t h) noexcept {
+    constexpr size_t members = std::is_aggregate_v<T> ? count_members<T>() : 0;
+    if constexpr(members == 0 || members > 16) {
+        return h;  // Size and alignment only
+    } else {
+        using tied = decltype(tie_members<members>(std::declval<T&>()));
+        return fnv1a_word(member_layout_hash(h, std::type_identity<tied> {}), members);
+    }
+}
+
+}  // namespace detail
+
+// Schema hash written to and checked against the file header
+template <flat_record T>
+constexpr uint64_t record_schema_hash() noexcept {
+    std::string_view name    = {};
+    uint64_t         version = 0;
+    if constexpr(requires { T::schema_name; }) name = std::string_view(T::schema_name);
+    if constexpr(requires { T::schema_version; }) version = static_cast<uint64_t>(T::schema_version);
+    uint64_t h = detail::fnv1a(name);
+    h          = detail::fnv1a_word(h, sizeof(T));
+    h          = detail::fnv1a_word(h, alignof(T));
+    h          = detail::layout_hash<T>(h);
+    return detail::fnv1a_word(h, version);
+}
+
+inline constexpr char     record_magic[8]       = { 'A', 'S', 'Y', 'R', 'E', 'C', '0', '1' };
+inline constexpr uint32_t record_format_version = 1;
+inline constexpr uint32_t default_block_records = 4096;
+inline constexpr uint64_t record_data_alignment = 4096;  // Records start at a page-aligned offset
+
+struct record_header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t header_bytes;     // sizeof(record_header)
+    uint64_t schema_hash;
+    uint32_t record_size;
+    uint32_t record_align;
+    uint32_t block_records;    // Records per checksummed block
+    uint32_t reserved;
+    uint64_t record_count;
+    uint64_t data_offset;      // First record
+    uint64_t checksum_offset;  // uint64_t per block
+    uint64_t block_count;
+    uint64_t header_checksum;  // XXH64 of every byte above
+
+    uint64_t compute_checksum() const noexcept { return detail::xxh64(this, offsetof(record_header, header_checksum)); }
+};
+
+static_assert(std::is_trivially_copyable_v<record_header> && std::is_standard_layout_v<record_header>);
+
+// Appends records in blocks with positioned writes; the header is written last by finish()
+template <flat_record T>
+class record_writer {
+    io::file*             f_;
+    std::vector<T>        block_;
+    std::vector<uint64_t> checksums_;
+    uint32_t              block_records_;
+    uint64_t              count_    = 0;
+    bool                  finished_ = false;
+    bool                  failed_   = false;
+
+    static constexpr uint64_t data_offset = record_data_alignment;
+
+    bool write_at(const void* data, size_t length, uint64_t offset) noexcept {
+        auto* p = static_cast<const char*>(data);
+        while(length > 0) {
+            auto done = f_->write(p, length, offset);
+            if(!done || *done == 0) return false;
+            p      += *done;
+            offset += *done;
+            length -= *done;
+        }
+        return true;
+    }
+
+    // Checksum and write count records that continue the data section
+    bool write_block(const T* records, size_t count) {
+        size_t bytes = count * sizeof(T);
+        checksums_.push_back(detail::xxh64(records, bytes));
+        if(!write_at(records, bytes, data_offset + count_ * sizeof(T))) return false;
+        count_ += count;
+        return true;
+    }
+
+    public:
+    // Writes from offset 0 of f (opened for writing); f must outlive the writer
+    // expected_records > 0 preallocates the data and checksum sections (best effort)
+    explicit record_writer(
+      io::file& f,
+      uint64_t  expected_records = 0,
+      uint32_t  block_records    = default_block_records):
+        f_(&f),
+        block_records_(block_records ? block_records : default_block_records) {
+        block_.reserve(block_records_);
+        if(expected_records > 0) {
+            uint64_t blocks = (expected_records + block_records_ - 1) / block_records_;
+            checksums_.reserve(blocks);
+            f.allocate(0, data_offset + expected_records * sizeof(T) + blocks * sizeof(uint64_t) + sizeof(uint64_t));
+        }
+    }
+
+    record_writer(const record_writer&)            = delete;
+    record_writer& operator=(const record_writer&) = delete;
+
+    // An unfinished file is completed; call finish() first to observe errors
+    ~record_writer() { finish(); }
+
+    result<uint64_t> append(T const& record) {
+        if(finished_ || failed_) return result<uint64_t>(unexpect, error::io_error);
+        block_.push_back(record);
+        if(block_.size() == block_records_) {
+            failed_ = !write_block(block_.data(), block_.size());
+            block_.clear();
+            if(failed_) return result<uint64_t>(unexpect, error::io_error);
+        }
+        return result<uint64_t>(count_ + block_.size());
+    }
+
+    // Whole blocks are written straight from records without staging
+    result<uint64_t> append(std::span<const T> records) {
+        if(finished_ || failed_) return result<uint64_t>(unexpect, error::io_error);
+        while(!records.empty()) {
+            if(block_.empty() && records.size() >= block_records_) {
+                if(!write_block(records.data(), block_records_)) {
+                    failed_ = true;
+                    return result<uint64_t>(unexpect, error::io_error);
+                }
+                records = records.subspan(block_records_);
+                continue;
+            }
+            size_t take = block_records_ - block_.size();
+            if(take > records.size()) take = records.size();
+            block_.insert(block_.end(), records.begin(), records.begin() + take);
+            records = records.subspan(take);
+            if(block_.size() == block_records_) {
+                failed_ = !write_block(block_.data(), block_.size());
+                block_.clear();
+                if(failed_) return result<uint64_t>(unexpect, error::io_error);
+            }
+        }
+        return result<uint64_t>(count_ + block_.size());
+    }
+
+    // Any other range of T: contiguous ones take the span path above, the rest
+    // are appended record by record
+    template <std::ranges::input_range R>
+    requires std::same_as<std::ranges::range_value_t<R>, T>
+    result<uint64_t> append(R&& records) {
+        if constexpr(dispatches_to<range_dispatch, R, contiguous_path>) {
+            return append(std::span<const T>(std::ranges::data(records), std::ranges::size(records)));
+        } else {
+            if(finished_ || failed_) return result<uint64_t>(unexpect, error::io_error);
+            for(auto&& record : records) {
+                if(auto added = append(static_cast<const T&>(record)); !added) return added;
+            }
+            return result<uint64_t>(count_ + block_.size());
+        }
+    }
+
+    // Write the last block, the checksum table and the header; trims preallocated space
+    result<uint64_t> finish() {
+        if(finished_) return failed_ ? result<uint64_t>(unexpect, error::io_error) : result<uint64_t>(count_);
+        finished_ = true;
+        if(!failed_ && !block_.empty()) failed_ = !write_block(block_.data(), block_.size());
+        block_.clear();
+        if(failed_) return result<uint64_t>(unexpect, error::io_error);
+
+        record_header header {};
+        std::memcpy(header.magic, record_magic, sizeof(record_magic));
+        header.version         = record_format_version;
+        header.header_bytes    = sizeof(record_header);
+        header.schema_hash     = record_schema_hash<T>();
+        header.record_size     = sizeof(T);
+        header.record_align    = alignof(T);
+        header.block_records   = block_records_;
+        header.record_count    = count_;
+        header.data_offset     = data_offset;
+        header.checksum_offset = (data_offset + count_ * sizeof(T) + 7) & ~uint64_t { 7 };
+        header.block_count     = checksums_.size();
+        header.header_checksum = header.compute_checksum();
+
+        uint64_t end = header.checksum_offset + checksums_.size() * sizeof(uint64_t);
+        failed_      = !write_at(checksums_.data(), checksums_.size() * sizeof(uint64_t), header.checksum_offset)
+                || !write_at(&header, sizeof(header), 0) || !f_->truncate(end);
+        if(failed_) return result<uint64_t>(unexpect, error::io_error);
+        return result<uint64_t>(count_);
+    }
+
+    uint64_t size() const noexcept { return count_ + block_.size(); }
+};
+
+// Read-only typed view of a record file; records point into the mapping
+template <flat_record T>
+class record_view {
+    io::mmap map_;
+    const T* records_ = nullptr;
+    uint64_t count_   = 0;
+
+    const char* base() const noexcept { return map_.as<char>(); }
+
+    public:
+    using value_type     = T;
+    using const_iterator = const T*;
+
+    record_view() noexcept = default;
+
+    record_view(record_view&& other) noexcept:
+        map_(std::move(other.map_)),
+        records_(std::exchange(other.records_, nullptr)),
+        count_(std::exchange(other.count_, 0)) {}
+
+    record_view& operator=(record_view&& other) noexcept {
+        if(this != &other) {
+            map_     = std::move(other.map_);
+            records_ = std::exchange(other.records_, nullptr);
+            count_   = std::exchange(other.count_, 0);
+        }
+        return *this;
+    }
+
+    record_view(const record_view&)            = delete;
+    record_view& operator=(const record_view&) = delete;
+
+    // Map f and validate its header: io_error when unreadable, invalid_syntax when malformed,
+    // type_mismatch when written for another record type
+    static result<record_view> open(const io::file& f) noexcept {
+        auto size = f.size();
+        if(!size) return result<record_view>(unexpect, error::io_error);
+        if(*size < sizeof(record_header)) return result<record_view>(unexpect, error::invalid_syntax);
+
+        record_view out;
+        out.map_ = io::mmap(f, static_cast<size_t>(*size));
+        if(!out.map_.is_mapped()) return result<record_view>(unexpect, error::io_error);
+
+        const record_header& h = *out.map_.as<record_header>();
+        if(std::memcmp(h.magic, record_magic, sizeof(record_magic)) != 0 || h.version != record_format_version
+           || h.header_bytes != sizeof(record_header) || h.header_checksum != h.compute_checksum()) {
+            return result<record_view>(unexpect, error::invalid_syntax);
+        }
+        if(h.schema_hash != record_schema_hash<T>() || h.record_size != sizeof(T) || h.record_align != alignof(T)) {
+            return result<record_view>(unexpect, error::type_mismatch);
+        }
+
+        // Every section must lie inside the file
+        uint64_t blocks = h.block_records ? (h.record_count + h.block_records - 1) / h.block_records : 0;
+        if(h.block_records == 0 || h.block_count != blocks || h.data_offset % alignof(T) != 0
+           || h.data_offset < sizeof(record_header) || h.data_offset > *size
+           || h.record_count > (*size - h.data_offset) / sizeof(T)
+           || h.checksum_offset < h.data_offset + h.record_count * sizeof(T) || h.checksum_offset > *size
+           || h.block_count > (*size - h.checksum_offset) / sizeof(uint64_t)) {
+            return result<record_view>(unexpect, error::invalid_syntax);
+        }
+
+        out.records_ = reinterpret_cast<const T*>(out.base() + h.data_offset);
+        out.count_   = h.record_count;
+        return result<record_view>(std::move(out));
+    }
+
+    static result<record_view> open(const char* path) noexcept {
+        io::file f;
+        if(!f.open(path)) return result<record_view>(unexpect, error::io_error);
+        return open(f);
+    }
+
+    // Check one block against its stored checksum
+    bool verify_block(uint64_t block) const noexcept {
+        const record_header& h = header();
+        if(block >= h.block_count) return false;
+        uint64_t first = block * h.block_records;
+        uint64_t count = count_ - first < h.block_records ? count_ - first : h.block_records;
+        uint64_t stored;
+        std::memcpy(&stored, base() + h.checksum_offset + block * sizeof(uint64_t), sizeof(stored));
+        return detail::xxh64(records_ + first, count * sizeof(T)) == stored;
+    }
+
+    // Check every block; returns the number of records covered
+    result<uint64_t> verify() const noexcept {
+        if(!is_valid()) return result<uint64_t>(unexpect, error::uninitialized);
+        for(uint64_t block = 0; block < header().block_count; ++block) {
+            if(!verify_block(block)) return result<uint64_t>(unexpect, error::invalid_syntax);
+        }
+        return result<uint64_t>(count_);
+    }
+
+    // Element access
+    const T& operator[](size_t index) const noexcept { return records_[index]; }
+
+    // Bounds-checked; nullptr past the end
+    const T* at(size_t index) const noexcept { return index < count_ ? records_ + index : nullptr; }
+
+    std::span<const T> records() const noexcept { return std::span<const T>(records_, count_); }
+
+    const_iterator begin() const noexcept { return records_; }
+
+    const_iterator end() const noexcept { return records_ + count_; }
+
+    // Accessors
+    const record_header& header() const noexcept { return *map_.as<record_header>(); }
+
+    size_t size() const noexcept { return count_; }
+
+    bool empty() const noexcept { return count_ == 0; }
+
+    const io::mmap& mapping() const noexcept { return map_; }
+
+    bool is_valid() const noexcept { return map_.is_mapped(); }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+}  // namespace asyncle::format
+
+#endif  // ASYNCLE_FORMAT_RECORDS_HPP
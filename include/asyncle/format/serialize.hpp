@@ -25,6 +25,9 @@
 
 #include "../base/cpo.hpp"
 #include "../concepts/operation_concepts.hpp"
+#include "../instrument.hpp"
+#include <concepts>
+#include <cstddef>
 #include <format/serialize.hpp>
 #include <span>
 #include <string>
@@ -36,6 +39,7 @@ namespace asyncle::format {
 // Re-export foundation layer types and tags
 using ::format::serialize::error;
 using ::format::serialize::serializer_caps;
+using ::format::serialize::write_mode;
 
 // Format tags (defined by format layer, not asyncle)
 using ::format::serialize::beve_tag;
@@ -50,10 +54,47 @@ using result = ::format::serialize::result<T>;
 // Convenience functions - forward to format::serialize CPOs
 // No knowledge of implementation, just forwards to foundation layer
 
+namespace detail {
+
+// Run call() under an instrument::scope when Tag is JSON; bytes(value) is what
+// the call moved. Other formats are not instrumented.
+template <typename Tag, typename Call, typename Bytes>
+inline auto timed_json(instrument::op kind, Call&& call, Bytes&& bytes) {
+    if constexpr(std::same_as<Tag, json_tag>) {
+        instrument::scope timed(kind);
+        auto              out = call();
+        timed.done(out.has_value(), out ? static_cast<uint64_t>(bytes(*out)) : 0);
+        return out;
+    } else {
+        return call();
+    }
+}
+
+}  // namespace detail
+
 // Save with explicit format tag
 template <typename T, typename Tag>
 inline auto save(T const& obj, Tag tag) noexcept {
-    return ::format::serialize::save(obj, tag);
+    return detail::timed_json<Tag>(
+      instrument::op::json_serialize, [&] { return ::format::serialize::save(obj, tag); },
+      [](const auto& saved) { return saved.size(); });
+}
+
+// Save into a caller-owned buffer, keeping its capacity; returns bytes written
+template <typename T, typename Buffer, typename Tag>
+requires std::invocable<decltype(::format::serialize::save_into) const&, T const&, Buffer&, Tag, write_mode>
+inline auto save_into(T const& obj, Buffer& out, Tag tag, write_mode mode = write_mode::overwrite) {
+    return detail::timed_json<Tag>(
+      instrument::op::json_serialize, [&] { return ::format::serialize::save_into(obj, out, tag, mode); },
+      [](size_t written) { return written; });
+}
+
+// Save into a fixed span; error::capacity_exceeded when it does not fit
+template <typename T, typename Tag>
+inline auto save_into(T const& obj, std::span<std::byte> out, Tag tag) {
+    return detail::timed_json<Tag>(
+      instrument::op::json_serialize, [&] { return ::format::serialize::save_into(obj, out, tag); },
+      [](size_t written) { return written; });
 }
 
 // Load with explicit format tag
@@ -61,7 +102,9 @@ template <typename T, typename Tag>
 inline auto load(std::string_view data, Tag tag) noexcept
 requires ::format::serialize::text_format<Tag>
 {
-    return ::format::serialize::load<T>(data, tag);
+    return detail::timed_json<Tag>(
+      instrument::op::json_parse, [&] { return ::format::serialize::load<T>(data, tag); },
+      [&](const auto&) { return data.size(); });
 }
 
 template <typename T, typename Tag>
@@ -77,6 +120,11 @@ inline auto to_json(T const& obj) noexcept {
     return save(obj, json_tag {});
 }
 
+template <typename T>
+inline auto to_json_into(T const& obj, std::string& out, write_mode mode = write_mode::overwrite) {
+    return save_into(obj, out, json_tag {}, mode);
+}
+
 template <typename T>
 inline auto from_json(std::string_view json) noexcept {
     return load<T>(json, json_tag {});
@@ -100,12 +148,10 @@ class serializer_operation {
     serializer_operation() = default;
 
     // Save to JSON
-    result<std::string> to_json(T const& obj) const noexcept { return ::format::serialize::save(obj, json_tag {}); }
+    result<std::string> to_json(T const& obj) const noexcept { return format::save(obj, json_tag {}); }
 
     // Load from JSON
-    result<T> from_json(std::string_view data) const noexcept {
-        return ::format::serialize::load<T>(data, json_tag {});
-    }
+    result<T> from_json(std::string_view data) const noexcept { return format::load<T>(data, json_tag {}); }
 
     // Save to binary
     result<std::vector<std::byte>> to_binary(T const& obj) const noexcept {
@@ -120,7 +166,7 @@ class serializer_operation {
     // Generic save with format selection
     template <typename Tag>
     auto save(T const& obj, Tag tag) const noexcept {
-        return ::format::serialize::save(obj, tag);
+        return format::save(obj, tag);
     }
 
     // Generic load with format selection
@@ -128,7 +174,7 @@ class serializer_operation {
     auto load(std::string_view data, Tag tag) const noexcept
     requires ::format::serialize::text_format<Tag>
     {
-        return ::format::serialize::load<T>(data, tag);
+        return format::load<T>(data, tag);
     }
 
     template <typename Tag>
@@ -0,0 +1,220 @@
+#ifndef ASYNCLE_FORMAT_SINK_HPP
+#define ASYNCLE_FORMAT_SINK_HPP
+
+// asyncle::format sinks - Serialize record streams straight to storage
+//
+// A snapshot written as a sequence of records never exists as one in-memory
+// byte vector:
+// - file_sink<Tag> appends records into a few reusable segment buffers and
+//   writes them to an io::file with one writev() per flush. Memory stays at
+//   about segment_bytes * segments however large the output grows.
+// - mapped_sink<Tag> serializes each record directly into a shared file
+//   mapping, which doubles (ftruncate + remap) when a record does not fit.
+//   finish() trims the file to the bytes written.
+//
+// Both go through format::serialize::save_into, so any format with a save_into
+// customization (Glaze JSON/BEVE) or a plain save_impl works.
+//
+// Usage:
+//   asyncle::io::file out("snapshot.beve", mode);
+//   asyncle::format::file_sink<asyncle::format::beve_tag> sink(out);
+//   for(auto const& entry : state) { if(!sink.write(entry)) break; }
+//   sink.flush();
+
+#include "../io/file.hpp"
+#include "../io/mmap.hpp"
+#include "serialize.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace asyncle::format {
+
+// Staging buffer used for a format: text formats write strings, binary formats bytes
+template <typename Tag>
+using sink_buffer_t =
+  std::conditional_t<::format::serialize::text_format<Tag>, std::string, std::vector<std::byte>>;
+
+template <typename Tag>
+class file_sink {
+    public:
+    using buffer_type = sink_buffer_t<Tag>;
+
+    static constexpr size_t default_segment_bytes = 256 * 1024;
+    static constexpr size_t default_segments      = 4;
+    static constexpr size_t max_segments          = 64;  // Segments gathered by one writev()
+
+    private:
+    io::file*                f_;
+    std::vector<buffer_type> segments_;
+    size_t                   segment_bytes_;
+    size_t                   current_ = 0;  // Segment receiving records
+    uint64_t                 written_ = 0;  // Bytes handed to the file so far
+
+    public:
+    // Writes at f's current position; f must outlive the sink
+    explicit file_sink(
+      io::file& f,
+      size_t    segment_bytes = default_segment_bytes,
+      size_t    segments      = default_segments):
+        f_(&f),
+        segments_(segments == 0 ? 1 : segments > max_segments ? max_segments : segments),
+        segment_bytes_(segment_bytes) {
+        for(auto& segment : segments_) { segment.reserve(segment_bytes_); }
+    }
+
+    file_sink(const file_sink&)            = delete;
+    file_sink& operator=(const file_sink&) = delete;
+
+    // Pending records are flushed; call flush() first to observe write errors
+    ~file_sink() { flush(); }
+
+    // Serialize one record; returns its size in bytes
+    template <typename T>
+    result<size_t> write(T const& obj) {
+        auto written = ::format::serialize::save_into(obj, segments_[current_], Tag {}, write_mode::append);
+        if(!written) return written;
+        if(segments_[current_].size() >= segment_bytes_ && ++current_ == segments_.size()) {
+            auto flushed = flush();
+            if(!flushed) return result<size_t>(unexpect, flushed.error());
+        }
+        return written;
+    }
+
+    // Raw bytes between records (framing, separators)
+    result<size_t> write_bytes(std::span<const std::byte> bytes) {
+        auto& segment = segments_[current_];
+        auto* data    = reinterpret_cast<const typename buffer_type::value_type*>(bytes.data());
+        segment.insert(segment.end(), data, data + bytes.size());
+        if(segment.size() >= segment_bytes_ && ++current_ == segments_.size()) {
+            auto flushed = flush();
+            if(!flushed) return result<size_t>(unexpect, flushed.error());
+        }
+        return result<size_t>(bytes.size());
+    }
+
+    // Write every pending segment with one vectored call (repeated on short writes)
+    result<size_t> flush() {
+        io::io_request requests[max_segments];
+        size_t         count = 0;
+        size_t         total = 0;
+        for(auto& segment : segments_) {
+            if(segment.empty()) continue;
+            requests[count].buffer = segment.data();
+            requests[count].length = segment.size();
+            total                 += segment.size();
+            ++count;
+        }
+
+        size_t first = 0;
+        while(first < count) {
+            auto done = f_->writev(requests + first, count - first);
+            if(!done || done->bytes_transferred == 0) return result<size_t>(unexpect, error::io_error);
+
+            // Skip fully written segments and trim a partially written one
+            size_t bytes  = done->bytes_transferred;
+            written_     += bytes;
+            while(first < count && bytes >= requests[first].length) { bytes -= requests[first++].length; }
+            if(first < count) {
+                requests[first].buffer  = static_cast<char*>(requests[first].buffer) + bytes;
+                requests[first].length -= bytes;
+            }
+        }
+
+        for(auto& segment : segments_) { segment.clear(); }  // Capacity is kept
+        current_ = 0;
+        return result<size_t>(total);
+    }
+
+    // Bytes serialized but not yet written
+    size_t pending() const noexcept {
+        size_t bytes = 0;
+        for(auto const& segment : segments_) { bytes += segment.size(); }
+        return bytes;
+    }
+
+    uint64_t bytes_written() const noexcept { return written_; }
+};
+
+template <typename Tag>
+class mapped_sink {
+    public:
+    static constexpr size_t default_initial_size = size_t { 64 } << 20;
+
+    private:
+    io::file* f_;
+    io::mmap  map_;
+    uint64_t  size_     = 0;  // Bytes written from the start of the file
+    bool      finished_ = false;
+
+    // Resize the file to fit at least `extra` more bytes (at least doubling) and remap it
+    bool grow(size_t extra) noexcept {
+        size_t capacity = map_.size() * 2 > size_ + extra ? map_.size() * 2 : size_ + extra;
+        capacity        = io::mmap::align_to_page(capacity);
+        map_.unmap();
+        if(!f_->truncate(capacity)) return false;
+        map_ = io::mmap(*f_, capacity, 0, io::mmap_access::access_mode::read_write);
+        return map_.is_mapped();
+    }
+
+    public:
+    // Writes from offset 0 of f (opened read-write); f must outlive the sink
+    explicit mapped_sink(io::file& f, size_t initial_size = default_initial_size): f_(&f) {
+        grow(initial_size ? initial_size : io::mmap::page_size());
+    }
+
+    mapped_sink(const mapped_sink&)            = delete;
+    mapped_sink& operator=(const mapped_sink&) = delete;
+
+    ~mapped_sink() { finish(); }
+
+    // Serialize one record into the mapping, growing it when the record does not fit
+    template <typename T>
+    result<size_t> write(T const& obj) {
+        if(finished_ || !map_.is_mapped()) return result<size_t>(unexpect, error::io_error);
+        for(;;) {
+            auto free    = std::span<std::byte>(static_cast<std::byte*>(map_.data()) + size_, map_.size() - size_);
+            auto written = ::format::serialize::save_into(obj, free, Tag {});
+            if(written) {
+                size_ += *written;
+                return written;
+            }
+            // The record size is unknown until it fits: keep doubling
+            if(written.error() != error::capacity_exceeded) return written;
+            if(!grow(free.size() + 1)) return result<size_t>(unexpect, error::io_error);
+        }
+    }
+
+    // Raw bytes between records (framing, separators)
+    result<size_t> write_bytes(std::span<const std::byte> bytes) {
+        if(finished_ || !map_.is_mapped()) return result<size_t>(unexpect, error::io_error);
+        if(bytes.size() > map_.size() - size_ && !grow(bytes.size())) {
+            return result<size_t>(unexpect, error::io_error);
+        }
+        if(!bytes.empty()) std::memcpy(static_cast<std::byte*>(map_.data()) + size_, bytes.data(), bytes.size());
+        size_ += bytes.size();
+        return result<size_t>(bytes.size());
+    }
+
+    // Unmap and trim the file to the bytes written; later writes fail
+    result<uint64_t> finish() {
+        if(finished_) return result<uint64_t>(size_);
+        finished_ = true;
+        map_.unmap();
+        if(!f_->truncate(size_)) return result<uint64_t>(unexpect, error::io_error);
+        return result<uint64_t>(size_);
+    }
+
+    uint64_t bytes_written() const noexcept { return size_; }
+
+    // Current mapping length (file size until finish())
+    size_t capacity() const noexcept { return map_.size(); }
+};
+
+}  // namespace asyncle::format
+
+#endif  // ASYNCLE_FORMAT_SINK_HPP
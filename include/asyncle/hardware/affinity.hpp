@@ -0,0 +1,134 @@
+#ifndef ASYNCLE_HARDWARE_AFFINITY_HPP
+#define ASYNCLE_HARDWARE_AFFINITY_HPP
+
+#include "../../platform/hardware.hpp"
+#include "topology.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) && __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define ASYNCLE_HAS_RSEQ_AREA 1
+#endif
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Thread Placement and Scheduling (Platform-specific)
+// ============================================================================
+
+// Import thread placement from platform layer
+using platform::hardware::cpu_position;
+using platform::hardware::current_thread_handle;
+using platform::hardware::get_thread_affinity;
+using platform::hardware::get_thread_scheduling;
+using platform::hardware::sched_class;
+using platform::hardware::set_thread_affinity;
+using platform::hardware::set_thread_scheduling;
+using platform::hardware::thread_handle;
+using platform::hardware::thread_scheduling;
+
+// Restrict the calling thread, or a running std::thread, to a CPU set
+//
+//   std::thread rx(network_loop);
+//   pin_to(rx, topology.smt_siblings(3));   // Core 3, both hyperthreads
+//   set_scheduling(rx, sched_class::fifo, 50);
+inline bool pin_to(std::span<const uint32_t> cpus) noexcept {
+    return set_thread_affinity(current_thread_handle(), cpus.data(), cpus.size());
+}
+
+inline bool pin_to(std::thread& thread, std::span<const uint32_t> cpus) noexcept {
+    return set_thread_affinity(thread.native_handle(), cpus.data(), cpus.size());
+}
+
+// Pin to the allowed CPUs of one NUMA node; false if the node has none
+inline bool pin_to_node(uint32_t node, const cpu_topology& topology = cpu_topology::current()) {
+    return pin_to(topology.cpus_on_node(node));
+}
+
+inline bool pin_to_node(std::thread& thread, uint32_t node, const cpu_topology& topology = cpu_topology::current()) {
+    return pin_to(thread, topology.cpus_on_node(node));
+}
+
+// CPUs the thread may run on, ascending
+inline std::vector<uint32_t> affinity_of(thread_handle thread) {
+    std::vector<uint32_t> cpus(get_thread_affinity(thread, nullptr, 0));
+    cpus.resize(std::min(cpus.size(), get_thread_affinity(thread, cpus.data(), cpus.size())));
+    return cpus;
+}
+
+inline std::vector<uint32_t> affinity() { return affinity_of(current_thread_handle()); }
+
+inline std::vector<uint32_t> affinity(std::thread& thread) { return affinity_of(thread.native_handle()); }
+
+// Calling thread's CPU and node; the node comes from the topology where the
+// platform does not report it. Without a CPU query (macOS) returns { 0, 0 }.
+inline cpu_position where_am_i(const cpu_topology& topology = cpu_topology::current()) noexcept {
+    cpu_position position { 0, 0 };
+    if(platform::hardware::current_cpu(position) && position.node == 0) position.node = topology.node_of(position.cpu);
+    return position;
+}
+
+// CPU number for sharding hot-path data. Reads the cpu_id the kernel keeps
+// in glibc's registered rseq area (a thread-local load, glibc 2.35+), else
+// falls back to current_cpu(). UINT32_MAX when the platform cannot say.
+// Like where_am_i() the answer is stale once the thread migrates, so shards
+// indexed by it still need atomic updates.
+inline uint32_t fast_cpu_id() noexcept {
+#if defined(ASYNCLE_HAS_RSEQ_AREA)
+    if(__rseq_size > 0) {
+        const auto* area = reinterpret_cast<const volatile struct rseq*>(
+          static_cast<const char*>(__builtin_thread_pointer()) + __rseq_offset);
+        auto cpu = static_cast<int32_t>(area->cpu_id);
+        if(cpu >= 0) return static_cast<uint32_t>(cpu);  // Negative: registration failed
+    }
+#endif
+    cpu_position position { 0, 0 };
+    return platform::hardware::current_cpu(position) ? position.cpu : UINT32_MAX;
+}
+
+// Scheduling class and priority (see platform::hardware::set_thread_scheduling)
+inline bool set_scheduling(sched_class cls, int priority = 0) noexcept {
+    return set_thread_scheduling(current_thread_handle(), cls, priority);
+}
+
+inline bool set_scheduling(std::thread& thread, sched_class cls, int priority = 0) noexcept {
+    return set_thread_scheduling(thread.native_handle(), cls, priority);
+}
+
+inline thread_scheduling scheduling() noexcept {
+    thread_scheduling out { sched_class::normal, 0 };
+    get_thread_scheduling(current_thread_handle(), out);
+    return out;
+}
+
+// Restores the calling thread's affinity on scope exit
+//
+//   {
+//       scoped_affinity pinned(topology.cpus_on_node(1));
+//       build_node_local_index();
+//   }
+class scoped_affinity {
+    std::vector<uint32_t> saved_;
+    bool                  pinned_ = false;
+
+    public:
+    explicit scoped_affinity(std::span<const uint32_t> cpus): saved_(affinity()) { pinned_ = pin_to(cpus); }
+
+    ~scoped_affinity() {
+        if(pinned_ && !saved_.empty()) pin_to(saved_);
+    }
+
+    scoped_affinity(const scoped_affinity&)            = delete;
+    scoped_affinity& operator=(const scoped_affinity&) = delete;
+
+    // Whether the new mask was applied
+    bool pinned() const noexcept { return pinned_; }
+};
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_AFFINITY_HPP
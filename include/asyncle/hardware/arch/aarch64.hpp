@@ -43,7 +43,8 @@ struct aarch64_info {
     static constexpr size_t large_page_size = 2097152;     // 2 MB huge page
     static constexpr size_t huge_page_size  = 1073741824;  // 1 GB huge page (if supported)
 
-    // Architecture features
+    // Architecture features guaranteed at compile time by the baseline ABI;
+    // hardware::cpu_features() (capabilities.hpp) reports the running CPU
     static constexpr bool has_neon    = true;  // NEON SIMD
     static constexpr bool has_dc_cvac = true;  // Data cache clean (flush)
     static constexpr bool has_prfm    = true;  // Prefetch instructions
@@ -25,7 +25,8 @@ struct x86_64_info {
     static constexpr size_t large_page_size = 2097152;     // 2 MB huge page
     static constexpr size_t huge_page_size  = 1073741824;  // 1 GB huge page
 
-    // Architecture features
+    // Architecture features guaranteed at compile time by the baseline ABI;
+    // hardware::cpu_features() (capabilities.hpp) reports the running CPU
     static constexpr bool has_sse      = true;
     static constexpr bool has_sse2     = true;
     static constexpr bool has_clflush  = true;  // Cache line flush instruction
@@ -0,0 +1,464 @@
+#ifndef ASYNCLE_HARDWARE_BULK_HPP
+#define ASYNCLE_HARDWARE_BULK_HPP
+
+#include "arch/current.hpp"
+#include "capabilities.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ASYNCLE_BULK_X86 1
+#include <immintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__GNUC__) || defined(__clang__))
+#define ASYNCLE_BULK_AARCH64 1
+#endif
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Non-Temporal Copy and Fill
+// ============================================================================
+
+// Below this size streaming stores cost more than the cache pollution they avoid
+inline constexpr size_t stream_min_size = 4096;
+
+// Set of bytes to search for with find_byte_any()
+//
+//   static constexpr byte_set delimiters(",\n\"");
+//   const char* hit = static_cast<const char*>(find_byte_any(line, length, delimiters));
+//
+// Holds a 256-bit membership bitmap for the scalar path and nibble lookup
+// tables for the SIMD paths (a byte is a member when lo[b & 15] & hi[b >> 4]
+// is nonzero; pass 0 covers bytes 0x00-0x7f, pass 1 bytes 0x80-0xff).
+struct byte_set {
+    uint64_t bits[4]   = {};
+    uint8_t  lo[2][16] = {};
+    uint8_t  hi[2][16] = {};
+    bool     has_high  = false;  // Any member >= 0x80 (pass 1 needed)
+    size_t   count     = 0;
+    uint8_t  first     = 0;  // Lowest member, for single-byte sets
+
+    constexpr byte_set() noexcept {
+        for(int pass = 0; pass < 2; ++pass) {
+            for(int h = 0; h < 16; ++h) hi[pass][h] = (h >> 3) == pass ? static_cast<uint8_t>(1u << (h & 7)) : 0;
+        }
+    }
+
+    constexpr explicit byte_set(std::string_view members) noexcept: byte_set() {
+        for(char c : members) add(static_cast<uint8_t>(c));
+    }
+
+    constexpr byte_set(std::initializer_list<uint8_t> members) noexcept: byte_set() {
+        for(uint8_t b : members) add(b);
+    }
+
+    constexpr void add(uint8_t b) noexcept {
+        if(contains(b)) return;
+        bits[b >> 6] |= uint64_t(1) << (b & 63);
+        lo[b >> 7][b & 15] |= static_cast<uint8_t>(1u << ((b >> 4) & 7));
+        has_high = has_high || b >= 0x80;
+        first    = count == 0 || b < first ? b : first;
+        ++count;
+    }
+
+    constexpr bool contains(uint8_t b) const noexcept { return (bits[b >> 6] >> (b & 63)) & 1; }
+};
+
+namespace detail {
+
+using stream_copy_fn   = void(void*, const void*, size_t) noexcept;
+using stream_fill_fn   = void(void*, uint8_t, size_t) noexcept;
+using find_byte_fn     = const void*(const void*, size_t, uint8_t) noexcept;
+using find_byte_any_fn = const void*(const void*, size_t, const byte_set&) noexcept;
+
+inline void stream_copy_scalar(void* dst, const void* src, size_t n) noexcept { std::memcpy(dst, src, n); }
+
+inline void stream_fill_scalar(void* dst, uint8_t value, size_t n) noexcept { std::memset(dst, value, n); }
+
+inline const void* find_byte_scalar(const void* data, size_t n, uint8_t value) noexcept {
+    return n ? std::memchr(data, value, n) : nullptr;
+}
+
+inline const void* find_byte_any_scalar(const void* data, size_t n, const byte_set& set) noexcept {
+    const auto* p = static_cast<const uint8_t*>(data);
+    for(size_t i = 0; i < n; ++i) {
+        if(set.contains(p[i])) return p + i;
+    }
+    return nullptr;
+}
+
+// Bytes to copy with plain stores so vector stores to dst are Align-aligned
+template <size_t Align>
+inline size_t head_bytes(const void* dst, size_t n) noexcept {
+    size_t misalign = (Align - (reinterpret_cast<uintptr_t>(dst) & (Align - 1))) & (Align - 1);
+    return misalign < n ? misalign : n;
+}
+
+#if defined(ASYNCLE_BULK_X86)
+
+// Streaming stores bypass the cache and are weakly ordered; every variant ends
+// with SFENCE so the data is visible before a later release store publishes it
+
+inline void stream_copy_sse2(void* dst, const void* src, size_t n) noexcept {
+    auto*       d    = static_cast<char*>(dst);
+    const auto* s    = static_cast<const char*>(src);
+    size_t      head = head_bytes<16>(d, n);
+    std::memcpy(d, s, head);
+    d += head, s += head, n -= head;
+    for(; n >= 64; d += 64, s += 64, n -= 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+    }
+    _mm_sfence();
+    std::memcpy(d, s, n);
+}
+
+ASYNCLE_TARGET("avx2") inline void stream_copy_avx2(void* dst, const void* src, size_t n) noexcept {
+    auto*       d    = static_cast<char*>(dst);
+    const auto* s    = static_cast<const char*>(src);
+    size_t      head = head_bytes<32>(d, n);
+    std::memcpy(d, s, head);
+    d += head, s += head, n -= head;
+    for(; n >= 128; d += 128, s += 128, n -= 128) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), e);
+    }
+    _mm_sfence();
+    std::memcpy(d, s, n);
+}
+
+ASYNCLE_TARGET("avx512f") inline void stream_copy_avx512(void* dst, const void* src, size_t n) noexcept {
+    auto*       d    = static_cast<char*>(dst);
+    const auto* s    = static_cast<const char*>(src);
+    size_t      head = head_bytes<64>(d, n);
+    std::memcpy(d, s, head);
+    d += head, s += head, n -= head;
+    for(; n >= 256; d += 256, s += 256, n -= 256) {
+        __m512i a = _mm512_loadu_si512(s);
+        __m512i b = _mm512_loadu_si512(s + 64);
+        __m512i c = _mm512_loadu_si512(s + 128);
+        __m512i e = _mm512_loadu_si512(s + 192);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d), a);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), b);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), c);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), e);
+    }
+    _mm_sfence();
+    std::memcpy(d, s, n);
+}
+
+inline void stream_fill_sse2(void* dst, uint8_t value, size_t n) noexcept {
+    auto*   d    = static_cast<char*>(dst);
+    size_t  head = head_bytes<16>(d, n);
+    __m128i v    = _mm_set1_epi8(static_cast<char>(value));
+    std::memset(d, value, head);
+    d += head, n -= head;
+    for(; n >= 64; d += 64, n -= 64) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), v);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v);
+    }
+    _mm_sfence();
+    std::memset(d, value, n);
+}
+
+ASYNCLE_TARGET("avx2") inline void stream_fill_avx2(void* dst, uint8_t value, size_t n) noexcept {
+    auto*   d    = static_cast<char*>(dst);
+    size_t  head = head_bytes<32>(d, n);
+    __m256i v    = _mm256_set1_epi8(static_cast<char>(value));
+    std::memset(d, value, head);
+    d += head, n -= head;
+    for(; n >= 128; d += 128, n -= 128) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), v);
+    }
+    _mm_sfence();
+    std::memset(d, value, n);
+}
+
+ASYNCLE_TARGET("avx512f") inline void stream_fill_avx512(void* dst, uint8_t value, size_t n) noexcept {
+    auto*   d    = static_cast<char*>(dst);
+    size_t  head = head_bytes<64>(d, n);
+    __m512i v    = _mm512_set1_epi8(static_cast<char>(value));
+    std::memset(d, value, head);
+    d += head, n -= head;
+    for(; n >= 256; d += 256, n -= 256) {
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d), v);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), v);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), v);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), v);
+    }
+    _mm_sfence();
+    std::memset(d, value, n);
+}
+
+// Search kernels: full unaligned vectors, then a scalar tail (never reads past data + n)
+
+inline const void* find_byte_sse2(const void* data, size_t n, uint8_t value) noexcept {
+    const auto* p      = static_cast<const uint8_t*>(data);
+    __m128i     needle = _mm_set1_epi8(static_cast<char>(value));
+    size_t      i      = 0;
+    for(; i + 16 <= n; i += 16) {
+        __m128i  v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    return find_byte_scalar(p + i, n - i, value);
+}
+
+ASYNCLE_TARGET("avx2") inline const void* find_byte_avx2(const void* data, size_t n, uint8_t value) noexcept {
+    const auto* p      = static_cast<const uint8_t*>(data);
+    __m256i     needle = _mm256_set1_epi8(static_cast<char>(value));
+    size_t      i      = 0;
+    for(; i + 32 <= n; i += 32) {
+        __m256i  v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    return find_byte_sse2(p + i, n - i, value);
+}
+
+ASYNCLE_TARGET("avx512f,avx512bw,bmi2")
+inline const void* find_byte_avx512(const void* data, size_t n, uint8_t value) noexcept {
+    const auto* p      = static_cast<const uint8_t*>(data);
+    __m512i     needle = _mm512_set1_epi8(static_cast<char>(value));
+    size_t      i      = 0;
+    for(; i + 64 <= n; i += 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + i), needle);
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    // Masked load for the tail: lanes past n are not accessed
+    if(i < n) {
+        __mmask64 lanes = _bzhi_u64(~uint64_t(0), static_cast<unsigned>(n - i));
+        uint64_t  mask  = _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, p + i), needle);
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    return nullptr;
+}
+
+// Nibble lookup ("shufti"): PSHUFB maps each low and high nibble through the
+// set's tables; a nonzero AND marks a member
+ASYNCLE_TARGET("ssse3")
+inline const void* find_byte_any_ssse3(const void* data, size_t n, const byte_set& set) noexcept {
+    const auto* p      = static_cast<const uint8_t*>(data);
+    __m128i     nibble = _mm_set1_epi8(0x0f);
+    __m128i     zero   = _mm_setzero_si128();
+    __m128i     lo0    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.lo[0]));
+    __m128i     hi0    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.hi[0]));
+    __m128i     lo1    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.lo[1]));
+    __m128i     hi1    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.hi[1]));
+    size_t      i      = 0;
+    for(; i + 16 <= n; i += 16) {
+        __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i low   = _mm_and_si128(v, nibble);
+        __m128i high  = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+        __m128i match = _mm_and_si128(_mm_shuffle_epi8(lo0, low), _mm_shuffle_epi8(hi0, high));
+        if(set.has_high) {
+            match = _mm_or_si128(match, _mm_and_si128(_mm_shuffle_epi8(lo1, low), _mm_shuffle_epi8(hi1, high)));
+        }
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(match, zero))) & 0xffff;
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    return find_byte_any_scalar(p + i, n - i, set);
+}
+
+ASYNCLE_TARGET("avx2")
+inline const void* find_byte_any_avx2(const void* data, size_t n, const byte_set& set) noexcept {
+    const auto* p      = static_cast<const uint8_t*>(data);
+    __m256i     nibble = _mm256_set1_epi8(0x0f);
+    __m256i     zero   = _mm256_setzero_si256();
+    // VPSHUFB shuffles within each 128-bit lane, so the tables are repeated per lane
+    __m256i lo0 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.lo[0])));
+    __m256i hi0 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.hi[0])));
+    __m256i lo1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.lo[1])));
+    __m256i hi1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.hi[1])));
+    size_t  i   = 0;
+    for(; i + 32 <= n; i += 32) {
+        __m256i v     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i low   = _mm256_and_si256(v, nibble);
+        __m256i high  = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+        __m256i match = _mm256_and_si256(_mm256_shuffle_epi8(lo0, low), _mm256_shuffle_epi8(hi0, high));
+        if(set.has_high) {
+            match =
+              _mm256_or_si256(match, _mm256_and_si256(_mm256_shuffle_epi8(lo1, low), _mm256_shuffle_epi8(hi1, high)));
+        }
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(match, zero)));
+        if(mask) return p + i + std::countr_zero(mask);
+    }
+    return find_byte_any_ssse3(p + i, n - i, set);
+}
+
+inline constexpr cpu_feature_set avx512bw_bmi2 { cpu_feature::avx512f, cpu_feature::avx512bw, cpu_feature::bmi2 };
+
+inline stream_copy_fn* select_stream_copy() noexcept {
+    return select_variant<stream_copy_fn>({ { { cpu_feature::avx512f }, stream_copy_avx512 },
+                                            { { cpu_feature::avx2 }, stream_copy_avx2 } },
+                                          stream_copy_sse2);
+}
+
+inline stream_fill_fn* select_stream_fill() noexcept {
+    return select_variant<stream_fill_fn>({ { { cpu_feature::avx512f }, stream_fill_avx512 },
+                                            { { cpu_feature::avx2 }, stream_fill_avx2 } },
+                                          stream_fill_sse2);
+}
+
+inline find_byte_fn* select_find_byte() noexcept {
+    return select_variant<find_byte_fn>(
+      { { avx512bw_bmi2, find_byte_avx512 }, { { cpu_feature::avx2 }, find_byte_avx2 } }, find_byte_sse2);
+}
+
+inline find_byte_any_fn* select_find_byte_any() noexcept {
+    return select_variant<find_byte_any_fn>(
+      { { { cpu_feature::avx2 }, find_byte_any_avx2 }, { { cpu_feature::ssse3 }, find_byte_any_ssse3 } },
+      find_byte_any_scalar);
+}
+
+#elif defined(ASYNCLE_BULK_AARCH64)
+
+// STNP (store pair, non-temporal hint) of two Q registers; DMB ISHST orders
+// the streamed data before a later release store, matching SFENCE on x86
+
+inline void stream_copy_neon(void* dst, const void* src, size_t n) noexcept {
+    auto*       d    = static_cast<char*>(dst);
+    const auto* s    = static_cast<const char*>(src);
+    size_t      head = head_bytes<32>(d, n);
+    std::memcpy(d, s, head);
+    d += head, s += head, n -= head;
+    for(; n >= 64; d += 64, s += 64, n -= 64) {
+        asm volatile("ldp q0, q1, [%1]\n\t"
+                     "ldp q2, q3, [%1, #32]\n\t"
+                     "stnp q0, q1, [%0]\n\t"
+                     "stnp q2, q3, [%0, #32]"
+                     :
+                     : "r"(d), "r"(s)
+                     : "v0", "v1", "v2", "v3", "memory");
+    }
+    asm volatile("dmb ishst" ::: "memory");
+    std::memcpy(d, s, n);
+}
+
+// DC ZVA block size in bytes, 0 when the instruction is prohibited (DCZID_EL0.DZP)
+inline size_t zva_block_size() noexcept {
+    uint64_t dczid;
+    asm volatile("mrs %0, dczid_el0" : "=r"(dczid));
+    return (dczid & 16) ? 0 : size_t(4) << (dczid & 15);
+}
+
+inline void stream_fill_neon(void* dst, uint8_t value, size_t n) noexcept {
+    auto* d = static_cast<char*>(dst);
+
+    // Zeroing: DC ZVA clears whole blocks without reading them first
+    static const size_t zva = zva_block_size();
+    if(value == 0 && zva != 0 && n >= 2 * zva) {
+        size_t head = (zva - (reinterpret_cast<uintptr_t>(d) & (zva - 1))) & (zva - 1);
+        std::memset(d, 0, head);
+        d += head, n -= head;
+        for(; n >= zva; d += zva, n -= zva) asm volatile("dc zva, %0" : : "r"(d) : "memory");
+        asm volatile("dmb ishst" ::: "memory");
+        std::memset(d, 0, n);
+        return;
+    }
+
+    size_t head = head_bytes<32>(d, n);
+    std::memset(d, value, head);
+    d += head, n -= head;
+    asm volatile("dup v0.16b, %w0" : : "r"(static_cast<uint32_t>(value)) : "v0");
+    for(; n >= 64; d += 64, n -= 64) {
+        asm volatile("stnp q0, q0, [%0]\n\t"
+                     "stnp q0, q0, [%0, #32]"
+                     :
+                     : "r"(d)
+                     : "v0", "memory");
+    }
+    asm volatile("dmb ishst" ::: "memory");
+    std::memset(d, value, n);
+}
+
+inline stream_copy_fn* select_stream_copy() noexcept { return stream_copy_neon; }
+
+inline stream_fill_fn* select_stream_fill() noexcept { return stream_fill_neon; }
+
+// glibc and Apple libc memchr are already NEON; the scalar set search stays portable
+inline find_byte_fn* select_find_byte() noexcept { return find_byte_scalar; }
+
+inline find_byte_any_fn* select_find_byte_any() noexcept { return find_byte_any_scalar; }
+
+#else
+
+inline stream_copy_fn* select_stream_copy() noexcept { return stream_copy_scalar; }
+
+inline stream_fill_fn* select_stream_fill() noexcept { return stream_fill_scalar; }
+
+inline find_byte_fn* select_find_byte() noexcept { return find_byte_scalar; }
+
+inline find_byte_any_fn* select_find_byte_any() noexcept { return find_byte_any_scalar; }
+
+#endif
+
+}  // namespace detail
+
+// Copy with non-temporal stores: the destination goes to memory without
+// displacing the caller's working set from L1-L3. Use it for large one-shot
+// copies (filling an mmap'd output file); it is slower than memcpy when the
+// destination is read again soon. Regions must not overlap. The stores are
+// fenced before returning. The variant (AVX-512, AVX2, SSE2; NEON STNP) is
+// chosen once from cpu_features(), so ASYNCLE_CPU_DISABLE applies.
+inline void stream_copy(void* dst, const void* src, size_t n) noexcept {
+    if(n < stream_min_size) {
+        std::memcpy(dst, src, n);
+        return;
+    }
+    static detail::stream_copy_fn* const impl = detail::select_stream_copy();
+    impl(dst, src, n);
+}
+
+// memset with non-temporal stores (DC ZVA for zeroing on aarch64)
+inline void stream_fill(void* dst, uint8_t value, size_t n) noexcept {
+    if(n < stream_min_size) {
+        std::memset(dst, value, n);
+        return;
+    }
+    static detail::stream_fill_fn* const impl = detail::select_stream_fill();
+    impl(dst, value, n);
+}
+
+// ============================================================================
+// SIMD Byte Search
+// ============================================================================
+
+// First occurrence of value in [data, data + n), nullptr if absent (memchr)
+inline const void* find_byte(const void* data, size_t n, uint8_t value) noexcept {
+    static detail::find_byte_fn* const impl = detail::select_find_byte();
+    return impl(data, n, value);
+}
+
+// First byte in [data, data + n) that is a member of set, nullptr if none
+inline const void* find_byte_any(const void* data, size_t n, const byte_set& set) noexcept {
+    if(set.count == 0) return nullptr;
+    if(set.count == 1) return find_byte(data, n, set.first);
+    static detail::find_byte_any_fn* const impl = detail::select_find_byte_any();
+    return impl(data, n, set);
+}
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_BULK_HPP
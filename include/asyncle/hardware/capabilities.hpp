@@ -0,0 +1,148 @@
+#ifndef ASYNCLE_HARDWARE_CAPABILITIES_HPP
+#define ASYNCLE_HARDWARE_CAPABILITIES_HPP
+
+#include "../../platform/hardware.hpp"
+#include "arch/current.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+
+// Compile one function for an instruction set the build does not target:
+//
+//   ASYNCLE_TARGET("avx2,bmi2") size_t count_avx2(const char* p, size_t n);
+//
+// Call such a function only after a runtime check (cpu_features() or
+// select_variant below); executing it on a CPU without the extension faults.
+#if defined(__GNUC__) || defined(__clang__)
+#define ASYNCLE_TARGET(spec) __attribute__((target(spec)))
+#define ASYNCLE_HAS_TARGET_ATTRIBUTE 1
+#else
+#define ASYNCLE_TARGET(spec)
+#define ASYNCLE_HAS_TARGET_ATTRIBUTE 0
+#endif
+
+// Target strings for the x86-64 micro-architecture levels (psABI), matching the
+// feature sets below: v3 = Haswell / Zen 1 and later, v4 = Skylake-SP and later
+#define ASYNCLE_TARGET_X86_64_V3 "avx,avx2,bmi,bmi2,fma,f16c,lzcnt,movbe,popcnt,sse4.2"
+#define ASYNCLE_TARGET_X86_64_V4 ASYNCLE_TARGET_X86_64_V3 ",avx512f,avx512bw,avx512cd,avx512dq,avx512vl"
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Runtime CPU Features (Platform-specific)
+// ============================================================================
+
+// Import feature detection from platform layer
+using platform::hardware::cpu_feature;
+using platform::hardware::cpu_feature_name;
+using platform::hardware::cpu_feature_set;
+using platform::hardware::detect_cpu_features;
+
+// Micro-architecture levels, for variants built with ASYNCLE_TARGET_X86_64_V*
+inline constexpr cpu_feature_set x86_64_v3 { cpu_feature::avx,    cpu_feature::avx2,  cpu_feature::bmi1,
+                                             cpu_feature::bmi2,   cpu_feature::fma,   cpu_feature::f16c,
+                                             cpu_feature::lzcnt,  cpu_feature::movbe, cpu_feature::popcnt,
+                                             cpu_feature::sse4_2 };
+
+inline constexpr cpu_feature_set x86_64_v4 =
+  x86_64_v3
+  | cpu_feature_set { cpu_feature::avx512f, cpu_feature::avx512bw, cpu_feature::avx512cd, cpu_feature::avx512dq,
+                      cpu_feature::avx512vl };
+
+namespace detail {
+
+// Look a feature up by cpu_feature_name(); false if unknown
+inline bool parse_cpu_feature(std::string_view name, cpu_feature& out) noexcept {
+    for(size_t i = 0; i < static_cast<size_t>(cpu_feature::count); ++i) {
+        if(name == cpu_feature_name(static_cast<cpu_feature>(i))) {
+            out = static_cast<cpu_feature>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Clear extensions whose base is absent, as the hardware probes already report them
+inline void drop_orphan_features(cpu_feature_set& features) noexcept {
+    auto drop_range = [&](cpu_feature first, cpu_feature last) {
+        for(size_t i = static_cast<size_t>(first); i <= static_cast<size_t>(last); ++i) {
+            features.clear(static_cast<cpu_feature>(i));
+        }
+    };
+    if(!features.has(cpu_feature::avx512f)) drop_range(cpu_feature::avx512dq, cpu_feature::avx512fp16);
+    if(!features.has(cpu_feature::avx)) {
+        drop_range(cpu_feature::avx2, cpu_feature::avx512fp16);
+        features.clear(cpu_feature::vaes);
+        features.clear(cpu_feature::vpclmulqdq);
+    }
+    if(!features.has(cpu_feature::sve)) features.clear(cpu_feature::sve2);
+}
+
+// Clear the features named in a comma-separated list (unknown names are ignored),
+// with everything that builds on them: "avx" also hides AVX2 and AVX-512
+inline void remove_cpu_features(cpu_feature_set& features, std::string_view list) noexcept {
+    while(!list.empty()) {
+        size_t           comma = list.find(',');
+        std::string_view name  = list.substr(0, comma);
+        cpu_feature      f;
+        if(parse_cpu_feature(name, f)) features.clear(f);
+        list = comma == std::string_view::npos ? std::string_view {} : list.substr(comma + 1);
+    }
+    drop_orphan_features(features);
+}
+
+inline cpu_feature_set probe_cpu_features() noexcept {
+    cpu_feature_set features = detect_cpu_features();
+    if(const char* disabled = std::getenv("ASYNCLE_CPU_DISABLE")) remove_cpu_features(features, disabled);
+    return features;
+}
+
+}  // namespace detail
+
+// Features of this machine, probed once per process.
+// ASYNCLE_CPU_DISABLE=avx512f,avx2 (names as in cpu_feature_name) hides
+// features from this set, to exercise fallback paths on a capable host.
+inline const cpu_feature_set& cpu_features() noexcept {
+    static const cpu_feature_set cached = detail::probe_cpu_features();
+    return cached;
+}
+
+inline bool has_cpu_feature(cpu_feature f) noexcept { return cpu_features().has(f); }
+
+// ============================================================================
+// Function Multi-Versioning
+// ============================================================================
+
+// One implementation and the features it was compiled for
+template <typename Fn>
+struct cpu_variant {
+    cpu_feature_set required;
+    Fn*             fn;
+};
+
+// First variant whose required features are all present, else fallback.
+// List variants best first; resolve once and keep the pointer:
+//
+//   using count_fn = size_t(const char*, size_t);
+//   static count_fn* const count = select_variant<count_fn>(
+//     { { x86_64_v4, count_avx512 }, { x86_64_v3, count_avx2 } }, count_scalar);
+template <typename Fn>
+constexpr Fn* select_variant(std::span<const cpu_variant<Fn>> variants, Fn* fallback,
+                             const cpu_feature_set& available) noexcept {
+    for(const auto& v : variants) {
+        if(v.fn && available.has_all(v.required)) return v.fn;
+    }
+    return fallback;
+}
+
+template <typename Fn>
+Fn* select_variant(std::initializer_list<cpu_variant<Fn>> variants, Fn* fallback) noexcept {
+    return select_variant<Fn>(std::span<const cpu_variant<Fn>>(variants.begin(), variants.size()), fallback,
+                              cpu_features());
+}
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_CAPABILITIES_HPP
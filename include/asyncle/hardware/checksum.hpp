@@ -0,0 +1,298 @@
+#ifndef ASYNCLE_HARDWARE_CHECKSUM_HPP
+#define ASYNCLE_HARDWARE_CHECKSUM_HPP
+
+// asyncle::hardware checksums - CRC32C and XXH64 over memory blocks
+//
+// crc32c() picks an implementation once, on first use:
+//   x86-64   SSE4.2 CRC32 instruction, three independent streams per block
+//   aarch64  ARMv8 CRC32C instructions, likewise interleaved
+//   other    slicing-by-8 tables
+// The CRC instruction has a 3-cycle latency but issues every cycle, so one
+// dependent stream runs at a third of its throughput. Large inputs are split
+// into three lanes that are summed in parallel and merged with a table that
+// shifts a CRC past a lane of zeros.
+//
+// xxh64() is the portable XXH64, for integrity checks where a CRC's error
+// guarantees are not needed but 64 bits are.
+
+#include "capabilities.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ASYNCLE_CHECKSUM_X86_64 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define ASYNCLE_CHECKSUM_AARCH64 1
+#include <arm_acle.h>
+#if defined(__clang__)
+#define ASYNCLE_TARGET_ARM_CRC ASYNCLE_TARGET("crc")
+#else
+#define ASYNCLE_TARGET_ARM_CRC ASYNCLE_TARGET("+crc")
+#endif
+#endif
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// CRC32C (Castagnoli)
+// ============================================================================
+
+namespace detail {
+
+using crc32c_fn = uint32_t(uint32_t crc, const void* data, size_t n) noexcept;
+
+inline constexpr uint32_t crc32c_polynomial = 0x82F63B78u;  // Reflected
+
+// Slicing-by-8: table[k][b] is the CRC of byte b followed by k zero bytes
+inline constexpr std::array<std::array<uint32_t, 256>, 8> crc32c_tables = [] {
+    std::array<std::array<uint32_t, 256>, 8> tables {};
+    for(uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for(int bit = 0; bit < 8; ++bit) c = (c >> 1) ^ (crc32c_polynomial & (0u - (c & 1u)));
+        tables[0][i] = c;
+    }
+    for(size_t k = 1; k < 8; ++k) {
+        for(size_t i = 0; i < 256; ++i) {
+            uint32_t c   = tables[k - 1][i];
+            tables[k][i] = tables[0][c & 0xff] ^ (c >> 8);
+        }
+    }
+    return tables;
+}();
+
+inline uint64_t crc32c_load64(const unsigned char* p) noexcept {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// Raw register form: no pre/post inversion
+inline uint32_t crc32c_scalar(uint32_t crc, const void* data, size_t n) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    const auto& t = crc32c_tables;
+    if constexpr(std::endian::native == std::endian::little) {
+        for(; n >= 8; p += 8, n -= 8) {
+            uint64_t word = crc32c_load64(p) ^ crc;
+            crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff]
+                ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+        }
+    }
+    for(; n > 0; ++p, --n) crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+// Operator that appends `bytes` zero bytes to a CRC register, as four byte
+// tables; built by squaring the one-zero-bit operator over GF(2)
+constexpr std::array<std::array<uint32_t, 256>, 4> crc32c_zeros_tables(size_t bytes) noexcept {
+    using matrix = std::array<uint32_t, 32>;
+    auto apply   = [](const matrix& m, uint32_t v) {
+        uint32_t out = 0;
+        for(size_t i = 0; v != 0; ++i, v >>= 1) {
+            if(v & 1u) out ^= m[i];
+        }
+        return out;
+    };
+    auto square = [&](const matrix& m) {
+        matrix out {};
+        for(size_t i = 0; i < 32; ++i) out[i] = apply(m, m[i]);
+        return out;
+    };
+
+    matrix op {};  // One zero bit
+    op[0] = crc32c_polynomial;
+    for(size_t i = 1; i < 32; ++i) op[i] = 1u << (i - 1);
+    for(int i = 0; i < 3; ++i) op = square(op);  // One zero byte
+
+    matrix result {};  // Identity
+    for(size_t i = 0; i < 32; ++i) result[i] = 1u << i;
+    for(; bytes != 0; bytes >>= 1, op = square(op)) {
+        if(bytes & 1u) {
+            matrix next {};
+            for(size_t i = 0; i < 32; ++i) next[i] = apply(op, result[i]);
+            result = next;
+        }
+    }
+
+    std::array<std::array<uint32_t, 256>, 4> tables {};
+    for(size_t k = 0; k < 4; ++k) {
+        for(uint32_t b = 0; b < 256; ++b) tables[k][b] = apply(result, b << (8 * k));
+    }
+    return tables;
+}
+
+// Lane lengths for the three-stream kernels: long lanes amortize the merge,
+// short lanes keep mid-sized inputs off the single stream
+inline constexpr size_t crc32c_long_lane  = 8192;
+inline constexpr size_t crc32c_short_lane = 256;
+
+inline constexpr auto crc32c_long_shift  = crc32c_zeros_tables(crc32c_long_lane);
+inline constexpr auto crc32c_short_shift = crc32c_zeros_tables(crc32c_short_lane);
+
+inline uint32_t crc32c_shift(const std::array<std::array<uint32_t, 256>, 4>& table, uint32_t crc) noexcept {
+    return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^ table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+#if defined(ASYNCLE_CHECKSUM_X86_64)
+
+ASYNCLE_TARGET("sse4.2") inline uint32_t crc32c_sse42(uint32_t crc, const void* data, size_t n) noexcept {
+    const auto* p  = static_cast<const unsigned char*>(data);
+    uint64_t    c0 = crc;
+
+    auto lanes = [&](size_t lane, const auto& shift) ASYNCLE_TARGET("sse4.2") {
+        for(; n >= 3 * lane; p += 2 * lane, n -= 3 * lane) {
+            uint64_t    c1  = 0;
+            uint64_t    c2  = 0;
+            const auto* end = p + lane;
+            for(; p < end; p += 8) {
+                c0 = _mm_crc32_u64(c0, crc32c_load64(p));
+                c1 = _mm_crc32_u64(c1, crc32c_load64(p + lane));
+                c2 = _mm_crc32_u64(c2, crc32c_load64(p + 2 * lane));
+            }
+            c0 = crc32c_shift(shift, static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c1);
+            c0 = crc32c_shift(shift, static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c2);
+        }
+    };
+    lanes(crc32c_long_lane, crc32c_long_shift);
+    lanes(crc32c_short_lane, crc32c_short_shift);
+
+    for(; n >= 8; p += 8, n -= 8) c0 = _mm_crc32_u64(c0, crc32c_load64(p));
+    auto c = static_cast<uint32_t>(c0);
+    for(; n > 0; ++p, --n) c = _mm_crc32_u8(c, *p);
+    return c;
+}
+
+inline crc32c_fn* select_crc32c() noexcept {
+    return select_variant<crc32c_fn>({ { { cpu_feature::sse4_2 }, crc32c_sse42 } }, crc32c_scalar);
+}
+
+#elif defined(ASYNCLE_CHECKSUM_AARCH64)
+
+ASYNCLE_TARGET_ARM_CRC inline uint32_t crc32c_arm(uint32_t crc, const void* data, size_t n) noexcept {
+    const auto* p  = static_cast<const unsigned char*>(data);
+    uint32_t    c0 = crc;
+
+    auto lanes = [&](size_t lane, const auto& shift) ASYNCLE_TARGET_ARM_CRC {
+        for(; n >= 3 * lane; p += 2 * lane, n -= 3 * lane) {
+            uint32_t    c1  = 0;
+            uint32_t    c2  = 0;
+            const auto* end = p + lane;
+            for(; p < end; p += 8) {
+                c0 = __crc32cd(c0, crc32c_load64(p));
+                c1 = __crc32cd(c1, crc32c_load64(p + lane));
+                c2 = __crc32cd(c2, crc32c_load64(p + 2 * lane));
+            }
+            c0 = crc32c_shift(shift, c0) ^ c1;
+            c0 = crc32c_shift(shift, c0) ^ c2;
+        }
+    };
+    lanes(crc32c_long_lane, crc32c_long_shift);
+    lanes(crc32c_short_lane, crc32c_short_shift);
+
+    for(; n >= 8; p += 8, n -= 8) c0 = __crc32cd(c0, crc32c_load64(p));
+    for(; n > 0; ++p, --n) c0 = __crc32cb(c0, *p);
+    return c0;
+}
+
+inline crc32c_fn* select_crc32c() noexcept {
+    return select_variant<crc32c_fn>({ { { cpu_feature::arm_crc32 }, crc32c_arm } }, crc32c_scalar);
+}
+
+#else
+
+inline crc32c_fn* select_crc32c() noexcept { return crc32c_scalar; }
+
+#endif
+
+}  // namespace detail
+
+// CRC32C of [data, data + n), continuing from a previous result:
+//   crc32c(b, nb, crc32c(a, na)) == crc32c of a followed by b
+// Every implementation gives the same value.
+inline uint32_t crc32c(const void* data, size_t n, uint32_t previous = 0) noexcept {
+    static detail::crc32c_fn* const impl = detail::select_crc32c();
+    return ~impl(~previous, data, n);
+}
+
+template <typename T, size_t Extent>
+requires std::is_trivially_copyable_v<T>
+uint32_t crc32c(std::span<T, Extent> data, uint32_t previous = 0) noexcept {
+    return crc32c(data.data(), data.size_bytes(), previous);
+}
+
+// ============================================================================
+// XXH64
+// ============================================================================
+
+// XXH64 (seed 0 by default), bit-compatible with the reference implementation
+inline uint64_t xxh64(const void* data, size_t length, uint64_t seed = 0) noexcept {
+    constexpr uint64_t p1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t p2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t p3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t p4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t p5 = 0x27D4EB2F165667C5ull;
+
+    auto read64 = [](const unsigned char* p) noexcept {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    };
+    auto read32 = [](const unsigned char* p) noexcept {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    };
+    auto round = [](uint64_t acc, uint64_t input) noexcept { return std::rotl(acc + input * p2, 31) * p1; };
+    auto merge = [&](uint64_t acc, uint64_t value) noexcept { return (acc ^ round(0, value)) * p1 + p4; };
+
+    auto*       p   = static_cast<const unsigned char*>(data);
+    const auto* end = p + length;
+    uint64_t    h;
+
+    if(length >= 32) {
+        uint64_t v1 = seed + p1 + p2;
+        uint64_t v2 = seed + p2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - p1;
+        for(; end - p >= 32; p += 32) {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+        }
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        h = merge(merge(merge(merge(h, v1), v2), v3), v4);
+    } else {
+        h = seed + p5;
+    }
+
+    h += length;
+    for(; end - p >= 8; p += 8) { h = std::rotl(h ^ round(0, read64(p)), 27) * p1 + p4; }
+    if(end - p >= 4) {
+        h  = std::rotl(h ^ (read32(p) * p1), 23) * p2 + p3;
+        p += 4;
+    }
+    for(; p < end; ++p) { h = std::rotl(h ^ (*p * p5), 11) * p1; }
+
+    h ^= h >> 33;
+    h *= p2;
+    h ^= h >> 29;
+    h *= p3;
+    h ^= h >> 32;
+    return h;
+}
+
+template <typename T, size_t Extent>
+requires std::is_trivially_copyable_v<T>
+uint64_t xxh64(std::span<T, Extent> data, uint64_t seed = 0) noexcept {
+    return xxh64(data.data(), data.size_bytes(), seed);
+}
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_CHECKSUM_HPP
@@ -0,0 +1,251 @@
+#ifndef ASYNCLE_HARDWARE_CLOCK_HPP
+#define ASYNCLE_HARDWARE_CLOCK_HPP
+
+#include "capabilities.hpp"
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ASYNCLE_CLOCK_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define ASYNCLE_CLOCK_CNTVCT 1
+#endif
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Cycle Counter
+// ============================================================================
+
+// Where cycle_clock ticks come from
+enum class tick_source : uint8_t {
+    steady_clock = 0,  // No usable counter: ticks are steady_clock nanoseconds
+    tsc          = 1,  // x86-64 time-stamp counter (rdtsc / rdtscp)
+    cntvct       = 2   // AArch64 generic timer virtual count (cntvct_el0)
+};
+
+// Conversion from ticks to nanoseconds, measured once per process
+struct clock_calibration {
+    tick_source source       = tick_source::steady_clock;
+    double      ticks_per_ns = 1.0;
+    uint64_t    ns_scale     = uint64_t(1) << 32;  // ns = ticks * ns_scale >> 32
+    bool        invariant    = true;               // Constant tick rate across frequency and power states
+};
+
+namespace detail {
+
+// Full 64x64 product shifted right by 32, so long intervals do not overflow
+inline uint64_t mul_shift32(uint64_t ticks, uint64_t scale) noexcept {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(ticks) * scale) >> 32);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(ticks, scale, &high);
+    return __shiftright128(low, high, 32);
+#else
+    return (ticks >> 32) * scale + (((ticks & 0xffffffffu) * scale) >> 32);
+#endif
+}
+
+inline uint64_t steady_ns() noexcept {
+    return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+}
+
+#if defined(ASYNCLE_CLOCK_CNTVCT)
+inline uint64_t cntvct() noexcept {
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+}
+
+inline uint64_t cntfrq() noexcept {
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(value));
+    return value;
+}
+#endif
+
+// Counter read paired with steady_clock, keeping the tightest of a few brackets
+inline void paired_read(uint64_t (*read_ticks)() noexcept, uint64_t& ticks, uint64_t& ns) noexcept {
+    uint64_t best = UINT64_MAX;
+    for(int i = 0; i < 5; ++i) {
+        uint64_t before = read_ticks();
+        uint64_t now    = steady_ns();
+        uint64_t after  = read_ticks();
+        if(after - before < best) {
+            best  = after - before;
+            ticks = before + (after - before) / 2;
+            ns    = now;
+        }
+    }
+}
+
+}  // namespace detail
+
+// Cheap monotonic timestamps for per-message timing. A ticks() read is one
+// rdtsc (~7 ns) or mrs cntvct_el0 instead of a steady_clock::now() vDSO call
+// (~20 ns, more under some hypervisors), and converting an interval to
+// nanoseconds is one multiply. The tick rate is measured once against
+// steady_clock on first use (calibration(), ~2 ms), or read from cntfrq_el0
+// on AArch64.
+//
+//   uint64_t start = cycle_clock::ticks();
+//   handle(message);
+//   latency.record(cycle_clock::to_nanoseconds(cycle_clock::ticks() - start));
+//
+// ticks() is not ordered against surrounding instructions: out-of-order
+// execution may move the read a few dozen instructions either way, which is
+// noise for microsecond work. Time short regions with ticks_begin()/ticks_end();
+// they wait for earlier instructions to retire and keep later ones from
+// starting early, at 20-40 cycles each.
+//
+// Also a std::chrono clock (now(), time_point, duration in nanoseconds).
+// Counters are synchronized across cores on current hardware, but under
+// hypervisors without a stable TSC calibration().invariant is false and
+// intervals may jump; such hosts usually disable the invariant-tsc CPU flag.
+class cycle_clock {
+    public:
+    using rep        = int64_t;
+    using period     = std::nano;
+    using duration   = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<cycle_clock>;
+
+    static constexpr bool is_steady = true;
+
+    // Compile-time counter choice (calibration().source reports the same)
+    static constexpr tick_source source =
+#if defined(ASYNCLE_CLOCK_TSC)
+      tick_source::tsc;
+#elif defined(ASYNCLE_CLOCK_CNTVCT)
+      tick_source::cntvct;
+#else
+      tick_source::steady_clock;
+#endif
+
+    // Raw counter, unserialized
+    static uint64_t ticks() noexcept {
+#if defined(ASYNCLE_CLOCK_TSC)
+        return __rdtsc();
+#elif defined(ASYNCLE_CLOCK_CNTVCT)
+        return detail::cntvct();
+#else
+        return detail::steady_ns();
+#endif
+    }
+
+    // Start of a measured region: earlier instructions have completed and the
+    // region has not started when the counter is read
+    static uint64_t ticks_begin() noexcept {
+#if defined(ASYNCLE_CLOCK_TSC)
+        _mm_lfence();
+        uint64_t value = __rdtsc();
+        _mm_lfence();
+        return value;
+#elif defined(ASYNCLE_CLOCK_CNTVCT)
+        __asm__ volatile("isb" ::: "memory");
+        return detail::cntvct();
+#else
+        return detail::steady_ns();
+#endif
+    }
+
+    // End of a measured region: the region has completed when the counter is
+    // read (rdtscp where the CPU has it, else lfence + rdtsc)
+    static uint64_t ticks_end() noexcept {
+#if defined(ASYNCLE_CLOCK_TSC)
+        static const bool has_rdtscp = has_cpu_feature(cpu_feature::rdtscp);
+        uint64_t          value;
+        if(has_rdtscp) {
+            unsigned aux;
+            value = __rdtscp(&aux);
+        } else {
+            _mm_lfence();
+            value = __rdtsc();
+        }
+        _mm_lfence();
+        return value;
+#elif defined(ASYNCLE_CLOCK_CNTVCT)
+        __asm__ volatile("isb" ::: "memory");
+        uint64_t value = detail::cntvct();
+        __asm__ volatile("isb" ::: "memory");
+        return value;
+#else
+        return detail::steady_ns();
+#endif
+    }
+
+    // Measure the tick rate over window (blocks the caller for that long)
+    static clock_calibration calibrate(std::chrono::nanoseconds window = std::chrono::milliseconds(2)) noexcept {
+        clock_calibration out;
+        out.source = source;
+#if defined(ASYNCLE_CLOCK_CNTVCT)
+        (void)window;
+        uint64_t frequency = detail::cntfrq();
+        if(frequency) out.ticks_per_ns = static_cast<double>(frequency) / 1e9;
+#elif defined(ASYNCLE_CLOCK_TSC)
+        out.invariant = has_cpu_feature(cpu_feature::invariant_tsc);
+        uint64_t t0 = 0, n0 = 0, t1 = 0, n1 = 0;
+        detail::paired_read(&cycle_clock::ticks, t0, n0);
+        uint64_t deadline = n0 + static_cast<uint64_t>(window.count());
+        while(detail::steady_ns() < deadline) {}
+        detail::paired_read(&cycle_clock::ticks, t1, n1);
+        if(n1 > n0 && t1 > t0) out.ticks_per_ns = static_cast<double>(t1 - t0) / static_cast<double>(n1 - n0);
+#else
+        (void)window;
+#endif
+        out.ns_scale = static_cast<uint64_t>(4294967296.0 / out.ticks_per_ns + 0.5);
+        return out;
+    }
+
+    // Process-wide calibration, measured on first call
+    static const clock_calibration& calibration() noexcept {
+        static const clock_calibration cached = calibrate();
+        return cached;
+    }
+
+    static uint64_t to_nanoseconds(uint64_t ticks) noexcept {
+        return detail::mul_shift32(ticks, calibration().ns_scale);
+    }
+
+    static uint64_t from_nanoseconds(uint64_t ns) noexcept {
+        return static_cast<uint64_t>(static_cast<double>(ns) * calibration().ticks_per_ns);
+    }
+
+    static time_point now() noexcept { return time_point(duration(static_cast<rep>(to_nanoseconds(ticks())))); }
+};
+
+// Records the nanoseconds from construction to destruction into sink, which
+// is anything with record(value): a concurrent::sharded_histogram or
+// sharded_stat, or the caller's own aggregate
+//
+//   concurrent::sharded_histogram handle_ns;
+//   {
+//       scoped_timer timed(handle_ns);
+//       handle(message);
+//   }
+template <typename Sink>
+class scoped_timer {
+    Sink&    sink_;
+    uint64_t start_;
+
+    public:
+    explicit scoped_timer(Sink& sink) noexcept: sink_(sink), start_(cycle_clock::ticks()) {}
+
+    ~scoped_timer() { sink_.record(elapsed_ns()); }
+
+    scoped_timer(const scoped_timer&)            = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+
+    uint64_t elapsed_ns() const noexcept { return cycle_clock::to_nanoseconds(cycle_clock::ticks() - start_); }
+};
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_CLOCK_HPP
@@ -0,0 +1,467 @@
+#ifndef ASYNCLE_HARDWARE_LAYOUT_HPP
+#define ASYNCLE_HARDWARE_LAYOUT_HPP
+
+// asyncle::hardware layout - Aligned allocation and struct-of-arrays storage
+//
+// aligned_allocator<T, Alignment> is a standard allocator whose blocks start
+// on an Alignment boundary (a cache line by default), so a vector's first
+// element never straddles lines and SIMD loads from it are aligned.
+// page_allocator<T, Pages> maps every block from the kernel instead: page
+// aligned, zero filled, and with page_preference::prefer_large or
+// transparent_large backed by huge pages where the system grants them. It
+// suits a few large, long-lived arrays, not many small ones.
+//
+// soa_vector<Ts...> stores a table of records as one array per field. A loop
+// that reads two fields of a twelve-field record then streams two dense
+// arrays through the cache rather than striding over whole records, and
+// for_each<I...>(f), which indexes raw column pointers, is a plain counted
+// loop the compiler can vectorize. Fields are addressed by index; an enum
+// names them.
+//
+// Usage:
+//   enum field : size_t { price, quantity, score };
+//   hardware::soa_vector<double, int32_t, float> rows;
+//   rows.push_back(9.5, 3, 0.f);
+//   rows.for_each<price, quantity, score>([](double p, int32_t q, float& s) { s = float(p * q); });
+//   for(auto [p, s] : rows.zip<price, score>()) ...;
+//   std::span<const float> scores = rows.column<score>();
+
+#include "../../platform/mmap.hpp"
+#include "memory.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Aligned Allocators
+// ============================================================================
+
+// Allocator returning blocks aligned to Alignment (a power of two)
+template <typename T, size_t Alignment = cache_line_size>
+class aligned_allocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must not be below the type's own");
+
+    public:
+    using value_type = T;
+
+    static constexpr size_t alignment = Alignment;
+
+    template <typename U>
+    struct rebind {
+        using other = aligned_allocator<U, std::max(Alignment, alignof(U))>;
+    };
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template <typename U, size_t A>
+    constexpr aligned_allocator(const aligned_allocator<U, A>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if(n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept { ::operator delete(p, n * sizeof(T), std::align_val_t(Alignment)); }
+
+    template <typename U, size_t A>
+    constexpr bool operator==(const aligned_allocator<U, A>&) const noexcept {
+        return true;
+    }
+};
+
+template <typename T>
+using cache_aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+namespace detail {
+
+// Lengths page_allocator maps: whole pages, or whole large-page granules so
+// deallocate() unmaps exactly what any page tier mapped
+template <platform::mmap::page_preference Pages>
+inline size_t page_granule() noexcept {
+    static const size_t granule = [] {
+        const auto caps = platform::mmap::query_capabilities();
+        if(Pages != platform::mmap::page_preference::system_default && caps.large_page_granularity != 0) {
+            return caps.large_page_granularity;
+        }
+        return caps.system_page_size ? caps.system_page_size : size_t { 4096 };
+    }();
+    return granule;
+}
+
+}  // namespace detail
+
+// Allocator mapping each block from the kernel: page aligned and zero filled,
+// on huge pages when Pages asks for them and the system has them (see
+// platform::mmap::page_preference; require_large throws when it cannot)
+template <typename T, platform::mmap::page_preference Pages = platform::mmap::page_preference::system_default>
+class page_allocator {
+    public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = page_allocator<U, Pages>;
+    };
+
+    constexpr page_allocator() noexcept = default;
+
+    template <typename U>
+    constexpr page_allocator(const page_allocator<U, Pages>&) noexcept {}
+
+    // Bytes mapped for n elements
+    static size_t mapped_bytes(size_t n) noexcept {
+        const size_t granule = detail::page_granule<Pages>();
+        return (n * sizeof(T) + granule - 1) / granule * granule;
+    }
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if(n > (std::numeric_limits<size_t>::max() - detail::page_granule<Pages>()) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        platform::mmap::memory_request req {};
+        req.length    = mapped_bytes(n == 0 ? 1 : n);
+        req.access    = platform::mmap::access_mode::read_write;
+        req.sharing   = platform::mmap::sharing_mode::private_cow;
+        req.backing   = platform::mmap::backing_type::anonymous;
+        req.page_pref = Pages;
+        auto region   = platform::mmap::map_memory(-1, req);
+        if(!region) throw std::bad_alloc();
+        return static_cast<T*>(region->address);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        platform::mmap::memory_region region;
+        region.address = p;
+        region.length  = mapped_bytes(n == 0 ? 1 : n);
+        platform::mmap::unmap_memory(region);
+    }
+
+    template <typename U>
+    constexpr bool operator==(const page_allocator<U, Pages>&) const noexcept {
+        return true;
+    }
+};
+
+// ============================================================================
+// Struct-of-Arrays Storage
+// ============================================================================
+
+// Iterator over chosen columns of a soa_vector; dereferences to a tuple of
+// references, so structured bindings name the fields
+template <typename... Ps>
+class soa_zip_iterator {
+    std::tuple<Ps*...> columns_ {};
+    size_t             index_ = 0;
+
+    public:
+    using value_type        = std::tuple<std::remove_const_t<Ps>...>;
+    using reference         = std::tuple<Ps&...>;
+    using difference_type   = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    constexpr soa_zip_iterator() noexcept = default;
+
+    constexpr soa_zip_iterator(std::tuple<Ps*...> columns, size_t index) noexcept: columns_(columns), index_(index) {}
+
+    constexpr reference operator*() const noexcept {
+        return std::apply([i = index_](Ps*... p) { return reference(p[i]...); }, columns_);
+    }
+
+    constexpr reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    constexpr soa_zip_iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    constexpr soa_zip_iterator operator++(int) noexcept {
+        auto old = *this;
+        ++index_;
+        return old;
+    }
+
+    constexpr soa_zip_iterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    constexpr soa_zip_iterator operator--(int) noexcept {
+        auto old = *this;
+        --index_;
+        return old;
+    }
+
+    constexpr soa_zip_iterator& operator+=(difference_type n) noexcept {
+        index_ = static_cast<size_t>(static_cast<difference_type>(index_) + n);
+        return *this;
+    }
+
+    constexpr soa_zip_iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+
+    friend constexpr soa_zip_iterator operator+(soa_zip_iterator it, difference_type n) noexcept { return it += n; }
+
+    friend constexpr soa_zip_iterator operator+(difference_type n, soa_zip_iterator it) noexcept { return it += n; }
+
+    friend constexpr soa_zip_iterator operator-(soa_zip_iterator it, difference_type n) noexcept { return it -= n; }
+
+    friend constexpr difference_type operator-(const soa_zip_iterator& a, const soa_zip_iterator& b) noexcept {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+
+    friend constexpr bool operator==(const soa_zip_iterator& a, const soa_zip_iterator& b) noexcept {
+        return a.index_ == b.index_;
+    }
+
+    friend constexpr auto operator<=>(const soa_zip_iterator& a, const soa_zip_iterator& b) noexcept {
+        return a.index_ <=> b.index_;
+    }
+};
+
+template <typename... Ps>
+struct soa_zip_range {
+    soa_zip_iterator<Ps...> first;
+    soa_zip_iterator<Ps...> last;
+
+    constexpr soa_zip_iterator<Ps...> begin() const noexcept { return first; }
+
+    constexpr soa_zip_iterator<Ps...> end() const noexcept { return last; }
+
+    constexpr size_t size() const noexcept { return static_cast<size_t>(last - first); }
+};
+
+// One array per field. Fields must be trivially copyable (columns grow by
+// memcpy); every column holds size() elements and starts on the allocator's
+// alignment. Allocator is rebound per field type.
+template <typename Allocator, typename... Ts>
+class basic_soa_vector {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one field");
+    static_assert((std::is_trivially_copyable_v<Ts> && ...), "soa_vector fields must be trivially copyable");
+
+    public:
+    static constexpr size_t field_count = sizeof...(Ts);
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template <typename T>
+    using allocator_for = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    private:
+    std::tuple<Ts*...> columns_ {};
+    size_t             size_     = 0;
+    size_t             capacity_ = 0;
+
+    template <size_t... Is>
+    void reallocate(size_t capacity, std::index_sequence<Is...>) {
+        std::tuple<Ts*...> fresh {};
+        size_t             done = 0;
+        try {
+            ((std::get<Is>(fresh) = allocator_for<field_type<Is>>().allocate(capacity), ++done), ...);
+        } catch(...) {
+            ((Is < done ? allocator_for<field_type<Is>>().deallocate(std::get<Is>(fresh), capacity) : void()), ...);
+            throw;
+        }
+        ((size_ ? (void)std::memcpy(std::get<Is>(fresh), std::get<Is>(columns_), size_ * sizeof(field_type<Is>))
+                : void()),
+         ...);
+        release(std::index_sequence<Is...> {});
+        columns_  = fresh;
+        capacity_ = capacity;
+    }
+
+    template <size_t... Is>
+    void release(std::index_sequence<Is...>) noexcept {
+        if(capacity_ == 0) return;
+        (allocator_for<field_type<Is>>().deallocate(std::get<Is>(columns_), capacity_), ...);
+        columns_  = {};
+        capacity_ = 0;
+    }
+
+    void grow_for(size_t n) {
+        if(n > capacity_) reserve(std::max(n, capacity_ ? capacity_ * 2 : size_t { 16 }));
+    }
+
+    template <size_t... Is>
+    void store(size_t i, std::index_sequence<Is...>, const Ts&... values) noexcept {
+        ((std::get<Is>(columns_)[i] = values), ...);
+    }
+
+    public:
+    // Constructors
+    basic_soa_vector() noexcept = default;
+
+    explicit basic_soa_vector(size_t n) { resize(n); }
+
+    basic_soa_vector(basic_soa_vector&& other) noexcept:
+        columns_(std::exchange(other.columns_, {})),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+    basic_soa_vector& operator=(basic_soa_vector&& other) noexcept {
+        if(this != &other) {
+            release(std::index_sequence_for<Ts...> {});
+            columns_  = std::exchange(other.columns_, {});
+            size_     = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    basic_soa_vector(const basic_soa_vector& other) { *this = other; }
+
+    basic_soa_vector& operator=(const basic_soa_vector& other) {
+        if(this != &other) {
+            size_ = 0;
+            reserve(other.size_);
+            size_ = other.size_;
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                ((size_ ? (void)std::memcpy(
+                            std::get<Is>(columns_), std::get<Is>(other.columns_), size_ * sizeof(field_type<Is>))
+                        : void()),
+                 ...);
+            }(std::index_sequence_for<Ts...> {});
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~basic_soa_vector() { release(std::index_sequence_for<Ts...> {}); }
+
+    // Capacity
+    size_t size() const noexcept { return size_; }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    void reserve(size_t n) {
+        if(n > capacity_) reallocate(n, std::index_sequence_for<Ts...> {});
+    }
+
+    // New rows are value-initialized (zero for arithmetic fields)
+    void resize(size_t n) {
+        reserve(n);
+        if(n > size_) {
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                (std::fill(std::get<Is>(columns_) + size_, std::get<Is>(columns_) + n, field_type<Is> {}), ...);
+            }(std::index_sequence_for<Ts...> {});
+        }
+        size_ = n;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    void shrink_to_fit() {
+        if(size_ == capacity_) return;
+        if(size_ == 0) {
+            release(std::index_sequence_for<Ts...> {});
+        } else {
+            reallocate(size_, std::index_sequence_for<Ts...> {});
+        }
+    }
+
+    // Modifiers
+    void push_back(const Ts&... values) {
+        grow_for(size_ + 1);
+        store(size_, std::index_sequence_for<Ts...> {}, values...);
+        ++size_;
+    }
+
+    void pop_back() noexcept {
+        if(size_) --size_;
+    }
+
+    void set(size_t i, const Ts&... values) noexcept { store(i, std::index_sequence_for<Ts...> {}, values...); }
+
+    // Element access
+    template <size_t I>
+    field_type<I>* data() noexcept {
+        return std::get<I>(columns_);
+    }
+
+    template <size_t I>
+    const field_type<I>* data() const noexcept {
+        return std::get<I>(columns_);
+    }
+
+    template <size_t I>
+    std::span<field_type<I>> column() noexcept {
+        return std::span<field_type<I>>(std::get<I>(columns_), size_);
+    }
+
+    template <size_t I>
+    std::span<const field_type<I>> column() const noexcept {
+        return std::span<const field_type<I>>(std::get<I>(columns_), size_);
+    }
+
+    template <size_t I>
+    field_type<I>& get(size_t i) noexcept {
+        return std::get<I>(columns_)[i];
+    }
+
+    template <size_t I>
+    const field_type<I>& get(size_t i) const noexcept {
+        return std::get<I>(columns_)[i];
+    }
+
+    // All fields of row i, by reference
+    std::tuple<Ts&...> row(size_t i) noexcept {
+        return std::apply([i](Ts*... p) { return std::tuple<Ts&...>(p[i]...); }, columns_);
+    }
+
+    std::tuple<const Ts&...> row(size_t i) const noexcept {
+        return std::apply([i](Ts*... p) { return std::tuple<const Ts&...>(p[i]...); }, columns_);
+    }
+
+    // Iteration over fields Is... of every row
+    template <size_t... Is>
+    soa_zip_range<field_type<Is>...> zip() noexcept {
+        std::tuple<field_type<Is>*...> picked(std::get<Is>(columns_)...);
+        return { { picked, 0 }, { picked, size_ } };
+    }
+
+    template <size_t... Is>
+    soa_zip_range<const field_type<Is>...> zip() const noexcept {
+        std::tuple<const field_type<Is>*...> picked(std::get<Is>(columns_)...);
+        return { { picked, 0 }, { picked, size_ } };
+    }
+
+    // f(field<Is>(i)...) for every row i, as a counted loop over the column
+    // pointers; fields are passed by reference, so f may write them
+    template <size_t... Is, typename F>
+    void for_each(F&& f) {
+        const size_t n = size_;
+        [&](field_type<Is>*... p) {
+            for(size_t i = 0; i < n; ++i) f(p[i]...);
+        }(std::get<Is>(columns_)...);
+    }
+
+    template <size_t... Is, typename F>
+    void for_each(F&& f) const {
+        const size_t n = size_;
+        [&](const field_type<Is>*... p) {
+            for(size_t i = 0; i < n; ++i) f(p[i]...);
+        }(std::get<Is>(columns_)...);
+    }
+};
+
+template <typename... Ts>
+using soa_vector = basic_soa_vector<aligned_allocator<std::byte>, Ts...>;
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_LAYOUT_HPP
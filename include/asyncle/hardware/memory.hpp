@@ -38,8 +38,14 @@ namespace asyncle::hardware {
 using platform::hardware::cache_info;
 using platform::hardware::detect_cache_info;
 
+// detect_cache_info() probed once per process (thread-safe); it may read sysfs
+inline const cache_info& cpu_cache_info() noexcept {
+    static const cache_info cached = detect_cache_info();
+    return cached;
+}
+
 // Convenience function to detect cache line size at runtime
-inline size_t detect_cache_line_size() noexcept { return detect_cache_info().l1_line_size; }
+inline size_t detect_cache_line_size() noexcept { return cpu_cache_info().l1_line_size; }
 
 // ============================================================================
 // Cache-Aligned Storage
@@ -228,6 +234,18 @@ inline void memory_barrier_acq_rel() noexcept { std::atomic_thread_fence(std::me
 // Full memory fence (both compiler and hardware)
 inline void full_barrier() noexcept { std::atomic_thread_fence(std::memory_order_seq_cst); }
 
+// Spin-wait hint for busy loops: pause on x86 (lets the sibling hyperthread
+// run and avoids the memory-order flush on loop exit), yield on AArch64
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    asm volatile("yield" ::: "memory");
+#else
+    compiler_barrier();
+#endif
+}
+
 // ============================================================================
 // Cache Control
 // ============================================================================
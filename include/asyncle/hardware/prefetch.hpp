@@ -0,0 +1,179 @@
+#ifndef ASYNCLE_HARDWARE_PREFETCH_HPP
+#define ASYNCLE_HARDWARE_PREFETCH_HPP
+
+#include "memory.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// Prefetch Distance
+// ============================================================================
+
+// Prefetches in flight beyond which a core stops gaining: L1 miss handling
+// (line fill buffers) tops out at 10-16 outstanding lines on current x86 and
+// ARM cores
+inline constexpr size_t max_prefetch_distance = 16;
+
+// Elements to prefetch ahead when each element touches bytes_per_element bytes
+// of cold memory. The lines in flight must still be in L1 when the loop
+// reaches them, so the distance is capped at a quarter of L1 worth of elements
+// and at max_prefetch_distance; at least 2 so a prefetch always overlaps work.
+inline size_t prefetch_distance_for(size_t bytes_per_element, const cache_info& cache) noexcept {
+    size_t line   = cache.l1_line_size ? cache.l1_line_size : cache_line_size;
+    size_t lines  = std::max<size_t>(1, (bytes_per_element + line - 1) / line);
+    size_t budget = cache.l1_cache_size / 4 / (lines * line);
+    return std::clamp<size_t>(budget, 2, max_prefetch_distance);
+}
+
+// Default distance for one cache line per element, from cpu_cache_info()
+inline size_t prefetch_distance() noexcept {
+    static const size_t cached = prefetch_distance_for(cache_line_size, cpu_cache_info());
+    return cached;
+}
+
+// ============================================================================
+// Prefetch Pipelines
+// ============================================================================
+
+// Run fn over every element of range while the element distance positions
+// ahead has its cold memory prefetched. address_of(element) names that memory:
+// a hash bucket, a tree node, a row behind an index.
+//
+//   for_each_prefetched(probe_keys,
+//                       [&](uint64_t key) { return &table.bucket_for(key); },
+//                       [&](uint64_t key) { matches += table.lookup(key); });
+//
+// Works for any forward range; the look-ahead iterator is advanced alongside.
+// A distance of 0 turns prefetching off (for measuring the gain).
+template <prefetch_locality Locality = prefetch_locality::high, std::ranges::forward_range Range,
+          typename AddressOf, typename Fn>
+inline void for_each_prefetched(Range&& range, AddressOf&& address_of, Fn&& fn,
+                                size_t distance = prefetch_distance()) {
+    auto it    = std::ranges::begin(range);
+    auto last  = std::ranges::end(range);
+    auto ahead = it;
+    if(distance == 0) ahead = std::ranges::next(it, last);
+    for(size_t i = 0; i < distance && ahead != last; ++i, ++ahead) prefetch_read<Locality>(address_of(*ahead));
+    for(; it != last; ++it) {
+        if(ahead != last) {
+            prefetch_read<Locality>(address_of(*ahead));
+            ++ahead;
+        }
+        fn(*it);
+    }
+}
+
+// Gather: fn(element, i) for base + indices[i] * stride (stride in bytes,
+// default sizeof(T)), prefetching the element distance indices ahead
+//
+//   prefetch_gather(row_ids, rows.data(), [&](const row& r, size_t) { total += r.amount; });
+template <prefetch_locality Locality = prefetch_locality::high, typename Index, typename T, typename Fn>
+requires std::is_integral_v<Index>
+inline void prefetch_gather(std::span<const Index> indices, T* base, Fn&& fn, size_t stride = sizeof(T),
+                            size_t distance = prefetch_distance()) {
+    using byte_type = std::conditional_t<std::is_const_v<T>, const char, char>;
+    auto element    = [&](Index index) -> T& {
+        return *reinterpret_cast<T*>(reinterpret_cast<byte_type*>(base) + static_cast<size_t>(index) * stride);
+    };
+
+    size_t n     = indices.size();
+    size_t ahead = std::min(distance, n);
+    for(size_t i = 0; i < ahead; ++i) prefetch_read<Locality>(&element(indices[i]));
+    for(size_t i = 0; i < n; ++i) {
+        if(distance && i + distance < n) prefetch_read<Locality>(&element(indices[i + distance]));
+        fn(element(indices[i]), i);
+    }
+}
+
+// Range adapter: iterating yields the elements of range unchanged while
+// prefetching address_of(element) distance positions ahead
+//
+//   for(auto& order : prefetched(orders, [](const order& o) { return o.customer; })) {
+//       credit += order.customer->limit;
+//   }
+template <std::ranges::forward_range Range, typename AddressOf,
+          prefetch_locality Locality = prefetch_locality::high>
+class prefetch_view : public std::ranges::view_interface<prefetch_view<Range, AddressOf, Locality>> {
+    using base_iterator = std::ranges::iterator_t<Range>;
+    using base_sentinel = std::ranges::sentinel_t<Range>;
+
+    Range     range_;
+    AddressOf address_of_;
+    size_t    distance_;
+
+    public:
+    class iterator {
+        base_iterator    current_;
+        base_iterator    ahead_;
+        base_sentinel    last_;
+        const AddressOf* address_of_ = nullptr;
+
+        void issue() {
+            if(ahead_ != last_) {
+                prefetch_read<Locality>((*address_of_)(*ahead_));
+                ++ahead_;
+            }
+        }
+
+        public:
+        using value_type      = std::iter_value_t<base_iterator>;
+        using difference_type = std::iter_difference_t<base_iterator>;
+
+        iterator() = default;
+
+        iterator(base_iterator first, base_sentinel last, const AddressOf& address_of, size_t distance):
+            current_(first),
+            ahead_(first),
+            last_(last),
+            address_of_(&address_of) {
+            if(distance == 0) ahead_ = std::ranges::next(first, last);
+            for(size_t i = 0; i < distance; ++i) issue();
+        }
+
+        decltype(auto) operator*() const { return *current_; }
+
+        iterator& operator++() {
+            issue();
+            ++current_;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.current_ == b.current_; }
+
+        friend bool operator==(const iterator& a, std::default_sentinel_t) { return a.current_ == a.last_; }
+    };
+
+    prefetch_view(Range range, AddressOf address_of, size_t distance):
+        range_(std::move(range)),
+        address_of_(std::move(address_of)),
+        distance_(distance) {}
+
+    iterator begin() { return iterator(std::ranges::begin(range_), std::ranges::end(range_), address_of_, distance_); }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+template <std::ranges::viewable_range Range, typename AddressOf>
+inline auto prefetched(Range&& range, AddressOf address_of, size_t distance = prefetch_distance()) {
+    using view = std::views::all_t<Range>;
+    return prefetch_view<view, AddressOf>(std::views::all(std::forward<Range>(range)), std::move(address_of),
+                                          distance);
+}
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_PREFETCH_HPP
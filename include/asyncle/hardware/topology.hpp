@@ -0,0 +1,189 @@
+#ifndef ASYNCLE_HARDWARE_TOPOLOGY_HPP
+#define ASYNCLE_HARDWARE_TOPOLOGY_HPP
+
+#include "../../platform/hardware.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace asyncle::hardware {
+
+// ============================================================================
+// CPU Topology and NUMA (Platform-specific)
+// ============================================================================
+
+// Import topology detection from platform layer
+using platform::hardware::cpu_location;
+using platform::hardware::detect_cpu_topology;
+using platform::hardware::detect_numa_nodes;
+using platform::hardware::numa_distance;
+using platform::hardware::numa_node_info;
+
+// Snapshot of sockets, NUMA nodes, cores, SMT siblings and cache sharing
+//
+//   const auto& topo = cpu_topology::current();
+//   for(uint32_t node : topo.node_ids()) {
+//       auto cpus = topo.cpus_on_node(node);   // Pin this node's workers here
+//       ...
+//   }
+//
+// Read once with detect() (a few hundred sysfs reads on Linux) or use the
+// process-wide current(); CPU hotplug after the snapshot is not tracked.
+class cpu_topology {
+    std::vector<cpu_location>   cpus_;   // Ascending OS CPU number
+    std::vector<numa_node_info> nodes_;  // Ascending node number
+    std::vector<uint32_t>       distance_;
+    size_t                      packages_ = 0;
+    size_t                      cores_    = 0;
+
+    template <typename Pred>
+    std::vector<uint32_t> select(Pred&& pred) const {
+        std::vector<uint32_t> out;
+        for(const auto& loc : cpus_) {
+            if(pred(loc)) out.push_back(loc.cpu);
+        }
+        return out;
+    }
+
+    public:
+    cpu_topology() = default;
+
+    static cpu_topology detect() {
+        cpu_topology topo;
+
+        size_t count = detect_cpu_topology(nullptr, 0);
+        topo.cpus_.resize(count);
+        topo.cpus_.resize(std::min(count, detect_cpu_topology(topo.cpus_.data(), count)));
+
+        count = detect_numa_nodes(nullptr, 0);
+        topo.nodes_.resize(count);
+        topo.nodes_.resize(std::min(count, detect_numa_nodes(topo.nodes_.data(), count)));
+        if(topo.nodes_.empty()) {
+            topo.nodes_.push_back(numa_node_info { 0, static_cast<uint32_t>(topo.cpus_.size()), 0, 0 });
+        }
+
+        size_t n = topo.nodes_.size();
+        topo.distance_.resize(n * n);
+        for(size_t from = 0; from < n; ++from) {
+            for(size_t to = 0; to < n; ++to) {
+                uint32_t d = numa_distance(topo.nodes_[from].node, topo.nodes_[to].node);
+                topo.distance_[from * n + to] = d ? d : (from == to ? 10 : 20);
+            }
+        }
+
+        for(const auto& loc : topo.cpus_) {
+            topo.packages_ = std::max<size_t>(topo.packages_, loc.package + 1);
+            topo.cores_    = std::max<size_t>(topo.cores_, loc.core + 1);
+        }
+        return topo;
+    }
+
+    // Detected once per process on first use
+    static const cpu_topology& current() {
+        static const cpu_topology cached = detect();
+        return cached;
+    }
+
+    // Accessors
+    std::span<const cpu_location> cpus() const noexcept { return cpus_; }
+
+    std::span<const numa_node_info> nodes() const noexcept { return nodes_; }
+
+    size_t cpu_count() const noexcept { return cpus_.size(); }
+
+    size_t core_count() const noexcept { return cores_; }
+
+    size_t package_count() const noexcept { return packages_; }
+
+    size_t node_count() const noexcept { return nodes_.size(); }
+
+    bool is_numa() const noexcept { return nodes_.size() > 1; }
+
+    // Location of an OS CPU number, nullptr if not online
+    const cpu_location* find(uint32_t cpu) const noexcept {
+        auto it = std::lower_bound(cpus_.begin(), cpus_.end(), cpu,
+                                   [](const cpu_location& loc, uint32_t id) { return loc.cpu < id; });
+        return it != cpus_.end() && it->cpu == cpu ? &*it : nullptr;
+    }
+
+    const numa_node_info* find_node(uint32_t node) const noexcept {
+        for(const auto& info : nodes_) {
+            if(info.node == node) return &info;
+        }
+        return nullptr;
+    }
+
+    // NUMA node of a CPU (0 if unknown)
+    uint32_t node_of(uint32_t cpu) const noexcept {
+        const cpu_location* loc = find(cpu);
+        return loc ? loc->node : 0;
+    }
+
+    std::vector<uint32_t> node_ids() const {
+        std::vector<uint32_t> out;
+        for(const auto& info : nodes_) out.push_back(info.node);
+        return out;
+    }
+
+    // Relative memory access cost between nodes (10 = local)
+    uint32_t distance(uint32_t from_node, uint32_t to_node) const noexcept {
+        size_t n = nodes_.size(), from = n, to = n;
+        for(size_t i = 0; i < n; ++i) {
+            if(nodes_[i].node == from_node) from = i;
+            if(nodes_[i].node == to_node) to = i;
+        }
+        return from < n && to < n ? distance_[from * n + to] : 0;
+    }
+
+    // CPU sets, as OS CPU numbers; allowed_only drops CPUs outside the affinity mask
+    std::vector<uint32_t> cpus_on_node(uint32_t node, bool allowed_only = true) const {
+        return select([&](const cpu_location& loc) { return loc.node == node && (loc.allowed || !allowed_only); });
+    }
+
+    std::vector<uint32_t> cpus_on_package(uint32_t package, bool allowed_only = true) const {
+        return select(
+          [&](const cpu_location& loc) { return loc.package == package && (loc.allowed || !allowed_only); });
+    }
+
+    // Hardware threads of cpu's physical core, cpu included
+    std::vector<uint32_t> smt_siblings(uint32_t cpu) const {
+        const cpu_location* self = find(cpu);
+        if(!self) return {};
+        return select([&](const cpu_location& loc) { return loc.core == self->core; });
+    }
+
+    std::vector<uint32_t> sharing_l2(uint32_t cpu) const {
+        const cpu_location* self = find(cpu);
+        if(!self) return {};
+        return select([&](const cpu_location& loc) { return loc.l2_domain == self->l2_domain; });
+    }
+
+    std::vector<uint32_t> sharing_l3(uint32_t cpu) const {
+        const cpu_location* self = find(cpu);
+        if(!self) return {};
+        return select([&](const cpu_location& loc) { return loc.l3_domain == self->l3_domain; });
+    }
+
+    // Allowed CPUs ordered for spreading workers: node by node, and within a node
+    // one hardware thread per physical core before any SMT sibling
+    std::vector<uint32_t> placement_order() const {
+        std::vector<const cpu_location*> order;
+        for(const auto& loc : cpus_) {
+            if(loc.allowed) order.push_back(&loc);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const cpu_location* a, const cpu_location* b) {
+            if(a->node != b->node) return a->node < b->node;
+            return a->smt_index < b->smt_index;
+        });
+        std::vector<uint32_t> out;
+        out.reserve(order.size());
+        for(const auto* loc : order) out.push_back(loc->cpu);
+        return out;
+    }
+};
+
+}  // namespace asyncle::hardware
+
+#endif  // ASYNCLE_HARDWARE_TOPOLOGY_HPP
@@ -0,0 +1,238 @@
+#ifndef ASYNCLE_INSTRUMENT_HPP
+#define ASYNCLE_INSTRUMENT_HPP
+
+// asyncle::instrument - Hot-path metrics for asyncle::io and asyncle::format
+//
+// Per operation kind: calls, failures, bytes moved and a latency histogram in
+// nanoseconds. Built in when ASYNCLE_ENABLE_INSTRUMENTATION is defined (CMake
+// option of the same name); otherwise scope is an empty type with no-op
+// members, every hook compiles to nothing and snapshots read as zero.
+//
+// The macro changes the bodies of inline functions in io and format headers,
+// so every translation unit of a program must agree on it - set it through
+// the CMake option rather than per file.
+//
+// Usage:
+//   for(const auto& op : asyncle::instrument::snapshot_all()) {
+//       log(op.name, op.calls, op.bytes, op.latency.percentile(0.99));
+//   }
+//   std::fputs(asyncle::instrument::report().c_str(), stderr);
+
+#include "concurrent/histogram.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#if defined(ASYNCLE_ENABLE_INSTRUMENTATION)
+#include "concurrent/sharded.hpp"
+#include "hardware/clock.hpp"
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace asyncle::instrument {
+
+// Instrumented operations
+enum class op : uint8_t {
+    file_read      = 0,  // file::read / readv; bytes transferred
+    file_write     = 1,  // file::write / writev; bytes transferred
+    mmap_map       = 2,  // mmap::map and mapping constructors; bytes mapped (includes MAP_POPULATE)
+    mmap_fault     = 3,  // mmap::prefetch / lock: explicit fault-in; bytes requested
+    process_spawn  = 4,  // process::spawn and spawning constructors
+    json_parse     = 5,  // JSON parse and load; input bytes
+    json_serialize = 6   // JSON save / save_into; output bytes
+};
+
+inline constexpr size_t op_count = 7;
+
+constexpr std::string_view op_name(op kind) noexcept {
+    switch(kind) {
+    case op::file_read     : return "file.read";
+    case op::file_write    : return "file.write";
+    case op::mmap_map      : return "mmap.map";
+    case op::mmap_fault    : return "mmap.fault";
+    case op::process_spawn : return "process.spawn";
+    case op::json_parse    : return "json.parse";
+    case op::json_serialize: return "json.serialize";
+    }
+    return "unknown";
+}
+
+#if defined(ASYNCLE_ENABLE_INSTRUMENTATION)
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+// Totals for one operation kind since start-up or the last reset()
+struct op_snapshot {
+    op                             kind   = op::file_read;
+    std::string_view               name   = op_name(op::file_read);
+    uint64_t                       calls  = 0;  // Successful and failed
+    uint64_t                       errors = 0;
+    uint64_t                       bytes  = 0;
+    concurrent::histogram_snapshot latency;  // Nanoseconds per call
+};
+
+// Process-wide page faults from getrusage (zero where unavailable). Demand
+// faults on mapped memory happen on access, outside any library call, so
+// they are counted here rather than under op::mmap_fault.
+struct fault_counts {
+    uint64_t minor = 0;  // Served from the page cache or zero pages
+    uint64_t major = 0;  // Needed I/O
+};
+
+inline fault_counts page_faults() noexcept {
+    fault_counts out;
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage {};
+    if(getrusage(RUSAGE_SELF, &usage) == 0) {
+        out.minor = static_cast<uint64_t>(usage.ru_minflt);
+        out.major = static_cast<uint64_t>(usage.ru_majflt);
+    }
+#endif
+    return out;
+}
+
+#if defined(ASYNCLE_ENABLE_INSTRUMENTATION)
+
+namespace detail {
+
+// Shard by CPU, capped: every op carries a ~8 KiB-per-shard histogram
+inline size_t metric_shards() noexcept { return std::min<size_t>(concurrent::detail::default_shard_count(), 64); }
+
+struct op_metrics {
+    concurrent::sharded_counter   errors { concurrent::shard_by::cpu, metric_shards() };
+    concurrent::sharded_counter   bytes { concurrent::shard_by::cpu, metric_shards() };
+    concurrent::sharded_histogram latency { concurrent::shard_by::cpu, metric_shards() };
+};
+
+// Allocated on first use, never destroyed (hooks may run from static destructors)
+inline op_metrics& metrics(op kind) noexcept {
+    static op_metrics* const all = new op_metrics[op_count];
+    return all[static_cast<size_t>(kind)];
+}
+
+}  // namespace detail
+
+// Record one completed operation; the hooks go through scope, this is for
+// operations timed elsewhere
+inline void record(op kind, uint64_t nanoseconds, uint64_t bytes = 0, bool ok = true) noexcept {
+    auto& m = detail::metrics(kind);
+    m.latency.record(nanoseconds);
+    if(bytes) m.bytes.add(static_cast<int64_t>(bytes));
+    if(!ok) m.errors.add();
+}
+
+inline op_snapshot snapshot(op kind) {
+    auto&       m = detail::metrics(kind);
+    op_snapshot out;
+    out.kind    = kind;
+    out.name    = op_name(kind);
+    out.latency = m.latency.snapshot();
+    out.calls   = out.latency.count;
+    out.errors  = static_cast<uint64_t>(m.errors.value());
+    out.bytes   = static_cast<uint64_t>(m.bytes.value());
+    return out;
+}
+
+inline void reset() noexcept {
+    for(size_t i = 0; i < op_count; ++i) {
+        auto& m = detail::metrics(static_cast<op>(i));
+        m.errors.reset();
+        m.bytes.reset();
+        m.latency.reset();
+    }
+}
+
+// Times one operation from construction to destruction with
+// hardware::cycle_clock. An operation that never reaches done() (early
+// return, exception) counts as failed.
+//
+//   instrument::scope timed(instrument::op::file_read);
+//   auto result = platform::file::read_file(handle_, request);
+//   timed.done(result.has_value(), result ? result->bytes_transferred : 0);
+class scope {
+    using clock = hardware::cycle_clock;
+
+    uint64_t start_;
+    uint64_t bytes_ = 0;
+    op       kind_;
+    bool     ok_ = false;
+
+    public:
+    explicit scope(op kind) noexcept: start_(clock::ticks()), kind_(kind) {}
+
+    ~scope() { record(kind_, clock::to_nanoseconds(clock::ticks() - start_), bytes_, ok_); }
+
+    scope(const scope&)            = delete;
+    scope& operator=(const scope&) = delete;
+
+    void done(bool ok, uint64_t bytes = 0) noexcept {
+        ok_    = ok;
+        bytes_ = bytes;
+    }
+};
+
+#else
+
+inline void record(op, uint64_t, uint64_t = 0, bool = true) noexcept {}
+
+inline op_snapshot snapshot(op kind) {
+    op_snapshot out;
+    out.kind = kind;
+    out.name = op_name(kind);
+    return out;
+}
+
+inline void reset() noexcept {}
+
+class scope {
+    public:
+    explicit constexpr scope(op) noexcept {}
+
+    scope(const scope&)            = delete;
+    scope& operator=(const scope&) = delete;
+
+    constexpr void done(bool, uint64_t = 0) noexcept {}
+};
+
+#endif
+
+inline std::array<op_snapshot, op_count> snapshot_all() {
+    std::array<op_snapshot, op_count> out;
+    for(size_t i = 0; i < op_count; ++i) out[i] = snapshot(static_cast<op>(i));
+    return out;
+}
+
+// One line per operation that ran, plus page faults: a quick text dump for
+// logs and debug endpoints
+inline std::string report() {
+    std::string out;
+    char        line[256];
+    for(const auto& s : snapshot_all()) {
+        if(s.calls == 0) continue;
+        std::snprintf(
+          line, sizeof(line), "%-15.*s calls=%llu errors=%llu bytes=%llu p50=%lluns p99=%lluns max=%lluns\n",
+          static_cast<int>(s.name.size()), s.name.data(), static_cast<unsigned long long>(s.calls),
+          static_cast<unsigned long long>(s.errors), static_cast<unsigned long long>(s.bytes),
+          static_cast<unsigned long long>(s.latency.percentile(0.5)),
+          static_cast<unsigned long long>(s.latency.percentile(0.99)),
+          static_cast<unsigned long long>(s.latency.max()));
+        out += line;
+    }
+    fault_counts faults = page_faults();
+    std::snprintf(line, sizeof(line), "%-15s minor=%llu major=%llu\n", "page.faults",
+                  static_cast<unsigned long long>(faults.minor), static_cast<unsigned long long>(faults.major));
+    out += line;
+    return out;
+}
+
+}  // namespace asyncle::instrument
+
+#endif  // ASYNCLE_INSTRUMENT_HPP
@@ -0,0 +1,193 @@
+#ifndef ASYNCLE_IO_ARENA_HPP
+#define ASYNCLE_IO_ARENA_HPP
+
+#include "../../platform/mmap.hpp"
+#include "../hardware/memory.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace asyncle::io {
+
+// Monotonic bump allocator over one large anonymous mapping.
+// The whole range is reserved up front with lazy commit, so only pages that are
+// actually touched cost memory. Allocations bump an offset (cache-line aligned by
+// default) and are never freed individually; reset() rewinds to the start in O(1)
+// and keeps the touched pages for the next round, trim() hands them back.
+// Not thread-safe: use one arena per thread or per request.
+class arena {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = memory_error;
+    template <typename T>
+    using result_type = mmap_result<T>;
+
+    static constexpr size_t default_reserve   = size_t { 1 } << 30;  // 1 GiB of address space
+    static constexpr size_t default_alignment = hardware::cache_line_size;
+
+    private:
+    mmap   slab_;
+    size_t offset_     = 0;
+    size_t high_water_ = 0;  // Furthest offset handed out since the last trim()
+
+    public:
+    // Constructors
+    arena() noexcept = default;
+
+    explicit arena(
+      size_t                       reserve_bytes,
+      mmap_access::page_preference pages = mmap_access::page_preference::system_default) noexcept {
+        reserve(reserve_bytes, pages);
+    }
+
+    // Move semantics
+    arena(arena&& other) noexcept:
+        slab_(std::move(other.slab_)),
+        offset_(std::exchange(other.offset_, 0)),
+        high_water_(std::exchange(other.high_water_, 0)) {}
+
+    arena& operator=(arena&& other) noexcept {
+        if(this != &other) {
+            slab_       = std::move(other.slab_);
+            offset_     = std::exchange(other.offset_, 0);
+            high_water_ = std::exchange(other.high_water_, 0);
+        }
+        return *this;
+    }
+
+    // No copy
+    arena(const arena&)            = delete;
+    arena& operator=(const arena&) = delete;
+
+    // Core operations
+    // Reserve address space; nothing is committed until first touched
+    mmap_result<memory_region> reserve(
+      size_t                       reserve_bytes = default_reserve,
+      mmap_access::page_preference pages         = mmap_access::page_preference::system_default) noexcept {
+        slab_.unmap();
+        offset_     = 0;
+        high_water_ = 0;
+        if(reserve_bytes == 0) {
+            return mmap_result<memory_region>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+
+        memory_request req {};
+        req.length    = mmap::align_to_page(reserve_bytes);
+        req.backing   = backing_type::anonymous;
+        req.access    = mmap_access::access_mode::read_write;
+        req.sharing   = sharing_mode::private_cow;
+        req.page_pref = pages;
+        req.commit    = mmap_access::commit_strategy::lazy_commit;
+        req.populate  = mmap_access::populate_strategy::none;
+        return slab_.map(req, -1);
+    }
+
+    // Bump-allocate bytes at the given power-of-two alignment; nullptr when exhausted
+    void* allocate(size_t bytes, size_t alignment = default_alignment) noexcept {
+        if(!slab_.is_mapped()) return nullptr;
+        auto   base    = reinterpret_cast<uintptr_t>(slab_.data());
+        size_t aligned = ((base + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - base;
+        if(aligned > slab_.size() || bytes > slab_.size() - aligned) return nullptr;
+
+        offset_ = aligned + bytes;
+        if(offset_ > high_water_) high_water_ = offset_;
+        return reinterpret_cast<void*>(base + aligned);
+    }
+
+    // Uninitialized storage for count objects of T
+    template <typename T>
+    T* allocate_array(size_t count, size_t alignment = alignof(T)) noexcept {
+        if(count > slab_.size() / sizeof(T)) return nullptr;
+        return static_cast<T*>(allocate(count * sizeof(T), alignment < alignof(T) ? alignof(T) : alignment));
+    }
+
+    // Construct a T in the arena; its destructor is never run, so T should be trivially destructible
+    template <typename T, typename... Args>
+    T* create(Args&&... args) noexcept {
+        void* storage = allocate(sizeof(T), alignof(T) > default_alignment ? alignof(T) : default_alignment);
+        if(!storage) return nullptr;
+        return ::new(storage) T(std::forward<Args>(args)...);
+    }
+
+    // Rewind to the start in O(1); touched pages stay committed for reuse
+    void reset() noexcept { offset_ = 0; }
+
+    // Scoped rollback: everything allocated after mark() is released by rewind()
+    size_t mark() const noexcept { return offset_; }
+
+    void rewind(size_t marker) noexcept {
+        if(marker <= offset_) offset_ = marker;
+    }
+
+    // Return committed pages past max(used, keep_bytes) to the kernel (MADV_DONTNEED)
+    mmap_void_result trim(size_t keep_bytes = 0) noexcept {
+        if(!slab_.is_mapped()) return mmap_void_result();
+        size_t keep = mmap::align_to_page(keep_bytes > offset_ ? keep_bytes : offset_);
+        if(keep >= high_water_ || keep >= slab_.size()) return mmap_void_result();
+
+        size_t end    = mmap::align_to_page(high_water_);
+        auto   result = platform::mmap::discard_memory(slab_.region(), keep, end - keep);
+        if(result) high_water_ = offset_;
+        return result;
+    }
+
+    // Accessors
+    size_t used() const noexcept { return offset_; }
+
+    size_t capacity() const noexcept { return slab_.size(); }
+
+    size_t remaining() const noexcept { return slab_.size() - offset_; }
+
+    size_t high_water() const noexcept { return high_water_; }
+
+    bool owns(const void* ptr) const noexcept {
+        auto p    = reinterpret_cast<uintptr_t>(ptr);
+        auto base = reinterpret_cast<uintptr_t>(slab_.data());
+        return slab_.is_mapped() && p >= base && p < base + slab_.size();
+    }
+
+    const memory_region& region() const noexcept { return slab_.region(); }
+
+    bool is_valid() const noexcept { return slab_.is_mapped(); }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+// std::pmr adapter so pmr containers allocate from an arena.
+// Deallocation is a no-op; memory comes back on arena::reset(). Allocation failure
+// throws std::bad_alloc as memory_resource requires. Honors the caller's alignment
+// (at least min_alignment) instead of forcing cache-line alignment on every node.
+class arena_resource: public std::pmr::memory_resource {
+    arena* arena_;
+    size_t min_alignment_;
+
+    public:
+    explicit arena_resource(arena& a, size_t min_alignment = alignof(std::max_align_t)) noexcept:
+        arena_(&a),
+        min_alignment_(min_alignment) {}
+
+    arena& upstream() const noexcept { return *arena_; }
+
+    private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = arena_->allocate(bytes, alignment > min_alignment_ ? alignment : min_alignment_);
+        if(!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) noexcept override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        auto* o = dynamic_cast<const arena_resource*>(&other);
+        return o && o->arena_ == arena_;
+    }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_ARENA_HPP
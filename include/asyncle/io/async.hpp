@@ -0,0 +1,486 @@
+#ifndef ASYNCLE_IO_ASYNC_HPP
+#define ASYNCLE_IO_ASYNC_HPP
+
+#include "../../platform/process.hpp"
+#include "../async/task.hpp"
+#include "../async/work.hpp"
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "commands.hpp"
+#include "file.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include "ring.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+// ============================================================================
+// Driver Machinery
+// ============================================================================
+
+namespace detail {
+
+// Coroutines handed to a driver from other threads and resumed on the
+// driver's own thread. signal() moves on every post, so an idle driver can
+// sleep on it.
+class posted_queue {
+    std::mutex                           mutex_;
+    std::vector<std::coroutine_handle<>> queue_;
+    std::vector<std::coroutine_handle<>> running_;
+    std::atomic<uint64_t>                signal_ { 0 };
+    std::atomic<size_t>                  size_ { 0 };
+
+    public:
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back(handle);
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake();
+    }
+
+    void wake() noexcept {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    // Resume everything posted so far; returns how many
+    size_t run() {
+        if(size_.load(std::memory_order_relaxed) == 0) return 0;
+        {
+            std::lock_guard lock(mutex_);
+            running_.swap(queue_);
+            size_.store(0, std::memory_order_relaxed);
+        }
+        for(auto handle : running_) handle.resume();
+        size_t count = running_.size();
+        running_.clear();
+        return count;
+    }
+
+    uint64_t signal() const noexcept { return signal_.load(std::memory_order_acquire); }
+
+    void wait(uint64_t seen) const noexcept { signal_.wait(seen, std::memory_order_acquire); }
+
+    bool empty() const noexcept { return size_.load(std::memory_order_relaxed) == 0; }
+};
+
+// co_await driver.schedule(): continue on the driver's thread
+class post_awaiter {
+    posted_queue& queue_;
+
+    public:
+    explicit post_awaiter(posted_queue& queue) noexcept: queue_(queue) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) { queue_.post(awaiting); }
+
+    void await_resume() const noexcept {}
+};
+
+// Run a on the calling thread, calling driver.step(block) until it finishes.
+// step(true) may sleep in the driver's native wait when it has operations in
+// flight; otherwise the driver sleeps on the posted queue.
+template <typename Driver, typename A>
+async::await_result_t<A> drive(Driver& driver, posted_queue& posted, A&& a) {
+    struct state {
+        posted_queue*     posted;
+        std::atomic<bool> done { false };
+    } st { &posted };
+
+    async::detail::awaited_slot<A> slot;
+    async::detail::notifying_task  body = async::detail::await_into(std::forward<A>(a), slot);
+    body.handle.promise().context       = &st;
+    body.handle.promise().notify        = [](void* p) noexcept {
+        auto* s = static_cast<state*>(p);
+        s->done.store(true, std::memory_order_release);
+        s->posted->wake();
+    };
+
+    body.handle.resume();
+    while(!st.done.load(std::memory_order_acquire)) {
+        uint64_t seen = posted.signal();
+        if(posted.run() != 0) continue;
+        if(st.done.load(std::memory_order_acquire)) break;
+        if(driver.in_flight() != 0) {
+            driver.step(true);
+        } else {
+            posted.wait(seen);
+        }
+    }
+    body.handle.destroy();
+    return slot.take();
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Ring Scheduler
+// ============================================================================
+
+// Completes file reads and writes through one io_ring. Awaiting read() or
+// write() queues the request and suspends; nothing reaches the kernel until
+// the driving thread polls, so every operation started since the last poll
+// goes out in a single submit. Completions resume their coroutines on the
+// polling thread.
+//
+//   ring_scheduler ring(256);
+//   task<size_t> copy(ring_scheduler& ring, file& in, file& out) {
+//       auto got = co_await ring.read(in, request);                 // Or async_work(ring, in, read_command {}, request)
+//       ...
+//   }
+//   auto copied = ring.run(copy(ring, in, out));
+//
+// The ring is confined to the driving thread: a coroutine that moved to a
+// pool with async::schedule or offload comes back with co_await
+// ring.schedule() before its next ring operation. Posted coroutines are
+// resumed as soon as the ring is idle, or after the next completion while
+// file operations are in flight; event_loop (event_loop.hpp) wakes on them
+// immediately and adds pipes and timers to the same wait.
+class ring_scheduler {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    // Completions reaped per poll at most
+    static constexpr size_t reap_batch = 64;
+
+    private:
+    struct operation {
+        std::coroutine_handle<> handle;
+        io_completion           completion;
+    };
+
+    io_ring              ring_;
+    size_t               in_flight_ = 0;
+    detail::posted_queue posted_;
+
+    file_void_result queue(const file_handle& f, ring_op op, const io_request& request, operation* state) noexcept {
+        auto data = reinterpret_cast<uint64_t>(state);
+        for(int attempt = 0; attempt < 2; ++attempt) {
+            auto queued = ring_.queue(f, op, &request, 1, data);
+            if(!queued) return file_void_result(unexpect, queued.error());
+            if(queued.value() == 1) {
+                ++in_flight_;
+                return file_void_result();
+            }
+            // Submission queue full: hand what is there to the kernel and retry
+            auto submitted = ring_.submit();
+            if(!submitted) return file_void_result(unexpect, submitted.error());
+        }
+        return file_void_result(unexpect, file_error(error_code::would_block));
+    }
+
+    public:
+    class io_awaiter {
+        ring_scheduler&    ring_;
+        const file_handle& file_;
+        ring_op            op_;
+        io_request         request_;
+        operation          state_ {};
+
+        public:
+        io_awaiter(ring_scheduler& ring, const file_handle& f, ring_op op, const io_request& request) noexcept:
+            ring_(ring),
+            file_(f),
+            op_(op),
+            request_(request) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            state_.handle = awaiting;
+            auto queued   = ring_.queue(file_, op_, request_, &state_);
+            if(queued) return true;
+            state_.completion.error = queued.error();
+            return false;
+        }
+
+        file_result<io_result> await_resume() const noexcept {
+            if(state_.completion.error.code != error_code::success) {
+                return file_result<io_result>(unexpect, state_.completion.error);
+            }
+            return file_result<io_result>(state_.completion.result);
+        }
+    };
+
+    // Constructors
+    explicit ring_scheduler(uint32_t entries = 256) noexcept: ring_(entries) {}
+
+    explicit ring_scheduler(const ring_request& request) noexcept: ring_(request) {}
+
+    ring_scheduler(const ring_scheduler&)            = delete;
+    ring_scheduler& operator=(const ring_scheduler&) = delete;
+
+    // Awaitable operations; the file must stay open until the await finishes
+    io_awaiter read(const file& f, const io_request& request) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::read, request);
+    }
+
+    io_awaiter write(file& f, const io_request& request) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::write, request);
+    }
+
+    io_awaiter sync(file& f, sync_flags flags = sync_flags::full_sync) noexcept {
+        io_request request {};
+        request.flags = static_cast<uint32_t>(flags);
+        return io_awaiter(*this, f.handle(), ring_op::sync, request);
+    }
+
+    // Continue on the driving thread (thread-safe)
+    detail::post_awaiter schedule() noexcept { return detail::post_awaiter(posted_); }
+
+    // Submit queued requests and resume the coroutines whose operations
+    // completed; block for at least one completion when block is set and
+    // something is in flight. Returns the number of coroutines resumed.
+    size_t step(bool block = false) {
+        if(in_flight_ == 0) return 0;
+        if(!ring_.submit()) return 0;
+
+        io_completion completions[reap_batch];
+        auto          reaped = ring_.complete(completions, reap_batch, block ? 1 : 0);
+        if(!reaped) return 0;
+        for(size_t i = 0; i < reaped.value(); ++i) {
+            auto* state       = reinterpret_cast<operation*>(completions[i].user_data);
+            state->completion = completions[i];
+            --in_flight_;
+        }
+        // Resume only after bookkeeping, since a resumed coroutine may queue more
+        for(size_t i = 0; i < reaped.value(); ++i) reinterpret_cast<operation*>(completions[i].user_data)->handle.resume();
+        return reaped.value();
+    }
+
+    // Non-blocking step plus posted coroutines
+    size_t poll() { return posted_.run() + step(false); }
+
+    // Drive a (typically a task) on this thread until it finishes
+    template <typename A>
+    requires async::awaitable<A>
+    async::await_result_t<A> run(A&& a) {
+        return detail::drive(*this, posted_, std::forward<A>(a));
+    }
+
+    // State queries
+    size_t in_flight() const noexcept { return in_flight_; }
+
+    bool is_open() const noexcept { return ring_.is_open(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    io_ring& ring() noexcept { return ring_; }
+
+    // CPO integration: async_work(ring, file, read_command/write_command, request)
+    friend io_awaiter tag_invoke(async::async_work_t, ring_scheduler& ring, file& f, read_command,
+                                 const io_request& request) noexcept {
+        return ring.read(f, request);
+    }
+
+    friend io_awaiter tag_invoke(async::async_work_t, ring_scheduler& ring, file& f, write_command,
+                                 const io_request& request) noexcept {
+        return ring.write(f, request);
+    }
+};
+
+// ============================================================================
+// Pipe Scheduler
+// ============================================================================
+
+// Waits for child process pipes through a readiness multiplexer (epoll on
+// Linux). Each await arms its descriptor once (oneshot), so pipes nobody is
+// waiting on never wake the driver. Resumes coroutines on the thread that
+// drives it, like ring_scheduler.
+//
+//   pipe_scheduler pipes;
+//   task<size_t> collect(pipe_scheduler& pipes, process& child, std::string& out) {
+//       char buffer[4096];
+//       for(;;) {
+//           process::io_request req {};
+//           req.buffer = buffer;
+//           req.length = sizeof(buffer);
+//           auto got   = co_await async_work(pipes, child, pipe_read_command {}, req);
+//           if(!got || got->bytes_transferred == 0) break;                 // Error or EOF
+//           out.append(buffer, got->bytes_transferred);
+//       }
+//       co_return out.size();
+//   }
+//
+// Reads and writes retry on would_block, so they complete with data, EOF
+// (0 bytes) or a real error. exited(child) completes once the child has
+// exited; process::wait() then returns without blocking.
+class pipe_scheduler {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = process_error;
+    template <typename T>
+    using result_type = process_result<T>;
+
+    // Events handled per step at most
+    static constexpr size_t max_batch = 64;
+
+    private:
+    using reactor_events = platform::process::reactor_events;
+
+    struct operation {
+        std::coroutine_handle<> handle;
+        reactor_events          events = reactor_events::none;
+    };
+
+    platform::process::reactor_handle handle_;
+    size_t                            in_flight_ = 0;
+    detail::posted_queue              posted_;
+
+    process_void_result arm(int32_t fd, reactor_events interest, operation* state) noexcept {
+        auto token = reinterpret_cast<uint64_t>(state);
+        interest   = interest | reactor_events::oneshot;
+        // Re-arm a descriptor registered by an earlier await, else register it
+        auto armed = platform::process::reactor_modify(handle_, fd, token, interest);
+        if(!armed) armed = platform::process::reactor_add(handle_, fd, token, interest);
+        if(armed) ++in_flight_;
+        return armed;
+    }
+
+    public:
+    class ready_awaiter {
+        pipe_scheduler& pipes_;
+        int32_t         fd_;
+        reactor_events  interest_;
+        operation       state_ {};
+        process_error   error_ {};
+
+        public:
+        ready_awaiter(pipe_scheduler& pipes, int32_t fd, reactor_events interest) noexcept:
+            pipes_(pipes),
+            fd_(fd),
+            interest_(interest) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            state_.handle = awaiting;
+            auto armed    = pipes_.arm(fd_, interest_, &state_);
+            if(armed) return true;
+            error_ = armed.error();
+            return false;
+        }
+
+        // True when ready, false on hangup or an error condition with nothing to read
+        process_result<bool> await_resume() const noexcept {
+            if(error_.code != process::error_code::success) return process_result<bool>(unexpect, error_);
+            return process_result<bool>(platform::process::has_event(state_.events, interest_));
+        }
+    };
+
+    // Constructors
+    pipe_scheduler() noexcept {
+        auto created = platform::process::create_reactor();
+        if(created) handle_ = created.value();
+    }
+
+    ~pipe_scheduler() { platform::process::destroy_reactor(handle_); }
+
+    pipe_scheduler(const pipe_scheduler&)            = delete;
+    pipe_scheduler& operator=(const pipe_scheduler&) = delete;
+
+    // Readiness of one pipe; the pipe must stay open until the await finishes
+    ready_awaiter readable(const pipe_handle& pipe) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::readable);
+    }
+
+    ready_awaiter writable(const pipe_handle& pipe) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::writable);
+    }
+
+    // Read child's stdout, waiting while the pipe is empty; 0 bytes at EOF
+    async::task<process_result<process::io_result>> read(process& child, process::io_request request) {
+        for(;;) {
+            auto got = child.read_stdout(request);
+            if(got || got.error().code != process::error_code::would_block) co_return got;
+            auto ready = co_await readable(child.stdout_pipe());
+            if(!ready) co_return process_result<process::io_result>(unexpect, ready.error());
+        }
+    }
+
+    // Write to child's stdin, waiting while the pipe is full
+    async::task<process_result<process::io_result>> write(process& child, process::io_request request) {
+        for(;;) {
+            auto put = child.write_stdin(request);
+            if(put || put.error().code != process::error_code::would_block) co_return put;
+            auto ready = co_await writable(child.stdin_pipe());
+            if(!ready) co_return process_result<process::io_result>(unexpect, ready.error());
+        }
+    }
+
+    // Complete once child has exited
+    async::task<process_void_result> exited(const process& child) {
+        auto exit = platform::process::open_exit_handle(child.handle());
+        if(!exit) co_return process_void_result(unexpect, exit.error());
+        pipe_handle handle = exit.value();
+        auto        ready  = co_await readable(handle);
+        platform::process::reactor_remove(handle_, handle.fd);
+        platform::process::close_pipe(handle);
+        if(!ready) co_return process_void_result(unexpect, ready.error());
+        co_return process_void_result();
+    }
+
+    // Continue on the driving thread (thread-safe)
+    detail::post_awaiter schedule() noexcept { return detail::post_awaiter(posted_); }
+
+    // Wait for readiness (blocking when block is set and something is armed)
+    // and resume the ready coroutines; returns how many were resumed
+    size_t step(bool block = false) {
+        if(in_flight_ == 0) return 0;
+        platform::process::reactor_event events[max_batch];
+        auto ready = platform::process::reactor_wait(handle_, events, max_batch, block ? -1 : 0);
+        if(!ready) return 0;
+        for(size_t i = 0; i < ready.value(); ++i) {
+            auto* state   = reinterpret_cast<operation*>(events[i].token);
+            state->events = events[i].events;
+            --in_flight_;
+        }
+        for(size_t i = 0; i < ready.value(); ++i) reinterpret_cast<operation*>(events[i].token)->handle.resume();
+        return ready.value();
+    }
+
+    size_t poll() { return posted_.run() + step(false); }
+
+    template <typename A>
+    requires async::awaitable<A>
+    async::await_result_t<A> run(A&& a) {
+        return detail::drive(*this, posted_, std::forward<A>(a));
+    }
+
+    // State queries
+    size_t in_flight() const noexcept { return in_flight_; }
+
+    bool is_open() const noexcept { return handle_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // CPO integration: async_work(pipes, child, pipe_read_command/pipe_write_command, request)
+    friend async::task<process_result<process::io_result>>
+      tag_invoke(async::async_work_t, pipe_scheduler& pipes, process& child, pipe_read_command,
+                 const process::io_request& request) {
+        return pipes.read(child, request);
+    }
+
+    friend async::task<process_result<process::io_result>>
+      tag_invoke(async::async_work_t, pipe_scheduler& pipes, process& child, pipe_write_command,
+                 const process::io_request& request) {
+        return pipes.write(child, request);
+    }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_ASYNC_HPP
@@ -0,0 +1,298 @@
+#ifndef ASYNCLE_IO_BLOCK_CODEC_HPP
+#define ASYNCLE_IO_BLOCK_CODEC_HPP
+
+// asyncle::io block codecs - Compress one independent block at a time
+//
+// block_codec::lz4 writes the LZ4 block format (a token byte, literals, a
+// 16-bit match offset, lengths in 255-runs). Without a library the built-in
+// coder is used: a greedy single-probe matcher with a 4096-entry hash table,
+// plus a bounds-checked decoder. With ASYNCLE_HAS_LZ4 (CMake option
+// ASYNCLE_ENABLE_LZ4), liblz4 does the work instead. Either side reads the
+// other's output, because the format is the same. block_codec::zstd needs
+// ASYNCLE_HAS_ZSTD (ASYNCLE_ENABLE_ZSTD); without it, codec_available(zstd) is
+// false and both directions fail with error_code::not_supported.
+// block_codec::store copies the bytes unchanged.
+//
+// Blocks are independent (no dictionary carried between them), so they
+// compress and decompress in parallel, and a reader can start at any block.
+// compress_block() fails with no_space when the output does not fit; a buffer
+// of compress_bound(codec, n) bytes always does. decompress_block() needs the
+// exact raw size and fails with io_error on malformed input. It never reads or
+// writes out of bounds.
+//
+// Usage:
+//   std::vector<char> packed(io::compress_bound(io::block_codec::lz4, raw.size()));
+//   auto n = io::compress_block(io::block_codec::lz4, 0, raw.data(), raw.size(), packed.data(), packed.size());
+//   io::decompress_block(io::block_codec::lz4, packed.data(), *n, out.data(), raw.size());
+
+#include "result.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(ASYNCLE_HAS_LZ4)
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#if defined(ASYNCLE_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace asyncle::io {
+
+using platform::file::error_code;
+using platform::file::file_error;
+using platform::file::unexpect;
+
+enum class block_codec : uint8_t {
+    store = 0,  // Bytes as they are
+    lz4   = 1,  // LZ4 block format (built in, or liblz4)
+    zstd  = 2   // Zstandard frame (libzstd only)
+};
+
+namespace detail {
+
+inline constexpr size_t lz4_min_match  = 4;
+inline constexpr size_t lz4_last_bytes = 5;   // Always literals
+inline constexpr size_t lz4_mf_limit   = 12;  // No match starts closer to the end
+inline constexpr size_t lz4_max_offset = 65535;
+inline constexpr int    lz4_hash_bits  = 12;
+
+inline uint32_t lz4_read32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t lz4_hash(uint32_t v) noexcept { return (v * 2654435761u) >> (32 - lz4_hash_bits); }
+
+// Bytes equal from a and b, stopping at limit (a's end)
+inline size_t lz4_count(const uint8_t* a, const uint8_t* b, const uint8_t* limit) noexcept {
+    const uint8_t* start = a;
+    while(a + 8 <= limit) {
+        uint64_t x, y;
+        std::memcpy(&x, a, 8);
+        std::memcpy(&y, b, 8);
+        if(uint64_t diff = x ^ y) {
+            if constexpr(std::endian::native == std::endian::little) {
+                return static_cast<size_t>(a - start) + static_cast<size_t>(std::countr_zero(diff) / 8);
+            } else {
+                return static_cast<size_t>(a - start) + static_cast<size_t>(std::countl_zero(diff) / 8);
+            }
+        }
+        a += 8;
+        b += 8;
+    }
+    while(a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<size_t>(a - start);
+}
+
+// A length >= 15 continues in 255-runs after the token
+inline uint8_t* lz4_put_length(uint8_t* op, size_t length) noexcept {
+    for(; length >= 255; length -= 255) *op++ = 255;
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+// One sequence: literals [anchor, anchor + literals), then a match (none when match == 0)
+inline uint8_t*
+  lz4_sequence(uint8_t* op, const uint8_t* anchor, size_t literals, size_t offset, size_t match) noexcept {
+    uint8_t* token = op++;
+    *token         = static_cast<uint8_t>((literals >= 15 ? 15 : literals) << 4);
+    if(literals >= 15) op = lz4_put_length(op, literals - 15);
+    if(literals) std::memcpy(op, anchor, literals);
+    op += literals;
+    if(match == 0) return op;
+    *op++          = static_cast<uint8_t>(offset);
+    *op++          = static_cast<uint8_t>(offset >> 8);
+    const size_t m = match - lz4_min_match;
+    *token         = static_cast<uint8_t>(*token | (m >= 15 ? 15 : m));
+    if(m >= 15) op = lz4_put_length(op, m - 15);
+    return op;
+}
+
+// Caller guarantees capacity >= compress_bound
+inline size_t lz4_compress(const uint8_t* src, size_t n, uint8_t* dst) noexcept {
+    const uint8_t* ip     = src;
+    const uint8_t* anchor = src;
+    uint8_t*       op     = dst;
+    if(n > lz4_mf_limit) {
+        const uint8_t* end         = src + n;
+        const uint8_t* match_limit = end - lz4_last_bytes;
+        const uint8_t* mf_limit    = end - lz4_mf_limit;
+        uint32_t       table[size_t { 1 } << lz4_hash_bits] = {};  // Positions + 1; 0 = empty
+
+        while(ip <= mf_limit) {
+            const uint32_t h         = lz4_hash(lz4_read32(ip));
+            const uint32_t candidate = table[h];
+            table[h]                 = static_cast<uint32_t>(ip - src) + 1;
+            const uint8_t* ref       = candidate ? src + candidate - 1 : ip;
+            if(ref == ip || static_cast<size_t>(ip - ref) > lz4_max_offset || lz4_read32(ref) != lz4_read32(ip)) {
+                ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);  // Skip faster through incompressible runs
+                continue;
+            }
+            while(ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            const size_t literals = static_cast<size_t>(ip - anchor);
+            const size_t match    = lz4_min_match + lz4_count(ip + lz4_min_match, ref + lz4_min_match, match_limit);
+            op                    = lz4_sequence(op, anchor, literals, static_cast<size_t>(ip - ref), match);
+            ip    += match;
+            anchor = ip;
+            if(ip <= mf_limit) table[lz4_hash(lz4_read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src) + 1;
+        }
+    }
+    return static_cast<size_t>(lz4_sequence(op, anchor, n - static_cast<size_t>(anchor - src), 0, 0) - dst);
+}
+
+// false on malformed input or when the output is not exactly raw bytes
+inline bool lz4_decompress(const uint8_t* ip, size_t n, uint8_t* dst, size_t raw) noexcept {
+    const uint8_t* const iend = ip + n;
+    uint8_t*             op   = dst;
+    uint8_t* const       oend = dst + raw;
+    auto                 length = [&](size_t base, size_t& out) {
+        out = base;
+        if(base != 15) return true;
+        for(;;) {
+            if(ip == iend) return false;
+            const uint8_t b  = *ip++;
+            out             += b;
+            if(b != 255) return true;
+        }
+    };
+
+    for(;;) {
+        if(ip == iend) return false;
+        const uint8_t token = *ip++;
+        size_t        literals;
+        if(!length(token >> 4, literals)) return false;
+        if(literals > static_cast<size_t>(iend - ip) || literals > static_cast<size_t>(oend - op)) return false;
+        if(literals) std::memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if(ip == iend) return op == oend;  // The last sequence has no match
+
+        if(iend - ip < 2) return false;
+        const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+        ip                 += 2;
+        size_t match;
+        if(!length(token & 15, match)) return false;
+        match += lz4_min_match;
+        if(offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+        if(match > static_cast<size_t>(oend - op)) return false;
+        const uint8_t* ref = op - offset;
+        if(offset >= match) {
+            std::memcpy(op, ref, match);
+            op += match;
+        } else {
+            for(size_t i = 0; i < match; ++i) *op++ = ref[i];  // Overlapping copy repeats the last offset bytes
+        }
+    }
+}
+
+inline file_error codec_unsupported() noexcept { return file_error(error_code::not_supported); }
+
+}  // namespace detail
+
+// Whether this build can compress and decompress with codec
+constexpr bool codec_available(block_codec codec) noexcept {
+    switch(codec) {
+    case block_codec::store :
+    case block_codec::lz4 : return true;
+    case block_codec::zstd :
+#if defined(ASYNCLE_HAS_ZSTD)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+// Largest compressed size of n bytes
+inline size_t compress_bound(block_codec codec, size_t n) noexcept {
+#if defined(ASYNCLE_HAS_ZSTD)
+    if(codec == block_codec::zstd) return ZSTD_compressBound(n);
+#endif
+    if(codec == block_codec::lz4) return n + n / 255 + 16;
+    return n;
+}
+
+// Compress n bytes of src into dst; level is codec-specific (lz4 with liblz4:
+// > 1 selects the HC coder at that level; zstd: the zstd level; 0 = default)
+inline file_result<size_t>
+  compress_block(block_codec codec, int level, const void* src, size_t n, void* dst, size_t capacity) noexcept {
+    switch(codec) {
+    case block_codec::store :
+        if(n > capacity) return file_result<size_t>(unexpect, file_error(error_code::no_space));
+        if(n) std::memcpy(dst, src, n);
+        return n;
+    case block_codec::lz4 : {
+        if(n > 0x7E000000u) return file_result<size_t>(unexpect, file_error(error_code::file_too_large));
+#if defined(ASYNCLE_HAS_LZ4)
+        const int packed =
+          level > 1 ? LZ4_compress_HC(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(n),
+                                      static_cast<int>(std::min<size_t>(capacity, INT32_MAX)), level)
+                    : LZ4_compress_default(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(n),
+                                           static_cast<int>(std::min<size_t>(capacity, INT32_MAX)));
+        if(packed <= 0) return file_result<size_t>(unexpect, file_error(error_code::no_space));
+        return static_cast<size_t>(packed);
+#else
+        (void)level;
+        if(capacity < compress_bound(codec, n)) return file_result<size_t>(unexpect, file_error(error_code::no_space));
+        return detail::lz4_compress(static_cast<const uint8_t*>(src), n, static_cast<uint8_t*>(dst));
+#endif
+    }
+    case block_codec::zstd : {
+#if defined(ASYNCLE_HAS_ZSTD)
+        const size_t packed = ZSTD_compress(dst, capacity, src, n, level ? level : ZSTD_CLEVEL_DEFAULT);
+        if(ZSTD_isError(packed)) return file_result<size_t>(unexpect, file_error(error_code::no_space));
+        return packed;
+#else
+        (void)level;
+        return file_result<size_t>(unexpect, detail::codec_unsupported());
+#endif
+    }
+    }
+    return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+}
+
+// Decompress n bytes of src into exactly raw bytes at dst
+inline file_void_result decompress_block(block_codec codec, const void* src, size_t n, void* dst, size_t raw) noexcept {
+    bool ok = false;
+    switch(codec) {
+    case block_codec::store :
+        ok = n == raw;
+        if(ok && n) std::memcpy(dst, src, n);
+        break;
+    case block_codec::lz4 :
+#if defined(ASYNCLE_HAS_LZ4)
+        if(n > INT32_MAX || raw > INT32_MAX) break;
+        ok = LZ4_decompress_safe(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(n),
+                                 static_cast<int>(raw))
+             == static_cast<int>(raw);
+#else
+        ok = detail::lz4_decompress(static_cast<const uint8_t*>(src), n, static_cast<uint8_t*>(dst), raw);
+#endif
+        break;
+    case block_codec::zstd :
+#if defined(ASYNCLE_HAS_ZSTD)
+        if(const size_t got = ZSTD_decompress(dst, raw, src, n); !ZSTD_isError(got)) ok = got == raw;
+        break;
+#else
+        return file_void_result(unexpect, detail::codec_unsupported());
+#endif
+    }
+    if(!ok) return file_void_result(unexpect, file_error(error_code::io_error));
+    return file_void_result();
+}
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_BLOCK_CODEC_HPP
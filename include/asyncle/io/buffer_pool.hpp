@@ -0,0 +1,236 @@
+#ifndef ASYNCLE_IO_BUFFER_POOL_HPP
+#define ASYNCLE_IO_BUFFER_POOL_HPP
+
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include "ring.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace asyncle::io {
+
+// Buffer handed out by dio_buffer_pool (24 bytes)
+struct dio_buffer {
+    void*    data;   // Aligned buffer start
+    size_t   size;   // Usable length (multiple of the pool alignment)
+    uint32_t index;  // Buffer index, also the ring fixed-buffer index
+    uint32_t reserved;
+
+    constexpr dio_buffer() noexcept: data(nullptr), size(0), index(0), reserved(0) {}
+
+    constexpr dio_buffer(void* d, size_t s, uint32_t i) noexcept: data(d), size(s), index(i), reserved(0) {}
+
+    constexpr bool is_valid() const noexcept { return data != nullptr; }
+
+    constexpr explicit operator bool() const noexcept { return is_valid(); }
+
+    // Request covering the first length bytes (0 = whole buffer) at a file offset
+    constexpr io_request request(uint64_t offset, size_t length = 0) const noexcept {
+        io_request req {};
+        req.buffer       = data;
+        req.length       = length ? length : size;
+        req.offset       = offset;
+        req.buffer_index = index;
+        return req;
+    }
+};
+
+// Fixed-size pool of O_DIRECT-ready buffers carved out of one anonymous mapping.
+// Buffers are aligned to the device's direct I/O alignment and padded to a multiple
+// of it, so no per-I/O alignment checks are needed; the slab can be registered with
+// an io_ring so read_fixed/write_fixed skip the per-request page pinning.
+// A bitmap of buffers that are out makes a double release a no-op rather than a
+// corrupted free list. Not thread-safe: use one pool per thread or guard
+// acquire/release externally.
+class dio_buffer_pool {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = memory_error;
+    template <typename T>
+    using result_type = mmap_result<T>;
+
+    private:
+    static constexpr uint32_t end_of_list = static_cast<uint32_t>(-1);
+
+    mmap     slab_;
+    size_t   stride_    = 0;  // Distance between buffers (buffer size rounded to alignment)
+    size_t   alignment_ = 0;
+    uint32_t count_     = 0;
+    uint32_t available_ = 0;
+    uint32_t free_head_ = end_of_list;  // Intrusive free list stored in the free buffers
+
+    std::unique_ptr<uint64_t[]> out_;  // Bit per buffer, set while it is acquired
+
+    bool is_out(uint32_t index) const noexcept { return (out_[index / 64] >> (index % 64)) & 1; }
+
+    void mark(uint32_t index, bool out) noexcept {
+        const uint64_t bit = uint64_t { 1 } << (index % 64);
+        out_[index / 64]   = out ? out_[index / 64] | bit : out_[index / 64] & ~bit;
+    }
+
+    char* buffer_at(uint32_t index) const noexcept {
+        return static_cast<char*>(const_cast<void*>(slab_.data())) + static_cast<size_t>(index) * stride_;
+    }
+
+    void reset() noexcept {
+        stride_    = 0;
+        alignment_ = 0;
+        count_     = 0;
+        available_ = 0;
+        free_head_ = end_of_list;
+        out_.reset();
+    }
+
+    public:
+    // Constructors
+    dio_buffer_pool() noexcept = default;
+
+    dio_buffer_pool(
+      size_t                       buffer_size,
+      uint32_t                     count,
+      size_t                       alignment = 0,
+      mmap_access::page_preference pages     = mmap_access::page_preference::system_default) noexcept {
+        create(buffer_size, count, alignment, pages);
+    }
+
+    // Pool sized for direct I/O on a specific file
+    static dio_buffer_pool for_file(
+      const file&                  f,
+      size_t                       buffer_size,
+      uint32_t                     count,
+      mmap_access::page_preference pages = mmap_access::page_preference::system_default) noexcept {
+        size_t alignment = 0;
+        auto   dio       = f.direct_io_alignment();
+        if(dio) {
+            const dio_alignment& a = dio.value();
+            alignment              = a.memory_align > a.offset_align ? a.memory_align : a.offset_align;
+        }
+        return dio_buffer_pool(buffer_size, count, alignment, pages);
+    }
+
+    // Move semantics
+    dio_buffer_pool(dio_buffer_pool&& other) noexcept:
+        slab_(std::move(other.slab_)),
+        stride_(other.stride_),
+        alignment_(other.alignment_),
+        count_(other.count_),
+        available_(other.available_),
+        free_head_(other.free_head_),
+        out_(std::move(other.out_)) {
+        other.reset();
+    }
+
+    dio_buffer_pool& operator=(dio_buffer_pool&& other) noexcept {
+        if(this != &other) {
+            slab_      = std::move(other.slab_);
+            stride_    = other.stride_;
+            alignment_ = other.alignment_;
+            count_     = other.count_;
+            available_ = other.available_;
+            free_head_ = other.free_head_;
+            out_       = std::move(other.out_);
+            other.reset();
+        }
+        return *this;
+    }
+
+    // No copy
+    dio_buffer_pool(const dio_buffer_pool&)            = delete;
+    dio_buffer_pool& operator=(const dio_buffer_pool&) = delete;
+
+    // Core operations
+    // alignment = 0 uses the page size; it must be a power of two no larger than the page size
+    mmap_result<memory_region> create(
+      size_t                       buffer_size,
+      uint32_t                     count,
+      size_t                       alignment = 0,
+      mmap_access::page_preference pages     = mmap_access::page_preference::system_default) noexcept {
+        slab_.unmap();
+        reset();
+
+        const size_t page = mmap::page_size();
+        if(alignment == 0) alignment = page;
+        if(buffer_size == 0 || count == 0 || count == end_of_list || (alignment & (alignment - 1)) != 0
+           || alignment > page) {
+            return mmap_result<memory_region>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+
+        out_.reset(new(std::nothrow) uint64_t[(count + 63) / 64]());
+        if(!out_) return mmap_result<memory_region>(unexpect, memory_error(mmap_access::error_code::no_memory));
+
+        const size_t stride = (buffer_size + alignment - 1) & ~(alignment - 1);
+        auto         result = slab_.map_anonymous(mmap::align_to_page(stride * count), pages);
+        if(!result) {
+            out_.reset();
+            return result;
+        }
+
+        stride_    = stride;
+        alignment_ = alignment;
+        count_     = count;
+        available_ = count;
+
+        // Thread every buffer onto the free list (touches one word per buffer)
+        for(uint32_t i = count; i-- > 0;) {
+            std::memcpy(buffer_at(i), &free_head_, sizeof(free_head_));
+            free_head_ = i;
+        }
+        return result;
+    }
+
+    // Register every buffer with the ring; buffer i becomes fixed-buffer index i
+    file_void_result register_with(io_ring& ring) const noexcept {
+        if(!is_valid()) { return file_void_result(unexpect, file_error(error_code::invalid_argument)); }
+
+        auto* buffers = static_cast<ring_buffer*>(::operator new(count_ * sizeof(ring_buffer), std::nothrow));
+        if(!buffers) { return file_void_result(unexpect, file_error(error_code::no_memory)); }
+        for(uint32_t i = 0; i < count_; ++i) { buffers[i] = ring_buffer(buffer_at(i), stride_); }
+
+        auto result = ring.register_buffers(buffers, count_);
+        ::operator delete(buffers, std::nothrow);
+        return result;
+    }
+
+    // Take a buffer; returns an invalid buffer when the pool is exhausted
+    dio_buffer acquire() noexcept {
+        if(free_head_ == end_of_list) return dio_buffer {};
+        uint32_t index = free_head_;
+        std::memcpy(&free_head_, buffer_at(index), sizeof(free_head_));
+        mark(index, true);
+        --available_;
+        return dio_buffer(buffer_at(index), stride_, index);
+    }
+
+    // Return a buffer; one that is not out (already released, or never acquired) is ignored
+    void release(const dio_buffer& buffer) noexcept {
+        if(!buffer.is_valid() || buffer.index >= count_ || !is_out(buffer.index)) return;
+        mark(buffer.index, false);
+        std::memcpy(buffer_at(buffer.index), &free_head_, sizeof(free_head_));
+        free_head_ = buffer.index;
+        ++available_;
+    }
+
+    // Accessors
+    size_t buffer_size() const noexcept { return stride_; }
+
+    size_t alignment() const noexcept { return alignment_; }
+
+    uint32_t capacity() const noexcept { return count_; }
+
+    uint32_t available() const noexcept { return available_; }
+
+    const memory_region& region() const noexcept { return slab_.region(); }
+
+    bool is_valid() const noexcept { return slab_.is_mapped() && count_ != 0; }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_BUFFER_POOL_HPP
@@ -0,0 +1,340 @@
+#ifndef ASYNCLE_IO_BUFFERED_WRITER_HPP
+#define ASYNCLE_IO_BUFFERED_WRITER_HPP
+
+// asyncle::io buffered writer - Double-buffered appends to a file
+//
+// write() copies records into the current buffer. When the buffer is full it
+// is queued for a writer thread and the next free buffer takes over, so the
+// caller keeps filling one buffer while another is written. The writer thread
+// takes every queued buffer at once and writes them with one writev. Buffers
+// come from a dio_buffer_pool, so they are page aligned and safe for O_DIRECT.
+// A small record costs a memcpy; the system calls are per buffer.
+//
+// With align_tail, the file is expected to be open with access_mode::direct.
+// Buffers are then a whole number of the file's direct I/O blocks. flush()
+// pads the last partial block with zeros, writes it, and truncates the file
+// back to its logical size. The partial block stays in the buffer and is
+// written again, complete, by the next flush.
+//
+// A failed write is sticky: every later call returns the error. One producer
+// only (a writer per thread); the file must outlive the writer.
+//
+// Usage:
+//   io::file log("events.log", mode(access_mode::write_only, access_mode::create));
+//   io::buffered_writer out(log);                  // Appends at the end of the file
+//   for(const auto& e : events) out.write(e.data(), e.size());
+//   out.flush();                                   // Everything written on return
+
+#include "../meta/dispatch.hpp"
+#include "buffer_pool.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+struct buffered_writer_options {
+    size_t   buffer_size = size_t { 1 } << 20;  // Bytes per buffer, rounded up to the alignment
+    uint32_t buffers     = 2;                   // Buffers in rotation (at least 2)
+    bool     background  = true;                // Write on a writer thread; false writes full buffers inline
+    bool     align_tail  = false;               // O_DIRECT: pad partial blocks on flush, then trim the file
+};
+
+class buffered_writer {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    struct queued_buffer {
+        dio_buffer buffer;
+        size_t     length;
+        uint64_t   offset;
+    };
+
+    file*                   file_ = nullptr;
+    buffered_writer_options options_;
+    dio_buffer_pool         pool_;  // Guarded by mutex_ while the writer thread runs
+    size_t                  block_  = 1;
+    dio_buffer              current_;
+    size_t                  used_   = 0;
+    uint64_t                offset_ = 0;  // File offset of current_'s first byte
+
+    std::mutex                 mutex_;
+    std::condition_variable    queued_;   // Work for the writer thread, or stop
+    std::condition_variable    written_;  // A buffer came back, or the queue drained
+    std::vector<queued_buffer> queue_;
+    std::vector<queued_buffer> batch_;  // Owned by whoever is writing
+    std::vector<io_request>    requests_;
+    std::optional<file_error>  failed_;
+    bool                       writing_  = false;
+    bool                       stopping_ = false;
+    std::thread                writer_;
+
+    // Short writes resume where they stopped
+    file_void_result write_all(std::span<io_request> run) noexcept {
+        while(!run.empty()) {
+            auto wrote = file_->writev(run.data(), run.size());
+            if(!wrote) return file_void_result(unexpect, wrote.error());
+            size_t done = wrote->bytes_transferred;
+            if(done == 0) return file_void_result(unexpect, file_error(error_code::io_error));
+            while(!run.empty() && done >= run.front().length) {
+                done -= run.front().length;
+                run   = run.subspan(1);
+            }
+            if(!run.empty()) {
+                run.front().buffer  = static_cast<std::byte*>(run.front().buffer) + done;
+                run.front().offset += done;
+                run.front().length -= done;
+            }
+        }
+        return file_void_result();
+    }
+
+    // Write batch_ (file-contiguous) with one writev and return its buffers
+    file_void_result write_batch() noexcept {
+        requests_.clear();
+        for(const auto& q : batch_) requests_.push_back(q.buffer.request(q.offset, q.length));
+        return write_all(requests_);
+    }
+
+    void run_writer() noexcept {
+        std::unique_lock lock(mutex_);
+        for(;;) {
+            queued_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            if(queue_.empty()) return;
+            writing_          = true;
+            const bool failed = failed_.has_value();  // After a failure buffers only come back
+            batch_.swap(queue_);
+            lock.unlock();
+            auto done = failed ? file_void_result() : write_batch();
+            lock.lock();
+            if(!done && !failed_) failed_ = done.error();
+            for(const auto& q : batch_) pool_.release(q.buffer);
+            batch_.clear();
+            writing_ = false;
+            written_.notify_all();
+        }
+    }
+
+    // Wait until nothing is queued or being written
+    file_void_result drain() noexcept {
+        std::unique_lock lock(mutex_);
+        written_.wait(lock, [this] { return queue_.empty() && !writing_; });
+        if(failed_) return file_void_result(unexpect, *failed_);
+        return file_void_result();
+    }
+
+    // Make current_ a free buffer, waiting for the writer thread to return one
+    file_void_result take_buffer() noexcept {
+        std::unique_lock lock(mutex_);
+        written_.wait(lock, [this] { return pool_.available() > 0 || failed_; });
+        if(failed_) return file_void_result(unexpect, *failed_);
+        current_ = pool_.acquire();
+        used_    = 0;
+        return file_void_result();
+    }
+
+    // Hand the full current_ to the writer thread, or write it here
+    file_void_result submit() noexcept {
+        queued_buffer full { current_, used_, offset_ };
+        offset_  += used_;
+        current_  = dio_buffer {};
+        used_     = 0;
+        if(writer_.joinable()) {
+            std::lock_guard lock(mutex_);
+            if(failed_) {
+                pool_.release(full.buffer);
+                return file_void_result(unexpect, *failed_);
+            }
+            queue_.push_back(full);
+            queued_.notify_one();
+            return file_void_result();
+        }
+        batch_.assign(1, full);
+        auto done = write_batch();
+        pool_.release(full.buffer);
+        batch_.clear();
+        if(!done) failed_ = done.error();
+        return done;
+    }
+
+    void stop_writer() noexcept {
+        if(!writer_.joinable()) return;
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        queued_.notify_one();
+        writer_.join();
+        stopping_ = false;
+    }
+
+    public:
+    // Constructors
+    buffered_writer() = default;
+
+    explicit buffered_writer(file& f, const buffered_writer_options& options = {}) { open(f, options); }
+
+    // Not movable: the writer thread holds this
+    buffered_writer(const buffered_writer&)            = delete;
+    buffered_writer& operator=(const buffered_writer&) = delete;
+
+    // Destructor (errors are lost; call close() to see them)
+    ~buffered_writer() { close(); }
+
+    // Core operations
+    // Start appending at the end of f. With align_tail a partial last block is
+    // read back first so that it can be rewritten whole.
+    file_void_result open(file& f, const buffered_writer_options& options = {}) {
+        close();
+        auto size = f.size();
+        if(!f.is_open() || !size || options.buffers < 2 || options.buffer_size == 0) {
+            return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        }
+
+        size_t block = 0;
+        if(options.align_tail) {
+            auto dio = f.direct_io_alignment();
+            if(!dio) return file_void_result(unexpect, dio.error());
+            block = std::max<size_t>({ dio->memory_align, dio->offset_align, 1 });
+        }
+        auto created = pool_.create(std::max(options.buffer_size, block), options.buffers, block);
+        if(!created) return file_void_result(unexpect, detail::to_file_error(created.error()));
+
+        file_    = &f;
+        options_ = options;
+        block_   = block ? block : 1;
+        current_ = pool_.acquire();
+        offset_  = *size / block_ * block_;
+        used_    = static_cast<size_t>(*size - offset_);
+        if(used_ > 0) {
+            auto tail = f.read(current_.data, block_, offset_);
+            if(!tail || *tail < used_) {
+                close();
+                return file_void_result(unexpect, tail ? file_error(error_code::io_error) : tail.error());
+            }
+        }
+
+        queue_.reserve(options.buffers);
+        batch_.reserve(options.buffers);
+        requests_.reserve(options.buffers);
+        if(options.background) {
+            try {
+                writer_ = std::thread([this] { run_writer(); });
+            } catch(...) {}  // No thread: full buffers are written inline
+        }
+        return file_void_result();
+    }
+
+    // Append length bytes; returns once they are copied into a buffer
+    file_void_result write(const void* data, size_t length) noexcept {
+        if(!file_) return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        // Without a writer thread nothing else touches failed_; with one it is read under mutex_
+        if(!writer_.joinable() && failed_) return file_void_result(unexpect, *failed_);
+        const auto* bytes = static_cast<const std::byte*>(data);
+        while(length > 0) {
+            if(!current_) {
+                if(auto taken = take_buffer(); !taken) return taken;
+            }
+            const size_t n = std::min(length, current_.size - used_);
+            std::memcpy(static_cast<std::byte*>(current_.data) + used_, bytes, n);
+            used_  += n;
+            bytes  += n;
+            length -= n;
+            if(used_ == current_.size) {
+                if(auto sent = submit(); !sent) return sent;
+            }
+        }
+        return file_void_result();
+    }
+
+    file_void_result write(std::span<const std::byte> data) noexcept { return write(data.data(), data.size()); }
+
+    // Append a range of trivially copyable values: one copy for contiguous
+    // ranges, one per element otherwise
+    template <std::ranges::input_range R>
+    requires dispatches_to<element_dispatch, std::ranges::range_value_t<R>, trivial_copy_path>
+    file_void_result write_range(R&& values) noexcept {
+        using value_type = std::ranges::range_value_t<R>;
+        if constexpr(dispatches_to<range_dispatch, R, contiguous_path>) {
+            return write(std::ranges::data(values), std::ranges::size(values) * sizeof(value_type));
+        } else {
+            for(auto&& value : values) {
+                const value_type copy = value;
+                if(auto done = write(&copy, sizeof(value_type)); !done) return done;
+            }
+            return file_void_result();
+        }
+    }
+
+    // Write everything buffered so far and wait for it; the data is in the
+    // page cache (or on the device, for O_DIRECT), not synced
+    file_void_result flush() noexcept {
+        if(!file_) return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        if(auto drained = drain(); !drained) return drained;
+        if(!current_ || used_ == 0) return file_void_result();
+
+        const size_t padded = (used_ + block_ - 1) / block_ * block_;
+        std::memset(static_cast<std::byte*>(current_.data) + used_, 0, padded - used_);
+        io_request request = current_.request(offset_, padded);
+        auto       done    = write_all({ &request, 1 });
+        if(done && padded != used_) done = file_->truncate(offset_ + used_);
+        if(!done) {
+            std::lock_guard lock(mutex_);
+            failed_ = done.error();
+            return done;
+        }
+
+        // Keep the partial block; the next write completes it in place
+        const size_t whole = used_ / block_ * block_;
+        std::memmove(current_.data, static_cast<std::byte*>(current_.data) + whole, used_ - whole);
+        offset_ += whole;
+        used_   -= whole;
+        return file_void_result();
+    }
+
+    // Flush, stop the writer thread and release the buffers
+    file_void_result close() noexcept {
+        if(!file_) return file_void_result();
+        auto flushed = flush();
+        stop_writer();
+        pool_    = dio_buffer_pool {};
+        current_ = dio_buffer {};
+        file_    = nullptr;
+        used_    = 0;
+        offset_  = 0;
+        failed_.reset();
+        return flushed;
+    }
+
+    // Accessors
+    // Logical end of the data written so far (file offset)
+    uint64_t position() const noexcept { return offset_ + used_; }
+
+    // Bytes waiting in the current buffer
+    size_t buffered() const noexcept { return used_; }
+
+    size_t buffer_size() const noexcept { return pool_.buffer_size(); }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_BUFFERED_WRITER_HPP
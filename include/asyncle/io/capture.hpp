@@ -0,0 +1,189 @@
+#ifndef ASYNCLE_IO_CAPTURE_HPP
+#define ASYNCLE_IO_CAPTURE_HPP
+
+#include "file.hpp"
+#include "mmap.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace asyncle::io {
+
+// Child output capture without user-space copies.
+//
+// A child writing straight into a file needs no relay at all: use
+// spawn_request::redirect_stdout(file.fd()). When the parent must see the
+// bytes as they arrive, keep the pipe and splice it: splice_output() moves
+// pipe pages into a file's page cache, and output_ring splices into a memfd
+// that is mapped shared, so the consumer reads the bytes in place. Both take
+// the non-blocking parent end of the pipe and pair with process_reactor.
+
+// Splice up to max_bytes buffered in pipe into out at *offset (advanced), or at
+// the file position when offset is null. Returns 0 once the writer closed and
+// the pipe is empty; fails with would_block while it is merely empty.
+inline file_result<size_t>
+  splice_output(const pipe_handle& pipe, file& out, uint64_t* offset, size_t max_bytes = size_t { 1 } << 20) noexcept {
+    if(!pipe.is_valid() || !out.is_open()) {
+        return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+    }
+    return platform::file::splice_files(file_handle(pipe.fd), nullptr, out.handle(), offset, max_bytes,
+                                        platform::file::splice_flag::move | platform::file::splice_flag::nonblock);
+}
+
+// Splice everything currently buffered in pipe into out; eof is set once the
+// writer closed. Returns the bytes moved (0 when nothing was ready).
+inline file_result<size_t> drain_output(const pipe_handle& pipe, file& out, uint64_t* offset, bool& eof) noexcept {
+    size_t total = 0;
+    for(;;) {
+        auto moved = splice_output(pipe, out, offset);
+        if(!moved) {
+            if(moved.error().code == error_code::would_block) break;
+            if(total > 0) break;
+            return moved;
+        }
+        if(moved.value() == 0) {
+            eof = true;
+            break;
+        }
+        total += moved.value();
+    }
+    return file_result<size_t>(total);
+}
+
+// Byte ring in a shared memfd mapping, filled by splicing a child's pipe.
+// Single producer (fill) and single consumer (readable/consume) on one thread;
+// the memfd (fd()) can also be handed to another process to map.
+class output_ring {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    file     backing_;
+    mmap     view_;
+    size_t   capacity_ = 0;
+    uint64_t head_     = 0;  // Bytes written since creation
+    uint64_t tail_     = 0;  // Bytes consumed since creation
+    bool     eof_      = false;
+
+    public:
+    // Constructors
+    output_ring() noexcept = default;
+
+    // Capacity is rounded up to whole pages
+    explicit output_ring(size_t capacity, const char* name = "asyncle-output") noexcept { create(capacity, name); }
+
+    // Move semantics
+    output_ring(output_ring&& other) noexcept:
+        backing_(std::move(other.backing_)),
+        view_(std::move(other.view_)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        head_(std::exchange(other.head_, 0)),
+        tail_(std::exchange(other.tail_, 0)),
+        eof_(std::exchange(other.eof_, false)) {}
+
+    output_ring& operator=(output_ring&& other) noexcept {
+        if(this != &other) {
+            backing_  = std::move(other.backing_);
+            view_     = std::move(other.view_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            head_     = std::exchange(other.head_, 0);
+            tail_     = std::exchange(other.tail_, 0);
+            eof_      = std::exchange(other.eof_, false);
+        }
+        return *this;
+    }
+
+    // No copy
+    output_ring(const output_ring&)            = delete;
+    output_ring& operator=(const output_ring&) = delete;
+
+    // Core operations
+    file_void_result create(size_t capacity, const char* name = "asyncle-output") noexcept {
+        view_.unmap();
+        backing_.close();
+        capacity_ = 0;
+        head_ = tail_ = 0;
+        eof_          = false;
+        if(capacity == 0) { return file_void_result(unexpect, file_error(error_code::invalid_argument)); }
+
+        capacity     = mmap::align_to_page(capacity);
+        auto created = platform::file::create_memory_file(name, capacity);
+        if(!created) return file_void_result(unexpect, created.error());
+        backing_ = file(created.value());
+
+        auto mapped = view_.map_file(backing_, capacity, 0, mmap_access::access_mode::read);
+        if(!mapped) {
+            backing_.close();
+            return file_void_result(unexpect, file_error(error_code::no_memory));
+        }
+        capacity_ = capacity;
+        return file_void_result();
+    }
+
+    // Splice what pipe holds into free space, up to the wrap point twice.
+    // Returns bytes added; 0 when the ring is full or nothing was ready.
+    file_result<size_t> fill(const pipe_handle& pipe) noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+
+        size_t added = 0;
+        for(int segment = 0; segment < 2 && !eof_; ++segment) {
+            size_t   offset = static_cast<size_t>(head_ % capacity_);
+            size_t   room   = std::min(capacity_ - offset, free_space());
+            uint64_t at     = offset;
+            if(room == 0) break;
+
+            auto moved = splice_output(pipe, backing_, &at, room);
+            if(!moved) {
+                if(moved.error().code == error_code::would_block || added > 0) break;
+                return moved;
+            }
+            if(moved.value() == 0) {
+                eof_ = true;
+                break;
+            }
+            head_ += moved.value();
+            added += moved.value();
+            if(moved.value() < room) break;  // Pipe drained before the wrap point
+        }
+        return file_result<size_t>(added);
+    }
+
+    // Oldest unread bytes, contiguous up to the wrap point (call again after consume)
+    std::span<const std::byte> readable() const noexcept {
+        if(!is_open() || head_ == tail_) return {};
+        size_t offset = static_cast<size_t>(tail_ % capacity_);
+        size_t length = std::min(static_cast<size_t>(head_ - tail_), capacity_ - offset);
+        return { static_cast<const std::byte*>(view_.data()) + offset, length };
+    }
+
+    // Release n bytes from the front of readable()
+    void consume(size_t n) noexcept { tail_ += std::min<uint64_t>(n, head_ - tail_); }
+
+    // Accessors
+    bool is_open() const noexcept { return capacity_ != 0; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // Writer closed and every byte spliced in
+    bool eof() const noexcept { return eof_; }
+
+    size_t size() const noexcept { return static_cast<size_t>(head_ - tail_); }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+    size_t free_space() const noexcept { return capacity_ - size(); }
+
+    bool empty() const noexcept { return head_ == tail_; }
+
+    int fd() const noexcept { return backing_.fd(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_CAPTURE_HPP
@@ -0,0 +1,112 @@
+#ifndef ASYNCLE_IO_COMMANDS_HPP
+#define ASYNCLE_IO_COMMANDS_HPP
+
+#include "../base/command.hpp"
+#include "../base/cpo.hpp"
+#include "../meta/entries.hpp"
+#include "file.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace asyncle::io {
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+// work(file, read_command {}, request) -> file_result<io_result>; positional
+// when request.offset is set, like file::read
+struct read_command: command<file_error, type_map<io_request, io_result>> {};
+
+struct write_command: command<file_error, type_map<io_request, io_result>> {};
+
+// work(child, pipe_read_command {}, request) reads its stdout, pipe_write_command
+// writes its stdin; both fail with would_block on an empty or full pipe
+struct pipe_read_command: command<process_error, type_map<process::io_request, process::io_result>> {};
+
+struct pipe_write_command: command<process_error, type_map<process::io_request, process::io_result>> {};
+
+inline file_result<io_result> tag_invoke(read_command, file& f, const io_request& request) noexcept {
+    return f.read(request);
+}
+
+inline file_result<io_result> tag_invoke(write_command, file& f, const io_request& request) noexcept {
+    return f.write(request);
+}
+
+inline process_result<process::io_result>
+  tag_invoke(pipe_read_command, process& p, const process::io_request& request) noexcept {
+    return p.read_stdout(request);
+}
+
+inline process_result<process::io_result>
+  tag_invoke(pipe_write_command, process& p, const process::io_request& request) noexcept {
+    return p.write_stdin(request);
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+namespace detail {
+
+// Spread one vectored transfer over its requests in order: each is credited
+// up to its length, so a short transfer leaves the tail with 0 bytes. An error
+// is only reported when nothing was transferred, and then fails every request.
+inline size_t split_vectored(const file_result<io_result>&     done,
+                             std::span<const io_request>       requests,
+                             std::span<file_result<io_result>> results) noexcept {
+    size_t count = std::min(requests.size(), results.size());
+    if(!done) {
+        for(size_t i = 0; i < count; ++i) results[i] = file_result<io_result>(unexpect, done.error());
+        return count;
+    }
+
+    size_t remaining = done->bytes_transferred;
+    for(size_t i = 0; i < count; ++i) {
+        size_t    bytes  = std::min(remaining, requests[i].length);
+        uint64_t  offset = requests[i].offset;
+        io_result item;
+        item.bytes_transferred = bytes;
+        item.new_offset        = offset == static_cast<uint64_t>(-1) ? done->new_offset : offset + bytes;
+        results[i]             = file_result<io_result>(item);
+        remaining -= bytes;
+    }
+    return count;
+}
+
+template <typename P>
+concept io_request_payload = std::same_as<std::remove_const_t<P>, io_request>;
+
+}  // namespace detail
+
+// work_batch(file, read_command/write_command, requests, results): one
+// vectored syscall for the whole batch (file-contiguous requests coalesce
+// into a single preadv/pwritev) instead of one per request
+template <detail::io_request_payload P>
+size_t tag_invoke(work_batch_t, file& f, read_command, std::span<P> requests,
+                  std::span<file_result<io_result>> results) noexcept {
+    size_t count = std::min(requests.size(), results.size());
+    if(count == 0) return 0;
+    std::span<const io_request> batch(requests.data(), count);
+    return detail::split_vectored(f.readv(batch.data(), count), batch, results);
+}
+
+template <detail::io_request_payload P>
+size_t tag_invoke(work_batch_t, file& f, write_command, std::span<P> requests,
+                  std::span<file_result<io_result>> results) noexcept {
+    size_t count = std::min(requests.size(), results.size());
+    if(count == 0) return 0;
+    std::span<const io_request> batch(requests.data(), count);
+    return detail::split_vectored(f.writev(batch.data(), count), batch, results);
+}
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_COMMANDS_HPP
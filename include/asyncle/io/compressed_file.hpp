@@ -0,0 +1,684 @@
+#ifndef ASYNCLE_IO_COMPRESSED_FILE_HPP
+#define ASYNCLE_IO_COMPRESSED_FILE_HPP
+
+// asyncle::io compressed file - Framed block compression with a seek index
+//
+//   [compressed_file_header]
+//   [compressed_frame_header][payload] ...        one frame per block
+//   [compressed_index_entry] ...                  frame and raw offset of every block
+//   [compressed_file_footer]
+//
+// compressed_writer cuts the bytes appended to it into block_size blocks and
+// compresses each on its own (see block_codec.hpp), up to `parallel` blocks at
+// a time, on a work_stealing_pool or inline. Frames are written in block
+// order as they complete. A frame's header records the block number, the raw
+// and stored sizes, the codec actually used, and the CRC32C of the raw bytes.
+// The codec is store when compression would save nothing. The header carries
+// a CRC32C of its own. flush() ends the current block early, which makes a
+// shorter block; the index records raw offsets, so blocks need not be equal.
+//
+// finish() appends the index and the footer. compressed_reader finds a block
+// with a binary search of the index and reads it with one pread; the prefix
+// is never decompressed. A file without a valid footer (its writer never
+// finished) is still readable: open() walks the frame headers with one small
+// read per block and no decompression, and stops at the first torn or
+// mismatching frame. Decoding checks the frame header and the raw CRC32C, and
+// fails with io_error on any mismatch.
+//
+// The writer has one producer and the file must outlive it. The reader's
+// read() and read_block() share one scratch buffer, so use one reader per
+// thread. for_each_block() decodes ahead on the pool and calls fn on the
+// calling thread in block order.
+//
+// Usage:
+//   concurrent::work_stealing_pool pool;
+//   io::compressed_writer out(snapshot_file, { .codec = io::block_codec::lz4 }, &pool);
+//   out.write(state.data(), state.size());
+//   out.finish();                                          // Index and footer written
+//
+//   io::compressed_reader in(snapshot_file);
+//   in.read(buffer, 4096, offset);                         // Decodes only the blocks covering the range
+//   in.for_each_block(pool, [](uint64_t at, std::span<const std::byte> block) { ... });
+
+#include "../concurrent/thread_pool.hpp"
+#include "../hardware/checksum.hpp"
+#include "block_codec.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+struct compressed_options {
+    block_codec codec      = block_codec::lz4;
+    int         level      = 0;                     // Codec-specific (see compress_block), 0 = default
+    size_t      block_size = size_t { 1 } << 20;    // Raw bytes per block, 4 KiB to 1 GiB
+    size_t      parallel   = 0;                     // Blocks compressing at once (0 = pool workers + 1)
+};
+
+struct compressed_file_header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t crc;         // CRC32C of the header with this field zero
+    uint32_t block_size;  // Raw bytes per full block
+    uint8_t  codec;       // Codec the writer was asked for; frames may be stored
+    uint8_t  reserved[11];
+};
+
+struct compressed_frame_header {
+    uint64_t block;        // Block number, from 0
+    uint32_t raw_size;     // Bytes after decompression
+    uint32_t stored_size;  // Payload bytes after this header
+    uint32_t crc;          // CRC32C of the raw bytes
+    uint32_t header_crc;   // CRC32C of the frame header with this field zero
+    uint8_t  codec;        // block_codec of the payload
+    uint8_t  reserved[7];
+};
+
+struct compressed_index_entry {
+    uint64_t frame_offset;  // File offset of the frame header
+    uint64_t raw_offset;    // Offset of the block's first byte in the raw stream
+};
+
+struct compressed_file_footer {
+    uint64_t index_offset;
+    uint64_t blocks;
+    uint64_t raw_size;
+    uint32_t crc;    // CRC32C of the index entries, then of the footer with this field zero
+    uint32_t magic;
+};
+
+static_assert(sizeof(compressed_file_header) == 32);
+static_assert(sizeof(compressed_frame_header) == 32);
+static_assert(sizeof(compressed_index_entry) == 16);
+static_assert(sizeof(compressed_file_footer) == 32);
+
+namespace detail {
+
+inline constexpr uint64_t compressed_magic        = 0x31464243434E5941ull;  // "AYNCCBF1"
+inline constexpr uint32_t compressed_footer_magic = 0x58424341u;            // "ACBX"
+inline constexpr uint32_t compressed_version      = 1;
+
+inline file_error compressed_corrupt() noexcept { return file_error(error_code::io_error); }
+
+template <typename T>
+uint32_t crc_without(T value, uint32_t T::* field, uint32_t crc = 0) noexcept {
+    value.*field = 0;
+    return hardware::crc32c(&value, sizeof(value), crc);
+}
+
+// Read exactly length bytes at offset; a short read (end of file) is corruption
+inline file_void_result read_exact(const file& f, void* buffer, size_t length, uint64_t offset) noexcept {
+    auto* bytes = static_cast<char*>(buffer);
+    while(length > 0) {
+        auto got = f.read(bytes, length, offset);
+        if(!got) return file_void_result(unexpect, got.error());
+        if(*got == 0) return file_void_result(unexpect, compressed_corrupt());
+        bytes  += *got;
+        offset += *got;
+        length -= *got;
+    }
+    return file_void_result();
+}
+
+}  // namespace detail
+
+class compressed_writer {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    enum : uint32_t { slot_idle, slot_busy, slot_done };
+
+    struct slot {
+        std::vector<char>     raw;
+        std::vector<char>     frame;  // Header and payload
+        size_t                used       = 0;
+        size_t                frame_size = 0;
+        uint64_t              block      = 0;
+        uint64_t              raw_offset = 0;
+        file_error            error {};
+        std::atomic<uint32_t> state { slot_idle };
+    };
+
+    file*                               file_ = nullptr;
+    concurrent::work_stealing_pool*     pool_ = nullptr;
+    compressed_options                  options_;
+    std::shared_ptr<slot[]>             slots_;  // Shared with pool tasks, which notify after their last store
+    size_t                              count_      = 0;
+    size_t                              fill_       = 0;  // Slot taking write()s
+    size_t                              oldest_     = 0;  // Oldest dispatched slot not yet written
+    size_t                              pending_    = 0;  // Dispatched, not yet written
+    uint64_t                            next_block_ = 0;
+    uint64_t                            raw_size_   = 0;  // Bytes in dispatched blocks
+    uint64_t                            offset_     = 0;  // End of the last frame written
+    std::vector<compressed_index_entry> index_;
+    std::optional<file_error>           failed_;
+    bool                                finished_ = false;
+
+    static void compress(slot& s, const compressed_options& options) noexcept {
+        compressed_frame_header header {};
+        header.block    = s.block;
+        header.raw_size = static_cast<uint32_t>(s.used);
+        header.crc      = hardware::crc32c(s.raw.data(), s.used);
+        header.codec    = static_cast<uint8_t>(block_codec::store);
+        s.error         = file_error();
+
+        char*  payload = s.frame.data() + sizeof(header);
+        size_t room    = s.frame.size() - sizeof(header);
+        auto   packed  = compress_block(options.codec, options.level, s.raw.data(), s.used, payload, room);
+        if(packed && *packed < s.used) {
+            header.codec       = static_cast<uint8_t>(options.codec);
+            header.stored_size = static_cast<uint32_t>(*packed);
+        } else if(!packed && packed.error().code == error_code::not_supported) {
+            s.error = packed.error();
+        } else {
+            std::memcpy(payload, s.raw.data(), s.used);  // Incompressible: store it
+            header.stored_size = header.raw_size;
+        }
+        header.header_crc = detail::crc_without(header, &compressed_frame_header::header_crc);
+        std::memcpy(s.frame.data(), &header, sizeof(header));
+        s.frame_size = sizeof(header) + header.stored_size;
+        s.state.store(slot_done, std::memory_order_release);
+        s.state.notify_one();
+    }
+
+    file_void_result fail(const file_error& error) noexcept {
+        if(!failed_) failed_ = error;
+        return file_void_result(unexpect, *failed_);
+    }
+
+    // Compress the filling slot, on the pool when there is one
+    void dispatch() noexcept {
+        slot& s      = slots_[fill_];
+        s.block      = next_block_++;
+        s.raw_offset = raw_size_;
+        raw_size_   += s.used;
+        s.state.store(slot_busy, std::memory_order_relaxed);
+        const compressed_options* options = &options_;
+        if(!pool_ || !pool_->submit([slots = slots_, &s, options] { compress(s, *options); })) compress(s, options_);
+        fill_ = (fill_ + 1) % count_;
+        ++pending_;
+    }
+
+    // Write the oldest dispatched frame, waiting for it when block is set
+    file_result<bool> write_oldest(bool block) noexcept {
+        if(pending_ == 0) return false;
+        slot& s = slots_[oldest_];
+        for(uint32_t state = s.state.load(std::memory_order_acquire); state != slot_done;
+            state          = s.state.load(std::memory_order_acquire)) {
+            if(!block) return false;
+            s.state.wait(state, std::memory_order_acquire);
+        }
+        s.state.store(slot_idle, std::memory_order_relaxed);
+        s.used  = 0;
+        oldest_ = (oldest_ + 1) % count_;
+        --pending_;
+        if(failed_) return file_result<bool>(unexpect, *failed_);
+        if(s.error.code != error_code::success) return file_result<bool>(unexpect, *(failed_ = s.error));
+
+        if(auto wrote = file_->write_all(s.frame.data(), s.frame_size, offset_); !wrote) {
+            return file_result<bool>(unexpect, *(failed_ = wrote.error()));
+        }
+        index_.push_back(compressed_index_entry { offset_, s.raw_offset });
+        offset_ += s.frame_size;
+        return true;
+    }
+
+    // Wait for every dispatched slot, written or not (tasks point into slots_)
+    void quiesce() noexcept {
+        for(size_t i = 0; i < count_; ++i) {
+            for(uint32_t state = slots_[i].state.load(std::memory_order_acquire); state == slot_busy;
+                state          = slots_[i].state.load(std::memory_order_acquire)) {
+                slots_[i].state.wait(state, std::memory_order_acquire);
+            }
+        }
+    }
+
+    public:
+    // Constructors
+    compressed_writer() noexcept = default;
+
+    // Writes a new compressed file over f from offset 0; pool == nullptr compresses inline
+    explicit compressed_writer(
+      file& f, const compressed_options& options = {}, concurrent::work_stealing_pool* pool = nullptr) {
+        open(f, options, pool);
+    }
+
+    // Not movable: pool tasks point at options_
+    compressed_writer(const compressed_writer&)            = delete;
+    compressed_writer& operator=(const compressed_writer&) = delete;
+
+    // Destructor finishes the file; call finish() to see its result
+    ~compressed_writer() { close(); }
+
+    // Core operations
+    file_void_result
+      open(file& f, const compressed_options& options = {}, concurrent::work_stealing_pool* pool = nullptr) {
+        close();
+        if(!f.is_open() || options.block_size < 4096 || options.block_size > (size_t { 1 } << 30)) {
+            return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        }
+        if(!codec_available(options.codec)) return file_void_result(unexpect, file_error(error_code::not_supported));
+
+        const size_t workers = pool && pool->is_running() ? pool->worker_count() + 1 : 1;
+        options_             = options;
+        count_               = std::max<size_t>(1, options.parallel ? options.parallel : workers);
+        slots_               = std::shared_ptr<slot[]>(new slot[count_]);
+        const size_t frame   = sizeof(compressed_frame_header)
+                           + std::max(options.block_size, compress_bound(options.codec, options.block_size));
+        for(size_t i = 0; i < count_; ++i) {
+            slots_[i].raw.resize(options.block_size);
+            slots_[i].frame.resize(frame);
+        }
+
+        compressed_file_header header {};
+        header.magic      = detail::compressed_magic;
+        header.version    = detail::compressed_version;
+        header.block_size = static_cast<uint32_t>(options.block_size);
+        header.codec      = static_cast<uint8_t>(options.codec);
+        header.crc        = detail::crc_without(header, &compressed_file_header::crc);
+        if(auto wrote = f.write_all(&header, sizeof(header), 0); !wrote) {
+            slots_.reset();
+            count_ = 0;
+            return file_void_result(unexpect, wrote.error());
+        }
+        file_     = &f;
+        pool_     = pool;
+        offset_   = sizeof(header);
+        finished_ = false;
+        return file_void_result();
+    }
+
+    // Append bytes; full blocks are compressed while the next one fills
+    file_void_result write(const void* data, size_t length) noexcept {
+        if(!file_ || finished_) return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        if(failed_) return file_void_result(unexpect, *failed_);
+        const char* bytes = static_cast<const char*>(data);
+        while(length > 0) {
+            slot&        s    = slots_[fill_];
+            const size_t take = std::min(length, options_.block_size - s.used);
+            std::memcpy(s.raw.data() + s.used, bytes, take);
+            s.used += take;
+            bytes  += take;
+            length -= take;
+            if(s.used < options_.block_size) break;
+
+            dispatch();
+            // Write what is done; wait only when every slot is taken
+            for(;;) {
+                auto wrote = write_oldest(pending_ == count_);
+                if(!wrote) return file_void_result(unexpect, wrote.error());
+                if(!*wrote) break;
+            }
+        }
+        return file_void_result();
+    }
+
+    // Compress and write everything appended so far (a partial block becomes a short block)
+    file_void_result flush() noexcept {
+        if(!file_ || finished_) return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        if(failed_) return file_void_result(unexpect, *failed_);
+        if(slots_[fill_].used > 0) dispatch();
+        while(pending_ > 0) {
+            if(auto wrote = write_oldest(true); !wrote) return file_void_result(unexpect, wrote.error());
+        }
+        return file_void_result();
+    }
+
+    // Flush, then write the index and the footer and trim anything after them
+    file_void_result finish() noexcept {
+        if(!file_) return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        if(finished_) return failed_ ? file_void_result(unexpect, *failed_) : file_void_result();
+        auto flushed = flush();
+        finished_    = true;
+        if(!flushed) return flushed;
+
+        compressed_file_footer footer {};
+        footer.index_offset = offset_;
+        footer.blocks       = index_.size();
+        footer.raw_size     = raw_size_;
+        footer.magic        = detail::compressed_footer_magic;
+        const size_t   index_bytes = index_.size() * sizeof(compressed_index_entry);
+        const uint32_t index_crc   = hardware::crc32c(index_.data(), index_bytes);
+        footer.crc                 = detail::crc_without(footer, &compressed_file_footer::crc, index_crc);
+
+        if(auto wrote = file_->write_all(index_.data(), index_bytes, offset_); !wrote) return fail(wrote.error());
+        if(auto wrote = file_->write_all(&footer, sizeof(footer), offset_ + index_bytes); !wrote) {
+            return fail(wrote.error());
+        }
+        if(auto trimmed = file_->truncate(offset_ + index_bytes + sizeof(footer)); !trimmed) {
+            return fail(trimmed.error());
+        }
+        return file_void_result();
+    }
+
+    // Finish (errors are dropped) and release the buffers
+    void close() noexcept {
+        if(file_ && !finished_) (void)finish();
+        quiesce();
+        file_ = nullptr;
+        pool_ = nullptr;
+        slots_.reset();
+        count_ = fill_ = oldest_ = pending_ = 0;
+        next_block_ = raw_size_ = offset_ = 0;
+        index_.clear();
+        failed_.reset();
+        finished_ = false;
+    }
+
+    // Accessors
+    // Raw bytes appended so far
+    uint64_t size() const noexcept { return raw_size_ + (file_ ? slots_[fill_].used : 0); }
+
+    // Compressed bytes written so far
+    uint64_t compressed_size() const noexcept { return offset_; }
+
+    uint64_t blocks_written() const noexcept { return index_.size(); }
+
+    const compressed_options& options() const noexcept { return options_; }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+class compressed_reader {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    const file*                         file_ = nullptr;
+    compressed_file_header              header_ {};
+    std::vector<compressed_index_entry> index_;  // One entry per block plus an end sentinel
+    bool                                recovered_ = false;
+    std::vector<char>                   scratch_;  // Frame being decoded
+    std::vector<char>                   block_;    // Last block read() decoded
+    uint64_t                            cached_ = UINT64_MAX;
+
+    file_void_result load_index(uint64_t file_size) {
+        compressed_file_footer footer {};
+        if(file_size < sizeof(header_) + sizeof(footer)) {
+            return file_void_result(unexpect, detail::compressed_corrupt());
+        }
+        if(auto got = detail::read_exact(*file_, &footer, sizeof(footer), file_size - sizeof(footer)); !got) return got;
+        const uint64_t index_bytes = file_size - sizeof(footer) - footer.index_offset;
+        if(footer.magic != detail::compressed_footer_magic || footer.index_offset < sizeof(header_)
+           || footer.index_offset > file_size - sizeof(footer)
+           || index_bytes != footer.blocks * sizeof(compressed_index_entry)) {
+            return file_void_result(unexpect, detail::compressed_corrupt());
+        }
+        index_.resize(static_cast<size_t>(footer.blocks));
+        if(auto got = detail::read_exact(*file_, index_.data(), static_cast<size_t>(index_bytes), footer.index_offset);
+           !got) {
+            return got;
+        }
+        const uint32_t crc = hardware::crc32c(index_.data(), static_cast<size_t>(index_bytes));
+        if(footer.crc != detail::crc_without(footer, &compressed_file_footer::crc, crc)) {
+            return file_void_result(unexpect, detail::compressed_corrupt());
+        }
+        index_.push_back(compressed_index_entry { footer.index_offset, footer.raw_size });
+        for(size_t i = 0; i + 1 < index_.size(); ++i) {
+            if(index_[i + 1].frame_offset <= index_[i].frame_offset || index_[i + 1].raw_offset < index_[i].raw_offset
+               || index_[i + 1].raw_offset - index_[i].raw_offset > header_.block_size
+               || index_[i].frame_offset < sizeof(header_)) {
+                return file_void_result(unexpect, detail::compressed_corrupt());
+            }
+        }
+        return file_void_result();
+    }
+
+    // No footer: walk the frame headers and keep the valid prefix
+    file_void_result recover_index(uint64_t file_size) {
+        index_.clear();
+        uint64_t offset = sizeof(header_), raw = 0;
+        for(uint64_t block = 0;; ++block) {
+            compressed_frame_header frame {};
+            if(offset + sizeof(frame) > file_size) break;
+            if(!detail::read_exact(*file_, &frame, sizeof(frame), offset)) break;
+            if(frame.block != block || frame.raw_size > header_.block_size
+               || offset + sizeof(frame) + frame.stored_size > file_size
+               || frame.header_crc != detail::crc_without(frame, &compressed_frame_header::header_crc)) {
+                break;
+            }
+            index_.push_back(compressed_index_entry { offset, raw });
+            offset += sizeof(frame) + frame.stored_size;
+            raw    += frame.raw_size;
+        }
+        index_.push_back(compressed_index_entry { offset, raw });
+        recovered_ = true;
+        return file_void_result();
+    }
+
+    public:
+    // Constructors
+    compressed_reader() noexcept = default;
+
+    explicit compressed_reader(const file& f) { open(f); }
+
+    compressed_reader(compressed_reader&&) noexcept            = default;
+    compressed_reader& operator=(compressed_reader&&) noexcept = default;
+
+    // No copy
+    compressed_reader(const compressed_reader&)            = delete;
+    compressed_reader& operator=(const compressed_reader&) = delete;
+
+    // Core operations
+    // Read the header and the index (or rebuild the index from the frames)
+    file_void_result open(const file& f) {
+        close();
+        auto size = f.size();
+        if(!size) return file_void_result(unexpect, size.error());
+        file_ = &f;
+        auto opened = [&]() -> file_void_result {
+            if(*size < sizeof(header_)) return file_void_result(unexpect, detail::compressed_corrupt());
+            if(auto got = detail::read_exact(f, &header_, sizeof(header_), 0); !got) return got;
+            if(header_.magic != detail::compressed_magic || header_.version != detail::compressed_version
+               || header_.crc != detail::crc_without(header_, &compressed_file_header::crc)
+               || header_.block_size < 4096 || header_.block_size > (uint32_t { 1 } << 30)) {
+                return file_void_result(unexpect, detail::compressed_corrupt());
+            }
+            if(load_index(*size)) return file_void_result();
+            return recover_index(*size);
+        }();
+        if(!opened) close();
+        return opened;
+    }
+
+    void close() noexcept {
+        file_ = nullptr;
+        index_.clear();
+        recovered_ = false;
+        cached_    = UINT64_MAX;
+    }
+
+    // Decode block k into out (block_length(k) bytes), using caller scratch so
+    // several threads can decode from one reader
+    file_result<size_t> read_block(uint64_t k, void* out, std::vector<char>& scratch) const noexcept {
+        if(!file_ || k >= block_count()) return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        const uint64_t at     = index_[k].frame_offset;
+        const uint64_t length = index_[k + 1].frame_offset - at;
+        const uint64_t raw    = index_[k + 1].raw_offset - index_[k].raw_offset;
+        if(length < sizeof(compressed_frame_header)) return file_result<size_t>(unexpect, detail::compressed_corrupt());
+        try {
+            if(scratch.size() < length) scratch.resize(static_cast<size_t>(length));
+        } catch(...) {
+            return file_result<size_t>(unexpect, file_error(error_code::no_memory));
+        }
+        if(auto got = detail::read_exact(*file_, scratch.data(), static_cast<size_t>(length), at); !got) {
+            return file_result<size_t>(unexpect, got.error());
+        }
+
+        compressed_frame_header frame;
+        std::memcpy(&frame, scratch.data(), sizeof(frame));
+        if(frame.block != k || frame.raw_size != raw || sizeof(frame) + frame.stored_size != length
+           || frame.header_crc != detail::crc_without(frame, &compressed_frame_header::header_crc)) {
+            return file_result<size_t>(unexpect, detail::compressed_corrupt());
+        }
+        auto decoded = decompress_block(static_cast<block_codec>(frame.codec), scratch.data() + sizeof(frame),
+                                        frame.stored_size, out, frame.raw_size);
+        if(!decoded) return file_result<size_t>(unexpect, decoded.error());
+        if(hardware::crc32c(out, frame.raw_size) != frame.crc) {
+            return file_result<size_t>(unexpect, detail::compressed_corrupt());
+        }
+        return static_cast<size_t>(frame.raw_size);
+    }
+
+    file_result<size_t> read_block(uint64_t k, void* out) noexcept { return read_block(k, out, scratch_); }
+
+    // Copy length raw bytes at offset into out, decoding only the blocks that
+    // cover them; returns fewer bytes at the end of the stream
+    file_result<size_t> read(void* out, size_t length, uint64_t offset) noexcept {
+        if(!file_) return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        char*  dst  = static_cast<char*>(out);
+        size_t done = 0;
+        while(done < length && offset < size()) {
+            const uint64_t k     = block_at(offset);
+            const uint64_t start = index_[k].raw_offset;
+            const size_t   raw   = block_length(k);
+            const size_t   skip  = static_cast<size_t>(offset - start);
+            const size_t   take  = std::min(length - done, raw - skip);
+            if(skip == 0 && take == raw && k != cached_) {
+                auto got = read_block(k, dst + done);  // Whole block: straight into out
+                if(!got) return got;
+            } else {
+                if(k != cached_) {
+                    try {
+                        if(block_.size() < raw) block_.resize(raw);
+                    } catch(...) {
+                        return file_result<size_t>(unexpect, file_error(error_code::no_memory));
+                    }
+                    cached_  = UINT64_MAX;
+                    auto got = read_block(k, block_.data());
+                    if(!got) return got;
+                    cached_ = k;
+                }
+                std::memcpy(dst + done, block_.data() + skip, take);
+            }
+            done   += take;
+            offset += take;
+        }
+        return done;
+    }
+
+    // Decode every block from first on pool, up to ahead blocks (0 = two per
+    // worker) in flight, and call fn(raw_offset, std::span<const std::byte>)
+    // here in block order. Stops at the first error; returns the raw bytes
+    // delivered. Must not be called from a task on the same pool.
+    template <typename F>
+    file_result<uint64_t>
+      for_each_block(concurrent::work_stealing_pool& pool, F&& fn, size_t ahead = 0, uint64_t first = 0) const {
+        struct decode_slot {
+            std::vector<char>     raw;
+            std::vector<char>     scratch;
+            file_result<size_t>   result { size_t { 0 } };
+            std::atomic<uint32_t> busy { 0 };
+        };
+        if(!file_) return file_result<uint64_t>(unexpect, file_error(error_code::invalid_argument));
+        const uint64_t blocks = block_count();
+        const size_t   window = ahead ? ahead : std::max<size_t>(2, pool.worker_count() * 2);
+        // Tasks hold the slots too: the final wait can return before a task's notify_one()
+        std::shared_ptr<decode_slot[]> slots;
+        try {
+            size_t widest = 0;  // At most block_size(), checked when the index was loaded
+            for(uint64_t k = 0; k < blocks; ++k) widest = std::max(widest, block_length(k));
+            slots = std::shared_ptr<decode_slot[]>(new decode_slot[window]);
+            for(size_t i = 0; i < window; ++i) slots[i].raw.resize(widest);
+        } catch(const std::bad_alloc&) {
+            return file_result<uint64_t>(unexpect, file_error(error_code::no_memory));
+        }
+
+        auto launch = [&](uint64_t k) {
+            decode_slot& s = slots[k % window];
+            s.busy.store(1, std::memory_order_relaxed);
+            auto decode = [this, slots, &s, k] {
+                s.result = read_block(k, s.raw.data(), s.scratch);
+                s.busy.store(0, std::memory_order_release);
+                s.busy.notify_one();
+            };
+            if(!pool.submit(decode)) decode();
+        };
+        auto wait = [](decode_slot& s) {
+            for(uint32_t b = s.busy.load(std::memory_order_acquire); b; b = s.busy.load(std::memory_order_acquire)) {
+                s.busy.wait(b, std::memory_order_acquire);
+            }
+        };
+
+        uint64_t launched = first;
+        for(; launched < blocks && launched - first < window; ++launched) launch(launched);
+        uint64_t                  delivered = 0;
+        std::optional<file_error> failed;
+        try {
+            for(uint64_t k = first; k < blocks; ++k) {
+                decode_slot& s = slots[k % window];
+                wait(s);
+                if(!s.result) {
+                    failed = s.result.error();
+                    break;
+                }
+                fn(index_[k].raw_offset,
+                   std::span<const std::byte>(reinterpret_cast<const std::byte*>(s.raw.data()), *s.result));
+                delivered += *s.result;
+                if(launched < blocks) launch(launched++);
+            }
+        } catch(...) {
+            // Tasks still read through this reader; let them finish before unwinding
+            for(size_t i = 0; i < window; ++i) wait(slots[i]);
+            throw;
+        }
+        for(size_t i = 0; i < window; ++i) wait(slots[i]);
+        if(failed) return file_result<uint64_t>(unexpect, *failed);
+        return delivered;
+    }
+
+    // Accessors
+    // Block holding raw offset (block_count() when offset >= size())
+    uint64_t block_at(uint64_t offset) const noexcept {
+        if(index_.size() < 2 || offset >= size()) return block_count();
+        auto it = std::upper_bound(index_.begin(), index_.end() - 1, offset,
+                                   [](uint64_t v, const compressed_index_entry& e) { return v < e.raw_offset; });
+        return static_cast<uint64_t>(it - index_.begin()) - 1;
+    }
+
+    uint64_t block_count() const noexcept { return index_.empty() ? 0 : index_.size() - 1; }
+
+    uint64_t block_offset(uint64_t k) const noexcept { return index_[k].raw_offset; }
+
+    size_t block_length(uint64_t k) const noexcept {
+        return static_cast<size_t>(index_[k + 1].raw_offset - index_[k].raw_offset);
+    }
+
+    // Raw stream size
+    uint64_t size() const noexcept { return index_.empty() ? 0 : index_.back().raw_offset; }
+
+    size_t block_size() const noexcept { return header_.block_size; }
+
+    block_codec codec() const noexcept { return static_cast<block_codec>(header_.codec); }
+
+    // The footer was missing or invalid and the index was rebuilt from the frames
+    bool recovered() const noexcept { return recovered_; }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_COMPRESSED_FILE_HPP
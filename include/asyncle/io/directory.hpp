@@ -0,0 +1,150 @@
+#ifndef ASYNCLE_IO_DIRECTORY_HPP
+#define ASYNCLE_IO_DIRECTORY_HPP
+
+#include "../../platform/file.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include "ring.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace asyncle::io {
+
+using platform::file::dir_entry;
+
+// Directory listing through one large buffer (getdents64 on Linux).
+// Each refill returns as many entries as fit, typically a whole directory
+// per system call; "." and ".." are skipped. Entries point into the buffer and
+// stay valid until the call that refills it.
+class directory {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    static constexpr size_t default_buffer_size = 256 * 1024;
+
+    private:
+    file_handle             handle_;
+    std::unique_ptr<char[]> buffer_;
+    size_t                  capacity_ = 0;
+    size_t                  filled_   = 0;
+    size_t                  offset_   = 0;
+
+    static bool is_dot(std::string_view name) noexcept { return name == "." || name == ".."; }
+
+    public:
+    // Constructors
+    directory() noexcept = default;
+
+    explicit directory(const char* path, size_t buffer_size = default_buffer_size) noexcept { open(path, buffer_size); }
+
+    // Move semantics
+    directory(directory&& other) noexcept:
+        handle_(std::exchange(other.handle_, file_handle {})),
+        buffer_(std::move(other.buffer_)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        filled_(std::exchange(other.filled_, 0)),
+        offset_(std::exchange(other.offset_, 0)) {}
+
+    directory& operator=(directory&& other) noexcept {
+        if(this != &other) {
+            close();
+            handle_   = std::exchange(other.handle_, file_handle {});
+            buffer_   = std::move(other.buffer_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            filled_   = std::exchange(other.filled_, 0);
+            offset_   = std::exchange(other.offset_, 0);
+        }
+        return *this;
+    }
+
+    // No copy
+    directory(const directory&)            = delete;
+    directory& operator=(const directory&) = delete;
+
+    // Destructor
+    ~directory() { close(); }
+
+    // Core operations
+    file_void_result open(const char* path, size_t buffer_size = default_buffer_size) noexcept {
+        close();
+        if(!path || buffer_size < 1024) {
+            return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        }
+        if(capacity_ < buffer_size) {
+            buffer_.reset(new(std::nothrow) char[buffer_size]);
+            capacity_ = buffer_ ? buffer_size : 0;
+            if(!buffer_) return file_void_result(unexpect, file_error(error_code::no_memory));
+        }
+        auto opened = platform::file::open_directory(path);
+        if(!opened) return file_void_result(unexpect, opened.error());
+        handle_ = *opened;
+        return file_void_result();
+    }
+
+    // Keeps the buffer for the next open()
+    void close() noexcept {
+        if(handle_.is_valid()) platform::file::close_file(handle_);
+        filled_ = 0;
+        offset_ = 0;
+    }
+
+    // Up to max entries, all from the same buffer fill, so every name stays
+    // valid together until the next call. 0 means the listing is done
+    file_result<size_t> next_batch(dir_entry* entries, size_t max) noexcept {
+        if(!is_open() || (max > 0 && !entries)) {
+            return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        }
+        size_t count = 0;
+        while(count == 0 && max > 0) {
+            if(offset_ >= filled_) {
+                auto filled = platform::file::read_directory(handle_, buffer_.get(), capacity_);
+                if(!filled) return file_result<size_t>(unexpect, filled.error());
+                filled_ = *filled;
+                offset_ = 0;
+                if(filled_ == 0) break;
+            }
+            while(count < max
+                  && platform::file::next_directory_entry(buffer_.get(), filled_, offset_, entries[count])) {
+                if(!is_dot(entries[count].name)) ++count;
+            }
+        }
+        return count;
+    }
+
+    // Next entry; an empty name means the listing is done
+    file_result<dir_entry> next() noexcept {
+        dir_entry entry;
+        auto      got = next_batch(&entry, 1);
+        if(!got) return file_result<dir_entry>(unexpect, got.error());
+        return *got ? entry : dir_entry {};
+    }
+
+    // Stat names in this directory without following symlinks (see
+    // platform::file::stat_batch); an idle ring sends them in one submission
+    file_result<size_t> stat(
+      const char* const* names, size_t count, file_info* infos, file_error* errors, io_ring* ring = nullptr) noexcept {
+        if(!is_open()) return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        return platform::file::stat_batch(
+          handle_, names, count, infos, errors, ring && ring->is_open() ? &ring->handle() : nullptr);
+    }
+
+    // Accessors
+    const file_handle& handle() const noexcept { return handle_; }
+
+    int fd() const noexcept { return handle_.fd; }
+
+    size_t buffer_size() const noexcept { return capacity_; }
+
+    bool is_open() const noexcept { return handle_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_DIRECTORY_HPP
@@ -0,0 +1,834 @@
+#ifndef ASYNCLE_IO_EVENT_LOOP_HPP
+#define ASYNCLE_IO_EVENT_LOOP_HPP
+
+#include "../../platform/file.hpp"
+#include "../../platform/hardware.hpp"
+#include "../../platform/process.hpp"
+#include "../async/task.hpp"
+#include "../async/work.hpp"
+#include "../hardware/topology.hpp"
+#include "async.hpp"
+#include "file.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include "ring.hpp"
+#include "timer_wheel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+// ============================================================================
+// Event Loop
+// ============================================================================
+
+struct event_loop_options {
+    uint32_t ring_entries        = 256;   // io_uring depth for file I/O; 0 = no ring (file I/O runs inline)
+    uint32_t timer_resolution_us = 1000;  // Timer wheel tick; deadlines round up to a whole tick
+};
+
+// What exited(child, deadline) does to a child still running at the deadline
+enum class timeout_action : uint8_t {
+    none,       // Leave it running
+    terminate,  // process::terminate() (SIGTERM), then wait for it to exit
+    kill        // SIGKILL, then wait for it to exit
+};
+
+namespace detail {
+
+// Fire-and-forget coroutine for event_loop::spawn: destroys itself on
+// completion and, like pool tasks, terminates on an escaping exception
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() noexcept {
+            return detached_task { std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+}  // namespace detail
+
+// Single-threaded run loop over one readiness multiplexer (epoll on Linux)
+// that drives everything the async layer can wait for:
+//
+// - file reads, writes and syncs through an io_ring whose completions signal
+//   an eventfd watched by the multiplexer (inline syscalls when io_uring is
+//   unavailable or ring_entries is 0)
+// - child process pipes and exits, armed oneshot per await
+// - timers and operation deadlines, kept in a timer_wheel behind one timerfd
+// - coroutines posted from other threads (schedule(), spawn()), which wake
+//   the loop through the same eventfd
+//
+//   event_loop loop;
+//   task<void> serve(event_loop& loop, file& log, process& child) {
+//       auto line = co_await loop.read(child, request);          // Pipe readiness
+//       co_await loop.write(log, log_request);                   // io_uring
+//       co_await loop.sleep_for(std::chrono::milliseconds(10));  // timerfd
+//       co_await loop.exited(child, loop.clock::now() + 5s);     // Terminated after 5 s
+//       co_await async::offload(pool, [&] { ... });              // CPU stage on a pool
+//       co_await loop.schedule();                                // Back on the loop
+//   }
+//   loop.run(serve(loop, log, child));
+//
+// All operations except schedule(), spawn(), wake() and stop() must be
+// started on the loop's thread; a coroutine that moved elsewhere comes back
+// with co_await loop.schedule(). Operations queued while the loop runs
+// coroutines reach the kernel in one submit when it next waits.
+//
+// File, pipe and process operations take an optional deadline and fail with
+// timed_out once it passes. Deadlines live in the same wheel as sleeps, so
+// scheduling and cancelling one is O(1) however many are pending; a file
+// operation that times out is cancelled in the ring and resumes when the
+// kernel lets go of its buffer.
+class event_loop {
+    public:
+    using clock = std::chrono::steady_clock;
+
+    // Readiness events handled per wait at most
+    static constexpr size_t max_batch = 64;
+
+    private:
+    using reactor_events = platform::process::reactor_events;
+
+    // Multiplexer tokens of the loop's own descriptors; operation pointers are
+    // aligned, so they never collide with these
+    static constexpr uint64_t wakeup_token = 1;
+    static constexpr uint64_t timer_token  = 2;
+    static constexpr uint64_t cancel_token = 3;  // Ring cancels queued for timed-out file operations
+
+    // Wheel entry; kind says what expiring means
+    struct loop_timer : timer_node {
+        enum class kind : uint8_t { sleep, ready, file } type;
+
+        explicit loop_timer(kind k) noexcept: type(k) {}
+    };
+
+    struct sleep_operation : loop_timer {
+        std::coroutine_handle<> handle;
+
+        sleep_operation() noexcept: loop_timer(kind::sleep) {}
+    };
+
+    struct file_operation : loop_timer {
+        std::coroutine_handle<> handle;
+        io_completion           completion;
+        bool                    timed_out = false;
+
+        file_operation() noexcept: loop_timer(kind::file) {}
+    };
+
+    struct ready_operation : loop_timer {
+        std::coroutine_handle<> handle;
+        reactor_events          events    = reactor_events::none;
+        int32_t                 fd        = -1;
+        bool                    timed_out = false;
+
+        ready_operation() noexcept: loop_timer(kind::ready) {}
+    };
+
+    io_ring                              ring_;
+    platform::process::reactor_handle    reactor_;
+    pipe_handle                          wakeup_;
+    pipe_handle                          timer_;
+    size_t                               file_in_flight_ = 0;
+    size_t                               pipe_in_flight_ = 0;
+    uint64_t                             resolution_ns_;
+    timer_wheel                          timers_;
+    std::vector<std::coroutine_handle<>> due_;  // Capacity reused across steps
+    uint64_t                             armed_deadline_ = 0;
+    detail::posted_queue                 posted_;
+    std::atomic<bool>                    signalled_ { false };
+    std::atomic<bool>                    stopped_ { false };
+    std::atomic<size_t>                  spawned_ { 0 };
+
+    static uint64_t to_ns(clock::time_point t) noexcept {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        return ns > 0 ? static_cast<uint64_t>(ns) : 1;
+    }
+
+    file_void_result queue(const file_handle& f, ring_op op, const io_request& request, uint64_t data) noexcept {
+        for(int attempt = 0; attempt < 2; ++attempt) {
+            auto queued = ring_.queue(f, op, &request, 1, data);
+            if(!queued) return file_void_result(unexpect, queued.error());
+            if(queued.value() == 1) {
+                ++file_in_flight_;
+                return file_void_result();
+            }
+            // Submission queue full: hand what is there to the kernel and retry
+            auto submitted = ring_.submit();
+            if(!submitted) return file_void_result(unexpect, submitted.error());
+        }
+        return file_void_result(unexpect, file_error(error_code::would_block));
+    }
+
+    process_void_result arm(int32_t fd, reactor_events interest, ready_operation* state) noexcept {
+        auto token = reinterpret_cast<uint64_t>(state);
+        interest   = interest | reactor_events::oneshot;
+        // Re-arm a descriptor registered by an earlier await, else register it
+        auto armed = platform::process::reactor_modify(reactor_, fd, token, interest);
+        if(!armed) armed = platform::process::reactor_add(reactor_, fd, token, interest);
+        if(armed) ++pipe_in_flight_;
+        return armed;
+    }
+
+    uint64_t now_tick() const noexcept { return to_ns(clock::now()) / resolution_ns_; }
+
+    // Keep the timerfd armed for the next wheel tick with work (disarmed when
+    // none); called once per step, so timers added or cancelled by the
+    // coroutines of one step cost at most one syscall
+    void rearm_timer() noexcept {
+        uint64_t next = timers_.empty() ? 0 : timers_.next_tick() * resolution_ns_;
+        if(next == armed_deadline_) return;
+        if(platform::process::arm_timer(timer_, next)) armed_deadline_ = next;
+    }
+
+    // Deadlines round up to a tick, so a timer never fires early
+    void add_timer(loop_timer& timer, uint64_t deadline_ns) noexcept {
+        timers_.schedule(timer, (deadline_ns + resolution_ns_ - 1) / resolution_ns_);
+    }
+
+    void expire(loop_timer& timer, std::vector<std::coroutine_handle<>>& due) noexcept {
+        switch(timer.type) {
+        case loop_timer::kind::sleep: due.push_back(static_cast<sleep_operation&>(timer).handle); break;
+        case loop_timer::kind::ready: {
+            // Disarm the descriptor so no event refers to the operation once it resumes
+            auto& op = static_cast<ready_operation&>(timer);
+            platform::process::reactor_remove(reactor_, op.fd);
+            op.timed_out = true;
+            due.push_back(op.handle);
+            --pipe_in_flight_;
+            break;
+        }
+        case loop_timer::kind::file: {
+            // The kernel still owns the buffer: cancel the request and resume
+            // the operation on its (cancelled) completion
+            auto&      op = static_cast<file_operation&>(timer);
+            io_request cancel {};
+            cancel.offset = reinterpret_cast<uint64_t>(&op);
+            op.timed_out  = true;
+            queue(file_handle {}, ring_op::cancel, cancel, cancel_token);
+            break;
+        }
+        }
+    }
+
+    // Fire every expired timer (in deadline order)
+    void expire_timers(std::vector<std::coroutine_handle<>>& due) {
+        timers_.advance(now_tick(), [&](timer_node& node) { expire(static_cast<loop_timer&>(node), due); });
+    }
+
+    // Reap finished file operations into due
+    void reap(std::vector<std::coroutine_handle<>>& due) {
+        while(file_in_flight_ != 0) {
+            io_completion completions[max_batch];
+            auto          reaped = ring_.complete(completions, max_batch, 0);
+            if(!reaped || reaped.value() == 0) return;
+            for(size_t i = 0; i < reaped.value(); ++i) {
+                --file_in_flight_;
+                if(completions[i].user_data == cancel_token) continue;
+                auto* state       = reinterpret_cast<file_operation*>(completions[i].user_data);
+                state->completion = completions[i];
+                timers_.cancel(*state);
+                due.push_back(state->handle);
+            }
+        }
+    }
+
+    public:
+    class io_awaiter {
+        event_loop&        loop_;
+        const file_handle& file_;
+        ring_op            op_;
+        io_request         request_;
+        uint64_t           deadline_ns_;
+        file_operation     state_ {};
+
+        // Without a ring the operation runs now and the await does not suspend
+        void run_inline() noexcept {
+            file_result<io_result> done = [&] {
+                switch(op_) {
+                case ring_op::read: return platform::file::read_file(file_, request_);
+                case ring_op::write: return platform::file::write_file(file_, request_);
+                default: {
+                    auto synced = platform::file::sync_file(file_, static_cast<sync_flags>(request_.flags));
+                    if(!synced) return file_result<io_result>(unexpect, synced.error());
+                    return file_result<io_result>(io_result {});
+                }
+                }
+            }();
+            if(done) {
+                state_.completion.result = done.value();
+            } else {
+                state_.completion.error = done.error();
+            }
+        }
+
+        public:
+        io_awaiter(
+          event_loop&        loop,
+          const file_handle& f,
+          ring_op            op,
+          const io_request&  request,
+          uint64_t           deadline_ns = 0) noexcept:
+            loop_(loop),
+            file_(f),
+            op_(op),
+            request_(request),
+            deadline_ns_(deadline_ns) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            if(!loop_.ring_.is_open()) {
+                run_inline();
+                return false;
+            }
+            state_.handle = awaiting;
+            auto queued   = loop_.queue(file_, op_, request_, reinterpret_cast<uint64_t>(&state_));
+            if(queued) {
+                if(deadline_ns_ != 0) loop_.add_timer(state_, deadline_ns_);
+                return true;
+            }
+            state_.completion.error = queued.error();
+            return false;
+        }
+
+        // An operation that finished before its cancel reached the kernel keeps its result
+        file_result<io_result> await_resume() const noexcept {
+            if(state_.completion.error.code != error_code::success) {
+                if(state_.timed_out) return file_result<io_result>(unexpect, file_error(error_code::timed_out));
+                return file_result<io_result>(unexpect, state_.completion.error);
+            }
+            return file_result<io_result>(state_.completion.result);
+        }
+    };
+
+    class ready_awaiter {
+        event_loop&     loop_;
+        int32_t         fd_;
+        reactor_events  interest_;
+        uint64_t        deadline_ns_;
+        ready_operation state_ {};
+        process_error   error_ {};
+
+        public:
+        ready_awaiter(event_loop& loop, int32_t fd, reactor_events interest, uint64_t deadline_ns = 0) noexcept:
+            loop_(loop),
+            fd_(fd),
+            interest_(interest),
+            deadline_ns_(deadline_ns) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            state_.handle = awaiting;
+            state_.fd     = fd_;
+            auto armed    = loop_.arm(fd_, interest_, &state_);
+            if(armed) {
+                if(deadline_ns_ != 0) loop_.add_timer(state_, deadline_ns_);
+                return true;
+            }
+            error_ = armed.error();
+            return false;
+        }
+
+        // True when ready, false on hangup or an error condition with nothing to read
+        process_result<bool> await_resume() const noexcept {
+            if(error_.code != process::error_code::success) return process_result<bool>(unexpect, error_);
+            if(state_.timed_out) {
+                return process_result<bool>(unexpect, process_error(process::error_code::timed_out));
+            }
+            return process_result<bool>(platform::process::has_event(state_.events, interest_));
+        }
+    };
+
+    class sleep_awaiter {
+        event_loop&     loop_;
+        uint64_t        deadline_ns_;
+        sleep_operation state_ {};
+
+        public:
+        sleep_awaiter(event_loop& loop, uint64_t deadline_ns) noexcept: loop_(loop), deadline_ns_(deadline_ns) {}
+
+        bool await_ready() const noexcept { return deadline_ns_ <= to_ns(clock::now()); }
+
+        void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            state_.handle = awaiting;
+            loop_.add_timer(state_, deadline_ns_);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    // Open the multiplexer, wakeup and timer handles and, when supported,
+    // the ring; check is_open() before use
+    explicit event_loop(const event_loop_options& options = {}) noexcept:
+        resolution_ns_(std::max<uint64_t>(1, uint64_t { options.timer_resolution_us } * 1000)),
+        timers_(to_ns(clock::now()) / resolution_ns_) {
+        auto reactor = platform::process::create_reactor();
+        auto wakeup  = platform::process::open_wakeup_handle();
+        auto timer   = platform::process::open_timer_handle();
+        if(reactor) reactor_ = reactor.value();
+        if(wakeup) wakeup_ = wakeup.value();
+        if(timer) timer_ = timer.value();
+        if(!is_open()) return;
+
+        platform::process::reactor_add(reactor_, wakeup_.fd, wakeup_token, reactor_events::readable);
+        platform::process::reactor_add(reactor_, timer_.fd, timer_token, reactor_events::readable);
+
+        // Ring completions signal the wakeup handle; without that the ring is
+        // useless here, so file I/O falls back to inline syscalls
+        if(options.ring_entries != 0 && file::capabilities().supports_async_io) {
+            ring_ = io_ring(options.ring_entries);
+            if(ring_.is_open() && !ring_.register_eventfd(wakeup_.fd)) ring_.close();
+        }
+    }
+
+    ~event_loop() {
+        ring_.close();
+        platform::process::close_pipe(timer_);
+        platform::process::close_pipe(wakeup_);
+        platform::process::destroy_reactor(reactor_);
+    }
+
+    event_loop(const event_loop&)            = delete;
+    event_loop& operator=(const event_loop&) = delete;
+
+    // File I/O; the file must stay open until the await finishes
+    io_awaiter read(const file& f, const io_request& request) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::read, request);
+    }
+
+    io_awaiter write(file& f, const io_request& request) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::write, request);
+    }
+
+    // With a deadline: timed_out once it passes (inline file I/O has none)
+    io_awaiter read(const file& f, const io_request& request, clock::time_point deadline) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::read, request, to_ns(deadline));
+    }
+
+    io_awaiter write(file& f, const io_request& request, clock::time_point deadline) noexcept {
+        return io_awaiter(*this, f.handle(), ring_op::write, request, to_ns(deadline));
+    }
+
+    io_awaiter sync(file& f, sync_flags flags = sync_flags::full_sync) noexcept {
+        io_request request {};
+        request.flags = static_cast<uint32_t>(flags);
+        return io_awaiter(*this, f.handle(), ring_op::sync, request);
+    }
+
+    // Pipe readiness; the pipe must stay open until the await finishes
+    ready_awaiter readable(const pipe_handle& pipe) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::readable);
+    }
+
+    ready_awaiter writable(const pipe_handle& pipe) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::writable);
+    }
+
+    ready_awaiter readable(const pipe_handle& pipe, clock::time_point deadline) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::readable, to_ns(deadline));
+    }
+
+    ready_awaiter writable(const pipe_handle& pipe, clock::time_point deadline) noexcept {
+        return ready_awaiter(*this, pipe.fd, reactor_events::writable, to_ns(deadline));
+    }
+
+    private:
+    async::task<process_result<process::io_result>>
+      read_until(process& child, process::io_request request, uint64_t deadline_ns) {
+        for(;;) {
+            auto got = child.read_stdout(request);
+            if(got || got.error().code != process::error_code::would_block) co_return got;
+            auto ready = co_await ready_awaiter(*this, child.stdout_pipe().fd, reactor_events::readable, deadline_ns);
+            if(!ready) co_return process_result<process::io_result>(unexpect, ready.error());
+        }
+    }
+
+    async::task<process_result<process::io_result>>
+      write_until(process& child, process::io_request request, uint64_t deadline_ns) {
+        for(;;) {
+            auto put = child.write_stdin(request);
+            if(put || put.error().code != process::error_code::would_block) co_return put;
+            auto ready = co_await ready_awaiter(*this, child.stdin_pipe().fd, reactor_events::writable, deadline_ns);
+            if(!ready) co_return process_result<process::io_result>(unexpect, ready.error());
+        }
+    }
+
+    public:
+    // Child stdout/stdin with would_block retried, as pipe_scheduler does
+    async::task<process_result<process::io_result>> read(process& child, process::io_request request) {
+        return read_until(child, request, 0);
+    }
+
+    async::task<process_result<process::io_result>> write(process& child, process::io_request request) {
+        return write_until(child, request, 0);
+    }
+
+    // With a deadline for the whole operation, however many retries it takes
+    async::task<process_result<process::io_result>>
+      read(process& child, process::io_request request, clock::time_point deadline) {
+        return read_until(child, request, to_ns(deadline));
+    }
+
+    async::task<process_result<process::io_result>>
+      write(process& child, process::io_request request, clock::time_point deadline) {
+        return write_until(child, request, to_ns(deadline));
+    }
+
+    // Complete once child has exited
+    async::task<process_void_result> exited(const process& child) {
+        auto exit = platform::process::open_exit_handle(child.handle());
+        if(!exit) co_return process_void_result(unexpect, exit.error());
+        pipe_handle handle = exit.value();
+        auto        ready  = co_await readable(handle);
+        platform::process::reactor_remove(reactor_, handle.fd);
+        platform::process::close_pipe(handle);
+        if(!ready) co_return process_void_result(unexpect, ready.error());
+        co_return process_void_result();
+    }
+
+    // Complete once child has exited, or fail with timed_out at the deadline.
+    // A child still running then gets on_timeout and is waited for, so it has
+    // exited (and can be reaped with wait()) when this fails with timed_out.
+    async::task<process_void_result>
+      exited(process& child, clock::time_point deadline, timeout_action on_timeout = timeout_action::terminate) {
+        auto exit = platform::process::open_exit_handle(child.handle());
+        if(!exit) co_return process_void_result(unexpect, exit.error());
+        pipe_handle handle = exit.value();
+        auto        ready  = co_await ready_awaiter(*this, handle.fd, reactor_events::readable, to_ns(deadline));
+        if(!ready && ready.error().code == process::error_code::timed_out && on_timeout != timeout_action::none) {
+            auto signalled = on_timeout == timeout_action::kill ? child.kill(SIGKILL) : child.terminate();
+            if(signalled) co_await readable(handle);
+        }
+        platform::process::reactor_remove(reactor_, handle.fd);
+        platform::process::close_pipe(handle);
+        if(!ready) co_return process_void_result(unexpect, ready.error());
+        co_return process_void_result();
+    }
+
+    // Timers, resumed on the loop thread once the deadline has passed
+    sleep_awaiter sleep_until(clock::time_point deadline) noexcept { return sleep_awaiter(*this, to_ns(deadline)); }
+
+    template <typename Rep, typename Period>
+    sleep_awaiter sleep_for(std::chrono::duration<Rep, Period> delay) noexcept {
+        return sleep_until(clock::now() + std::chrono::duration_cast<clock::duration>(delay));
+    }
+
+    // Scheduler for async_work that gives each operation started through it
+    // the same deadline:
+    //   auto timed = loop.with_timeout(50ms);
+    //   auto got   = co_await async::async_work(timed, f, read_command {}, request);
+    class deadline_scheduler {
+        event_loop&       loop_;
+        clock::time_point deadline_;
+
+        public:
+        deadline_scheduler(event_loop& loop, clock::time_point deadline) noexcept: loop_(loop), deadline_(deadline) {}
+
+        event_loop& loop() const noexcept { return loop_; }
+
+        clock::time_point deadline() const noexcept { return deadline_; }
+
+        friend io_awaiter tag_invoke(async::async_work_t, deadline_scheduler& sched, file& f, read_command,
+                                     const io_request& request) noexcept {
+            return sched.loop_.read(f, request, sched.deadline_);
+        }
+
+        friend io_awaiter tag_invoke(async::async_work_t, deadline_scheduler& sched, file& f, write_command,
+                                     const io_request& request) noexcept {
+            return sched.loop_.write(f, request, sched.deadline_);
+        }
+
+        friend async::task<process_result<process::io_result>>
+          tag_invoke(async::async_work_t, deadline_scheduler& sched, process& child, pipe_read_command,
+                     const process::io_request& request) {
+            return sched.loop_.read(child, request, sched.deadline_);
+        }
+
+        friend async::task<process_result<process::io_result>>
+          tag_invoke(async::async_work_t, deadline_scheduler& sched, process& child, pipe_write_command,
+                     const process::io_request& request) {
+            return sched.loop_.write(child, request, sched.deadline_);
+        }
+    };
+
+    deadline_scheduler with_deadline(clock::time_point deadline) noexcept {
+        return deadline_scheduler(*this, deadline);
+    }
+
+    template <typename Rep, typename Period>
+    deadline_scheduler with_timeout(std::chrono::duration<Rep, Period> timeout) noexcept {
+        return with_deadline(clock::now() + std::chrono::duration_cast<clock::duration>(timeout));
+    }
+
+    // ------------------------------------------------------------------------
+    // Cross-thread entry points
+    // ------------------------------------------------------------------------
+
+    // Interrupt a blocked wait; one eventfd write per batch of posts
+    void wake() noexcept {
+        if(!signalled_.exchange(true, std::memory_order_acq_rel)) platform::process::signal_wakeup(wakeup_);
+    }
+
+    // co_await loop.schedule(): continue on the loop thread
+    auto schedule() noexcept {
+        struct awaiter {
+            event_loop& loop;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> awaiting) {
+                loop.posted_.post(awaiting);
+                loop.wake();
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return awaiter { *this };
+    }
+
+    // Start t on the loop thread and let it run detached; the loop owns it
+    void spawn(async::task<void> t) {
+        auto body = [](event_loop& loop, async::task<void> inner) -> detail::detached_task {
+            co_await std::move(inner);
+            loop.spawned_.fetch_sub(1, std::memory_order_release);
+        };
+        spawned_.fetch_add(1, std::memory_order_relaxed);
+        posted_.post(body(*this, std::move(t)).handle);
+        wake();
+    }
+
+    // Make run() return after its current iteration
+    void stop() noexcept {
+        stopped_.store(true, std::memory_order_release);
+        wake();
+    }
+
+    // ------------------------------------------------------------------------
+    // Driving (loop thread)
+    // ------------------------------------------------------------------------
+
+    // One loop iteration: submit queued file I/O, wait for readiness (for up
+    // to timeout_ms: -1 = until something happens, 0 = poll) and resume every
+    // coroutine whose operation finished. Returns how many were resumed.
+    size_t step(int timeout_ms = -1) {
+        if(file_in_flight_ != 0) ring_.submit();
+        if(!posted_.empty()) timeout_ms = 0;
+        rearm_timer();
+
+        platform::process::reactor_event events[max_batch];
+        auto ready = platform::process::reactor_wait(reactor_, events, max_batch, timeout_ms);
+
+        std::vector<std::coroutine_handle<>> due;
+        due.swap(due_);
+        bool woken = false, fired = false;
+        for(size_t i = 0; ready && i < ready.value(); ++i) {
+            if(events[i].token == wakeup_token) {
+                woken = true;
+            } else if(events[i].token == timer_token) {
+                fired = true;
+            } else {
+                auto* state   = reinterpret_cast<ready_operation*>(events[i].token);
+                state->events = events[i].events;
+                timers_.cancel(*state);
+                due.push_back(state->handle);
+                --pipe_in_flight_;
+            }
+        }
+
+        // Drain before collecting, so anything signalled afterwards wakes the next wait
+        if(woken) {
+            platform::process::drain_event_handle(wakeup_);
+            signalled_.exchange(false, std::memory_order_acq_rel);
+        }
+        if(fired) {
+            platform::process::drain_event_handle(timer_);
+            armed_deadline_ = 0;  // The timerfd is disarmed once it fires
+        }
+        reap(due);
+        if(fired || (!timers_.empty() && timers_.next_tick() <= now_tick())) expire_timers(due);
+
+        // Resume only after bookkeeping, since a resumed coroutine may start more
+        for(auto handle : due) handle.resume();
+        size_t resumed = due.size();
+        due.clear();
+        due_.swap(due);
+        return resumed + posted_.run();
+    }
+
+    // Non-blocking iteration
+    size_t poll() { return step(0); }
+
+    // Drive a (typically a task) on this thread until it finishes
+    template <typename A>
+    requires async::awaitable<A>
+    async::await_result_t<A> run(A&& a) {
+        struct state {
+            event_loop*       loop;
+            std::atomic<bool> done { false };
+        } st { this };
+
+        async::detail::awaited_slot<A> slot;
+        async::detail::notifying_task  body = async::detail::await_into(std::forward<A>(a), slot);
+        body.handle.promise().context       = &st;
+        body.handle.promise().notify        = [](void* p) noexcept {
+            auto* s = static_cast<state*>(p);
+            s->done.store(true, std::memory_order_release);
+            s->loop->wake();
+        };
+
+        body.handle.resume();
+        while(!st.done.load(std::memory_order_acquire)) step(-1);
+        body.handle.destroy();
+        return slot.take();
+    }
+
+    // Serve spawned tasks and posted coroutines until stop()
+    void run() {
+        while(!stopped_.load(std::memory_order_acquire)) step(-1);
+        stopped_.store(false, std::memory_order_relaxed);
+    }
+
+    // State queries
+    bool is_open() const noexcept { return reactor_.is_valid() && wakeup_.is_valid() && timer_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // File I/O goes through io_uring (else inline syscalls)
+    bool has_ring() const noexcept { return ring_.is_open(); }
+
+    // File and pipe operations waiting on the kernel
+    size_t in_flight() const noexcept { return file_in_flight_ + pipe_in_flight_; }
+
+    // Sleeps and operation deadlines not fired or cancelled yet
+    size_t timers_pending() const noexcept { return timers_.size(); }
+
+    // Spawned tasks not finished yet
+    size_t spawned() const noexcept { return spawned_.load(std::memory_order_acquire); }
+
+    // CPO integration: async_work(loop, file|process, command, request)
+    friend io_awaiter tag_invoke(async::async_work_t, event_loop& loop, file& f, read_command,
+                                 const io_request& request) noexcept {
+        return loop.read(f, request);
+    }
+
+    friend io_awaiter tag_invoke(async::async_work_t, event_loop& loop, file& f, write_command,
+                                 const io_request& request) noexcept {
+        return loop.write(f, request);
+    }
+
+    friend async::task<process_result<process::io_result>>
+      tag_invoke(async::async_work_t, event_loop& loop, process& child, pipe_read_command,
+                 const process::io_request& request) {
+        return loop.read(child, request);
+    }
+
+    friend async::task<process_result<process::io_result>>
+      tag_invoke(async::async_work_t, event_loop& loop, process& child, pipe_write_command,
+                 const process::io_request& request) {
+        return loop.write(child, request);
+    }
+};
+
+// ============================================================================
+// Loop Group
+// ============================================================================
+
+struct event_loop_group_options {
+    size_t             loops = 0;     // 0 = one per physical core in the affinity mask
+    bool               pin   = true;  // Pin loop i to the i-th CPU of the topology's placement order
+    event_loop_options loop {};
+};
+
+// One event_loop per core, each on its own thread. CPUs come from
+// hardware::cpu_topology::placement_order(), so loops spread across NUMA
+// nodes and physical cores before SMT siblings.
+//
+//   event_loop_group loops;
+//   loops.next().spawn(handle_connection(...));        // Round-robin placement
+//   co_await loops.at(shard).schedule();               // Hop to a specific loop
+class event_loop_group {
+    std::vector<std::unique_ptr<event_loop>> loops_;
+    std::vector<std::thread>                 threads_;
+    std::atomic<size_t>                      next_ { 0 };
+
+    static inline thread_local event_loop* current_ = nullptr;
+
+    public:
+    explicit event_loop_group(const event_loop_group_options& options = {}) {
+        const auto& topo  = hardware::cpu_topology::current();
+        auto        order = topo.placement_order();
+
+        size_t count = options.loops;
+        if(count == 0) {
+            for(const auto& loc : topo.cpus()) count += loc.allowed && loc.smt_index == 0;
+        }
+        if(count == 0) count = std::max(1u, std::thread::hardware_concurrency());
+
+        loops_.reserve(count);
+        for(size_t i = 0; i < count; ++i) loops_.push_back(std::make_unique<event_loop>(options.loop));
+
+        threads_.reserve(count);
+        for(size_t i = 0; i < count; ++i) {
+            bool     pin = options.pin && !order.empty();
+            uint32_t cpu = pin ? order[i % order.size()] : 0;
+            threads_.emplace_back([loop = loops_[i].get(), pin, cpu] {
+                if(pin) platform::hardware::pin_current_thread(cpu);
+                current_ = loop;
+                loop->run();
+                current_ = nullptr;
+            });
+        }
+    }
+
+    ~event_loop_group() { stop(); }
+
+    event_loop_group(const event_loop_group&)            = delete;
+    event_loop_group& operator=(const event_loop_group&) = delete;
+
+    // Stop every loop and join its thread; detached tasks still suspended are leaked
+    void stop() noexcept {
+        for(auto& loop : loops_) loop->stop();
+        for(auto& thread : threads_) {
+            if(thread.joinable()) thread.join();
+        }
+        threads_.clear();
+    }
+
+    size_t size() const noexcept { return loops_.size(); }
+
+    event_loop& at(size_t i) noexcept { return *loops_[i]; }
+
+    // Round-robin choice for new work
+    event_loop& next() noexcept { return *loops_[next_.fetch_add(1, std::memory_order_relaxed) % loops_.size()]; }
+
+    // Loop of the calling thread, nullptr off the group's threads
+    static event_loop* current() noexcept { return current_; }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_EVENT_LOOP_HPP
@@ -0,0 +1,227 @@
+#ifndef ASYNCLE_IO_EXTENTS_HPP
+#define ASYNCLE_IO_EXTENTS_HPP
+
+// asyncle::io extents - Sparse-file aware iteration, copy and scan
+//
+// extent_iterator walks the data extents of a file with SEEK_DATA/SEEK_HOLE.
+// Extents are filesystem-block granular, so the block that ends an extent
+// may hold zeros past the last byte written. Where the file or filesystem
+// cannot report holes, the rest of the file comes back as one extent, so
+// callers work the same everywhere and only lose the savings.
+//
+// sparse_copy() copies only the data extents (copy_file_range, or splice
+// when the kernel refuses) and leaves holes in the destination where the
+// source has them. scan_data() maps only the data extents through a
+// mapped_reader, so holes are never read.
+//
+// SEEK_DATA and SEEK_HOLE move the descriptor's file position; positional
+// reads and writes are unaffected.
+//
+// Usage:
+//   io::file image("disk.img", io::access_mode::read_only);
+//   io::file copy("disk.copy", io::mode(io::access_mode::read_write, io::access_mode::create));
+//   auto stats = io::sparse_copy(image, copy);        // stats->bytes_skipped were holes
+//
+//   io::scan_data(image, [](uint64_t offset, std::span<const std::byte> bytes) { ... });
+
+#include "file.hpp"
+#include "mapped_reader.hpp"
+#include "result.hpp"
+#include "stream.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace asyncle::io {
+
+struct file_extent {
+    uint64_t offset = 0;
+    uint64_t length = 0;  // 0 once the iterator is exhausted
+
+    uint64_t end() const noexcept { return offset + length; }
+};
+
+// Data extents of [offset, offset + length) of a file, in file order.
+// The file must outlive the iterator; it is not owned.
+class extent_iterator {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    const file* file_   = nullptr;
+    uint64_t    cursor_ = 0;
+    uint64_t    end_    = 0;
+
+    // EINVAL from SEEK_DATA: this file's filesystem has no hole reporting
+    static bool seek_refused(const file_error& e) noexcept {
+        return e.code == error_code::invalid_argument || e.code == error_code::not_supported;
+    }
+
+    file_extent finish(uint64_t start, uint64_t stop) noexcept {
+        cursor_ = stop;
+        return file_extent { start, stop - start };
+    }
+
+    public:
+    // Constructors
+    extent_iterator() noexcept = default;
+
+    explicit extent_iterator(const file& f, uint64_t offset = 0, uint64_t length = 0) noexcept {
+        reset(f, offset, length);
+    }
+
+    // Start over on [offset, offset + length) of f (length 0 = to the end of the file)
+    file_void_result reset(const file& f, uint64_t offset = 0, uint64_t length = 0) noexcept {
+        file_ = nullptr;
+        auto size = f.size();
+        if(!f.is_open() || !size) { return file_void_result(unexpect, file_error(error_code::invalid_argument)); }
+        file_   = &f;
+        cursor_ = std::min(offset, *size);
+        end_    = (length == 0 || length > *size - cursor_) ? *size : cursor_ + length;
+        return file_void_result();
+    }
+
+    // Next data extent; a zero length (at the end offset) means no more data
+    file_result<file_extent> next() noexcept {
+        if(!file_) { return file_result<file_extent>(unexpect, file_error(error_code::invalid_argument)); }
+        if(cursor_ >= end_) return file_extent { end_, 0 };
+
+        const auto& handle = file_->handle();
+        auto        data   = platform::file::seek_file(handle, static_cast<int64_t>(cursor_), seek_origin::data);
+        if(!data) {
+            if(data.error().platform_errno == ENXIO) return finish(end_, end_);  // Only a hole remains
+            if(seek_refused(data.error())) return finish(cursor_, end_);
+            return file_result<file_extent>(unexpect, data.error());
+        }
+        if(*data >= end_) return finish(end_, end_);
+
+        auto hole = platform::file::seek_file(handle, static_cast<int64_t>(*data), seek_origin::hole);
+        if(!hole) return file_result<file_extent>(unexpect, hole.error());
+        return finish(*data, std::min(*hole, end_));
+    }
+
+    // Accessors
+    uint64_t position() const noexcept { return cursor_; }
+
+    bool done() const noexcept { return cursor_ >= end_; }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+struct sparse_copy_stats {
+    uint64_t bytes_copied  = 0;  // Data extent bytes copied
+    uint64_t bytes_skipped = 0;  // Hole bytes neither read nor written
+    uint64_t extents       = 0;
+};
+
+namespace detail {
+
+// Make [offset, offset + length) of out read as zeros: punch a hole, or write
+// zeros where the filesystem cannot
+inline file_void_result zero_range(file& out, uint64_t offset, uint64_t length) noexcept {
+    auto punched = out.deallocate(offset, length);
+    if(punched || (punched.error().code != error_code::not_supported && punched.error().platform_errno != EOPNOTSUPP)) {
+        return punched;
+    }
+    static constexpr char zeros[64 * 1024] = {};
+    while(length > 0) {
+        auto written = out.write(zeros, std::min<uint64_t>(length, sizeof(zeros)), offset);
+        if(!written) return file_void_result(unexpect, written.error());
+        offset += *written;
+        length -= *written;
+    }
+    return file_void_result();
+}
+
+}  // namespace detail
+
+// Copy all of in to out, holes included: data extents are copied in-kernel and
+// the ranges between them become holes in out. out ends up exactly in's size;
+// whatever it held before is replaced.
+inline file_result<sparse_copy_stats> sparse_copy(const file& in, file& out) noexcept {
+    auto size     = in.size();
+    auto previous = out.size();
+    if(!in.is_open() || !out.is_open() || !size || !previous) {
+        return file_result<sparse_copy_stats>(unexpect, file_error(error_code::invalid_argument));
+    }
+    // Extending leaves a hole; only ranges out already had need punching
+    if(auto sized = out.truncate(*size); !sized) return file_result<sparse_copy_stats>(unexpect, sized.error());
+    const uint64_t written_before = std::min(*previous, *size);
+
+    extent_iterator   extents(in);
+    stream_transfer   transfer;
+    sparse_copy_stats stats;
+    uint64_t          at = 0;
+    for(;;) {
+        auto extent = extents.next();
+        if(!extent) return file_result<sparse_copy_stats>(unexpect, extent.error());
+
+        const uint64_t gap_end = extent->length ? extent->offset : *size;
+        if(gap_end > at) {
+            stats.bytes_skipped += gap_end - at;
+            if(at < written_before) {
+                auto zeroed = detail::zero_range(out, at, std::min(gap_end, written_before) - at);
+                if(!zeroed) return file_result<sparse_copy_stats>(unexpect, zeroed.error());
+            }
+        }
+        if(extent->length == 0) break;
+
+        for(uint64_t done = 0; done < extent->length;) {
+            const uint64_t offset = extent->offset + done;
+            auto copied = transfer.copy(in, offset, out, offset, static_cast<size_t>(extent->length - done));
+            if(!copied) return file_result<sparse_copy_stats>(unexpect, copied.error());
+            if(*copied == 0) return file_result<sparse_copy_stats>(unexpect, file_error(error_code::io_error));
+            done += *copied;
+        }
+        stats.bytes_copied += extent->length;
+        ++stats.extents;
+        at = extent->end();
+    }
+    return stats;
+}
+
+// Visit only the data extents of f through a sliding mmap window: on_data is
+// called as on_data(uint64_t offset, std::span<const std::byte> bytes) with
+// consecutive pieces of each extent, split where windows end. Returns the data
+// bytes visited.
+template <typename F>
+file_result<uint64_t>
+  scan_data(const file& f, F&& on_data, size_t window_size = mapped_reader::default_window_size) {
+    auto size = f.size();
+    if(!f.is_open() || !size) { return file_result<uint64_t>(unexpect, file_error(error_code::invalid_argument)); }
+    if(*size == 0) return uint64_t { 0 };
+
+    mapped_reader reader;
+    if(auto opened = reader.open(f, window_size); !opened) {
+        return file_result<uint64_t>(unexpect, detail::to_file_error(opened.error()));
+    }
+    extent_iterator extents(f);
+    uint64_t        visited = 0;
+    for(;;) {
+        auto extent = extents.next();
+        if(!extent) return file_result<uint64_t>(unexpect, extent.error());
+        if(extent->length == 0) break;
+
+        reader.seek(extent->offset);
+        for(uint64_t left = extent->length; left > 0;) {
+            auto view = reader.next(static_cast<size_t>(left));
+            if(!view) return file_result<uint64_t>(unexpect, detail::to_file_error(view.error()));
+            if(view->empty()) break;  // The file shrank under us
+            on_data(reader.position() - view->size(), *view);
+            left    -= view->size();
+            visited += view->size();
+        }
+    }
+    return visited;
+}
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_EXTENTS_HPP
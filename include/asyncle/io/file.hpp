@@ -2,8 +2,14 @@
 #define ASYNCLE_IO_FILE_HPP
 
 #include "../../platform/file.hpp"
+#include "../instrument.hpp"
+#include "../meta/dispatch.hpp"
 #include "result.hpp"
+#include "ring.hpp"
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <ranges>
 #include <span>
 #include <string_view>
 #include <utility>
@@ -12,6 +18,7 @@ namespace asyncle::io {
 
 // Import platform types
 using platform::file::access_mode;
+using platform::file::dio_alignment;
 using platform::file::error_code;
 using platform::file::error_domain;
 using platform::file::expected;
@@ -116,7 +123,10 @@ class file {
     // I/O operations
     file_result<io_result> read(const io_request& request) const noexcept {
         if(!is_open()) { return file_result<io_result>(unexpect, file_error(error_code::invalid_argument)); }
-        return platform::file::read_file(handle_, request);
+        instrument::scope timed(instrument::op::file_read);
+        auto              result = platform::file::read_file(handle_, request);
+        timed.done(result.has_value(), result ? result->bytes_transferred : 0);
+        return result;
     }
 
     file_result<size_t> read(void* buffer, size_t length, uint64_t offset = static_cast<uint64_t>(-1)) const noexcept {
@@ -131,7 +141,10 @@ class file {
 
     file_result<io_result> write(const io_request& request) noexcept {
         if(!is_open()) { return file_result<io_result>(unexpect, file_error(error_code::invalid_argument)); }
-        return platform::file::write_file(handle_, request);
+        instrument::scope timed(instrument::op::file_write);
+        auto              result = platform::file::write_file(handle_, request);
+        timed.done(result.has_value(), result ? result->bytes_transferred : 0);
+        return result;
     }
 
     file_result<size_t> write(const void* buffer, size_t length, uint64_t offset = static_cast<uint64_t>(-1)) noexcept {
@@ -144,15 +157,115 @@ class file {
         return file_result<size_t>(unexpect, result.error());
     }
 
+    // Write all length bytes, continuing after short writes; io_error when the
+    // file stops taking data
+    file_result<size_t>
+      write_all(const void* buffer, size_t length, uint64_t offset = static_cast<uint64_t>(-1)) noexcept {
+        const auto* bytes = static_cast<const std::byte*>(buffer);
+        size_t      total = 0;
+        while(total < length) {
+            auto done = write(bytes + total, length - total, offset);
+            if(!done) return done;
+            if(*done == 0) return file_result<size_t>(unexpect, file_error(error_code::io_error));
+            total += *done;
+            if(offset != static_cast<uint64_t>(-1)) offset += *done;
+        }
+        return file_result<size_t>(total);
+    }
+
+    // Write every element of a range of trivially copyable values back to back
+    // from offset (or the current position); returns the bytes written.
+    // Contiguous ranges go out as one write (repeated only after a short one);
+    // other ranges are copied through a small stack buffer so that each write
+    // carries many elements.
+    template <std::ranges::input_range R>
+    requires dispatches_to<element_dispatch, std::ranges::range_value_t<R>, trivial_copy_path>
+    file_result<size_t> write_range(R&& values, uint64_t offset = static_cast<uint64_t>(-1)) noexcept {
+        using value_type = std::ranges::range_value_t<R>;
+        if constexpr(dispatches_to<range_dispatch, R, contiguous_path>) {
+            return write_all(std::ranges::data(values), std::ranges::size(values) * sizeof(value_type), offset);
+        } else {
+            constexpr size_t stage_bytes = 4096;
+            constexpr size_t per_stage   = sizeof(value_type) < stage_bytes ? stage_bytes / sizeof(value_type) : 1;
+            alignas(value_type) std::byte stage[per_stage * sizeof(value_type)];
+
+            size_t total  = 0;
+            size_t staged = 0;
+            auto   drain  = [&]() noexcept -> file_result<size_t> {
+                auto done = write_all(stage, staged * sizeof(value_type), offset);
+                if(!done) return done;
+                total += *done;
+                if(offset != static_cast<uint64_t>(-1)) offset += *done;
+                staged = 0;
+                return done;
+            };
+            for(auto&& value : values) {
+                const value_type copy = value;
+                std::memcpy(stage + staged * sizeof(value_type), &copy, sizeof(value_type));
+                if(++staged == per_stage) {
+                    if(auto done = drain(); !done) return done;
+                }
+            }
+            if(staged) {
+                if(auto done = drain(); !done) return done;
+            }
+            return file_result<size_t>(total);
+        }
+    }
+
     // Vectored I/O
     file_result<io_result> readv(const io_request* requests, size_t count) const noexcept {
         if(!is_open()) { return file_result<io_result>(unexpect, file_error(error_code::invalid_argument)); }
-        return platform::file::read_vectored(handle_, requests, count);
+        instrument::scope timed(instrument::op::file_read);
+        auto              result = platform::file::read_vectored(handle_, requests, count);
+        timed.done(result.has_value(), result ? result->bytes_transferred : 0);
+        return result;
     }
 
     file_result<io_result> writev(const io_request* requests, size_t count) noexcept {
         if(!is_open()) { return file_result<io_result>(unexpect, file_error(error_code::invalid_argument)); }
-        return platform::file::write_vectored(handle_, requests, count);
+        instrument::scope timed(instrument::op::file_write);
+        auto              result = platform::file::write_vectored(handle_, requests, count);
+        timed.done(result.has_value(), result ? result->bytes_transferred : 0);
+        return result;
+    }
+
+    // Asynchronous ring I/O - requests are queued on the ring and complete with
+    // user_data + i; nothing reaches the kernel until ring.submit()
+    file_result<size_t>
+      queue_read(io_ring& ring, const io_request* requests, size_t count, uint64_t user_data = 0) const noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+        return ring.queue(handle_, ring_op::read, requests, count, user_data);
+    }
+
+    file_result<size_t>
+      queue_write(io_ring& ring, const io_request* requests, size_t count, uint64_t user_data = 0) noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+        return ring.queue(handle_, ring_op::write, requests, count, user_data);
+    }
+
+    // The sync drains the ring: it starts only once every request submitted
+    // before it has completed, so it covers earlier queued writes
+    file_result<size_t>
+      queue_sync(io_ring& ring, uint64_t user_data = 0, sync_flags flags = sync_flags::full_sync) noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+        io_request req {};
+        req.flags = static_cast<uint32_t>(flags);
+        return ring.queue(handle_, ring_op::sync, &req, 1, user_data);
+    }
+
+    // Fixed-buffer variants - io_request::buffer_index selects a buffer registered
+    // with the ring (see dio_buffer_pool::register_with)
+    file_result<size_t>
+      queue_read_fixed(io_ring& ring, const io_request* requests, size_t count, uint64_t user_data = 0) const noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+        return ring.queue(handle_, ring_op::read_fixed, requests, count, user_data);
+    }
+
+    file_result<size_t>
+      queue_write_fixed(io_ring& ring, const io_request* requests, size_t count, uint64_t user_data = 0) noexcept {
+        if(!is_open()) { return file_result<size_t>(unexpect, file_error(error_code::invalid_argument)); }
+        return ring.queue(handle_, ring_op::write_fixed, requests, count, user_data);
     }
 
     // File positioning
@@ -210,6 +323,12 @@ class file {
         return platform::file::advise_file(handle_, offset, length, advice);
     }
 
+    // Queue [offset, offset + length) for reading into the page cache; returns before the I/O completes
+    file_void_result readahead(uint64_t offset, uint64_t length) noexcept {
+        if(!is_open()) { return file_void_result(unexpect, file_error(error_code::invalid_argument)); }
+        return platform::file::readahead_file(handle_, offset, length);
+    }
+
     // Zero-copy operations
     file_result<size_t>
       splice_to(file& out, uint64_t* in_offset, uint64_t* out_offset, size_t length, uint32_t flags = 0) noexcept {
@@ -237,12 +356,23 @@ class file {
         return platform::file::get_file_size(handle_);
     }
 
+    // Buffer and offset alignment required when opened with access_mode::direct
+    file_result<dio_alignment> direct_io_alignment() const noexcept {
+        if(!is_open()) { return file_result<dio_alignment>(unexpect, file_error(error_code::invalid_argument)); }
+        return platform::file::query_dio_alignment(handle_);
+    }
+
     // Static utilities
     static file_result<file_info> stat(const char* path, bool follow_symlinks = true) noexcept {
         return platform::file::stat_path(path, follow_symlinks);
     }
 
-    static file_caps capabilities() noexcept { return platform::file::query_file_caps(); }
+    // Probed once per process (see asyncle/system.hpp); query_file_caps() sets
+    // up a throwaway io_uring on every call
+    static const file_caps& capabilities() noexcept {
+        static const file_caps caps = platform::file::query_file_caps();
+        return caps;
+    }
 
     // Accessors
     const file_handle& handle() const noexcept { return handle_; }
@@ -0,0 +1,225 @@
+#ifndef ASYNCLE_IO_GROWABLE_MAPPING_HPP
+#define ASYNCLE_IO_GROWABLE_MAPPING_HPP
+
+#include "../../platform/mmap.hpp"
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace asyncle::io {
+
+// Shared read_write mapping of a file that grows in place.
+// open() reserves a large range of address space (PROT_NONE, nothing
+// committed) and maps the file over its start. grow() extends the file, then
+// maps only the new pages with MAP_FIXED over the next part of the
+// reservation, so the base address never changes and pointers into the
+// mapping stay valid for its lifetime. The kernel merges the pieces into one
+// VMA when their file offsets line up.
+//
+// grow() preallocates with allocate() (fallocate) so a full disk fails the
+// grow instead of raising SIGBUS on a later store; filesystems without
+// fallocate fall back to truncate(). Grow in chunks (e.g. doubling) rather
+// than per append: each grow costs two system calls.
+//
+// The file must outlive the mapping; it is not owned. Not thread-safe, but
+// other threads may keep using memory below size() while one thread grows.
+class growable_mapping {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = memory_error;
+    template <typename T>
+    using result_type = mmap_result<T>;
+
+    static constexpr size_t default_reserve = size_t { 1 } << 36;  // 64 GiB of address space
+
+    private:
+    file*         file_ = nullptr;
+    memory_region reservation_;  // Whole reserved range, unmapped as one
+    memory_region region_;       // File-backed prefix, for sync
+    uint64_t      size_ = 0;     // File size; region_.length is this rounded up to a page
+    size_t        page_ = 0;
+
+    uint64_t round_to_page(uint64_t bytes) const noexcept { return (bytes + page_ - 1) / page_ * page_; }
+
+    static memory_error file_failure(const file_error& e) noexcept {
+        return memory_error(mmap_access::error_domain::system, mmap_access::error_code::io_error, e.platform_errno);
+    }
+
+    // Map file pages [offset, offset + length) at the same offset in the reservation
+    mmap_void_result map_pages(size_t offset, size_t length) noexcept {
+        memory_request req {};
+        req.length       = length;
+        req.offset       = offset;
+        req.address_hint = static_cast<char*>(reservation_.address) + offset;
+        req.placement    = mmap_access::placement_strategy::fixed_address;  // Our own PROT_NONE range
+        req.backing      = backing_type::file_backed;
+        req.access       = region_.actual_access;
+        req.sharing      = sharing_mode::shared;
+
+        auto mapped = platform::mmap::map_memory(file_->fd(), req);
+        if(!mapped) return mmap_void_result(unexpect, mapped.error());
+        region_.length = offset + mapped->length;
+        return mmap_void_result();
+    }
+
+    public:
+    // Constructors
+    growable_mapping() noexcept = default;
+
+    explicit growable_mapping(
+      file&                    f,
+      size_t                   reserve_bytes = default_reserve,
+      mmap_access::access_mode access        = mmap_access::access_mode::read_write) noexcept {
+        open(f, reserve_bytes, access);
+    }
+
+    // Move semantics
+    growable_mapping(growable_mapping&& other) noexcept:
+        file_(std::exchange(other.file_, nullptr)),
+        reservation_(std::exchange(other.reservation_, memory_region {})),
+        region_(std::exchange(other.region_, memory_region {})),
+        size_(std::exchange(other.size_, 0)),
+        page_(other.page_) {}
+
+    growable_mapping& operator=(growable_mapping&& other) noexcept {
+        if(this != &other) {
+            close();
+            file_        = std::exchange(other.file_, nullptr);
+            reservation_ = std::exchange(other.reservation_, memory_region {});
+            region_      = std::exchange(other.region_, memory_region {});
+            size_        = std::exchange(other.size_, 0);
+            page_        = other.page_;
+        }
+        return *this;
+    }
+
+    // No copy
+    growable_mapping(const growable_mapping&)            = delete;
+    growable_mapping& operator=(const growable_mapping&) = delete;
+
+    // Destructor
+    ~growable_mapping() { close(); }
+
+    // Core operations
+    // Reserve reserve_bytes of address space and map the file's current contents
+    mmap_void_result open(
+      file&                    f,
+      size_t                   reserve_bytes = default_reserve,
+      mmap_access::access_mode access        = mmap_access::access_mode::read_write) noexcept {
+        close();
+        auto size = f.size();
+        if(!f.is_open() || !size) {
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        page_                = mmap::page_size();
+        const size_t reserve = round_to_page(reserve_bytes);
+        if(reserve == 0 || round_to_page(*size) > reserve) {
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+
+        memory_request req {};  // Address space only: PROT_NONE pages are never committed
+        req.length  = reserve;
+        req.backing = backing_type::anonymous;
+        req.access  = mmap_access::access_mode::none;
+        req.sharing = sharing_mode::private_cow;
+        req.commit  = mmap_access::commit_strategy::lazy_commit;
+        auto reserved = platform::mmap::map_memory(-1, req);
+        if(!reserved) return mmap_void_result(unexpect, reserved.error());
+
+        file_                   = &f;
+        reservation_            = *reserved;
+        region_                 = memory_region {};
+        region_.address         = reservation_.address;
+        region_.file_descriptor = f.fd();
+        region_.actual_access   = access;
+        region_.actual_sharing  = sharing_mode::shared;
+        region_.supports_sync   = true;
+        size_                   = *size;
+        if(size_ == 0) return mmap_void_result();
+
+        auto mapped = map_pages(0, round_to_page(size_));
+        if(!mapped) close();
+        return mapped;
+    }
+
+    // Extend the file to new_size bytes and map the added pages in place.
+    // Smaller sizes are a no-op; the file never shrinks.
+    mmap_void_result grow(uint64_t new_size) noexcept {
+        if(!is_open()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
+        if(new_size <= size_) return mmap_void_result();
+        if(new_size > reservation_.length || round_to_page(new_size) > reservation_.length) {
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::no_memory));
+        }
+
+        auto extended = file_->allocate(size_, new_size - size_);
+        if(!extended
+           && (extended.error().code == platform::file::error_code::not_supported
+               || extended.error().platform_errno == EOPNOTSUPP)) {
+            extended = file_->truncate(new_size);
+        }
+        if(!extended) return mmap_void_result(unexpect, file_failure(extended.error()));
+
+        const size_t mapped = region_.length;
+        const size_t wanted = round_to_page(new_size);
+        if(wanted > mapped) {
+            auto added = map_pages(mapped, wanted - mapped);
+            if(!added) return added;
+        }
+        size_ = new_size;
+        return mmap_void_result();
+    }
+
+    // Release the whole reservation; the file keeps its size
+    void close() noexcept {
+        if(reservation_.address) platform::mmap::unmap_memory(reservation_);
+        file_        = nullptr;
+        reservation_ = memory_region {};
+        region_      = memory_region {};
+        size_        = 0;
+    }
+
+    // Memory synchronization
+    mmap_void_result sync() noexcept {
+        if(region_.length == 0) return mmap_void_result();
+        return platform::mmap::sync_memory(region_);
+    }
+
+    mmap_void_result sync_range(size_t offset, size_t length, flush_mode mode = flush_mode::sync_flush) noexcept {
+        return platform::mmap::sync_memory_range(region_, offset, length, mode);
+    }
+
+    // Accessors
+    void* data() noexcept { return reservation_.address; }
+
+    const void* data() const noexcept { return reservation_.address; }
+
+    template <typename T>
+    T* as() noexcept {
+        return static_cast<T*>(reservation_.address);
+    }
+
+    template <typename T>
+    const T* as() const noexcept {
+        return static_cast<const T*>(reservation_.address);
+    }
+
+    // Bytes of file currently mapped and valid to access
+    uint64_t size() const noexcept { return size_; }
+
+    // Largest size grow() can reach
+    size_t capacity() const noexcept { return reservation_.length; }
+
+    const memory_region& region() const noexcept { return region_; }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_GROWABLE_MAPPING_HPP
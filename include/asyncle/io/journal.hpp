@@ -0,0 +1,492 @@
+#ifndef ASYNCLE_IO_JOURNAL_HPP
+#define ASYNCLE_IO_JOURNAL_HPP
+
+// asyncle::io journal - Append-only write-ahead log with group commit
+//
+// A journal is a directory of numbered segments:
+//
+//   <dir>/<prefix>-<sequence, 16 hex digits>.log
+//   [segment_header][record][record]...[zeros up to segment_size]
+//   record = [journal_record_header { crc, length, lsn }][payload]
+//
+// Every record gets a log sequence number (LSN), consecutive from 1 across
+// segments. Its CRC32C covers the length, the LSN and the payload. A
+// segment ends at the first record that fails the check, so a torn tail is
+// never replayed.
+//
+// Segments are preallocated with allocate(). A record that does not fit in
+// the rest of the current segment goes to a new one. open() replays the
+// existing segments to find the next LSN and always starts a fresh segment,
+// so a recovered segment is never written again. The one exception is a
+// newest segment whose header never made it to disk: it holds no records and
+// is rewritten in place. A bad header on any earlier segment is an error.
+//
+// append() returns once the record is durable. Concurrent appenders commit
+// as a group: the first waiter becomes the leader and writes everything
+// queued with one writev per segment run, followed by one sync. The others
+// wait and return with it. A failed write or sync is sticky (as an fsync
+// error must be): every later append fails and the journal has to be
+// reopened.
+//
+// Usage:
+//   io::journal wal;
+//   if(!wal.open("/var/lib/app/wal")) ...;
+//   auto lsn = wal.append(std::as_bytes(std::span(entry)));   // Durable on return
+//
+//   io::replay_journal("/var/lib/app/wal", [](uint64_t lsn, std::span<const std::byte> payload) { ... });
+
+#include "../hardware/checksum.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+// How a group commit is made durable
+enum class journal_sync : uint8_t {
+    data,   // fdatasync: data and the metadata needed to read it back
+    range,  // sync_file_range over the batch: written back, no device cache flush
+    none    // Left to the page cache (tests, or a replicated log)
+};
+
+struct journal_options {
+    uint64_t     segment_size = uint64_t { 64 } << 20;  // Preallocated per segment
+    journal_sync sync         = journal_sync::data;
+    size_t       max_batch    = 512;    // Records per writev
+    const char*  prefix       = "wal";  // Segment file name prefix
+};
+
+struct journal_record_header {
+    uint32_t crc;     // CRC32C of length, lsn and payload
+    uint32_t length;  // Payload bytes
+    uint64_t lsn;
+};
+
+struct journal_segment_header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t crc;  // CRC32C of the header with this field zero
+    uint64_t sequence;
+    uint64_t first_lsn;
+};
+
+static_assert(sizeof(journal_record_header) == 16);
+static_assert(sizeof(journal_segment_header) == 32);
+
+namespace detail {
+
+inline constexpr uint64_t journal_magic   = 0x314C4157434E5941ull;  // "AYNCWAL1"
+inline constexpr uint32_t journal_version = 1;
+
+inline file_error journal_corrupt() noexcept { return file_error(error_code::io_error); }
+
+inline std::string journal_segment_path(const std::string& dir, const char* prefix, uint64_t sequence) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/%s-%016llx.log", prefix, static_cast<unsigned long long>(sequence));
+    return dir + name;
+}
+
+inline uint32_t journal_record_crc(const journal_record_header& header, const void* payload) noexcept {
+    uint32_t crc = hardware::crc32c(&header.length, sizeof(header.length) + sizeof(header.lsn));
+    return hardware::crc32c(payload, header.length, crc);
+}
+
+inline uint32_t journal_segment_crc(journal_segment_header header) noexcept {
+    header.crc = 0;
+    return hardware::crc32c(&header, sizeof(header));
+}
+
+// LSN range and end position of the valid prefix of one segment
+struct journal_scan {
+    uint64_t first_lsn = 0;
+    uint64_t next_lsn  = 0;
+    uint64_t end       = 0;
+};
+
+// Header of segment sequence; nullopt when it is short or does not check out
+inline file_result<std::optional<journal_segment_header>> read_journal_header(const file& f,
+                                                                              uint64_t    sequence) noexcept {
+    journal_segment_header header {};
+    auto                   got = f.read(&header, sizeof(header), 0);
+    if(!got) return file_result<std::optional<journal_segment_header>>(unexpect, got.error());
+    if(*got != sizeof(header) || header.magic != journal_magic || header.version != journal_version
+       || header.sequence != sequence || header.crc != journal_segment_crc(header)) {
+        return file_result<std::optional<journal_segment_header>>(std::nullopt);
+    }
+    return file_result<std::optional<journal_segment_header>>(header);
+}
+
+// Reads records in chunks after a checked header, calling fn(lsn, payload)
+// for each valid one; a bad record just ends the segment
+template <typename F>
+file_result<journal_scan> scan_journal_segment(const file& f, const journal_segment_header& header,
+                                               std::vector<std::byte>& buffer, F&& fn) {
+    journal_scan scan { header.first_lsn, header.first_lsn, sizeof(header) };
+    if(buffer.size() < (size_t { 1 } << 20)) buffer.resize(size_t { 1 } << 20);
+    uint64_t chunk_start = scan.end;
+    size_t   filled      = 0;
+    size_t   pos         = 0;
+    bool     at_eof      = false;
+
+    // Keep at least need bytes from pos in the buffer; false at end of file
+    auto fill = [&](size_t need) -> file_result<bool> {
+        if(filled - pos >= need) return file_result<bool>(true);
+        if(at_eof) return file_result<bool>(false);
+        std::memmove(buffer.data(), buffer.data() + pos, filled - pos);
+        chunk_start += pos;
+        filled -= pos;
+        pos = 0;
+        if(buffer.size() < need) buffer.resize(need);
+        while(filled < need) {
+            auto read = f.read(buffer.data() + filled, buffer.size() - filled, chunk_start + filled);
+            if(!read) return file_result<bool>(unexpect, read.error());
+            if(*read == 0) {
+                at_eof = true;
+                return file_result<bool>(false);
+            }
+            filled += *read;
+        }
+        return file_result<bool>(true);
+    };
+
+    for(;;) {
+        auto more = fill(sizeof(journal_record_header));
+        if(!more) return file_result<journal_scan>(unexpect, more.error());
+        if(!*more) break;
+        journal_record_header record;
+        std::memcpy(&record, buffer.data() + pos, sizeof(record));
+        if(record.lsn != scan.next_lsn || record.length == 0) break;
+
+        more = fill(sizeof(record) + record.length);
+        if(!more) return file_result<journal_scan>(unexpect, more.error());
+        if(!*more) break;
+        const std::byte* payload = buffer.data() + pos + sizeof(record);
+        if(record.crc != journal_record_crc(record, payload)) break;
+
+        fn(record.lsn, std::span<const std::byte>(payload, record.length));
+        pos += sizeof(record) + record.length;
+        scan.end = chunk_start + pos;
+        ++scan.next_lsn;
+    }
+    return file_result<journal_scan>(scan);
+}
+
+// Scans segments from sequence 0 until one is missing; each must start at
+// the LSN the previous one ended with. A crash while a segment is being
+// started can leave it without a valid header; that is accepted only for the
+// newest segment, which is then reported as torn (and holds no records).
+template <typename F>
+file_result<uint64_t> scan_journal(const std::string& dir, const char* prefix, uint64_t& sequence, bool& torn,
+                                   F&& fn) {
+    std::vector<std::byte> buffer;
+    uint64_t               next_lsn = 1;
+    torn                            = false;
+    for(sequence = 0;; ++sequence) {
+        file f;
+        if(!f.open(journal_segment_path(dir, prefix, sequence).c_str(), access_mode::read_only)) break;
+        auto header = read_journal_header(f, sequence);
+        if(!header) return file_result<uint64_t>(unexpect, header.error());
+        if(!*header) {
+            file later;
+            if(later.open(journal_segment_path(dir, prefix, sequence + 1).c_str(), access_mode::read_only)) {
+                return file_result<uint64_t>(unexpect, journal_corrupt());
+            }
+            torn = true;
+            break;
+        }
+        auto scan = scan_journal_segment(f, **header, buffer, fn);
+        if(!scan) return file_result<uint64_t>(unexpect, scan.error());
+        if(scan->first_lsn != next_lsn) return file_result<uint64_t>(unexpect, journal_corrupt());
+        next_lsn = scan->next_lsn;
+    }
+    return file_result<uint64_t>(next_lsn);
+}
+
+}  // namespace detail
+
+// Calls fn(lsn, payload) for every valid record of the journal in dir, in LSN
+// order, and returns the next LSN (1 for an empty journal)
+template <typename F>
+file_result<uint64_t> replay_journal(const char* dir, F&& fn, const char* prefix = journal_options {}.prefix) {
+    uint64_t segments = 0;
+    bool     torn     = false;
+    return detail::scan_journal(dir, prefix, segments, torn, fn);
+}
+
+// ============================================================================
+// Journal
+// ============================================================================
+
+class journal {
+    struct pending_record {
+        journal_record_header header;
+        const std::byte*      payload;
+    };
+
+    std::string     dir_;
+    journal_options options_;
+    file            segment_;
+    uint64_t        sequence_ = 0;  // Of segment_
+    uint64_t        offset_   = 0;  // Write position in segment_
+
+    std::mutex                  mutex_;
+    std::condition_variable     committed_;
+    std::vector<pending_record> pending_;  // Queued by appenders, guarded by mutex_
+    std::vector<pending_record> batch_;    // Owned by the committing leader
+    std::vector<io_request>     requests_;
+    uint64_t                    next_lsn_    = 1;
+    uint64_t                    durable_lsn_ = 0;
+    uint64_t                    commits_     = 0;
+    uint64_t                    segments_    = 0;  // sequence_ as of the last commit
+    bool                        committing_  = false;
+    std::optional<file_error>   failed_;
+
+    static size_t framed(const pending_record& r) noexcept { return sizeof(journal_record_header) + r.header.length; }
+
+    file_void_result sync_directory() noexcept {
+        file dir(dir_.c_str(), access_mode::read_only);
+        if(!dir) return file_void_result(unexpect, file_error(error_code::not_directory));
+        return dir.sync(sync_flags::full_sync);
+    }
+
+    // Close the current segment durably and start sequence with first_lsn;
+    // overwrite replaces a torn segment left by a crash instead of creating one
+    file_void_result start_segment(uint64_t sequence, uint64_t first_lsn, bool overwrite = false) noexcept {
+        if(segment_) {
+            if(options_.sync != journal_sync::none) {
+                if(auto synced = segment_.sync(sync_flags::data_only); !synced) return synced;
+            }
+            segment_.close();
+        }
+
+        uint8_t access = static_cast<uint8_t>(access_mode::read_write) | static_cast<uint8_t>(access_mode::create);
+        if(!overwrite) access |= static_cast<uint8_t>(access_mode::exclusive);
+        file_request request;
+        request.access = static_cast<access_mode>(access);
+        file next;
+        if(auto opened = next.open(journal_segment_path(sequence).c_str(), request); !opened) {
+            return file_void_result(unexpect, opened.error());
+        }
+        if(overwrite) {
+            if(auto cleared = next.truncate(0); !cleared) return cleared;
+        }
+        // Preallocation is an optimization; filesystems without fallocate still work
+        (void)next.allocate(0, options_.segment_size);
+
+        journal_segment_header header { detail::journal_magic, detail::journal_version, 0, sequence, first_lsn };
+        header.crc = detail::journal_segment_crc(header);
+        auto wrote = next.write(&header, sizeof(header), 0);
+        if(!wrote) return file_void_result(unexpect, wrote.error());
+        if(*wrote != sizeof(header)) return file_void_result(unexpect, file_error(error_code::io_error));
+        if(options_.sync != journal_sync::none) {
+            if(auto synced = next.sync(sync_flags::data_only); !synced) return synced;
+            if(auto synced = sync_directory(); !synced) return synced;
+        }
+
+        segment_  = std::move(next);
+        sequence_ = sequence;
+        offset_   = sizeof(header);
+        return file_void_result();
+    }
+
+    std::string journal_segment_path(uint64_t sequence) const {
+        return detail::journal_segment_path(dir_, options_.prefix, sequence);
+    }
+
+    // One file-contiguous run; short writes resume where they stopped
+    file_void_result write_run(std::span<io_request> run) noexcept {
+        while(!run.empty()) {
+            auto wrote = segment_.writev(run.data(), run.size());
+            if(!wrote) return file_void_result(unexpect, wrote.error());
+            size_t done = wrote->bytes_transferred;
+            if(done == 0) return file_void_result(unexpect, file_error(error_code::io_error));
+            while(!run.empty() && done >= run.front().length) {
+                done -= run.front().length;
+                run = run.subspan(1);
+            }
+            if(!run.empty()) {
+                run.front().buffer = static_cast<std::byte*>(run.front().buffer) + done;
+                run.front().offset += done;
+                run.front().length -= done;
+            }
+        }
+        return file_void_result();
+    }
+
+    // Leader only: write batch_ in LSN order, rolling segments, then sync once
+    file_void_result commit_batch() noexcept {
+        uint64_t synced_from = offset_;
+        for(size_t i = 0; i < batch_.size();) {
+            uint64_t room  = options_.segment_size > offset_ ? options_.segment_size - offset_ : 0;
+            size_t   end   = i;
+            uint64_t bytes = 0;
+            while(end < batch_.size() && end - i < options_.max_batch && bytes + framed(batch_[end]) <= room) {
+                bytes += framed(batch_[end++]);
+            }
+            if(end == i) {
+                if(auto rolled = start_segment(sequence_ + 1, batch_[i].header.lsn); !rolled) return rolled;
+                synced_from = offset_;
+                continue;
+            }
+
+            requests_.clear();
+            uint64_t at = offset_;
+            for(size_t r = i; r < end; ++r) {
+                io_request header;
+                header.buffer = &batch_[r].header;
+                header.length = sizeof(journal_record_header);
+                header.offset = at;
+                io_request body;
+                body.buffer = const_cast<std::byte*>(batch_[r].payload);
+                body.length = batch_[r].header.length;
+                body.offset = at + header.length;
+                at += framed(batch_[r]);
+                requests_.push_back(header);
+                requests_.push_back(body);
+            }
+            if(auto wrote = write_run(requests_); !wrote) return wrote;
+            offset_ = at;
+            i       = end;
+        }
+
+        switch(options_.sync) {
+        case journal_sync::data: return segment_.sync(sync_flags::data_only);
+        case journal_sync::range: return segment_.sync_range(synced_from, offset_ - synced_from);
+        case journal_sync::none: break;
+        }
+        return file_void_result();
+    }
+
+    public:
+    // Constructors
+    journal() noexcept = default;
+
+    journal(const journal&)            = delete;
+    journal& operator=(const journal&) = delete;
+
+    // Destructor
+    ~journal() { close(); }
+
+    // Replays dir to find the next LSN, then starts a new segment after the
+    // last one found, or rewrites a torn newest one. The directory must exist.
+    file_void_result open(const char* dir, const journal_options& options = {}) {
+        close();
+        if(options.segment_size <= sizeof(journal_segment_header) + sizeof(journal_record_header)
+           || options.max_batch == 0) {
+            return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        }
+        dir_     = dir;
+        options_ = options;
+
+        uint64_t sequence = 0;
+        bool     torn     = false;
+        auto     next_lsn = detail::scan_journal(dir_, options_.prefix, sequence, torn, [](uint64_t, auto) {});
+        if(!next_lsn) return file_void_result(unexpect, next_lsn.error());
+
+        if(auto started = start_segment(sequence, *next_lsn, torn); !started) return started;
+        next_lsn_    = *next_lsn;
+        durable_lsn_ = *next_lsn - 1;
+        segments_    = sequence;
+        commits_     = 0;
+        failed_.reset();
+        return file_void_result();
+    }
+
+    // Appenders must have returned
+    void close() noexcept {
+        segment_.close();
+        pending_.clear();
+        batch_.clear();
+    }
+
+    // Largest payload a segment can hold
+    uint64_t max_record() const noexcept {
+        return options_.segment_size - sizeof(journal_segment_header) - sizeof(journal_record_header);
+    }
+
+    // Thread-safe. Returns the (non-empty) record's LSN once it is durable
+    // per journal_options::sync; the payload is written from record in place.
+    file_result<uint64_t> append(std::span<const std::byte> record) {
+        if(record.empty() || record.size() > max_record() || record.size() > UINT32_MAX) {
+            return file_result<uint64_t>(unexpect, file_error(error_code::invalid_argument));
+        }
+
+        std::unique_lock lock(mutex_);
+        if(!segment_) return file_result<uint64_t>(unexpect, file_error(error_code::invalid_argument));
+        if(failed_) return file_result<uint64_t>(unexpect, *failed_);
+
+        journal_record_header header { 0, static_cast<uint32_t>(record.size()), next_lsn_++ };
+        header.crc = detail::journal_record_crc(header, record.data());
+        pending_.push_back(pending_record { header, record.data() });
+        const uint64_t lsn = header.lsn;
+
+        while(durable_lsn_ < lsn) {
+            if(failed_) return file_result<uint64_t>(unexpect, *failed_);
+            if(committing_) {
+                committed_.wait(lock);
+                continue;
+            }
+
+            // Lead a group commit of everything queued so far
+            committing_ = true;
+            batch_.swap(pending_);
+            lock.unlock();
+            auto done = commit_batch();
+            lock.lock();
+            committing_ = false;
+            segments_   = sequence_;
+            if(done) {
+                durable_lsn_ = batch_.back().header.lsn;
+                ++commits_;
+            } else {
+                failed_ = done.error();
+            }
+            batch_.clear();
+            committed_.notify_all();
+        }
+        return file_result<uint64_t>(lsn);
+    }
+
+    // State queries
+    bool is_open() const noexcept { return segment_.is_open(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // Thread-safe snapshots
+    uint64_t durable_lsn() {
+        std::lock_guard lock(mutex_);
+        return durable_lsn_;
+    }
+
+    uint64_t next_lsn() {
+        std::lock_guard lock(mutex_);
+        return next_lsn_;
+    }
+
+    // Group commits (syncs) made since open
+    uint64_t commits() {
+        std::lock_guard lock(mutex_);
+        return commits_;
+    }
+
+    // Sequence number of the segment being written
+    uint64_t segment() {
+        std::lock_guard lock(mutex_);
+        return segments_;
+    }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_JOURNAL_HPP
@@ -0,0 +1,245 @@
+#ifndef ASYNCLE_IO_MAPPED_READER_HPP
+#define ASYNCLE_IO_MAPPED_READER_HPP
+
+#include "../../platform/mmap.hpp"
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace asyncle::io {
+
+// Sequential reader over a file of any size through a sliding mmap window.
+// Only the current window and the next one (prefetched with MADV_WILLNEED) are
+// mapped; pages the cursor has passed are dropped with MADV_DONTNEED, so RSS
+// stays around two windows regardless of file size.
+// The file must outlive the reader; it is not owned.
+class mapped_reader {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = memory_error;
+    template <typename T>
+    using result_type = mmap_result<T>;
+    using view_type   = std::span<const std::byte>;
+
+    static constexpr size_t default_window_size = 64 * 1024 * 1024;
+
+    private:
+    struct window {
+        memory_region region;
+        uint64_t      offset   = 0;  // File offset of region.address
+        size_t        released = 0;  // Bytes at the front already discarded
+
+        bool contains(uint64_t pos) const noexcept { return region.address && pos >= offset && pos < end(); }
+
+        uint64_t end() const noexcept { return offset + region.length; }
+
+        void unmap() noexcept {
+            if(region.address) { platform::mmap::unmap_memory(region); }
+            region   = memory_region {};
+            offset   = 0;
+            released = 0;
+        }
+    };
+
+    int      fd_          = -1;
+    uint64_t file_size_   = 0;
+    uint64_t cursor_      = 0;
+    size_t   window_size_ = 0;
+    window   current_;
+    window   next_;
+
+    static size_t page() noexcept { return mmap::page_size(); }
+
+    mmap_result<memory_region> map_window(window& w, uint64_t offset, size_t length) noexcept {
+        memory_request req {};
+        req.length  = length;
+        req.offset  = static_cast<size_t>(offset);
+        req.backing = backing_type::file_backed;
+        req.access  = mmap_access::access_mode::read;
+        req.sharing = sharing_mode::shared;
+        req.pattern = access_pattern::sequential_access;
+
+        auto result = platform::mmap::map_memory(fd_, req);
+        if(result) {
+            w.region   = result.value();
+            w.offset   = offset;
+            w.released = 0;
+        }
+        return result;
+    }
+
+    size_t window_length(uint64_t offset, size_t at_least) const noexcept {
+        size_t   want = window_size_ > at_least ? window_size_ : mmap::align_to_page(at_least);
+        uint64_t left = file_size_ - offset;
+        return left < want ? static_cast<size_t>(left) : want;
+    }
+
+    // Map the window following current_ and ask the kernel to start reading it
+    void prefetch_next() noexcept {
+        if(next_.region.address || !current_.region.address) return;
+        uint64_t offset = current_.end();
+        if(offset >= file_size_) return;
+        if(map_window(next_, offset, window_length(offset, 0))) { platform::mmap::prefetch_memory(next_.region); }
+    }
+
+    // Make [pos, pos + length) addressable from a single window
+    mmap_void_result ensure(uint64_t pos, size_t length) noexcept {
+        if(current_.contains(pos) && pos + length <= current_.end()) return mmap_void_result();
+
+        // Common case: cursor stepped into the prefetched window
+        if(next_.contains(pos) && pos + length <= next_.end()) {
+            current_.unmap();
+            current_ = std::exchange(next_, window {});
+            prefetch_next();
+            return mmap_void_result();
+        }
+
+        // Seek or a view straddling two windows: remap at the page containing pos
+        current_.unmap();
+        next_.unmap();
+        uint64_t base   = pos & ~static_cast<uint64_t>(page() - 1);
+        auto     mapped = map_window(current_, base, window_length(base, static_cast<size_t>(pos - base) + length));
+        if(!mapped) return mmap_void_result(unexpect, mapped.error());
+        prefetch_next();
+        return mmap_void_result();
+    }
+
+    // Drop whole pages behind the cursor, in batches of a quarter window
+    void release_behind() noexcept {
+        if(!current_.contains(cursor_) && cursor_ != current_.end()) return;
+        size_t passed = static_cast<size_t>(cursor_ - current_.offset) & ~(page() - 1);
+        size_t batch  = window_size_ / 4;
+        if(passed < current_.released + batch) return;
+        platform::mmap::discard_memory(current_.region, current_.released, passed - current_.released);
+        current_.released = passed;
+    }
+
+    public:
+    // Constructors
+    mapped_reader() noexcept = default;
+
+    explicit mapped_reader(const file& f, size_t window_size = default_window_size) noexcept { open(f, window_size); }
+
+    // Move semantics
+    mapped_reader(mapped_reader&& other) noexcept:
+        fd_(std::exchange(other.fd_, -1)),
+        file_size_(std::exchange(other.file_size_, 0)),
+        cursor_(std::exchange(other.cursor_, 0)),
+        window_size_(std::exchange(other.window_size_, 0)),
+        current_(std::exchange(other.current_, window {})),
+        next_(std::exchange(other.next_, window {})) {}
+
+    mapped_reader& operator=(mapped_reader&& other) noexcept {
+        if(this != &other) {
+            close();
+            fd_          = std::exchange(other.fd_, -1);
+            file_size_   = std::exchange(other.file_size_, 0);
+            cursor_      = std::exchange(other.cursor_, 0);
+            window_size_ = std::exchange(other.window_size_, 0);
+            current_     = std::exchange(other.current_, window {});
+            next_        = std::exchange(other.next_, window {});
+        }
+        return *this;
+    }
+
+    // No copy
+    mapped_reader(const mapped_reader&)            = delete;
+    mapped_reader& operator=(const mapped_reader&) = delete;
+
+    // Destructor
+    ~mapped_reader() { close(); }
+
+    // Core operations
+    // window_size is rounded up to whole pages
+    mmap_void_result open(const file& f, size_t window_size = default_window_size) noexcept {
+        close();
+        if(!f.is_open() || window_size == 0) {
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+
+        auto size = f.size();
+        if(!size) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::io_error)); }
+
+        fd_          = f.fd();
+        file_size_   = size.value();
+        window_size_ = mmap::align_to_page(window_size);
+        return mmap_void_result();
+    }
+
+    void close() noexcept {
+        current_.unmap();
+        next_.unmap();
+        fd_        = -1;
+        file_size_ = 0;
+        cursor_    = 0;
+    }
+
+    // Next contiguous chunk of up to max_bytes, advancing the cursor.
+    // Chunks end at window boundaries; an empty view means end of file
+    mmap_result<view_type> next(size_t max_bytes = static_cast<size_t>(-1)) noexcept {
+        if(!is_open()) {
+            return mmap_result<view_type>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        if(cursor_ >= file_size_) return mmap_result<view_type>(view_type {});
+
+        auto ready = ensure(cursor_, 1);
+        if(!ready) return mmap_result<view_type>(unexpect, ready.error());
+
+        uint64_t    available = current_.end() - cursor_;
+        size_t      length    = available < max_bytes ? static_cast<size_t>(available) : max_bytes;
+        const auto* data      = static_cast<const std::byte*>(current_.region.address) + (cursor_ - current_.offset);
+
+        cursor_ += length;
+        release_behind();
+        return mmap_result<view_type>(view_type(data, length));
+    }
+
+    // Contiguous view of exactly length bytes at the cursor without advancing
+    // (shorter only at end of file); remaps when the range straddles windows
+    mmap_result<view_type> peek(size_t length) noexcept {
+        if(!is_open()) {
+            return mmap_result<view_type>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        if(cursor_ >= file_size_) return mmap_result<view_type>(view_type {});
+        if(length > file_size_ - cursor_) length = static_cast<size_t>(file_size_ - cursor_);
+
+        auto ready = ensure(cursor_, length);
+        if(!ready) return mmap_result<view_type>(unexpect, ready.error());
+
+        const auto* data = static_cast<const std::byte*>(current_.region.address) + (cursor_ - current_.offset);
+        return mmap_result<view_type>(view_type(data, length));
+    }
+
+    void advance(size_t bytes) noexcept {
+        cursor_ = (bytes > file_size_ - cursor_) ? file_size_ : cursor_ + bytes;
+        release_behind();
+    }
+
+    void seek(uint64_t position) noexcept { cursor_ = position > file_size_ ? file_size_ : position; }
+
+    // Accessors
+    uint64_t position() const noexcept { return cursor_; }
+
+    uint64_t size() const noexcept { return file_size_; }
+
+    uint64_t remaining() const noexcept { return file_size_ - cursor_; }
+
+    size_t window_size() const noexcept { return window_size_; }
+
+    bool eof() const noexcept { return cursor_ >= file_size_; }
+
+    // Bytes currently mapped (current + prefetched window)
+    size_t mapped_bytes() const noexcept { return current_.region.length + next_.region.length; }
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_MAPPED_READER_HPP
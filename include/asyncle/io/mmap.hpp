@@ -2,10 +2,16 @@
 #define ASYNCLE_IO_MMAP_HPP
 
 #include "../../platform/mmap.hpp"
+#include "../hardware/checksum.hpp"
+#include "../hardware/memory.hpp"
+#include "../instrument.hpp"
 #include "file.hpp"
 #include "result.hpp"
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <utility>
 
 namespace asyncle::io {
@@ -14,13 +20,16 @@ namespace asyncle::io {
 using platform::mmap::access_pattern;
 using platform::mmap::backing_type;
 using platform::mmap::expected;
+using platform::mmap::flush_mode;
 using platform::mmap::locking_strategy;
 using platform::mmap::memory_caps;
 using platform::mmap::memory_error;
 using platform::mmap::memory_region;
 using platform::mmap::memory_request;
+using platform::mmap::numa_policy;
 using platform::mmap::placement_strategy;
 using platform::mmap::sharing_mode;
+using platform::mmap::sync_semantics;
 using platform::mmap::unexpect;
 
 // Use explicit namespace for mmap-specific types
@@ -38,18 +47,26 @@ class mmap {
     using result_type      = mmap_result<T>;
     using void_result_type = mmap_void_result;
 
+    // Separate dirty ranges kept until flush(); past this a new range is merged
+    // into its nearest neighbour
+    static constexpr size_t max_dirty_ranges = 8;
+
     private:
-    memory_region region_;
+    struct dirty_range {
+        size_t begin;
+        size_t end;
+    };
+
+    memory_region                             region_;
+    std::array<dirty_range, max_dirty_ranges> dirty_ {};
+    size_t                                    dirty_count_ = 0;
 
     public:
     // Constructors
     mmap() noexcept = default;
 
     // Map anonymous memory with request
-    explicit mmap(const memory_request& request) noexcept {
-        auto result = platform::mmap::map_memory(-1, request);
-        if(result) { region_ = result.value(); }
-    }
+    explicit mmap(const memory_request& request) noexcept { map(request, -1); }
 
     // Map anonymous memory with simple parameters
     mmap(size_t length, mmap_access::access_mode access = mmap_access::access_mode::read_write) noexcept {
@@ -58,16 +75,12 @@ class mmap {
         req.backing = backing_type::anonymous;
         req.access  = access;
         req.sharing = sharing_mode::private_cow;
-        auto result = platform::mmap::map_memory(-1, req);
-        if(result) { region_ = result.value(); }
+        map(req, -1);
     }
 
     // Map file with request
     mmap(const file& f, const memory_request& request) noexcept {
-        if(f.is_open()) {
-            auto result = platform::mmap::map_memory(f.fd(), request);
-            if(result) { region_ = result.value(); }
-        }
+        if(f.is_open()) { map(request, f.fd()); }
     }
 
     // Map file with simple parameters
@@ -83,27 +96,28 @@ class mmap {
             req.backing = backing_type::file_backed;
             req.access  = access;
             req.sharing = sharing_mode::shared;
-            auto result = platform::mmap::map_memory(f.fd(), req);
-            if(result) { region_ = result.value(); }
+            map(req, f.fd());
         }
     }
 
     // Map from file descriptor with request
-    mmap(int fd, const memory_request& request) noexcept {
-        auto result = platform::mmap::map_memory(fd, request);
-        if(result) { region_ = result.value(); }
-    }
+    mmap(int fd, const memory_request& request) noexcept { map(request, fd); }
 
     // Create from existing region
     explicit mmap(memory_region region) noexcept: region_(region) {}
 
     // Move semantics
-    mmap(mmap&& other) noexcept: region_(std::exchange(other.region_, memory_region {})) {}
+    mmap(mmap&& other) noexcept:
+        region_(std::exchange(other.region_, memory_region {})),
+        dirty_(other.dirty_),
+        dirty_count_(std::exchange(other.dirty_count_, 0)) {}
 
     mmap& operator=(mmap&& other) noexcept {
         if(this != &other) {
             unmap();
-            region_ = std::exchange(other.region_, memory_region {});
+            region_      = std::exchange(other.region_, memory_region {});
+            dirty_       = other.dirty_;
+            dirty_count_ = std::exchange(other.dirty_count_, 0);
         }
         return *this;
     }
@@ -118,7 +132,9 @@ class mmap {
     // Core operations
     mmap_result<memory_region> map(const memory_request& request, int fd = -1) noexcept {
         unmap();
-        auto result = platform::mmap::map_memory(fd, request);
+        instrument::scope timed(instrument::op::mmap_map);
+        auto              result = platform::mmap::map_memory(fd, request);
+        timed.done(result.has_value(), result ? result->length : 0);
         if(result) { region_ = result.value(); }
         return result;
     }
@@ -140,6 +156,19 @@ class mmap {
         return map(req, -1);
     }
 
+    mmap_result<memory_region> map_anonymous(
+      size_t                       length,
+      mmap_access::page_preference pages,
+      mmap_access::access_mode     access = mmap_access::access_mode::read_write) noexcept {
+        memory_request req {};
+        req.length    = length;
+        req.backing   = backing_type::anonymous;
+        req.access    = access;
+        req.sharing   = sharing_mode::private_cow;
+        req.page_pref = pages;
+        return map(req, -1);
+    }
+
     mmap_result<memory_region> map_file(
       const file&              f,
       size_t                   length,
@@ -161,14 +190,84 @@ class mmap {
     void unmap() noexcept {
         if(is_mapped()) {
             platform::mmap::unmap_memory(region_);
-            region_ = memory_region {};
+            region_      = memory_region {};
+            dirty_count_ = 0;
         }
     }
 
-    // Memory synchronization
+    // Memory synchronization (the whole region; clears the dirty ranges)
     mmap_void_result sync(bool invalidate_caches = false) noexcept {
         if(!is_mapped()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
-        return platform::mmap::sync_memory(region_, invalidate_caches);
+        auto result = platform::mmap::sync_memory(region_, invalidate_caches);
+        if(result) dirty_count_ = 0;
+        return result;
+    }
+
+    // Sync [offset, offset + length) only. On a durable (MAP_SYNC) mapping the
+    // range is persisted by writing back its CPU cache lines, with no system call.
+    mmap_void_result sync_range(size_t offset, size_t length, flush_mode mode = flush_mode::sync_flush) noexcept {
+        if(!is_mapped() || offset >= region_.length) {
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        if(is_durable()) {
+            size_t end   = length > region_.length - offset ? region_.length : offset + length;
+            size_t begin = offset & ~(hardware::cache_line_size - 1);
+            hardware::cache_flush_range(static_cast<char*>(region_.address) + begin, end - begin);
+            hardware::full_barrier();
+            return mmap_void_result();
+        }
+        return platform::mmap::sync_memory_range(region_, offset, length, mode);
+    }
+
+    // Record that [offset, offset + length) was written. Ranges are widened to
+    // whole pages and merged when they overlap or touch, so flush() issues one
+    // sync per run of dirty pages instead of one for the whole mapping.
+    void mark_dirty(size_t offset, size_t length) noexcept {
+        if(!is_mapped() || length == 0 || offset >= region_.length) return;
+        const size_t page = region_.actual_page_size ? region_.actual_page_size : 4096;
+        const size_t end  = length > region_.length - offset ? region_.length : offset + length;
+        dirty_range  range { offset / page * page, std::min(region_.length, (end + page - 1) / page * page) };
+
+        size_t first = 0;
+        while(first < dirty_count_ && dirty_[first].end < range.begin) ++first;
+        size_t last = first;
+        for(; last < dirty_count_ && dirty_[last].begin <= range.end; ++last) {
+            range.begin = std::min(range.begin, dirty_[last].begin);
+            range.end   = std::max(range.end, dirty_[last].end);
+        }
+
+        auto ranges = dirty_.begin();
+        if(last > first) {
+            dirty_[first] = range;
+            std::copy(ranges + last, ranges + dirty_count_, ranges + first + 1);
+            dirty_count_ -= last - first - 1;
+        } else if(dirty_count_ < max_dirty_ranges) {
+            std::copy_backward(ranges + first, ranges + dirty_count_, ranges + dirty_count_ + 1);
+            dirty_[first] = range;
+            ++dirty_count_;
+        } else if(first > 0 && (first == dirty_count_
+                                || range.begin - dirty_[first - 1].end <= dirty_[first].begin - range.end)) {
+            dirty_[first - 1].end = range.end;  // Full: the clean pages in between get synced too
+        } else {
+            dirty_[first].begin = range.begin;
+        }
+    }
+
+    size_t dirty_ranges() const noexcept { return dirty_count_; }
+
+    // Sync every dirty range and forget them. On failure the ranges not yet
+    // synced are kept for the next call.
+    mmap_void_result flush(flush_mode mode = flush_mode::sync_flush) noexcept {
+        for(size_t i = 0; i < dirty_count_; ++i) {
+            auto result = sync_range(dirty_[i].begin, dirty_[i].end - dirty_[i].begin, mode);
+            if(!result) {
+                std::copy(dirty_.begin() + i, dirty_.begin() + dirty_count_, dirty_.begin());
+                dirty_count_ -= i;
+                return result;
+            }
+        }
+        dirty_count_ = 0;
+        return mmap_void_result();
     }
 
     // Memory advice
@@ -180,7 +279,10 @@ class mmap {
     // Memory locking
     mmap_void_result lock(locking_strategy strategy = locking_strategy::lock_resident) noexcept {
         if(!is_mapped()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
-        return platform::mmap::lock_memory(region_, strategy);
+        instrument::scope timed(instrument::op::mmap_fault);
+        auto              result = platform::mmap::lock_memory(region_, strategy);
+        timed.done(result.has_value(), region_.length);
+        return result;
     }
 
     mmap_void_result unlock() noexcept {
@@ -191,17 +293,74 @@ class mmap {
     // Memory prefetch
     mmap_void_result prefetch(size_t offset = 0, size_t length = 0) noexcept {
         if(!is_mapped()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
-        return platform::mmap::prefetch_memory(region_, offset, length);
+        instrument::scope timed(instrument::op::mmap_fault);
+        auto              result = platform::mmap::prefetch_memory(region_, offset, length);
+        timed.done(result.has_value(), length ? length : (offset < region_.length ? region_.length - offset : 0));
+        return result;
     }
 
-    // Static utilities
-    static memory_caps capabilities() noexcept { return platform::mmap::query_capabilities(); }
+    // Fault [offset, offset + length) in and wait until it is resident
+    mmap_void_result populate(size_t offset = 0, size_t length = 0) noexcept {
+        if(!is_mapped()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
+        instrument::scope timed(instrument::op::mmap_fault);
+        auto              result = platform::mmap::populate_memory(region_, offset, length);
+        timed.done(result.has_value(), length ? length : (offset < region_.length ? region_.length - offset : 0));
+        return result;
+    }
 
-    static size_t page_size() noexcept {
-        auto caps = capabilities();
-        return caps.system_page_size;
+    // Drop cold pages: unmap [offset, offset + length) and evict it from the page
+    // cache, so the next access reads storage again. Writes not yet synced stay
+    // cached until their writeback finishes; sync() first to evict them too.
+    mmap_void_result evict(size_t offset = 0, size_t length = 0) noexcept {
+        if(!is_mapped()) { return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument)); }
+        return platform::mmap::evict_memory(region_, offset, length);
     }
 
+    // Residency
+    // Bytes of [offset, offset + length) currently in memory (length 0 = to the end)
+    mmap_result<size_t> resident_bytes(size_t offset = 0, size_t length = 0) const noexcept {
+        if(!is_mapped() || offset >= region_.length) {
+            return mmap_result<size_t>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        const size_t  page = page_size();
+        const size_t  end  = (length == 0 || length > region_.length - offset) ? region_.length : offset + length;
+        unsigned char pages[1024];
+        size_t        bytes = 0;
+        for(size_t at = offset / page * page; at < end; at += sizeof(pages) * page) {
+            const size_t stop     = std::min(end, at + sizeof(pages) * page);
+            auto         resident = platform::mmap::query_residency(region_, at, stop - at, pages);
+            if(!resident) return mmap_result<size_t>(unexpect, resident.error());
+            if(*resident == 0) continue;
+            for(size_t i = 0; at + i * page < stop; ++i) {
+                if(pages[i] & 1) bytes += std::min(stop, at + (i + 1) * page) - std::max(offset, at + i * page);
+            }
+        }
+        return bytes;
+    }
+
+    // Per-page residency from offset (rounded down to a page): bit 0 of pages[i]
+    // is set when page i is resident. Fills at most pages.size() entries and
+    // returns how many of them are resident
+    mmap_result<size_t> residency(std::span<unsigned char> pages, size_t offset = 0) const noexcept {
+        if(!is_mapped() || offset >= region_.length || pages.empty()) {
+            return mmap_result<size_t>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        const size_t page  = page_size();
+        const size_t begin = offset / page * page;
+        const size_t bytes = std::min(region_.length - begin, pages.size() * page);
+        return platform::mmap::query_residency(region_, begin, bytes, pages.data());
+    }
+
+    // Static utilities
+    // Probed once per process (see asyncle/system.hpp); query_capabilities()
+    // reads /proc and /sys on every call
+    static const memory_caps& capabilities() noexcept {
+        static const memory_caps caps = platform::mmap::query_capabilities();
+        return caps;
+    }
+
+    static size_t page_size() noexcept { return capabilities().system_page_size; }
+
     static size_t align_to_page(size_t size) noexcept {
         size_t ps = page_size();
         return (size + ps - 1) & ~(ps - 1);
@@ -255,9 +414,22 @@ class mmap {
 
     bool supports_sync() const noexcept { return region_.supports_sync; }
 
+    // Mapped with MAP_SYNC (memory_request::sync = durable_sync on DAX): stores
+    // are durable once their cache lines are written back
+    bool is_durable() const noexcept { return region_.actual_sync == sync_semantics::durable_sync; }
+
     int fd() const noexcept { return region_.file_descriptor; }
 };
 
+// Checksums over a whole mapping; an unmapped one hashes as empty input.
+// Every page is touched, so advise(access_pattern::sequential_access) first
+// lets readahead stay ahead of the checksum on a file mapping.
+inline uint32_t crc32c(const mmap& m, uint32_t previous = 0) noexcept {
+    return hardware::crc32c(m.data(), m.size(), previous);
+}
+
+inline uint64_t xxh64(const mmap& m, uint64_t seed = 0) noexcept { return hardware::xxh64(m.data(), m.size(), seed); }
+
 }  // namespace asyncle::io
 
 #endif  // ASYNCLE_IO_MMAP_HPP
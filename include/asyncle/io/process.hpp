@@ -2,6 +2,7 @@
 #define ASYNCLE_IO_PROCESS_HPP
 
 #include "../../platform/process.hpp"
+#include "../instrument.hpp"
 #include "result.hpp"
 #include <memory>
 #include <span>
@@ -10,12 +11,9 @@
 
 namespace asyncle::io {
 
-// Import platform types
-using platform::process::error_code;
-using platform::process::error_domain;
+// Import platform types; error_code, error_domain, io_request and io_result are
+// class members below so this header can be used alongside file.hpp
 using platform::process::expected;
-using platform::process::io_request;
-using platform::process::io_result;
 using platform::process::pipe_handle;
 using platform::process::pipe_mode;
 using platform::process::process_caps;
@@ -37,6 +35,12 @@ class process {
     using result_type      = process_result<T>;
     using void_result_type = process_void_result;
 
+    // Process-specific platform types (the file module imports its own into asyncle::io)
+    using error_code   = platform::process::error_code;
+    using error_domain = platform::process::error_domain;
+    using io_request   = platform::process::io_request;
+    using io_result    = platform::process::io_result;
+
     private:
     process_handle handle_;
     pipe_handle    stdin_;
@@ -48,16 +52,7 @@ class process {
     process() noexcept = default;
 
     // Spawn process with full request
-    explicit process(const spawn_request& request) noexcept {
-        pipe_handle stdin_pipe, stdout_pipe, stderr_pipe;
-        auto        result = platform::process::spawn_process(request, &stdin_pipe, &stdout_pipe, &stderr_pipe);
-        if(result) {
-            handle_ = result.value();
-            stdin_  = stdin_pipe;
-            stdout_ = stdout_pipe;
-            stderr_ = stderr_pipe;
-        }
-    }
+    explicit process(const spawn_request& request) noexcept { spawn(request); }
 
     // Simple spawn with executable path and args
     process(
@@ -72,15 +67,7 @@ class process {
         req.stdin_mode  = stdin_mode;
         req.stdout_mode = stdout_mode;
         req.stderr_mode = stderr_mode;
-
-        pipe_handle stdin_pipe, stdout_pipe, stderr_pipe;
-        auto        result = platform::process::spawn_process(req, &stdin_pipe, &stdout_pipe, &stderr_pipe);
-        if(result) {
-            handle_ = result.value();
-            stdin_  = stdin_pipe;
-            stdout_ = stdout_pipe;
-            stderr_ = stderr_pipe;
-        }
+        spawn(req);
     }
 
     // Create from existing handles
@@ -118,8 +105,10 @@ class process {
     // Core operations
     process_result<process_handle> spawn(const spawn_request& request) noexcept {
         close_pipes();
-        pipe_handle stdin_pipe, stdout_pipe, stderr_pipe;
-        auto        result = platform::process::spawn_process(request, &stdin_pipe, &stdout_pipe, &stderr_pipe);
+        instrument::scope timed(instrument::op::process_spawn);
+        pipe_handle       stdin_pipe, stdout_pipe, stderr_pipe;
+        auto              result = platform::process::spawn_process(request, &stdin_pipe, &stdout_pipe, &stderr_pipe);
+        timed.done(result.has_value());
         if(result) {
             handle_ = result.value();
             stdin_  = stdin_pipe;
@@ -246,7 +235,11 @@ class process {
     }
 
     // Static utilities
-    static process_caps capabilities() noexcept { return platform::process::query_process_caps(); }
+    // Probed once per process (see asyncle/system.hpp); query_process_caps() probes again
+    static const process_caps& capabilities() noexcept {
+        static const process_caps caps = platform::process::query_process_caps();
+        return caps;
+    }
 
     // Accessors
     const process_handle& handle() const noexcept { return handle_; }
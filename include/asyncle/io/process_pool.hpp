@@ -0,0 +1,336 @@
+#ifndef ASYNCLE_IO_PROCESS_POOL_HPP
+#define ASYNCLE_IO_PROCESS_POOL_HPP
+
+#include "../../platform/process.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <signal.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+namespace asyncle::io {
+
+// Framed request/response protocol between a process_pool and its workers.
+// Every message, in both directions, is a 4-byte little-endian payload length
+// followed by the payload. A worker loops: read a request frame from stdin,
+// write exactly one response frame to stdout.
+inline constexpr size_t   frame_header_size = 4;
+inline constexpr uint32_t default_max_frame = 64u << 20;
+
+namespace detail {
+
+inline void encode_frame_length(uint32_t length, std::byte* out) noexcept {
+    for(size_t i = 0; i < frame_header_size; ++i) out[i] = static_cast<std::byte>(length >> (8 * i));
+}
+
+inline uint32_t decode_frame_length(const std::byte* in) noexcept {
+    uint32_t length = 0;
+    for(size_t i = 0; i < frame_header_size; ++i) length |= static_cast<uint32_t>(in[i]) << (8 * i);
+    return length;
+}
+
+// Blocking full read/write on a worker's own stdin/stdout (blocking descriptors)
+inline bool read_full(int fd, std::byte* data, size_t length) noexcept {
+    while(length > 0) {
+        ssize_t got = ::read(fd, data, length);
+        if(got < 0 && errno == EINTR) continue;
+        if(got <= 0) return false;
+        data += got;
+        length -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+inline bool write_full(int fd, const std::byte* data, size_t length) noexcept {
+    while(length > 0) {
+        ssize_t put = ::write(fd, data, length);
+        if(put < 0 && errno == EINTR) continue;
+        if(put <= 0) return false;
+        data += put;
+        length -= static_cast<size_t>(put);
+    }
+    return true;
+}
+
+}  // namespace detail
+
+// Worker side: read the next request frame from fd (stdin by default); false at
+// EOF (the pool is shutting down), on error, or when the frame exceeds max_size
+inline bool read_frame(std::vector<std::byte>& payload, int fd = STDIN_FILENO, uint32_t max_size = default_max_frame) {
+    std::byte header[frame_header_size];
+    if(!detail::read_full(fd, header, frame_header_size)) return false;
+    uint32_t length = detail::decode_frame_length(header);
+    if(length > max_size) return false;
+    payload.resize(length);
+    return detail::read_full(fd, payload.data(), length);
+}
+
+// Worker side: write one response frame to fd (stdout by default)
+inline bool write_frame(std::span<const std::byte> payload, int fd = STDOUT_FILENO) noexcept {
+    if(payload.size() > UINT32_MAX) return false;
+    std::byte header[frame_header_size];
+    detail::encode_frame_length(static_cast<uint32_t>(payload.size()), header);
+    return detail::write_full(fd, header, frame_header_size) && detail::write_full(fd, payload.data(), payload.size());
+}
+
+// Worker command line and limits for a process_pool
+struct pool_options {
+    const char*        executable     = nullptr;            // Worker program
+    const char* const* args           = nullptr;            // NULL-terminated argv
+    const char* const* env            = nullptr;            // nullptr = inherit
+    const char*        working_dir    = nullptr;            // nullptr = inherit
+    size_t             workers        = 4;                  // Warm children kept alive
+    uint32_t           max_response   = default_max_frame;  // Larger responses fail the call
+    int                timeout_ms     = -1;                 // Per call; -1 = none
+    bool               inherit_stderr = true;               // Else stderr goes to /dev/null
+};
+
+// Keeps options.workers children warm and runs framed requests on them
+//
+// call() checks out an idle worker (blocking while all are busy), writes the
+// request frame to its stdin, and reads one response frame from its stdout.
+// Safe to call from many threads; each call holds one worker.
+//
+// A worker that has died, or that fails a call (broken pipe, EOF, oversized
+// response, timeout), is killed, reaped and respawned. The failing call returns
+// process_terminated (would_block on timeout) and is not retried, since the
+// request may have had side effects.
+//
+//   const char* argv[] = { "/usr/libexec/resizer", nullptr };
+//   process_pool pool({ .executable = argv[0], .args = argv, .workers = 8 });
+//   std::string  out;
+//   auto         n = pool.call(request_bytes, out);
+class process_pool {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = process_error;
+    template <typename T>
+    using result_type      = process_result<T>;
+    using void_result_type = process_void_result;
+
+    private:
+    using clock = std::chrono::steady_clock;
+
+    struct worker {
+        process  child;
+        uint64_t calls = 0;      // Calls served by the current child
+        bool     alive = false;  // Spawned and not yet reaped
+    };
+
+    pool_options            options_;
+    spawn_request           request_ {};
+    std::vector<worker>     workers_;
+    std::vector<size_t>     idle_;
+    std::mutex              mutex_;
+    std::condition_variable available_;
+    uint64_t                respawns_ = 0;
+    bool                    stopped_  = false;
+
+    static process_error error(process::error_code code) noexcept { return process_error(code); }
+
+    process_void_result spawn(worker& w) noexcept {
+        w.child = process(request_);
+        w.calls = 0;
+        w.alive = w.child.is_running();
+        if(!w.alive) return process_void_result(unexpect, error(process::error_code::process_not_found));
+        return process_void_result();
+    }
+
+    // Kill and reap a worker whose protocol state is unknown, then start a fresh one
+    void replace(worker& w) noexcept {
+        if(w.alive) {
+            w.child.kill(SIGKILL);
+            w.child.wait();
+        }
+        spawn(w);
+        std::lock_guard lock(mutex_);
+        ++respawns_;
+    }
+
+    int remaining_ms(clock::time_point deadline) const noexcept {
+        if(options_.timeout_ms < 0) return -1;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+        return left > 0 ? static_cast<int>(left) : 0;
+    }
+
+    process_void_result write_all(worker& w, const std::byte* data, size_t length, clock::time_point deadline) noexcept {
+        while(length > 0) {
+            auto put = w.child.write_stdin(data, length);
+            if(put) {
+                data += put.value();
+                length -= put.value();
+                continue;
+            }
+            if(put.error().code != process::error_code::would_block) {
+                return process_void_result(unexpect, error(process::error_code::process_terminated));
+            }
+            auto ready = platform::process::wait_pipe(w.child.stdin_pipe(), true, remaining_ms(deadline));
+            if(!ready || !ready.value()) return process_void_result(unexpect, error(process::error_code::would_block));
+        }
+        return process_void_result();
+    }
+
+    process_void_result read_all(worker& w, std::byte* data, size_t length, clock::time_point deadline) noexcept {
+        while(length > 0) {
+            auto got = w.child.read_stdout(data, length);
+            if(got) {
+                if(got.value() == 0) return process_void_result(unexpect, error(process::error_code::process_terminated));
+                data += got.value();
+                length -= got.value();
+                continue;
+            }
+            if(got.error().code != process::error_code::would_block) {
+                return process_void_result(unexpect, error(process::error_code::process_terminated));
+            }
+            auto ready = platform::process::wait_pipe(w.child.stdout_pipe(), false, remaining_ms(deadline));
+            if(!ready || !ready.value()) return process_void_result(unexpect, error(process::error_code::would_block));
+        }
+        return process_void_result();
+    }
+
+    process_result<size_t> exchange(worker& w, std::span<const std::byte> request, auto& response) {
+        if(request.size() > UINT32_MAX) {
+            return process_result<size_t>(unexpect, error(process::error_code::invalid_argument));
+        }
+        auto deadline = clock::now() + std::chrono::milliseconds(options_.timeout_ms < 0 ? 0 : options_.timeout_ms);
+
+        std::byte header[frame_header_size];
+        detail::encode_frame_length(static_cast<uint32_t>(request.size()), header);
+        auto sent = write_all(w, header, frame_header_size, deadline);
+        if(sent && !request.empty()) sent = write_all(w, request.data(), request.size(), deadline);
+        if(!sent) return process_result<size_t>(unexpect, sent.error());
+
+        auto received = read_all(w, header, frame_header_size, deadline);
+        if(!received) return process_result<size_t>(unexpect, received.error());
+        uint32_t length = detail::decode_frame_length(header);
+        if(length > options_.max_response) {
+            return process_result<size_t>(unexpect, error(process::error_code::no_memory));
+        }
+        response.resize(length);
+        if(length > 0) {
+            received = read_all(w, reinterpret_cast<std::byte*>(response.data()), length, deadline);
+            if(!received) return process_result<size_t>(unexpect, received.error());
+        }
+        ++w.calls;
+        return process_result<size_t>(static_cast<size_t>(length));
+    }
+
+    template <typename Response>
+    process_result<size_t> run(std::span<const std::byte> request, Response& response) {
+        size_t index;
+        {
+            std::unique_lock lock(mutex_);
+            available_.wait(lock, [&] { return stopped_ || !idle_.empty(); });
+            if(stopped_) return process_result<size_t>(unexpect, error(process::error_code::invalid_argument));
+            index = idle_.back();
+            idle_.pop_back();
+        }
+        worker& w = workers_[index];
+
+        // An idle worker may have died since its last call
+        if(w.alive && w.child.wait(true)) w.alive = false;
+        if(!w.alive) replace(w);
+
+        process_result<size_t> result =
+          w.alive ? exchange(w, request, response)
+                  : process_result<size_t>(unexpect, error(process::error_code::process_not_found));
+        if(!result && w.alive) replace(w);
+
+        {
+            std::lock_guard lock(mutex_);
+            idle_.push_back(index);
+        }
+        available_.notify_all();  // Wakes shutdown() as well as waiting callers
+        return result;
+    }
+
+    public:
+    // Spawns options.workers children; check ready() afterwards
+    explicit process_pool(const pool_options& options): options_(options) {
+        request_.executable  = options.executable;
+        request_.args        = options.args;
+        request_.env         = options.env;
+        request_.working_dir = options.working_dir;
+        request_.stdin_mode  = pipe_mode::pipe;
+        request_.stdout_mode = pipe_mode::pipe;
+        request_.stderr_mode = options.inherit_stderr ? pipe_mode::inherit : pipe_mode::none;
+
+        workers_.resize(options.workers);
+        idle_.reserve(options.workers);
+        for(size_t i = options.workers; i-- > 0;) {
+            spawn(workers_[i]);
+            idle_.push_back(i);
+        }
+    }
+
+    // No copy or move: workers are checked out by reference
+    process_pool(const process_pool&)            = delete;
+    process_pool& operator=(const process_pool&) = delete;
+
+    ~process_pool() { shutdown(); }
+
+    // Run one request on an idle worker; returns the response size
+    process_result<size_t> call(std::span<const std::byte> request, std::vector<std::byte>& response) {
+        return run(request, response);
+    }
+
+    process_result<size_t> call(std::string_view request, std::string& response) {
+        return run(std::as_bytes(std::span<const char>(request.data(), request.size())), response);
+    }
+
+    // Fail waiting and later calls with invalid_argument, let calls in progress
+    // finish, then close every worker's stdin (EOF ends the worker loop) and reap
+    void shutdown() noexcept {
+        {
+            std::unique_lock lock(mutex_);
+            if(stopped_) return;
+            stopped_ = true;
+            available_.notify_all();
+            available_.wait(lock, [&] { return idle_.size() == workers_.size(); });
+        }
+        for(auto& w : workers_) {
+            if(!w.alive) continue;
+            w.child.close_stdin();
+            w.child.wait();
+            w.alive = false;
+        }
+        workers_.clear();
+        idle_.clear();
+    }
+
+    // Accessors
+    size_t size() const noexcept { return workers_.size(); }
+
+    // All workers started
+    bool ready() const noexcept {
+        for(auto const& w : workers_) {
+            if(!w.alive) return false;
+        }
+        return !workers_.empty();
+    }
+
+    size_t idle() noexcept {
+        std::lock_guard lock(mutex_);
+        return idle_.size();
+    }
+
+    // Workers replaced after dying or failing a call
+    uint64_t respawns() noexcept {
+        std::lock_guard lock(mutex_);
+        return respawns_;
+    }
+
+    const pool_options& options() const noexcept { return options_; }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_PROCESS_POOL_HPP
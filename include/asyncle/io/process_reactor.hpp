@@ -0,0 +1,254 @@
+#ifndef ASYNCLE_IO_PROCESS_REACTOR_HPP
+#define ASYNCLE_IO_PROCESS_REACTOR_HPP
+
+#include "../../platform/process.hpp"
+#include "process.hpp"
+#include "result.hpp"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+// Import platform types
+using platform::process::reactor_event;
+using platform::process::reactor_events;
+using platform::process::reactor_handle;
+
+// Which watched source a process_event refers to
+enum class process_ready : uint8_t {
+    stdout_data = 0,  // stdout readable: data, or EOF once the child closed it
+    stderr_data = 1,  // stderr readable
+    exited      = 2   // Process exited; process::wait() returns without blocking
+};
+
+// One readiness or exit notification (16 bytes)
+struct process_event {
+    uint64_t      user_data;  // Value given to watch()
+    uint32_t      id;         // Watch id returned by watch()
+    process_ready source;     // What is ready
+    bool          hangup;     // Pipe writer closed; read until 0 bytes, then stop watching it
+    uint16_t      _padding;
+};
+
+// Supervises many children from one thread (epoll + pidfd on Linux)
+//
+// watch() registers a child's stdout/stderr pipes (non-blocking since spawn)
+// and an exit handle in one multiplexer; wait() returns a batch of events.
+// Pipe events are level-triggered: a pipe keeps reporting until drained. The
+// exit event fires once; data may still be buffered in the pipes after it.
+//
+//   process_reactor reactor(500);
+//   auto id = reactor.watch(child, index);
+//   process_event events[64];
+//   auto n = reactor.wait(events);        // then read_stdout / wait() per event
+//
+// The reactor does not own the process objects. Call unwatch(id, source) before
+// closing a watched pipe and unwatch(id) before destroying the process, so a
+// reused descriptor number is never registered twice.
+class process_reactor {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = process_error;
+    template <typename T>
+    using result_type      = process_result<T>;
+    using void_result_type = process_void_result;
+
+    // Events translated per wait() call at most
+    static constexpr size_t max_batch = 256;
+
+    private:
+    static constexpr uint64_t source_bits = 2;
+    static constexpr uint32_t no_slot     = static_cast<uint32_t>(-1);
+
+    struct watch_slot {
+        uint64_t    user_data = 0;
+        int32_t     fds[2]    = { -1, -1 };  // stdout, stderr as registered
+        pipe_handle exit;                    // Owned exit handle (pidfd)
+        bool        active = false;
+    };
+
+    reactor_handle          handle_;
+    std::vector<watch_slot> slots_;
+    std::vector<uint32_t>   free_;
+    size_t                  watched_ = 0;
+
+    static constexpr uint64_t token(uint32_t id, process_ready source) noexcept {
+        return (static_cast<uint64_t>(id) << source_bits) | static_cast<uint64_t>(source);
+    }
+
+    void release_slot(uint32_t id) noexcept {
+        watch_slot& slot = slots_[id];
+        for(int32_t& fd : slot.fds) {
+            if(fd >= 0) platform::process::reactor_remove(handle_, fd);
+            fd = -1;
+        }
+        if(slot.exit.is_valid()) platform::process::close_pipe(slot.exit);
+        slot = watch_slot {};
+        free_.push_back(id);
+        --watched_;
+    }
+
+    public:
+    // Constructors
+    process_reactor() noexcept = default;
+
+    explicit process_reactor(size_t expected_children) {
+        open();
+        slots_.reserve(expected_children);
+        free_.reserve(expected_children);
+    }
+
+    // Move semantics
+    process_reactor(process_reactor&& other) noexcept:
+        handle_(std::exchange(other.handle_, reactor_handle {})),
+        slots_(std::move(other.slots_)),
+        free_(std::move(other.free_)),
+        watched_(std::exchange(other.watched_, 0)) {}
+
+    process_reactor& operator=(process_reactor&& other) noexcept {
+        if(this != &other) {
+            close();
+            handle_  = std::exchange(other.handle_, reactor_handle {});
+            slots_   = std::move(other.slots_);
+            free_    = std::move(other.free_);
+            watched_ = std::exchange(other.watched_, 0);
+        }
+        return *this;
+    }
+
+    // No copy
+    process_reactor(const process_reactor&)            = delete;
+    process_reactor& operator=(const process_reactor&) = delete;
+
+    // Destructor
+    ~process_reactor() { close(); }
+
+    // Core operations
+    process_void_result open() noexcept {
+        close();
+        auto result = platform::process::create_reactor();
+        if(!result) return process_void_result(unexpect, result.error());
+        handle_ = result.value();
+        return process_void_result();
+    }
+
+    void close() noexcept {
+        for(auto& slot : slots_) {
+            if(slot.exit.is_valid()) platform::process::close_pipe(slot.exit);
+        }
+        slots_.clear();
+        free_.clear();
+        watched_ = 0;
+        platform::process::destroy_reactor(handle_);
+    }
+
+    // Watch p's stdout/stderr pipes (those it has) and its exit; returns the watch id
+    process_result<uint32_t> watch(const process& p, uint64_t user_data = 0) {
+        if(!is_open() || !p.is_running()) {
+            return process_result<uint32_t>(unexpect, process_error(process::error_code::invalid_argument));
+        }
+
+        auto exit = platform::process::open_exit_handle(p.handle());
+        if(!exit) return process_result<uint32_t>(unexpect, exit.error());
+
+        uint32_t id = no_slot;
+        if(!free_.empty()) {
+            id = free_.back();
+            free_.pop_back();
+        } else {
+            id = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+            free_.reserve(slots_.size());  // release_slot never allocates
+        }
+        ++watched_;
+
+        watch_slot& slot = slots_[id];
+        slot.active      = true;
+        slot.user_data   = user_data;
+        slot.exit        = exit.value();
+
+        auto added = platform::process::reactor_add(handle_, slot.exit.fd, token(id, process_ready::exited),
+                                                    reactor_events::readable | reactor_events::oneshot);
+        const pipe_handle* pipes[2] = { &p.stdout_pipe(), &p.stderr_pipe() };
+        for(int i = 0; i < 2 && added; ++i) {
+            if(!pipes[i]->is_valid()) continue;
+            added = platform::process::reactor_add(handle_, pipes[i]->fd, token(id, static_cast<process_ready>(i)),
+                                                   reactor_events::readable);
+            if(added) slot.fds[i] = pipes[i]->fd;
+        }
+        if(!added) {
+            auto error = added.error();
+            release_slot(id);
+            return process_result<uint32_t>(unexpect, error);
+        }
+        return process_result<uint32_t>(id);
+    }
+
+    // Stop watching one pipe of a watched process (call before closing that pipe)
+    process_void_result unwatch(uint32_t id, process_ready source) noexcept {
+        if(!watching(id) || source == process_ready::exited) {
+            return process_void_result(unexpect, process_error(process::error_code::invalid_argument));
+        }
+        int32_t& fd = slots_[id].fds[static_cast<size_t>(source)];
+        if(fd < 0) return process_void_result();
+        auto result = platform::process::reactor_remove(handle_, fd);
+        fd          = -1;
+        return result;
+    }
+
+    // Stop watching a process entirely; id may be reused by a later watch()
+    process_void_result unwatch(uint32_t id) noexcept {
+        if(!watching(id)) { return process_void_result(unexpect, process_error(process::error_code::invalid_argument)); }
+        release_slot(id);
+        return process_void_result();
+    }
+
+    // Wait up to timeout_ms (-1 = forever, 0 = poll) and fill events with up to
+    // max_batch notifications; returns how many, 0 on timeout
+    process_result<size_t> wait(std::span<process_event> events, int timeout_ms = -1) noexcept {
+        if(!is_open() || events.empty()) {
+            return process_result<size_t>(unexpect, process_error(process::error_code::invalid_argument));
+        }
+
+        reactor_event raw[max_batch];
+        size_t        limit = events.size() < max_batch ? events.size() : max_batch;
+        auto          ready = platform::process::reactor_wait(handle_, raw, limit, timeout_ms);
+        if(!ready) return ready;
+
+        size_t count = 0;
+        for(size_t i = 0; i < ready.value(); ++i) {
+            uint32_t id = static_cast<uint32_t>(raw[i].token >> source_bits);
+            if(!watching(id)) continue;
+            process_event& out = events[count++];
+            out.user_data      = slots_[id].user_data;
+            out.id             = id;
+            out.source         = static_cast<process_ready>(raw[i].token & ((1u << source_bits) - 1));
+            out.hangup         = out.source != process_ready::exited
+                     && platform::process::has_event(raw[i].events, reactor_events::hangup);
+            out._padding       = 0;
+        }
+        return process_result<size_t>(count);
+    }
+
+    // Accessors
+    bool is_open() const noexcept { return handle_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    bool watching(uint32_t id) const noexcept { return id < slots_.size() && slots_[id].active; }
+
+    uint64_t user_data(uint32_t id) const noexcept { return watching(id) ? slots_[id].user_data : 0; }
+
+    // Processes currently watched
+    size_t size() const noexcept { return watched_; }
+
+    bool empty() const noexcept { return watched_ == 0; }
+
+    const reactor_handle& handle() const noexcept { return handle_; }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_PROCESS_REACTOR_HPP
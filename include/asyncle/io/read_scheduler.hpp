@@ -0,0 +1,400 @@
+#ifndef ASYNCLE_IO_READ_SCHEDULER_HPP
+#define ASYNCLE_IO_READ_SCHEDULER_HPP
+
+// asyncle::io read scheduler - Scan many files at the pace each device can take
+//
+// Reading thousands of shards one after another leaves an NVMe drive idle;
+// reading them all at once buries a spinning disk in seeks. read_scheduler
+// groups files by device (file_info::device, or a group the caller names) and
+// gives every device a budget: reads in flight (queue depth) and bytes in
+// flight. One driver thread cuts each file into block_size reads and queues
+// them on an io_ring while the budgets allow. Within a device the files take
+// turns, one read each, so a large file never holds up the small ones; across
+// devices a priority-3 device is offered three reads for every one offered to
+// a priority-1 device, as long as both have budget left.
+//
+// Completed blocks go to an mpmc_queue as read_chunk, for any number of
+// consumer threads. A chunk's data stays valid until release(), which any
+// thread may call. Buffers come from one dio_buffer_pool registered with the
+// ring, so consumers that hold on to chunks slow the reads down instead of
+// growing memory. A file with several reads in flight can deliver its chunks
+// out of offset order, and a file that shrinks during the scan ends with a
+// short chunk. A file added by path is opened at its first read and closed
+// after its last, so a scan of many thousands of shards only holds
+// descriptors for the files being read. A scheduler can be reused: add()
+// after finished() starts another scan.
+//
+// Without io_uring (file::capabilities().supports_async_io is false, the ring
+// fails to open, or options.use_ring is false) step() reads the blocks inline
+// with pread, in the same order. add(), set_budget(), step() and run() belong
+// to the driver thread; next(), try_next(), release() and finished() are safe
+// from any thread.
+// The two queues make the object about 64 KiB.
+//
+// Usage:
+//   io::read_scheduler scan({ .block_size = 1 << 20 });
+//   for(const auto& path : shards) scan.add(path.c_str());
+//   scan.set_budget(hdd_device, { .max_bytes_in_flight = 4 << 20, .max_queue_depth = 2 });
+//   std::thread driver([&] { scan.run(); });
+//
+//   io::read_chunk chunk;                          // On each consumer thread
+//   while(scan.next(chunk)) {
+//       parse(chunk.file, chunk.offset, chunk.bytes());
+//       scan.release(chunk);
+//   }
+
+#include "../concurrent/mpmc_queue.hpp"
+#include "buffer_pool.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include "ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+struct device_budget {
+    size_t   max_bytes_in_flight = size_t { 16 } << 20;  // One read may exceed it when the device is idle
+    uint32_t max_queue_depth     = 32;
+    uint32_t priority            = 1;  // Reads offered per round relative to other devices (0 counts as 1)
+};
+
+struct read_scheduler_options {
+    size_t        block_size   = size_t { 256 } << 10;  // Largest single read
+    uint32_t      buffers      = 128;  // Blocks in flight or held by consumers (at most chunk_capacity)
+    uint32_t      ring_entries = 128;
+    bool          use_ring     = true;  // false reads inline with pread even when io_uring works
+    device_budget defaults {};  // Budget of devices without set_budget()
+};
+
+// One block of a file, passed from the driver to a consumer
+struct read_chunk {
+    const char* data   = nullptr;
+    size_t      length = 0;  // Bytes read; 0 when error is set
+    uint64_t    offset = 0;  // File offset of data[0]
+    uint32_t    file   = 0;  // Index add() returned
+    uint32_t    buffer = 0;  // Pool buffer, returned by release()
+    file_error  error {};    // A failed read ends its file
+
+    bool ok() const noexcept { return error.code == error_code::success; }
+
+    std::span<const std::byte> bytes() const noexcept {
+        return { reinterpret_cast<const std::byte*>(data), length };
+    }
+};
+
+// Per-device counters, updated by the driver thread
+struct read_device_stats {
+    uint64_t device               = 0;  // file_info::device or the group passed to add()
+    uint64_t reads                = 0;
+    uint64_t bytes                = 0;
+    size_t   peak_bytes_in_flight = 0;
+    uint32_t peak_queue_depth     = 0;
+};
+
+class read_scheduler {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    // Most chunks that can wait for consumers; options.buffers is clamped to it
+    static constexpr uint32_t chunk_capacity = 512;
+
+    private:
+    struct source {
+        file        handle {};
+        std::string path {};  // add(path): opened at the first read
+        uint64_t    size      = 0;
+        uint64_t    next      = 0;  // Offset of the next read to queue
+        uint32_t    device    = 0;  // Index into devices_
+        uint32_t    in_flight = 0;
+        bool        failed    = false;
+    };
+
+    struct device_state {
+        device_budget        budget {};
+        std::deque<uint32_t> ready {};  // Files with blocks left to queue, in turn order
+        size_t               bytes_in_flight = 0;
+        uint32_t             in_flight       = 0;
+    };
+
+    // A queued read, indexed by its buffer (and ring user_data)
+    struct pending_read {
+        dio_buffer buffer;
+        uint64_t   offset = 0;
+        uint32_t   file   = 0;
+        uint32_t   length = 0;
+    };
+
+    read_scheduler_options         options_;
+    dio_buffer_pool                pool_;
+    io_ring                        ring_;
+    bool                           fixed_ = false;  // Pool registered with the ring
+    std::vector<source>            sources_;
+    std::vector<device_state>      devices_;
+    std::vector<read_device_stats> stats_;
+    std::vector<pending_read>      pending_;
+    size_t                         unqueued_  = 0;  // Files with blocks left to queue
+    uint32_t                       in_flight_ = 0;
+    size_t                         first_     = 0;  // Device offered reads first in the next fill
+
+    concurrent::mpmc_queue<read_chunk, chunk_capacity> chunks_;
+    concurrent::mpmc_queue<uint32_t, chunk_capacity>   returned_;
+    std::atomic<bool>                                  done_ { true };
+
+    uint32_t device_index(uint64_t device) {
+        for(uint32_t i = 0; i < stats_.size(); ++i) {
+            if(stats_[i].device == device) return i;
+        }
+        devices_.push_back(device_state { .budget = options_.defaults });
+        stats_.push_back(read_device_stats { .device = device });
+        return static_cast<uint32_t>(devices_.size() - 1);
+    }
+
+    // Return buffers released by consumers to the pool
+    void reclaim() noexcept {
+        uint32_t index;
+        while(returned_.take(index)) pool_.release(pending_[index].buffer);
+    }
+
+    // Account for a finished read and pass its chunk on. Every chunk holds a
+    // buffer and buffers <= chunk_capacity, so the push always fits.
+    void complete(const pending_read& read, size_t length, file_error error) noexcept {
+        source&       src = sources_[read.file];
+        device_state& dev = devices_[src.device];
+        dev.bytes_in_flight -= read.length;
+        --dev.in_flight;
+        --in_flight_;
+        if(error.code == error_code::success) {
+            ++stats_[src.device].reads;
+            stats_[src.device].bytes += length;
+        } else {
+            src.failed = true;
+        }
+        // Close a file after its last read so only files being read hold descriptors
+        if(--src.in_flight == 0 && (src.failed || src.next >= src.size)) src.handle.close();
+
+        read_chunk chunk;
+        chunk.data   = static_cast<const char*>(read.buffer.data);
+        chunk.length = error.code == error_code::success ? length : 0;
+        chunk.offset = read.offset;
+        chunk.file   = read.file;
+        chunk.buffer = read.buffer.index;
+        chunk.error  = error;
+        chunks_.push(chunk);
+    }
+
+    // Queue (or, without a ring, perform) the next read of device d's next file
+    bool issue(uint32_t d) noexcept {
+        device_state& dev = devices_[d];
+        while(!dev.ready.empty() && sources_[dev.ready.front()].failed) {
+            dev.ready.pop_front();
+            --unqueued_;
+        }
+        if(dev.ready.empty() || dev.in_flight >= std::max(dev.budget.max_queue_depth, 1u)) return false;
+        if(ring_.is_open() && in_flight_ >= ring_.capacity()) return false;
+
+        const uint32_t id  = dev.ready.front();
+        source&        src = sources_[id];
+        const size_t   len = static_cast<size_t>(std::min<uint64_t>(options_.block_size, src.size - src.next));
+        if(dev.in_flight > 0 && dev.bytes_in_flight + len > dev.budget.max_bytes_in_flight) return false;
+
+        dio_buffer buffer = pool_.acquire();
+        if(!buffer) return false;
+        pending_read& read = pending_[buffer.index];
+        read               = pending_read { buffer, src.next, id, static_cast<uint32_t>(len) };
+
+        src.next += len;
+        dev.ready.pop_front();
+        if(src.next < src.size) {
+            dev.ready.push_back(id);
+        } else {
+            --unqueued_;
+        }
+        dev.bytes_in_flight += len;
+        ++dev.in_flight;
+        ++in_flight_;
+        ++src.in_flight;
+        read_device_stats& s   = stats_[d];
+        s.peak_bytes_in_flight = std::max(s.peak_bytes_in_flight, dev.bytes_in_flight);
+        s.peak_queue_depth     = std::max(s.peak_queue_depth, dev.in_flight);
+
+        // Files added by path are opened for their first read
+        if(!src.handle.is_open()) {
+            if(auto opened = src.handle.open(src.path.c_str()); !opened) {
+                complete(read, 0, opened.error());
+                return true;
+            }
+        }
+        if(ring_.is_open()) {
+            // in_flight_ <= capacity, so the submission queue has room; a
+            // rejected request fails its file like a failed read
+            io_request req    = buffer.request(read.offset, len);
+            auto       queued = fixed_ ? src.handle.queue_read_fixed(ring_, &req, 1, buffer.index)
+                                       : src.handle.queue_read(ring_, &req, 1, buffer.index);
+            if(!queued || *queued == 0) complete(read, 0, queued ? file_error(error_code::io_error) : queued.error());
+        } else {
+            auto got = src.handle.read(buffer.data, len, read.offset);
+            complete(read, got ? *got : 0, got ? file_error() : got.error());
+        }
+        return true;
+    }
+
+    // Weighted round robin: each pass offers every device priority reads,
+    // until a pass queues nothing
+    size_t fill() noexcept {
+        const size_t n      = devices_.size();
+        size_t       queued = 0;
+        for(bool progress = true; progress && unqueued_ > 0;) {
+            progress = false;
+            for(size_t k = 0; k < n; ++k) {
+                const uint32_t d = static_cast<uint32_t>((first_ + k) % n);
+                for(uint32_t share = std::max(devices_[d].budget.priority, 1u); share > 0; --share) {
+                    if(!issue(d)) break;
+                    progress = true;
+                    ++queued;
+                }
+            }
+        }
+        if(n > 0) first_ = (first_ + 1) % n;
+        return queued;
+    }
+
+    file_result<size_t> reap(bool block) noexcept {
+        io_completion done[64];
+        auto          reaped = ring_.complete(done, 64, block && in_flight_ > 0 ? 1 : 0);
+        if(!reaped) return reaped;
+        for(size_t i = 0; i < *reaped; ++i) {
+            complete(pending_[done[i].user_data], done[i].result.bytes_transferred, done[i].error);
+        }
+        return reaped;
+    }
+
+    file_result<uint32_t> add_source(source&& src, uint64_t device) {
+        if(!is_valid()) return file_result<uint32_t>(unexpect, file_error(error_code::invalid_argument));
+        const uint32_t id = static_cast<uint32_t>(sources_.size());
+        src.device        = device_index(device);
+        if(src.size > 0) {
+            devices_[src.device].ready.push_back(id);
+            ++unqueued_;
+            done_.store(false, std::memory_order_relaxed);
+        } else {
+            src.handle.close();
+        }
+        sources_.push_back(std::move(src));
+        return id;
+    }
+
+    public:
+    // Constructors
+    explicit read_scheduler(const read_scheduler_options& options = {}) noexcept: options_(options) {
+        options_.buffers = std::clamp(options_.buffers, 1u, chunk_capacity);
+        if(!pool_.create(options_.block_size, options_.buffers)) return;
+        pending_.resize(options_.buffers);
+        if(options_.use_ring && file::capabilities().supports_async_io) {
+            if(ring_.open(ring_request(options_.ring_entries))) fixed_ = static_cast<bool>(pool_.register_with(ring_));
+        }
+    }
+
+    // Not movable: consumers and queued reads point into the scheduler
+    read_scheduler(const read_scheduler&)            = delete;
+    read_scheduler& operator=(const read_scheduler&) = delete;
+
+    // Core operations
+    // Schedule path on its device; returns the file index. The file is opened
+    // when its first read is queued and closed after its last one completes.
+    file_result<uint32_t> add(const char* path) {
+        auto info = file::stat(path);
+        if(!info) return file_result<uint32_t>(unexpect, info.error());
+        return add_source(source { .path = path, .size = info->size }, info->device);
+    }
+
+    // Schedule an open file under device group (e.g. one group per physical
+    // disk when its partitions report different devices)
+    file_result<uint32_t> add(file&& f, uint64_t device) {
+        if(!f.is_open()) return file_result<uint32_t>(unexpect, file_error(error_code::invalid_argument));
+        auto size = f.size();
+        if(!size) return file_result<uint32_t>(unexpect, size.error());
+        return add_source(source { .handle = std::move(f), .size = *size }, device);
+    }
+
+    // Budget for a device (or group); files may be added before or after
+    void set_budget(uint64_t device, const device_budget& budget) { devices_[device_index(device)].budget = budget; }
+
+    // Queue what the budgets allow and deliver what completed; with block,
+    // waits for at least one completion when reads are in flight. Returns the
+    // number of chunks delivered.
+    file_result<size_t> step(bool block = true) noexcept {
+        if(!is_valid()) return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        reclaim();
+        size_t delivered = fill();
+        if(ring_.is_open()) {
+            if(auto submitted = ring_.submit(); !submitted) return file_result<size_t>(unexpect, submitted.error());
+            auto reaped = reap(block);
+            if(!reaped) return reaped;
+            delivered = *reaped;
+        }
+        if(unqueued_ == 0 && in_flight_ == 0) done_.store(true, std::memory_order_release);
+        return delivered;
+    }
+
+    // Drive step() until every file is read. While consumers hold every
+    // buffer the driver yields.
+    file_void_result run() noexcept {
+        while(!finished()) {
+            auto stepped = step(true);
+            if(!stepped) return file_void_result(unexpect, stepped.error());
+            if(*stepped == 0 && in_flight_ == 0) std::this_thread::yield();
+        }
+        return file_void_result();
+    }
+
+    // Consumer side (any thread)
+    bool try_next(read_chunk& out) noexcept { return chunks_.take(out); }
+
+    // Wait for the next chunk; false once every file is read and delivered
+    bool next(read_chunk& out) noexcept {
+        for(;;) {
+            if(chunks_.take(out)) return true;
+            if(done_.load(std::memory_order_acquire)) return chunks_.take(out);
+            std::this_thread::yield();
+        }
+    }
+
+    // Hand a chunk's buffer back for the next read
+    void release(const read_chunk& chunk) noexcept { returned_.push(chunk.buffer); }
+
+    // Accessors
+    // Every read queued and completed; chunks may still wait in the queue
+    bool finished() const noexcept { return done_.load(std::memory_order_acquire); }
+
+    std::span<const read_device_stats> devices() const noexcept { return stats_; }
+
+    uint64_t device_of(uint32_t file) const noexcept { return stats_[sources_[file].device].device; }
+
+    size_t file_count() const noexcept { return sources_.size(); }
+
+    uint32_t in_flight() const noexcept { return in_flight_; }
+
+    bool uses_ring() const noexcept { return ring_.is_open(); }
+
+    const read_scheduler_options& options() const noexcept { return options_; }
+
+    bool is_valid() const noexcept { return pool_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_READ_SCHEDULER_HPP
@@ -0,0 +1,238 @@
+#ifndef ASYNCLE_IO_RECORD_READER_HPP
+#define ASYNCLE_IO_RECORD_READER_HPP
+
+// asyncle::io record reader - Delimited records as string_views
+//
+// record_reader splits a file into records that end at a delimiter ('\n' by
+// default) and returns each one as a std::string_view. The delimiter is not
+// included, and the last record may have no delimiter. The delimiter is found
+// with hardware::find_byte, the SIMD byte search, so the scan runs at memory
+// bandwidth.
+//
+// record_source::read pulls blocks into one buffer with pread. A record cut
+// off at the end of a block is moved to the front of the buffer before the
+// next read; the buffer is allocated once and never grows.
+// record_source::mapped views the file through a mapped_reader window instead,
+// with no copy at all. A record that crosses a window edge is remapped into
+// one view. Either way a record longer than max_record fails with
+// error_code::file_too_large.
+//
+// A view stays valid until the next call to next(). Not thread-safe; the file
+// must outlive the reader.
+//
+// Usage:
+//   io::record_reader lines(input);                   // '\n', 1 MiB blocks
+//   std::string_view  line;
+//   while(lines.next(line).value_or(false)) handle(line);
+//
+//   io::record_reader rows(input, { .delimiter = '\x1e', .source = io::record_source::mapped });
+//   rows.for_each([](std::string_view row) { ... });
+
+#include "../hardware/bulk.hpp"
+#include "file.hpp"
+#include "mapped_reader.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace asyncle::io {
+
+enum class record_source : uint8_t {
+    read,   // pread into a reused buffer
+    mapped  // Sliding mmap window, no copy
+};
+
+struct record_reader_options {
+    char          delimiter  = '\n';
+    size_t        block_size = size_t { 1 } << 20;  // read: buffer size; mapped: window size
+    size_t        max_record = 0;                   // Longest record accepted (0 = block_size)
+    record_source source     = record_source::read;
+};
+
+class record_reader {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    const file*             file_ = nullptr;
+    record_reader_options   options_;
+    std::unique_ptr<char[]> buffer_;  // record_source::read
+    size_t                  capacity_ = 0;
+    size_t                  begin_    = 0;  // First byte not yet returned, in buffer_ or chunk_
+    size_t                  end_      = 0;  // Bytes filled (or viewed)
+    size_t                  scanned_  = 0;  // Searched up to here without a delimiter
+    uint64_t                offset_   = 0;  // File offset of buffer_[0] (or chunk_[0])
+    bool                    eof_      = false;
+    mapped_reader           mapped_;  // record_source::mapped
+    const char*             chunk_ = nullptr;
+
+    const char* find(const char* data, size_t length) const noexcept {
+        return static_cast<const char*>(hardware::find_byte(data, length, static_cast<uint8_t>(options_.delimiter)));
+    }
+
+    static file_result<bool> too_long() noexcept {
+        return file_result<bool>(unexpect, file_error(error_code::file_too_large));
+    }
+
+    file_result<bool> next_read(std::string_view& record) noexcept {
+        for(;;) {
+            if(const char* hit = find(buffer_.get() + scanned_, end_ - scanned_)) {
+                const size_t at = static_cast<size_t>(hit - buffer_.get());
+                record          = std::string_view(buffer_.get() + begin_, at - begin_);
+                begin_ = scanned_ = at + 1;
+                return true;
+            }
+            scanned_ = end_;
+            if(eof_) {
+                if(begin_ == end_) return false;
+                record = std::string_view(buffer_.get() + begin_, end_ - begin_);
+                begin_ = scanned_ = end_;
+                return true;
+            }
+            if(end_ - begin_ > options_.max_record) return too_long();
+
+            // Carry the partial record to the front and fill in behind it
+            if(begin_ > 0) {
+                std::memmove(buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+                offset_  += begin_;
+                end_     -= begin_;
+                scanned_ -= begin_;
+                begin_    = 0;
+            }
+            if(end_ == capacity_) return too_long();
+            auto got = file_->read(buffer_.get() + end_, capacity_ - end_, offset_ + end_);
+            if(!got) return file_result<bool>(unexpect, got.error());
+            eof_  = *got == 0;
+            end_ += *got;
+        }
+    }
+
+    // chunk_ is a view of the file at offset_, and the mapped_reader cursor
+    // stays at offset_ until the chunk is used up, so pages are only released
+    // behind records already returned
+    file_result<bool> next_mapped(std::string_view& record) noexcept {
+        for(;;) {
+            if(chunk_) {
+                if(const char* hit = find(chunk_ + scanned_, end_ - scanned_)) {
+                    const size_t at = static_cast<size_t>(hit - chunk_);
+                    record          = std::string_view(chunk_ + begin_, at - begin_);
+                    begin_ = scanned_ = at + 1;
+                    return true;
+                }
+                scanned_ = end_;
+            }
+            const size_t partial = end_ - begin_;
+            if(eof_) {
+                if(partial == 0) return false;
+                record = std::string_view(chunk_ + begin_, partial);
+                begin_ = scanned_ = end_;
+                return true;
+            }
+            if(partial > options_.max_record) return too_long();
+
+            // View again from the first unreturned byte; a cut-off record comes
+            // back whole, remapped if it crossed a window edge
+            mapped_.advance(begin_);
+            const size_t step = std::max(mapped_.window_size() / 4, mmap::page_size());
+            const size_t want = partial + step;
+            auto         view = mapped_.peek(want);
+            if(!view) return file_result<bool>(unexpect, detail::to_file_error(view.error()));
+            chunk_   = reinterpret_cast<const char*>(view->data());
+            offset_  = mapped_.position();
+            begin_   = 0;
+            end_     = view->size();
+            scanned_ = partial;
+            eof_     = end_ < want;
+        }
+    }
+
+    public:
+    // Constructors
+    record_reader() noexcept = default;
+
+    explicit record_reader(const file& f, const record_reader_options& options = {}) noexcept { open(f, options); }
+
+    // Not movable: views point into the reader's own buffer and mapping
+    record_reader(const record_reader&)            = delete;
+    record_reader& operator=(const record_reader&) = delete;
+
+    // Core operations
+    // Read records of f from offset 0
+    file_void_result open(const file& f, const record_reader_options& options = {}) noexcept {
+        close();
+        if(!f.is_open() || options.block_size == 0) {
+            return file_void_result(unexpect, file_error(error_code::invalid_argument));
+        }
+        options_ = options;
+        if(options_.max_record == 0) options_.max_record = options_.block_size;
+
+        if(options_.source == record_source::mapped) {
+            if(auto opened = mapped_.open(f, options_.block_size); !opened) {
+                return file_void_result(unexpect, detail::to_file_error(opened.error()));
+            }
+        } else {
+            // max_record plus one delimiter has to fit after a carry
+            const size_t capacity = std::max(options_.block_size, options_.max_record + 1);
+            if(capacity_ < capacity) {
+                buffer_.reset(new(std::nothrow) char[capacity]);
+                capacity_ = buffer_ ? capacity : 0;
+                if(!buffer_) return file_void_result(unexpect, file_error(error_code::no_memory));
+            }
+        }
+        file_ = &f;
+        return file_void_result();
+    }
+
+    // Keeps the read buffer for the next open()
+    void close() noexcept {
+        mapped_.close();
+        file_  = nullptr;
+        chunk_ = nullptr;
+        begin_ = end_ = scanned_ = 0;
+        offset_                  = 0;
+        eof_                     = false;
+    }
+
+    // Next record into record; false once the file is exhausted
+    file_result<bool> next(std::string_view& record) noexcept {
+        if(!file_) return file_result<bool>(unexpect, file_error(error_code::invalid_argument));
+        return options_.source == record_source::mapped ? next_mapped(record) : next_read(record);
+    }
+
+    // Call fn(std::string_view) for every remaining record; returns how many
+    template <typename F>
+    file_result<uint64_t> for_each(F&& fn) {
+        uint64_t         count = 0;
+        std::string_view record;
+        for(;;) {
+            auto got = next(record);
+            if(!got) return file_result<uint64_t>(unexpect, got.error());
+            if(!*got) return count;
+            fn(record);
+            ++count;
+        }
+    }
+
+    // Accessors
+    // File offset of the first byte not yet returned
+    uint64_t position() const noexcept { return offset_ + begin_; }
+
+    const record_reader_options& options() const noexcept { return options_; }
+
+    bool is_open() const noexcept { return file_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_RECORD_READER_HPP
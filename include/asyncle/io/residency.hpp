@@ -0,0 +1,129 @@
+#ifndef ASYNCLE_IO_RESIDENCY_HPP
+#define ASYNCLE_IO_RESIDENCY_HPP
+
+// asyncle::io residency - Warm files into the page cache and evict them again
+//
+// prewarm() splits a file range into chunks and has a few threads claim them
+// in order. Each chunk is queued whole with readahead(2), so the device sees
+// one large request rather than a series of fault-sized ones, and the thread
+// then waits for it by populating a read-only mapping of the chunk. A thread
+// has at most one chunk outstanding, which bounds the bytes in flight at
+// concurrency x chunk size. Chunks mincore() reports fully resident are
+// skipped without any I/O.
+//
+// evict() is the inverse for cold data: it advises the kernel to drop a range
+// from the page cache. Dirty pages are only queued for writeback and stay
+// cached; sync the file first to evict everything.
+//
+// Usage:
+//   io::file index("index.bin", io::access_mode::read_only);
+//   auto stats = io::prewarm(index, 0, 0, { .concurrency = 8 });   // Whole file
+//   ...
+//   io::evict(index);
+
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace asyncle::io {
+
+struct prewarm_options {
+    size_t concurrency     = 4;                    // Threads with a chunk in flight (1 = calling thread only)
+    size_t bytes_in_flight = size_t { 64 } << 20;  // Budget across all threads; chunk = budget / concurrency
+    bool   skip_resident   = true;                 // Skip chunks mincore() reports fully resident
+};
+
+struct prewarm_stats {
+    uint64_t bytes_read     = 0;  // Bytes of chunks that had to be read
+    uint64_t bytes_resident = 0;  // Bytes of chunks already resident and skipped
+    uint64_t chunks         = 0;  // Chunks read
+};
+
+// Read [offset, offset + length) of f into the page cache and return once it
+// is resident (length 0 = to the end of the file). f needs read access; the
+// range is clamped to the file size.
+inline file_result<prewarm_stats>
+  prewarm(file& f, uint64_t offset = 0, uint64_t length = 0, const prewarm_options& options = {}) noexcept {
+    auto size = f.size();
+    if(!f.is_open() || !size) {
+        return file_result<prewarm_stats>(unexpect, file_error(platform::file::error_code::invalid_argument));
+    }
+    if(offset >= *size) return prewarm_stats {};
+    const uint64_t end = (length == 0 || length > *size - offset) ? *size : offset + length;
+
+    // Map from the enclosing page; the mapping only carries the waits
+    const size_t   page  = mmap::page_size();
+    const uint64_t begin = offset / page * page;
+    mmap           view;
+    if(auto mapped = view.map_file(f, end - begin, begin); !mapped) {
+        return file_result<prewarm_stats>(unexpect, detail::to_file_error(mapped.error()));
+    }
+
+    const size_t   threads = std::max<size_t>(1, options.concurrency);
+    const size_t   chunk   = std::max(page, options.bytes_in_flight / threads / page * page);
+    const uint64_t chunks  = (end - begin + chunk - 1) / chunk;
+
+    std::atomic<uint64_t> next { 0 };
+    std::atomic<bool>     failed { false };
+    std::mutex            lock;
+    prewarm_stats         total;
+    file_error            error;
+
+    auto work = [&] {
+        prewarm_stats mine;
+        while(!failed.load(std::memory_order_relaxed)) {
+            const uint64_t i = next.fetch_add(1);
+            if(i >= chunks) break;
+            const size_t at    = static_cast<size_t>(i * chunk);
+            const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunk, end - begin - at));
+            if(options.skip_resident) {
+                auto resident = view.resident_bytes(at, bytes);
+                if(resident && *resident == bytes) {
+                    mine.bytes_resident += bytes;
+                    continue;
+                }
+            }
+            // A refused readahead only loses the large request; populate still reads
+            f.readahead(begin + at, bytes);
+            if(auto waited = view.populate(at, bytes); !waited) {
+                std::lock_guard guard(lock);
+                if(!failed.exchange(true)) error = detail::to_file_error(waited.error());
+                break;
+            }
+            mine.bytes_read += bytes;
+            ++mine.chunks;
+        }
+        std::lock_guard guard(lock);
+        total.bytes_read += mine.bytes_read;
+        total.bytes_resident += mine.bytes_resident;
+        total.chunks += mine.chunks;
+    };
+
+    // Helpers that fail to start leave their chunks to the threads that did
+    std::vector<std::thread> helpers;
+    try {
+        for(size_t t = 1; t < threads && t < chunks; ++t) helpers.emplace_back(work);
+    } catch(...) {}
+    work();
+    for(auto& helper : helpers) helper.join();
+
+    if(failed.load()) return file_result<prewarm_stats>(unexpect, error);
+    return total;
+}
+
+// Ask the kernel to drop [offset, offset + length) of f from the page cache
+// (length 0 = to the end of the file)
+inline file_void_result evict(file& f, uint64_t offset = 0, uint64_t length = 0) noexcept {
+    return f.advise(offset, length, file_advice::dont_need);
+}
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_RESIDENCY_HPP
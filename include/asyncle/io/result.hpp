@@ -30,6 +30,16 @@ template <typename T>
 using process_result      = platform::process::result<T>;
 using process_void_result = platform::process::void_result;
 
+namespace detail {
+
+// A mapping failure inside a file-level operation, reported as a file I/O error
+inline platform::file::file_error to_file_error(const platform::mmap::memory_error& e) noexcept {
+    return platform::file::file_error(
+      platform::file::error_domain::system, platform::file::error_code::io_error, e.platform_errno);
+}
+
+}  // namespace detail
+
 }  // namespace asyncle::io
 
 #endif  // ASYNCLE_IO_RESULT_HPP
@@ -0,0 +1,158 @@
+#ifndef ASYNCLE_IO_RING_HPP
+#define ASYNCLE_IO_RING_HPP
+
+#include "../../platform/file.hpp"
+#include "result.hpp"
+#include <span>
+#include <utility>
+
+namespace asyncle::io {
+
+// Import platform types
+using platform::file::io_completion;
+using platform::file::ring_buffer;
+using platform::file::ring_handle;
+using platform::file::ring_op;
+using platform::file::ring_request;
+using platform::file::ring_status;
+
+// RAII asynchronous I/O ring (io_uring on Linux)
+// Requests are queued through file::queue_read/queue_write/queue_sync, handed to
+// the kernel in a single submit(), and collected with complete()
+class io_ring {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = platform::file::file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    ring_handle handle_;
+
+    public:
+    // Constructors
+    io_ring() noexcept = default;
+
+    explicit io_ring(const ring_request& request) noexcept {
+        auto result = platform::file::create_ring(request);
+        if(result) { handle_ = result.value(); }
+    }
+
+    explicit io_ring(uint32_t entries) noexcept: io_ring(ring_request(entries)) {}
+
+    // Move semantics
+    io_ring(io_ring&& other) noexcept: handle_(std::exchange(other.handle_, ring_handle {})) {}
+
+    io_ring& operator=(io_ring&& other) noexcept {
+        if(this != &other) {
+            close();
+            handle_ = std::exchange(other.handle_, ring_handle {});
+        }
+        return *this;
+    }
+
+    // No copy
+    io_ring(const io_ring&)            = delete;
+    io_ring& operator=(const io_ring&) = delete;
+
+    // Destructor
+    ~io_ring() { close(); }
+
+    // Core operations
+    file_result<ring_handle> open(const ring_request& request = {}) noexcept {
+        close();
+        auto result = platform::file::create_ring(request);
+        if(result) { handle_ = result.value(); }
+        return result;
+    }
+
+    void close() noexcept {
+        if(handle_.is_valid()) { platform::file::destroy_ring(handle_); }
+    }
+
+    // Queue raw requests for a file handle (see file::queue_read for the RAII form)
+    file_result<size_t> queue(
+      const platform::file::file_handle& file,
+      ring_op                            op,
+      const platform::file::io_request*  requests,
+      size_t                             count,
+      uint64_t                           user_data = 0) noexcept {
+        if(!is_open()) {
+            return file_result<size_t>(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::queue_ring(handle_, file, op, requests, count, user_data);
+    }
+
+    // Fixed buffers for ring_op::read_fixed/write_fixed
+    file_void_result register_buffers(const ring_buffer* buffers, size_t count) noexcept {
+        if(!is_open()) {
+            return file_void_result(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::register_ring_buffers(handle_, buffers, count);
+    }
+
+    file_void_result unregister_buffers() noexcept {
+        if(!is_open()) {
+            return file_void_result(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::unregister_ring_buffers(handle_);
+    }
+
+    // Signal eventfd fd on every completion (see event_loop)
+    file_void_result register_eventfd(int32_t fd) noexcept {
+        if(!is_open()) {
+            return file_void_result(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::register_ring_eventfd(handle_, fd);
+    }
+
+    // Submit everything queued; wait_for > 0 also blocks for that many completions
+    file_result<size_t> submit(size_t wait_for = 0) noexcept {
+        if(!is_open()) {
+            return file_result<size_t>(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::submit_ring(handle_, wait_for);
+    }
+
+    // Reap up to max_count completions, blocking until at least min_count are ready
+    file_result<size_t> complete(io_completion* completions, size_t max_count, size_t min_count = 0) noexcept {
+        if(!is_open()) {
+            return file_result<size_t>(unexpect, platform::file::file_error(platform::file::error_code::invalid_argument));
+        }
+        return platform::file::reap_ring(handle_, completions, max_count, min_count);
+    }
+
+    file_result<size_t> complete(std::span<io_completion> completions, size_t min_count = 0) noexcept {
+        return complete(completions.data(), completions.size(), min_count);
+    }
+
+    // Submit and wait for all in-flight requests, reaping into the given buffer
+    file_result<size_t> drain(std::span<io_completion> completions) noexcept {
+        size_t pending = in_flight();
+        if(pending > completions.size()) pending = completions.size();
+        auto submitted = submit();
+        if(!submitted) { return file_result<size_t>(unexpect, submitted.error()); }
+        return complete(completions, pending);
+    }
+
+    // State queries
+    ring_status status() const noexcept { return platform::file::query_ring(handle_); }
+
+    size_t queued() const noexcept { return status().queued; }
+
+    size_t in_flight() const noexcept { return status().in_flight; }
+
+    size_t capacity() const noexcept { return handle_.entries; }
+
+    bool is_open() const noexcept { return handle_.is_valid(); }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    const ring_handle& handle() const noexcept { return handle_; }
+
+    ring_handle& handle() noexcept { return handle_; }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_RING_HPP
@@ -0,0 +1,490 @@
+#ifndef ASYNCLE_IO_SHM_RING_HPP
+#define ASYNCLE_IO_SHM_RING_HPP
+
+#include "../../platform/mmap.hpp"
+#include "../../platform/process.hpp"
+#include "../hardware/memory.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace asyncle::io {
+
+// Where a shm_ring's pages come from
+enum class shm_backing : uint8_t {
+    memory_file = 0,  // memfd: the descriptor can be handed to a spawned process
+    anonymous   = 1   // MAP_SHARED | MAP_ANONYMOUS: shared with fork()ed children only
+};
+
+// Single-producer/single-consumer message ring in memory shared between
+// processes. The producer writes a message straight into the ring (prepare,
+// fill, commit) and the consumer reads it in place (peek, use, release), so a
+// message is copied once, by whoever produces it, and costs no system call
+// while the other side is awake.
+//
+// Layout of the mapping: a header with the magic, the capacity, and the
+// consumer (head) and producer (tail) positions on their own cache lines,
+// then capacity bytes of records. A record is an 8-byte header (the payload
+// length) and the payload, padded to 8 bytes; a record that would run past
+// the end is preceded by a wrap marker and starts again at offset 0. Each side
+// keeps a cached copy of the other's position and reads the shared line only
+// when the cache says the ring looks full or empty.
+//
+// A side that has to wait sleeps on a futex word in the header. The other side
+// bumps that word and wakes it only when a waiter is registered, so a busy
+// channel makes no system calls at all.
+//
+// Exactly one process (and thread) produces and one consumes. The creator
+// passes the memory file to a child with share_with(request), which returns the
+// descriptor number the child sees; the child calls attach() on that number.
+// Either side can close: close_writing() lets the consumer drain and stop,
+// close_reading() makes the producer's sends fail instead of waiting for room.
+//
+// The peer is not trusted. attach() checks the capacity against the size of
+// the memory file. peek() checks every record against the published bytes
+// and the ring bounds before handing it out. A record that does not check
+// out closes the ring for reading.
+//
+// Usage:
+//   io::shm_ring ring;
+//   ring.create(1 << 20);
+//   io::process::spawn_request req {};
+//   int child_fd = ring.share_with(req);  // Pass child_fd in argv
+//   process worker(req);
+//   ring.send(std::as_bytes(std::span(message)));
+//
+//   // In the child
+//   io::shm_ring ring;
+//   ring.attach(child_fd);
+//   for(auto ready = ring.wait_readable(); ready && *ready; ready = ring.wait_readable()) {
+//       handle(ring.peek());
+//       ring.release();
+//   }
+class shm_ring {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = memory_error;
+    template <typename T>
+    using result_type = mmap_result<T>;
+
+    static constexpr uint64_t magic = 0x31474e4952484d53;  // "SMHRING1"
+
+    private:
+    using atomic_word = std::atomic<uint32_t>;
+    static_assert(atomic_word::is_always_lock_free && sizeof(atomic_word) == sizeof(uint32_t));
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Positions are shared between processes");
+
+    // Futex word plus the number of sleepers on it
+    struct wait_word {
+        atomic_word sequence { 0 };
+        atomic_word waiters { 0 };
+    };
+
+    struct header {
+        uint64_t    magic;
+        uint64_t    capacity;             // Record bytes after the header, a power of two
+        atomic_word closed { 0 };         // Set by the producer
+        atomic_word reader_closed { 0 };  // Set by the consumer
+
+        hardware::cache_padded<std::atomic<uint64_t>> head { uint64_t { 0 } };  // Consumer: bytes released
+        hardware::cache_padded<std::atomic<uint64_t>> tail { uint64_t { 0 } };  // Producer: bytes published
+        hardware::cache_padded<wait_word>             readable;  // Consumer sleeps here
+        hardware::cache_padded<wait_word>             writable;  // Producer sleeps here
+    };
+
+    static constexpr size_t   header_size = (sizeof(header) + 63) / 64 * 64;
+    static constexpr uint64_t record_size = 8;
+    static constexpr uint32_t wrap_marker = UINT32_MAX;
+
+    mmap       map_;
+    int        fd_     = -1;  // Memory file, owned; -1 for anonymous rings
+    header*    header_ = nullptr;
+    std::byte* data_   = nullptr;
+    uint64_t   mask_   = 0;
+
+    // Producer state
+    uint64_t cached_head_ = 0;
+    uint64_t reserved_    = 0;  // Payload bytes prepared and not yet committed
+    uint64_t skip_        = 0;  // Bytes to the end of the ring when the prepared record wraps
+
+    // Consumer state
+    uint64_t cached_tail_ = 0;
+    uint64_t peeked_      = 0;  // Bytes the peeked record (and any wrap before it) occupies
+    bool     corrupt_     = false;
+
+    static constexpr uint64_t footprint(uint64_t payload) noexcept {
+        return (record_size + payload + record_size - 1) / record_size * record_size;
+    }
+
+    static const uint32_t* futex_word(const wait_word& w) noexcept {
+        return reinterpret_cast<const uint32_t*>(&w.sequence);
+    }
+
+    // Called after publishing: wakes the other side if it registered as a waiter
+    static void notify(wait_word& w) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(w.waiters.load(std::memory_order_relaxed) != 0) {
+            w.sequence.fetch_add(1, std::memory_order_release);
+            platform::mmap::wake_shared_word(futex_word(w), INT_MAX);
+        }
+    }
+
+    // Sleep on w until ready() holds, timeout_ms passes (-1 = forever) or the ring closes
+    template <typename Ready>
+    mmap_result<bool> wait_until(wait_word& w, int timeout_ms, Ready&& ready) noexcept {
+        using clock         = std::chrono::steady_clock;
+        const auto deadline = clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+        for(;;) {
+            if(ready()) return true;
+            if(stopped()) return ready();
+            int remaining = -1;
+            if(timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+                if(left <= 0) return false;
+                remaining = static_cast<int>(left);
+            }
+
+            const uint32_t seen = w.sequence.load(std::memory_order_acquire);
+            w.waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            mmap_result<bool> woke(true);
+            if(!ready() && !stopped()) {
+                woke = platform::mmap::wait_shared_word(futex_word(w), seen, remaining);
+            }
+            w.waiters.fetch_sub(1, std::memory_order_relaxed);
+            if(!woke) return woke;
+        }
+    }
+
+    bool stopped() const noexcept {
+        return header_->closed.load(std::memory_order_acquire) | header_->reader_closed.load(std::memory_order_acquire);
+    }
+
+    // The peer published something that is not a record: stop reading
+    std::span<const std::byte> corrupt() noexcept {
+        corrupt_ = true;
+        peeked_  = 0;
+        close_reading();
+        return {};
+    }
+
+    mmap_void_result map_ring(int fd, uint64_t capacity, shm_backing backing) noexcept {
+        memory_request req {};
+        req.length  = header_size + capacity;
+        req.backing = backing == shm_backing::anonymous ? backing_type::anonymous : backing_type::file_backed;
+        req.access  = mmap_access::access_mode::read_write;
+        req.sharing = sharing_mode::shared;
+        auto mapped = map_.map(req, fd);
+        if(!mapped) return mmap_void_result(unexpect, mapped.error());
+
+        header_ = static_cast<header*>(map_.data());
+        data_   = static_cast<std::byte*>(map_.data()) + header_size;
+        mask_   = capacity - 1;
+        return mmap_void_result();
+    }
+
+    void reset_local() noexcept {
+        cached_head_ = header_ ? header_->head->load(std::memory_order_acquire) : 0;
+        cached_tail_ = header_ ? header_->tail->load(std::memory_order_acquire) : 0;
+        reserved_ = skip_ = peeked_ = 0;
+        corrupt_  = false;
+    }
+
+    public:
+    // Constructors
+    shm_ring() noexcept = default;
+
+    // Move semantics; the mapping stays where it is
+    shm_ring(shm_ring&& other) noexcept:
+        map_(std::move(other.map_)),
+        fd_(std::exchange(other.fd_, -1)),
+        header_(std::exchange(other.header_, nullptr)),
+        data_(std::exchange(other.data_, nullptr)),
+        mask_(std::exchange(other.mask_, 0)),
+        cached_head_(other.cached_head_),
+        reserved_(std::exchange(other.reserved_, 0)),
+        skip_(std::exchange(other.skip_, 0)),
+        cached_tail_(other.cached_tail_),
+        peeked_(std::exchange(other.peeked_, 0)),
+        corrupt_(std::exchange(other.corrupt_, false)) {}
+
+    shm_ring& operator=(shm_ring&& other) noexcept {
+        if(this != &other) {
+            close();
+            map_         = std::move(other.map_);
+            fd_          = std::exchange(other.fd_, -1);
+            header_      = std::exchange(other.header_, nullptr);
+            data_        = std::exchange(other.data_, nullptr);
+            mask_        = std::exchange(other.mask_, 0);
+            cached_head_ = other.cached_head_;
+            reserved_    = std::exchange(other.reserved_, 0);
+            skip_        = std::exchange(other.skip_, 0);
+            cached_tail_ = other.cached_tail_;
+            peeked_      = std::exchange(other.peeked_, 0);
+            corrupt_     = std::exchange(other.corrupt_, false);
+        }
+        return *this;
+    }
+
+    // No copy
+    shm_ring(const shm_ring&)            = delete;
+    shm_ring& operator=(const shm_ring&) = delete;
+
+    // Destructor
+    ~shm_ring() { close(); }
+
+    // Create a ring of capacity record bytes (rounded up to a power of two, at
+    // least one page)
+    mmap_void_result create(size_t capacity, shm_backing backing = shm_backing::memory_file) noexcept {
+        close();
+        uint64_t rounded = 4096;
+        while(rounded < capacity) rounded <<= 1;
+
+        int fd = -1;
+        if(backing == shm_backing::memory_file) {
+            auto created = platform::mmap::create_shared_memory("asyncle-shm-ring", header_size + rounded);
+            if(!created) return mmap_void_result(unexpect, created.error());
+            fd = *created;
+        }
+        if(auto mapped = map_ring(fd, rounded, backing); !mapped) {
+            if(fd >= 0) ::close(fd);
+            return mapped;
+        }
+        fd_ = fd;
+
+        header_           = new(map_.data()) header {};
+        header_->capacity = rounded;
+        std::atomic_ref<uint64_t>(header_->magic).store(magic, std::memory_order_release);
+        reset_local();
+        return mmap_void_result();
+    }
+
+    // Map a ring another process created, from its memory file; takes
+    // ownership of fd. The header must describe a ring that fits in the file.
+    mmap_void_result attach(int fd) noexcept {
+        close();
+        if(fd < 0) return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        struct stat info {};
+        if(::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(header_size)) {
+            ::close(fd);
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        const uint64_t room = static_cast<uint64_t>(info.st_size) - header_size;
+
+        // Read the capacity from the header, then map header and records
+        memory_request probe {};
+        probe.length  = header_size;
+        probe.backing = backing_type::file_backed;
+        probe.access  = mmap_access::access_mode::read;
+        probe.sharing = sharing_mode::shared;
+        uint64_t capacity = 0;
+        {
+            mmap head(fd, probe);
+            if(!head.is_mapped()) {
+                ::close(fd);
+                return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+            }
+            const auto* h = static_cast<const header*>(head.data());
+            if(std::atomic_ref<const uint64_t>(h->magic).load(std::memory_order_acquire) == magic) {
+                capacity = h->capacity;
+            }
+        }
+        if(capacity < 4096 || (capacity & (capacity - 1)) != 0 || capacity > room) {
+            ::close(fd);
+            return mmap_void_result(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        if(auto mapped = map_ring(fd, capacity, shm_backing::memory_file); !mapped) {
+            ::close(fd);
+            return mapped;
+        }
+        fd_ = fd;
+        reset_local();
+        return mmap_void_result();
+    }
+
+    // Unmap and close the memory file; the other side keeps its own mapping
+    void close() noexcept {
+        map_.unmap();
+        if(fd_ >= 0) ::close(fd_);
+        fd_     = -1;
+        header_ = nullptr;
+        data_   = nullptr;
+        mask_   = 0;
+        reset_local();
+    }
+
+    // Let the child spawned from request inherit the memory file; returns the
+    // descriptor number to attach() to in the child, or -1 (anonymous ring, or
+    // no inherit slot left)
+    int share_with(platform::process::spawn_request& request) const noexcept {
+        return fd_ >= 0 ? request.inherit_fd(fd_) : -1;
+    }
+
+    // Producer operations
+
+    // Room for one payload of n bytes, written in place and published by
+    // commit(); null when the ring is too full right now, n is larger than
+    // max_message_size(), or the consumer closed
+    std::span<std::byte> prepare(size_t n) noexcept {
+        if(!header_ || n > max_message_size() || header_->reader_closed.load(std::memory_order_relaxed)) return {};
+        const uint64_t tail  = header_->tail->load(std::memory_order_relaxed);
+        const uint64_t at    = tail & mask_;
+        const uint64_t size  = footprint(n);
+        const uint64_t skip  = at + size > mask_ + 1 ? mask_ + 1 - at : 0;
+        const uint64_t needs = skip + size;
+        if(mask_ + 1 - (tail - cached_head_) < needs) {
+            cached_head_ = header_->head->load(std::memory_order_acquire);
+            if(mask_ + 1 - (tail - cached_head_) < needs) return {};
+        }
+        reserved_ = n;
+        skip_     = skip;
+        return std::span<std::byte>(data_ + ((tail + skip) & mask_) + record_size, n);
+    }
+
+    // Publish the first n bytes (n <= the prepared size) of the prepared payload
+    void commit(size_t n) noexcept {
+        if(!header_) return;
+        if(n > reserved_) n = reserved_;
+        const uint64_t tail = header_->tail->load(std::memory_order_relaxed);
+        if(skip_) std::memcpy(data_ + (tail & mask_), &wrap_marker, sizeof(wrap_marker));
+        const auto length = static_cast<uint32_t>(n);
+        std::memcpy(data_ + ((tail + skip_) & mask_), &length, sizeof(length));
+        header_->tail->store(tail + skip_ + footprint(n), std::memory_order_release);
+        reserved_ = skip_ = 0;
+        notify(header_->readable.get());
+    }
+
+    // Copy one message in if it fits now
+    bool try_send(std::span<const std::byte> message) noexcept {
+        auto room = prepare(message.size());
+        if(!room.data()) return false;
+        std::memcpy(room.data(), message.data(), message.size());
+        commit(message.size());
+        return true;
+    }
+
+    // Block until one payload of n bytes fits; false on timeout or when either
+    // side closed
+    mmap_result<bool> wait_writable(size_t n, int timeout_ms = -1) noexcept {
+        if(!header_ || n > max_message_size()) {
+            return mmap_result<bool>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        }
+        auto fits = wait_until(header_->writable.get(), timeout_ms, [&] { return prepare(n).data() != nullptr; });
+        reserved_ = skip_ = 0;
+        if(fits && *fits && (closed() || reader_closed())) return false;
+        return fits;
+    }
+
+    // Copy one message in, waiting up to timeout_ms for room
+    mmap_result<bool> send(std::span<const std::byte> message, int timeout_ms = -1) noexcept {
+        if(try_send(message)) return true;
+        auto room = wait_writable(message.size(), timeout_ms);
+        if(!room || !*room) return room;
+        return try_send(message);
+    }
+
+    // Tell the consumer no more messages follow; it drains what was committed
+    void close_writing() noexcept {
+        if(!header_) return;
+        header_->closed.store(1, std::memory_order_release);
+        notify(header_->readable.get());
+        notify(header_->writable.get());
+    }
+
+    // Consumer operations
+
+    // Next message, in place; null when none is waiting or the ring is
+    // corrupt. Stays valid until release().
+    std::span<const std::byte> peek() noexcept {
+        if(!header_ || corrupt_) return {};
+        uint64_t head = header_->head->load(std::memory_order_relaxed);
+        if(cached_tail_ == head) {
+            cached_tail_ = header_->tail->load(std::memory_order_acquire);
+            if(cached_tail_ == head) return {};
+        }
+        // Both positions are shared: check them before reading at either
+        const uint64_t published = cached_tail_ - head;
+        if(head % record_size != 0 || published < record_size || published > mask_ + 1) return corrupt();
+        uint32_t length = 0;
+        std::memcpy(&length, data_ + (head & mask_), sizeof(length));
+        uint64_t skip = 0;
+        if(length == wrap_marker) {
+            skip = mask_ + 1 - (head & mask_);
+            if(skip + record_size > published) return corrupt();
+            std::memcpy(&length, data_ + ((head + skip) & mask_), sizeof(length));
+        }
+        const uint64_t at = (head + skip) & mask_;
+        if(length > max_message_size() || skip + footprint(length) > published || at + footprint(length) > mask_ + 1) {
+            return corrupt();
+        }
+        peeked_ = skip + footprint(length);
+        return std::span<const std::byte>(data_ + at + record_size, length);
+    }
+
+    // Drop the message returned by peek(), making its bytes writable
+    void release() noexcept {
+        if(!header_ || peeked_ == 0) return;
+        header_->head->fetch_add(peeked_, std::memory_order_release);
+        peeked_ = 0;
+        notify(header_->writable.get());
+    }
+
+    // Tell the producer no more messages are read; its sends fail from now on
+    void close_reading() noexcept {
+        if(!header_) return;
+        header_->reader_closed.store(1, std::memory_order_release);
+        notify(header_->writable.get());
+        notify(header_->readable.get());
+    }
+
+    // Block until a message is waiting; false on timeout, or once the ring is
+    // closed and drained; io_error once peek() found a corrupt record
+    mmap_result<bool> wait_readable(int timeout_ms = -1) noexcept {
+        if(!header_) return mmap_result<bool>(unexpect, memory_error(mmap_access::error_code::invalid_argument));
+        if(corrupt_) return mmap_result<bool>(unexpect, memory_error(mmap_access::error_code::io_error));
+        return wait_until(header_->readable.get(), timeout_ms, [&] {
+            return header_->tail->load(std::memory_order_acquire) != header_->head->load(std::memory_order_relaxed);
+        });
+    }
+
+    // Accessors
+    bool is_open() const noexcept { return header_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_open(); }
+
+    bool closed() const noexcept { return header_ && header_->closed.load(std::memory_order_acquire) != 0; }
+
+    bool reader_closed() const noexcept {
+        return header_ && header_->reader_closed.load(std::memory_order_acquire) != 0;
+    }
+
+    int fd() const noexcept { return fd_; }
+
+    size_t capacity() const noexcept { return header_ ? static_cast<size_t>(mask_ + 1) : 0; }
+
+    // Largest payload: half the ring less a record header, so a wrapped record always fits once drained
+    size_t max_message_size() const noexcept {
+        return header_ ? static_cast<size_t>((mask_ + 1) / 2 - record_size) : 0;
+    }
+
+    // Committed bytes not yet released (record headers and padding included)
+    size_t pending() const noexcept {
+        if(!header_) return 0;
+        return static_cast<size_t>(
+          header_->tail->load(std::memory_order_acquire) - header_->head->load(std::memory_order_acquire));
+    }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_SHM_RING_HPP
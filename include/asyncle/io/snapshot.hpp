@@ -0,0 +1,270 @@
+#ifndef ASYNCLE_IO_SNAPSHOT_HPP
+#define ASYNCLE_IO_SNAPSHOT_HPP
+
+// asyncle::io snapshot - Map a snapshot file, fault it in and verify it in parallel
+//
+// load_snapshot() maps a file read-only and splits it into fixed-size blocks
+// that a few pool tasks claim in order. With populate_strategy::prefault
+// (the default) a task faults its block in with one populate call
+// (MADV_POPULATE_READ, which reads ahead across the block), then computes the
+// block's CRC32C while the pages are hot. The mapping itself is made without
+// MAP_POPULATE, which would fault the whole file in on the calling thread
+// inside mmap(); here the faults for different blocks are taken on different
+// cores, and the device sees several large requests at once.
+//
+// The per-block checksums are compared with options.expected when given
+// (typically stored next to the snapshot, see snapshot_checksums()); any
+// mismatch fails the load with io_error. The calling thread waits and calls
+// progress(const snapshot_progress&) after blocks complete, and once more at
+// the end, so a service can report how far its cold start has got.
+//
+// Usage:
+//   concurrent::work_stealing_pool pool;
+//   io::file data("state.snap", io::access_mode::read_only);
+//   auto snap = io::load_snapshot(data, pool, { .expected = manifest }, [](const io::snapshot_progress& p) {
+//       log("loaded {} of {} MiB", p.bytes_done >> 20, p.bytes_total >> 20);
+//   });
+//   if(snap) use(snap->bytes());
+
+#include "../concurrent/thread_pool.hpp"
+#include "../hardware/checksum.hpp"
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace asyncle::io {
+
+struct snapshot_options {
+    size_t block_size  = size_t { 4 } << 20;  // Fault-in and checksum unit, rounded up to whole pages
+    size_t concurrency = 0;                   // Pool tasks working on blocks (0 = one per pool worker)
+
+    // prefault: fault every block in on the pool; hint_needed: MADV_WILLNEED
+    // only; none: leave faults to first use (verification still touches every page)
+    mmap_access::populate_strategy populate = mmap_access::populate_strategy::prefault;
+
+    bool                      verify = true;  // Compute a CRC32C per block
+    std::span<const uint32_t> expected {};    // Per-block CRC32Cs to check (empty = compute only)
+};
+
+struct snapshot_progress {
+    uint64_t bytes_done   = 0;
+    uint64_t bytes_total  = 0;
+    uint64_t blocks_done  = 0;
+    uint64_t blocks_total = 0;
+    uint64_t bad_blocks   = 0;           // Blocks whose CRC32C did not match options.expected
+    uint64_t first_bad    = UINT64_MAX;  // Lowest mismatching block index
+};
+
+// A loaded snapshot: the read-only mapping and the checksum of each block
+class snapshot {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    mmap                  map_;
+    size_t                block_size_ = 0;
+    std::vector<uint32_t> checksums_;
+
+    template <typename F>
+    friend file_result<snapshot> load_snapshot(file&, concurrent::work_stealing_pool&, const snapshot_options&, F&&);
+
+    public:
+    // Constructors
+    snapshot() noexcept = default;
+
+    // Move semantics
+    snapshot(snapshot&&) noexcept            = default;
+    snapshot& operator=(snapshot&&) noexcept = default;
+
+    // No copy
+    snapshot(const snapshot&)            = delete;
+    snapshot& operator=(const snapshot&) = delete;
+
+    // Accessors
+    bool is_loaded() const noexcept { return map_.is_mapped(); }
+
+    explicit operator bool() const noexcept { return is_loaded(); }
+
+    const void* data() const noexcept { return map_.data(); }
+
+    size_t size() const noexcept { return map_.size(); }
+
+    std::span<const std::byte> bytes() const noexcept {
+        return std::span<const std::byte>(static_cast<const std::byte*>(map_.data()), map_.size());
+    }
+
+    size_t block_size() const noexcept { return block_size_; }
+
+    // CRC32C of each block (empty when loaded without verify)
+    std::span<const uint32_t> checksums() const noexcept { return checksums_; }
+
+    const mmap& mapping() const noexcept { return map_; }
+};
+
+// CRC32C of each block_size block of data (the last one may be shorter), as
+// load_snapshot() computes them; store these with the snapshot when writing it
+inline std::vector<uint32_t> snapshot_checksums(std::span<const std::byte> data, size_t block_size) {
+    std::vector<uint32_t> sums;
+    if(block_size == 0) return sums;
+    sums.reserve((data.size() + block_size - 1) / block_size);
+    for(size_t at = 0; at < data.size(); at += block_size) {
+        sums.push_back(hardware::crc32c(data.data() + at, std::min(block_size, data.size() - at)));
+    }
+    return sums;
+}
+
+namespace detail {
+
+struct snapshot_state {
+    mmap&                  view;
+    const snapshot_options options;
+    uint32_t*              sums;
+    uint64_t               size;
+    size_t                 block;
+    uint64_t               blocks;
+
+    std::atomic<uint64_t> next { 0 };
+    std::atomic<uint64_t> blocks_done { 0 };
+    std::atomic<uint64_t> bytes_done { 0 };
+    std::atomic<uint64_t> bad_blocks { 0 };
+    std::atomic<uint64_t> first_bad { UINT64_MAX };
+    std::atomic<size_t>   runners { 0 };
+    std::atomic<uint32_t> events { 0 };  // Bumped per finished block and runner; the caller waits on it
+    std::atomic<bool>     failed { false };
+    std::mutex            lock;
+    file_error            error;
+
+    snapshot_state(mmap& v, const snapshot_options& o, uint32_t* s, uint64_t n, size_t b) noexcept:
+        view(v),
+        options(o),
+        sums(s),
+        size(n),
+        block(b),
+        blocks((n + b - 1) / b) {}
+
+    void fail(const file_error& e) noexcept {
+        std::lock_guard guard(lock);
+        if(!failed.exchange(true)) error = e;
+    }
+
+    void load_block(uint64_t i) noexcept {
+        const size_t at    = static_cast<size_t>(i * block);
+        const size_t bytes = static_cast<size_t>(std::min<uint64_t>(block, size - at));
+        if(options.populate == mmap_access::populate_strategy::hint_needed) view.prefetch(at, bytes);
+        if(options.populate == mmap_access::populate_strategy::prefault) {
+            if(auto faulted = view.populate(at, bytes); !faulted) {
+                fail(to_file_error(faulted.error()));
+                return;
+            }
+        }
+        if(sums) {
+            sums[i] = hardware::crc32c(static_cast<const std::byte*>(view.data()) + at, bytes);
+            if(!options.expected.empty() && sums[i] != options.expected[i]) {
+                bad_blocks.fetch_add(1, std::memory_order_relaxed);
+                uint64_t seen = first_bad.load(std::memory_order_relaxed);
+                while(i < seen && !first_bad.compare_exchange_weak(seen, i, std::memory_order_relaxed)) {}
+            }
+        }
+        bytes_done.fetch_add(bytes, std::memory_order_relaxed);
+        blocks_done.fetch_add(1, std::memory_order_release);
+    }
+
+    void run() noexcept {
+        while(!failed.load(std::memory_order_relaxed)) {
+            const uint64_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if(i >= blocks) break;
+            load_block(i);
+            events.fetch_add(1, std::memory_order_release);
+            events.notify_all();
+        }
+        runners.fetch_sub(1, std::memory_order_acq_rel);
+        events.fetch_add(1, std::memory_order_release);
+        events.notify_all();
+    }
+
+    snapshot_progress progress() const noexcept {
+        snapshot_progress p;
+        p.bytes_done   = bytes_done.load(std::memory_order_relaxed);
+        p.bytes_total  = size;
+        p.blocks_done  = blocks_done.load(std::memory_order_acquire);
+        p.blocks_total = blocks;
+        p.bad_blocks   = bad_blocks.load(std::memory_order_relaxed);
+        p.first_bad    = first_bad.load(std::memory_order_relaxed);
+        return p;
+    }
+};
+
+}  // namespace detail
+
+// Map all of f read-only and load it across pool as described above, calling
+// progress(const snapshot_progress&) on this thread as blocks complete. f needs
+// read access. Must not be called from a task on the same pool; when the pool
+// rejects a task (or is not running) that share of the work runs here.
+template <typename F>
+file_result<snapshot> load_snapshot(
+  file& f, concurrent::work_stealing_pool& pool, const snapshot_options& options, F&& progress) {
+    auto size = f.size();
+    if(!f.is_open() || !size || *size == 0) {
+        return file_result<snapshot>(unexpect, file_error(platform::file::error_code::invalid_argument));
+    }
+
+    const size_t   page   = mmap::page_size();
+    const size_t   block  = std::max(page, (options.block_size + page - 1) / page * page);
+    const uint64_t blocks = (*size + block - 1) / block;
+    if(!options.expected.empty() && options.expected.size() != blocks) {
+        return file_result<snapshot>(unexpect, file_error(platform::file::error_code::invalid_argument));
+    }
+
+    snapshot snap;
+    snap.block_size_ = block;
+    if(auto mapped = snap.map_.map_file(f, static_cast<size_t>(*size)); !mapped) {
+        return file_result<snapshot>(unexpect, detail::to_file_error(mapped.error()));
+    }
+    if(options.verify || !options.expected.empty()) snap.checksums_.resize(blocks);
+
+    auto state = std::make_shared<detail::snapshot_state>(
+      snap.map_, options, snap.checksums_.empty() ? nullptr : snap.checksums_.data(), *size, block);
+
+    size_t runners = options.concurrency ? options.concurrency : std::max<size_t>(1, pool.worker_count());
+    runners        = static_cast<size_t>(std::min<uint64_t>(runners, blocks));
+    state->runners.store(runners, std::memory_order_relaxed);
+    size_t inline_runs = 0;
+    for(size_t r = 0; r < runners; ++r) {
+        if(!pool.submit([state] { state->run(); })) ++inline_runs;
+    }
+    for(size_t r = 0; r < inline_runs; ++r) state->run();
+
+    for(uint32_t seen = state->events.load(std::memory_order_acquire); state->runners.load(std::memory_order_acquire);
+        seen          = state->events.load(std::memory_order_acquire)) {
+        progress(state->progress());
+        state->events.wait(seen, std::memory_order_acquire);
+    }
+    progress(state->progress());
+
+    if(state->failed.load()) return file_result<snapshot>(unexpect, state->error);
+    if(state->bad_blocks.load() != 0) {
+        return file_result<snapshot>(unexpect, file_error(platform::file::error_code::io_error));
+    }
+    return snap;
+}
+
+inline file_result<snapshot>
+  load_snapshot(file& f, concurrent::work_stealing_pool& pool, const snapshot_options& options = {}) {
+    return load_snapshot(f, pool, options, [](const snapshot_progress&) {});
+}
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_SNAPSHOT_HPP
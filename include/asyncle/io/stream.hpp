@@ -0,0 +1,264 @@
+#ifndef ASYNCLE_IO_STREAM_HPP
+#define ASYNCLE_IO_STREAM_HPP
+
+#include "file.hpp"
+#include "mmap.hpp"
+#include "result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace asyncle::io {
+
+// Zero-copy streaming engine built on splice_files.
+// Moves a byte range from a file or mapping to any descriptor (socket, pipe, file)
+// through an internal pipe pair, looping over partial transfers and waiting out
+// EAGAIN on non-blocking outputs. Regular-file to regular-file copies go through
+// copy_file_range first and fall back to the pipe path when the kernel refuses.
+class stream_transfer {
+    public:
+    // Type aliases for result types and error handling
+    using error_type = file_error;
+    template <typename T>
+    using result_type = file_result<T>;
+
+    private:
+    file_handle pipe_read_;
+    file_handle pipe_write_;
+    size_t      pipe_size_      = 0;  // Actual pipe capacity once created
+    size_t      requested_size_ = 0;  // 0 = derive from file_caps::pipe_buffer_size
+
+    // Pipe capacity multiplier over the default pipe buffer size (64 KiB -> 1 MiB)
+    static constexpr size_t default_pipe_scale = 16;
+
+    file_void_result ensure_pipe() noexcept {
+        if(pipe_read_.is_valid()) return file_void_result();
+
+        auto created = platform::file::create_pipe(pipe_read_, pipe_write_);
+        if(!created) return created;
+
+        size_t want = requested_size_;
+        if(want == 0) want = static_cast<size_t>(file::capabilities().pipe_buffer_size) * default_pipe_scale;
+
+        // Growing past /proc/sys/fs/pipe-max-size fails for unprivileged users; keep the default then
+        auto resized = want ? platform::file::set_pipe_size(pipe_write_, want) : file_result<size_t>(size_t { 0 });
+        if(resized && resized.value() > 0) {
+            pipe_size_ = resized.value();
+        } else {
+            pipe_size_ = file::capabilities().pipe_buffer_size;
+        }
+        if(pipe_size_ == 0) pipe_size_ = 65536;
+        return file_void_result();
+    }
+
+    // Drop the pipe (and any bytes stranded in it) after a failed drain
+    void reset_pipe() noexcept {
+        if(pipe_read_.is_valid()) platform::file::close_file(pipe_read_);
+        if(pipe_write_.is_valid()) platform::file::close_file(pipe_write_);
+        pipe_read_  = file_handle {};
+        pipe_write_ = file_handle {};
+        pipe_size_  = 0;
+    }
+
+    // Move count bytes sitting in the pipe to out
+    file_void_result drain(const file_handle& out, size_t count) noexcept {
+        constexpr uint32_t flags = platform::file::splice_flag::move | platform::file::splice_flag::more;
+        while(count > 0) {
+            auto moved = platform::file::splice_files(pipe_read_, nullptr, out, nullptr, count, flags);
+            if(!moved) {
+                if(moved.error().code == error_code::interrupted) continue;
+                if(moved.error().code == error_code::would_block) {
+                    auto ready = platform::file::wait_ready(out, true);
+                    if(!ready) return file_void_result(unexpect, ready.error());
+                    continue;
+                }
+                return file_void_result(unexpect, moved.error());
+            }
+            if(moved.value() == 0) return file_void_result(unexpect, file_error(error_code::broken_pipe));
+            count -= moved.value();
+        }
+        return file_void_result();
+    }
+
+    template <typename Fill>
+    file_result<size_t> pump(const file_handle& out, size_t length, Fill&& fill) noexcept {
+        auto ready = ensure_pipe();
+        if(!ready) return file_result<size_t>(unexpect, ready.error());
+
+        size_t total = 0;
+        while(total < length) {
+            size_t chunk = length - total;
+            if(chunk > pipe_size_) chunk = pipe_size_;
+
+            auto filled = fill(total, chunk);
+            if(!filled) {
+                if(filled.error().code == error_code::interrupted) continue;
+                if(total > 0) break;
+                return filled;
+            }
+            if(filled.value() == 0) break;  // Source exhausted
+
+            auto drained = drain(out, filled.value());
+            if(!drained) {
+                reset_pipe();
+                if(total > 0) break;  // Report the bytes that reached out; the caller retries from there
+                return file_result<size_t>(unexpect, drained.error());
+            }
+            total += filled.value();
+        }
+        return file_result<size_t>(total);
+    }
+
+    static bool is_regular(const file_handle& handle) noexcept {
+        auto info = platform::file::stat_file(handle);
+        return info && info.value().type == file_type::regular;
+    }
+
+    public:
+    // Constructors
+    // pipe_size = 0 sizes the pipe from file_caps::pipe_buffer_size
+    explicit stream_transfer(size_t pipe_size = 0) noexcept: requested_size_(pipe_size) {}
+
+    // Move semantics
+    stream_transfer(stream_transfer&& other) noexcept:
+        pipe_read_(std::exchange(other.pipe_read_, file_handle {})),
+        pipe_write_(std::exchange(other.pipe_write_, file_handle {})),
+        pipe_size_(std::exchange(other.pipe_size_, 0)),
+        requested_size_(other.requested_size_) {}
+
+    stream_transfer& operator=(stream_transfer&& other) noexcept {
+        if(this != &other) {
+            reset_pipe();
+            pipe_read_      = std::exchange(other.pipe_read_, file_handle {});
+            pipe_write_     = std::exchange(other.pipe_write_, file_handle {});
+            pipe_size_      = std::exchange(other.pipe_size_, 0);
+            requested_size_ = other.requested_size_;
+        }
+        return *this;
+    }
+
+    // No copy
+    stream_transfer(const stream_transfer&)            = delete;
+    stream_transfer& operator=(const stream_transfer&) = delete;
+
+    // Destructor
+    ~stream_transfer() { reset_pipe(); }
+
+    // Stream length bytes of in starting at offset to out.
+    // Returns the bytes delivered; short only at end of file or after a late error
+    file_result<size_t> send(const file& in, uint64_t offset, size_t length, const file_handle& out) noexcept {
+        if(!in.is_open() || !out.is_valid()) {
+            return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        }
+
+        // Regular files copy in-kernel without the pipe hop
+        if(is_regular(out)) {
+            auto copied = copy_range(in.handle(), offset, out, nullptr, length);
+            if(copied || copied.error().code != error_code::not_supported) return copied;
+        }
+
+        constexpr uint32_t flags = platform::file::splice_flag::move | platform::file::splice_flag::more;
+        return pump(out, length, [&](size_t done, size_t chunk) noexcept {
+            uint64_t in_off = offset + done;
+            return platform::file::splice_files(in.handle(), &in_off, pipe_write_, nullptr, chunk, flags);
+        });
+    }
+
+    file_result<size_t> send(const file& in, uint64_t offset, size_t length, int out_fd) noexcept {
+        return send(in, offset, length, file_handle(out_fd));
+    }
+
+    // Stream part of a mapping. The pipe references the pages (vmsplice) and a
+    // socket destination keeps referencing them until the peer acknowledges the
+    // data, so returning from send() does not free the range: leave it unmodified
+    // until the transfer is acknowledged, or send a copy
+    file_result<size_t> send(const mmap& in, size_t offset, size_t length, const file_handle& out) noexcept {
+        if(!in.is_mapped() || offset > in.size() || !out.is_valid()) {
+            return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        }
+        if(length > in.size() - offset) length = in.size() - offset;
+
+        const char* base = static_cast<const char*>(in.data()) + offset;
+        return pump(out, length, [&](size_t done, size_t chunk) noexcept {
+            return platform::file::vmsplice_op(pipe_write_, base + done, chunk, 0);
+        });
+    }
+
+    file_result<size_t> send(const mmap& in, size_t offset, size_t length, int out_fd) noexcept {
+        return send(in, offset, length, file_handle(out_fd));
+    }
+
+    // Copy between regular files at explicit offsets
+    file_result<size_t> copy(const file& in, uint64_t in_offset, file& out, uint64_t out_offset, size_t length) noexcept {
+        if(!in.is_open() || !out.is_open()) {
+            return file_result<size_t>(unexpect, file_error(error_code::invalid_argument));
+        }
+
+        auto copied = copy_range(in.handle(), in_offset, out.handle(), &out_offset, length);
+        if(copied || copied.error().code != error_code::not_supported) return copied;
+
+        // Cross-filesystem or unsupported: splice through the pipe with explicit output offsets
+        auto ready = ensure_pipe();
+        if(!ready) return file_result<size_t>(unexpect, ready.error());
+
+        size_t total = 0;
+        while(total < length) {
+            size_t chunk = length - total;
+            if(chunk > pipe_size_) chunk = pipe_size_;
+
+            uint64_t in_off = in_offset + total;
+            auto     filled = platform::file::splice_files(in.handle(), &in_off, pipe_write_, nullptr, chunk, 0);
+            if(!filled) {
+                if(total > 0) break;
+                return filled;
+            }
+            if(filled.value() == 0) break;
+
+            size_t pending = filled.value();
+            while(pending > 0) {
+                auto moved = platform::file::splice_files(pipe_read_, nullptr, out.handle(), &out_offset, pending, 0);
+                if(!moved || moved.value() == 0) {
+                    reset_pipe();
+                    if(total > 0) return file_result<size_t>(total);
+                    return moved ? file_result<size_t>(unexpect, file_error(error_code::io_error)) : moved;
+                }
+                pending -= moved.value();
+                total   += moved.value();
+            }
+        }
+        return file_result<size_t>(total);
+    }
+
+    // Accessors
+    size_t pipe_size() const noexcept { return pipe_size_; }
+
+    bool has_pipe() const noexcept { return pipe_read_.is_valid(); }
+
+    private:
+    // copy_file_range loop; not_supported before any byte moved means the kernel
+    // cannot copy this pair and the caller should fall back to the pipe path
+    static file_result<size_t> copy_range(
+      const file_handle& in,
+      uint64_t           in_offset,
+      const file_handle& out,
+      uint64_t*          out_offset,
+      size_t             length) noexcept {
+        size_t total = 0;
+        while(total < length) {
+            uint64_t in_off  = in_offset + total;
+            auto     copied = platform::file::copy_file_range_op(in, &in_off, out, out_offset, length - total);
+            if(!copied) {
+                if(copied.error().code == error_code::interrupted) continue;
+                if(total > 0) break;
+                return copied;
+            }
+            if(copied.value() == 0) break;
+            total += copied.value();
+        }
+        return file_result<size_t>(total);
+    }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_STREAM_HPP
@@ -0,0 +1,219 @@
+#ifndef ASYNCLE_IO_TIMER_WHEEL_HPP
+#define ASYNCLE_IO_TIMER_WHEEL_HPP
+
+// asyncle::io timer wheel - O(1) deadlines for thousands of pending operations
+//
+// A hierarchical timing wheel over an abstract tick: 6 levels of 64 slots,
+// level L covering 64^L ticks per slot, so one wheel spans 2^36 ticks (about
+// 19 hours at 1 us, 2 years at 1 ms); later deadlines park in the top level and
+// are re-placed as it turns. schedule() and cancel() are O(1): a timer_node is
+// linked into one slot's list, and a 64-bit occupancy mask per level finds the
+// next slot to visit without walking empty ones. advance() fires every node
+// due at the new tick, moving nodes of a coarser slot one level down (at most
+// five times for a deadline within the span) as their slot comes round.
+//
+// Ticks are whatever the driver counts: the event loop uses its timer
+// resolution in steady_clock nanoseconds, a polling thread can pass
+// hardware::cycle_clock::ticks() >> n. Deadlines never fire early; a node
+// scheduled for a tick that already passed fires on the next advance().
+//
+// timer_node is intrusive, so the owner embeds it (typically in a coroutine
+// frame or an operation state) and nothing is allocated per timer. The wheel
+// is single-threaded, like the loop that owns it.
+//
+// Usage:
+//   struct request_timeout : io::timer_node { request* owner; };
+//   io::timer_wheel wheel(now_tick());
+//   wheel.schedule(req.timeout, now_tick() + 500);
+//   wheel.cancel(req.timeout);                          // Completed in time
+//   wheel.advance(now_tick(), [](io::timer_node& n) {   // Fire what is due
+//       static_cast<request_timeout&>(n).owner->abort();
+//   });
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace asyncle::io {
+
+class timer_wheel;
+
+// Intrusive wheel entry; must not move while scheduled
+struct timer_node {
+    private:
+    friend class timer_wheel;
+
+    timer_node*  next_  = nullptr;
+    timer_node** pprev_ = nullptr;  // Link pointing at this node; nullptr when not scheduled
+    uint64_t     tick_  = 0;
+    uint16_t     slot_  = 0;  // level * 64 + slot, or detached_slot while being fired or moved
+
+    public:
+    timer_node() noexcept = default;
+
+    // A scheduled node is linked by address
+    timer_node(const timer_node&)            = delete;
+    timer_node& operator=(const timer_node&) = delete;
+
+    bool scheduled() const noexcept { return pprev_ != nullptr; }
+
+    // Tick the node was last scheduled for
+    uint64_t tick() const noexcept { return tick_; }
+};
+
+class timer_wheel {
+    public:
+    static constexpr unsigned level_bits = 6;
+    static constexpr unsigned levels     = 6;
+    static constexpr size_t   slots      = size_t { 1 } << level_bits;
+    static constexpr uint64_t span       = uint64_t { 1 } << (level_bits * levels);  // Ticks covered by the levels
+
+    // next_tick() of an empty wheel
+    static constexpr uint64_t never = ~uint64_t { 0 };
+
+    private:
+    static constexpr uint16_t detached_slot = levels * slots;
+
+    timer_node* slots_[levels * slots] {};
+    uint64_t    occupied_[levels] {};
+    uint64_t    current_ = 0;  // Next tick advance() processes
+    size_t      size_    = 0;
+
+    void link(timer_node& node) noexcept {
+        // The highest bit where the tick differs from current_ picks the level;
+        // ticks past the span are placed as far out as the top level reaches
+        uint64_t place = node.tick_ - current_ >= span ? current_ + span - 1 : node.tick_;
+        unsigned level = place == current_ ? 0 : (std::bit_width(place ^ current_) - 1) / level_bits;
+        if(level >= levels) level = levels - 1;
+        unsigned slot = static_cast<unsigned>(place >> (level * level_bits)) & (slots - 1);
+
+        timer_node*& head = slots_[level * slots + slot];
+        node.slot_        = static_cast<uint16_t>(level * slots + slot);
+        node.next_        = head;
+        node.pprev_       = &head;
+        if(head) head->pprev_ = &node.next_;
+        head = &node;
+        occupied_[level] |= uint64_t { 1 } << slot;
+    }
+
+    void unlink(timer_node& node) noexcept {
+        *node.pprev_ = node.next_;
+        if(node.next_) node.next_->pprev_ = node.pprev_;
+        if(node.slot_ != detached_slot && !slots_[node.slot_]) {
+            occupied_[node.slot_ / slots] &= ~(uint64_t { 1 } << (node.slot_ % slots));
+        }
+        node.next_  = nullptr;
+        node.pprev_ = nullptr;
+    }
+
+    // Move a slot's list out of the wheel; its nodes stay cancellable
+    timer_node* detach(unsigned level, unsigned slot) noexcept {
+        timer_node* head = slots_[level * slots + slot];
+        slots_[level * slots + slot] = nullptr;
+        occupied_[level] &= ~(uint64_t { 1 } << slot);
+        for(timer_node* n = head; n; n = n->next_) n->slot_ = detached_slot;
+        return head;
+    }
+
+    // Earliest tick at which level's nonempty slots fire or move down
+    uint64_t first_tick(unsigned level) const noexcept {
+        const unsigned shift = level * level_bits;
+        const uint64_t block = uint64_t { 1 } << (shift + level_bits);
+        const uint64_t base  = current_ & ~(block - 1);
+        const unsigned digit = static_cast<unsigned>(current_ >> shift) & (slots - 1);
+        // The current digit's slot is still ahead only at its exact boundary;
+        // slots behind it (top level only) come round in the next block
+        const unsigned from  = digit + ((current_ & ((uint64_t { 1 } << shift) - 1)) != 0);
+        const uint64_t ahead = from < slots ? occupied_[level] & (~uint64_t { 0 } << from) : 0;
+        if(ahead) return base + (static_cast<uint64_t>(std::countr_zero(ahead)) << shift);
+        return base + block + (static_cast<uint64_t>(std::countr_zero(occupied_[level])) << shift);
+    }
+
+    public:
+    explicit timer_wheel(uint64_t start_tick = 0) noexcept: current_(start_tick) {}
+
+    timer_wheel(const timer_wheel&)            = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    // (Re)schedule node to fire at tick; O(1)
+    void schedule(timer_node& node, uint64_t tick) noexcept {
+        if(node.scheduled()) {
+            unlink(node);
+        } else {
+            ++size_;
+        }
+        node.tick_ = tick < current_ ? current_ : tick;
+        link(node);
+    }
+
+    // Unschedule node; false when it was not scheduled (already fired or cancelled)
+    bool cancel(timer_node& node) noexcept {
+        if(!node.scheduled()) return false;
+        unlink(node);
+        --size_;
+        return true;
+    }
+
+    // Fire every node due at or before now with fire(timer_node&), in tick
+    // order. A fired node is unscheduled before fire runs, so fire may
+    // reschedule it or schedule and cancel others. Returns the number fired.
+    template <typename F>
+    size_t advance(uint64_t now, F&& fire) {
+        size_t fired = 0;
+        while(current_ <= now) {
+            uint64_t tick = next_tick();
+            if(tick > now) {
+                current_ = now + 1;  // Nothing due in between: skip the idle ticks
+                break;
+            }
+            current_ = tick;
+
+            // Coarser slots whose range starts here move down first
+            for(unsigned level = levels - 1; level > 0; --level) {
+                const unsigned shift = level * level_bits;
+                if((tick & ((uint64_t { 1 } << shift) - 1)) != 0) continue;
+                timer_node* moved = detach(level, static_cast<unsigned>(tick >> shift) & (slots - 1));
+                while(timer_node* node = moved) {
+                    moved = node->next_;
+                    link(*node);
+                }
+            }
+
+            // Nodes still linked into the local list can be cancelled by an earlier fire
+            timer_node* due = detach(0, static_cast<unsigned>(tick) & (slots - 1));
+            if(due) due->pprev_ = &due;
+            current_ = tick + 1;
+            while(timer_node* node = due) {
+                unlink(*node);
+                --size_;
+                ++fired;
+                fire(*node);
+            }
+        }
+        return fired;
+    }
+
+    // Tick of the next fire or level move (never when empty); a driver that
+    // sleeps until then and calls advance() skips every idle tick
+    uint64_t next_tick() const noexcept {
+        // Every level counts: a coarser slot starting at current_ may hold
+        // ticks before a finer slot's
+        uint64_t next = never;
+        for(unsigned level = 0; level < levels; ++level) {
+            if(occupied_[level]) next = std::min(next, first_tick(level));
+        }
+        return next;
+    }
+
+    // Next tick advance() processes
+    uint64_t now() const noexcept { return current_; }
+
+    size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+};
+
+}  // namespace asyncle::io
+
+#endif  // ASYNCLE_IO_TIMER_WHEEL_HPP
@@ -0,0 +1,64 @@
+#ifndef ASYNCLE_DISPATCH_HPP
+#define ASYNCLE_DISPATCH_HPP
+
+// asyncle dispatch - Pick an implementation path from predicates
+//
+// dispatch_by<Entries...> takes the same entries as a command (type_map,
+// pred_map, rule_map) but maps a type to a path tag instead of a result type;
+// the first matching entry wins. Hot paths branch on the tag with if constexpr,
+// so a queue or writer compiles one straight-line body per element type:
+//
+//   element_dispatch  trivial_copy_path  trivially copyable: memcpy whole batches
+//                     move_path          anything else: construct/move per element
+//   range_dispatch    contiguous_path    contiguous ranges: one bulk operation
+//                     generic_path       other ranges: element by element
+//
+// Usage:
+//   if constexpr(dispatches_to<element_dispatch, T, trivial_copy_path>) {
+//       std::memcpy(dst, src, count * sizeof(T));
+//   } else {
+//       std::uninitialized_copy_n(src, count, dst);
+//   }
+
+#include "entries.hpp"
+#include "predicates.hpp"
+#include <concepts>
+
+namespace asyncle {
+
+// Path tags
+struct trivial_copy_path {};
+struct move_path {};
+struct contiguous_path {};
+struct generic_path {};
+
+template <class... Entries>
+struct dispatch_by {
+    // Tag of the first entry matching T (void when none does)
+    template <class T>
+    using path = typename first_match<T, Entries...>::type;
+
+    template <class T>
+    static constexpr bool handles = first_match<T, Entries...>::found;
+};
+
+template <class Dispatch, class T>
+using dispatch_path_t = typename Dispatch::template path<T>;
+
+template <class Dispatch, class T, class Path>
+inline constexpr bool dispatches_to = std::same_as<dispatch_path_t<Dispatch, T>, Path>;
+
+// How elements are moved into and out of storage
+using element_dispatch = dispatch_by<pred_map<pred_triv_copy, trivial_copy_path>, pred_map<pred_always, move_path>>;
+
+// How a range of elements is walked; non-ranges are not handled
+using range_dispatch = dispatch_by<pred_map<pred_contig_range, contiguous_path>, pred_map<pred_range, generic_path>>;
+
+// A range whose elements can go out as raw bytes in one call
+template <class R>
+concept bulk_copyable_range = dispatches_to<range_dispatch, R, contiguous_path>
+                           && dispatches_to<element_dispatch, std::ranges::range_value_t<R>, trivial_copy_path>;
+
+}  // namespace asyncle
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef ASYNCLE_ENTRIES_HPP
 #define ASYNCLE_ENTRIES_HPP
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -52,25 +53,77 @@ struct entry_match<P, type_map<K, V>>: std::bool_constant<std::same_as<std::deca
 template <class P, template <class> class Pred, class V>
 struct entry_match<P, pred_map<Pred, V>>: std::bool_constant<pred_map<Pred, V>::template match<P>> {};
 
-// First-match lookup (supports type_map, pred_map, rule_map)
-template <class P, class... Entries>
-struct first_match;
+namespace detail {
+
+// Same test as entry_match on an already decayed payload, as a variable
+// template so a lookup instantiates no class per entry for type_map keys
+template <class D, class Entry>
+inline constexpr bool matches_decayed = entry_match<D, Entry>::value;
+
+template <class D, class K, class V>
+inline constexpr bool matches_decayed<D, type_map<K, V>> = std::is_same_v<D, K>;
+
+template <class D, template <class> class Pred, class V>
+inline constexpr bool matches_decayed<D, pred_map<Pred, V>> = Pred<D>::value;
+
+template <bool... Matches>
+constexpr std::size_t first_true() noexcept {
+    constexpr bool flags[] = { Matches..., false };
+    std::size_t    i       = 0;
+    while(i < sizeof...(Matches) && !flags[i]) ++i;
+    return i;
+}
 
-template <class P>
-struct first_match<P> {
-    static constexpr bool found = false;
-    using type                  = void;
+// Pack indexing by overload resolution: every element is a distinct base, so
+// picking element I is one deduction rather than I nested instantiations
+template <std::size_t I, class T>
+struct indexed_type {
+    using type = T;
 };
 
-template <class P, class E0, class... Rest>
-struct first_match<P, E0, Rest...> {
+template <class Seq, class... Ts>
+struct indexed_pack;
+
+template <std::size_t... Is, class... Ts>
+struct indexed_pack<std::index_sequence<Is...>, Ts...>: indexed_type<Is, Ts>... {};
+
+template <std::size_t I, class T>
+indexed_type<I, T> select_indexed(const indexed_type<I, T>&);
+
+template <bool Found, std::size_t I, class... Entries>
+struct mapped_at {
+    using type = void;
+};
+
+}  // namespace detail
+
+// Element I of a type pack, with constant instantiation depth
+template <std::size_t I, class... Ts>
+using pack_element_t = typename decltype(detail::select_indexed<I>(
+  std::declval<const detail::indexed_pack<std::index_sequence_for<Ts...>, Ts...>&>()))::type;
+
+namespace detail {
+
+template <std::size_t I, class... Entries>
+struct mapped_at<true, I, Entries...> {
+    using type = entry_mapped_t<pack_element_t<I, Entries...>>;
+};
+
+}  // namespace detail
+
+// First-match lookup (supports type_map, pred_map, rule_map). Every entry is
+// tested in one pack expansion and the winner is picked by index, so commands
+// with many entries do not nest one std::conditional_t per entry.
+template <class P, class... Entries>
+struct first_match {
     private:
-    static constexpr bool m0 = entry_match<P, E0>::value;
-    using tail               = first_match<P, Rest...>;
+    using decayed = std::decay_t<P>;
 
     public:
-    static constexpr bool found = m0 ? true : tail::found;
-    using type                  = std::conditional_t<m0, entry_mapped_t<E0>, typename tail::type>;
+    // Position of the first matching entry; sizeof...(Entries) when none match
+    static constexpr std::size_t index = detail::first_true<detail::matches_decayed<decayed, Entries>...>();
+    static constexpr bool        found = index < sizeof...(Entries);
+    using type                         = typename detail::mapped_at<found, index, Entries...>::type;
 };
 
 template <class K, class... Maps>
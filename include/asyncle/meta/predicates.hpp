@@ -13,10 +13,11 @@
 
 namespace asyncle {
 
-// Macros to convert concepts/traits to predicates
+// Macros to convert concepts/traits to predicates. Concepts see the type without
+// cv and references but not decayed, so a C array stays a (contiguous) range.
 #define MAKE_CONCEPT_PRED(NAME, CONCEPT) \
     template <class T>                   \
-    struct NAME: std::bool_constant<CONCEPT<std::decay_t<T>>> {}
+    struct NAME: std::bool_constant<CONCEPT<std::remove_cvref_t<T>>> {}
 
 #define MAKE_TRAIT_PRED(NAME, TRAIT) \
     template <class T>               \
@@ -39,24 +40,15 @@ MAKE_TRAIT_PRED(pred_scalar, std::is_scalar);
 MAKE_TRAIT_PRED(pred_trivial, std::is_trivial);
 MAKE_TRAIT_PRED(pred_triv_copy, std::is_trivially_copyable);
 
-// Range predicates - simple implementations
-template <class T>
-struct pred_range: std::false_type {};
-
-template <class T>
-struct pred_range<std::vector<T>>: std::true_type {};
-
-template <>
-struct pred_range<std::string>: std::true_type {};
-
-template <class T>
-struct pred_sized_range: std::bool_constant<pred_range<T>::value> {};
-
-template <class T>
-struct pred_contig_range: std::bool_constant<pred_range<T>::value> {};
+// Range predicates (std::ranges concepts on the cvref-stripped type)
+MAKE_CONCEPT_PRED(pred_range, std::ranges::range);
+MAKE_CONCEPT_PRED(pred_sized_range, std::ranges::sized_range);
+MAKE_CONCEPT_PRED(pred_contig_range, std::ranges::contiguous_range);
+MAKE_CONCEPT_PRED(pred_view, std::ranges::view);
 
+// Matches every type; the last entry of a total mapping
 template <class T>
-struct pred_view: std::false_type {};
+struct pred_always: std::true_type {};
 
 template <class T>
 struct pred_optional: std::false_type {};
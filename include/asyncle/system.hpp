@@ -0,0 +1,56 @@
+#ifndef ASYNCLE_SYSTEM_HPP
+#define ASYNCLE_SYSTEM_HPP
+
+// asyncle system - One process-wide snapshot of what the machine and kernel support
+//
+// Probing is not free: platform::file::query_file_caps() sets up and tears
+// down an io_uring, platform::mmap::query_capabilities() walks /proc and /sys,
+// and detect_cache_info() may read sysfs through std::ifstream. Each module
+// therefore probes once, on first use, into a function-local static (whose
+// initialization is thread-safe), and hot paths such as mmap::page_size() and
+// mmap::align_to_page() only read the result:
+//
+//   io::mmap::capabilities()      memory_caps
+//   io::file::capabilities()      file_caps
+//   io::process::capabilities()   process_caps
+//   hardware::cpu_cache_info()    cache_info
+//   hardware::cpu_features()      cpu_feature_set (after ASYNCLE_CPU_DISABLE)
+//
+// system() gathers the five in one place. Calling it once at startup, or on a
+// background thread while the service initializes, takes all of the probing
+// off the first request. The snapshot never changes afterwards; the
+// platform::*::query_* functions still probe on every call for tools that want
+// a fresh answer. Using this header links every platform library.
+//
+// Usage:
+//   const auto& sys = asyncle::system();
+//   if(sys.file.supports_async_io) use_ring();
+//   size_t line = sys.cache.l1_line_size;
+
+#include "hardware/capabilities.hpp"
+#include "hardware/memory.hpp"
+#include "io/file.hpp"
+#include "io/mmap.hpp"
+#include "io/process.hpp"
+
+namespace asyncle {
+
+struct system_snapshot {
+    const io::memory_caps&           memory;
+    const io::file_caps&             file;
+    const io::process_caps&          process;
+    const hardware::cache_info&      cache;
+    const hardware::cpu_feature_set& cpu;
+};
+
+// Probe everything not probed yet; later calls return the same snapshot
+inline const system_snapshot& system() noexcept {
+    static const system_snapshot snapshot { io::mmap::capabilities(), io::file::capabilities(),
+                                            io::process::capabilities(), hardware::cpu_cache_info(),
+                                            hardware::cpu_features() };
+    return snapshot;
+}
+
+}  // namespace asyncle
+
+#endif  // ASYNCLE_SYSTEM_HPP
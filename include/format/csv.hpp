@@ -0,0 +1,21 @@
+#ifndef FORMAT_CSV_HPP
+#define FORMAT_CSV_HPP
+
+// format::csv - CSV tokenizing and row binding foundation layer
+//
+// This is a convenience header that includes all format::csv components.
+//
+// Components:
+// - format::csv::tokenize      - SIMD field/row index over the input, no copies
+// - format::csv::field_index   - Field views by row and column
+// - format::csv::row_end       - Quote-aware row boundaries, for chunking
+// - format::csv::load_rows     - Rows into std::vector<T> by structured binding
+// - format::csv::append_row    - The reverse, with minimal quoting
+//
+// The serialize CPOs accept csv_tag for std::vector<T> (format/serialize.hpp);
+// asyncle/format/csv.hpp adds mapped files and parallel loading.
+
+#include "csv/bind.hpp"
+#include "csv/tokenizer.hpp"
+
+#endif  // FORMAT_CSV_HPP
@@ -0,0 +1,273 @@
+#ifndef FORMAT_CSV_BIND_HPP
+#define FORMAT_CSV_BIND_HPP
+
+// format::csv binding - Rows into plain structs by structured binding
+//
+// A row type is a flat aggregate with up to 16 members; column i fills member
+// i through a structured binding, so no registration or reflection is needed.
+// Supported member types:
+//   - integers and floating point (std::from_chars, the whole field must parse)
+//   - bool ("true"/"false" or "1"/"0")
+//   - char (a field of exactly one character)
+//   - std::string (quotes removed, doubled quotes collapsed)
+//   - std::string_view (a view of the input without the enclosing quotes;
+//     doubled quotes stay doubled, so prefer std::string for such columns)
+//   - std::optional<T> of any of these (an empty field is std::nullopt; for
+//     strings a quoted "" is an empty value, not an absent one)
+// Extra columns are ignored; a row with fewer columns than members, or a field
+// that does not convert, fails with error::type_mismatch. Blank lines are
+// skipped, except for a single optional column, where they are std::nullopt.
+// append_row() writes the same types back, quoting the fields that need it and
+// empty strings, so load_rows(append_row(x)) gives x back.
+//
+// Usage:
+//   struct trade { std::string symbol; int64_t qty; double price; };
+//   std::vector<trade> trades;
+//   auto rows = format::csv::load_rows(text, trades, { .header = true });
+
+#include "tokenizer.hpp"
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace format::csv {
+
+namespace detail {
+
+// Converts to any member type, to probe aggregate initialization
+struct any_member {
+    template <typename U>
+    operator U() const;
+};
+
+template <typename T, size_t... I>
+constexpr bool initializable_with(std::index_sequence<I...>) {
+    return requires { T { (static_cast<void>(I), any_member {})... }; };
+}
+
+template <typename T, size_t N = 0>
+constexpr size_t count_members() {
+    if constexpr(N > 16) {
+        return N;
+    } else if constexpr(initializable_with<T>(std::make_index_sequence<N + 1> {})) {
+        return count_members<T, N + 1>();
+    } else {
+        return N;
+    }
+}
+
+// References to the members of row, in declaration order
+template <size_t N, typename T>
+auto tie_members(T& row) {
+    // clang-format off
+    if constexpr(N == 1) { auto& [a] = row; return std::tie(a); }
+    else if constexpr(N == 2) { auto& [a, b] = row; return std::tie(a, b); }
+    else if constexpr(N == 3) { auto& [a, b, c] = row; return std::tie(a, b, c); }
+    else if constexpr(N == 4) { auto& [a, b, c, d] = row; return std::tie(a, b, c, d); }
+    else if constexpr(N == 5) { auto& [a, b, c, d, e] = row; return std::tie(a, b, c, d, e); }
+    else if constexpr(N == 6) { auto& [a, b, c, d, e, f] = row; return std::tie(a, b, c, d, e, f); }
+    else if constexpr(N == 7) { auto& [a, b, c, d, e, f, g] = row; return std::tie(a, b, c, d, e, f, g); }
+    else if constexpr(N == 8) { auto& [a, b, c, d, e, f, g, h] = row; return std::tie(a, b, c, d, e, f, g, h); }
+    else if constexpr(N == 9) {
+        auto& [a, b, c, d, e, f, g, h, i] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i);
+    } else if constexpr(N == 10) {
+        auto& [a, b, c, d, e, f, g, h, i, j] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j);
+    } else if constexpr(N == 11) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k);
+    } else if constexpr(N == 12) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l);
+    } else if constexpr(N == 13) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m);
+    } else if constexpr(N == 14) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n);
+    } else if constexpr(N == 15) {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o);
+    } else {
+        auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p] = row;
+        return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p);
+    }
+    // clang-format on
+}
+
+template <typename T>
+struct is_optional: std::false_type {};
+
+template <typename T>
+struct is_optional<std::optional<T>>: std::true_type {};
+
+template <typename T>
+concept scalar_field = std::same_as<T, bool> || std::same_as<T, char> || std::same_as<T, std::string>
+                    || std::same_as<T, std::string_view> || std::integral<T> || std::floating_point<T>;
+
+template <typename T>
+concept field_type = scalar_field<T> || (is_optional<T>::value && scalar_field<typename T::value_type>);
+
+template <typename T>
+bool parse_number(std::string_view text, T& out) noexcept {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec]  = std::from_chars(text.data(), end, out);
+    return ec == std::errc {} && ptr == end;
+}
+
+// Convert one raw field into out
+template <typename T>
+bool convert(std::string_view raw, T& out, char quote) {
+    if constexpr(is_optional<T>::value) {
+        constexpr bool text = std::same_as<typename T::value_type, std::string>
+                           || std::same_as<typename T::value_type, std::string_view>;
+        if(text ? raw.empty() : unquote(raw, quote).empty()) {
+            out.reset();
+            return true;
+        }
+        return convert(raw, out.emplace(), quote);
+    } else if constexpr(std::same_as<T, std::string>) {
+        unescape(raw, out, quote);
+        return true;
+    } else if constexpr(std::same_as<T, std::string_view>) {
+        out = unquote(raw, quote);
+        return true;
+    } else if constexpr(std::same_as<T, bool>) {
+        const std::string_view text = unquote(raw, quote);
+        if(text == "true" || text == "1") {
+            out = true;
+        } else if(text == "false" || text == "0") {
+            out = false;
+        } else {
+            return false;
+        }
+        return true;
+    } else if constexpr(std::same_as<T, char>) {
+        const std::string_view text = unquote(raw, quote);
+        if(text.size() != 1) return false;
+        out = text.front();
+        return true;
+    } else {
+        return parse_number(unquote(raw, quote), out);
+    }
+}
+
+template <typename N>
+void append_number(std::string& out, N value) {
+    char buffer[64];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, ec == std::errc {} ? end : buffer);
+}
+
+// Empty text is written as two quotes, so it reads back apart from an absent field
+inline void append_text(std::string& out, std::string_view text, const dialect& d) {
+    const char special[] = { d.delimiter, d.quote, '\n', '\r' };
+    if(!text.empty() && text.find_first_of(std::string_view(special, sizeof(special))) == std::string_view::npos) {
+        out.append(text);
+        return;
+    }
+    out.push_back(d.quote);
+    for(char c : text) {
+        if(c == d.quote) out.push_back(d.quote);
+        out.push_back(c);
+    }
+    out.push_back(d.quote);
+}
+
+// Write one member as a field
+template <typename T>
+void append_field(std::string& out, const T& value, const dialect& d) {
+    if constexpr(is_optional<T>::value) {
+        if(value) append_field(out, *value, d);
+    } else if constexpr(std::same_as<T, std::string> || std::same_as<T, std::string_view>) {
+        append_text(out, value, d);
+    } else if constexpr(std::same_as<T, bool>) {
+        out.append(value ? "true" : "false");
+    } else if constexpr(std::same_as<T, char>) {
+        append_text(out, std::string_view(&value, 1), d);
+    } else {
+        append_number(out, value);
+    }
+}
+
+// A blank line is a row of T: a single optional column, which append_row writes
+// as an empty line when it is absent
+template <typename T>
+constexpr bool binds_blank() {
+    if constexpr(count_members<T>() == 1) {
+        using member = std::remove_reference_t<std::tuple_element_t<0, decltype(tie_members<1>(std::declval<T&>()))>>;
+        return is_optional<member>::value;
+    } else {
+        return false;
+    }
+}
+
+}  // namespace detail
+
+// Columns a row type binds (its member count)
+template <typename T>
+inline constexpr size_t column_count_v = detail::count_members<T>();
+
+// A flat aggregate whose every member converts from a field
+template <typename T>
+concept row_type = std::is_aggregate_v<T> && !std::is_array_v<T> && column_count_v<T> >= 1 && column_count_v<T> <= 16
+                && requires(T& value) {
+                       []<typename... M>(std::tuple<M&...>)
+                           requires(detail::field_type<M> && ...)
+                       {}(detail::tie_members<column_count_v<T>>(value));
+                   };
+
+// Fill out from the leading fields of r
+template <row_type T>
+error bind_row(const row& r, T& out, char quote = '"') {
+    constexpr size_t columns = column_count_v<T>;
+    if(r.size() < columns) return error::type_mismatch;
+    auto members = detail::tie_members<columns>(out);
+    bool ok      = [&]<size_t... I>(std::index_sequence<I...>) {
+        return (detail::convert(r.raw(I), std::get<I>(members), quote) && ...);
+    }(std::make_index_sequence<columns> {});
+    return ok ? error::none : error::type_mismatch;
+}
+
+// Tokenize text and append one T per row to out; returns the rows appended.
+// On failure out keeps the rows bound before the bad one.
+template <row_type T>
+result<size_t> load_rows(std::string_view text, std::vector<T>& out, const dialect& d = {}) {
+    field_index rows;
+    auto        tokenized = rows.assign(text, d);
+    if(!tokenized) return result<size_t>(unexpect, tokenized.error());
+
+    const size_t before = out.size();
+    out.reserve(before + rows.row_count());
+    for(size_t i = d.header ? 1 : 0; i < rows.row_count(); ++i) {
+        const row r = rows.row(i);
+        if(r.blank() && !detail::binds_blank<T>()) continue;
+        T value {};
+        if(error e = bind_row(r, value, d.quote); e != error::none) return result<size_t>(unexpect, e);
+        out.push_back(std::move(value));
+    }
+    return out.size() - before;
+}
+
+// Append value as one row ending in '\n'
+template <row_type T>
+void append_row(std::string& out, const T& value, const dialect& d = {}) {
+    auto members = detail::tie_members<column_count_v<T>>(value);
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        ((I == 0 ? void() : out.push_back(d.delimiter), detail::append_field(out, std::get<I>(members), d)), ...);
+    }(std::make_index_sequence<column_count_v<T>> {});
+    out.push_back('\n');
+}
+
+}  // namespace format::csv
+
+#endif  // FORMAT_CSV_BIND_HPP
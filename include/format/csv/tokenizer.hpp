@@ -0,0 +1,419 @@
+#ifndef FORMAT_CSV_TOKENIZER_HPP
+#define FORMAT_CSV_TOKENIZER_HPP
+
+// format::csv tokenizer - Vectorized field splitting without copies
+//
+// The input is classified 64 bytes at a time into three bitmasks: quotes,
+// delimiters and newlines. The bytes inside quoted fields are the prefix XOR
+// of the quote mask, computed with one carry-less multiply by all ones
+// (PCLMULQDQ), as simdjson does. The parity carries into the next block.
+// Delimiters and newlines outside quotes end fields, and their positions are
+// pulled out of the mask with count-trailing-zeros into an index of offsets.
+// Fields are never copied: a field is a view of the input, quotes included,
+// until it is converted.
+//
+// AVX2 or SSE2 classification and the PCLMUL prefix XOR are picked at run
+// time; other targets get a scalar kernel with the same output. The last
+// partial block is copied to the stack, so the input needs no padding.
+//
+// RFC 4180 quoting: a quoted field may hold delimiters, newlines and doubled
+// quotes. \r\n line endings are accepted (the \r is trimmed from the last
+// field). An unterminated quote fails with error::invalid_syntax; texts of
+// 4 GiB and more fail with error::capacity_exceeded (split them first, as the
+// parallel loader does).
+//
+// Usage:
+//   format::csv::field_index rows;
+//   if(auto done = format::csv::tokenize(text, rows); !done) { ... }
+//   for(size_t r = 0; r < rows.row_count(); ++r) {
+//       auto row = rows.row(r);
+//       std::string_view name = row.raw(0);  // "\"Smith, J\"" stays quoted; see unquote()
+//   }
+
+#include "../json/types.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define FORMAT_CSV_X86 1
+#endif
+
+namespace format::csv {
+
+using format::json::error;
+using format::json::expected;
+using format::json::unexpect;
+
+template <typename T>
+using result = expected<T, error>;
+
+using void_result = expected<void, error>;
+
+struct dialect {
+    char delimiter = ',';
+    char quote     = '"';
+    bool header    = false;  // The first row names the columns; loaders skip it
+};
+
+namespace detail {
+
+struct block_masks {
+    uint64_t quote;
+    uint64_t delimiter;
+    uint64_t newline;
+};
+
+struct scalar_kernel {
+    static block_masks classify(const uint8_t* p, const dialect& d) noexcept {
+        block_masks m { 0, 0, 0 };
+        for(int i = 0; i < 64; ++i) {
+            const uint64_t bit  = uint64_t { 1 } << i;
+            m.quote            |= p[i] == static_cast<uint8_t>(d.quote) ? bit : 0;
+            m.delimiter        |= p[i] == static_cast<uint8_t>(d.delimiter) ? bit : 0;
+            m.newline          |= p[i] == '\n' ? bit : 0;
+        }
+        return m;
+    }
+
+    // Bit i = XOR of bits 0..i
+    static uint64_t prefix_xor(uint64_t bits) noexcept {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+};
+
+#ifdef FORMAT_CSV_X86
+struct sse2_kernel {
+    __attribute__((target("sse2,pclmul"))) static block_masks classify(const uint8_t* p, const dialect& d) noexcept {
+        const __m128i q  = _mm_set1_epi8(d.quote);
+        const __m128i s  = _mm_set1_epi8(d.delimiter);
+        const __m128i nl = _mm_set1_epi8('\n');
+        block_masks   m { 0, 0, 0 };
+        for(int i = 0; i < 4; ++i) {
+            const __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            const int     shift = 16 * i;
+            m.quote     |= uint64_t { static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, q))) } << shift;
+            m.delimiter |= uint64_t { static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, s))) } << shift;
+            m.newline   |= uint64_t { static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl))) } << shift;
+        }
+        return m;
+    }
+
+    __attribute__((target("sse2,pclmul"))) static uint64_t prefix_xor(uint64_t bits) noexcept {
+        const __m128i all_ones = _mm_set1_epi8(static_cast<char>(0xFF));
+        return static_cast<uint64_t>(
+          _mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(bits)), all_ones, 0)));
+    }
+};
+
+struct avx2_kernel {
+    __attribute__((target("avx2,pclmul"))) static uint64_t mask(__m256i lo, __m256i hi, __m256i needle) noexcept {
+        const uint64_t low  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+        const uint64_t high = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+        return low | high << 32;
+    }
+
+    __attribute__((target("avx2,pclmul"))) static block_masks classify(const uint8_t* p, const dialect& d) noexcept {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        return block_masks { mask(lo, hi, _mm256_set1_epi8(d.quote)),
+                             mask(lo, hi, _mm256_set1_epi8(d.delimiter)),
+                             mask(lo, hi, _mm256_set1_epi8('\n')) };
+    }
+
+    __attribute__((target("avx2,pclmul"))) static uint64_t prefix_xor(uint64_t bits) noexcept {
+        return sse2_kernel::prefix_xor(bits);
+    }
+};
+#endif
+
+// Field and row ends as they are found. The vectors are buffers kept larger
+// than the counts, so a block's offsets are stored without bounds checks.
+struct split_output {
+    static constexpr size_t slack = 64 + 8;  // One block, plus the flattening overshoot
+
+    std::vector<uint32_t> ends;
+    std::vector<uint32_t> rows;
+    size_t                fields = 0;
+    size_t                lines  = 0;
+
+    void reserve_block() {
+        if(ends.size() < fields + slack) ends.resize(ends.size() * 2 + slack);
+        if(rows.size() < lines + slack) rows.resize(rows.size() * 2 + slack);
+    }
+};
+
+// Block p (64 readable bytes) starting at offset base: the field terminators
+// outside quotes. inside carries the quote state from block to block.
+template <typename Kernel>
+[[gnu::always_inline]] inline void
+  split_block(const uint8_t* p, uint32_t base, uint64_t valid, uint64_t& inside, const dialect& d, split_output& out) {
+    const block_masks m      = Kernel::classify(p, d);
+    const uint64_t    quoted = Kernel::prefix_xor(m.quote) ^ inside;
+    inside                   = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+    uint64_t fields          = (m.delimiter | m.newline) & ~quoted & valid;
+    if(fields == 0) return;
+    uint64_t lines = m.newline & fields;
+
+    // Eight offsets per step, unconditionally; the writes past the last bit
+    // land in the slack and are overwritten by the next block
+    const size_t count = static_cast<size_t>(std::popcount(fields));
+    uint32_t*    ends  = out.ends.data() + out.fields;
+    for(size_t i = 0; i < count; i += 8) {
+        for(size_t j = 0; j < 8; ++j) {
+            ends[i + j]  = base + static_cast<uint32_t>(std::countr_zero(fields));
+            fields      &= fields - 1;
+        }
+    }
+
+    // A row ends after the field its newline terminates
+    const uint64_t all = (m.delimiter | m.newline) & ~quoted & valid;
+    while(lines) {
+        const int      bit   = std::countr_zero(lines);
+        const uint64_t upto  = bit == 63 ? ~uint64_t { 0 } : (uint64_t { 2 } << bit) - 1;
+        out.rows[out.lines++] = static_cast<uint32_t>(out.fields + static_cast<size_t>(std::popcount(all & upto)));
+        lines &= lines - 1;
+    }
+    out.fields += count;
+}
+
+// Tokenize [data, data + length); returns false on an unterminated quote
+template <typename Kernel>
+[[gnu::always_inline]] inline bool split_text(const char* data, size_t length, const dialect& d, split_output& out) {
+    const auto* p      = reinterpret_cast<const uint8_t*>(data);
+    uint64_t    inside = 0;
+    size_t      i      = 0;
+    for(; i + 64 <= length; i += 64) {
+        out.reserve_block();
+        split_block<Kernel>(p + i, static_cast<uint32_t>(i), ~uint64_t { 0 }, inside, d, out);
+    }
+    if(i < length) {
+        alignas(64) uint8_t tail[64] = {};
+        std::memcpy(tail, p + i, length - i);
+        const uint64_t valid = (uint64_t { 1 } << (length - i)) - 1;
+        out.reserve_block();
+        split_block<Kernel>(tail, static_cast<uint32_t>(i), valid, inside, d, out);
+    }
+    return inside == 0;
+}
+
+// Offset just past the first newline outside quotes at or after at_least,
+// scanning from from (a row start); length when there is none
+template <typename Kernel>
+[[gnu::always_inline]] inline size_t
+  find_row_end(const char* data, size_t length, size_t from, size_t at_least, const dialect& d) {
+    const auto* p      = reinterpret_cast<const uint8_t*>(data);
+    uint64_t    inside = 0;
+    for(size_t i = from; i < length; i += 64) {
+        alignas(64) uint8_t tail[64];
+        const uint8_t*      block = p + i;
+        uint64_t            valid = ~uint64_t { 0 };
+        if(length - i < 64) {
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, p + i, length - i);
+            block = tail;
+            valid = (uint64_t { 1 } << (length - i)) - 1;
+        }
+        const block_masks m      = Kernel::classify(block, d);
+        const uint64_t    quoted = Kernel::prefix_xor(m.quote) ^ inside;
+        inside                   = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+        if(i + 64 <= at_least) continue;
+        uint64_t lines = m.newline & ~quoted & valid;
+        if(at_least > i) lines &= ~uint64_t { 0 } << (at_least - i);
+        if(lines) return i + static_cast<size_t>(std::countr_zero(lines)) + 1;
+    }
+    return length;
+}
+
+using split_fn   = bool (*)(const char*, size_t, const dialect&, split_output&);
+using row_end_fn = size_t (*)(const char*, size_t, size_t, size_t, const dialect&);
+
+struct kernel_table {
+    split_fn    split;
+    row_end_fn  row_end;
+    const char* name;
+};
+
+inline bool split_scalar(const char* data, size_t length, const dialect& d, split_output& out) {
+    return split_text<scalar_kernel>(data, length, d, out);
+}
+
+inline size_t row_end_scalar(const char* data, size_t length, size_t from, size_t at_least, const dialect& d) {
+    return find_row_end<scalar_kernel>(data, length, from, at_least, d);
+}
+
+#ifdef FORMAT_CSV_X86
+__attribute__((target("sse2,pclmul"))) inline bool
+  split_sse2(const char* data, size_t length, const dialect& d, split_output& out) {
+    return split_text<sse2_kernel>(data, length, d, out);
+}
+
+__attribute__((target("sse2,pclmul"))) inline size_t
+  row_end_sse2(const char* data, size_t length, size_t from, size_t at_least, const dialect& d) {
+    return find_row_end<sse2_kernel>(data, length, from, at_least, d);
+}
+
+__attribute__((target("avx2,pclmul"))) inline bool
+  split_avx2(const char* data, size_t length, const dialect& d, split_output& out) {
+    return split_text<avx2_kernel>(data, length, d, out);
+}
+
+__attribute__((target("avx2,pclmul"))) inline size_t
+  row_end_avx2(const char* data, size_t length, size_t from, size_t at_least, const dialect& d) {
+    return find_row_end<avx2_kernel>(data, length, from, at_least, d);
+}
+#endif
+
+inline constexpr kernel_table scalar_table { split_scalar, row_end_scalar, "scalar" };
+
+// Best kernel for this CPU, chosen once
+inline const kernel_table& active_kernels() noexcept {
+    static const kernel_table table = [] {
+#if defined(FORMAT_CSV_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("pclmul")) {
+            if(__builtin_cpu_supports("avx2")) return kernel_table { split_avx2, row_end_avx2, "avx2" };
+            return kernel_table { split_sse2, row_end_sse2, "sse2" };
+        }
+#endif
+        return scalar_table;
+    }();
+    return table;
+}
+
+}  // namespace detail
+
+class field_index;
+
+// One row of an index: fields by position, as views of the input
+class row {
+    const char*     data_  = nullptr;
+    const uint32_t* ends_  = nullptr;  // Terminator offset of each field
+    uint32_t        begin_ = 0;        // Offset of the first field
+    size_t          count_ = 0;
+
+    friend class field_index;
+
+    row(const char* data, const uint32_t* ends, uint32_t begin, size_t count) noexcept:
+        data_(data), ends_(ends), begin_(begin), count_(count) {}
+
+    public:
+    row() noexcept = default;
+
+    size_t size() const noexcept { return count_; }
+
+    bool empty() const noexcept { return count_ == 0; }
+
+    // Field i exactly as written, quotes and escapes included (no \r)
+    std::string_view raw(size_t i) const noexcept {
+        const uint32_t start = i == 0 ? begin_ : ends_[i - 1] + 1;
+        uint32_t       end   = ends_[i];
+        if(i + 1 == count_ && end > start && data_[end - 1] == '\r') --end;
+        return std::string_view(data_ + start, end - start);
+    }
+
+    // A row with one empty field: a blank line
+    bool blank() const noexcept { return count_ == 1 && raw(0).empty(); }
+};
+
+// Field and row boundaries of one text
+class field_index {
+    const char*          data_   = nullptr;
+    size_t               length_ = 0;
+    detail::split_output out_;  // ends: each field's terminator offset; rows: one past each row's last field
+
+    public:
+    // Index text, replacing the contents (capacity is kept); returns the row
+    // count. The index refers to text, which must outlive it.
+    result<size_t> assign(
+      std::string_view text, const dialect& d = {}, const detail::kernel_table& kernels = detail::active_kernels()) {
+        clear();
+        if(text.size() >= UINT32_MAX) return result<size_t>(unexpect, error::capacity_exceeded);
+        data_   = text.data();
+        length_ = text.size();
+        if(!kernels.split(text.data(), text.size(), d, out_)) {
+            clear();
+            return result<size_t>(unexpect, error::invalid_syntax);
+        }
+        // Close a last row that has no newline
+        const size_t tail = out_.lines == 0 ? 0 : out_.ends[out_.rows[out_.lines - 1] - 1] + 1;
+        if(tail < length_) {
+            out_.reserve_block();
+            out_.ends[out_.fields++] = static_cast<uint32_t>(length_);
+            out_.rows[out_.lines++]  = static_cast<uint32_t>(out_.fields);
+        }
+        return out_.lines;
+    }
+
+    size_t row_count() const noexcept { return out_.lines; }
+
+    size_t field_count() const noexcept { return out_.fields; }
+
+    csv::row row(size_t r) const noexcept {
+        const uint32_t first = r == 0 ? 0 : out_.rows[r - 1];
+        const uint32_t begin = first == 0 ? 0 : out_.ends[first - 1] + 1;
+        return csv::row(data_, out_.ends.data() + first, begin, out_.rows[r] - first);
+    }
+
+    std::string_view text() const noexcept { return std::string_view(data_, length_); }
+
+    // Keeps capacity for the next tokenize()
+    void clear() noexcept {
+        data_       = nullptr;
+        length_     = 0;
+        out_.fields = 0;
+        out_.lines  = 0;
+    }
+};
+
+// Text of a field without its enclosing quotes; doubled quotes are left as they are
+inline std::string_view unquote(std::string_view field, char quote = '"') noexcept {
+    if(field.size() >= 2 && field.front() == quote && field.back() == quote) return field.substr(1, field.size() - 2);
+    return field;
+}
+
+// Text of a field with quotes removed and doubled quotes collapsed, into out
+inline void unescape(std::string_view field, std::string& out, char quote = '"') {
+    out.clear();
+    const bool quoted = field.size() >= 2 && field.front() == quote && field.back() == quote;
+    if(!quoted) {
+        out.assign(field);
+        return;
+    }
+    field = field.substr(1, field.size() - 2);
+    out.reserve(field.size());
+    for(size_t i = 0; i < field.size(); ++i) {
+        out.push_back(field[i]);
+        if(field[i] == quote && i + 1 < field.size() && field[i + 1] == quote) ++i;
+    }
+}
+
+// Name of the kernel tokenize() uses ("avx2", "sse2" or "scalar")
+inline const char* kernel_name() noexcept { return detail::active_kernels().name; }
+
+// Index the fields and rows of text into out; returns the row count
+inline result<size_t> tokenize(std::string_view text, field_index& out, const dialect& d = {}) {
+    return out.assign(text, d);
+}
+
+// Offset just past the first row end (a newline outside quotes) at or after
+// at_least, scanning the quote state from from, which must start a row;
+// text.size() when there is none. Chunk boundaries for parallel parsing.
+inline size_t row_end(std::string_view text, size_t from, size_t at_least, const dialect& d = {}) noexcept {
+    return detail::active_kernels().row_end(text.data(), text.size(), from, at_least, d);
+}
+
+}  // namespace format::csv
+
+#endif  // FORMAT_CSV_TOKENIZER_HPP
@@ -15,6 +15,7 @@
 // - format::json::error         - Error types
 // - format::json::parser_caps   - Parser capabilities
 // - format::json::result<T>     - Result type
+// - format::json::mutable_document - Built-in DOM for parse, patch, write back
 //
 // Usage:
 //   // Direct use of foundation layer
@@ -31,6 +32,7 @@
 //       .make();
 
 #include "json/concepts.hpp"  // json_parser concept
+#include "json/dom.hpp"       // mutable_document (built in, no backend)
 #include "json/parser.hpp"    // Unified parser (type alias)
 #include "json/types.hpp"     // error, result, parser_caps
 
@@ -0,0 +1,1028 @@
+#ifndef FORMAT_JSON_DOM_HPP
+#define FORMAT_JSON_DOM_HPP
+
+// format::json mutable DOM - Parse, patch a few fields, write back
+//
+// mutable_document parses a whole document into a tree of nodes. The nodes,
+// and any bytes a patch adds, are bump-allocated from chunks taken from a
+// std::pmr::memory_resource (use asyncle::io::arena_resource to put them in
+// an arena). Chunks are kept across parse() calls and freed only when the
+// document is destroyed. Nothing is copied out of the input: strings,
+// numbers and keys are views of it until they are changed. A string with
+// escapes is decoded into the pool on its first get_string(). The input must
+// outlive the document.
+//
+// Every node remembers its span in the input. serialize() copies each
+// unchanged node as one span, keeping the original spacing and number
+// spelling. A container whose children were only modified keeps its own
+// bytes too: only the changed children are rewritten, with the verbatim text
+// between them spliced back in. A container that gained or lost members is
+// written compactly, but its unchanged children are still copied as spans.
+// Patching one field of a large document therefore copies almost everything
+// with memcpy and formats only the new value.
+//
+// The parser is built in (no backend needed) and validates JSON syntax (not
+// UTF-8), nesting at most max_depth deep; documents of 4 GiB and more fail
+// with capacity_exceeded. dom_value is a cheap handle that carries its lookup
+// error, so lookups chain and fail once at the end:
+// doc.root()["a"]["b"].get_int64() is key_not_found when "a" is missing.
+// Handles stay valid until the next parse() or until the document moves; a
+// handle to an erased member is detached. Not thread-safe.
+//
+// Usage:
+//   asyncle::io::arena          scratch(64 << 20);
+//   asyncle::io::arena_resource memory(scratch);
+//   format::json::mutable_document doc(request_body, &memory);
+//   auto root = doc.iterate().value();
+//   root["route"]["shard"].set_int64(9);
+//   root["labels"].emplace("zone").set_string("eu-west-1b");
+//   root["debug"].erase("trace");
+//   std::string patched = doc.serialize().value();   // Unchanged spans copied as is
+
+#include "types.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace format::json {
+
+enum class dom_type : uint8_t { null, boolean, number, string, array, object };
+
+class mutable_document;
+
+namespace detail {
+
+inline constexpr uint32_t dom_no_source = UINT32_MAX;  // Also the limit on source size
+
+enum dom_flag : uint8_t {
+    dom_changed  = 1,  // This node or a descendant differs from its source span
+    dom_reshaped = 2,  // Children were added or removed; the container is rewritten
+    dom_escaped  = 4,  // String text is raw JSON with escapes, not decoded yet
+    dom_plain    = 8,  // String text is decoded and is escaped when written
+    dom_true     = 16  // Boolean value
+};
+
+// One cache line per value; offsets and lengths are 32-bit, like csv::field_index
+struct dom_node {
+    dom_type    type       = dom_type::null;
+    uint8_t     flags      = 0;
+    uint32_t    key_length = 0;
+    uint32_t    size       = 0;              // Members or elements
+    uint32_t    length     = 0;              // Of text
+    uint32_t    begin      = dom_no_source;  // Span in the source, when parsed
+    uint32_t    end        = 0;
+    const char* text       = nullptr;  // Number or string characters
+    const char* key        = nullptr;  // Decoded member name
+    dom_node*   parent     = nullptr;
+    dom_node*   next       = nullptr;
+    dom_node*   first      = nullptr;
+};
+
+static_assert(sizeof(void*) != 8 || sizeof(dom_node) == 64);
+
+// Bump allocator over chunks from an upstream resource. reset() rewinds to
+// the first chunk and reuses the chain; allocate() returns nullptr when the
+// upstream resource throws.
+class dom_pool {
+    struct chunk {
+        chunk* next;
+        size_t size;  // Usable bytes after the header
+    };
+
+    std::pmr::memory_resource* upstream_;
+    chunk*                     head_    = nullptr;
+    chunk*                     current_ = nullptr;
+    char*                      cursor_  = nullptr;
+    char*                      limit_   = nullptr;
+    size_t                     used_    = 0;  // Bytes in chunks before current_
+
+    static char* data(chunk* c) noexcept { return reinterpret_cast<char*>(c + 1); }
+
+    bool enter(chunk* c) noexcept {
+        if(current_) used_ += current_->size;
+        current_ = c;
+        cursor_  = data(c);
+        limit_   = cursor_ + c->size;
+        return true;
+    }
+
+    bool grow(size_t bytes) noexcept {
+        // Reuse the next chunk of the chain when it fits, else splice in a larger one
+        if(current_ && current_->next && current_->next->size >= bytes) return enter(current_->next);
+        size_t size = current_ ? current_->size * 2 : 4096;
+        while(size < bytes) size *= 2;
+        chunk* c = nullptr;
+        try {
+            c = static_cast<chunk*>(upstream_->allocate(sizeof(chunk) + size, alignof(std::max_align_t)));
+        } catch(...) {
+            return false;
+        }
+        c->size = size;
+        if(current_) {
+            c->next        = current_->next;
+            current_->next = c;
+        } else {
+            c->next = head_;
+            head_   = c;
+        }
+        return enter(c);
+    }
+
+    public:
+    explicit dom_pool(std::pmr::memory_resource* upstream) noexcept: upstream_(upstream) {}
+
+    dom_pool(dom_pool&& other) noexcept:
+        upstream_(other.upstream_),
+        head_(std::exchange(other.head_, nullptr)),
+        current_(std::exchange(other.current_, nullptr)),
+        cursor_(std::exchange(other.cursor_, nullptr)),
+        limit_(std::exchange(other.limit_, nullptr)),
+        used_(std::exchange(other.used_, 0)) {}
+
+    dom_pool& operator=(dom_pool&& other) noexcept {
+        if(this != &other) {
+            release();
+            upstream_ = other.upstream_;
+            head_     = std::exchange(other.head_, nullptr);
+            current_  = std::exchange(other.current_, nullptr);
+            cursor_   = std::exchange(other.cursor_, nullptr);
+            limit_    = std::exchange(other.limit_, nullptr);
+            used_     = std::exchange(other.used_, 0);
+        }
+        return *this;
+    }
+
+    ~dom_pool() { release(); }
+
+    void* allocate(size_t bytes, size_t alignment) noexcept {
+        auto at = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if(!cursor_ || at + bytes > reinterpret_cast<uintptr_t>(limit_)) {
+            if(!grow(bytes + alignment)) return nullptr;
+            at = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        }
+        cursor_ = reinterpret_cast<char*>(at + bytes);
+        return reinterpret_cast<void*>(at);
+    }
+
+    dom_node* node() noexcept {
+        void* storage = allocate(sizeof(dom_node), alignof(dom_node));
+        return storage ? ::new(storage) dom_node {} : nullptr;
+    }
+
+    const char* copy(std::string_view text) noexcept {
+        if(text.empty()) return "";
+        auto* out = static_cast<char*>(allocate(text.size(), 1));
+        if(out) std::memcpy(out, text.data(), text.size());
+        return out;
+    }
+
+    void reset() noexcept {
+        current_ = nullptr;
+        cursor_ = limit_ = nullptr;
+        used_            = 0;
+        if(head_) enter(head_);
+    }
+
+    void release() noexcept {
+        while(head_) {
+            chunk* next = head_->next;
+            upstream_->deallocate(head_, sizeof(chunk) + head_->size, alignof(std::max_align_t));
+            head_ = next;
+        }
+        current_ = nullptr;
+        cursor_ = limit_ = nullptr;
+        used_            = 0;
+    }
+
+    // Bytes handed out since the last reset(), including alignment
+    size_t used() const noexcept { return current_ ? used_ + static_cast<size_t>(cursor_ - data(current_)) : 0; }
+
+    std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+};
+
+inline bool dom_hex(char c, uint32_t& value) noexcept {
+    uint32_t digit;
+    if(c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+    else if(c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+    else if(c >= 'A' && c <= 'F') digit = static_cast<uint32_t>(c - 'A' + 10);
+    else return false;
+    value = value * 16 + digit;
+    return true;
+}
+
+// Decode the contents of a validated JSON string into out (at least raw.size()
+// bytes); returns the decoded length, or npos on an unpaired surrogate
+inline size_t dom_unescape(std::string_view raw, char* out) noexcept {
+    char* o = out;
+    for(size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if(c != '\\') {
+            *o++ = c;
+            continue;
+        }
+        c = raw[++i];
+        switch(c) {
+        case 'b' : *o++ = '\b'; break;
+        case 'f' : *o++ = '\f'; break;
+        case 'n' : *o++ = '\n'; break;
+        case 'r' : *o++ = '\r'; break;
+        case 't' : *o++ = '\t'; break;
+        case 'u' : {
+            uint32_t code = 0;
+            for(int k = 1; k <= 4; ++k) dom_hex(raw[i + k], code);
+            i += 4;
+            if(code >= 0xD800 && code < 0xDC00) {
+                uint32_t low = 0;
+                if(i + 6 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u') return std::string_view::npos;
+                for(int k = 3; k <= 6; ++k) dom_hex(raw[i + k], low);
+                if(low < 0xDC00 || low >= 0xE000) return std::string_view::npos;
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                i   += 6;
+            } else if(code >= 0xDC00 && code < 0xE000) {
+                return std::string_view::npos;
+            }
+            if(code < 0x80) {
+                *o++ = static_cast<char>(code);
+            } else if(code < 0x800) {
+                *o++ = static_cast<char>(0xC0 | (code >> 6));
+                *o++ = static_cast<char>(0x80 | (code & 0x3F));
+            } else if(code < 0x10000) {
+                *o++ = static_cast<char>(0xE0 | (code >> 12));
+                *o++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *o++ = static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                *o++ = static_cast<char>(0xF0 | (code >> 18));
+                *o++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                *o++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *o++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default : *o++ = c; break;  // " \ /
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+// Append text as a JSON string, quotes included
+inline void dom_write_string(std::string& out, std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out += '"';
+    size_t run = 0;
+    for(size_t i = 0; i < text.size(); ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if(c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch(c) {
+        case '"' : out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default  : {
+            const char escape[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+            out.append(escape, sizeof(escape));
+        }
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out += '"';
+}
+
+// True when any of the 8 bytes is '"', '\\' or below 0x20
+inline bool dom_string_special(uint64_t v) noexcept {
+    constexpr uint64_t ones = 0x0101010101010101ull, high = 0x8080808080808080ull;
+    auto zero = [](uint64_t x) { return (x - ones) & ~x & high; };
+    return (zero(v ^ (ones * '"')) | zero(v ^ (ones * '\\')) | ((v - ones * 0x20) & ~v & high)) != 0;
+}
+
+class dom_parser {
+    dom_pool&   pool_;
+    const char* base_;
+    const char* p_;
+    const char* end_;
+    size_t      depth_     = 0;
+    size_t      max_depth_ = 0;
+    error       error_     = error::none;
+
+    bool fail(error e) noexcept {
+        if(error_ == error::none) error_ = e;
+        return false;
+    }
+
+    void skip_space() noexcept {
+        while(p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+
+    bool literal(std::string_view word) noexcept {
+        if(static_cast<size_t>(end_ - p_) < word.size() || std::memcmp(p_, word.data(), word.size()) != 0) {
+            return fail(error::invalid_syntax);
+        }
+        p_ += word.size();
+        return true;
+    }
+
+    // p_ at the opening quote; leaves p_ past the closing one
+    bool scan_string(const char*& text, uint32_t& length, bool& escaped) noexcept {
+        const char* start = ++p_;
+        escaped           = false;
+        for(;;) {
+            while(end_ - p_ >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p_, 8);
+                if(dom_string_special(word)) break;
+                p_ += 8;
+            }
+            if(p_ == end_) return fail(error::invalid_syntax);
+            const auto c = static_cast<unsigned char>(*p_);
+            if(c == '"') break;
+            if(c < 0x20) return fail(error::invalid_syntax);
+            if(c == '\\') {
+                escaped = true;
+                if(++p_ == end_) return fail(error::invalid_syntax);
+                const char e = *p_;
+                if(e == 'u') {
+                    uint32_t code = 0;
+                    if(end_ - p_ < 5) return fail(error::invalid_syntax);
+                    for(int k = 1; k <= 4; ++k) {
+                        if(!dom_hex(p_[k], code)) return fail(error::invalid_syntax);
+                    }
+                    p_ += 4;
+                } else if(!std::strchr("\"\\/bfnrt", e) || e == '\0') {
+                    return fail(error::invalid_syntax);
+                }
+            }
+            ++p_;
+        }
+        text   = start;
+        length = static_cast<uint32_t>(p_ - start);
+        ++p_;
+        return true;
+    }
+
+    bool scan_digits() noexcept {
+        const char* start = p_;
+        while(p_ != end_ && *p_ >= '0' && *p_ <= '9') ++p_;
+        return p_ != start || fail(error::invalid_syntax);
+    }
+
+    bool scan_number() noexcept {
+        if(p_ != end_ && *p_ == '-') ++p_;
+        if(p_ == end_) return fail(error::invalid_syntax);
+        if(*p_ == '0') ++p_;
+        else if(!(*p_ >= '1' && *p_ <= '9') || !scan_digits()) return fail(error::invalid_syntax);
+        if(p_ != end_ && *p_ == '.' && !(++p_, scan_digits())) return false;
+        if(p_ != end_ && (*p_ == 'e' || *p_ == 'E')) {
+            ++p_;
+            if(p_ != end_ && (*p_ == '+' || *p_ == '-')) ++p_;
+            if(!scan_digits()) return false;
+        }
+        return true;
+    }
+
+    bool parse_container(dom_node* n) noexcept {
+        const bool object = *p_ == '{';
+        const char close  = object ? '}' : ']';
+        n->type           = object ? dom_type::object : dom_type::array;
+        ++p_;
+        if(++depth_ > max_depth_) return fail(error::capacity_exceeded);
+        skip_space();
+        if(p_ != end_ && *p_ == close) {
+            ++p_;
+            --depth_;
+            return true;
+        }
+        for(dom_node* tail = nullptr;;) {
+            dom_node* child = pool_.node();
+            if(!child) return fail(error::capacity_exceeded);
+            if(object) {
+                skip_space();
+                if(p_ == end_ || *p_ != '"') return fail(error::invalid_syntax);
+                bool escaped;
+                if(!scan_string(child->key, child->key_length, escaped)) return false;
+                if(escaped) {
+                    auto* decoded = static_cast<char*>(pool_.allocate(child->key_length, 1));
+                    if(!decoded) return fail(error::capacity_exceeded);
+                    const size_t length = dom_unescape({ child->key, child->key_length }, decoded);
+                    if(length == std::string_view::npos) return fail(error::utf8_error);
+                    child->key        = decoded;
+                    child->key_length = static_cast<uint32_t>(length);
+                }
+                skip_space();
+                if(p_ == end_ || *p_ != ':') return fail(error::invalid_syntax);
+                ++p_;
+            }
+            if(!parse_value(child)) return false;
+            child->parent                  = n;
+            (tail ? tail->next : n->first) = child;
+            tail                           = child;
+            ++n->size;
+            skip_space();
+            if(p_ == end_) return fail(error::invalid_syntax);
+            if(*p_ == ',') {
+                ++p_;
+                skip_space();
+                continue;
+            }
+            if(*p_ != close) return fail(error::invalid_syntax);
+            ++p_;
+            --depth_;
+            return true;
+        }
+    }
+
+    public:
+    dom_parser(dom_pool& pool, std::string_view text, size_t max_depth) noexcept:
+        pool_(pool),
+        base_(text.data()),
+        p_(text.data()),
+        end_(text.data() + text.size()),
+        max_depth_(max_depth) {}
+
+    bool parse_value(dom_node* n) noexcept {
+        skip_space();
+        if(p_ == end_) return fail(error::invalid_syntax);
+        n->begin = static_cast<uint32_t>(p_ - base_);
+        switch(*p_) {
+        case '{' :
+        case '[' :
+            if(!parse_container(n)) return false;
+            break;
+        case '"' : {
+            bool escaped;
+            n->type = dom_type::string;
+            if(!scan_string(n->text, n->length, escaped)) return false;
+            if(escaped) n->flags |= dom_escaped;
+            break;
+        }
+        case 't' :
+            n->type   = dom_type::boolean;
+            n->flags |= dom_true;
+            if(!literal("true")) return false;
+            break;
+        case 'f' :
+            n->type = dom_type::boolean;
+            if(!literal("false")) return false;
+            break;
+        case 'n' :
+            if(!literal("null")) return false;
+            break;
+        default : {
+            const char* start = p_;
+            if(!scan_number()) return false;
+            n->type   = dom_type::number;
+            n->text   = start;
+            n->length = static_cast<uint32_t>(p_ - start);
+        }
+        }
+        n->end = static_cast<uint32_t>(p_ - base_);
+        return true;
+    }
+
+    // Only whitespace may follow the root value
+    bool finish() noexcept {
+        skip_space();
+        return p_ == end_ || fail(error::invalid_syntax);
+    }
+
+    error status() const noexcept { return error_; }
+};
+
+}  // namespace detail
+
+// Handle to one node of a mutable_document. A failed lookup yields a handle
+// whose status() says why; every getter and setter on it returns that error.
+class dom_value {
+    mutable_document* doc_    = nullptr;
+    detail::dom_node* node_   = nullptr;
+    error             status_ = error::uninitialized;
+
+    friend class mutable_document;
+
+    dom_value(mutable_document* doc, detail::dom_node* node) noexcept: doc_(doc), node_(node), status_(error::none) {}
+
+    explicit dom_value(error status) noexcept: status_(status) {}
+
+    void_result check(dom_type type) const noexcept {
+        if(!node_) return void_result(unexpect, status_);
+        if(node_->type != type) return void_result(unexpect, error::type_mismatch);
+        return void_result();
+    }
+
+    void_result become(dom_type type) noexcept;
+    void_result set_text(dom_type type, std::string_view text) noexcept;
+    dom_value   insert(const char* key, uint32_t key_length) noexcept;
+    void        unlink(detail::dom_node** link) noexcept;
+
+    template <typename T>
+    result<T> get_integer() const noexcept {
+        if(auto ok = check(dom_type::number); !ok) return result<T>(unexpect, ok.error());
+        T    value {};
+        auto parsed = std::from_chars(node_->text, node_->text + node_->length, value);
+        if(parsed.ec != std::errc() || parsed.ptr != node_->text + node_->length) {
+            return result<T>(unexpect, error::type_mismatch);
+        }
+        return value;
+    }
+
+    public:
+    class iterator {
+        mutable_document* doc_  = nullptr;
+        detail::dom_node* node_ = nullptr;
+
+        friend class dom_value;
+
+        iterator(mutable_document* doc, detail::dom_node* node) noexcept: doc_(doc), node_(node) {}
+
+        public:
+        using value_type      = dom_value;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept = default;
+
+        dom_value operator*() const noexcept { return dom_value(doc_, node_); }
+
+        iterator& operator++() noexcept {
+            node_ = node_->next;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator before = *this;
+            node_           = node_->next;
+            return before;
+        }
+
+        bool operator==(const iterator& other) const noexcept { return node_ == other.node_; }
+    };
+
+    dom_value() noexcept = default;
+
+    // Lookup
+    // Member of an object (key_not_found, or type_mismatch when this is no object)
+    dom_value operator[](std::string_view key) const noexcept {
+        if(auto ok = check(dom_type::object); !ok) return dom_value(ok.error());
+        for(auto* child = node_->first; child; child = child->next) {
+            if(std::string_view(child->key, child->key_length) == key) return dom_value(doc_, child);
+        }
+        return dom_value(error::key_not_found);
+    }
+
+    // Element of an array (index_out_of_bounds, or type_mismatch)
+    dom_value at(size_t index) const noexcept {
+        if(auto ok = check(dom_type::array); !ok) return dom_value(ok.error());
+        if(index >= node_->size) return dom_value(error::index_out_of_bounds);
+        auto* child = node_->first;
+        while(index--) child = child->next;
+        return dom_value(doc_, child);
+    }
+
+    // RFC 6901 pointer relative to this value ("" is this value itself)
+    dom_value at_pointer(std::string_view pointer) const noexcept {
+        if(!node_) return *this;
+        if(pointer.empty()) return *this;
+        if(pointer[0] != '/') return dom_value(error::invalid_syntax);
+        dom_value current = *this;
+        while(!pointer.empty() && current) {
+            pointer.remove_prefix(1);
+            const size_t     cut     = pointer.find('/');
+            std::string_view segment = pointer.substr(0, cut);
+            pointer                  = cut == std::string_view::npos ? std::string_view() : pointer.substr(cut);
+            char   decoded[256];
+            size_t length = 0;
+            if(segment.find('~') != std::string_view::npos) {
+                if(segment.size() > sizeof(decoded)) return dom_value(error::capacity_exceeded);
+                for(size_t i = 0; i < segment.size(); ++i) {
+                    char c = segment[i];
+                    if(c == '~') {
+                        char next = i + 1 < segment.size() ? segment[++i] : '\0';
+                        if(next != '0' && next != '1') return dom_value(error::invalid_syntax);
+                        c = next == '1' ? '/' : '~';
+                    }
+                    decoded[length++] = c;
+                }
+                segment = std::string_view(decoded, length);
+            }
+            if(current.type() == dom_type::array) {
+                size_t index  = 0;
+                auto   parsed = std::from_chars(segment.data(), segment.data() + segment.size(), index);
+                if(segment.empty() || parsed.ec != std::errc() || parsed.ptr != segment.data() + segment.size()
+                   || (segment.size() > 1 && segment[0] == '0')) {
+                    return dom_value(error::index_out_of_bounds);
+                }
+                current = current.at(index);
+            } else {
+                current = current[segment];
+            }
+        }
+        return current;
+    }
+
+    // Accessors
+    dom_type type() const noexcept { return node_ ? node_->type : dom_type::null; }
+
+    bool is_null() const noexcept { return node_ && node_->type == dom_type::null; }
+
+    bool is_object() const noexcept { return node_ && node_->type == dom_type::object; }
+
+    bool is_array() const noexcept { return node_ && node_->type == dom_type::array; }
+
+    // Members or elements; 0 for scalars
+    size_t size() const noexcept { return node_ ? node_->size : 0; }
+
+    // Member name when this value is in an object
+    std::string_view key() const noexcept {
+        return node_ && node_->key ? std::string_view(node_->key, node_->key_length) : std::string_view();
+    }
+
+    // Changed since parse, or added by a patch
+    bool modified() const noexcept { return node_ && (node_->flags & detail::dom_changed); }
+
+    error status() const noexcept { return status_; }
+
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    iterator begin() const noexcept { return iterator(doc_, node_ ? node_->first : nullptr); }
+
+    iterator end() const noexcept { return iterator(doc_, nullptr); }
+
+    result<bool> get_bool() const noexcept {
+        if(auto ok = check(dom_type::boolean); !ok) return result<bool>(unexpect, ok.error());
+        return (node_->flags & detail::dom_true) != 0;
+    }
+
+    result<int64_t> get_int64() const noexcept { return get_integer<int64_t>(); }
+
+    result<uint64_t> get_uint64() const noexcept { return get_integer<uint64_t>(); }
+
+    result<double> get_double() const noexcept {
+        if(auto ok = check(dom_type::number); !ok) return result<double>(unexpect, ok.error());
+        double value  = 0;
+        auto   parsed = std::from_chars(node_->text, node_->text + node_->length, value);
+        if(parsed.ec != std::errc() || parsed.ptr != node_->text + node_->length) {
+            return result<double>(unexpect, error::type_mismatch);
+        }
+        return value;
+    }
+
+    // Number exactly as written in the source (or as formatted by set_*)
+    result<std::string_view> get_number_text() const noexcept {
+        if(auto ok = check(dom_type::number); !ok) return result<std::string_view>(unexpect, ok.error());
+        return std::string_view(node_->text, node_->length);
+    }
+
+    // Decoded string; a view of the source unless it had escapes
+    result<std::string_view> get_string() const noexcept;
+
+    // Mutation
+    // Replace this value; a container's children are dropped
+    void_result set_null() noexcept { return become(dom_type::null); }
+
+    void_result set_bool(bool value) noexcept {
+        if(auto ok = become(dom_type::boolean); !ok) return ok;
+        if(value) node_->flags |= detail::dom_true;
+        return void_result();
+    }
+
+    void_result set_int64(int64_t value) noexcept;
+    void_result set_uint64(uint64_t value) noexcept;
+    void_result set_double(double value) noexcept;  // type_mismatch for NaN and infinities
+    void_result set_string(std::string_view value) noexcept;
+
+    // Replace this value with an empty object or array
+    void_result set_object() noexcept { return become(dom_type::object); }
+
+    void_result set_array() noexcept { return become(dom_type::array); }
+
+    // Member key of this object, added as null at the end when missing
+    dom_value emplace(std::string_view key) noexcept;
+
+    // New null element at the end of this array
+    dom_value push_back() noexcept;
+
+    void_result erase(std::string_view key) noexcept;
+    void_result erase_at(size_t index) noexcept;
+};
+
+// Mutable, arena-friendly JSON document (see the header comment)
+class mutable_document {
+    public:
+    using document_type = dom_value;
+
+    static constexpr size_t default_max_depth = 1024;
+
+    private:
+    friend class dom_value;
+
+    detail::dom_pool  pool_;
+    std::string_view  source_;
+    detail::dom_node* root_      = nullptr;
+    size_t            max_depth_ = default_max_depth;
+    error             status_    = error::uninitialized;
+    bool              parsed_    = false;
+
+    // Mark node and its ancestors changed
+    static void touch(detail::dom_node* node) noexcept {
+        for(; node && !(node->flags & detail::dom_changed); node = node->parent) node->flags |= detail::dom_changed;
+    }
+
+    void write(std::string& out, const detail::dom_node* n) const {
+        using namespace detail;
+        if(!(n->flags & dom_changed) && n->begin != dom_no_source) {
+            out.append(source_.data() + n->begin, n->end - n->begin);
+            return;
+        }
+        switch(n->type) {
+        case dom_type::null   : out += "null"; return;
+        case dom_type::boolean: out += (n->flags & dom_true) ? "true" : "false"; return;
+        case dom_type::number : out.append(n->text, n->length); return;
+        case dom_type::string :
+            if(n->flags & dom_plain) {
+                dom_write_string(out, std::string_view(n->text, n->length));
+            } else {
+                out += '"';
+                out.append(n->text, n->length);
+                out += '"';
+            }
+            return;
+        case dom_type::array :
+        case dom_type::object: break;
+        }
+
+        if(!(n->flags & dom_reshaped) && n->begin != dom_no_source) {
+            // Same children as the source: splice the text between changed ones
+            uint32_t at = n->begin;
+            for(auto* child = n->first; child; child = child->next) {
+                if(!(child->flags & dom_changed)) continue;
+                out.append(source_.data() + at, child->begin - at);
+                write(out, child);
+                at = child->end;
+            }
+            out.append(source_.data() + at, n->end - at);
+            return;
+        }
+
+        const bool object = n->type == dom_type::object;
+        out += object ? '{' : '[';
+        for(auto* child = n->first; child; child = child->next) {
+            if(child != n->first) out += ',';
+            if(object) {
+                dom_write_string(out, std::string_view(child->key, child->key_length));
+                out += ':';
+            }
+            write(out, child);
+        }
+        out += object ? '}' : ']';
+    }
+
+    public:
+    // Constructors
+    // Empty document; parse() fills it
+    explicit mutable_document(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept:
+        pool_(resource) {}
+
+    // Parsed on the first iterate(), like simdjson_dom_document
+    explicit mutable_document(
+      std::string_view json, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept:
+        pool_(resource),
+        source_(json) {}
+
+    // Move semantics (handles into either document become invalid)
+    mutable_document(mutable_document&& other) noexcept:
+        pool_(std::move(other.pool_)),
+        source_(other.source_),
+        root_(std::exchange(other.root_, nullptr)),
+        max_depth_(other.max_depth_),
+        status_(std::exchange(other.status_, error::uninitialized)),
+        parsed_(std::exchange(other.parsed_, false)) {}
+
+    mutable_document& operator=(mutable_document&& other) noexcept {
+        if(this != &other) {
+            pool_      = std::move(other.pool_);
+            source_    = other.source_;
+            root_      = std::exchange(other.root_, nullptr);
+            max_depth_ = other.max_depth_;
+            status_    = std::exchange(other.status_, error::uninitialized);
+            parsed_    = std::exchange(other.parsed_, false);
+        }
+        return *this;
+    }
+
+    // No copy
+    mutable_document(const mutable_document&)            = delete;
+    mutable_document& operator=(const mutable_document&) = delete;
+
+    static constexpr parser_caps caps() noexcept {
+        return parser_caps {
+            .zero_copy         = true,
+            .lazy_parsing      = false,
+            .lightweight_index = false,
+            .full_dom          = true,
+
+            .streaming        = false,
+            .random_access    = true,
+            .multiple_cursors = true,
+
+            .simd_optimized          = false,
+            .swar_optimized          = true,  // String scanning, 8 bytes at a time
+            .compile_time_reflection = false,
+
+            .typical_overhead_pct = 500,  // One 64-byte node per value
+            .can_use_stack        = false,
+            .requires_mutable     = false,
+
+            .structured_binding = false,
+            .validates_utf8     = false,
+            .validates_json     = true
+        };
+    }
+
+    // Core operations
+    // Parse json (which must outlive the document), reusing the pool's chunks;
+    // earlier handles become invalid
+    void_result parse(std::string_view json) noexcept {
+        pool_.reset();
+        source_ = json;
+        parsed_ = true;
+        root_   = json.size() < detail::dom_no_source ? pool_.node() : nullptr;
+        status_ = root_ ? error::none : error::capacity_exceeded;
+        if(root_) {
+            detail::dom_parser parser(pool_, json, max_depth_);
+            if(!parser.parse_value(root_) || !parser.finish()) status_ = parser.status();
+        }
+        if(status_ != error::none) root_ = nullptr;
+        return status_ == error::none ? void_result() : void_result(unexpect, status_);
+    }
+
+    // Root value; parses the constructor's input on the first call
+    result<dom_value> iterate() noexcept {
+        if(!parsed_) (void)parse(source_);
+        if(!root_) return result<dom_value>(unexpect, status_);
+        return dom_value(this, root_);
+    }
+
+    dom_value root() noexcept {
+        if(!parsed_) (void)parse(source_);
+        return root_ ? dom_value(this, root_) : dom_value(status_);
+    }
+
+    // Append the document to out: unchanged spans verbatim, changes compact
+    void_result serialize(std::string& out) const {
+        if(!root_) return void_result(unexpect, status_);
+        write(out, root_);
+        return void_result();
+    }
+
+    result<std::string> serialize() const {
+        std::string out;
+        out.reserve(source_.size() + 64);
+        if(auto done = serialize(out); !done) return result<std::string>(unexpect, done.error());
+        return out;
+    }
+
+    // Accessors
+    std::string_view source() const noexcept { return source_; }
+
+    bool modified() const noexcept { return root_ && (root_->flags & detail::dom_changed); }
+
+    // Pool bytes used by nodes and patched text
+    size_t memory_used() const noexcept { return pool_.used(); }
+
+    std::pmr::memory_resource* resource() const noexcept { return pool_.upstream(); }
+
+    // Deepest nesting parse() accepts; deeper documents fail with capacity_exceeded
+    void set_max_depth(size_t depth) noexcept { max_depth_ = depth; }
+};
+
+inline result<std::string_view> dom_value::get_string() const noexcept {
+    if(auto ok = check(dom_type::string); !ok) return result<std::string_view>(unexpect, ok.error());
+    if(node_->flags & detail::dom_escaped) {
+        auto* decoded = static_cast<char*>(doc_->pool_.allocate(node_->length, 1));
+        if(!decoded) return result<std::string_view>(unexpect, error::capacity_exceeded);
+        const size_t length = detail::dom_unescape({ node_->text, node_->length }, decoded);
+        if(length == std::string_view::npos) return result<std::string_view>(unexpect, error::utf8_error);
+        // Same value, so the span stays reusable; only the representation changes
+        node_->text   = decoded;
+        node_->length = static_cast<uint32_t>(length);
+        node_->flags  = static_cast<uint8_t>((node_->flags & ~detail::dom_escaped) | detail::dom_plain);
+    }
+    return std::string_view(node_->text, node_->length);
+}
+
+inline void_result dom_value::become(dom_type type) noexcept {
+    if(!node_) return void_result(unexpect, status_);
+    node_->type   = type;
+    node_->flags  = static_cast<uint8_t>(detail::dom_reshaped);
+    node_->text   = nullptr;
+    node_->length = node_->size = 0;
+    node_->first                = nullptr;
+    mutable_document::touch(node_);
+    return void_result();
+}
+
+inline void_result dom_value::set_text(dom_type type, std::string_view text) noexcept {
+    if(!node_) return void_result(unexpect, status_);
+    if(text.size() >= detail::dom_no_source) return void_result(unexpect, error::capacity_exceeded);
+    const char* copy = doc_->pool_.copy(text);
+    if(!copy) return void_result(unexpect, error::capacity_exceeded);
+    (void)become(type);
+    node_->text   = copy;
+    node_->length = static_cast<uint32_t>(text.size());
+    return void_result();
+}
+
+inline void_result dom_value::set_int64(int64_t value) noexcept {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return set_text(dom_type::number, std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+inline void_result dom_value::set_uint64(uint64_t value) noexcept {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return set_text(dom_type::number, std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+inline void_result dom_value::set_double(double value) noexcept {
+    if(node_ && !std::isfinite(value)) return void_result(unexpect, error::type_mismatch);
+    char digits[32];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return set_text(dom_type::number, std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+inline void_result dom_value::set_string(std::string_view value) noexcept {
+    auto done = set_text(dom_type::string, value);
+    if(done) node_->flags |= detail::dom_plain;
+    return done;
+}
+
+inline dom_value dom_value::insert(const char* key, uint32_t key_length) noexcept {
+    detail::dom_node* child = doc_->pool_.node();
+    if(!child) return dom_value(error::capacity_exceeded);
+    child->key        = key;
+    child->key_length = key_length;
+    child->parent     = node_;
+    auto** link       = &node_->first;
+    while(*link) link = &(*link)->next;
+    *link = child;
+    ++node_->size;
+    node_->flags |= detail::dom_reshaped;
+    mutable_document::touch(child);
+    return dom_value(doc_, child);
+}
+
+inline dom_value dom_value::emplace(std::string_view key) noexcept {
+    if(auto found = (*this)[key]; found || found.status() != error::key_not_found) return found;
+    if(key.size() >= detail::dom_no_source) return dom_value(error::capacity_exceeded);
+    const char* copy = doc_->pool_.copy(key);
+    if(!copy) return dom_value(error::capacity_exceeded);
+    return insert(copy, static_cast<uint32_t>(key.size()));
+}
+
+inline dom_value dom_value::push_back() noexcept {
+    if(auto ok = check(dom_type::array); !ok) return dom_value(ok.error());
+    return insert(nullptr, 0);
+}
+
+inline void dom_value::unlink(detail::dom_node** link) noexcept {
+    detail::dom_node* child = *link;
+    *link                   = child->next;
+    child->parent           = nullptr;
+    --node_->size;
+    node_->flags |= detail::dom_reshaped;
+    mutable_document::touch(node_);
+}
+
+inline void_result dom_value::erase(std::string_view key) noexcept {
+    if(auto ok = check(dom_type::object); !ok) return ok;
+    for(auto** link = &node_->first; *link; link = &(*link)->next) {
+        if(std::string_view((*link)->key, (*link)->key_length) != key) continue;
+        unlink(link);
+        return void_result();
+    }
+    return void_result(unexpect, error::key_not_found);
+}
+
+inline void_result dom_value::erase_at(size_t index) noexcept {
+    if(auto ok = check(dom_type::array); !ok) return ok;
+    if(index >= node_->size) return void_result(unexpect, error::index_out_of_bounds);
+    auto** link = &node_->first;
+    while(index--) link = &(*link)->next;
+    unlink(link);
+    return void_result();
+}
+
+}  // namespace format::json
+
+#endif  // FORMAT_JSON_DOM_HPP
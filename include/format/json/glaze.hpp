@@ -0,0 +1,80 @@
+#ifndef FORMAT_JSON_GLAZE_HPP
+#define FORMAT_JSON_GLAZE_HPP
+
+#include "types.hpp"
+#include <string>
+#include <string_view>
+
+#ifdef FORMAT_HAS_GLAZE
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#include <glaze/glaze.hpp>
+#pragma GCC diagnostic pop
+
+namespace format::json {
+
+// Glaze generic-value capabilities: an owning tree of variants
+inline constexpr parser_caps glaze_caps {
+    .zero_copy         = false,  // Keys and strings are copied into the tree
+    .lazy_parsing      = false,
+    .lightweight_index = false,
+    .full_dom          = true,
+
+    .streaming        = false,
+    .random_access    = true,
+    .multiple_cursors = true,
+
+    .simd_optimized          = false,
+    .swar_optimized          = true,
+    .compile_time_reflection = false,  // Typed reads go through format::serialize
+
+    .typical_overhead_pct = 300,  // Node per value, std::map per object
+    .can_use_stack        = false,
+    .requires_mutable     = false,
+
+    .structured_binding = false,
+    .validates_utf8     = false,
+    .validates_json     = true
+};
+
+// Document holder for Glaze's generic JSON value
+// The input is parsed in the constructor into a tree that owns its strings, so
+// the input may be released right away. iterate() returns the root, which is
+// valid while this object is alive.
+class glaze_document {
+    public:
+    using native_document_type = glz::generic;
+    using document_type        = native_document_type;
+
+    explicit glaze_document(std::string_view json) { parse(std::string(json)); }
+
+    explicit glaze_document(padded_input input) { parse(std::string(input.view())); }
+
+    glaze_document(const glaze_document&)                = delete;
+    glaze_document& operator=(const glaze_document&)     = delete;
+    glaze_document(glaze_document&&) noexcept            = default;
+    glaze_document& operator=(glaze_document&&) noexcept = default;
+
+    static constexpr parser_caps caps() noexcept { return glaze_caps; }
+
+    result<native_document_type*> iterate() noexcept {
+        if(status_ != error::none) return result<native_document_type*>(unexpect, status_);
+        return result<native_document_type*>(&root_);
+    }
+
+    private:
+    // Glaze reads null-terminated buffers by default, hence the std::string
+    void parse(const std::string& json) {
+        if(glz::read_json(root_, json)) status_ = error::invalid_syntax;
+    }
+
+    native_document_type root_;
+    error                status_ = error::none;
+};
+
+}  // namespace format::json
+
+#endif  // FORMAT_HAS_GLAZE
+
+#endif  // FORMAT_JSON_GLAZE_HPP
@@ -8,19 +8,18 @@
 //
 // Design:
 // - Single parser type: format::json::parser
-// - Implementation selected at compile time via CMake flags
+// - Implementation selected at compile time from the compiled-in backends
+//   (select.hpp): the first one that parses in place, forward-only
 // - If no implementation available, provides error stub
 // - asyncle only sees format::json::parser (never simdjson_document, etc.)
 
+#include "pointer.hpp"
+#include "select.hpp"
 #include "types.hpp"
+#include <cstddef>
 #include <string_view>
 #include <utility>
 
-// Include selected implementation
-#ifdef FORMAT_HAS_SIMDJSON
-#include "simdjson.hpp"
-#endif
-
 // Note: For serialization (not parsing), use format::serialize with Glaze.
 // JSON parsing uses simdjson for optimal performance (zero-copy, SIMD).
 
@@ -28,45 +27,136 @@ namespace format::json {
 
 // Unified parser type - implementation selected at compile time
 // This is THE parser that asyncle uses
+using parser                                     = select_parser_t<default_requirements>;
+inline constexpr parser_caps parser_capabilities = parser::caps();
+
 #if defined(FORMAT_HAS_SIMDJSON)
-// Use simdjson as default parser
-using parser                                     = simdjson_document;
-inline constexpr parser_caps parser_capabilities = simdjson_caps;
+using parser_pool     = simdjson_parser_pool;
+using parser_lease    = simdjson_parser_lease;
+using document_stream = simdjson_document_stream;
 
 #else
-// No parser available - provide stub that produces errors
-class parser {
+// Pooled parsing stubs - same shape as the real pool, every parse fails
+class parser_lease {
     public:
-    using native_document_type = void;
-    using native_parser_type   = void;
+    struct document_type {};  // Never handed out
+
+    parser_lease() noexcept = default;
+
+    static constexpr parser_caps caps() noexcept { return parser_caps {}; }
+
+    result<void> iterate(std::string_view) noexcept { return result<void>(unexpect, error::uninitialized); }
+
+    template <typename F>
+    result<size_t> for_each_document(padded_input, F&&, size_t = 0) noexcept {
+        return result<size_t>(unexpect, error::uninitialized);
+    }
+
+    void release() noexcept {}
 
-    explicit parser(std::string_view) {}
+    bool is_valid() const noexcept { return false; }
 
-    parser(parser&&) noexcept            = default;
-    parser& operator=(parser&&) noexcept = default;
-    parser(const parser&)                = delete;
-    parser& operator=(const parser&)     = delete;
+    explicit operator bool() const noexcept { return false; }
+};
+
+class parser_pool {
+    public:
+    using lease_type = parser_lease;
+
+    explicit parser_pool(size_t = 0, size_t = 64) {}
 
     static constexpr parser_caps caps() noexcept { return parser_caps {}; }
 
-    result<void> iterate() noexcept { return result<void>(unexpect, error::uninitialized); }
+    parser_lease acquire() noexcept { return parser_lease {}; }
+
+    size_t idle() const noexcept { return 0; }
+
+    size_t created() const noexcept { return 0; }
 };
 
-inline constexpr parser_caps parser_capabilities = parser_caps {};
+// Streaming stub - chunks are rejected, nothing is buffered
+class document_stream {
+    public:
+    static constexpr size_t default_batch_size = 1000000;
+
+    explicit document_stream(size_t = default_batch_size) {}
+
+    static constexpr parser_caps caps() noexcept { return parser_caps {}; }
+
+    template <typename F>
+    result<size_t> feed(std::string_view, F&&) noexcept {
+        return result<size_t>(unexpect, error::uninitialized);
+    }
+
+    template <typename F>
+    result<size_t> finish(F&&) noexcept {
+        return result<size_t>(unexpect, error::uninitialized);
+    }
+
+    void reset() noexcept {}
+
+    size_t pending() const noexcept { return 0; }
+
+    size_t documents() const noexcept { return 0; }
+};
 #endif
 
 // Convenience: Check if a parser implementation is available
-inline constexpr bool has_parser_impl =
-#if defined(FORMAT_HAS_SIMDJSON)
-  true;
-#else
-  false;
-#endif
+inline constexpr bool has_parser_impl = has_parser_for_v<default_requirements>;
 
 // Parse function - unified interface for asyncle
 // This is what asyncle calls, without knowing the implementation
 inline auto parse(std::string_view json_data) { return parser { json_data }; }
 
+// In-place parse of a buffer with input_padding of readable slack (no copy)
+inline auto parse(padded_input input) { return parser { input }; }
+
+// Typed extraction: fill the members named by Fields in one forward pass
+// Usage:
+//   struct route { std::string_view tenant; int64_t id; std::optional<bool> trace; };
+//   route r;
+//   auto found = format::json::extract<field<"/tenant", &route::tenant>, field<"/ids/0", &route::id>>(doc, r);
+// The document must not have been iterated yet. Returns the number of fields
+// read; key_not_found when a non-optional field is absent, type_mismatch when a
+// value does not fit its member.
+template <typename... Fields, typename T>
+    requires field_set<T, Fields...>
+result<size_t> extract([[maybe_unused]] parser& doc, [[maybe_unused]] T& out) noexcept {
+#if defined(FORMAT_HAS_SIMDJSON)
+    simdjson::ondemand::document document;
+    if(auto err = doc.iterate().get(document)) return result<size_t>(unexpect, convert_error(err));
+    return simdjson_extract<Fields...>(document, out);
+#else
+    return result<size_t>(unexpect, error::uninitialized);
+#endif
+}
+
+// Same over a pooled parser; string_view members stay valid until the lease parses again
+template <typename... Fields, typename T>
+    requires field_set<T, Fields...>
+result<size_t>
+  extract([[maybe_unused]] parser_lease& lease, [[maybe_unused]] std::string_view json, [[maybe_unused]] T& out) {
+#if defined(FORMAT_HAS_SIMDJSON)
+    simdjson::ondemand::document document;
+    if(auto err = lease.iterate(json).get(document)) return result<size_t>(unexpect, convert_error(err));
+    return simdjson_extract<Fields...>(document, out);
+#else
+    return result<size_t>(unexpect, error::uninitialized);
+#endif
+}
+
+// Streaming parse of newline-delimited JSON fed in arbitrary chunks
+// Usage:
+//   format::json::document_stream stream;
+//   stream.feed(chunk, [](auto& doc) { ... });  // Repeat per chunk
+//   stream.finish([](auto& doc) { ... });
+
+// Pooled parse: the returned document lives as long as the lease
+// Usage:
+//   format::json::parser_pool pool;
+//   auto lease = pool.acquire();
+//   auto doc   = lease.iterate(json_data);
+
 }  // namespace format::json
 
 #endif  // FORMAT_JSON_PARSER_HPP
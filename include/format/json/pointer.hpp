@@ -0,0 +1,162 @@
+#ifndef FORMAT_JSON_POINTER_HPP
+#define FORMAT_JSON_POINTER_HPP
+
+// format::json::json_pointer / field - Compile-time field paths for extract()
+//
+// A json_pointer is an RFC 6901 pointer ("/route/tenant", "/ids/0") parsed at
+// compile time into unescaped segments. A field binds a pointer to a data
+// member; extract<field<...>...>(doc, out) then fills the members in one
+// forward pass over the document (see parser.hpp).
+//
+// Restrictions, checked at compile time:
+// - Pointers are non-empty, start with '/', and no pointer is a prefix of
+//   another (a forward-only parser can read a value only once).
+// - Segments contain no '"' or '\\': keys are compared against the raw JSON,
+//   like simdjson's find_field.
+// - At most 64 fields per extraction.
+// - Members are bool, arithmetic, std::string_view, std::string, or
+//   std::optional of those. std::optional members may be absent or null;
+//   std::string_view members point into the parser and live no longer.
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace format::json {
+
+template <size_t N>
+struct json_pointer {
+    static constexpr size_t no_index = static_cast<size_t>(-1);
+
+    char   text[N] {};          // Unescaped segments, back to back
+    size_t begin[N] {};         // Segment start in text
+    size_t length[N] {};        // Segment length
+    size_t index[N] {};         // Array index when the segment is a decimal number, else no_index
+    size_t count       = 0;     // Number of segments
+    bool   well_formed = true;  // Starts with '/', valid ~ escapes, no quote or backslash
+
+    consteval json_pointer(const char (&path)[N]) {
+        size_t out = 0;
+        if(N < 2 || path[0] != '/') well_formed = false;
+        for(size_t i = 0; i + 1 < N; ++i) {
+            char c = path[i];
+            if(c == '/') {
+                if(count > 0) finish_segment(count - 1, out);
+                begin[count++] = out;
+                continue;
+            }
+            if(c == '~') {
+                char next = i + 2 < N ? path[i + 1] : '\0';
+                if(next != '0' && next != '1') well_formed = false;
+                c = next == '1' ? '/' : '~';
+                ++i;
+            }
+            if(c == '"' || c == '\\') well_formed = false;
+            text[out++] = c;
+        }
+        if(count > 0) finish_segment(count - 1, out);
+    }
+
+    constexpr std::string_view segment(size_t depth) const noexcept {
+        return std::string_view(text + begin[depth], length[depth]);
+    }
+
+    constexpr size_t size() const noexcept { return count; }
+
+    // True when this pointer equals or starts with every segment of other
+    template <size_t M>
+    constexpr bool has_prefix(const json_pointer<M>& other) const noexcept {
+        if(other.count > count) return false;
+        for(size_t d = 0; d < other.count; ++d) {
+            if(segment(d) != other.segment(d)) return false;
+        }
+        return true;
+    }
+
+    private:
+    consteval void finish_segment(size_t s, size_t end) {
+        length[s] = end - begin[s];
+        index[s]  = length[s] > 0 && (length[s] == 1 || text[begin[s]] != '0') ? 0 : no_index;
+        for(size_t i = begin[s]; i < end && index[s] != no_index; ++i) {
+            if(text[i] < '0' || text[i] > '9') index[s] = no_index;
+            else index[s] = index[s] * 10 + static_cast<size_t>(text[i] - '0');
+        }
+    }
+};
+
+namespace detail {
+
+template <typename T>
+struct is_optional: std::false_type {};
+
+template <typename T>
+struct is_optional<std::optional<T>>: std::true_type {};
+
+template <typename T>
+struct member_pointer_traits;
+
+template <typename C, typename M>
+struct member_pointer_traits<M C::*> {
+    using class_type  = C;
+    using member_type = M;
+};
+
+template <typename T>
+concept json_scalar_member = std::is_same_v<T, bool> || std::is_arithmetic_v<T> || std::is_same_v<T, std::string_view>
+                          || std::is_same_v<T, std::string>;
+
+}  // namespace detail
+
+// Member types extract() can fill
+template <typename T>
+concept json_extractable = detail::json_scalar_member<T>
+                        || (detail::is_optional<T>::value && detail::json_scalar_member<typename T::value_type>);
+
+// Binds the value at Path to the data member Member
+template <json_pointer Path, auto Member>
+    requires std::is_member_object_pointer_v<decltype(Member)>
+          && json_extractable<typename detail::member_pointer_traits<decltype(Member)>::member_type>
+struct field {
+    using class_type  = typename detail::member_pointer_traits<decltype(Member)>::class_type;
+    using member_type = typename detail::member_pointer_traits<decltype(Member)>::member_type;
+
+    static_assert(Path.well_formed, "field path must be a JSON pointer without quotes or backslashes");
+
+    static constexpr auto pointer  = Path;
+    static constexpr auto member   = Member;
+    static constexpr bool required = !detail::is_optional<member_type>::value;
+};
+
+namespace detail {
+
+template <typename F>
+struct is_field: std::false_type {};
+
+template <json_pointer Path, auto Member>
+struct is_field<field<Path, Member>>: std::true_type {};
+
+// No two pointers where one is a prefix of (or equal to) the other
+template <typename F, typename... Rest>
+constexpr bool disjoint_fields() noexcept {
+    if constexpr(sizeof...(Rest) == 0) {
+        return true;
+    } else {
+        bool disjoint = ((!F::pointer.has_prefix(Rest::pointer) && !Rest::pointer.has_prefix(F::pointer)) && ...);
+        return disjoint && disjoint_fields<Rest...>();
+    }
+}
+
+}  // namespace detail
+
+// A set of fields that extract() can fill into T in one pass
+template <typename T, typename... Fields>
+concept field_set = sizeof...(Fields) > 0 && sizeof...(Fields) <= 64 && (detail::is_field<Fields>::value && ...)
+                 && (std::is_same_v<typename Fields::class_type, T> && ...) && detail::disjoint_fields<Fields...>();
+
+}  // namespace format::json
+
+#endif  // FORMAT_JSON_POINTER_HPP
@@ -0,0 +1,174 @@
+#ifndef FORMAT_JSON_SELECT_HPP
+#define FORMAT_JSON_SELECT_HPP
+
+// format::json backend selection - Pick a parser from stated requirements
+//
+// Callers say what they need from a parser (parser_requirements, one flag per
+// parser_caps property) and select_parser_t names the first compiled-in backend
+// whose caps provide all of it, in this order:
+//   1. simdjson_document      on-demand: zero-copy, lazy, one forward cursor
+//   2. simdjson_dom_document  simdjson DOM: full tape, random access
+//   3. glaze_document         Glaze generic value: owning tree
+// When none qualifies (or none is compiled in) the result is
+// unavailable_parser, whose iterate() fails with error::uninitialized, so code
+// still compiles; has_parser_for_v tells the two apart at compile time.
+//
+// parse_adaptive() adds a runtime choice between two selected backends from
+// the document size: a document queried more than once and at least
+// dom_threshold bytes long is parsed into a DOM once and then read any number
+// of times, while everything else goes through on-demand, which does the least
+// work for a single pass.
+//
+// Usage:
+//   using tree = format::json::select_parser_t<{ .random_access = true, .multiple_cursors = true }>;
+//   tree doc(json);
+//
+//   auto total = format::json::parse_adaptive(json, { .queries = 3 }, [](auto& doc) { ... });
+
+#include "glaze.hpp"
+#include "simdjson.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace format::json {
+
+// What a caller needs; every flag set must be set in the backend's parser_caps
+struct parser_requirements {
+    bool zero_copy          = false;
+    bool lazy_parsing       = false;
+    bool full_dom           = false;
+    bool streaming          = false;
+    bool random_access      = false;
+    bool multiple_cursors   = false;
+    bool simd_optimized     = false;
+    bool structured_binding = false;
+    bool validates_utf8     = false;
+    bool validates_json     = false;
+};
+
+constexpr bool satisfies(const parser_caps& caps, const parser_requirements& need) noexcept {
+    return (!need.zero_copy || caps.zero_copy) && (!need.lazy_parsing || caps.lazy_parsing)
+        && (!need.full_dom || caps.full_dom) && (!need.streaming || caps.streaming)
+        && (!need.random_access || caps.random_access) && (!need.multiple_cursors || caps.multiple_cursors)
+        && (!need.simd_optimized || caps.simd_optimized) && (!need.structured_binding || caps.structured_binding)
+        && (!need.validates_utf8 || caps.validates_utf8) && (!need.validates_json || caps.validates_json);
+}
+
+// Stand-in when no backend meets the requirements - every parse fails
+class unavailable_parser {
+    public:
+    using native_document_type = void;
+    using native_parser_type   = void;
+
+    struct document_type {};  // Never handed out
+
+    explicit unavailable_parser(std::string_view) {}
+
+    explicit unavailable_parser(padded_input) {}
+
+    unavailable_parser(unavailable_parser&&) noexcept            = default;
+    unavailable_parser& operator=(unavailable_parser&&) noexcept = default;
+    unavailable_parser(const unavailable_parser&)                = delete;
+    unavailable_parser& operator=(const unavailable_parser&)     = delete;
+
+    static constexpr parser_caps caps() noexcept { return parser_caps {}; }
+
+    result<void> iterate() noexcept { return result<void>(unexpect, error::uninitialized); }
+};
+
+// Candidate backends, in order of preference
+template <typename... Parsers>
+struct backend_list {};
+
+using compiled_backends = backend_list<
+#if defined(FORMAT_HAS_SIMDJSON)
+  simdjson_document,
+  simdjson_dom_document,
+#endif
+#if defined(FORMAT_HAS_GLAZE)
+  glaze_document,
+#endif
+  unavailable_parser>;
+
+namespace detail {
+
+template <parser_requirements Need, typename List>
+struct first_satisfying {
+    using type = unavailable_parser;
+};
+
+template <parser_requirements Need, typename First, typename... Rest>
+struct first_satisfying<Need, backend_list<First, Rest...>> {
+    using type = std::conditional_t<
+      !std::is_same_v<First, unavailable_parser> && satisfies(First::caps(), Need),
+      First,
+      typename first_satisfying<Need, backend_list<Rest...>>::type>;
+};
+
+}  // namespace detail
+
+// First backend in List that meets Need, or unavailable_parser
+template <parser_requirements Need, typename List = compiled_backends>
+using select_parser_t = typename detail::first_satisfying<Need, List>::type;
+
+template <parser_requirements Need, typename List = compiled_backends>
+inline constexpr bool has_parser_for_v = !std::is_same_v<select_parser_t<Need, List>, unavailable_parser>;
+
+// The default parser: in place and forward-only
+inline constexpr parser_requirements default_requirements { .zero_copy = true, .streaming = true };
+
+// Backends parse_adaptive() chooses between
+inline constexpr parser_requirements single_pass_requirements { .lazy_parsing = true };
+inline constexpr parser_requirements repeated_query_requirements { .random_access = true, .multiple_cursors = true };
+
+// When a document is worth a DOM
+struct size_policy {
+    size_t dom_threshold = size_t { 64 } << 10;  // Bytes from which repeated queries use the DOM
+    size_t queries       = 1;                    // Passes the caller expects to make over the document
+};
+
+constexpr bool prefers_dom(size_t size, const size_policy& policy) noexcept {
+    return policy.queries > 1 && size >= policy.dom_threshold;
+}
+
+// Parse json with the backend policy picks for its size and call f(doc) with
+// it; f is called with either backend type, so it is usually a generic lambda,
+// and must return the same type for both. When only one of the two backends is
+// available it is used for every document.
+template <
+  typename SinglePass = select_parser_t<single_pass_requirements>,
+  typename Repeated   = select_parser_t<repeated_query_requirements>,
+  typename Input,
+  typename F>
+    requires std::is_constructible_v<SinglePass, const Input&> && std::is_constructible_v<Repeated, const Input&>
+decltype(auto) parse_adaptive(const Input& input, const size_policy& policy, F&& f) {
+    using single_result = std::invoke_result_t<F&, SinglePass&>;
+    static_assert(
+      std::is_same_v<single_result, std::invoke_result_t<F&, Repeated&>>,
+      "parse_adaptive: f must return the same type for both backends");
+
+    size_t size = 0;
+    if constexpr(std::is_same_v<Input, padded_input>) {
+        size = input.length;
+    } else {
+        size = std::string_view(input).size();
+    }
+
+    constexpr bool single_missing   = std::is_same_v<SinglePass, unavailable_parser>;
+    constexpr bool repeated_missing = std::is_same_v<Repeated, unavailable_parser>;
+    if constexpr(!repeated_missing) {
+        if(single_missing || prefers_dom(size, policy)) {
+            Repeated doc(input);
+            return static_cast<single_result>(f(doc));
+        }
+    }
+    SinglePass doc(input);
+    return static_cast<single_result>(f(doc));
+}
+
+}  // namespace format::json
+
+#endif  // FORMAT_JSON_SELECT_HPP
@@ -1,8 +1,18 @@
 #ifndef FORMAT_JSON_SIMDJSON_HPP
 #define FORMAT_JSON_SIMDJSON_HPP
 
+#include "pointer.hpp"
 #include "types.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string_view>
+#include <tuple>
+#include <utility>
 
 #ifdef FORMAT_HAS_SIMDJSON
 #pragma GCC diagnostic push
@@ -13,6 +23,8 @@
 
 namespace format::json {
 
+static_assert(input_padding >= simdjson::SIMDJSON_PADDING, "input_padding must cover simdjson's padding");
+
 // simdjson capabilities
 inline constexpr parser_caps simdjson_caps {
     .zero_copy         = true,
@@ -60,6 +72,8 @@ inline error convert_error(simdjson::error_code err) noexcept {
 // RAII document holder for simdjson on-demand parsing
 // This class owns the memory (padded_string) required for zero-copy parsing
 // Usage: Create instance with JSON, then iterate() to get document for consumption
+// Inputs that already carry input_padding of slack (padded_input) are parsed in
+// place without the copy; the caller's buffer must then outlive this object.
 //
 // Important: simdjson documents are forward-only iterators that can only be consumed once.
 // The document returned by iterate() is only valid while this object is alive.
@@ -67,10 +81,21 @@ class simdjson_document {
     public:
     using native_document_type = simdjson::ondemand::document;
     using native_parser_type   = simdjson::ondemand::parser;
+    using document_type        = native_document_type;
 
     // Construct with JSON string - prepares padded memory
     explicit simdjson_document(std::string_view json): parser_(), padded_(json) {}
 
+    // Construct over a caller buffer - parsed in place when it has enough slack,
+    // otherwise copied like a string_view
+    explicit simdjson_document(padded_input input): parser_() {
+        if(input.has_padding()) {
+            input_ = input;
+        } else {
+            padded_ = simdjson::padded_string(input.view());
+        }
+    }
+
     // Non-copyable, moveable
     simdjson_document(const simdjson_document&)                = delete;
     simdjson_document& operator=(const simdjson_document&)     = delete;
@@ -91,7 +116,13 @@ class simdjson_document {
     //   auto result = doc.iterate();
     //   if(result.error()) { /* handle error */ }
     //   auto name = result["name"].get_string();
-    simdjson::simdjson_result<native_document_type> iterate() noexcept { return parser_.iterate(padded_); }
+    simdjson::simdjson_result<native_document_type> iterate() noexcept {
+        if(input_.data) return parser_.iterate(input_.data, input_.length, input_.capacity);
+        return parser_.iterate(padded_);
+    }
+
+    // True when parsing the caller's buffer in place (no copy was made)
+    bool is_zero_copy() const noexcept { return input_.data != nullptr; }
 
     // Access native parser for advanced usage
     native_parser_type& parser() noexcept { return parser_; }
@@ -104,8 +135,567 @@ class simdjson_document {
     private:
     native_parser_type      parser_;
     simdjson::padded_string padded_;
+    padded_input            input_ {};  // Set only for in-place parsing
+};
+
+// simdjson DOM capabilities: the whole document is parsed into a tape up front
+inline constexpr parser_caps simdjson_dom_caps {
+    .zero_copy         = false,  // Strings are unescaped into the parser's buffer
+    .lazy_parsing      = false,
+    .lightweight_index = false,
+    .full_dom          = true,
+
+    .streaming        = false,
+    .random_access    = true,
+    .multiple_cursors = true,
+
+    .simd_optimized          = true,
+    .swar_optimized          = false,
+    .compile_time_reflection = false,
+
+    .typical_overhead_pct = 200,  // Tape plus string buffer
+    .can_use_stack        = false,
+    .requires_mutable     = false,
+
+    .structured_binding = false,
+    .validates_utf8     = true,
+    .validates_json     = true
+};
+
+// RAII document holder for simdjson DOM parsing
+// The first iterate() parses the whole document; later calls return the same
+// root, and any number of elements can be held and read in any order. Elements
+// are valid while this object is alive and not moved from.
+//
+// Usage:
+//   simdjson_dom_document doc(json_string);
+//   auto root = doc.iterate();
+//   auto name = root["user"]["name"].get_string();
+//   auto id   = root["id"].get_int64();  // Any order, any number of times
+class simdjson_dom_document {
+    public:
+    using native_document_type = simdjson::dom::element;
+    using native_parser_type   = simdjson::dom::parser;
+    using document_type        = native_document_type;
+
+    explicit simdjson_dom_document(std::string_view json): padded_(json) {}
+
+    // Parsed from the caller's buffer when it has enough slack, otherwise copied
+    explicit simdjson_dom_document(padded_input input) {
+        if(input.has_padding()) {
+            input_ = input;
+        } else {
+            padded_ = simdjson::padded_string(input.view());
+        }
+    }
+
+    simdjson_dom_document(const simdjson_dom_document&)                = delete;
+    simdjson_dom_document& operator=(const simdjson_dom_document&)     = delete;
+    simdjson_dom_document(simdjson_dom_document&&) noexcept            = default;
+    simdjson_dom_document& operator=(simdjson_dom_document&&) noexcept = default;
+
+    static constexpr parser_caps caps() noexcept { return simdjson_dom_caps; }
+
+    // Root element; parses on the first call
+    simdjson::simdjson_result<native_document_type> iterate() noexcept {
+        if(!parsed_) {
+            simdjson::dom::element root;
+            status_ = input_.data ? parser_.parse(input_.data, input_.length, false).get(root)
+                                  : parser_.parse(padded_).get(root);
+            parsed_ = true;
+        }
+        if(status_) return status_;
+        return parser_.doc.root();
+    }
+
+    native_parser_type& parser() noexcept { return parser_; }
+
+    private:
+    native_parser_type      parser_;
+    simdjson::padded_string padded_;
+    padded_input            input_ {};
+    simdjson::error_code    status_ = simdjson::SUCCESS;
+    bool                    parsed_ = false;
 };
 
+// Run on_document over every document in [data, data + length) with iterate_many.
+// data must be followed by SIMDJSON_PADDING readable bytes. Returns the document count.
+template <typename F>
+result<size_t> simdjson_iterate_many(
+  simdjson::ondemand::parser& parser,
+  const char*                 data,
+  size_t                      length,
+  size_t                      batch_size,
+  F&                          on_document) {
+    simdjson::ondemand::document_stream docs;
+    if(auto err = parser.iterate_many(data, length, batch_size).get(docs)) {
+        return result<size_t>(unexpect, convert_error(err));
+    }
+
+    size_t count = 0;
+    for(auto doc : docs) {
+        if(doc.error()) return result<size_t>(unexpect, convert_error(doc.error()));
+        simdjson::ondemand::document_reference ref = doc.value_unsafe();
+        on_document(ref);
+        ++count;
+    }
+    if(docs.truncated_bytes() != 0) return result<size_t>(unexpect, error::invalid_syntax);
+    return result<size_t>(count);
+}
+
+// Pooled parser state: an on-demand parser plus a reusable padded input buffer.
+// Both keep their capacity across documents, so steady-state parsing of similar
+// sized messages allocates nothing.
+struct simdjson_parser_slot {
+    simdjson::ondemand::parser parser;
+    std::unique_ptr<char[]>    buffer;
+    size_t                     capacity = 0;  // Usable bytes, excluding SIMDJSON_PADDING
+    simdjson_parser_slot*      next     = nullptr;
+};
+
+class simdjson_parser_pool;
+
+// RAII lease on a pooled parser; returns it to the pool on destruction.
+// The document returned by iterate() is valid until the next iterate() or until
+// the lease is released, whichever comes first. The pool must outlive its leases.
+class simdjson_parser_lease {
+    public:
+    using native_document_type = simdjson::ondemand::document;
+    using native_parser_type   = simdjson::ondemand::parser;
+    using document_type        = simdjson::ondemand::document_reference;  // Handed to for_each_document callbacks
+
+    simdjson_parser_lease() noexcept = default;
+
+    simdjson_parser_lease(simdjson_parser_lease&& other) noexcept:
+        pool_(std::exchange(other.pool_, nullptr)),
+        slot_(std::exchange(other.slot_, nullptr)) {}
+
+    simdjson_parser_lease& operator=(simdjson_parser_lease&& other) noexcept {
+        if(this != &other) {
+            release();
+            pool_ = std::exchange(other.pool_, nullptr);
+            slot_ = std::exchange(other.slot_, nullptr);
+        }
+        return *this;
+    }
+
+    simdjson_parser_lease(const simdjson_parser_lease&)            = delete;
+    simdjson_parser_lease& operator=(const simdjson_parser_lease&) = delete;
+
+    ~simdjson_parser_lease() { release(); }
+
+    static constexpr parser_caps caps() noexcept { return simdjson_caps; }
+
+    // Copy json into the lease's padded buffer (grown only when too small) and iterate
+    simdjson::simdjson_result<native_document_type> iterate(std::string_view json) {
+        if(!slot_) return simdjson::simdjson_result<native_document_type>(simdjson::UNINITIALIZED);
+        const char* data = stage(json);
+        return slot_->parser.iterate(data, json.size(), slot_->capacity + simdjson::SIMDJSON_PADDING);
+    }
+
+    // Run on_document over each document of an NDJSON range (iterate_many)
+    // Padded inputs are parsed in place; others are staged in the lease's buffer first
+    template <typename F>
+    result<size_t> for_each_document(
+      padded_input input,
+      F&&          on_document,
+      size_t       batch_size = simdjson::ondemand::DEFAULT_BATCH_SIZE) {
+        if(!slot_) return result<size_t>(unexpect, error::uninitialized);
+        const char* data = input.has_padding() ? input.data : stage(input.view());
+        return simdjson_iterate_many(slot_->parser, data, input.length, batch_size, on_document);
+    }
+
+    // Access native parser for advanced usage
+    native_parser_type& parser() noexcept { return slot_->parser; }
+
+    // Return the parser to its pool early
+    inline void release() noexcept;
+
+    bool is_valid() const noexcept { return slot_ != nullptr; }
+
+    explicit operator bool() const noexcept { return is_valid(); }
+
+    private:
+    friend class simdjson_parser_pool;
+
+    simdjson_parser_lease(simdjson_parser_pool* pool, simdjson_parser_slot* slot) noexcept: pool_(pool), slot_(slot) {}
+
+    // Copy json into the slot's padded buffer, growing it only when too small
+    const char* stage(std::string_view json) {
+        if(!slot_->buffer || json.size() > slot_->capacity) {
+            size_t capacity = slot_->capacity * 2 > json.size() ? slot_->capacity * 2 : json.size();
+            slot_->buffer.reset(new char[capacity + simdjson::SIMDJSON_PADDING]);
+            slot_->capacity = capacity;
+        }
+        if(!json.empty()) std::memcpy(slot_->buffer.get(), json.data(), json.size());
+        std::memset(slot_->buffer.get() + json.size(), 0, simdjson::SIMDJSON_PADDING);
+        return slot_->buffer.get();
+    }
+
+    simdjson_parser_pool* pool_ = nullptr;
+    simdjson_parser_slot* slot_ = nullptr;
+};
+
+// Pool of reusable on-demand parsers (thread-safe acquire/release).
+// Leases are created on demand when the pool is empty; at most max_idle parsers
+// are kept when they come back.
+class simdjson_parser_pool {
+    public:
+    using lease_type = simdjson_parser_lease;
+
+    explicit simdjson_parser_pool(size_t prewarm = 0, size_t max_idle = 64): max_idle_(max_idle) {
+        for(size_t i = 0; i < prewarm; ++i) { push(new simdjson_parser_slot()); }
+        created_ = prewarm;
+    }
+
+    simdjson_parser_pool(const simdjson_parser_pool&)            = delete;
+    simdjson_parser_pool& operator=(const simdjson_parser_pool&) = delete;
+
+    ~simdjson_parser_pool() {
+        while(free_) {
+            simdjson_parser_slot* next = free_->next;
+            delete free_;
+            free_ = next;
+        }
+    }
+
+    static constexpr parser_caps caps() noexcept { return simdjson_caps; }
+
+    // Take a parser from the pool, creating one when none is idle
+    simdjson_parser_lease acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(free_) {
+                simdjson_parser_slot* slot = free_;
+                free_                      = slot->next;
+                --idle_;
+                return simdjson_parser_lease(this, slot);
+            }
+            ++created_;
+        }
+        return simdjson_parser_lease(this, new simdjson_parser_slot());
+    }
+
+    // Parsers waiting in the pool
+    size_t idle() const noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_;
+    }
+
+    // Parsers ever created by this pool
+    size_t created() const noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return created_;
+    }
+
+    private:
+    friend class simdjson_parser_lease;
+
+    void push(simdjson_parser_slot* slot) noexcept {
+        slot->next = free_;
+        free_      = slot;
+        ++idle_;
+    }
+
+    void give_back(simdjson_parser_slot* slot) noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(idle_ < max_idle_) {
+                push(slot);
+                return;
+            }
+        }
+        delete slot;
+    }
+
+    mutable std::mutex    mutex_;
+    simdjson_parser_slot* free_     = nullptr;
+    size_t                idle_     = 0;
+    size_t                created_  = 0;
+    size_t                max_idle_ = 64;
+};
+
+inline void simdjson_parser_lease::release() noexcept {
+    if(slot_) pool_->give_back(slot_);
+    pool_ = nullptr;
+    slot_ = nullptr;
+}
+
+// Incremental NDJSON parser over iterate_many.
+// Chunks of any size are appended to a reusable padded buffer; everything up to
+// the last newline is parsed as a document stream and the incomplete tail is
+// carried into the next feed(), so documents straddling chunk boundaries stay
+// intact. finish() parses whatever remains after the final chunk.
+// batch_size bounds the largest single document (error::capacity_exceeded past it).
+//
+// Usage:
+//   simdjson_document_stream stream;
+//   auto on_document = [](simdjson::ondemand::document_reference& doc) { ... };
+//   while(auto chunk = next_chunk()) { stream.feed(chunk, on_document); }
+//   stream.finish(on_document);
+//
+// Documents handed to the callback are only valid during the call.
+class simdjson_document_stream {
+    public:
+    using native_document_type = simdjson::ondemand::document_reference;
+    using native_parser_type   = simdjson::ondemand::parser;
+
+    static constexpr size_t default_batch_size = simdjson::ondemand::DEFAULT_BATCH_SIZE;
+
+    explicit simdjson_document_stream(size_t batch_size = default_batch_size): batch_size_(batch_size) {}
+
+    simdjson_document_stream(const simdjson_document_stream&)            = delete;
+    simdjson_document_stream& operator=(const simdjson_document_stream&) = delete;
+
+    static constexpr parser_caps caps() noexcept { return simdjson_caps; }
+
+    // Append chunk and parse every complete line; returns documents parsed by this call
+    template <typename F>
+    result<size_t> feed(std::string_view chunk, F&& on_document) {
+        size_t start = length_;
+        append(chunk);
+
+        size_t newline = std::string_view(buffer_.get() + start, chunk.size()).rfind('\n');
+        if(newline == std::string_view::npos) return result<size_t>(size_t { 0 });
+
+        size_t complete = start + newline + 1;
+        auto   parsed   = parse(complete, on_document);
+        std::memmove(buffer_.get(), buffer_.get() + complete, length_ - complete);
+        length_ -= complete;
+        return parsed;
+    }
+
+    // Parse the trailing document left without a final newline
+    template <typename F>
+    result<size_t> finish(F&& on_document) {
+        size_t length = length_;
+        length_       = 0;
+        if(std::string_view(buffer_.get(), length).find_first_not_of(" \t\r\n") == std::string_view::npos) {
+            return result<size_t>(size_t { 0 });
+        }
+        return parse(length, on_document);
+    }
+
+    // Drop any carried bytes; buffer capacity is kept
+    void reset() noexcept { length_ = 0; }
+
+    // Bytes of an incomplete document waiting for the next chunk
+    size_t pending() const noexcept { return length_; }
+
+    // Total documents parsed since construction
+    size_t documents() const noexcept { return documents_; }
+
+    size_t batch_size() const noexcept { return batch_size_; }
+
+    // Access native parser for advanced usage
+    native_parser_type& parser() noexcept { return parser_; }
+
+    private:
+    void append(std::string_view chunk) {
+        if(length_ + chunk.size() > capacity_) {
+            size_t capacity = capacity_ * 2 > length_ + chunk.size() ? capacity_ * 2 : length_ + chunk.size();
+            std::unique_ptr<char[]> grown(new char[capacity + simdjson::SIMDJSON_PADDING]);
+            if(length_) std::memcpy(grown.get(), buffer_.get(), length_);
+            buffer_   = std::move(grown);
+            capacity_ = capacity;
+        }
+        if(!chunk.empty()) std::memcpy(buffer_.get() + length_, chunk.data(), chunk.size());
+        length_ += chunk.size();
+    }
+
+    template <typename F>
+    result<size_t> parse(size_t length, F& on_document) {
+        auto parsed = simdjson_iterate_many(parser_, buffer_.get(), length, batch_size_, on_document);
+        if(parsed) documents_ += *parsed;
+        return parsed;
+    }
+
+    native_parser_type      parser_;
+    std::unique_ptr<char[]> buffer_;
+    size_t                  capacity_   = 0;  // Usable bytes, excluding SIMDJSON_PADDING
+    size_t                  length_     = 0;
+    size_t                  batch_size_ = default_batch_size;
+    size_t                  documents_  = 0;
+};
+
+// One forward pass filling the members named by Fields (see pointer.hpp).
+// At each object or array only children on some field's path are entered; all
+// other values are skipped by the on-demand iterator without being parsed, and
+// an object is left as soon as every field below it has been read. The walk is
+// instantiated per depth, so every key comparison is against a constant segment.
+template <typename T, typename... Fields>
+class simdjson_extraction {
+    using mask_type = uint64_t;
+
+    template <size_t I>
+    using field_at = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr mask_type all =
+      sizeof...(Fields) == 64 ? ~mask_type { 0 } : (mask_type { 1 } << sizeof...(Fields)) - 1;
+
+    T*        out_;
+    mask_type found_ = 0;
+
+    template <typename M, typename V>
+    static error read(V&& value, M& member) noexcept {
+        if constexpr(detail::is_optional<M>::value) {
+            bool null = false;
+            if(auto err = value.is_null().get(null)) return convert_error(err);
+            if(null) {
+                member.reset();
+                return error::none;
+            }
+            return read(value, member.emplace());
+        } else if constexpr(std::is_same_v<M, bool>) {
+            return convert_error(value.get_bool().get(member));
+        } else if constexpr(std::is_floating_point_v<M>) {
+            double number;
+            if(auto err = value.get_double().get(number)) return convert_error(err);
+            member = static_cast<M>(number);
+            return error::none;
+        } else if constexpr(std::is_integral_v<M> && std::is_signed_v<M>) {
+            int64_t number;
+            if(auto err = value.get_int64().get(number)) return convert_error(err);
+            if(number < std::numeric_limits<M>::min() || number > std::numeric_limits<M>::max()) {
+                return error::type_mismatch;
+            }
+            member = static_cast<M>(number);
+            return error::none;
+        } else if constexpr(std::is_integral_v<M>) {
+            uint64_t number;
+            if(auto err = value.get_uint64().get(number)) return convert_error(err);
+            if(number > std::numeric_limits<M>::max()) return error::type_mismatch;
+            member = static_cast<M>(number);
+            return error::none;
+        } else {
+            std::string_view text;
+            if(auto err = value.get_string().get(text)) return convert_error(err);
+            member = M(text);
+            return error::none;
+        }
+    }
+
+    static constexpr size_t max_depth = [] {
+        size_t depth = 0;
+        ((depth = Fields::pointer.size() > depth ? Fields::pointer.size() : depth), ...);
+        return depth;
+    }();
+
+    // Fields of mask whose segment at Depth satisfies matches(segment, index); paths are
+    // compile-time, so each comparison is against a constant key
+    template <size_t Depth, typename Match>
+    static mask_type select(mask_type mask, Match&& matches) noexcept {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            mask_type selected = 0;
+            (
+              [&] {
+                  constexpr auto& pointer = field_at<I>::pointer;
+                  if constexpr(Depth < pointer.size()) {
+                      if(mask >> I & 1 && matches(pointer.segment(Depth), pointer.index[Depth])) {
+                          selected |= mask_type { 1 } << I;
+                      }
+                  }
+              }(),
+              ...);
+            return selected;
+        }(std::index_sequence_for<Fields...> {});
+    }
+
+    // value is the target of exactly one field when that field's path ends at Depth
+    template <size_t Depth, typename V>
+    error visit(V&& value, mask_type selected) noexcept {
+        error status = error::none;
+        bool  leaf   = [&]<size_t... I>(std::index_sequence<I...>) {
+            return (
+              [&] {
+                  if constexpr(field_at<I>::pointer.size() == Depth) {
+                      if(selected >> I & 1) {
+                          status  = read(value, out_->*field_at<I>::member);
+                          found_ |= mask_type { 1 } << I;
+                          return true;
+                      }
+                  }
+                  return false;
+              }()
+              || ...);
+        }(std::index_sequence_for<Fields...> {});
+        if constexpr(Depth < max_depth) {
+            if(!leaf) return walk<Depth>(value, selected);
+        }
+        return status;
+    }
+
+    template <size_t Depth, typename V>
+    error walk(V&& value, mask_type mask) noexcept {
+        // Only a segment that reads as an index can address an array; otherwise go straight for an object
+        constexpr bool may_index = [] {
+            return ((Depth < Fields::pointer.size() && Fields::pointer.index[Depth] != Fields::pointer.no_index) || ...);
+        }();
+        simdjson::ondemand::json_type type = simdjson::ondemand::json_type::object;
+        if constexpr(may_index) {
+            if(auto err = value.type().get(type)) return convert_error(err);
+        }
+
+        if(type == simdjson::ondemand::json_type::object) {
+            simdjson::ondemand::object object;
+            if(auto err = value.get_object().get(object)) {
+                return err == simdjson::INCORRECT_TYPE ? error::none : convert_error(err);  // Path ends early
+            }
+            for(auto member : object) {
+                simdjson::ondemand::field entry;
+                if(auto err = std::move(member).get(entry)) return convert_error(err);
+                auto      key      = entry.key();
+                mask_type selected = select<Depth>(mask, [&](std::string_view segment, size_t) {
+                    return key.unsafe_is_equal(segment);
+                });
+                if(!selected) continue;
+                if(auto status = visit<Depth + 1>(entry.value(), selected); status != error::none) return status;
+                if((found_ & mask) == mask) break;
+            }
+        } else if(type == simdjson::ondemand::json_type::array) {
+            simdjson::ondemand::array array;
+            if(auto err = value.get_array().get(array)) return convert_error(err);
+            size_t position = 0;
+            for(auto element : array) {
+                simdjson::ondemand::value item;
+                if(auto err = std::move(element).get(item)) return convert_error(err);
+                mask_type selected = select<Depth>(mask, [&](std::string_view, size_t index) {
+                    return index == position;
+                });
+                ++position;
+                if(!selected) continue;
+                if(auto status = visit<Depth + 1>(item, selected); status != error::none) return status;
+                if((found_ & mask) == mask) break;
+            }
+        }
+        // Scalars on the way down leave the deeper fields unfound
+        return error::none;
+    }
+
+    public:
+    explicit simdjson_extraction(T& out) noexcept: out_(&out) {}
+
+    // Returns the number of fields read; key_not_found when a required field is absent
+    template <typename Document>
+    result<size_t> run(Document& doc) noexcept {
+        if(auto status = walk<0>(doc, all); status != error::none) return result<size_t>(unexpect, status);
+        constexpr mask_type required = [] {
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                return ((field_at<I>::required ? mask_type { 1 } << I : 0) | ...);
+            }(std::index_sequence_for<Fields...> {});
+        }();
+        if((found_ & required) != required) return result<size_t>(unexpect, error::key_not_found);
+        return result<size_t>(static_cast<size_t>(std::popcount(found_)));
+    }
+};
+
+// Extract Fields from an on-demand document (or document_reference) not yet consumed
+template <typename... Fields, typename T, typename Document>
+    requires field_set<T, Fields...>
+result<size_t> simdjson_extract(Document& doc, T& out) noexcept {
+    return simdjson_extraction<T, Fields...>(out).run(doc);
+}
+
 }  // namespace format::json
 
 #endif  // FORMAT_HAS_SIMDJSON
@@ -90,6 +90,23 @@ struct parser_caps {
     bool validates_json;      // Validates JSON structure during parsing
 };
 
+// Readable slack required after the last byte for in-place (zero-copy) parsing.
+// Parsers may read, but never write, up to this many bytes past the document.
+inline constexpr size_t input_padding = 64;
+
+// Caller-owned input with slack after the document for in-place parsing
+struct padded_input {
+    const char* data     = nullptr;
+    size_t      length   = 0;  // Document bytes
+    size_t      capacity = 0;  // Readable bytes starting at data (length + slack)
+
+    constexpr bool has_padding() const noexcept {
+        return data != nullptr && capacity >= length && capacity - length >= input_padding;
+    }
+
+    constexpr std::string_view view() const noexcept { return std::string_view { data, length }; }
+};
+
 // Data source lifetime hints
 enum class source_lifetime {
     transient,  // Must copy immediately (e.g., temporary buffer)
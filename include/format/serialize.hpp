@@ -13,9 +13,9 @@
 // 4. Support for multiple serialization libraries
 //
 // Supported formats (when corresponding libraries are available):
-// - JSON (via Glaze)
+// - JSON (via Glaze, or built in for structs that declare a json_schema)
 // - BEVE (Binary Efficient Versatile Encoding, via Glaze)
-// - CSV (via Glaze)
+// - CSV (built in: std::vector of flat structs, see format/csv.hpp)
 // - XML (future)
 // - YAML (future)
 //
@@ -30,8 +30,16 @@
 //
 //   // Serialize to binary format
 //   auto bytes = format::serialize::save(config, format::serialize::beve_tag{});
+//
+//   // Serialize into a reused buffer (no allocation once its capacity suffices)
+//   std::string out;
+//   auto written = format::serialize::save_into(config, out, format::serialize::json_tag{});
 
 #include "serialize/concepts.hpp"
+#include "serialize/csv.hpp"
+#include "serialize/json_schema.hpp"
+#include <cstddef>
+#include <cstring>
 #include <span>
 #include <string>
 #include <string_view>
@@ -77,6 +85,60 @@ struct save_fn {
     }
 };
 
+// save_into writes into caller-owned storage and returns the bytes written by the call.
+// Implementations customize it with save_into_impl(obj, buffer, tag, mode) for
+// growable buffers and save_into_impl(obj, span, tag) for fixed spans; without
+// one, save_impl's result is copied in (correct, but still allocates).
+struct save_into_fn {
+    // Text format into a growable string
+    template <typename T, typename Tag>
+    requires text_format<Tag>
+    auto operator()(T const& obj, std::string& out, Tag tag, write_mode mode = write_mode::overwrite) const
+      -> result<size_t> {
+        if constexpr(requires { save_into_impl(obj, out, tag, mode); }) {
+            return save_into_impl(obj, out, tag, mode);
+        } else {
+            return copy_into(save_impl(obj, tag), out, mode);
+        }
+    }
+
+    // Binary format into a growable byte vector
+    template <typename T, typename Tag>
+    requires binary_format<Tag>
+    auto operator()(T const& obj, std::vector<std::byte>& out, Tag tag, write_mode mode = write_mode::overwrite) const
+      -> result<size_t> {
+        if constexpr(requires { save_into_impl(obj, out, tag, mode); }) {
+            return save_into_impl(obj, out, tag, mode);
+        } else {
+            return copy_into(save_impl(obj, tag), out, mode);
+        }
+    }
+
+    // Any format into a fixed span; capacity_exceeded when it does not fit
+    template <typename T, typename Tag>
+    requires text_format<Tag> || binary_format<Tag>
+    auto operator()(T const& obj, std::span<std::byte> out, Tag tag) const -> result<size_t> {
+        if constexpr(requires { save_into_impl(obj, out, tag); }) {
+            return save_into_impl(obj, out, tag);
+        } else {
+            auto saved = save_impl(obj, tag);
+            if(!saved) return result<size_t>(unexpect, saved.error());
+            if(saved->size() > out.size()) return result<size_t>(unexpect, error::capacity_exceeded);
+            if(!saved->empty()) std::memcpy(out.data(), saved->data(), saved->size());
+            return result<size_t>(saved->size());
+        }
+    }
+
+    private:
+    template <typename Saved, typename Buffer>
+    static result<size_t> copy_into(Saved&& saved, Buffer& out, write_mode mode) {
+        if(!saved) return result<size_t>(unexpect, saved.error());
+        if(mode == write_mode::overwrite) out.clear();
+        out.insert(out.end(), saved->begin(), saved->end());
+        return result<size_t>(saved->size());
+    }
+};
+
 template <typename T>
 struct load_fn {
     // Text format overload
@@ -96,7 +158,8 @@ struct load_fn {
 }  // namespace detail
 
 // CPO objects
-inline constexpr detail::save_fn save {};
+inline constexpr detail::save_fn      save {};
+inline constexpr detail::save_into_fn save_into {};
 
 // Load CPO - template variable pattern for proper template argument deduction
 template <typename T>
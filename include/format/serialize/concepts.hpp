@@ -3,6 +3,7 @@
 
 #include "../json/types.hpp"
 #include <concepts>
+#include <cstdint>
 #include <span>
 #include <string>
 #include <string_view>
@@ -13,11 +14,18 @@ namespace format::serialize {
 // Import expected from json
 using format::json::error;
 using format::json::expected;
+using format::json::unexpect;
 
 // Result types for serialization
 template <typename T>
 using result = expected<T, error>;
 
+// How save_into treats existing buffer contents (capacity is always kept)
+enum class write_mode : uint8_t {
+    overwrite,  // Replace the contents
+    append      // Write after the existing contents
+};
+
 // Format tag types - used to select serialization format
 // These are empty tag types for compile-time dispatch
 struct json_tag {};
@@ -0,0 +1,70 @@
+#ifndef FORMAT_SERIALIZE_CSV_HPP
+#define FORMAT_SERIALIZE_CSV_HPP
+
+// CSV adapter for the serialize CPOs: std::vector<T> of a csv::row_type, one
+// row per element, no header row (see format/csv/bind.hpp for the mapping)
+
+#include "../csv/bind.hpp"
+#include "concepts.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace format::serialize {
+
+inline constexpr serializer_caps csv_caps {
+    .text_format         = true,
+    .binary_format       = false,
+    .self_describing     = false,
+    .supports_reflection = true,  // Structured bindings, no registration
+    .supports_schema     = false,
+    .streaming_output    = true,
+    .zero_allocation     = false,
+    .compile_time        = false,
+    .format_name         = "CSV",
+    .mime_type           = "text/csv"
+};
+
+namespace detail {
+
+template <typename T>
+struct is_csv_table: std::false_type {};
+
+template <typename T, typename A>
+requires csv::row_type<T>
+struct is_csv_table<std::vector<T, A>>: std::true_type {};
+
+}  // namespace detail
+
+template <typename T>
+concept csv_table = detail::is_csv_table<T>::value;
+
+template <csv_table T>
+auto save_into_impl(T const& rows, std::string& out, csv_tag, write_mode mode) -> result<size_t> {
+    if(mode == write_mode::overwrite) out.clear();
+    const size_t before = out.size();
+    for(const auto& row : rows) csv::append_row(out, row);
+    return result<size_t>(out.size() - before);
+}
+
+template <csv_table T>
+auto save_impl(T const& rows, csv_tag tag) -> result<std::string> {
+    std::string out;
+    auto        saved = save_into_impl(rows, out, tag, write_mode::overwrite);
+    if(!saved) return result<std::string>(unexpect, saved.error());
+    return result<std::string>(std::move(out));
+}
+
+template <csv_table T>
+auto load_impl(std::string_view data, csv_tag) -> result<T> {
+    T    rows;
+    auto loaded = csv::load_rows(data, rows);
+    if(!loaded) return result<T>(unexpect, loaded.error());
+    return result<T>(std::move(rows));
+}
+
+}  // namespace format::serialize
+
+#endif  // FORMAT_SERIALIZE_CSV_HPP
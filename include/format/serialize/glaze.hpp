@@ -2,6 +2,8 @@
 #define FORMAT_SERIALIZE_GLAZE_HPP
 
 #include "concepts.hpp"
+#include <cstddef>
+#include <cstring>
 #include <span>
 #include <string>
 #include <string_view>
@@ -65,6 +67,48 @@ auto save_impl(T const& obj, json_tag) -> result<std::string> {
     return result<std::string>(std::move(buffer));
 }
 
+// Per-thread staging buffer for append and fixed-span writes; keeps its capacity
+template <typename Buffer>
+Buffer& glaze_scratch() {
+    thread_local Buffer buffer;
+    return buffer;
+}
+
+// Glaze writes from the start of the buffer, so the reused buffer serves overwrite
+// directly; append and span targets stage through the per-thread scratch buffer
+template <typename Buffer, typename Write>
+auto glaze_write_into(Buffer& out, write_mode mode, Write&& write) -> result<size_t> {
+    if(mode == write_mode::overwrite) {
+        if(auto ec = write(out)) { return result<size_t>(unexpect, convert_glaze_error(ec)); }
+        return result<size_t>(out.size());
+    }
+
+    auto& scratch = glaze_scratch<Buffer>();
+    if(auto ec = write(scratch)) { return result<size_t>(unexpect, convert_glaze_error(ec)); }
+    out.insert(out.end(), scratch.begin(), scratch.end());
+    return result<size_t>(scratch.size());
+}
+
+template <typename Buffer, typename Write>
+auto glaze_write_span(std::span<std::byte> out, Write&& write) -> result<size_t> {
+    auto& scratch = glaze_scratch<Buffer>();
+    if(auto ec = write(scratch)) { return result<size_t>(unexpect, convert_glaze_error(ec)); }
+    if(scratch.size() > out.size()) { return result<size_t>(unexpect, error::capacity_exceeded); }
+    if(!scratch.empty()) std::memcpy(out.data(), scratch.data(), scratch.size());
+    return result<size_t>(scratch.size());
+}
+
+// save_into with Glaze + JSON: reuses out's capacity
+template <typename T>
+auto save_into_impl(T const& obj, std::string& out, json_tag, write_mode mode) -> result<size_t> {
+    return glaze_write_into(out, mode, [&](std::string& buffer) { return glz::write_json(obj, buffer); });
+}
+
+template <typename T>
+auto save_into_impl(T const& obj, std::span<std::byte> out, json_tag) -> result<size_t> {
+    return glaze_write_span<std::string>(out, [&](std::string& buffer) { return glz::write_json(obj, buffer); });
+}
+
 // Implementation for load with Glaze + JSON
 template <typename T>
 auto load_impl(std::string_view data, json_tag) -> result<T> {
@@ -87,6 +131,19 @@ auto save_impl(T const& obj, beve_tag) -> result<std::vector<std::byte>> {
     return result<std::vector<std::byte>>(std::move(buffer));
 }
 
+// save_into with Glaze + BEVE
+template <typename T>
+auto save_into_impl(T const& obj, std::vector<std::byte>& out, beve_tag, write_mode mode) -> result<size_t> {
+    return glaze_write_into(out, mode, [&](std::vector<std::byte>& buffer) { return glz::write_binary(obj, buffer); });
+}
+
+template <typename T>
+auto save_into_impl(T const& obj, std::span<std::byte> out, beve_tag) -> result<size_t> {
+    return glaze_write_span<std::vector<std::byte>>(out, [&](std::vector<std::byte>& buffer) {
+        return glz::write_binary(obj, buffer);
+    });
+}
+
 // Implementation for load with Glaze + BEVE
 template <typename T>
 auto load_impl(std::span<std::byte const> data, beve_tag) -> result<T> {
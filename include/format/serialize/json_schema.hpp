@@ -0,0 +1,530 @@
+#ifndef FORMAT_SERIALIZE_JSON_SCHEMA_HPP
+#define FORMAT_SERIALIZE_JSON_SCHEMA_HPP
+
+// Schema-compiled JSON output for json_tag
+//
+// A struct that names its fields in a schema is written by a dedicated
+// serializer instead of a generic one. The constant text between values
+// (`{"id":`, `,"name":` and the closing `}`) is escaped and concatenated at
+// compile time, so each field costs one fixed-size copy plus its value. The
+// output is sized from the layout first: the fragments, the widest number of
+// each numeric type, and the length of each string plus its quotes. Numbers
+// are written with std::to_chars (shortest round trip for floating point),
+// and strings are scanned for bytes that need escaping 16 bytes at a time with
+// SSE2, so clean strings are one memcpy.
+//
+// Member types: bool, integers, floating point (NaN and infinity are written
+// as null), std::string, std::string_view, const char*, std::optional of any
+// of these (null when empty), std::vector and std::array of any of these, and
+// other schema types (nested objects). Strings are written as given; invalid
+// UTF-8 is not repaired.
+//
+// A schema is declared inside the struct, or, for types that cannot be
+// changed, by specializing json_schema_for:
+//   struct user {
+//       int64_t                  id;
+//       std::string              name;
+//       std::vector<std::string> roles;
+//       using json_schema = format::serialize::json_fields<
+//         format::serialize::json_field<"id", &user::id>,
+//         format::serialize::json_field<"name", &user::name>,
+//         format::serialize::json_field<"roles", &user::roles>>;
+//   };
+//   auto text = format::serialize::save(u, format::serialize::json_tag {});  // {"id":7,"name":"ann","roles":[]}
+//
+// With Glaze enabled the schema serializer still takes precedence for these
+// types: its overloads are more constrained than Glaze's.
+
+#include "concepts.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FORMAT_SERIALIZE_SSE2 1
+#endif
+
+namespace format::serialize {
+
+inline constexpr serializer_caps schema_json_caps {
+    .text_format         = true,
+    .binary_format       = false,
+    .self_describing     = true,
+    .supports_reflection = false,  // Fields are listed in a schema
+    .supports_schema     = true,
+    .streaming_output    = false,
+    .zero_allocation     = true,  // save_into a buffer that is already large enough
+    .compile_time        = false,
+    .format_name         = "JSON (schema)",
+    .mime_type           = "application/json"
+};
+
+// Field name usable as a template argument
+template <size_t N>
+struct json_key {
+    char text[N] {};
+
+    consteval json_key(const char (&name)[N]) {
+        for(size_t i = 0; i < N; ++i) text[i] = name[i];
+    }
+
+    constexpr std::string_view view() const noexcept { return std::string_view(text, N - 1); }
+};
+
+// Binds the JSON key Name to the data member Member
+template <json_key Name, auto Member>
+    requires std::is_member_object_pointer_v<decltype(Member)>
+struct json_field {
+    static constexpr auto key    = Name;
+    static constexpr auto member = Member;
+};
+
+// The fields of a struct, in output order
+template <typename... Fields>
+struct json_fields {};
+
+// Specialize with `using type = json_fields<...>;` for types that cannot declare a json_schema
+template <typename T>
+struct json_schema_for {};
+
+namespace detail {
+
+template <typename T>
+struct schema_of {};
+
+template <typename T>
+    requires requires { typename T::json_schema; }
+struct schema_of<T> {
+    using type = typename T::json_schema;
+};
+
+template <typename T>
+    requires(!requires { typename T::json_schema; }) && requires { typename json_schema_for<T>::type; }
+struct schema_of<T> {
+    using type = typename json_schema_for<T>::type;
+};
+
+}  // namespace detail
+
+// A type whose JSON layout is described by a schema
+template <typename T>
+concept json_schema_type = std::is_class_v<T> && requires { typename detail::schema_of<T>::type; };
+
+namespace detail {
+
+// Escaped form of a key, as it appears between quotes
+consteval size_t escaped_length(std::string_view key) {
+    size_t length = 0;
+    for(char c : key) {
+        const auto u  = static_cast<unsigned char>(c);
+        length       += (c == '"' || c == '\\') ? 2 : u < 0x20 ? 6 : 1;
+    }
+    return length;
+}
+
+inline constexpr char hex_digits[] = "0123456789abcdef";
+
+// `{"key":` for the first field, `,"key":` after it
+template <json_key Key, bool First>
+struct key_fragment {
+    static constexpr size_t size = escaped_length(Key.view()) + 4;
+
+    static constexpr std::array<char, size> text = [] {
+        std::array<char, size> out {};
+        size_t                 at = 0;
+        out[at++]                 = First ? '{' : ',';
+        out[at++]                 = '"';
+        for(char c : Key.view()) {
+            const auto u = static_cast<unsigned char>(c);
+            if(c == '"' || c == '\\') {
+                out[at++] = '\\';
+                out[at++] = c;
+            } else if(u < 0x20) {
+                out[at++] = '\\';
+                out[at++] = 'u';
+                out[at++] = '0';
+                out[at++] = '0';
+                out[at++] = hex_digits[u >> 4];
+                out[at++] = hex_digits[u & 15];
+            } else {
+                out[at++] = c;
+            }
+        }
+        out[at++] = '"';
+        out[at++] = ':';
+        return out;
+    }();
+};
+
+template <typename T>
+struct is_optional: std::false_type {};
+
+template <typename T>
+struct is_optional<std::optional<T>>: std::true_type {};
+
+template <typename T>
+struct is_sequence: std::false_type {};
+
+template <typename T, typename A>
+struct is_sequence<std::vector<T, A>>: std::true_type {};
+
+template <typename T, size_t N>
+struct is_sequence<std::array<T, N>>: std::true_type {};
+
+template <typename T>
+concept json_string = std::same_as<T, std::string> || std::same_as<T, std::string_view> || std::same_as<T, const char*>;
+
+template <typename T>
+concept json_number = std::is_arithmetic_v<T> && !std::same_as<T, bool> && !std::same_as<T, char>;
+
+template <typename T>
+struct member_type_of;
+
+template <typename C, typename M>
+struct member_type_of<M C::*> {
+    using type = M;
+};
+
+template <typename T>
+constexpr bool writable_value();
+
+template <typename... Fields>
+constexpr bool writable_fields(json_fields<Fields...>*) {
+    return (writable_value<typename member_type_of<std::remove_cv_t<decltype(Fields::member)>>::type>() && ...);
+}
+
+template <typename T>
+constexpr bool writable_value() {
+    if constexpr(std::same_as<T, bool> || json_number<T> || json_string<T>) {
+        return true;
+    } else if constexpr(is_optional<T>::value || is_sequence<T>::value) {
+        return writable_value<typename T::value_type>();
+    } else if constexpr(json_schema_type<T>) {
+        return writable_fields(static_cast<typename schema_of<T>::type*>(nullptr));
+    } else {
+        return false;
+    }
+}
+
+// Widest output of a number type: sign, digits, and for floating point the
+// point and exponent of the shortest round-trip form
+template <typename T>
+constexpr size_t number_width() {
+    if constexpr(std::is_floating_point_v<T>) {
+        return std::numeric_limits<T>::max_digits10 + 8;
+    } else {
+        return std::numeric_limits<T>::digits10 + 3;
+    }
+}
+
+// First byte of [p, p + n) that JSON requires escaped ('"', '\\', < 0x20), or n
+inline size_t find_escape(const char* p, size_t n) noexcept {
+    size_t i = 0;
+#ifdef FORMAT_SERIALIZE_SSE2
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+    for(; i + 16 <= n; i += 16) {
+        const __m128i v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i low  = _mm_cmpeq_epi8(_mm_min_epu8(v, control), v);  // v <= 0x1F
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), low);
+        if(const int mask = _mm_movemask_epi8(hits)) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#endif
+    for(; i < n; ++i) {
+        const auto u = static_cast<unsigned char>(p[i]);
+        if(u == '"' || u == '\\' || u < 0x20) return i;
+    }
+    return n;
+}
+
+// Output cursor over a std::string, which grows, or a fixed span, which
+// fails with capacity_exceeded instead
+class json_writer {
+    std::string* string_ = nullptr;
+    char*        base_   = nullptr;
+    char*        at_     = nullptr;
+    char*        end_    = nullptr;
+    bool         full_   = false;
+
+    static void resize_uninitialized(std::string& s, size_t size) {
+#if defined(__cpp_lib_string_resize_and_overwrite)
+        s.resize_and_overwrite(size, [](char*, size_t n) noexcept { return n; });
+#else
+        s.resize(size);
+#endif
+    }
+
+    bool grow(size_t n) {
+        if(!string_) {
+            full_ = true;
+            return false;
+        }
+        const size_t used = static_cast<size_t>(at_ - base_);
+        const size_t want = std::max(string_->size() * 2, used + n);
+        resize_uninitialized(*string_, want);
+        base_ = string_->data();
+        at_   = base_ + used;
+        end_  = base_ + string_->size();
+        return true;
+    }
+
+    public:
+    // Write after the first offset bytes of out, reserving reserve more
+    json_writer(std::string& out, size_t offset, size_t reserve): string_(&out) {
+        resize_uninitialized(out, offset + reserve);
+        base_ = out.data();
+        at_   = base_ + offset;
+        end_  = base_ + out.size();
+    }
+
+    explicit json_writer(std::span<std::byte> out) noexcept:
+        base_(reinterpret_cast<char*>(out.data())), at_(base_), end_(base_ + out.size()) {}
+
+    // Room for n more bytes
+    bool ensure(size_t n) {
+        if(static_cast<size_t>(end_ - at_) >= n) [[likely]] return true;
+        return !full_ && grow(n);
+    }
+
+    void put(char c) noexcept { *at_++ = c; }
+
+    void put(const char* p, size_t n) noexcept {
+        std::memcpy(at_, p, n);
+        at_ += n;
+    }
+
+    // Bytes that can be written without ensure()
+    size_t room() const noexcept { return static_cast<size_t>(end_ - at_); }
+
+    char* cursor() noexcept { return at_; }
+
+    void advance_to(char* p) noexcept { at_ = p; }
+
+    bool growable() const noexcept { return string_ != nullptr; }
+
+    bool overflowed() const noexcept { return full_; }
+
+    size_t offset() const noexcept { return static_cast<size_t>(at_ - base_); }
+
+    // Trim a growable string to what was written
+    void finish() {
+        if(string_) string_->resize(offset());
+    }
+};
+
+// Control characters with a two-byte escape
+constexpr bool short_escape(unsigned char u) noexcept {
+    return u == '\b' || u == '\f' || u == '\n' || u == '\r' || u == '\t';
+}
+
+inline void write_escaped(json_writer& w, std::string_view s) {
+    size_t clean = find_escape(s.data(), s.size());
+    if(!w.ensure(s.size() + 2)) return;
+    w.put('"');
+    if(clean == s.size()) [[likely]] {
+        w.put(s.data(), s.size());
+        w.put('"');
+        return;
+    }
+    // Escapes take up to 6 bytes; ask for the rest once, or for the exact
+    // length when a fixed span has less than the worst case left
+    const size_t worst = (s.size() - clean) * 6 + 1;
+    if(w.room() < worst && !(w.growable() && w.ensure(worst))) {
+        size_t exact = 1;
+        for(size_t i = clean; i < s.size(); ++i) {
+            const auto u  = static_cast<unsigned char>(s[i]);
+            exact        += u == '"' || u == '\\' ? 2 : u >= 0x20 ? 1 : short_escape(u) ? 2 : 6;
+        }
+        if(!w.ensure(exact)) return;
+    }
+    size_t start = 0;
+    while(clean < s.size()) {
+        w.put(s.data() + start, clean - start);
+        const auto u = static_cast<unsigned char>(s[clean]);
+        w.put('\\');
+        switch(u) {
+        case '"' : w.put('"'); break;
+        case '\\': w.put('\\'); break;
+        case '\b': w.put('b'); break;
+        case '\f': w.put('f'); break;
+        case '\n': w.put('n'); break;
+        case '\r': w.put('r'); break;
+        case '\t': w.put('t'); break;
+        default  :
+            w.put("u00", 3);
+            w.put(hex_digits[u >> 4]);
+            w.put(hex_digits[u & 15]);
+        }
+        start = clean + 1;
+        clean = start + find_escape(s.data() + start, s.size() - start);
+    }
+    w.put(s.data() + start, s.size() - start);
+    w.put('"');
+}
+
+// Formats in place when the widest form fits, else through a stack buffer so
+// a fixed span can be filled to its last byte
+template <typename T>
+void write_number(json_writer& w, T value) {
+    if constexpr(std::is_floating_point_v<T>) {
+        if(!std::isfinite(value)) {
+            if(w.ensure(4)) w.put("null", 4);
+            return;
+        }
+    }
+    constexpr size_t width = number_width<T>();
+    if(w.room() >= width || (w.growable() && w.ensure(width))) [[likely]] {
+        auto [end, ec] = std::to_chars(w.cursor(), w.cursor() + width, value);
+        w.advance_to(ec == std::errc {} ? end : w.cursor());
+        return;
+    }
+    char buffer[width];
+    auto [end, ec] = std::to_chars(buffer, buffer + width, value);
+    const size_t length = ec == std::errc {} ? static_cast<size_t>(end - buffer) : 0;
+    if(w.ensure(length)) w.put(buffer, length);
+}
+
+template <typename T>
+void write_value(json_writer& w, const T& value);
+
+template <typename T, typename... Fields>
+void write_object(json_writer& w, const T& value, json_fields<Fields...>*) {
+    if constexpr(sizeof...(Fields) == 0) {
+        if(w.ensure(2)) w.put("{}", 2);
+    } else {
+        size_t index = 0;
+        auto   field = [&]<typename F>(F*) {
+            const bool first = index++ == 0;
+            const auto& text = first ? key_fragment<F::key, true>::text : key_fragment<F::key, false>::text;
+            if(!w.ensure(text.size())) return;
+            w.put(text.data(), text.size());
+            write_value(w, value.*F::member);
+        };
+        (field(static_cast<Fields*>(nullptr)), ...);
+        if(w.ensure(1)) w.put('}');
+    }
+}
+
+template <typename T>
+void write_value(json_writer& w, const T& value) {
+    if constexpr(std::same_as<T, bool>) {
+        if(w.ensure(value ? 4 : 5)) value ? w.put("true", 4) : w.put("false", 5);
+    } else if constexpr(json_number<T>) {
+        write_number(w, value);
+    } else if constexpr(std::same_as<T, const char*>) {
+        if(value) {
+            write_escaped(w, std::string_view(value));
+        } else if(w.ensure(4)) {
+            w.put("null", 4);
+        }
+    } else if constexpr(json_string<T>) {
+        write_escaped(w, std::string_view(value));
+    } else if constexpr(is_optional<T>::value) {
+        if(value) {
+            write_value(w, *value);
+        } else if(w.ensure(4)) {
+            w.put("null", 4);
+        }
+    } else if constexpr(is_sequence<T>::value) {
+        if(!w.ensure(1)) return;
+        w.put('[');
+        bool first = true;
+        for(const auto& item : value) {
+            if(!first) {
+                if(!w.ensure(1)) return;
+                w.put(',');
+            }
+            first = false;
+            write_value(w, item);
+        }
+        if(w.ensure(1)) w.put(']');
+    } else {
+        write_object(w, value, static_cast<typename schema_of<T>::type*>(nullptr));
+    }
+}
+
+template <typename T>
+size_t size_hint(const T& value);
+
+template <typename T, typename... Fields>
+size_t object_size_hint(const T& value, json_fields<Fields...>*) {
+    constexpr size_t fixed = (key_fragment<Fields::key, false>::size + ... + 2);
+    return fixed + (size_hint(value.*Fields::member) + ... + 0);
+}
+
+// Output length when no string needs escaping (an upper bound for numbers)
+template <typename T>
+size_t size_hint(const T& value) {
+    if constexpr(std::same_as<T, bool>) {
+        return 5;
+    } else if constexpr(json_number<T>) {
+        return number_width<T>();
+    } else if constexpr(std::same_as<T, const char*>) {
+        return value ? std::strlen(value) + 2 : 4;
+    } else if constexpr(json_string<T>) {
+        return value.size() + 2;
+    } else if constexpr(is_optional<T>::value) {
+        return value ? size_hint(*value) : 4;
+    } else if constexpr(is_sequence<T>::value) {
+        using item = typename T::value_type;
+        if constexpr(std::same_as<item, bool> || json_number<item>) {
+            return 2 + value.size() * (size_hint(item {}) + 1);
+        } else {
+            size_t total = 2 + value.size();
+            for(const auto& x : value) total += size_hint(x);
+            return total;
+        }
+    } else {
+        return object_size_hint(value, static_cast<typename schema_of<T>::type*>(nullptr));
+    }
+}
+
+}  // namespace detail
+
+// A schema type whose every member can be written
+template <typename T>
+concept json_schema_writable = json_schema_type<T> && detail::writable_value<T>();
+
+template <json_schema_writable T>
+auto save_into_impl(T const& obj, std::string& out, json_tag, write_mode mode) -> result<size_t> {
+    const size_t        offset = mode == write_mode::append ? out.size() : 0;
+    detail::json_writer writer(out, offset, detail::size_hint(obj));
+    detail::write_value(writer, obj);
+    writer.finish();
+    return result<size_t>(out.size() - offset);
+}
+
+template <json_schema_writable T>
+auto save_into_impl(T const& obj, std::span<std::byte> out, json_tag) -> result<size_t> {
+    detail::json_writer writer(out);
+    detail::write_value(writer, obj);
+    if(writer.overflowed()) return result<size_t>(unexpect, error::capacity_exceeded);
+    return result<size_t>(writer.offset());
+}
+
+template <json_schema_writable T>
+auto save_impl(T const& obj, json_tag tag) -> result<std::string> {
+    std::string out;
+    auto        saved = save_into_impl(obj, out, tag, write_mode::overwrite);
+    if(!saved) return result<std::string>(unexpect, saved.error());
+    return result<std::string>(std::move(out));
+}
+
+}  // namespace format::serialize
+
+#endif  // FORMAT_SERIALIZE_JSON_SCHEMA_HPP
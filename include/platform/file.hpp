@@ -20,6 +20,9 @@ struct file_error;
 struct file_info;
 struct io_request;
 struct io_result;
+struct ring_handle;
+struct ring_request;
+struct io_completion;
 
 // Result type templates for consistent error handling
 template <typename T>
@@ -52,6 +55,7 @@ enum class error_code : uint16_t {
     broken_pipe       = 14,
     would_block       = 15,
     interrupted       = 16,
+    timed_out         = 17,
     not_supported     = 200,
     platform_specific = 201
 };
@@ -165,6 +169,17 @@ struct file_info {
     uint8_t   reserved[3];  // Padding
 };
 
+// Directory entry parsed from a read_directory() fill (32 bytes)
+// name points into the fill buffer and is NUL-terminated
+struct dir_entry {
+    uint64_t         inode;        // Inode number
+    std::string_view name;         // Entry name, without the directory
+    file_type        type;         // file_type::unknown when the filesystem does not report it
+    uint8_t          reserved[7];  // Padding
+
+    constexpr dir_entry() noexcept: inode(0), name(), type(file_type::unknown), reserved {} {}
+};
+
 // Flattened file open request (16 bytes)
 struct file_request {
     access_mode access;        // Access mode flags
@@ -183,18 +198,18 @@ struct file_request {
 
 // Flattened I/O request (32 bytes)
 struct io_request {
-    void*    buffer;    // Data buffer
-    uint64_t offset;    // File offset (-1 for current position)
-    size_t   length;    // Bytes to read/write
-    uint32_t flags;     // Platform-specific flags
-    uint32_t reserved;  // Padding
+    void*    buffer;        // Data buffer
+    uint64_t offset;        // File offset (-1 for current position)
+    size_t   length;        // Bytes to read/write
+    uint32_t flags;         // Platform-specific flags (RWF_* on Linux)
+    uint32_t buffer_index;  // Registered buffer index (ring_op::read_fixed/write_fixed)
 
     constexpr io_request() noexcept:
         buffer(nullptr),
         offset(static_cast<uint64_t>(-1)),
         length(0),
         flags(0),
-        reserved(0) {}
+        buffer_index(0) {}
 };
 
 // Flattened I/O result (16 bytes)
@@ -259,6 +274,93 @@ struct file_caps {
         reserved {} {}
 };
 
+// splice/vmsplice flags (values match Linux SPLICE_F_*)
+namespace splice_flag {
+constexpr uint32_t move     = 0x01;  // Move pages instead of copying
+constexpr uint32_t nonblock = 0x02;  // Don't block on pipe I/O
+constexpr uint32_t more     = 0x04;  // More data follows (socket corking hint)
+constexpr uint32_t gift     = 0x08;  // vmsplice: pages are gifted to the kernel
+}  // namespace splice_flag
+
+// Asynchronous I/O ring operations
+enum class ring_op : uint8_t {
+    nop         = 0,  // No operation (completes immediately)
+    read        = 1,  // Read into io_request::buffer (pread semantics when offset is set)
+    write       = 2,  // Write from io_request::buffer (pwrite semantics when offset is set)
+    sync        = 3,  // Flush file after all earlier requests complete (io_request::flags holds sync_flags)
+    read_fixed  = 4,  // read into a registered buffer (io_request::buffer_index)
+    write_fixed = 5,  // write from a registered buffer (io_request::buffer_index)
+    cancel      = 6   // Cancel the in-flight request whose user_data is io_request::offset
+};
+
+// Flattened ring setup request (16 bytes)
+struct ring_request {
+    uint32_t entries;       // Submission queue depth (rounded up to a power of two)
+    uint32_t cq_entries;    // Completion queue depth (0 = twice the submission depth)
+    uint32_t native_flags;  // Platform-specific setup flags (IORING_SETUP_*)
+    uint32_t reserved;      // Padding
+
+    constexpr ring_request() noexcept: entries(256), cq_entries(0), native_flags(0), reserved(0) {}
+
+    constexpr ring_request(uint32_t e) noexcept: entries(e), cq_entries(0), native_flags(0), reserved(0) {}
+};
+
+// Flattened ring handle (16 bytes)
+// The state pointer is owned by the platform implementation and released by destroy_ring()
+struct ring_handle {
+    void*    state;       // Platform-specific ring state
+    uint32_t entries;     // Submission queue depth
+    uint32_t cq_entries;  // Completion queue depth (upper bound on requests in flight)
+
+    constexpr ring_handle() noexcept: state(nullptr), entries(0), cq_entries(0) {}
+
+    constexpr bool is_valid() const noexcept { return state != nullptr; }
+
+    constexpr explicit operator bool() const noexcept { return is_valid(); }
+};
+
+// Buffer registered with a ring for fixed-buffer I/O (16 bytes)
+struct ring_buffer {
+    void*  address;  // Buffer start
+    size_t length;   // Buffer length in bytes
+
+    constexpr ring_buffer() noexcept: address(nullptr), length(0) {}
+
+    constexpr ring_buffer(void* a, size_t l) noexcept: address(a), length(l) {}
+};
+
+// Direct I/O alignment requirements (8 bytes)
+struct dio_alignment {
+    uint32_t memory_align;  // Required buffer address/length alignment
+    uint32_t offset_align;  // Required file offset alignment (logical block size)
+
+    constexpr dio_alignment() noexcept: memory_align(0), offset_align(0) {}
+
+    constexpr dio_alignment(uint32_t m, uint32_t o) noexcept: memory_align(m), offset_align(o) {}
+};
+
+// Flattened ring status snapshot (16 bytes)
+struct ring_status {
+    uint32_t queued;      // Prepared but not yet submitted to the kernel
+    uint32_t in_flight;   // Queued or submitted and not yet reaped
+    uint32_t entries;     // Submission queue depth
+    uint32_t cq_entries;  // Completion queue depth
+
+    constexpr ring_status() noexcept: queued(0), in_flight(0), entries(0), cq_entries(0) {}
+};
+
+// Flattened I/O completion (32 bytes)
+// result.new_offset is offset + bytes_transferred for positional requests and 0
+// for current-position requests (no lseek on the completion path)
+struct io_completion {
+    uint64_t   user_data;  // Caller tag supplied at queue time
+    io_result  result;     // Transfer result (valid when error.code == success)
+    file_error error;      // Completion error
+    uint32_t   reserved;   // Padding
+
+    constexpr io_completion() noexcept: user_data(0), result(), error(), reserved(0) {}
+};
+
 // Platform interface functions
 
 // File operations
@@ -271,9 +373,36 @@ expected<file_info, file_error> stat_file(const file_handle& handle) noexcept;
 expected<file_info, file_error> stat_path(const char* path, bool follow_symlinks = true) noexcept;
 expected<uint64_t, file_error>  get_file_size(const file_handle& handle) noexcept;
 
+// Directory listing
+// read_directory() fills buffer with raw entries (getdents64 on Linux) and
+// returns the bytes filled, 0 at the end; next_directory_entry() walks one fill,
+// advancing offset. Every entry is returned, "." and ".." included. Buffers of
+// tens of KiB or more list most directories in one call
+expected<file_handle, file_error> open_directory(const char* path) noexcept;
+expected<size_t, file_error>      read_directory(const file_handle& dir, void* buffer, size_t size) noexcept;
+bool next_directory_entry(const void* buffer, size_t filled, size_t& offset, dir_entry& entry) noexcept;
+
+// Stat count names relative to dir without following symlinks. infos[i] or
+// errors[i] receives each outcome and the return value is how many succeeded.
+// With an idle ring the statx calls go to the kernel together, one submission
+// per ring's worth; without one, or on kernels lacking IORING_OP_STATX, each
+// name is a plain statx
+expected<size_t, file_error> stat_batch(
+  const file_handle& dir,
+  const char* const* names,
+  size_t             count,
+  file_info*         infos,
+  file_error*        errors,
+  ring_handle*       ring = nullptr) noexcept;
+
 // I/O operations
 expected<io_result, file_error> read_file(const file_handle& handle, const io_request& request) noexcept;
 expected<io_result, file_error> write_file(const file_handle& handle, const io_request& request) noexcept;
+
+// Scatter/gather I/O. Each request's offset is honored: file-contiguous requests are
+// coalesced into one positional call (chunked at IOV_MAX), offset -1 uses the file
+// position. result.new_offset is the end of the last positional transfer. An error
+// after some bytes moved returns those bytes; resubmitting the rest reports the error.
 expected<io_result, file_error>
   read_vectored(const file_handle& handle, const io_request* requests, size_t count) noexcept;
 expected<io_result, file_error>
@@ -300,6 +429,9 @@ expected<file_lock, file_error> test_lock(const file_handle& handle, const file_
 // File advice
 expected<void, file_error>
   advise_file(const file_handle& handle, uint64_t offset, uint64_t length, file_advice advice) noexcept;
+// Start reading [offset, offset + length) into the page cache without waiting.
+// Uses readahead(2), falling back to will_need advice where it is refused.
+expected<void, file_error> readahead_file(const file_handle& handle, uint64_t offset, uint64_t length) noexcept;
 
 // Zero-copy operations (Linux specific)
 expected<size_t, file_error> splice_files(
@@ -312,6 +444,72 @@ expected<size_t, file_error> splice_files(
 expected<size_t, file_error>
   sendfile_op(const file_handle& out, const file_handle& in, uint64_t* offset, size_t count) noexcept;
 
+// In-kernel copy between regular files (copy_file_range on Linux).
+// Unsupported file pairs fail with error_domain::feature / not_supported
+expected<size_t, file_error> copy_file_range_op(
+  const file_handle& in,
+  uint64_t*          in_offset,
+  const file_handle& out,
+  uint64_t*          out_offset,
+  size_t             length) noexcept;
+
+// Pipes for splice-based streaming
+expected<void, file_error>   create_pipe(file_handle& read_end, file_handle& write_end) noexcept;
+expected<size_t, file_error> set_pipe_size(const file_handle& pipe, size_t size) noexcept;  // Returns actual size
+
+// Anonymous memory-backed file of size bytes (memfd on Linux), close-on-exec;
+// map it shared to see bytes spliced into it, or pass the descriptor to another process
+expected<file_handle, file_error> create_memory_file(const char* name, uint64_t size) noexcept;
+
+// Map user pages into a pipe (vmsplice on Linux); pages must stay unmodified until
+// the pipe is drained and, when spliced on to a socket, until the data is acknowledged
+expected<size_t, file_error>
+  vmsplice_op(const file_handle& pipe, const void* data, size_t length, uint32_t flags) noexcept;
+
+// Block until the handle is readable/writable or timeout_ms elapses (-1 = forever).
+// Returns false on timeout
+expected<bool, file_error> wait_ready(const file_handle& handle, bool writable, int timeout_ms = -1) noexcept;
+
+// Asynchronous I/O ring (io_uring on Linux)
+// Requests are queued locally, handed to the kernel in one call by submit_ring(),
+// and their results are collected with reap_ring()
+expected<ring_handle, file_error> create_ring(const ring_request& request) noexcept;
+void                              destroy_ring(ring_handle& ring) noexcept;
+ring_status                       query_ring(const ring_handle& ring) noexcept;
+
+// Queue count requests of one operation; request i completes with user_data + i.
+// Returns the number queued, which is less than count when the ring is full.
+// A read or write longer than UINT32_MAX bytes fails with invalid_argument and
+// nothing is queued; split it across requests.
+expected<size_t, file_error> queue_ring(
+  ring_handle&       ring,
+  const file_handle& handle,
+  ring_op            op,
+  const io_request*  requests,
+  size_t             count,
+  uint64_t           user_data) noexcept;
+
+// Register buffers for ring_op::read_fixed/write_fixed; buffer i has index i.
+// The kernel pins the pages for the lifetime of the registration
+expected<void, file_error> register_ring_buffers(ring_handle& ring, const ring_buffer* buffers, size_t count) noexcept;
+expected<void, file_error> unregister_ring_buffers(ring_handle& ring) noexcept;
+
+// Signal an eventfd whenever the ring posts a completion, so a readiness
+// reactor can wait for ring completions alongside other descriptors
+expected<void, file_error> register_ring_eventfd(ring_handle& ring, int32_t fd) noexcept;
+
+// Submit all queued requests, optionally blocking until wait_for completions are ready
+expected<size_t, file_error> submit_ring(ring_handle& ring, size_t wait_for = 0) noexcept;
+
+// Collect up to max_count completions, blocking until at least min_count are available;
+// min_count is capped at what is queued or in flight, so it cannot wait forever
+expected<size_t, file_error>
+  reap_ring(ring_handle& ring, io_completion* completions, size_t max_count, size_t min_count = 0) noexcept;
+
+// Direct I/O alignment for a file (statx STATX_DIOALIGN, block device sector size,
+// or page size as a conservative fallback)
+expected<dio_alignment, file_error> query_dio_alignment(const file_handle& handle) noexcept;
+
 // Capability query
 file_caps query_file_caps() noexcept;
 
@@ -5,19 +5,35 @@
 
 // Platform-specific includes
 #ifdef __linux__
+#include <cstddef>
 #include <cstring>
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
 #include <sys/stat.h>
+#include <sys/sysmacros.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
 // Linux-specific headers
+#include <linux/fs.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/ioctl.h>
 #include <sys/sendfile.h>
 #include <sys/syscall.h>
 
+// io_uring (raw syscalls, no liburing dependency)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <atomic>
+#include <linux/io_uring.h>
+#include <new>
+#include <sys/mman.h>
+#define PLATFORM_FILE_HAS_IO_URING 1
+#endif
+
 namespace platform::file::linux_impl {
 
 // Import expected types for cleaner usage
@@ -101,6 +117,18 @@ constexpr int to_seek_whence(seek_origin origin) noexcept {
     }
 }
 
+// Convert st_mode file type bits to file_type
+constexpr file_type mode_to_type(uint32_t mode) noexcept {
+    if(S_ISREG(mode)) return file_type::regular;
+    if(S_ISDIR(mode)) return file_type::directory;
+    if(S_ISLNK(mode)) return file_type::symlink;
+    if(S_ISBLK(mode)) return file_type::block;
+    if(S_ISCHR(mode)) return file_type::character;
+    if(S_ISFIFO(mode)) return file_type::fifo;
+    if(S_ISSOCK(mode)) return file_type::socket;
+    return file_type::unknown;
+}
+
 // Convert stat structure to file_info
 inline file_info stat_to_info(const struct stat& st) noexcept {
     file_info info {};
@@ -116,19 +144,56 @@ inline file_info stat_to_info(const struct stat& st) noexcept {
     info.gid       = st.st_gid;
     info.nlink     = st.st_nlink;
 
-    // Determine file type
-    if(S_ISREG(st.st_mode)) info.type = file_type::regular;
-    else if(S_ISDIR(st.st_mode)) info.type = file_type::directory;
-    else if(S_ISLNK(st.st_mode)) info.type = file_type::symlink;
-    else if(S_ISBLK(st.st_mode)) info.type = file_type::block;
-    else if(S_ISCHR(st.st_mode)) info.type = file_type::character;
-    else if(S_ISFIFO(st.st_mode)) info.type = file_type::fifo;
-    else if(S_ISSOCK(st.st_mode)) info.type = file_type::socket;
-    else info.type = file_type::unknown;
+    info.type      = mode_to_type(st.st_mode);
+    return info;
+}
 
+// Convert statx result (STATX_BASIC_STATS) to file_info
+inline file_info statx_to_info(const struct statx& stx) noexcept {
+    file_info info {};
+    info.size      = stx.stx_size;
+    info.blocks    = stx.stx_blocks;
+    info.inode     = stx.stx_ino;
+    info.device    = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    info.atime_sec = stx.stx_atime.tv_sec;
+    info.mtime_sec = stx.stx_mtime.tv_sec;
+    info.ctime_sec = stx.stx_ctime.tv_sec;
+    info.mode      = stx.stx_mode;
+    info.uid       = stx.stx_uid;
+    info.gid       = stx.stx_gid;
+    info.nlink     = stx.stx_nlink;
+    info.type      = mode_to_type(stx.stx_mode);
     return info;
 }
 
+// Convert DT_* directory entry types to file_type
+constexpr file_type dirent_to_type(unsigned char type) noexcept {
+    switch(type) {
+    case DT_REG : return file_type::regular;
+    case DT_DIR : return file_type::directory;
+    case DT_LNK : return file_type::symlink;
+    case DT_BLK : return file_type::block;
+    case DT_CHR : return file_type::character;
+    case DT_FIFO: return file_type::fifo;
+    case DT_SOCK: return file_type::socket;
+    default     : return file_type::unknown;
+    }
+}
+
+// lstat semantics, basic fields only; automount points are not triggered
+constexpr int      statx_flags = AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT;
+constexpr unsigned statx_mask  = STATX_BASIC_STATS;
+
+inline bool statx_one(int dir_fd, const char* name, file_info& info, file_error& error) noexcept {
+    struct statx stx {};
+    if(::statx(dir_fd, name, statx_flags, statx_mask, &stx) == 0) {
+        info = statx_to_info(stx);
+        return true;
+    }
+    error = make_system_error(errno);
+    return false;
+}
+
 // Convert lock_type to F_* constants
 constexpr short to_lock_type(lock_type type) noexcept {
     switch(type) {
@@ -164,6 +229,173 @@ constexpr int to_fadvise_advice(file_advice advice) noexcept {
     }
 }
 
+// Vectored transfer shared by read_vectored/write_vectored.
+// Consecutive requests are coalesced into one preadv2/pwritev2 call while they are
+// file-contiguous, share the same RWF_* flags and fit in IOV_MAX; a discontinuity
+// starts a new call. Requests with offset -1 use (and advance) the file position.
+// EINTR is retried. Stops at the first short transfer. An error after partial
+// progress returns the bytes transferred so far and attempts nothing further, so
+// the caller resubmits the remaining requests and that call reports the error.
+inline expected<io_result, file_error>
+  transfer_vectored(const file_handle& handle, const io_request* requests, size_t count, bool write) noexcept {
+    constexpr uint64_t current_position = static_cast<uint64_t>(-1);
+
+    if(count > 0 && !requests) {
+        return expected<io_result, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    struct iovec iov[IOV_MAX];
+    size_t       total      = 0;
+    uint64_t     end_offset = 0;
+    bool         positional = false;
+
+    for(size_t base = 0; base < count;) {
+        const uint64_t offset = requests[base].offset;
+        const uint32_t flags  = requests[base].flags;
+
+        // Gather a file-contiguous run
+        size_t   n            = 0;
+        size_t   expected_len = 0;
+        uint64_t next         = offset;
+        while(base + n < count && n < IOV_MAX) {
+            const io_request& req = requests[base + n];
+            if(req.flags != flags) break;
+            if(offset == current_position ? req.offset != current_position : req.offset != next) break;
+            iov[n].iov_base  = req.buffer;
+            iov[n].iov_len   = req.length;
+            expected_len    += req.length;
+            if(offset != current_position) next += req.length;
+            ++n;
+        }
+
+        const off_t pos    = offset == current_position ? -1 : static_cast<off_t>(offset);
+        const int   iovcnt = static_cast<int>(n);
+        ssize_t     result;
+        do {
+            if(flags == 0) {
+                // Plain readv/preadv keep working on kernels without the *v2 variants
+                if(pos < 0) {
+                    result = write ? ::writev(handle.fd, iov, iovcnt) : ::readv(handle.fd, iov, iovcnt);
+                } else {
+                    result = write ? ::pwritev(handle.fd, iov, iovcnt, pos) : ::preadv(handle.fd, iov, iovcnt, pos);
+                }
+            } else {
+                result = write ? ::pwritev2(handle.fd, iov, iovcnt, pos, static_cast<int>(flags))
+                               : ::preadv2(handle.fd, iov, iovcnt, pos, static_cast<int>(flags));
+            }
+        } while(result < 0 && errno == EINTR);
+
+        if(result < 0) {
+            if(total == 0) { return expected<io_result, file_error>(unexpect, make_system_error(errno)); }
+            break;  // Report the progress; the failing run is retried, and fails, on the next call
+        }
+
+        total += static_cast<size_t>(result);
+        if(pos >= 0) {
+            positional = true;
+            end_offset = offset + static_cast<uint64_t>(result);
+        } else {
+            positional = false;
+        }
+
+        base += n;
+        if(static_cast<size_t>(result) < expected_len) break;
+    }
+
+    // Positional runs report the end offset directly; only a trailing
+    // current-position run needs the file position queried
+    if(!positional && count > 0) {
+        off_t new_pos = ::lseek(handle.fd, 0, SEEK_CUR);
+        end_offset    = new_pos < 0 ? 0 : static_cast<uint64_t>(new_pos);
+    }
+
+    return expected<io_result, file_error>(io_result(total, end_offset));
+}
+
+#ifdef PLATFORM_FILE_HAS_IO_URING
+// io_uring ring state - mapped SQ/CQ rings plus a slot table that remembers
+// the caller tag and file offset of every request in flight
+struct ring_state {
+    int fd;
+
+    // Submission queue
+    void*         sq_ptr;
+    size_t        sq_size;
+    io_uring_sqe* sqes;
+    size_t        sqes_size;
+    uint32_t*     sq_head;
+    uint32_t*     sq_tail;
+    uint32_t*     sq_array;
+    uint32_t      sq_mask;
+    uint32_t      sq_entries;
+
+    // Completion queue
+    void*         cq_ptr;
+    size_t        cq_size;
+    io_uring_cqe* cqes;
+    uint32_t*     cq_head;
+    uint32_t*     cq_tail;
+    uint32_t      cq_mask;
+    uint32_t      cq_entries;
+
+    // Local bookkeeping
+    uint32_t  queued;      // SQEs published to the ring but not yet entered
+    uint32_t  free_count;  // Unused slots
+    uint64_t* slot_user_data;
+    uint64_t* slot_offset;
+    uint32_t* free_slots;
+};
+
+// Kernel limit on buffers registered with IORING_REGISTER_BUFFERS
+constexpr size_t max_registered_buffers = 1u << 14;
+
+// slot_user_data of a slot with no request in flight
+constexpr uint64_t free_slot_data = ~uint64_t { 0 };
+
+// Slot of the in-flight request queued with user_data (cq_entries when none is);
+// only cancels search, so a linear scan over the slots is fine
+inline uint32_t find_slot(const ring_state& state, uint64_t user_data) noexcept {
+    if(user_data == free_slot_data) return state.cq_entries;
+    uint32_t slot = 0;
+    while(slot < state.cq_entries && state.slot_user_data[slot] != user_data) ++slot;
+    return slot;
+}
+
+inline int ring_setup(uint32_t entries, io_uring_params* params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int ring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+inline uint32_t load_acquire(uint32_t* p) noexcept {
+    return std::atomic_ref<uint32_t>(*p).load(std::memory_order_acquire);
+}
+
+inline void store_release(uint32_t* p, uint32_t v) noexcept {
+    std::atomic_ref<uint32_t>(*p).store(v, std::memory_order_release);
+}
+
+inline void release_ring_state(ring_state* state) noexcept {
+    if(state->sqes) ::munmap(state->sqes, state->sqes_size);
+    if(state->cq_ptr && state->cq_ptr != state->sq_ptr) ::munmap(state->cq_ptr, state->cq_size);
+    if(state->sq_ptr) ::munmap(state->sq_ptr, state->sq_size);
+    if(state->fd >= 0) ::close(state->fd);
+    ::operator delete(state->slot_user_data, std::nothrow);
+    ::operator delete(state, std::nothrow);
+}
+
+inline bool ring_available() noexcept {
+    io_uring_params params {};
+    int             fd = ring_setup(1, &params);
+    if(fd < 0) return false;
+    ::close(fd);
+    // IORING_OP_READ/WRITE arrived together with current-position support (5.6)
+    return (params.features & IORING_FEAT_RW_CUR_POS) != 0;
+}
+#endif
+
 }  // namespace detail
 
 // Linux implementation functions
@@ -225,6 +457,35 @@ inline expected<uint64_t, file_error> get_file_size_impl(const file_handle& hand
     return expected<uint64_t, file_error>(st.st_size);
 }
 
+inline expected<file_handle, file_error> open_directory_impl(const char* path) noexcept {
+    int fd = ::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(fd < 0) { return expected<file_handle, file_error>(unexpect, detail::make_system_error(errno)); }
+    return expected<file_handle, file_error>(file_handle(fd, O_RDONLY | O_DIRECTORY));
+}
+
+inline expected<size_t, file_error> read_directory_impl(const file_handle& dir, void* buffer, size_t size) noexcept {
+    for(;;) {
+        long filled = ::syscall(SYS_getdents64, dir.fd, buffer, size);
+        if(filled >= 0) return expected<size_t, file_error>(static_cast<size_t>(filled));
+        if(errno != EINTR) return expected<size_t, file_error>(unexpect, detail::make_system_error(errno));
+    }
+}
+
+inline bool next_directory_entry_impl(const void* buffer, size_t filled, size_t& offset, dir_entry& entry) noexcept {
+    constexpr size_t name_at = offsetof(struct dirent64, d_name);
+    if(!buffer || offset + name_at >= filled) return false;
+
+    // getdents64 records have the layout of struct dirent64, sized by d_reclen
+    const char* record = static_cast<const char*>(buffer) + offset;
+    const auto* head   = reinterpret_cast<const struct dirent64*>(record);
+    const char* name   = record + name_at;
+    entry.inode        = head->d_ino;
+    entry.type         = detail::dirent_to_type(head->d_type);
+    entry.name         = std::string_view(name, ::strnlen(name, head->d_reclen - name_at));
+    offset            += head->d_reclen;
+    return true;
+}
+
 inline expected<io_result, file_error> read_file_impl(const file_handle& handle, const io_request& request) noexcept {
     ssize_t result;
 
@@ -267,40 +528,12 @@ inline expected<io_result, file_error> write_file_impl(const file_handle& handle
 
 inline expected<io_result, file_error>
   read_vectored_impl(const file_handle& handle, const io_request* requests, size_t count) noexcept {
-    if(count > IOV_MAX) { return expected<io_result, file_error>(unexpect, file_error(error_code::invalid_argument)); }
-
-    struct iovec iov[IOV_MAX];
-    for(size_t i = 0; i < count; ++i) {
-        iov[i].iov_base = requests[i].buffer;
-        iov[i].iov_len  = requests[i].length;
-    }
-
-    ssize_t result = ::readv(handle.fd, iov, count);
-    if(result < 0) { return expected<io_result, file_error>(unexpect, detail::make_system_error(errno)); }
-
-    off_t new_pos = ::lseek(handle.fd, 0, SEEK_CUR);
-    if(new_pos < 0) new_pos = 0;
-
-    return expected<io_result, file_error>(io_result(result, new_pos));
+    return detail::transfer_vectored(handle, requests, count, false);
 }
 
 inline expected<io_result, file_error>
   write_vectored_impl(const file_handle& handle, const io_request* requests, size_t count) noexcept {
-    if(count > IOV_MAX) { return expected<io_result, file_error>(unexpect, file_error(error_code::invalid_argument)); }
-
-    struct iovec iov[IOV_MAX];
-    for(size_t i = 0; i < count; ++i) {
-        iov[i].iov_base = requests[i].buffer;
-        iov[i].iov_len  = requests[i].length;
-    }
-
-    ssize_t result = ::writev(handle.fd, iov, count);
-    if(result < 0) { return expected<io_result, file_error>(unexpect, detail::make_system_error(errno)); }
-
-    off_t new_pos = ::lseek(handle.fd, 0, SEEK_CUR);
-    if(new_pos < 0) new_pos = 0;
-
-    return expected<io_result, file_error>(io_result(result, new_pos));
+    return detail::transfer_vectored(handle, requests, count, true);
 }
 
 inline expected<uint64_t, file_error>
@@ -426,6 +659,16 @@ inline expected<void, file_error>
 #endif
 }
 
+inline expected<void, file_error>
+  readahead_file_impl(const file_handle& handle, uint64_t offset, uint64_t length) noexcept {
+#ifdef __linux__
+    if(::readahead(handle.fd, static_cast<off64_t>(offset), length) == 0) return expected<void, file_error>();
+    if(errno != EINVAL) return expected<void, file_error>(unexpect, detail::make_system_error(errno));
+    // EINVAL: not a regular file or the filesystem has no readahead; advice may still apply
+#endif
+    return advise_file_impl(handle, offset, length, file_advice::will_need);
+}
+
 inline expected<size_t, file_error> splice_files_impl(
   const file_handle& in,
   uint64_t*          in_offset,
@@ -468,12 +711,574 @@ inline expected<size_t, file_error>
 #endif
 }
 
+inline expected<size_t, file_error> copy_file_range_impl(
+  const file_handle& in,
+  uint64_t*          in_offset,
+  const file_handle& out,
+  uint64_t*          out_offset,
+  size_t             length) noexcept {
+    loff_t in_off  = in_offset ? *in_offset : 0;
+    loff_t out_off = out_offset ? *out_offset : 0;
+
+    ssize_t result =
+      ::copy_file_range(in.fd, in_offset ? &in_off : nullptr, out.fd, out_offset ? &out_off : nullptr, length, 0);
+
+    if(result < 0) {
+        // File pairs the kernel cannot copy (cross-filesystem, special files) report
+        // not_supported so callers know to fall back to splice or read/write
+        int err = errno;
+        if(err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == ENOSYS) {
+            return expected<size_t, file_error>(
+              unexpect,
+              file_error(error_domain::feature, error_code::not_supported, static_cast<uint8_t>(err)));
+        }
+        return expected<size_t, file_error>(unexpect, detail::make_system_error(err));
+    }
+
+    if(in_offset) *in_offset = in_off;
+    if(out_offset) *out_offset = out_off;
+
+    return expected<size_t, file_error>(result);
+}
+
+inline expected<void, file_error> create_pipe_impl(file_handle& read_end, file_handle& write_end) noexcept {
+    int fds[2];
+    if(::pipe2(fds, O_CLOEXEC) < 0) { return expected<void, file_error>(unexpect, detail::make_system_error(errno)); }
+    read_end  = file_handle(fds[0], O_RDONLY);
+    write_end = file_handle(fds[1], O_WRONLY);
+    return expected<void, file_error>();
+}
+
+inline expected<size_t, file_error> set_pipe_size_impl(const file_handle& pipe, size_t size) noexcept {
+#ifdef F_SETPIPE_SZ
+    int result = ::fcntl(pipe.fd, F_SETPIPE_SZ, static_cast<int>(size));
+    if(result < 0) { return expected<size_t, file_error>(unexpect, detail::make_system_error(errno)); }
+    return expected<size_t, file_error>(static_cast<size_t>(result));
+#else
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<file_handle, file_error> create_memory_file_impl(const char* name, uint64_t size) noexcept {
+    int fd = ::memfd_create(name ? name : "asyncle", MFD_CLOEXEC);
+    if(fd < 0) { return expected<file_handle, file_error>(unexpect, detail::make_system_error(errno)); }
+    if(::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        int err = errno;
+        ::close(fd);
+        return expected<file_handle, file_error>(unexpect, detail::make_system_error(err));
+    }
+    return expected<file_handle, file_error>(file_handle(fd, O_RDWR));
+}
+
+inline expected<size_t, file_error>
+  vmsplice_op_impl(const file_handle& pipe, const void* data, size_t length, uint32_t flags) noexcept {
+    struct iovec iov;
+    iov.iov_base = const_cast<void*>(data);
+    iov.iov_len  = length;
+
+    ssize_t result = ::vmsplice(pipe.fd, &iov, 1, flags);
+    if(result < 0) { return expected<size_t, file_error>(unexpect, detail::make_system_error(errno)); }
+    return expected<size_t, file_error>(result);
+}
+
+inline expected<bool, file_error> wait_ready_impl(const file_handle& handle, bool writable, int timeout_ms) noexcept {
+    struct pollfd pfd;
+    pfd.fd      = handle.fd;
+    pfd.events  = writable ? POLLOUT : POLLIN;
+    pfd.revents = 0;
+
+    int result;
+    do { result = ::poll(&pfd, 1, timeout_ms); } while(result < 0 && errno == EINTR);
+
+    if(result < 0) { return expected<bool, file_error>(unexpect, detail::make_system_error(errno)); }
+    return expected<bool, file_error>(result > 0);
+}
+
+inline expected<ring_handle, file_error> create_ring_impl(const ring_request& request) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(request.entries == 0) {
+        return expected<ring_handle, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    io_uring_params params {};
+    params.flags = request.native_flags;
+    if(request.cq_entries != 0) {
+        params.flags      |= IORING_SETUP_CQSIZE;
+        params.cq_entries  = request.cq_entries;
+    }
+
+    int fd = detail::ring_setup(request.entries, &params);
+    if(fd < 0) { return expected<ring_handle, file_error>(unexpect, detail::make_system_error(errno)); }
+
+    // Slot arrays (user data, offset, free stack) share one allocation sized to the CQ,
+    // so the number of requests in flight can never overflow the completion ring
+    const uint32_t slots    = params.cq_entries;
+    auto*          state    = static_cast<detail::ring_state*>(::operator new(sizeof(detail::ring_state), std::nothrow));
+    void*          slot_mem = ::operator new(slots * (2 * sizeof(uint64_t) + sizeof(uint32_t)), std::nothrow);
+    if(!state || !slot_mem) {
+        ::operator delete(state, std::nothrow);
+        ::operator delete(slot_mem, std::nothrow);
+        ::close(fd);
+        return expected<ring_handle, file_error>(unexpect, file_error(error_code::no_memory));
+    }
+
+    *state                = detail::ring_state {};
+    state->fd             = fd;
+    state->slot_user_data = static_cast<uint64_t*>(slot_mem);
+    state->slot_offset    = state->slot_user_data + slots;
+    state->free_slots     = reinterpret_cast<uint32_t*>(state->slot_offset + slots);
+    state->free_count     = slots;
+    for(uint32_t i = 0; i < slots; ++i) {
+        state->free_slots[i]     = slots - 1 - i;
+        state->slot_user_data[i] = detail::free_slot_data;
+    }
+
+    state->sq_size   = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    state->cq_size   = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    state->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    // Kernels with IORING_FEAT_SINGLE_MMAP share one mapping for both rings
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(single_mmap) {
+        if(state->cq_size > state->sq_size) state->sq_size = state->cq_size;
+        state->cq_size = state->sq_size;
+    }
+
+    void* sq_ptr =
+      ::mmap(nullptr, state->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if(sq_ptr == MAP_FAILED) {
+        int err = errno;
+        detail::release_ring_state(state);
+        return expected<ring_handle, file_error>(unexpect, detail::make_system_error(err));
+    }
+    state->sq_ptr = sq_ptr;
+
+    void* cq_ptr = sq_ptr;
+    if(!single_mmap) {
+        cq_ptr =
+          ::mmap(nullptr, state->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if(cq_ptr == MAP_FAILED) {
+            int err = errno;
+            detail::release_ring_state(state);
+            return expected<ring_handle, file_error>(unexpect, detail::make_system_error(err));
+        }
+    }
+    state->cq_ptr = cq_ptr;
+
+    void* sqes =
+      ::mmap(nullptr, state->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if(sqes == MAP_FAILED) {
+        int err = errno;
+        detail::release_ring_state(state);
+        return expected<ring_handle, file_error>(unexpect, detail::make_system_error(err));
+    }
+    state->sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq          = static_cast<char*>(sq_ptr);
+    state->sq_head    = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    state->sq_tail    = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    state->sq_array   = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    state->sq_mask    = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    state->sq_entries = params.sq_entries;
+
+    char* cq          = static_cast<char*>(cq_ptr);
+    state->cq_head    = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    state->cq_tail    = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    state->cqes       = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    state->cq_mask    = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    state->cq_entries = params.cq_entries;
+
+    ring_handle ring;
+    ring.state      = state;
+    ring.entries    = params.sq_entries;
+    ring.cq_entries = params.cq_entries;
+    return expected<ring_handle, file_error>(ring);
+#else
+    return expected<ring_handle, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline void destroy_ring_impl(ring_handle& ring) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(ring.state) { detail::release_ring_state(static_cast<detail::ring_state*>(ring.state)); }
+#endif
+    ring = ring_handle {};
+}
+
+inline ring_status query_ring_impl(const ring_handle& ring) noexcept {
+    ring_status status;
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(ring.state) {
+        auto* state       = static_cast<const detail::ring_state*>(ring.state);
+        status.queued     = state->queued;
+        status.in_flight  = state->cq_entries - state->free_count;
+        status.entries    = state->sq_entries;
+        status.cq_entries = state->cq_entries;
+    }
+#endif
+    return status;
+}
+
+inline expected<size_t, file_error> queue_ring_impl(
+  ring_handle&       ring,
+  const file_handle& handle,
+  ring_op            op,
+  const io_request*  requests,
+  size_t             count,
+  uint64_t           user_data) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state || (count > 0 && !requests)) {
+        return expected<size_t, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    // An SQE carries a 32-bit length; reject longer transfers rather than wrap them into short ones
+    if(op == ring_op::read || op == ring_op::write || op == ring_op::read_fixed || op == ring_op::write_fixed) {
+        for(size_t i = 0; i < count; ++i) {
+            if(requests[i].length > UINT32_MAX) {
+                return expected<size_t, file_error>(unexpect, file_error(error_code::invalid_argument));
+            }
+        }
+    }
+
+    auto*    state = static_cast<detail::ring_state*>(ring.state);
+    uint32_t head  = detail::load_acquire(state->sq_head);
+    uint32_t tail  = *state->sq_tail;
+
+    size_t queued = 0;
+    for(; queued < count; ++queued) {
+        // Stop when either the submission ring or the in-flight budget is exhausted
+        if(tail - head >= state->sq_entries || state->free_count == 0) break;
+
+        const io_request& req   = requests[queued];
+        uint32_t          index = tail & state->sq_mask;
+        io_uring_sqe*     sqe   = &state->sqes[index];
+        *sqe                    = io_uring_sqe {};
+
+        sqe->fd  = handle.fd;
+        sqe->off = req.offset;  // -1 selects the current file position
+        switch(op) {
+        case ring_op::nop: sqe->opcode = IORING_OP_NOP; break;
+        case ring_op::read:
+            sqe->opcode    = IORING_OP_READ;
+            sqe->addr      = reinterpret_cast<uint64_t>(req.buffer);
+            sqe->len       = static_cast<uint32_t>(req.length);
+            sqe->rw_flags  = static_cast<int>(req.flags);
+            break;
+        case ring_op::write:
+            sqe->opcode    = IORING_OP_WRITE;
+            sqe->addr      = reinterpret_cast<uint64_t>(req.buffer);
+            sqe->len       = static_cast<uint32_t>(req.length);
+            sqe->rw_flags  = static_cast<int>(req.flags);
+            break;
+        case ring_op::sync:
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->off    = 0;
+            sqe->flags  = IOSQE_IO_DRAIN;  // Starts once everything submitted before it has completed
+            if(req.flags == static_cast<uint32_t>(sync_flags::data_only)) { sqe->fsync_flags = IORING_FSYNC_DATASYNC; }
+            break;
+        case ring_op::read_fixed:
+        case ring_op::write_fixed:
+            sqe->opcode    = op == ring_op::read_fixed ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe->addr      = reinterpret_cast<uint64_t>(req.buffer);
+            sqe->len       = static_cast<uint32_t>(req.length);
+            sqe->rw_flags  = static_cast<int>(req.flags);
+            sqe->buf_index = static_cast<uint16_t>(req.buffer_index);
+            break;
+        case ring_op::cancel:
+            // The kernel knows requests by slot; an unknown target gets a slot
+            // no request uses, so the cancel completes with ENOENT
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd     = -1;
+            sqe->off    = 0;
+            sqe->addr   = detail::find_slot(*state, req.offset);
+            break;
+        }
+
+        uint32_t slot                = state->free_slots[--state->free_count];
+        state->slot_user_data[slot]  = user_data + queued;
+        state->slot_offset[slot]     = (op == ring_op::read || op == ring_op::write || op == ring_op::read_fixed
+                                    || op == ring_op::write_fixed)
+                                       ? req.offset
+                                       : 0;
+        sqe->user_data               = slot;
+        state->sq_array[index]       = index;
+        ++tail;
+    }
+
+    detail::store_release(state->sq_tail, tail);
+    state->queued += static_cast<uint32_t>(queued);
+    return expected<size_t, file_error>(queued);
+#else
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<size_t, file_error> submit_ring_impl(ring_handle& ring, size_t wait_for) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state) { return expected<size_t, file_error>(unexpect, file_error(error_code::invalid_argument)); }
+
+    auto*    state = static_cast<detail::ring_state*>(ring.state);
+    uint32_t flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+    if(state->queued == 0 && wait_for == 0) { return expected<size_t, file_error>(size_t { 0 }); }
+
+    int submitted = detail::ring_enter(state->fd, state->queued, static_cast<uint32_t>(wait_for), flags);
+    if(submitted < 0) { return expected<size_t, file_error>(unexpect, detail::make_system_error(errno)); }
+
+    state->queued -= static_cast<uint32_t>(submitted);
+    return expected<size_t, file_error>(static_cast<size_t>(submitted));
+#else
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<size_t, file_error>
+  reap_ring_impl(ring_handle& ring, io_completion* completions, size_t max_count, size_t min_count) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state || (max_count > 0 && !completions) || min_count > max_count) {
+        return expected<size_t, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    auto*  state = static_cast<detail::ring_state*>(ring.state);
+    size_t count = 0;
+
+    for(;;) {
+        uint32_t head = *state->cq_head;
+        uint32_t tail = detail::load_acquire(state->cq_tail);
+
+        for(; head != tail && count < max_count; ++head, ++count) {
+            const io_uring_cqe& cqe  = state->cqes[head & state->cq_mask];
+            uint32_t            slot = static_cast<uint32_t>(cqe.user_data);
+            io_completion&      out  = completions[count];
+
+            out           = io_completion {};
+            out.user_data = state->slot_user_data[slot];
+            if(cqe.res < 0) {
+                out.error = detail::make_system_error(-cqe.res);
+            } else {
+                uint64_t offset = state->slot_offset[slot];
+                out.result.bytes_transferred = static_cast<size_t>(cqe.res);
+                out.result.new_offset = (offset == static_cast<uint64_t>(-1)) ? 0 : offset + static_cast<uint64_t>(cqe.res);
+            }
+            state->slot_user_data[slot]            = detail::free_slot_data;
+            state->free_slots[state->free_count++] = slot;
+        }
+        detail::store_release(state->cq_head, head);
+
+        if(count >= min_count) break;
+
+        // Wait for the remainder, but never for more than is in flight
+        size_t in_flight = state->cq_entries - state->free_count;
+        if(in_flight == 0) break;
+        size_t wanted  = min_count - count < in_flight ? min_count - count : in_flight;
+        int    entered =
+          detail::ring_enter(state->fd, state->queued, static_cast<uint32_t>(wanted), IORING_ENTER_GETEVENTS);
+        if(entered < 0) {
+            if(errno == EINTR) continue;
+            return expected<size_t, file_error>(unexpect, detail::make_system_error(errno));
+        }
+        state->queued -= static_cast<uint32_t>(entered);
+    }
+
+    return expected<size_t, file_error>(count);
+#else
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<size_t, file_error> stat_batch_impl(
+  const file_handle& dir,
+  const char* const* names,
+  size_t             count,
+  file_info*         infos,
+  file_error*        errors,
+  ring_handle*       ring) noexcept {
+    if(count > 0 && (!names || !infos || !errors)) {
+        return expected<size_t, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    size_t done      = 0;
+    size_t succeeded = 0;
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    // Only an idle ring: completions for someone else's requests would be reaped here
+    auto* state = ring && ring->state ? static_cast<detail::ring_state*>(ring->state) : nullptr;
+    if(state && state->queued == 0 && state->free_count == state->cq_entries) {
+        constexpr size_t batch = 64;
+        struct statx     results[batch];
+        io_completion    completions[batch];
+        while(done < count) {
+            uint32_t head   = detail::load_acquire(state->sq_head);
+            uint32_t tail   = *state->sq_tail;
+            size_t   queued = 0;
+            for(; queued < batch && done + queued < count; ++queued) {
+                if(tail - head >= state->sq_entries || state->free_count == 0) break;
+
+                uint32_t      index = tail & state->sq_mask;
+                io_uring_sqe* sqe   = &state->sqes[index];
+                *sqe                = io_uring_sqe {};
+                sqe->opcode         = IORING_OP_STATX;
+                sqe->fd             = dir.fd;
+                sqe->addr           = reinterpret_cast<uint64_t>(names[done + queued]);
+                sqe->len            = detail::statx_mask;
+                sqe->off            = reinterpret_cast<uint64_t>(&results[queued]);
+                sqe->statx_flags    = detail::statx_flags;
+
+                uint32_t slot               = state->free_slots[--state->free_count];
+                state->slot_user_data[slot] = queued;
+                state->slot_offset[slot]    = 0;
+                sqe->user_data              = slot;
+                state->sq_array[index]      = index;
+                ++tail;
+            }
+            if(queued == 0) break;
+            detail::store_release(state->sq_tail, tail);
+            state->queued += static_cast<uint32_t>(queued);
+
+            // Submit and wait until nothing submitted is outstanding: the SQEs
+            // point into results. Entries the kernel never took fall back to statx.
+            size_t reaped    = 0;
+            size_t submitted = queued;
+            bool   stalled   = false;
+            while(reaped < submitted) {
+                auto got = reap_ring_impl(*ring, completions + reaped, submitted - reaped, 0);  // Never waits
+                if(got) reaped += *got;
+                if(reaped == submitted) break;
+                int entered = detail::ring_enter(state->fd, state->queued, 1, IORING_ENTER_GETEVENTS);
+                if(entered >= 0) {
+                    state->queued -= static_cast<uint32_t>(entered);
+                    continue;
+                }
+                if(errno == EINTR) continue;
+                if(state->queued > 0) {
+                    // Unpublish the SQEs the kernel has not read and return their slots
+                    for(uint32_t k = 0; k < state->queued; ++k) {
+                        const io_uring_sqe& sqe  = state->sqes[(tail - 1 - k) & state->sq_mask];
+                        uint32_t            slot = static_cast<uint32_t>(sqe.user_data);
+                        state->slot_user_data[slot]            = detail::free_slot_data;
+                        state->free_slots[state->free_count++] = slot;
+                    }
+                    submitted -= state->queued;
+                    tail      -= state->queued;
+                    detail::store_release(state->sq_tail, tail);
+                    state->queued = 0;
+                    stalled       = true;
+                } else {
+                    ::sched_yield();  // Cannot wait; submitted statx calls still complete on their own
+                }
+            }
+            for(size_t i = 0; i < reaped; ++i) {
+                const io_completion& c = completions[i];
+                size_t               n = done + c.user_data;
+                if(c.error.code == error_code::success) {
+                    infos[n] = detail::statx_to_info(results[c.user_data]);
+                    ++succeeded;
+                } else if(c.error.code == error_code::invalid_argument) {
+                    // Kernels before 5.6 reject the opcode itself
+                    succeeded += detail::statx_one(dir.fd, names[n], infos[n], errors[n]);
+                } else {
+                    errors[n] = c.error;
+                }
+            }
+            done += submitted;
+            if(stalled) break;
+        }
+    }
+#else
+    (void)ring;
+#endif
+    for(; done < count; ++done) succeeded += detail::statx_one(dir.fd, names[done], infos[done], errors[done]);
+    return expected<size_t, file_error>(succeeded);
+}
+
+inline expected<void, file_error>
+  register_ring_buffers_impl(ring_handle& ring, const ring_buffer* buffers, size_t count) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state || count == 0 || !buffers || count > detail::max_registered_buffers) {
+        return expected<void, file_error>(unexpect, file_error(error_code::invalid_argument));
+    }
+
+    auto* iov = static_cast<struct iovec*>(::operator new(count * sizeof(struct iovec), std::nothrow));
+    if(!iov) { return expected<void, file_error>(unexpect, file_error(error_code::no_memory)); }
+    for(size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = buffers[i].address;
+        iov[i].iov_len  = buffers[i].length;
+    }
+
+    auto* state  = static_cast<detail::ring_state*>(ring.state);
+    long  result = ::syscall(__NR_io_uring_register, state->fd, IORING_REGISTER_BUFFERS, iov, count);
+    int   err    = errno;
+    ::operator delete(iov, std::nothrow);
+
+    if(result < 0) { return expected<void, file_error>(unexpect, detail::make_system_error(err)); }
+    return expected<void, file_error>();
+#else
+    return expected<void, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<void, file_error> unregister_ring_buffers_impl(ring_handle& ring) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state) { return expected<void, file_error>(unexpect, file_error(error_code::invalid_argument)); }
+
+    auto* state = static_cast<detail::ring_state*>(ring.state);
+    if(::syscall(__NR_io_uring_register, state->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0) < 0) {
+        return expected<void, file_error>(unexpect, detail::make_system_error(errno));
+    }
+    return expected<void, file_error>();
+#else
+    return expected<void, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<void, file_error> register_ring_eventfd_impl(ring_handle& ring, int32_t fd) noexcept {
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    if(!ring.state || fd < 0) { return expected<void, file_error>(unexpect, file_error(error_code::invalid_argument)); }
+
+    auto* state = static_cast<detail::ring_state*>(ring.state);
+    if(::syscall(__NR_io_uring_register, state->fd, IORING_REGISTER_EVENTFD, &fd, 1) < 0) {
+        return expected<void, file_error>(unexpect, detail::make_system_error(errno));
+    }
+    return expected<void, file_error>();
+#else
+    return expected<void, file_error>(unexpect, file_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+inline expected<dio_alignment, file_error> query_dio_alignment_impl(const file_handle& handle) noexcept {
+#ifdef STATX_DIOALIGN
+    struct statx stx {};
+    if(::statx(handle.fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &stx) == 0 && (stx.stx_mask & STATX_DIOALIGN)
+       && stx.stx_dio_offset_align != 0) {
+        return expected<dio_alignment, file_error>(dio_alignment(stx.stx_dio_mem_align, stx.stx_dio_offset_align));
+    }
+#endif
+
+    struct stat st;
+    if(::fstat(handle.fd, &st) < 0) {
+        return expected<dio_alignment, file_error>(unexpect, detail::make_system_error(errno));
+    }
+
+    // Block devices report their logical sector size directly
+    if(S_ISBLK(st.st_mode)) {
+        int sector = 0;
+        if(::ioctl(handle.fd, BLKSSZGET, &sector) == 0 && sector > 0) {
+            return expected<dio_alignment, file_error>(
+              dio_alignment(static_cast<uint32_t>(sector), static_cast<uint32_t>(sector)));
+        }
+    }
+
+    // Page alignment satisfies every filesystem's O_DIRECT requirements
+    uint32_t page = static_cast<uint32_t>(::sysconf(_SC_PAGESIZE));
+    return expected<dio_alignment, file_error>(dio_alignment(page, page));
+}
+
 inline file_caps query_file_caps_impl() noexcept {
     file_caps caps {};
 
 #ifdef __linux__
     caps.supports_direct_io = true;
-    caps.supports_async_io  = true;
+#ifdef PLATFORM_FILE_HAS_IO_URING
+    caps.supports_async_io = detail::ring_available();
+#endif
     caps.supports_splice    = true;
     caps.supports_fallocate = true;
 #ifdef POSIX_FADV_NORMAL
@@ -1,7 +1,11 @@
 #ifndef PLATFORM_HARDWARE_HPP
 #define PLATFORM_HARDWARE_HPP
 
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <thread>
 
 namespace platform::hardware {
 
@@ -33,6 +37,247 @@ struct cache_info {
 // - macOS: sysctl()
 cache_info detect_cache_info() noexcept;
 
+// Instruction set extensions probed at runtime (CPUID + XGETBV on x86, HWCAP or
+// sysctl on ARM). x86 register-state features (AVX, AVX-512, AMX) are reported
+// only when the OS also saves those registers.
+enum class cpu_feature : uint8_t {
+    // x86 / x86-64
+    sse,
+    sse2,
+    sse3,
+    ssse3,
+    sse4_1,
+    sse4_2,  // Includes the CRC32C instruction
+    popcnt,
+    lzcnt,
+    bmi1,
+    bmi2,
+    movbe,
+    adx,
+    avx,
+    avx2,
+    fma,
+    f16c,
+    avx512f,
+    avx512dq,
+    avx512cd,
+    avx512bw,
+    avx512vl,
+    avx512vbmi,
+    avx512vbmi2,
+    avx512vnni,
+    avx512bitalg,
+    avx512vpopcntdq,
+    avx512fp16,
+    aes,
+    pclmul,
+    vaes,
+    vpclmulqdq,
+    gfni,
+    sha,
+    rdrand,
+    rdseed,
+    clflushopt,
+    clwb,
+    waitpkg,  // umonitor / umwait / tpause
+    movdiri,
+    movdir64b,
+    serialize,
+    erms,  // Enhanced rep movsb
+    fsrm,  // Fast short rep movsb
+    rdtscp,
+    invariant_tsc,  // TSC ticks at a constant rate through P-, C- and T-states
+    amx_tile,
+    amx_int8,
+    amx_bf16,
+
+    // AArch64
+    neon,
+    fp16,
+    dotprod,
+    sve,
+    sve2,
+    arm_aes,
+    arm_pmull,
+    arm_sha1,
+    arm_sha2,
+    arm_sha512,
+    arm_crc32,
+    lse,  // Large System Extensions (single-instruction atomics)
+
+    count
+};
+
+// Fixed-size feature bitset (16 bytes), value semantics
+struct cpu_feature_set {
+    uint64_t bits[2];
+
+    constexpr cpu_feature_set() noexcept: bits { 0, 0 } {}
+
+    constexpr cpu_feature_set(std::initializer_list<cpu_feature> features) noexcept: bits { 0, 0 } {
+        for(cpu_feature f : features) set(f);
+    }
+
+    constexpr bool has(cpu_feature f) const noexcept {
+        auto i = static_cast<size_t>(f);
+        return (bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Every feature in required is present
+    constexpr bool has_all(const cpu_feature_set& required) const noexcept {
+        return (bits[0] & required.bits[0]) == required.bits[0] && (bits[1] & required.bits[1]) == required.bits[1];
+    }
+
+    constexpr void set(cpu_feature f, bool on = true) noexcept {
+        auto     i    = static_cast<size_t>(f);
+        uint64_t mask = uint64_t { 1 } << (i % 64);
+        bits[i / 64]  = on ? (bits[i / 64] | mask) : (bits[i / 64] & ~mask);
+    }
+
+    constexpr void clear(cpu_feature f) noexcept { set(f, false); }
+
+    constexpr bool empty() const noexcept { return (bits[0] | bits[1]) == 0; }
+
+    constexpr size_t size() const noexcept {
+        return static_cast<size_t>(std::popcount(bits[0]) + std::popcount(bits[1]));
+    }
+
+    constexpr cpu_feature_set operator|(const cpu_feature_set& other) const noexcept {
+        cpu_feature_set out;
+        out.bits[0] = bits[0] | other.bits[0];
+        out.bits[1] = bits[1] | other.bits[1];
+        return out;
+    }
+
+    constexpr cpu_feature_set operator&(const cpu_feature_set& other) const noexcept {
+        cpu_feature_set out;
+        out.bits[0] = bits[0] & other.bits[0];
+        out.bits[1] = bits[1] & other.bits[1];
+        return out;
+    }
+
+    constexpr bool operator==(const cpu_feature_set&) const noexcept = default;
+};
+
+static_assert(static_cast<size_t>(cpu_feature::count) <= 128, "cpu_feature_set holds 128 features");
+
+// Lower-case name as used by compilers and /proc/cpuinfo ("avx2", "sve"); nullptr if out of range
+constexpr const char* cpu_feature_name(cpu_feature f) noexcept {
+    constexpr const char* names[] = {
+        "sse", "sse2", "sse3", "ssse3", "sse4.1", "sse4.2", "popcnt", "lzcnt", "bmi1", "bmi2", "movbe", "adx", "avx",
+        "avx2", "fma", "f16c", "avx512f", "avx512dq", "avx512cd", "avx512bw", "avx512vl", "avx512vbmi", "avx512vbmi2",
+        "avx512vnni", "avx512bitalg", "avx512vpopcntdq", "avx512fp16", "aes", "pclmul", "vaes", "vpclmulqdq", "gfni",
+        "sha", "rdrand", "rdseed", "clflushopt", "clwb", "waitpkg", "movdiri", "movdir64b", "serialize", "erms",
+        "fsrm", "rdtscp", "invariant-tsc", "amx-tile", "amx-int8", "amx-bf16", "neon", "fp16", "dotprod", "sve", "sve2",
+        "arm-aes", "arm-pmull", "arm-sha1", "arm-sha2", "arm-sha512", "arm-crc32", "lse",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(cpu_feature::count));
+    auto i = static_cast<size_t>(f);
+    return i < static_cast<size_t>(cpu_feature::count) ? names[i] : nullptr;
+}
+
+// Probe the features of the running CPU (uncached; a few CPUID/sysctl calls)
+// Implemented in platform-specific source files:
+// - x86 on any OS: CPUID + XGETBV (platform/hardware_x86.hpp)
+// - Linux AArch64: getauxval(AT_HWCAP/AT_HWCAP2)
+// - macOS arm64: sysctl hw.optional.*
+// - Windows ARM64: IsProcessorFeaturePresent()
+cpu_feature_set detect_cpu_features() noexcept;
+
+// Where one logical CPU sits in the machine (36 bytes)
+// Ids are dense indices assigned by the detector, except cpu (the OS CPU number)
+// and node (the OS node number). CPUs with equal l2_domain/l3_domain share that cache.
+struct cpu_location {
+    uint32_t cpu;        // OS CPU number (as used by affinity masks)
+    uint32_t core;       // Physical core, unique across packages
+    uint32_t package;    // Socket
+    uint32_t node;       // NUMA node
+    uint32_t l2_domain;  // L2 sharing group
+    uint32_t l3_domain;  // Last-level cache sharing group
+    uint32_t l2_kib;     // This CPU's L2 size (0 = unknown)
+    uint32_t l3_kib;     // This CPU's L3 size (0 = unknown or none)
+    uint16_t smt_index;  // 0 for the first hardware thread of its core
+    uint8_t  allowed;    // In this process's affinity mask
+    uint8_t  _padding;
+};
+
+// One NUMA node (24 bytes); machines without NUMA report a single node 0
+struct numa_node_info {
+    uint32_t node;          // OS node number
+    uint32_t cpu_count;     // Online CPUs on the node
+    uint64_t total_memory;  // Bytes (0 = unknown)
+    uint64_t free_memory;   // Bytes at detection time (0 = unknown)
+};
+
+// Online CPUs in ascending OS number order
+// Writes up to max_count entries and returns the total number of online CPUs
+size_t detect_cpu_topology(cpu_location* cpus, size_t max_count) noexcept;
+
+// NUMA nodes with memory or CPUs, in ascending node order
+// Writes up to max_count entries and returns the total number of nodes
+size_t detect_numa_nodes(numa_node_info* nodes, size_t max_count) noexcept;
+
+// Relative access cost from one node to another (ACPI SLIT: 10 = local); 0 if unknown.
+// Windows does not expose the SLIT and reports 10 or 20.
+uint32_t numa_distance(uint32_t from, uint32_t to) noexcept;
+
+// CPUs this process may run on (affinity mask on Linux, online CPUs elsewhere)
+// Writes up to max_count CPU ids into cpus and returns the total number available
+size_t available_cpus(size_t* cpus, size_t max_count) noexcept;
+
+// Restrict the calling thread to a single CPU; false if unsupported or refused
+bool pin_current_thread(size_t cpu) noexcept;
+
+// ============================================================================
+// Thread Placement and Scheduling
+// ============================================================================
+
+// Native handle of a std::thread (pthread_t, or HANDLE on Windows)
+using thread_handle = std::thread::native_handle_type;
+
+thread_handle current_thread_handle() noexcept;
+
+// Restrict a thread to a set of OS CPU numbers; false if the set is empty,
+// unsupported (macOS has no hard affinity) or refused. Windows needs every CPU
+// in one processor group (CPU number = group * 64 + index).
+bool set_thread_affinity(thread_handle thread, const uint32_t* cpus, size_t count) noexcept;
+
+// CPUs a thread may run on; writes up to max_count ids and returns the total (0 on failure)
+size_t get_thread_affinity(thread_handle thread, uint32_t* cpus, size_t max_count) noexcept;
+
+// Where the calling thread is running right now (may change on the next instruction)
+struct cpu_position {
+    uint32_t cpu;   // OS CPU number
+    uint32_t node;  // NUMA node, 0 when the platform does not say
+};
+
+// Linux: getcpu (vDSO, RDPID/RDTSCP-backed on x86); Windows: GetCurrentProcessorNumberEx.
+// False where the CPU cannot be queried (macOS).
+bool current_cpu(cpu_position& out) noexcept;
+
+// Scheduling classes; priority meaning depends on the class (see set_thread_scheduling)
+enum class sched_class : uint8_t {
+    normal      = 0,  // Time-shared (SCHED_OTHER)
+    batch       = 1,  // Throughput, no wake-up preference (SCHED_BATCH; below normal elsewhere)
+    idle        = 2,  // Runs only when nothing else would (SCHED_IDLE; idle priority elsewhere)
+    fifo        = 3,  // Real-time, runs until it blocks or yields (SCHED_FIFO)
+    round_robin = 4   // Real-time with a time slice among equal priorities (SCHED_RR)
+};
+
+struct thread_scheduling {
+    sched_class cls;
+    int         priority;
+};
+
+// Real-time classes take priority 1 (lowest) to 99 (clamped to the platform range;
+// usually needs CAP_SYS_NICE or an rtprio rlimit). Time-shared classes take a nice
+// value from -20 (favoured) to 19, applied on Linux only when thread is the caller;
+// other threads accept priority 0. False if refused.
+bool set_thread_scheduling(thread_handle thread, sched_class cls, int priority) noexcept;
+
+// Current class and priority (nice value for time-shared classes of the caller)
+bool get_thread_scheduling(thread_handle thread, thread_scheduling& out) noexcept;
+
 }  // namespace platform::hardware
 
 #endif  // PLATFORM_HARDWARE_HPP
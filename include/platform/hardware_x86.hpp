@@ -0,0 +1,130 @@
+#ifndef PLATFORM_HARDWARE_X86_HPP
+#define PLATFORM_HARDWARE_X86_HPP
+
+// CPUID/XGETBV feature probe shared by the Linux, macOS and Windows sources
+// Only included by platform implementation files - not part of public API
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include "hardware.hpp"
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace platform::hardware::x86_impl {
+
+struct cpuid_regs {
+    uint32_t eax, ebx, ecx, edx;
+};
+
+inline cpuid_regs cpuid(uint32_t leaf, uint32_t subleaf = 0) noexcept {
+    cpuid_regs r {};
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r = { static_cast<uint32_t>(out[0]), static_cast<uint32_t>(out[1]), static_cast<uint32_t>(out[2]),
+          static_cast<uint32_t>(out[3]) };
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+// Register state the OS saves on context switch (XCR0); only valid with OSXSAVE
+inline uint64_t xgetbv0() noexcept {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+constexpr bool bit(uint32_t reg, int n) noexcept { return (reg >> n) & 1; }
+
+inline void probe_x86_features(cpu_feature_set& out) noexcept {
+    uint32_t max_leaf = cpuid(0).eax;
+    if(max_leaf < 1) return;
+
+    cpuid_regs l1 = cpuid(1);
+    out.set(cpu_feature::sse, bit(l1.edx, 25));
+    out.set(cpu_feature::sse2, bit(l1.edx, 26));
+    out.set(cpu_feature::sse3, bit(l1.ecx, 0));
+    out.set(cpu_feature::pclmul, bit(l1.ecx, 1));
+    out.set(cpu_feature::ssse3, bit(l1.ecx, 9));
+    out.set(cpu_feature::sse4_1, bit(l1.ecx, 19));
+    out.set(cpu_feature::sse4_2, bit(l1.ecx, 20));
+    out.set(cpu_feature::movbe, bit(l1.ecx, 22));
+    out.set(cpu_feature::popcnt, bit(l1.ecx, 23));
+    out.set(cpu_feature::aes, bit(l1.ecx, 25));
+    out.set(cpu_feature::rdrand, bit(l1.ecx, 30));
+
+    // AVX needs the OS to save YMM (XCR0 bits 1-2), AVX-512 also opmask/ZMM (5-7), AMX tiles (17-18)
+    uint64_t xcr0   = bit(l1.ecx, 27) ? xgetbv0() : 0;
+    bool     ymm_os = (xcr0 & 0x6) == 0x6;
+    bool     zmm_os = ymm_os && (xcr0 & 0xe0) == 0xe0;
+    bool     amx_os = (xcr0 & 0x60000) == 0x60000;
+
+    bool avx = ymm_os && bit(l1.ecx, 28);
+    out.set(cpu_feature::avx, avx);
+    out.set(cpu_feature::fma, avx && bit(l1.ecx, 12));
+    out.set(cpu_feature::f16c, avx && bit(l1.ecx, 29));
+
+    if(max_leaf >= 7) {
+        cpuid_regs l7 = cpuid(7, 0);
+        out.set(cpu_feature::bmi1, bit(l7.ebx, 3));
+        out.set(cpu_feature::avx2, avx && bit(l7.ebx, 5));
+        out.set(cpu_feature::bmi2, bit(l7.ebx, 8));
+        out.set(cpu_feature::erms, bit(l7.ebx, 9));
+        out.set(cpu_feature::rdseed, bit(l7.ebx, 18));
+        out.set(cpu_feature::adx, bit(l7.ebx, 19));
+        out.set(cpu_feature::clflushopt, bit(l7.ebx, 23));
+        out.set(cpu_feature::clwb, bit(l7.ebx, 24));
+        out.set(cpu_feature::sha, bit(l7.ebx, 29));
+        out.set(cpu_feature::waitpkg, bit(l7.ecx, 5));
+        out.set(cpu_feature::gfni, bit(l7.ecx, 8));
+        out.set(cpu_feature::vaes, avx && bit(l7.ecx, 9));
+        out.set(cpu_feature::vpclmulqdq, avx && bit(l7.ecx, 10));
+        out.set(cpu_feature::movdiri, bit(l7.ecx, 27));
+        out.set(cpu_feature::movdir64b, bit(l7.ecx, 28));
+        out.set(cpu_feature::fsrm, bit(l7.edx, 4));
+        out.set(cpu_feature::serialize, bit(l7.edx, 14));
+
+        bool avx512 = zmm_os && bit(l7.ebx, 16);
+        out.set(cpu_feature::avx512f, avx512);
+        out.set(cpu_feature::avx512dq, avx512 && bit(l7.ebx, 17));
+        out.set(cpu_feature::avx512cd, avx512 && bit(l7.ebx, 28));
+        out.set(cpu_feature::avx512bw, avx512 && bit(l7.ebx, 30));
+        out.set(cpu_feature::avx512vl, avx512 && bit(l7.ebx, 31));
+        out.set(cpu_feature::avx512vbmi, avx512 && bit(l7.ecx, 1));
+        out.set(cpu_feature::avx512vbmi2, avx512 && bit(l7.ecx, 6));
+        out.set(cpu_feature::avx512vnni, avx512 && bit(l7.ecx, 11));
+        out.set(cpu_feature::avx512bitalg, avx512 && bit(l7.ecx, 12));
+        out.set(cpu_feature::avx512vpopcntdq, avx512 && bit(l7.ecx, 14));
+        out.set(cpu_feature::avx512fp16, avx512 && bit(l7.edx, 23));
+
+        out.set(cpu_feature::amx_bf16, amx_os && bit(l7.edx, 22));
+        out.set(cpu_feature::amx_tile, amx_os && bit(l7.edx, 24));
+        out.set(cpu_feature::amx_int8, amx_os && bit(l7.edx, 25));
+    }
+
+    uint32_t max_ext = cpuid(0x80000000).eax;
+    if(max_ext >= 0x80000001) {
+        cpuid_regs ext = cpuid(0x80000001);
+        out.set(cpu_feature::lzcnt, bit(ext.ecx, 5));
+        out.set(cpu_feature::rdtscp, bit(ext.edx, 27));
+    }
+    if(max_ext >= 0x80000007) out.set(cpu_feature::invariant_tsc, bit(cpuid(0x80000007).edx, 8));
+}
+
+}  // namespace platform::hardware::x86_impl
+
+#endif  // x86
+
+#endif  // PLATFORM_HARDWARE_X86_HPP
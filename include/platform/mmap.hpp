@@ -108,9 +108,10 @@ enum class placement_strategy : uint8_t {
 
 // Page size preferences
 enum class page_preference : uint8_t {
-    system_default = 0,  // Use system default page size
-    prefer_large   = 1,  // Try large pages, fallback to normal
-    require_large  = 2   // Require large pages or fail
+    system_default    = 0,  // Use system default page size
+    prefer_large      = 1,  // Try explicit large pages, then transparent, then normal
+    require_large     = 2,  // Require explicit large pages or fail
+    transparent_large = 3   // Transparent large pages only (Linux THP), fallback to normal
 };
 
 // Memory commitment strategy
@@ -136,7 +137,13 @@ enum class locking_strategy : uint8_t {
 // Synchronization semantics for file-backed mappings
 enum class sync_semantics : uint8_t {
     normal_sync  = 0,  // Standard synchronization
-    durable_sync = 1   // Durable sync if supported by filesystem
+    durable_sync = 1   // MAP_SYNC where the filesystem allows it (DAX); normal otherwise
+};
+
+// How sync_memory_range waits for a range to reach storage
+enum class flush_mode : uint8_t {
+    async_flush = 0,  // Start writeback and return (MS_ASYNC plus sync_file_range on Linux)
+    sync_flush  = 1   // Return once the range is written (MS_SYNC)
 };
 
 // Access pattern hints
@@ -146,6 +153,15 @@ enum class access_pattern : uint8_t {
     random_access     = 2   // Random access pattern
 };
 
+// NUMA memory placement policy (Linux mbind modes)
+enum class numa_policy : uint8_t {
+    default_policy = 0,  // Inherit the thread's policy (usually local allocation)
+    bind           = 1,  // Allocate only from numa_nodes; fail the fault rather than spill
+    preferred      = 2,  // Prefer the lowest node in numa_nodes, fall back to others
+    interleave     = 3,  // Round-robin pages across numa_nodes
+    local          = 4   // Node of the CPU that first touches each page
+};
+
 // Flattened memory request structure - optimized for cache efficiency
 struct memory_request {
     // Core mapping parameters
@@ -166,6 +182,10 @@ struct memory_request {
     locking_strategy   locking;    // Memory locking behavior
     sync_semantics     sync;       // Synchronization semantics
     access_pattern     pattern;    // Access pattern hints
+    numa_policy        numa;       // NUMA placement, applied before any prefault
+
+    // NUMA node mask for bind/preferred/interleave (bit n = node n)
+    uint64_t numa_nodes;
 
     // Platform-specific escape hatch (flattened for efficiency)
     uint64_t native_flags;       // Platform-specific flags
@@ -190,6 +210,8 @@ struct memory_request {
         locking(locking_strategy::no_lock),
         sync(sync_semantics::normal_sync),
         pattern(access_pattern::normal_access),
+        numa(numa_policy::default_policy),
+        numa_nodes(0),
         native_flags(0),
         native_protection(0),
         native_view_flags(0),
@@ -207,9 +229,12 @@ struct memory_region {
     // Flattened flags for what was actually granted
     access_mode     actual_access;   // Actual access permissions
     sharing_mode    actual_sharing;  // Actual sharing mode
-    page_preference actual_pages;    // Actual page size used
+    page_preference actual_pages;    // Page tier granted (require_large = explicit, transparent_large, or default)
     bool            is_locked;       // Whether region is locked in memory
-    bool            supports_sync;   // Whether durable sync is supported
+    bool            supports_sync;   // Whether the region can be synced to a file
+    sync_semantics  actual_sync;     // durable_sync when mapped with MAP_SYNC: CPU cache flushes persist stores
+    numa_policy     actual_numa;     // Policy the kernel reports for the region
+    uint64_t        actual_nodes;    // Node mask of that policy (0 for default/local)
 
     constexpr memory_region() noexcept:
         address(nullptr),
@@ -221,7 +246,10 @@ struct memory_region {
         actual_sharing(sharing_mode::shared),
         actual_pages(page_preference::system_default),
         is_locked(false),
-        supports_sync(false) {}
+        supports_sync(false),
+        actual_sync(sync_semantics::normal_sync),
+        actual_numa(numa_policy::default_policy),
+        actual_nodes(0) {}
 };
 
 // Flattened capability structure for platform features
@@ -230,21 +258,25 @@ struct memory_caps {
     std::size_t system_page_size;        // System default page size
     std::size_t large_page_sizes[8];     // Supported large page sizes (0-terminated)
     std::size_t allocation_granularity;  // Minimum allocation granularity
+    std::size_t large_page_granularity;  // Large-page lengths that every page tier maps unrounded
 
     // Feature flags (flattened booleans for cache efficiency)
-    bool supports_fixed_no_replace;  // Fixed address without replacement support
-    bool supports_large_pages;       // Large/huge page support
-    bool supports_lock_on_fault;     // Lock-on-fault support
-    bool supports_durable_sync;      // Durable sync support
-    bool supports_prefetch;          // Memory prefetch APIs
-    bool supports_memory_lock;       // Memory locking support
-    bool supports_anonymous;         // Anonymous mapping support
-    bool supports_execute;           // Execute permission support
+    bool supports_fixed_no_replace;   // Fixed address without replacement support
+    bool supports_large_pages;        // Large/huge page support
+    bool supports_lock_on_fault;      // Lock-on-fault support
+    bool supports_durable_sync;       // Kernel accepts MAP_SYNC; files still need a DAX filesystem
+    bool supports_prefetch;           // Memory prefetch APIs
+    bool supports_memory_lock;        // Memory locking support
+    bool supports_anonymous;          // Anonymous mapping support
+    bool supports_execute;            // Execute permission support
+    bool supports_transparent_pages;  // Transparent large pages (THP) available
+    bool supports_numa_policy;        // memory_request::numa honoured (mbind available)
 
     constexpr memory_caps() noexcept:
         system_page_size(4096),
         large_page_sizes {},
         allocation_granularity(4096),
+        large_page_granularity(0),
         supports_fixed_no_replace(false),
         supports_large_pages(false),
         supports_lock_on_fault(false),
@@ -252,7 +284,9 @@ struct memory_caps {
         supports_prefetch(false),
         supports_memory_lock(false),
         supports_anonymous(true),
-        supports_execute(false) {}
+        supports_execute(false),
+        supports_transparent_pages(false),
+        supports_numa_policy(false) {}
 };
 
 // Cross-platform memory mapping interface
@@ -264,6 +298,11 @@ expected<memory_region, memory_error> map_memory(int file_descriptor, const memo
 // Synchronize a mapped region to storage
 expected<void, memory_error> sync_memory(const memory_region& region, bool invalidate_caches = false) noexcept;
 
+// Synchronize [offset, offset + length) of a mapped region; offset is rounded
+// down to a page, the length clamped to the region
+expected<void, memory_error>
+  sync_memory_range(const memory_region& region, std::size_t offset, std::size_t length, flush_mode mode) noexcept;
+
 // Unmap a previously mapped region
 void unmap_memory(const memory_region& region) noexcept;
 
@@ -282,6 +321,42 @@ expected<void, memory_error> unlock_memory(const memory_region& region) noexcept
 expected<void, memory_error>
   prefetch_memory(const memory_region& region, std::size_t offset = 0, std::size_t length = 0) noexcept;
 
+// Drop resident pages of a range (MADV_DONTNEED on Linux). File-backed pages are
+// re-read on next access; private anonymous pages read back as zeros
+expected<void, memory_error>
+  discard_memory(const memory_region& region, std::size_t offset = 0, std::size_t length = 0) noexcept;
+
+// Drop a range from the mapping and, for file mappings, ask the kernel to drop
+// it from the page cache too. Dirty pages only start writeback and stay cached
+expected<void, memory_error>
+  evict_memory(const memory_region& region, std::size_t offset = 0, std::size_t length = 0) noexcept;
+
+// Fault a range in and wait for it (MADV_POPULATE_READ, or MADV_POPULATE_WRITE
+// for writable anonymous memory; older kernels read one byte per page)
+expected<void, memory_error>
+  populate_memory(const memory_region& region, std::size_t offset = 0, std::size_t length = 0) noexcept;
+
+// Residency of the pages covering [offset, offset + length) (mincore). Writes
+// one byte per page to pages, bit 0 set when resident, and returns the number
+// of resident pages. offset is rounded down to a page, length 0 means to the
+// end of the region. File mappings report page-cache state only for files the
+// caller owns or may write; otherwise only pages mapped by this process count
+expected<std::size_t, memory_error> query_residency(
+  const memory_region& region, std::size_t offset, std::size_t length, unsigned char* pages) noexcept;
+
+// Unnamed memory file of length bytes for sharing pages between processes
+// (memfd on Linux), close-on-exec. Map it file_backed with sharing_mode::shared;
+// the caller owns the descriptor and closes it.
+expected<int, memory_error> create_shared_memory(const char* name, std::size_t length) noexcept;
+
+// Block while *word == value (futex on Linux). Works across processes that map
+// the same pages shared. Returns false on timeout (timeout_ms -1 = forever);
+// it may also return early, so callers re-check their condition.
+expected<bool, memory_error> wait_shared_word(const uint32_t* word, uint32_t value, int timeout_ms) noexcept;
+
+// Wake up to count waiters blocked on word
+void wake_shared_word(const uint32_t* word, int count) noexcept;
+
 }  // namespace platform::mmap
 
 #endif
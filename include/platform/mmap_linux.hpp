@@ -5,11 +5,17 @@
 
 // Platform-specific includes
 #ifdef __linux__
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <errno.h>
 #include <fcntl.h>
+#include <dirent.h>
+#include <linux/futex.h>
 #include <sys/mman.h>
 #include <sys/syscall.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace platform::mmap::linux_impl {
@@ -79,27 +85,6 @@ constexpr int to_map_flags(const memory_request& req) noexcept {
         break;
     }
 
-    // Large pages
-    if(req.page_pref == page_preference::prefer_large || req.page_pref == page_preference::require_large) {
-#ifdef MAP_HUGETLB
-        flags |= MAP_HUGETLB;
-
-        // Try to set specific huge page size if requested
-        if(req.large_page_size != 0) {
-#ifdef MAP_HUGE_2MB
-            if(req.large_page_size == 2 * 1024 * 1024) {
-                flags |= MAP_HUGE_2MB;
-            }
-#endif
-#ifdef MAP_HUGE_1GB
-            else if(req.large_page_size == 1024 * 1024 * 1024) {
-                flags |= MAP_HUGE_1GB;
-            }
-#endif
-        }
-#endif
-    }
-
     // Population/commit strategy
     if(req.populate == populate_strategy::prefault || req.commit == commit_strategy::pre_commit) {
 #ifdef MAP_POPULATE
@@ -113,16 +98,103 @@ constexpr int to_map_flags(const memory_request& req) noexcept {
     return flags;
 }
 
-// Get system page size
-std::size_t get_page_size() noexcept {
-    static std::size_t page_size = 0;
-    if(page_size == 0) {
-        long ps   = sysconf(_SC_PAGESIZE);
-        page_size = (ps > 0) ? static_cast<std::size_t>(ps) : 4096;
-    }
+// Get system page size (read once; static initialization is thread-safe)
+inline std::size_t get_page_size() noexcept {
+    static const std::size_t page_size = [] {
+        long ps = sysconf(_SC_PAGESIZE);
+        return (ps > 0) ? static_cast<std::size_t>(ps) : std::size_t { 4096 };
+    }();
     return page_size;
 }
 
+// Read a single unsigned value from a sysfs/procfs file (0 on failure)
+inline std::size_t read_sys_value(const char* path) noexcept {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return 0;
+    char    buf[64];
+    ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+    ::close(fd);
+    if(n <= 0) return 0;
+    buf[n] = '\0';
+    return static_cast<std::size_t>(std::strtoull(buf, nullptr, 10));
+}
+
+// Default explicit huge page size (Hugepagesize in /proc/meminfo), 2 MiB fallback
+inline std::size_t default_huge_page_size() noexcept {
+    static const std::size_t cached = [] {
+        std::size_t size = 2 * 1024 * 1024;
+        int         fd   = ::open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+        if(fd >= 0) {
+            char    buf[4096];
+            ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+            ::close(fd);
+            if(n > 0) {
+                buf[n]          = '\0';
+                const char* key = std::strstr(buf, "Hugepagesize:");
+                if(key) {
+                    std::size_t kb = std::strtoull(key + 13, nullptr, 10);
+                    if(kb) size = kb * 1024;
+                }
+            }
+        }
+        return size;
+    }();
+    return cached;
+}
+
+// Transparent huge page size, or 0 when THP is unavailable or disabled
+inline std::size_t transparent_page_size() noexcept {
+    static const std::size_t cached = [] {
+        std::size_t size = 0;
+        int         fd   = ::open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY | O_CLOEXEC);
+        if(fd >= 0) {
+            char    buf[128];
+            ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+            ::close(fd);
+            if(n > 0) {
+                buf[n] = '\0';
+                // "[always]" or "[madvise]" allow MADV_HUGEPAGE regions; "[never]" does not
+                if(!std::strstr(buf, "[never]")) {
+                    size = read_sys_value("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+                    if(size == 0) size = 2 * 1024 * 1024;
+                }
+            }
+        }
+        return size;
+    }();
+    return cached;
+}
+
+// MAP_HUGETLB plus the MAP_HUGE_* size encoding (log2(size) << MAP_HUGE_SHIFT)
+inline int huge_tlb_flags(std::size_t size) noexcept {
+    int flags = 0;
+#ifdef MAP_HUGETLB
+    flags = MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    if(size != 0 && (size & (size - 1)) == 0) { flags |= __builtin_ctzll(size) << MAP_HUGE_SHIFT; }
+#endif
+#endif
+    return flags;
+}
+
+constexpr std::size_t round_up(std::size_t value, std::size_t unit) noexcept {
+    return (value + unit - 1) / unit * unit;
+}
+
+// Anonymous mapping aligned to align: over-map by one unit and trim both ends
+inline void* map_aligned(void* hint, std::size_t length, std::size_t align, int prot, int flags) noexcept {
+    void* raw = ::mmap(hint, length + align, prot, flags, -1, 0);
+    if(raw == MAP_FAILED) return MAP_FAILED;
+
+    auto        start   = reinterpret_cast<uintptr_t>(raw);
+    auto        aligned = (start + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    std::size_t head    = aligned - start;
+    std::size_t tail    = align - head;
+    if(head) ::munmap(raw, head);
+    if(tail) ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+    return reinterpret_cast<void*>(aligned);
+}
+
 // Apply memory advice using madvise
 expected<void, memory_error> apply_madvise(void* addr, std::size_t length, int advice) noexcept {
     if(::madvise(addr, length, advice) == 0) { return expected<void, memory_error>(); }
@@ -152,22 +224,141 @@ expected<void, memory_error> apply_mlock(void* addr, std::size_t length, locking
     return expected<void, memory_error>(unexpect, make_system_error(errno));
 }
 
-// Query large page sizes
-void query_large_page_sizes(memory_caps& caps) noexcept {
+// Kernel mempolicy modes and get_mempolicy flags (linux/mempolicy.h); raw
+// syscalls keep libnuma out of the dependency list
+constexpr int mpol_default    = 0;
+constexpr int mpol_preferred  = 1;
+constexpr int mpol_bind       = 2;
+constexpr int mpol_interleave = 3;
+constexpr int mpol_local      = 4;
+constexpr int mpol_f_addr     = 1 << 1;
+constexpr int mpol_mode_mask  = 0xff;  // Strip MPOL_F_STATIC_NODES and friends
+
+constexpr int to_mpol_mode(numa_policy policy) noexcept {
+    switch(policy) {
+    case numa_policy::bind      : return mpol_bind;
+    case numa_policy::preferred : return mpol_preferred;
+    case numa_policy::interleave: return mpol_interleave;
+    case numa_policy::local     : return mpol_local;
+    default                     : return mpol_default;
+    }
+}
+
+constexpr numa_policy from_mpol_mode(int mode) noexcept {
+    switch(mode & mpol_mode_mask) {
+    case mpol_bind      : return numa_policy::bind;
+    case mpol_preferred : return numa_policy::preferred;
+    case mpol_interleave: return numa_policy::interleave;
+    case mpol_local     : return numa_policy::local;
+    default             : return numa_policy::default_policy;
+    }
+}
+
+// Node mask words as the kernel reads them (unsigned long bitmap)
+constexpr std::size_t node_mask_words = 64 / (8 * sizeof(unsigned long));
+
+// Set a NUMA policy on a fresh mapping, before any page is faulted in
+inline expected<void, memory_error>
+  apply_numa_policy(void* addr, std::size_t length, numa_policy policy, uint64_t nodes) noexcept {
+    if(policy == numa_policy::default_policy) return expected<void, memory_error>();
+    if(policy != numa_policy::local && nodes == 0) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+#ifdef SYS_mbind
+    unsigned long mask[node_mask_words];
+    for(std::size_t i = 0; i < node_mask_words; ++i) {
+        mask[i] = static_cast<unsigned long>(nodes >> (i * 8 * sizeof(unsigned long)));
+    }
+    bool          local   = policy == numa_policy::local;
+    unsigned long maxnode = local ? 0 : 64 + 1;  // The kernel reads maxnode - 1 bits
+    if(::syscall(SYS_mbind, addr, length, to_mpol_mode(policy), local ? nullptr : mask, maxnode, 0) == 0) {
+        return expected<void, memory_error>();
+    }
+    return expected<void, memory_error>(unexpect, make_system_error(errno));
+#else
+    (void)addr;
+    (void)length;
+    return expected<void, memory_error>(unexpect, memory_error(error_domain::feature, error_code::not_supported));
+#endif
+}
+
+// Record the policy the kernel holds for the region (left as default on failure)
+inline void query_numa_policy(memory_region& region) noexcept {
+#ifdef SYS_get_mempolicy
+    // get_mempolicy rejects masks smaller than the possible node count; 1024 covers MAX_NUMNODES
+    constexpr unsigned long max_nodes = 1024;
+    unsigned long           mask[max_nodes / (8 * sizeof(unsigned long))] = {};
+    int                     mode                                          = 0;
+    if(::syscall(SYS_get_mempolicy, &mode, mask, max_nodes, region.address, mpol_f_addr) != 0) return;
+
+    region.actual_numa  = from_mpol_mode(mode);
+    region.actual_nodes = 0;
+    if(region.actual_numa == numa_policy::default_policy || region.actual_numa == numa_policy::local) return;
+    for(std::size_t i = 0; i < node_mask_words; ++i) {
+        region.actual_nodes |= static_cast<uint64_t>(mask[i]) << (i * 8 * sizeof(unsigned long));
+    }
+#else
+    (void)region;
+#endif
+}
+
+// Fault a range in after the mapping was created without MAP_POPULATE
+inline void populate_range(void* addr, std::size_t length, access_mode access, bool anonymous) noexcept {
+    bool writable = static_cast<uint8_t>(access) & static_cast<uint8_t>(access_mode::write);
+#ifdef MADV_POPULATE_WRITE
+    if(::madvise(addr, length, writable ? MADV_POPULATE_WRITE : MADV_POPULATE_READ) == 0) return;
+#endif
+    // Pre-5.14 kernels: writing zeros into fresh anonymous memory allocates it
+    // without changing it; anything else only gets read-ahead
+    if(writable && anonymous) {
+        std::size_t page = get_page_size();
+        for(std::size_t at = 0; at < length; at += page) {
+            static_cast<volatile char*>(addr)[at] = 0;
+        }
+        return;
+    }
+    ::madvise(addr, length, MADV_WILLNEED);
+}
+
+#ifdef MAP_SHARED_VALIDATE
+// Older kernels reject MAP_SHARED_VALIDATE as an unknown mapping type; probe a
+// shared /dev/zero page once (anonymous mappings reject it on every kernel)
+inline bool validates_map_flags() noexcept {
+    static const bool validates = [] {
+        int fd = ::open("/dev/zero", O_RDWR | O_CLOEXEC);
+        if(fd < 0) return false;
+        void* addr = ::mmap(nullptr, get_page_size(), PROT_READ, MAP_SHARED_VALIDATE, fd, 0);
+        ::close(fd);
+        if(addr == MAP_FAILED) return false;
+        ::munmap(addr, get_page_size());
+        return true;
+    }();
+    return validates;
+}
+#endif
+
+// Query explicit large page sizes from /sys/kernel/mm/hugepages (hugepages-<N>kB)
+inline void query_large_page_sizes(memory_caps& caps) noexcept {
     std::size_t idx = 0;
 
-    // Check common large page sizes
-    const std::size_t common_sizes[] = {
-        2 * 1024 * 1024,     // 2MB
-        1024 * 1024 * 1024,  // 1GB
-        0
-    };
+    DIR* dir = ::opendir("/sys/kernel/mm/hugepages");
+    if(dir) {
+        while(const dirent* entry = ::readdir(dir)) {
+            if(idx >= 7) break;
+            if(std::strncmp(entry->d_name, "hugepages-", 10) != 0) continue;
+            std::size_t kb = std::strtoull(entry->d_name + 10, nullptr, 10);
+            if(kb) caps.large_page_sizes[idx++] = kb * 1024;
+        }
+        ::closedir(dir);
+    }
 
-    for(const auto* size_ptr = common_sizes; *size_ptr && idx < 7; ++size_ptr) {
-        // Try to determine if this size is supported
-        // This is a simplified check - in practice, you might need to
-        // read /proc/meminfo or /sys/kernel/mm/hugepages/
-        caps.large_page_sizes[idx++] = *size_ptr;
+    // Keep sizes ascending regardless of directory order
+    for(std::size_t i = 1; i < idx; ++i) {
+        for(std::size_t j = i; j > 0 && caps.large_page_sizes[j - 1] > caps.large_page_sizes[j]; --j) {
+            std::size_t t                = caps.large_page_sizes[j];
+            caps.large_page_sizes[j]     = caps.large_page_sizes[j - 1];
+            caps.large_page_sizes[j - 1] = t;
+        }
     }
 
     caps.large_page_sizes[idx] = 0;  // Null terminate
@@ -192,40 +383,122 @@ inline expected<memory_region, memory_error> map_memory_impl(int file_descriptor
     int prot_flags = detail::to_prot_flags(request.access);
     int map_flags  = detail::to_map_flags(request);
 
+    // A NUMA policy only governs pages faulted after mbind, so prefault afterwards
+    const bool populate = (map_flags & MAP_POPULATE) != 0;
+    const bool numa     = request.numa != numa_policy::default_policy;
+    bool       deferred = numa && populate;
+    if(numa) map_flags &= ~static_cast<int>(MAP_POPULATE);
+
     // Handle address hint
     void* hint_addr = request.address_hint;
     if(request.placement == placement_strategy::any_address) { hint_addr = nullptr; }
 
-    // Perform the mapping
-    void* mapped_addr = ::mmap(
-      hint_addr,
-      request.length,
-      prot_flags,
-      map_flags,
-      (request.backing == backing_type::anonymous) ? -1 : file_descriptor,
-      static_cast<off_t>(request.offset));
+    const bool  anonymous   = request.backing == backing_type::anonymous;
+    const int   fd          = anonymous ? -1 : file_descriptor;
+    void*       mapped_addr = MAP_FAILED;
+    std::size_t length      = request.length;
+    std::size_t page_size   = detail::get_page_size();
+    auto        granted     = page_preference::system_default;
+
+    // Tier 1: explicit HugeTLB pages (anonymous only; needs reserved pages)
+    if(anonymous
+       && (request.page_pref == page_preference::prefer_large || request.page_pref == page_preference::require_large)) {
+        std::size_t huge = request.large_page_size ? request.large_page_size : detail::default_huge_page_size();
+        std::size_t len  = detail::round_up(request.length, huge);
+        void*       addr = ::mmap(hint_addr, len, prot_flags, map_flags | detail::huge_tlb_flags(huge), -1, 0);
+        if(addr != MAP_FAILED) {
+            mapped_addr = addr;
+            length      = len;
+            page_size   = huge;
+            granted     = page_preference::require_large;
+        } else if(request.page_pref == page_preference::require_large) {
+            return expected<memory_region, memory_error>(
+              unexpect,
+              memory_error(error_domain::feature, error_code::large_pages_unavailable, static_cast<uint8_t>(errno)));
+        }
+    }
+
+    // Tier 2: transparent huge pages on a region aligned to the THP size
+    std::size_t thp = detail::transparent_page_size();
+    if(mapped_addr == MAP_FAILED && anonymous && thp != 0
+       && (request.page_pref == page_preference::prefer_large || request.page_pref == page_preference::transparent_large)
+       && request.placement != placement_strategy::fixed_address
+       && request.placement != placement_strategy::fixed_no_replace) {
+        std::size_t len = detail::round_up(request.length, thp);
+        void*       addr =
+          detail::map_aligned(hint_addr, len, thp, prot_flags, map_flags & ~static_cast<int>(MAP_POPULATE));
+        if(addr != MAP_FAILED) {
+            mapped_addr = addr;
+            length      = len;
+#ifdef MADV_HUGEPAGE
+            if(::madvise(addr, len, MADV_HUGEPAGE) == 0) {
+                page_size = thp;
+                granted   = page_preference::transparent_large;
+            }
+#endif
+            // Prefault after the advice so faults are served with huge pages
+            deferred = populate;
+        }
+    }
 
+    // Tier 3: normal pages
+    bool durable = false;
     if(mapped_addr == MAP_FAILED) {
-        return expected<memory_region, memory_error>(unexpect, detail::make_system_error(errno));
+#if defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+        // DAX files accept MAP_SYNC; other filesystems fail with EOPNOTSUPP and get a plain shared mapping
+        if(!anonymous && request.sync == sync_semantics::durable_sync && request.sharing == sharing_mode::shared) {
+            int   flags = (map_flags & ~static_cast<int>(MAP_SHARED)) | MAP_SHARED_VALIDATE | MAP_SYNC;
+            void* addr  = ::mmap(hint_addr, request.length, prot_flags, flags, fd, static_cast<off_t>(request.offset));
+            if(addr != MAP_FAILED) {
+                mapped_addr = addr;
+                durable     = true;
+            }
+        }
+#endif
+        if(mapped_addr == MAP_FAILED) {
+            mapped_addr =
+              ::mmap(hint_addr, request.length, prot_flags, map_flags, fd, static_cast<off_t>(request.offset));
+        }
+        if(mapped_addr == MAP_FAILED) {
+            return expected<memory_region, memory_error>(unexpect, detail::make_system_error(errno));
+        }
+#ifdef MADV_HUGEPAGE
+        // File-backed large page preference is a best-effort hint (read-only file THP)
+        if(!anonymous && request.page_pref != page_preference::system_default) {
+            ::madvise(mapped_addr, request.length, MADV_HUGEPAGE);
+        }
+#endif
     }
 
     // Create region descriptor
     memory_region region;
     region.address          = mapped_addr;
-    region.length           = request.length;
-    region.actual_page_size = detail::get_page_size();
-    region.file_descriptor  = (request.backing == backing_type::anonymous) ? -1 : file_descriptor;
+    region.length           = length;
+    region.actual_page_size = page_size;
+    region.file_descriptor  = fd;
     region.file_offset      = request.offset;
     region.actual_access    = request.access;
     region.actual_sharing   = request.sharing;
-    region.actual_pages     = page_preference::system_default;  // May be updated below
+    region.actual_pages     = granted;
     region.is_locked        = false;
     region.supports_sync    = (request.backing == backing_type::file_backed);
+    region.actual_sync      = durable ? sync_semantics::durable_sync : sync_semantics::normal_sync;
 
     // Apply post-mapping operations
     bool         cleanup_needed = false;
     memory_error error;
 
+    // NUMA placement before anything below (prefault, mlock) allocates pages
+    if(numa) {
+        auto placed = detail::apply_numa_policy(mapped_addr, region.length, request.numa, request.numa_nodes);
+        if(!placed) {
+            ::munmap(mapped_addr, region.length);
+            return expected<memory_region, memory_error>(unexpect, placed.error());
+        }
+        detail::query_numa_policy(region);
+    }
+    if(deferred) detail::populate_range(mapped_addr, region.length, request.access, anonymous);
+
     // Apply memory advice for access patterns
     if(request.pattern != access_pattern::normal_access) {
         int advice = MADV_NORMAL;
@@ -235,7 +508,7 @@ inline expected<memory_region, memory_error> map_memory_impl(int file_descriptor
         default                               : break;
         }
 
-        auto advice_result = detail::apply_madvise(mapped_addr, request.length, advice);
+        auto advice_result = detail::apply_madvise(mapped_addr, region.length, advice);
         if(!advice_result && request.pattern != access_pattern::normal_access) {
             // Non-fatal, continue
         }
@@ -243,7 +516,7 @@ inline expected<memory_region, memory_error> map_memory_impl(int file_descriptor
 
     // Apply memory locking if requested
     if(request.locking != locking_strategy::no_lock) {
-        auto lock_result = detail::apply_mlock(mapped_addr, request.length, request.locking);
+        auto lock_result = detail::apply_mlock(mapped_addr, region.length, request.locking);
         if(!lock_result) {
             cleanup_needed = true;
             error          = lock_result.error();
@@ -253,23 +526,14 @@ inline expected<memory_region, memory_error> map_memory_impl(int file_descriptor
     }
 
     // Apply population hints if not already done via MAP_POPULATE
-    if(request.populate == populate_strategy::hint_needed && !(map_flags & MAP_POPULATE)) {
-        detail::apply_madvise(mapped_addr, request.length, MADV_WILLNEED);
+    if(request.populate == populate_strategy::hint_needed && !populate) {
+        detail::apply_madvise(mapped_addr, region.length, MADV_WILLNEED);
         // Non-fatal if this fails
     }
 
-    // Check for large pages if requested
-#ifdef MAP_HUGETLB
-    if(request.page_pref != page_preference::system_default) {
-        // In a real implementation, you might check /proc/self/smaps
-        // to determine if large pages were actually used
-        region.actual_pages = request.page_pref;
-    }
-#endif
-
     // Cleanup on error
     if(cleanup_needed) {
-        ::munmap(mapped_addr, request.length);
+        ::munmap(mapped_addr, region.length);
         return expected<memory_region, memory_error>(unexpect, error);
     }
 
@@ -289,6 +553,34 @@ inline expected<void, memory_error> sync_memory_impl(const memory_region& region
     return expected<void, memory_error>(unexpect, detail::make_system_error(errno));
 }
 
+inline expected<void, memory_error> sync_memory_range_impl(
+  const memory_region& region, std::size_t offset, std::size_t length, flush_mode mode) noexcept {
+    if(!region.supports_sync || region.file_descriptor < 0) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::no_such_device));
+    }
+    if(offset >= region.length) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+
+    if(length == 0) return expected<void, memory_error>();
+
+    // msync wants a page-aligned start; the end may stop mid-page
+    std::size_t page  = detail::get_page_size();
+    std::size_t begin = offset / page * page;
+    std::size_t end   = length > region.length - offset ? region.length : offset + length;
+
+    void* addr = static_cast<char*>(region.address) + begin;
+    if(::msync(addr, end - begin, mode == flush_mode::sync_flush ? MS_SYNC : MS_ASYNC) != 0) {
+        return expected<void, memory_error>(unexpect, detail::make_system_error(errno));
+    }
+    // MS_ASYNC only notes the pages on Linux; start their writeback now
+    if(mode == flush_mode::async_flush) {
+        ::sync_file_range(region.file_descriptor, static_cast<off_t>(region.file_offset + begin),
+                          static_cast<off_t>(end - begin), SYNC_FILE_RANGE_WRITE);
+    }
+    return expected<void, memory_error>();
+}
+
 inline void unmap_memory_impl(const memory_region& region) noexcept {
     if(region.address && region.length > 0) { ::munmap(region.address, region.length); }
 }
@@ -301,8 +593,18 @@ inline memory_caps query_capabilities_impl() noexcept {
 
     // Query large page support
 #ifdef MAP_HUGETLB
-    caps.supports_large_pages = true;
     detail::query_large_page_sizes(caps);
+    caps.supports_large_pages = caps.large_page_sizes[0] != 0;
+#endif
+    caps.supports_transparent_pages = detail::transparent_page_size() != 0;
+    // map_memory rounds large-page requests up to the HugeTLB or THP size; a
+    // multiple of both is mapped as asked whichever tier serves it
+    caps.large_page_granularity = std::max(detail::default_huge_page_size(), detail::transparent_page_size());
+
+    // mbind/get_mempolicy exist on NUMA kernels; seccomp profiles may still block them
+#ifdef SYS_get_mempolicy
+    int mode                  = 0;
+    caps.supports_numa_policy = ::syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0) == 0;
 #endif
 
     // Check for MAP_FIXED_NOREPLACE support (Linux >= 4.17)
@@ -315,10 +617,9 @@ inline memory_caps query_capabilities_impl() noexcept {
     caps.supports_lock_on_fault = true;
 #endif
 
-    // Check for MAP_SYNC support (requires DAX filesystem)
-#ifdef MAP_SYNC
-    // This is filesystem-dependent, so we set it optimistically
-    caps.supports_durable_sync = true;
+    // MAP_SYNC needs MAP_SHARED_VALIDATE (Linux >= 4.15); each file still needs DAX
+#if defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+    caps.supports_durable_sync = detail::validates_map_flags();
 #endif
 
     caps.supports_prefetch    = true;  // madvise(MADV_WILLNEED)
@@ -364,6 +665,113 @@ inline expected<void, memory_error>
     return detail::apply_madvise(addr, size, MADV_WILLNEED);
 }
 
+inline expected<void, memory_error>
+  discard_memory_impl(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    void*       addr = static_cast<char*>(region.address) + offset;
+    std::size_t size = (length == 0) ? (region.length - offset) : length;
+
+    if(offset >= region.length || offset + size > region.length) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+
+    return detail::apply_madvise(addr, size, MADV_DONTNEED);
+}
+
+inline expected<void, memory_error>
+  evict_memory_impl(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    if(offset >= region.length) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+    std::size_t page  = detail::get_page_size();
+    std::size_t begin = offset / page * page;
+    std::size_t size  = ((length == 0) ? (region.length - offset) : length) + (offset - begin);
+
+    auto dropped = discard_memory_impl(region, begin, size);
+    if(!dropped || region.file_descriptor < 0 || region.actual_sharing != sharing_mode::shared) return dropped;
+
+    // The mapping no longer holds the pages; drop the clean ones from the cache
+    int rc = ::posix_fadvise(region.file_descriptor, static_cast<off_t>(region.file_offset + begin),
+                             static_cast<off_t>(size), POSIX_FADV_DONTNEED);
+    if(rc != 0) return expected<void, memory_error>(unexpect, detail::make_system_error(rc));
+    return expected<void, memory_error>();
+}
+
+inline expected<void, memory_error>
+  populate_memory_impl(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    std::size_t size = (length == 0) ? (region.length - offset) : length;
+    if(offset >= region.length || offset + size > region.length) {
+        return expected<void, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+
+    // Align the start down to a page; madvise rejects anything else
+    std::size_t page  = detail::get_page_size();
+    std::size_t begin = offset / page * page;
+    char*       addr  = static_cast<char*>(region.address) + begin;
+    size += offset - begin;
+
+#ifdef MADV_POPULATE_READ
+    // Write-populating a shared file mapping would dirty every page
+    bool writable = static_cast<uint8_t>(region.actual_access) & static_cast<uint8_t>(access_mode::write);
+    int  advice   = writable && region.file_descriptor < 0 ? MADV_POPULATE_WRITE : MADV_POPULATE_READ;
+    if(::madvise(addr, size, advice) == 0) return expected<void, memory_error>();
+    if(errno != EINVAL) return expected<void, memory_error>(unexpect, detail::make_system_error(errno));
+#endif
+    // Pre-5.14 kernels: a read fault waits for the page like any other access
+    for(std::size_t at = 0; at < size; at += page) (void)static_cast<volatile const char*>(addr)[at];
+    return expected<void, memory_error>();
+}
+
+inline expected<std::size_t, memory_error> query_residency_impl(
+  const memory_region& region, std::size_t offset, std::size_t length, unsigned char* pages) noexcept {
+    if(!region.address || offset >= region.length || !pages) {
+        return expected<std::size_t, memory_error>(unexpect, memory_error(error_code::invalid_argument));
+    }
+
+    std::size_t page  = detail::get_page_size();
+    std::size_t begin = offset / page * page;
+    std::size_t end   = (length == 0 || length > region.length - offset) ? region.length : offset + length;
+    if(::mincore(static_cast<char*>(region.address) + begin, end - begin, pages) != 0) {
+        return expected<std::size_t, memory_error>(unexpect, detail::make_system_error(errno));
+    }
+
+    std::size_t count    = (end - begin + page - 1) / page;
+    std::size_t resident = 0;
+    for(std::size_t i = 0; i < count; ++i) resident += pages[i] & 1;
+    return resident;
+}
+
+inline expected<int, memory_error> create_shared_memory_impl(const char* name, std::size_t length) noexcept {
+    int fd = static_cast<int>(::syscall(SYS_memfd_create, name ? name : "shared", MFD_CLOEXEC));
+    if(fd < 0) return expected<int, memory_error>(unexpect, detail::make_system_error(errno));
+    if(::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        int err = errno;
+        ::close(fd);
+        return expected<int, memory_error>(unexpect, detail::make_system_error(err));
+    }
+    return fd;
+}
+
+// Not FUTEX_PRIVATE_FLAG: private futexes are keyed by address space, so a
+// waiter in another process would never be woken
+inline expected<bool, memory_error>
+  wait_shared_word_impl(const uint32_t* word, uint32_t value, int timeout_ms) noexcept {
+    timespec  timeout {};
+    timespec* limit = nullptr;
+    if(timeout_ms >= 0) {
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000;
+        limit           = &timeout;
+    }
+    if(::syscall(SYS_futex, word, FUTEX_WAIT, value, limit, nullptr, 0) == 0) return true;
+    if(errno == ETIMEDOUT) return false;
+    if(errno == EAGAIN || errno == EINTR) return true;  // Word already changed, or a signal
+    return expected<bool, memory_error>(unexpect, detail::make_system_error(errno));
+}
+
+inline void wake_shared_word_impl(const uint32_t* word, int count) noexcept {
+    ::syscall(SYS_futex, word, FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
 }  // namespace platform::mmap::linux_impl
 
 #endif  // __linux__
@@ -42,6 +42,7 @@ enum class error_code : uint16_t {
     broken_pipe        = 10,
     process_not_found  = 11,
     process_terminated = 12,
+    timed_out          = 13,
     not_supported      = 200,
     platform_specific  = 201
 };
@@ -70,9 +71,10 @@ using void_result = expected<void, process_error>;
 
 // Pipe modes
 enum class pipe_mode : uint8_t {
-    none    = 0,  // No pipe (inherit from parent or redirect to /dev/null)
-    pipe    = 1,  // Create pipe for bidirectional communication
-    inherit = 2   // Inherit from parent process
+    none     = 0,  // No pipe (inherit from parent or redirect to /dev/null)
+    pipe     = 1,  // Create pipe for bidirectional communication
+    inherit  = 2,  // Inherit from parent process
+    redirect = 3   // Attach to a caller-owned descriptor (spawn_request::*_fd), e.g. an output file
 };
 
 // Process creation flags
@@ -80,7 +82,8 @@ enum class spawn_flags : uint32_t {
     none              = 0x00,
     new_process_group = 0x01,  // Create new process group
     detached          = 0x02,  // Detach from parent
-    search_path       = 0x04   // Search PATH for executable
+    search_path       = 0x04,  // Search PATH for executable
+    use_fork          = 0x08   // fork()+exec instead of posix_spawn (see spawn_process)
 };
 
 // Flattened pipe handle (8 bytes)
@@ -115,16 +118,20 @@ struct process_handle {
 
 // Process spawn request (96 bytes - aligned)
 struct spawn_request {
-    const char*        executable;     // Path to executable
-    const char* const* args;           // Argument array (NULL-terminated)
-    const char* const* env;            // Environment array (NULL-terminated, nullptr = inherit)
-    const char*        working_dir;    // Working directory (nullptr = inherit)
-    pipe_mode          stdin_mode;     // stdin pipe configuration
-    pipe_mode          stdout_mode;    // stdout pipe configuration
-    pipe_mode          stderr_mode;    // stderr pipe configuration
-    uint8_t            _padding[5];    // Padding for alignment
-    spawn_flags        flags;          // Creation flags
-    uint32_t           _reserved[16];  // Reserved for future use
+    const char*        executable;      // Path to executable
+    const char* const* args;            // Argument array (NULL-terminated)
+    const char* const* env;             // Environment array (NULL-terminated, nullptr = inherit)
+    const char*        working_dir;     // Working directory (nullptr = inherit)
+    pipe_mode          stdin_mode;      // stdin pipe configuration
+    pipe_mode          stdout_mode;     // stdout pipe configuration
+    pipe_mode          stderr_mode;     // stderr pipe configuration
+    uint8_t            _padding[5];     // Padding for alignment
+    spawn_flags        flags;           // Creation flags
+    int32_t            stdin_fd;        // Descriptor for pipe_mode::redirect
+    int32_t            stdout_fd;       // Descriptor for pipe_mode::redirect
+    int32_t            stderr_fd;       // Descriptor for pipe_mode::redirect
+    int32_t            inherit_fds[4];  // Child descriptor 3 + i (-1 = unused), see inherit_fd()
+    uint32_t           _reserved[9];    // Reserved for future use
 
     constexpr spawn_request() noexcept:
         executable(nullptr),
@@ -136,7 +143,42 @@ struct spawn_request {
         stderr_mode(pipe_mode::inherit),
         _padding {},
         flags(spawn_flags::none),
+        stdin_fd(-1),
+        stdout_fd(-1),
+        stderr_fd(-1),
+        inherit_fds { -1, -1, -1, -1 },
         _reserved {} {}
+
+    // The child reads stdin from / writes stdout or stderr to fd directly, with
+    // no relay through the parent. fd stays owned by the caller; an O_APPEND file
+    // can be shared by several children.
+    constexpr void redirect_stdin(int32_t fd) noexcept {
+        stdin_mode = pipe_mode::redirect;
+        stdin_fd   = fd;
+    }
+
+    constexpr void redirect_stdout(int32_t fd) noexcept {
+        stdout_mode = pipe_mode::redirect;
+        stdout_fd   = fd;
+    }
+
+    constexpr void redirect_stderr(int32_t fd) noexcept {
+        stderr_mode = pipe_mode::redirect;
+        stderr_fd   = fd;
+    }
+
+    // Hand fd to the child, e.g. a shared memory file. Returns the descriptor
+    // number the child sees it as (3, 4, ...), or -1 when all slots are taken.
+    // fd stays owned by the caller and is not left open in other children.
+    constexpr int32_t inherit_fd(int32_t fd) noexcept {
+        for(int32_t i = 0; i < 4; ++i) {
+            if(inherit_fds[i] < 0) {
+                inherit_fds[i] = fd;
+                return 3 + i;
+            }
+        }
+        return -1;
+    }
 };
 
 // I/O request structure (32 bytes - same as file module)
@@ -170,17 +212,65 @@ struct process_caps {
     bool    supports_detach;          // Platform supports process detachment
     bool    supports_process_groups;  // Platform supports process groups
     bool    supports_search_path;     // Platform supports PATH search
-    uint8_t _padding[12];             // Reserved for future capabilities
+    bool    supports_exit_handles;    // open_exit_handle works (pidfd on Linux 5.3+)
+    uint8_t _padding[11];             // Reserved for future capabilities
 
     constexpr process_caps() noexcept:
         supports_pipes(false),
         supports_detach(false),
         supports_process_groups(false),
         supports_search_path(false),
+        supports_exit_handles(false),
         _padding {} {}
 };
 
+// Readiness multiplexer over pipes and exit handles (epoll on Linux, 8 bytes)
+struct reactor_handle {
+    int32_t  fd;     // Multiplexer descriptor
+    uint32_t flags;  // Internal flags
+
+    constexpr reactor_handle() noexcept: fd(-1), flags(0) {}
+
+    constexpr explicit reactor_handle(int32_t f, uint32_t fl = 0) noexcept: fd(f), flags(fl) {}
+
+    constexpr bool is_valid() const noexcept { return fd >= 0; }
+
+    constexpr explicit operator bool() const noexcept { return is_valid(); }
+};
+
+// Readiness bits, requested in reactor_add and reported in reactor_event::events
+enum class reactor_events : uint32_t {
+    none     = 0x00,
+    readable = 0x01,  // Data to read, or an exit handle whose process exited
+    writable = 0x02,  // Room to write
+    hangup   = 0x04,  // Peer closed; buffered data may remain readable
+    error    = 0x08,  // Error condition on the descriptor
+    oneshot  = 0x10   // Interest only: report once, then disarm until reactor_modify
+};
+
+constexpr reactor_events operator|(reactor_events a, reactor_events b) noexcept {
+    return static_cast<reactor_events>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+constexpr bool has_event(reactor_events set, reactor_events bit) noexcept {
+    return (static_cast<uint32_t>(set) & static_cast<uint32_t>(bit)) != 0;
+}
+
+// One readiness notification (16 bytes)
+struct reactor_event {
+    uint64_t       token;     // Value given to reactor_add
+    reactor_events events;    // What is ready
+    uint32_t       _padding;  // Padding for alignment
+
+    constexpr reactor_event() noexcept: token(0), events(reactor_events::none), _padding(0) {}
+};
+
 // Core process operations - to be implemented per platform
+
+// Spawn request.executable. On Linux this uses posix_spawn, whose cost does not
+// grow with the parent's memory size; exec failures (missing executable, no
+// permission) are returned as errors. spawn_flags::use_fork selects fork()+exec,
+// where exec failures show up as the child exiting with 127.
 expected<process_handle, process_error> spawn_process(
   const spawn_request& request,
   pipe_handle*         stdin_pipe,
@@ -200,9 +290,53 @@ expected<io_result, process_error> write_pipe(const pipe_handle& pipe, const io_
 
 expected<void, process_error> close_pipe(pipe_handle& pipe) noexcept;
 
+// Block until the pipe is readable/writable (or its peer closed) or timeout_ms
+// elapses (-1 = forever); returns false on timeout
+expected<bool, process_error> wait_pipe(const pipe_handle& pipe, bool writable, int timeout_ms) noexcept;
+
 // Capability query
 process_caps query_process_caps() noexcept;
 
+// Exit notification: a descriptor that becomes readable when the process exits
+// (pidfd on Linux). It does not reap; wait_process still collects the status.
+expected<pipe_handle, process_error> open_exit_handle(const process_handle& handle) noexcept;
+
+// Readiness multiplexing - level-triggered unless reactor_events::oneshot is given
+expected<reactor_handle, process_error> create_reactor() noexcept;
+
+expected<void, process_error> destroy_reactor(reactor_handle& reactor) noexcept;
+
+expected<void, process_error>
+  reactor_add(const reactor_handle& reactor, int32_t fd, uint64_t token, reactor_events interest) noexcept;
+
+expected<void, process_error>
+  reactor_modify(const reactor_handle& reactor, int32_t fd, uint64_t token, reactor_events interest) noexcept;
+
+expected<void, process_error> reactor_remove(const reactor_handle& reactor, int32_t fd) noexcept;
+
+// Wait up to timeout_ms (-1 = forever, 0 = poll) for at least one event and
+// return how many were stored; 0 on timeout or signal interruption.
+expected<size_t, process_error>
+  reactor_wait(const reactor_handle& reactor, reactor_event* events, size_t max_count, int timeout_ms) noexcept;
+
+// Event sources for a reactor, closed with close_pipe. A wakeup handle
+// (eventfd) becomes readable once signal_wakeup is called from any thread; a
+// timer handle (timerfd) once the monotonic clock passes the armed deadline.
+// Both are non-blocking and stay readable until drained.
+expected<pipe_handle, process_error> open_wakeup_handle() noexcept;
+
+expected<void, process_error> signal_wakeup(const pipe_handle& wakeup) noexcept;
+
+expected<pipe_handle, process_error> open_timer_handle() noexcept;
+
+// Fire at deadline_ns on the steady (CLOCK_MONOTONIC) clock; 0 disarms.
+// A deadline already past fires immediately.
+expected<void, process_error> arm_timer(const pipe_handle& timer, uint64_t deadline_ns) noexcept;
+
+// Reset a wakeup or timer handle; returns the signals or expirations since
+// the last drain (0 when it was not readable)
+expected<uint64_t, process_error> drain_event_handle(const pipe_handle& handle) noexcept;
+
 }  // namespace platform::process
 
 #endif  // PLATFORM_PROCESS_HPP
@@ -8,7 +8,13 @@
 #include <cerrno>
 #include <cstring>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -79,8 +85,32 @@ expected<io_result, process_error> write_pipe_impl(const pipe_handle& pipe, cons
 
 expected<void, process_error> close_pipe_impl(pipe_handle& pipe) noexcept;
 
+expected<bool, process_error> wait_pipe_impl(const pipe_handle& pipe, bool writable, int timeout_ms) noexcept;
+
 process_caps query_process_caps_impl() noexcept;
 
+expected<pipe_handle, process_error> open_exit_handle_impl(const process_handle& handle) noexcept;
+
+expected<reactor_handle, process_error> create_reactor_impl() noexcept;
+
+expected<void, process_error> destroy_reactor_impl(reactor_handle& reactor) noexcept;
+
+expected<void, process_error>
+  reactor_control_impl(const reactor_handle& reactor, int op, int32_t fd, uint64_t token, reactor_events interest) noexcept;
+
+expected<size_t, process_error>
+  reactor_wait_impl(const reactor_handle& reactor, reactor_event* events, size_t max_count, int timeout_ms) noexcept;
+
+expected<pipe_handle, process_error> open_wakeup_handle_impl() noexcept;
+
+expected<void, process_error> signal_wakeup_impl(const pipe_handle& wakeup) noexcept;
+
+expected<pipe_handle, process_error> open_timer_handle_impl() noexcept;
+
+expected<void, process_error> arm_timer_impl(const pipe_handle& timer, uint64_t deadline_ns) noexcept;
+
+expected<uint64_t, process_error> drain_event_handle_impl(const pipe_handle& handle) noexcept;
+
 }  // namespace platform::process::linux_impl
 
 #endif  // __linux__
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Run the asyncle benchmarks and compare them with a baseline.
+
+Usage:
+  ./scripts/bench-compare.py run --build-dir build-bench --out results.json
+  ./scripts/bench-compare.py compare baseline.json results.json --max-regression=15
+
+`run` executes each bench_* binary with --format=json (suite-specific
+arguments after `--` are passed to every binary) and writes one JSON file with
+all suites. With --repeat=N every binary runs N times and each case keeps its
+fastest run, which filters out most scheduler noise on shared machines.
+
+`compare` matches cases by suite and name and fails (exit 1) when a case's
+ns_per_op grew by more than --max-regression percent. Cases faster than
+--min-ns in the baseline are reported but never fail: timer and loop overhead
+dominate them. Cases present on only one side are listed and ignored, so adding
+a benchmark never breaks the comparison.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+DEFAULT_BENCHES = ["bench_concurrent", "bench_hardware"]
+
+
+def run_suites(args):
+    suites = {}
+    for bench in args.bench or DEFAULT_BENCHES:
+        binary = os.path.join(args.build_dir, bench)
+        if not os.access(binary, os.X_OK):
+            print(f"skipping {bench}: {binary} not built", file=sys.stderr)
+            continue
+        command = [binary, "--format=json", f"--min-time={args.min_time}"] + args.extra
+        if args.filter:
+            command.append(f"--filter={args.filter}")
+        for attempt in range(args.repeat):
+            print(f"running {' '.join(command)} ({attempt + 1}/{args.repeat})", file=sys.stderr)
+            output = subprocess.run(command, check=True, capture_output=True, text=True).stdout
+            report = json.loads(output)
+            suite = suites.setdefault(report["suite"], {"suite": report["suite"], "context": report["context"],
+                                                        "results": {}})
+            for case in report["results"]:
+                best = suite["results"].get(case["name"])
+                if best is None or case["ns_per_op"] < best["ns_per_op"]:
+                    suite["results"][case["name"]] = case
+    merged = {"suites": [dict(s, results=list(s["results"].values())) for s in suites.values()]}
+    with open(args.out, "w") as out:
+        json.dump(merged, out, indent=1)
+        out.write("\n")
+    return 0
+
+
+def load_cases(path):
+    with open(path) as f:
+        report = json.load(f)
+    # A single suite's --format=json output is accepted as well
+    suites = report["suites"] if "suites" in report else [report]
+    return {(s["suite"], case["name"]): case for s in suites for case in s["results"]}
+
+
+def compare(args):
+    baseline = load_cases(args.baseline)
+    current = load_cases(args.current)
+
+    regressions = []
+    print(f"{'case':<56} {'baseline ns':>14} {'current ns':>14} {'change':>9}")
+    for key in sorted(baseline.keys() & current.keys()):
+        before = baseline[key]["ns_per_op"]
+        after = current[key]["ns_per_op"]
+        change = (after - before) / before * 100 if before > 0 else 0.0
+        status = ""
+        if change > args.max_regression:
+            if before >= args.min_ns:
+                status = "  REGRESSION"
+                regressions.append(key)
+            else:
+                status = "  (below --min-ns)"
+        name = f"{key[0]}/{key[1]}"
+        print(f"{name:<56} {before:>14.1f} {after:>14.1f} {change:>+8.1f}%{status}")
+
+    for key in sorted(baseline.keys() - current.keys()):
+        print(f"{key[0]}/{key[1]}: missing from {args.current}")
+    for key in sorted(current.keys() - baseline.keys()):
+        print(f"{key[0]}/{key[1]}: new, no baseline")
+
+    if regressions:
+        print(f"\n{len(regressions)} case(s) slower than baseline by more than {args.max_regression}%")
+        return 1
+    print(f"\nNo case regressed by more than {args.max_regression}%")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    run = commands.add_parser("run", help="run benchmarks and write their results as JSON")
+    run.add_argument("--build-dir", default="build-bench")
+    run.add_argument("--out", required=True)
+    run.add_argument("--bench", action="append", help=f"binary to run (repeatable, default {DEFAULT_BENCHES})")
+    run.add_argument("--filter", help="passed to every binary as --filter")
+    run.add_argument("--min-time", type=float, default=200, help="per-case time budget in ms")
+    run.add_argument("--repeat", type=int, default=1, help="runs per binary; the fastest result per case is kept")
+    run.add_argument("extra", nargs="*", help="suite settings after --, e.g. -- --threads=1,2 --table-size=64")
+
+    cmp = commands.add_parser("compare", help="fail when results regressed against a baseline")
+    cmp.add_argument("baseline")
+    cmp.add_argument("current")
+    cmp.add_argument("--max-regression", type=float, default=10, help="allowed ns_per_op growth in percent")
+    cmp.add_argument("--min-ns", type=float, default=50, help="baseline ns_per_op below which cases never fail")
+
+    args = parser.parse_args()
+    return run_suites(args) if args.command == "run" else compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
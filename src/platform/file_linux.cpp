@@ -34,6 +34,28 @@ expected<uint64_t, file_error> get_file_size(const file_handle& handle) noexcept
     return linux_impl::get_file_size_impl(handle);
 }
 
+expected<file_handle, file_error> open_directory(const char* path) noexcept {
+    return linux_impl::open_directory_impl(path);
+}
+
+expected<size_t, file_error> read_directory(const file_handle& dir, void* buffer, size_t size) noexcept {
+    return linux_impl::read_directory_impl(dir, buffer, size);
+}
+
+bool next_directory_entry(const void* buffer, size_t filled, size_t& offset, dir_entry& entry) noexcept {
+    return linux_impl::next_directory_entry_impl(buffer, filled, offset, entry);
+}
+
+expected<size_t, file_error> stat_batch(
+  const file_handle& dir,
+  const char* const* names,
+  size_t             count,
+  file_info*         infos,
+  file_error*        errors,
+  ring_handle*       ring) noexcept {
+    return linux_impl::stat_batch_impl(dir, names, count, infos, errors, ring);
+}
+
 expected<io_result, file_error> read_file(const file_handle& handle, const io_request& request) noexcept {
     return linux_impl::read_file_impl(handle, request);
 }
@@ -94,6 +116,10 @@ expected<void, file_error>
     return linux_impl::advise_file_impl(handle, offset, length, advice);
 }
 
+expected<void, file_error> readahead_file(const file_handle& handle, uint64_t offset, uint64_t length) noexcept {
+    return linux_impl::readahead_file_impl(handle, offset, length);
+}
+
 expected<size_t, file_error> splice_files(
   const file_handle& in,
   uint64_t*          in_offset,
@@ -109,6 +135,79 @@ expected<size_t, file_error>
     return linux_impl::sendfile_op_impl(out, in, offset, count);
 }
 
+expected<size_t, file_error> copy_file_range_op(
+  const file_handle& in,
+  uint64_t*          in_offset,
+  const file_handle& out,
+  uint64_t*          out_offset,
+  size_t             length) noexcept {
+    return linux_impl::copy_file_range_impl(in, in_offset, out, out_offset, length);
+}
+
+expected<void, file_error> create_pipe(file_handle& read_end, file_handle& write_end) noexcept {
+    return linux_impl::create_pipe_impl(read_end, write_end);
+}
+
+expected<size_t, file_error> set_pipe_size(const file_handle& pipe, size_t size) noexcept {
+    return linux_impl::set_pipe_size_impl(pipe, size);
+}
+
+expected<file_handle, file_error> create_memory_file(const char* name, uint64_t size) noexcept {
+    return linux_impl::create_memory_file_impl(name, size);
+}
+
+expected<size_t, file_error>
+  vmsplice_op(const file_handle& pipe, const void* data, size_t length, uint32_t flags) noexcept {
+    return linux_impl::vmsplice_op_impl(pipe, data, length, flags);
+}
+
+expected<bool, file_error> wait_ready(const file_handle& handle, bool writable, int timeout_ms) noexcept {
+    return linux_impl::wait_ready_impl(handle, writable, timeout_ms);
+}
+
+expected<ring_handle, file_error> create_ring(const ring_request& request) noexcept {
+    return linux_impl::create_ring_impl(request);
+}
+
+void destroy_ring(ring_handle& ring) noexcept { linux_impl::destroy_ring_impl(ring); }
+
+ring_status query_ring(const ring_handle& ring) noexcept { return linux_impl::query_ring_impl(ring); }
+
+expected<size_t, file_error> queue_ring(
+  ring_handle&       ring,
+  const file_handle& handle,
+  ring_op            op,
+  const io_request*  requests,
+  size_t             count,
+  uint64_t           user_data) noexcept {
+    return linux_impl::queue_ring_impl(ring, handle, op, requests, count, user_data);
+}
+
+expected<size_t, file_error> submit_ring(ring_handle& ring, size_t wait_for) noexcept {
+    return linux_impl::submit_ring_impl(ring, wait_for);
+}
+
+expected<size_t, file_error>
+  reap_ring(ring_handle& ring, io_completion* completions, size_t max_count, size_t min_count) noexcept {
+    return linux_impl::reap_ring_impl(ring, completions, max_count, min_count);
+}
+
+expected<void, file_error> register_ring_buffers(ring_handle& ring, const ring_buffer* buffers, size_t count) noexcept {
+    return linux_impl::register_ring_buffers_impl(ring, buffers, count);
+}
+
+expected<void, file_error> unregister_ring_buffers(ring_handle& ring) noexcept {
+    return linux_impl::unregister_ring_buffers_impl(ring);
+}
+
+expected<void, file_error> register_ring_eventfd(ring_handle& ring, int32_t fd) noexcept {
+    return linux_impl::register_ring_eventfd_impl(ring, fd);
+}
+
+expected<dio_alignment, file_error> query_dio_alignment(const file_handle& handle) noexcept {
+    return linux_impl::query_dio_alignment_impl(handle);
+}
+
 file_caps query_file_caps() noexcept { return linux_impl::query_file_caps_impl(); }
 
 }  // namespace platform::file
@@ -144,6 +243,28 @@ expected<uint64_t, file_error> get_file_size(const file_handle& handle) noexcept
     return expected<uint64_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
 }
 
+expected<file_handle, file_error> open_directory(const char* path) noexcept {
+    return expected<file_handle, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<size_t, file_error> read_directory(const file_handle& dir, void* buffer, size_t size) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+bool next_directory_entry(const void* buffer, size_t filled, size_t& offset, dir_entry& entry) noexcept {
+    return false;
+}
+
+expected<size_t, file_error> stat_batch(
+  const file_handle& dir,
+  const char* const* names,
+  size_t             count,
+  file_info*         infos,
+  file_error*        errors,
+  ring_handle*       ring) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
 expected<io_result, file_error> read_file(const file_handle& handle, const io_request& request) noexcept {
     return expected<io_result, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
 }
@@ -204,6 +325,10 @@ expected<void, file_error>
     return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
 }
 
+expected<void, file_error> readahead_file(const file_handle& handle, uint64_t offset, uint64_t length) noexcept {
+    return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
 expected<size_t, file_error> splice_files(
   const file_handle& in,
   uint64_t*          in_offset,
@@ -219,6 +344,75 @@ expected<size_t, file_error>
     return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
 }
 
+expected<size_t, file_error> copy_file_range_op(
+  const file_handle& in,
+  uint64_t*          in_offset,
+  const file_handle& out,
+  uint64_t*          out_offset,
+  size_t             length) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, file_error> create_pipe(file_handle& read_end, file_handle& write_end) noexcept {
+    return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<size_t, file_error> set_pipe_size(const file_handle& pipe, size_t size) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<size_t, file_error>
+  vmsplice_op(const file_handle& pipe, const void* data, size_t length, uint32_t flags) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<bool, file_error> wait_ready(const file_handle& handle, bool writable, int timeout_ms) noexcept {
+    return expected<bool, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<ring_handle, file_error> create_ring(const ring_request& request) noexcept {
+    return expected<ring_handle, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+void destroy_ring(ring_handle& ring) noexcept { ring = ring_handle {}; }
+
+ring_status query_ring(const ring_handle& ring) noexcept { return ring_status {}; }
+
+expected<size_t, file_error> queue_ring(
+  ring_handle&       ring,
+  const file_handle& handle,
+  ring_op            op,
+  const io_request*  requests,
+  size_t             count,
+  uint64_t           user_data) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<size_t, file_error> submit_ring(ring_handle& ring, size_t wait_for) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<size_t, file_error>
+  reap_ring(ring_handle& ring, io_completion* completions, size_t max_count, size_t min_count) noexcept {
+    return expected<size_t, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, file_error> register_ring_buffers(ring_handle& ring, const ring_buffer* buffers, size_t count) noexcept {
+    return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, file_error> unregister_ring_buffers(ring_handle& ring) noexcept {
+    return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, file_error> register_ring_eventfd(ring_handle& ring, int32_t fd) noexcept {
+    return expected<void, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<dio_alignment, file_error> query_dio_alignment(const file_handle& handle) noexcept {
+    return expected<dio_alignment, file_error>(unexpect, file_error(error_domain::platform, error_code::not_supported));
+}
+
 file_caps query_file_caps() noexcept { return file_caps {}; }
 
 }  // namespace platform::file
@@ -1,12 +1,93 @@
 #ifdef __linux__
 
 #include "../../include/platform/hardware.hpp"
+#include "../../include/platform/hardware_x86.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <pthread.h>
+#include <sched.h>
 #include <string>
+#include <sys/resource.h>
+#include <sys/sysinfo.h>
 #include <unistd.h>
+#include <vector>
+
+#if defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
 
 namespace platform::hardware {
 
+namespace {
+
+const char* const cpu_root  = "/sys/devices/system/cpu";
+const char* const node_root = "/sys/devices/system/node";
+
+// First line of a sysfs file, empty if unreadable
+std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string   line;
+    if(in) std::getline(in, line);
+    return line;
+}
+
+long read_number(const std::string& path, long fallback) {
+    std::string text = read_line(path);
+    if(text.empty()) return fallback;
+    char* end   = nullptr;
+    long  value = std::strtol(text.c_str(), &end, 10);
+    return end == text.c_str() ? fallback : value;
+}
+
+// Kernel CPU/node list format: "0-3,8,10-11"
+std::vector<uint32_t> parse_id_list(const std::string& text) {
+    std::vector<uint32_t> ids;
+    const char*           p = text.c_str();
+    while(*p) {
+        char*         end   = nullptr;
+        unsigned long first = std::strtoul(p, &end, 10);
+        if(end == p) break;
+        unsigned long last = first;
+        p                  = end;
+        if(*p == '-') {
+            last = std::strtoul(p + 1, &end, 10);
+            p    = end;
+        }
+        for(unsigned long id = first; id <= last; ++id) ids.push_back(static_cast<uint32_t>(id));
+        while(*p == ',' || *p == '\n' || *p == ' ') ++p;
+    }
+    return ids;
+}
+
+// Cache size file format: "32K", "2048K", "8M"
+uint32_t parse_kib(const std::string& text) {
+    char*         end   = nullptr;
+    unsigned long value = std::strtoul(text.c_str(), &end, 10);
+    if(end == text.c_str()) return 0;
+    if(*end == 'M') value *= 1024;
+    else if(*end != 'K') value /= 1024;
+    return static_cast<uint32_t>(value);
+}
+
+// Dense index for a key, in order of first appearance
+uint32_t dense_id(std::vector<long>& keys, long key) {
+    auto it = std::find(keys.begin(), keys.end(), key);
+    if(it != keys.end()) return static_cast<uint32_t>(it - keys.begin());
+    keys.push_back(key);
+    return static_cast<uint32_t>(keys.size() - 1);
+}
+
+std::vector<uint32_t> online_nodes() {
+    auto nodes = parse_id_list(read_line(std::string(node_root) + "/online"));
+    if(nodes.empty()) nodes.push_back(0);  // Kernel without NUMA support
+    return nodes;
+}
+
+}  // namespace
+
 cache_info detect_cache_info() noexcept {
     cache_info info;
 
@@ -107,6 +188,311 @@ cache_info detect_cache_info() noexcept {
     return info;
 }
 
+cpu_feature_set detect_cpu_features() noexcept {
+    cpu_feature_set features;
+#if defined(__x86_64__) || defined(__i386__)
+    x86_impl::probe_x86_features(features);
+#elif defined(__aarch64__)
+    unsigned long hwcap  = getauxval(AT_HWCAP);
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    features.set(cpu_feature::neon, hwcap & HWCAP_ASIMD);
+    features.set(cpu_feature::fp16, hwcap & HWCAP_ASIMDHP);
+    features.set(cpu_feature::dotprod, hwcap & HWCAP_ASIMDDP);
+    features.set(cpu_feature::sve, hwcap & HWCAP_SVE);
+    features.set(cpu_feature::arm_aes, hwcap & HWCAP_AES);
+    features.set(cpu_feature::arm_pmull, hwcap & HWCAP_PMULL);
+    features.set(cpu_feature::arm_sha1, hwcap & HWCAP_SHA1);
+    features.set(cpu_feature::arm_sha2, hwcap & HWCAP_SHA2);
+    features.set(cpu_feature::arm_sha512, hwcap & HWCAP_SHA512);
+    features.set(cpu_feature::arm_crc32, hwcap & HWCAP_CRC32);
+    features.set(cpu_feature::lse, hwcap & HWCAP_ATOMICS);
+#ifdef HWCAP2_SVE2
+    features.set(cpu_feature::sve2, hwcap2 & HWCAP2_SVE2);
+#else
+    (void)hwcap2;
+#endif
+#endif
+    return features;
+}
+
+size_t detect_cpu_topology(cpu_location* cpus, size_t max_count) noexcept {
+    try {
+        std::vector<uint32_t> online = parse_id_list(read_line(std::string(cpu_root) + "/online"));
+        if(online.empty()) {
+            long count = sysconf(_SC_NPROCESSORS_ONLN);
+            for(long i = 0; i < (count > 0 ? count : 1); ++i) online.push_back(static_cast<uint32_t>(i));
+        }
+
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        // Node of each CPU, from the node side (cpuN/nodeM links are not always present)
+        std::vector<uint32_t> node_of;
+        for(uint32_t node : online_nodes()) {
+            std::string cpulist = read_line(std::string(node_root) + "/node" + std::to_string(node) + "/cpulist");
+            for(uint32_t cpu : parse_id_list(cpulist)) {
+                if(cpu >= node_of.size()) node_of.resize(cpu + 1, node);
+                node_of[cpu] = node;
+            }
+        }
+
+        std::vector<long> packages, cores, l2_groups, l3_groups;
+        for(size_t i = 0; i < online.size() && i < max_count; ++i) {
+            uint32_t     cpu  = online[i];
+            std::string  base = std::string(cpu_root) + "/cpu" + std::to_string(cpu);
+            cpu_location loc {};
+            loc.cpu           = cpu;
+            loc.node          = cpu < node_of.size() ? node_of[cpu] : 0;
+            loc.allowed       = !have_mask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+
+            long package = read_number(base + "/topology/physical_package_id", 0);
+            loc.package  = dense_id(packages, package < 0 ? 0 : package);
+
+            // A core is identified by its first hardware thread
+            auto siblings = parse_id_list(read_line(base + "/topology/thread_siblings_list"));
+            if(siblings.empty()) siblings.push_back(cpu);
+            auto position = std::find(siblings.begin(), siblings.end(), cpu);
+            loc.core      = dense_id(cores, siblings.front());
+            loc.smt_index = static_cast<uint16_t>(position == siblings.end() ? 0 : position - siblings.begin());
+
+            // Unified/data caches per level, grouped by their first sharing CPU
+            long l2_key = -1, l3_key = -1;
+            for(int index = 0;; ++index) {
+                std::string cache = base + "/cache/index" + std::to_string(index);
+                long        level = read_number(cache + "/level", -1);
+                if(level < 0) break;
+                if(read_line(cache + "/type") == "Instruction" || (level != 2 && level != 3)) continue;
+
+                auto     sharing = parse_id_list(read_line(cache + "/shared_cpu_list"));
+                long     key     = sharing.empty() ? cpu : sharing.front();
+                uint32_t kib     = parse_kib(read_line(cache + "/size"));
+                if(level == 2) {
+                    l2_key     = key;
+                    loc.l2_kib = kib;
+                } else {
+                    l3_key     = key;
+                    loc.l3_kib = kib;
+                }
+            }
+            // Without cache data, assume private L2 per core and one LLC per package
+            loc.l2_domain = dense_id(l2_groups, l2_key >= 0 ? l2_key : static_cast<long>(siblings.front()));
+            loc.l3_domain = dense_id(l3_groups, l3_key >= 0 ? l3_key : -1 - static_cast<long>(loc.package));
+
+            cpus[i] = loc;
+        }
+        return online.size();
+    } catch(...) {
+        return 0;
+    }
+}
+
+size_t detect_numa_nodes(numa_node_info* nodes, size_t max_count) noexcept {
+    try {
+        auto ids = online_nodes();
+        for(size_t i = 0; i < ids.size() && i < max_count; ++i) {
+            numa_node_info info {};
+            info.node = ids[i];
+
+            std::string base = std::string(node_root) + "/node" + std::to_string(ids[i]);
+            info.cpu_count   = static_cast<uint32_t>(parse_id_list(read_line(base + "/cpulist")).size());
+
+            // "Node 0 MemTotal:       6158152 kB"
+            std::ifstream meminfo(base + "/meminfo");
+            std::string   line;
+            while(std::getline(meminfo, line)) {
+                auto field = [&](const char* name, uint64_t& out) {
+                    auto at = line.find(name);
+                    if(at == std::string::npos) return;
+                    out = std::strtoull(line.c_str() + at + std::strlen(name), nullptr, 10) * 1024;
+                };
+                field("MemTotal:", info.total_memory);
+                field("MemFree:", info.free_memory);
+            }
+
+            // No node directory: a kernel without NUMA, so the whole machine is node 0
+            if(!meminfo.is_open() && ids.size() == 1) {
+                struct sysinfo si {};
+                if(sysinfo(&si) == 0) {
+                    info.total_memory = static_cast<uint64_t>(si.totalram) * si.mem_unit;
+                    info.free_memory  = static_cast<uint64_t>(si.freeram) * si.mem_unit;
+                }
+                long online    = sysconf(_SC_NPROCESSORS_ONLN);
+                info.cpu_count = online > 0 ? static_cast<uint32_t>(online) : 1;
+            }
+            nodes[i] = info;
+        }
+        return ids.size();
+    } catch(...) {
+        return 0;
+    }
+}
+
+uint32_t numa_distance(uint32_t from, uint32_t to) noexcept {
+    try {
+        // nodeN/distance lists the cost to every online node, in node order
+        auto ids      = online_nodes();
+        auto position = std::find(ids.begin(), ids.end(), to);
+        if(position == ids.end()) return 0;
+
+        std::string   text = read_line(std::string(node_root) + "/node" + std::to_string(from) + "/distance");
+        const char*   p    = text.c_str();
+        char*         end  = nullptr;
+        unsigned long cost = 0;
+        for(long i = 0; i <= position - ids.begin(); ++i) {
+            cost = std::strtoul(p, &end, 10);
+            if(end == p) return from == to ? 10 : 0;
+            p = end;
+        }
+        return static_cast<uint32_t>(cost);
+    } catch(...) {
+        return 0;
+    }
+}
+
+size_t available_cpus(size_t* cpus, size_t max_count) noexcept {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0) {
+        long   online = sysconf(_SC_NPROCESSORS_ONLN);
+        size_t count  = online > 0 ? static_cast<size_t>(online) : 1;
+        for(size_t i = 0; i < count && i < max_count; ++i) { cpus[i] = i; }
+        return count;
+    }
+
+    size_t count = 0;
+    for(size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if(!CPU_ISSET(cpu, &set)) continue;
+        if(count < max_count) cpus[count] = cpu;
+        ++count;
+    }
+    return count;
+}
+
+bool pin_current_thread(size_t cpu) noexcept {
+    if(cpu > UINT32_MAX) return false;
+    uint32_t id = static_cast<uint32_t>(cpu);
+    return set_thread_affinity(pthread_self(), &id, 1);
+}
+
+namespace {
+
+// The kernel caps NR_CPUS at 8192; anything past this is a caller bug, not a CPU
+constexpr size_t max_cpu_ids = 65536;
+
+// Heap cpu_set_t, so masks are not limited to CPU_SETSIZE (1024) CPUs
+struct cpu_mask {
+    cpu_set_t* set;
+    size_t     bytes;
+
+    explicit cpu_mask(size_t cpus) noexcept: set(CPU_ALLOC(cpus)), bytes(CPU_ALLOC_SIZE(cpus)) {
+        if(set) CPU_ZERO_S(bytes, set);
+    }
+
+    ~cpu_mask() {
+        if(set) CPU_FREE(set);
+    }
+
+    cpu_mask(const cpu_mask&)            = delete;
+    cpu_mask& operator=(const cpu_mask&) = delete;
+};
+
+int to_policy(sched_class cls) noexcept {
+    switch(cls) {
+    case sched_class::batch      : return SCHED_BATCH;
+    case sched_class::idle       : return SCHED_IDLE;
+    case sched_class::fifo       : return SCHED_FIFO;
+    case sched_class::round_robin: return SCHED_RR;
+    default                      : return SCHED_OTHER;
+    }
+}
+
+sched_class from_policy(int policy) noexcept {
+    switch(policy & ~SCHED_RESET_ON_FORK) {
+    case SCHED_BATCH: return sched_class::batch;
+    case SCHED_IDLE : return sched_class::idle;
+    case SCHED_FIFO : return sched_class::fifo;
+    case SCHED_RR   : return sched_class::round_robin;
+    default         : return sched_class::normal;
+    }
+}
+
+}  // namespace
+
+thread_handle current_thread_handle() noexcept { return pthread_self(); }
+
+bool set_thread_affinity(thread_handle thread, const uint32_t* cpus, size_t count) noexcept {
+    if(count == 0) return false;
+    uint32_t highest = *std::max_element(cpus, cpus + count);
+    if(highest >= max_cpu_ids) return false;
+
+    cpu_mask mask(std::max<size_t>(highest + 1, CPU_SETSIZE));
+    if(!mask.set) return false;
+    for(size_t i = 0; i < count; ++i) CPU_SET_S(cpus[i], mask.bytes, mask.set);
+    return pthread_setaffinity_np(thread, mask.bytes, mask.set) == 0;
+}
+
+size_t get_thread_affinity(thread_handle thread, uint32_t* cpus, size_t max_count) noexcept {
+    // EINVAL means the kernel mask is wider than ours
+    for(size_t width = CPU_SETSIZE; width <= max_cpu_ids; width *= 2) {
+        cpu_mask mask(width);
+        if(!mask.set) return 0;
+        int rc = pthread_getaffinity_np(thread, mask.bytes, mask.set);
+        if(rc == EINVAL) continue;
+        if(rc != 0) return 0;
+
+        size_t count = 0;
+        for(size_t cpu = 0; cpu < width; ++cpu) {
+            if(!CPU_ISSET_S(cpu, mask.bytes, mask.set)) continue;
+            if(count < max_count) cpus[count] = static_cast<uint32_t>(cpu);
+            ++count;
+        }
+        return count;
+    }
+    return 0;
+}
+
+bool current_cpu(cpu_position& out) noexcept {
+    unsigned cpu = 0, node = 0;
+    if(getcpu(&cpu, &node) != 0) return false;
+    out.cpu  = cpu;
+    out.node = node;
+    return true;
+}
+
+bool set_thread_scheduling(thread_handle thread, sched_class cls, int priority) noexcept {
+    int         policy   = to_policy(cls);
+    bool        realtime = cls == sched_class::fifo || cls == sched_class::round_robin;
+    bool        self     = pthread_equal(thread, pthread_self());
+    sched_param param {};
+    if(realtime) {
+        param.sched_priority = std::clamp(priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    } else if(priority != 0 && !self) {
+        return false;  // Nice values are per kernel task; only the caller's tid is known
+    }
+    if(pthread_setschedparam(thread, policy, &param) != 0) return false;
+    if(realtime || !self) return true;
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), std::clamp(priority, -20, 19)) == 0;
+}
+
+bool get_thread_scheduling(thread_handle thread, thread_scheduling& out) noexcept {
+    int         policy = 0;
+    sched_param param {};
+    if(pthread_getschedparam(thread, &policy, &param) != 0) return false;
+    out.cls      = from_policy(policy);
+    out.priority = param.sched_priority;
+    if(out.cls != sched_class::fifo && out.cls != sched_class::round_robin) {
+        out.priority = 0;
+        if(pthread_equal(thread, pthread_self())) {
+            errno    = 0;
+            int nice = getpriority(PRIO_PROCESS, static_cast<id_t>(gettid()));
+            if(nice == -1 && errno != 0) return false;
+            out.priority = nice;
+        }
+    }
+    return true;
+}
+
 }  // namespace platform::hardware
 
 #endif  // __linux__
@@ -1,6 +1,12 @@
 #ifdef __APPLE__
 
 #include "../../include/platform/hardware.hpp"
+#include "../../include/platform/hardware_x86.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/sysctl.h>
+#include <thread>
 
 namespace platform::hardware {
 
@@ -13,6 +19,158 @@ cache_info detect_cache_info() noexcept {
     return info;
 }
 
+namespace {
+
+bool sysctl_flag(const char* name) noexcept {
+    int    value  = 0;
+    size_t length = sizeof(value);
+    return sysctlbyname(name, &value, &length, nullptr, 0) == 0 && value != 0;
+}
+
+uint64_t sysctl_number(const char* name, uint64_t fallback) noexcept {
+    uint64_t value  = 0;
+    size_t   length = sizeof(value);
+    if(sysctlbyname(name, &value, &length, nullptr, 0) != 0 || length == 0) return fallback;
+    if(length == sizeof(uint32_t)) value &= 0xffffffffu;
+    return value;
+}
+
+}  // namespace
+
+cpu_feature_set detect_cpu_features() noexcept {
+    cpu_feature_set features;
+#if defined(__x86_64__)
+    x86_impl::probe_x86_features(features);
+#elif defined(__aarch64__)
+    // Apple Silicon has no SVE; every M-series core has NEON, CRC32 and LSE
+    features.set(cpu_feature::neon, true);
+    features.set(cpu_feature::fp16, sysctl_flag("hw.optional.arm.FEAT_FP16"));
+    features.set(cpu_feature::dotprod, sysctl_flag("hw.optional.arm.FEAT_DotProd"));
+    features.set(cpu_feature::arm_aes, sysctl_flag("hw.optional.arm.FEAT_AES"));
+    features.set(cpu_feature::arm_pmull, sysctl_flag("hw.optional.arm.FEAT_PMULL"));
+    features.set(cpu_feature::arm_sha1, sysctl_flag("hw.optional.arm.FEAT_SHA1"));
+    features.set(cpu_feature::arm_sha2, sysctl_flag("hw.optional.arm.FEAT_SHA256"));
+    features.set(cpu_feature::arm_sha512, sysctl_flag("hw.optional.arm.FEAT_SHA512"));
+    features.set(cpu_feature::arm_crc32, sysctl_flag("hw.optional.armv8_crc32"));
+    features.set(cpu_feature::lse, sysctl_flag("hw.optional.arm.FEAT_LSE"));
+#endif
+    return features;
+}
+
+size_t detect_cpu_topology(cpu_location* cpus, size_t max_count) noexcept {
+    // macOS numbers CPUs package by package, core by core; hw.cacheconfig[n] is
+    // how many logical CPUs share the level-n cache
+    size_t logical  = sysctl_number("hw.logicalcpu", 1);
+    size_t physical = sysctl_number("hw.physicalcpu", logical);
+    size_t packages = sysctl_number("hw.packages", 1);
+    size_t smt      = physical ? (logical + physical - 1) / physical : 1;
+
+    uint64_t config[8] = {};
+    size_t   length    = sizeof(config);
+    if(sysctlbyname("hw.cacheconfig", config, &length, nullptr, 0) != 0) length = 0;
+    size_t per_l2 = length > 2 * sizeof(uint64_t) && config[2] ? config[2] : smt;
+    size_t per_l3 = length > 3 * sizeof(uint64_t) && config[3] ? config[3] : logical / (packages ? packages : 1);
+
+    uint32_t l2_kib = static_cast<uint32_t>(sysctl_number("hw.l2cachesize", 0) / 1024);
+    uint32_t l3_kib = static_cast<uint32_t>(sysctl_number("hw.l3cachesize", 0) / 1024);
+    size_t   per_package = logical / (packages ? packages : 1);
+
+    for(size_t i = 0; i < logical && i < max_count; ++i) {
+        cpu_location loc {};
+        loc.cpu       = static_cast<uint32_t>(i);
+        loc.core      = static_cast<uint32_t>(i / smt);
+        loc.smt_index = static_cast<uint16_t>(i % smt);
+        loc.package   = static_cast<uint32_t>(per_package ? i / per_package : 0);
+        loc.node      = 0;
+        loc.l2_domain = static_cast<uint32_t>(per_l2 ? i / per_l2 : loc.core);
+        loc.l3_domain = static_cast<uint32_t>(per_l3 ? i / per_l3 : loc.package);
+        loc.l2_kib    = l2_kib;
+        loc.l3_kib    = l3_kib;
+        loc.allowed   = 1;  // No hard affinity on macOS
+        cpus[i]       = loc;
+    }
+    return logical;
+}
+
+size_t detect_numa_nodes(numa_node_info* nodes, size_t max_count) noexcept {
+    // Apple hardware is uniform memory access: one node with every CPU
+    if(max_count > 0) {
+        numa_node_info info {};
+        info.node         = 0;
+        info.cpu_count    = static_cast<uint32_t>(sysctl_number("hw.logicalcpu", 1));
+        info.total_memory = sysctl_number("hw.memsize", 0);
+        info.free_memory  = 0;
+        nodes[0]          = info;
+    }
+    return 1;
+}
+
+uint32_t numa_distance(uint32_t from, uint32_t to) noexcept { return from == 0 && to == 0 ? 10 : 0; }
+
+size_t available_cpus(size_t* cpus, size_t max_count) noexcept {
+    unsigned int count = std::thread::hardware_concurrency();
+    if(count == 0) count = 1;
+    for(size_t i = 0; i < count && i < max_count; ++i) { cpus[i] = i; }
+    return count;
+}
+
+// macOS has no hard affinity (thread_policy_set affinity tags are only a
+// scheduling hint), so pinning is not supported
+bool pin_current_thread(size_t cpu) noexcept {
+    (void)cpu;
+    return false;
+}
+
+thread_handle current_thread_handle() noexcept { return pthread_self(); }
+
+bool set_thread_affinity(thread_handle thread, const uint32_t* cpus, size_t count) noexcept {
+    (void)thread;
+    (void)cpus;
+    (void)count;
+    return false;
+}
+
+// Every thread may run anywhere
+size_t get_thread_affinity(thread_handle thread, uint32_t* cpus, size_t max_count) noexcept {
+    (void)thread;
+    unsigned int count = std::thread::hardware_concurrency();
+    if(count == 0) count = 1;
+    for(uint32_t i = 0; i < count && i < max_count; ++i) { cpus[i] = i; }
+    return count;
+}
+
+bool current_cpu(cpu_position& out) noexcept {
+    (void)out;
+    return false;
+}
+
+// No SCHED_BATCH/SCHED_IDLE or per-thread nice: those map to the lowest SCHED_OTHER priority
+bool set_thread_scheduling(thread_handle thread, sched_class cls, int priority) noexcept {
+    int policy = cls == sched_class::fifo ? SCHED_FIFO : cls == sched_class::round_robin ? SCHED_RR : SCHED_OTHER;
+    sched_param param {};
+    if(policy != SCHED_OTHER) {
+        param.sched_priority = std::clamp(priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    } else if(cls != sched_class::normal) {
+        param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+    } else {
+        if(priority != 0) return false;
+        param.sched_priority = (sched_get_priority_min(SCHED_OTHER) + sched_get_priority_max(SCHED_OTHER)) / 2;
+    }
+    return pthread_setschedparam(thread, policy, &param) == 0;
+}
+
+bool get_thread_scheduling(thread_handle thread, thread_scheduling& out) noexcept {
+    int         policy = 0;
+    sched_param param {};
+    if(pthread_getschedparam(thread, &policy, &param) != 0) return false;
+    if(policy == SCHED_FIFO || policy == SCHED_RR) {
+        out = { policy == SCHED_FIFO ? sched_class::fifo : sched_class::round_robin, param.sched_priority };
+    } else {
+        out = { sched_class::normal, 0 };
+    }
+    return true;
+}
+
 }  // namespace platform::hardware
 
 #endif  // __APPLE__
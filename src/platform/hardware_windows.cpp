@@ -1,6 +1,12 @@
 #ifdef _WIN32
 
 #include "../../include/platform/hardware.hpp"
+#include "../../include/platform/hardware_x86.hpp"
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include <windows.h>
 
 namespace platform::hardware {
 
@@ -13,6 +19,230 @@ cache_info detect_cache_info() noexcept {
     return info;
 }
 
+cpu_feature_set detect_cpu_features() noexcept {
+    cpu_feature_set features;
+#if defined(_M_X64) || defined(_M_IX86)
+    x86_impl::probe_x86_features(features);
+#elif defined(_M_ARM64)
+    features.set(cpu_feature::neon, true);
+    bool crypto = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+    features.set(cpu_feature::arm_aes, crypto);
+    features.set(cpu_feature::arm_pmull, crypto);
+    features.set(cpu_feature::arm_sha1, crypto);
+    features.set(cpu_feature::arm_sha2, crypto);
+    features.set(cpu_feature::arm_crc32, IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE));
+    features.set(cpu_feature::lse, IsProcessorFeaturePresent(PF_ARM_V81_ATOMIC_INSTRUCTIONS_AVAILABLE));
+#ifdef PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE
+    features.set(cpu_feature::dotprod, IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE));
+#endif
+#endif
+    return features;
+}
+
+namespace {
+
+// GetLogicalProcessorInformationEx records for one relationship, empty on failure
+std::vector<char> processor_information(LOGICAL_PROCESSOR_RELATIONSHIP relation) {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(relation, nullptr, &length);
+    std::vector<char> buffer(length);
+    if(length == 0
+       || !GetLogicalProcessorInformationEx(
+         relation, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data()), &length)) {
+        buffer.clear();
+    }
+    return buffer;
+}
+
+// Calls fn(record) for every record in a processor_information() buffer
+template <typename Fn>
+void for_each_record(const std::vector<char>& buffer, Fn&& fn) {
+    for(size_t offset = 0; offset < buffer.size();) {
+        auto* record = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        fn(*record);
+        offset += record->Size;
+    }
+}
+
+// CPU numbers are group * 64 + bit, matching the order Windows enumerates them
+template <typename Fn>
+void for_each_cpu(const GROUP_AFFINITY& mask, Fn&& fn) {
+    for(uint32_t bit = 0; bit < 64; ++bit) {
+        if(mask.Mask & (KAFFINITY { 1 } << bit)) fn(static_cast<uint32_t>(mask.Group) * 64 + bit);
+    }
+}
+
+}  // namespace
+
+size_t detect_cpu_topology(cpu_location* cpus, size_t max_count) noexcept {
+    try {
+        std::vector<cpu_location> all;
+        auto                      slot = [&](uint32_t cpu) -> cpu_location& {
+            if(cpu >= all.size()) all.resize(cpu + 1, cpu_location {});
+            all[cpu].cpu = cpu;
+            return all[cpu];
+        };
+
+        uint32_t index = 0;
+        for_each_record(processor_information(RelationProcessorCore), [&](const auto& r) {
+            uint16_t thread = 0;
+            for(WORD g = 0; g < r.Processor.GroupCount; ++g) {
+                for_each_cpu(r.Processor.GroupMask[g], [&](uint32_t cpu) {
+                    cpu_location& loc = slot(cpu);
+                    loc.core          = index;
+                    loc.smt_index     = thread++;
+                    loc.allowed       = 1;
+                });
+            }
+            ++index;
+        });
+
+        index = 0;
+        for_each_record(processor_information(RelationProcessorPackage), [&](const auto& r) {
+            for(WORD g = 0; g < r.Processor.GroupCount; ++g) {
+                for_each_cpu(r.Processor.GroupMask[g], [&](uint32_t cpu) { slot(cpu).package = index; });
+            }
+            ++index;
+        });
+
+        for_each_record(processor_information(RelationNumaNode), [&](const auto& r) {
+            for_each_cpu(r.NumaNode.GroupMask, [&](uint32_t cpu) { slot(cpu).node = r.NumaNode.NodeNumber; });
+        });
+
+        uint32_t l2_index = 0, l3_index = 0;
+        for_each_record(processor_information(RelationCache), [&](const auto& r) {
+            const CACHE_RELATIONSHIP& cache = r.Cache;
+            if(cache.Type == CacheInstruction || (cache.Level != 2 && cache.Level != 3)) return;
+            uint32_t id  = cache.Level == 2 ? l2_index++ : l3_index++;
+            uint32_t kib = static_cast<uint32_t>(cache.CacheSize / 1024);
+            for_each_cpu(cache.GroupMask, [&](uint32_t cpu) {
+                cpu_location& loc = slot(cpu);
+                (cache.Level == 2 ? loc.l2_domain : loc.l3_domain) = id;
+                (cache.Level == 2 ? loc.l2_kib : loc.l3_kib)       = kib;
+            });
+        });
+
+        size_t count = 0;
+        for(const auto& loc : all) {
+            if(!loc.allowed) continue;  // Not reported as a core member: offline or hole in the numbering
+            if(count < max_count) cpus[count] = loc;
+            ++count;
+        }
+        return count;
+    } catch(...) {
+        return 0;
+    }
+}
+
+size_t detect_numa_nodes(numa_node_info* nodes, size_t max_count) noexcept {
+    try {
+        size_t count = 0;
+        for_each_record(processor_information(RelationNumaNode), [&](const auto& r) {
+            if(count < max_count) {
+                numa_node_info info {};
+                info.node = r.NumaNode.NodeNumber;
+                for_each_cpu(r.NumaNode.GroupMask, [&](uint32_t) { ++info.cpu_count; });
+                ULONGLONG available = 0;
+                if(GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(info.node), &available)) {
+                    info.free_memory = available;
+                }
+                nodes[count] = info;
+            }
+            ++count;
+        });
+        return count;
+    } catch(...) {
+        return 0;
+    }
+}
+
+uint32_t numa_distance(uint32_t from, uint32_t to) noexcept {
+    // Windows does not expose the SLIT; report local vs remote only
+    return from == to ? 10 : 20;
+}
+
+size_t available_cpus(size_t* cpus, size_t max_count) noexcept {
+    unsigned int count = std::thread::hardware_concurrency();
+    if(count == 0) count = 1;
+    for(size_t i = 0; i < count && i < max_count; ++i) { cpus[i] = i; }
+    return count;
+}
+
+bool pin_current_thread(size_t cpu) noexcept {
+    if(cpu > UINT32_MAX) return false;
+    uint32_t id = static_cast<uint32_t>(cpu);
+    return set_thread_affinity(GetCurrentThread(), &id, 1);
+}
+
+thread_handle current_thread_handle() noexcept { return GetCurrentThread(); }
+
+bool set_thread_affinity(thread_handle thread, const uint32_t* cpus, size_t count) noexcept {
+    if(count == 0) return false;
+    GROUP_AFFINITY affinity {};
+    affinity.Group = static_cast<WORD>(cpus[0] / 64);
+    for(size_t i = 0; i < count; ++i) {
+        if(cpus[i] / 64 != affinity.Group) return false;  // A thread lives in one group
+        affinity.Mask |= KAFFINITY(1) << (cpus[i] % 64);
+    }
+    return SetThreadGroupAffinity(thread, &affinity, nullptr) != 0;
+}
+
+size_t get_thread_affinity(thread_handle thread, uint32_t* cpus, size_t max_count) noexcept {
+    GROUP_AFFINITY affinity {};
+    if(!GetThreadGroupAffinity(thread, &affinity)) return 0;
+    size_t count = 0;
+    for(uint32_t bit = 0; bit < 64; ++bit) {
+        if(!(affinity.Mask & (KAFFINITY(1) << bit))) continue;
+        if(count < max_count) cpus[count] = affinity.Group * 64u + bit;
+        ++count;
+    }
+    return count;
+}
+
+bool current_cpu(cpu_position& out) noexcept {
+    PROCESSOR_NUMBER number {};
+    GetCurrentProcessorNumberEx(&number);
+    USHORT node = 0;
+    out.cpu     = number.Group * 64u + number.Number;
+    out.node    = GetNumaProcessorNodeEx(&number, &node) ? node : 0;
+    return true;
+}
+
+// Windows has priority levels rather than classes; map onto the nearest level
+bool set_thread_scheduling(thread_handle thread, sched_class cls, int priority) noexcept {
+    int level = THREAD_PRIORITY_NORMAL;
+    switch(cls) {
+    case sched_class::fifo:
+    case sched_class::round_robin:
+        level = priority >= 50 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+        break;
+    case sched_class::idle       : level = THREAD_PRIORITY_IDLE; break;
+    case sched_class::batch      : level = THREAD_PRIORITY_BELOW_NORMAL; break;
+    default:
+        if(priority <= -10) level = THREAD_PRIORITY_HIGHEST;
+        else if(priority < 0) level = THREAD_PRIORITY_ABOVE_NORMAL;
+        else if(priority >= 10) level = THREAD_PRIORITY_LOWEST;
+        else if(priority > 0) level = THREAD_PRIORITY_BELOW_NORMAL;
+        break;
+    }
+    return SetThreadPriority(thread, level) != 0;
+}
+
+bool get_thread_scheduling(thread_handle thread, thread_scheduling& out) noexcept {
+    int level = GetThreadPriority(thread);
+    switch(level) {
+    case THREAD_PRIORITY_ERROR_RETURN : return false;
+    case THREAD_PRIORITY_TIME_CRITICAL: out = { sched_class::fifo, 99 }; break;
+    case THREAD_PRIORITY_IDLE         : out = { sched_class::idle, 0 }; break;
+    case THREAD_PRIORITY_HIGHEST      : out = { sched_class::normal, -10 }; break;
+    case THREAD_PRIORITY_ABOVE_NORMAL : out = { sched_class::normal, -5 }; break;
+    case THREAD_PRIORITY_BELOW_NORMAL : out = { sched_class::normal, 5 }; break;
+    case THREAD_PRIORITY_LOWEST       : out = { sched_class::normal, 10 }; break;
+    default                           : out = { sched_class::normal, 0 }; break;
+    }
+    return true;
+}
+
 }  // namespace platform::hardware
 
 #endif  // _WIN32
@@ -22,6 +22,11 @@ sync_memory(const memory_region& region, bool invalidate_caches) noexcept {
     return linux_impl::sync_memory_impl(region, invalidate_caches);
 }
 
+expected<void, memory_error>
+sync_memory_range(const memory_region& region, std::size_t offset, std::size_t length, flush_mode mode) noexcept {
+    return linux_impl::sync_memory_range_impl(region, offset, length, mode);
+}
+
 void unmap_memory(const memory_region& region) noexcept {
     linux_impl::unmap_memory_impl(region);
 }
@@ -50,6 +55,38 @@ prefetch_memory(const memory_region& region, std::size_t offset, std::size_t len
     return linux_impl::prefetch_memory_impl(region, offset, length);
 }
 
+expected<void, memory_error>
+discard_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return linux_impl::discard_memory_impl(region, offset, length);
+}
+
+expected<void, memory_error>
+evict_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return linux_impl::evict_memory_impl(region, offset, length);
+}
+
+expected<void, memory_error>
+populate_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return linux_impl::populate_memory_impl(region, offset, length);
+}
+
+expected<std::size_t, memory_error> query_residency(
+  const memory_region& region, std::size_t offset, std::size_t length, unsigned char* pages) noexcept {
+    return linux_impl::query_residency_impl(region, offset, length, pages);
+}
+
+expected<int, memory_error> create_shared_memory(const char* name, std::size_t length) noexcept {
+    return linux_impl::create_shared_memory_impl(name, length);
+}
+
+expected<bool, memory_error> wait_shared_word(const uint32_t* word, uint32_t value, int timeout_ms) noexcept {
+    return linux_impl::wait_shared_word_impl(word, value, timeout_ms);
+}
+
+void wake_shared_word(const uint32_t* word, int count) noexcept {
+    linux_impl::wake_shared_word_impl(word, count);
+}
+
 } // namespace platform::mmap
 
 #else
@@ -73,6 +110,12 @@ sync_memory(const memory_region& region, bool invalidate_caches) noexcept {
         unexpect, memory_error(error_domain::platform, error_code::not_supported));
 }
 
+expected<void, memory_error>
+sync_memory_range(const memory_region& region, std::size_t offset, std::size_t length, flush_mode mode) noexcept {
+    return expected<void, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
 void unmap_memory(const memory_region& region) noexcept {
     // No-op for unsupported platforms
 }
@@ -105,6 +148,44 @@ prefetch_memory(const memory_region& region, std::size_t offset, std::size_t len
         unexpect, memory_error(error_domain::platform, error_code::not_supported));
 }
 
+expected<void, memory_error>
+discard_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return expected<void, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, memory_error>
+evict_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return expected<void, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<void, memory_error>
+populate_memory(const memory_region& region, std::size_t offset, std::size_t length) noexcept {
+    return expected<void, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<std::size_t, memory_error> query_residency(
+  const memory_region& region, std::size_t offset, std::size_t length, unsigned char* pages) noexcept {
+    return expected<std::size_t, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<int, memory_error> create_shared_memory(const char* name, std::size_t length) noexcept {
+    return expected<int, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+expected<bool, memory_error> wait_shared_word(const uint32_t* word, uint32_t value, int timeout_ms) noexcept {
+    return expected<bool, memory_error>(
+        unexpect, memory_error(error_domain::platform, error_code::not_supported));
+}
+
+void wake_shared_word(const uint32_t* word, int count) noexcept {
+    // No-op for unsupported platforms
+}
+
 } // namespace platform::mmap
 
 #endif
\ No newline at end of file
@@ -39,160 +39,329 @@ expected<io_result, process_error> write_pipe(const pipe_handle& pipe, const io_
 
 expected<void, process_error> close_pipe(pipe_handle& pipe) noexcept { return linux_impl::close_pipe_impl(pipe); }
 
+expected<bool, process_error> wait_pipe(const pipe_handle& pipe, bool writable, int timeout_ms) noexcept {
+    return linux_impl::wait_pipe_impl(pipe, writable, timeout_ms);
+}
+
 process_caps query_process_caps() noexcept { return linux_impl::query_process_caps_impl(); }
 
+expected<pipe_handle, process_error> open_exit_handle(const process_handle& handle) noexcept {
+    return linux_impl::open_exit_handle_impl(handle);
+}
+
+expected<reactor_handle, process_error> create_reactor() noexcept { return linux_impl::create_reactor_impl(); }
+
+expected<void, process_error> destroy_reactor(reactor_handle& reactor) noexcept {
+    return linux_impl::destroy_reactor_impl(reactor);
+}
+
+expected<void, process_error>
+  reactor_add(const reactor_handle& reactor, int32_t fd, uint64_t token, reactor_events interest) noexcept {
+    return linux_impl::reactor_control_impl(reactor, EPOLL_CTL_ADD, fd, token, interest);
+}
+
+expected<void, process_error>
+  reactor_modify(const reactor_handle& reactor, int32_t fd, uint64_t token, reactor_events interest) noexcept {
+    return linux_impl::reactor_control_impl(reactor, EPOLL_CTL_MOD, fd, token, interest);
+}
+
+expected<void, process_error> reactor_remove(const reactor_handle& reactor, int32_t fd) noexcept {
+    return linux_impl::reactor_control_impl(reactor, EPOLL_CTL_DEL, fd, 0, reactor_events::none);
+}
+
+expected<size_t, process_error>
+  reactor_wait(const reactor_handle& reactor, reactor_event* events, size_t max_count, int timeout_ms) noexcept {
+    return linux_impl::reactor_wait_impl(reactor, events, max_count, timeout_ms);
+}
+
+expected<pipe_handle, process_error> open_wakeup_handle() noexcept { return linux_impl::open_wakeup_handle_impl(); }
+
+expected<void, process_error> signal_wakeup(const pipe_handle& wakeup) noexcept {
+    return linux_impl::signal_wakeup_impl(wakeup);
+}
+
+expected<pipe_handle, process_error> open_timer_handle() noexcept { return linux_impl::open_timer_handle_impl(); }
+
+expected<void, process_error> arm_timer(const pipe_handle& timer, uint64_t deadline_ns) noexcept {
+    return linux_impl::arm_timer_impl(timer, deadline_ns);
+}
+
+expected<uint64_t, process_error> drain_event_handle(const pipe_handle& handle) noexcept {
+    return linux_impl::drain_event_handle_impl(handle);
+}
+
 }  // namespace platform::process
 
 // Linux implementation details
 namespace platform::process::linux_impl {
 
 using detail::make_system_error;
-using detail::set_cloexec;
 using detail::set_nonblocking;
 
-expected<process_handle, process_error> spawn_process_impl(const spawn_request& request, pipe_handle* stdin_pipe,
-                                                             pipe_handle* stdout_pipe,
-                                                             pipe_handle* stderr_pipe) noexcept {
-    if(!request.executable) {
-        return expected<process_handle, process_error>(unexpect, process_error(error_code::invalid_argument));
+namespace {
+
+// glibc 2.29+ can chdir in the child as a posix_spawn file action
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define PLATFORM_PROCESS_SPAWN_CHDIR 1
+#else
+#define PLATFORM_PROCESS_SPAWN_CHDIR 0
+#endif
+
+constexpr int stream_fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+
+// Pipes for the three standard streams; {-1, -1} when the stream is not piped.
+// Every end is close-on-exec: the child gets its ends through dup2, so no
+// descriptor leaks into this child or into processes spawned concurrently.
+struct child_streams {
+    int       fds[3][2] = { { -1, -1 }, { -1, -1 }, { -1, -1 } };
+    pipe_mode modes[3];
+    int       redirects[3];  // Caller descriptors for pipe_mode::redirect
+
+    explicit child_streams(const spawn_request& request) noexcept:
+        modes { request.stdin_mode, request.stdout_mode, request.stderr_mode },
+        redirects { request.stdin_fd, request.stdout_fd, request.stderr_fd } {}
+
+    bool valid() const noexcept {
+        for(int i = 0; i < 3; ++i) {
+            if(modes[i] == pipe_mode::redirect && redirects[i] < 0) return false;
+        }
+        return true;
     }
 
-    // Create pipes if requested
-    int stdin_fds[2]  = {-1, -1};
-    int stdout_fds[2] = {-1, -1};
-    int stderr_fds[2] = {-1, -1};
+    int child_end(int i) const noexcept { return i == 0 ? fds[0][0] : fds[i][1]; }
 
-    if(request.stdin_mode == pipe_mode::pipe) {
-        if(pipe(stdin_fds) != 0) {
-            return expected<process_handle, process_error>(unexpect, make_system_error(errno));
+    // Descriptor the child gets as stream i, or -1 when it keeps the parent's
+    int child_fd(int i) const noexcept {
+        if(modes[i] == pipe_mode::pipe) return child_end(i);
+        if(modes[i] == pipe_mode::redirect) return redirects[i];
+        return -1;
+    }
+
+    int parent_end(int i) const noexcept { return i == 0 ? fds[0][1] : fds[i][0]; }
+
+    bool open() noexcept {
+        for(int i = 0; i < 3; ++i) {
+            if(modes[i] == pipe_mode::pipe && pipe2(fds[i], O_CLOEXEC) != 0) return false;
         }
-        set_cloexec(stdin_fds[1]);  // Parent write end
+        return true;
     }
 
-    if(request.stdout_mode == pipe_mode::pipe) {
-        if(pipe(stdout_fds) != 0) {
-            if(stdin_fds[0] != -1) {
-                ::close(stdin_fds[0]);
-                ::close(stdin_fds[1]);
-            }
-            return expected<process_handle, process_error>(unexpect, make_system_error(errno));
+    void close_child_ends() noexcept {
+        for(int i = 0; i < 3; ++i) {
+            if(child_end(i) != -1) ::close(child_end(i));
         }
-        set_cloexec(stdout_fds[0]);  // Parent read end
     }
 
-    if(request.stderr_mode == pipe_mode::pipe) {
-        if(pipe(stderr_fds) != 0) {
-            if(stdin_fds[0] != -1) {
-                ::close(stdin_fds[0]);
-                ::close(stdin_fds[1]);
+    void close_all() noexcept {
+        for(auto& pair : fds) {
+            for(int& fd : pair) {
+                if(fd != -1) ::close(fd);
+                fd = -1;
             }
-            if(stdout_fds[0] != -1) {
-                ::close(stdout_fds[0]);
-                ::close(stdout_fds[1]);
+        }
+    }
+};
+
+// Descriptors handed to the child as 3, 4, ... (spawn_request::inherit_fds).
+// A source inside that range or on a standard stream is first duplicated above
+// it, so no dup2 in the child overwrites a source it still needs.
+struct inherited_fds {
+    static constexpr int count = 4;
+
+    int sources[count] = { -1, -1, -1, -1 };
+    int copies[count]  = { -1, -1, -1, -1 };  // Temporary duplicates, closed after spawn
+
+    bool open(const spawn_request& request) noexcept {
+        for(int i = 0; i < count; ++i) {
+            int fd = request.inherit_fds[i];
+            if(fd < 0) continue;
+            if(fd < 3 + count) {
+                copies[i] = fcntl(fd, F_DUPFD_CLOEXEC, 3 + count);
+                if(copies[i] < 0) return false;
+                fd = copies[i];
             }
-            return expected<process_handle, process_error>(unexpect, make_system_error(errno));
+            sources[i] = fd;
         }
-        set_cloexec(stderr_fds[0]);  // Parent read end
+        return true;
     }
 
-    // Fork process
-    pid_t pid = fork();
+    static constexpr int target(int i) noexcept { return 3 + i; }
 
-    if(pid < 0) {
-        // Fork failed
-        int err = errno;
-        if(stdin_fds[0] != -1) {
-            ::close(stdin_fds[0]);
-            ::close(stdin_fds[1]);
+    void close_copies() noexcept {
+        for(int& fd : copies) {
+            if(fd != -1) ::close(fd);
+            fd = -1;
         }
-        if(stdout_fds[0] != -1) {
-            ::close(stdout_fds[0]);
-            ::close(stdout_fds[1]);
+    }
+};
+
+constexpr bool has_flag(spawn_flags flags, spawn_flags bit) noexcept {
+    return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(bit)) != 0;
+}
+
+// posix_spawn (clone(CLONE_VM|CLONE_VFORK) in glibc): the parent's page tables
+// are never copied, so spawn cost does not grow with parent RSS. Exec failures
+// are returned here rather than as a child exiting with 127.
+int spawn_with_posix_spawn(
+  const spawn_request& request, const child_streams& streams, const inherited_fds& inherited, pid_t& pid) noexcept {
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t          attr;
+
+    int err = posix_spawn_file_actions_init(&actions);
+    if(err != 0) return err;
+    err = posix_spawnattr_init(&attr);
+    if(err != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        return err;
+    }
+
+    for(int i = 0; i < 3 && err == 0; ++i) {
+        if(streams.child_fd(i) >= 0) {
+            err = posix_spawn_file_actions_adddup2(&actions, streams.child_fd(i), stream_fds[i]);
+        } else if(streams.modes[i] == pipe_mode::none) {
+            err = posix_spawn_file_actions_addopen(&actions, stream_fds[i], "/dev/null", i == 0 ? O_RDONLY : O_WRONLY, 0);
         }
-        if(stderr_fds[0] != -1) {
-            ::close(stderr_fds[0]);
-            ::close(stderr_fds[1]);
+    }
+    // After the standard streams, whose sources may sit on the targets
+    for(int i = 0; i < inherited_fds::count && err == 0; ++i) {
+        if(inherited.sources[i] >= 0) {
+            err = posix_spawn_file_actions_adddup2(&actions, inherited.sources[i], inherited_fds::target(i));
         }
-        return expected<process_handle, process_error>(unexpect, make_system_error(err));
     }
 
-    if(pid == 0) {
-        // Child process
-        // Redirect stdin
-        if(request.stdin_mode == pipe_mode::pipe) {
-            ::close(stdin_fds[1]);  // Close write end
-            if(dup2(stdin_fds[0], STDIN_FILENO) == -1) { _exit(127); }
-            ::close(stdin_fds[0]);
-        } else if(request.stdin_mode == pipe_mode::none) {
-            int null_fd = open("/dev/null", O_RDONLY);
-            if(null_fd != -1) {
-                dup2(null_fd, STDIN_FILENO);
-                ::close(null_fd);
-            }
-        }
+#if PLATFORM_PROCESS_SPAWN_CHDIR
+    if(err == 0 && request.working_dir) err = posix_spawn_file_actions_addchdir_np(&actions, request.working_dir);
+#endif
 
-        // Redirect stdout
-        if(request.stdout_mode == pipe_mode::pipe) {
-            ::close(stdout_fds[0]);  // Close read end
-            if(dup2(stdout_fds[1], STDOUT_FILENO) == -1) { _exit(127); }
-            ::close(stdout_fds[1]);
-        } else if(request.stdout_mode == pipe_mode::none) {
-            int null_fd = open("/dev/null", O_WRONLY);
-            if(null_fd != -1) {
-                dup2(null_fd, STDOUT_FILENO);
-                ::close(null_fd);
-            }
-        }
+    if(err == 0 && has_flag(request.flags, spawn_flags::new_process_group)) {
+        err = posix_spawnattr_setpgroup(&attr, 0);
+        if(err == 0) err = posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+    }
 
-        // Redirect stderr
-        if(request.stderr_mode == pipe_mode::pipe) {
-            ::close(stderr_fds[0]);  // Close read end
-            if(dup2(stderr_fds[1], STDERR_FILENO) == -1) { _exit(127); }
-            ::close(stderr_fds[1]);
-        } else if(request.stderr_mode == pipe_mode::none) {
-            int null_fd = open("/dev/null", O_WRONLY);
+    if(err == 0) {
+        char* const* argv = const_cast<char* const*>(request.args);
+        char* const* envp = request.env ? const_cast<char* const*>(request.env) : environ;
+        err               = has_flag(request.flags, spawn_flags::search_path)
+                            ? posix_spawnp(&pid, request.executable, &actions, &attr, argv, envp)
+                            : posix_spawn(&pid, request.executable, &actions, &attr, argv, envp);
+    }
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return err;
+}
+
+// fork() + exec: copies the parent's page tables, but runs arbitrary setup in
+// the child. Exec failures show up as the child exiting with 127.
+int spawn_with_fork(
+  const spawn_request& request, const child_streams& streams, const inherited_fds& inherited, pid_t& pid) noexcept {
+    pid = fork();
+    if(pid < 0) return errno;
+    if(pid > 0) {
+        // Also set the group from the parent so it holds as soon as spawn returns
+        if(has_flag(request.flags, spawn_flags::new_process_group)) { setpgid(pid, pid); }
+        return 0;
+    }
+
+    // Child process: redirect standard streams
+    for(int i = 0; i < 3; ++i) {
+        if(streams.child_fd(i) >= 0) {
+            int fd = streams.child_fd(i);
+            if(fd == stream_fds[i]) {
+                // dup2 onto itself keeps close-on-exec set
+                if(fcntl(fd, F_SETFD, 0) == -1) { _exit(127); }
+            } else if(dup2(fd, stream_fds[i]) == -1) {
+                _exit(127);
+            }
+        } else if(streams.modes[i] == pipe_mode::none) {
+            int null_fd = open("/dev/null", i == 0 ? O_RDONLY : O_WRONLY);
             if(null_fd != -1) {
-                dup2(null_fd, STDERR_FILENO);
+                dup2(null_fd, stream_fds[i]);
                 ::close(null_fd);
             }
         }
+    }
+    for(int i = 0; i < inherited_fds::count; ++i) {
+        if(inherited.sources[i] >= 0 && dup2(inherited.sources[i], inherited_fds::target(i)) == -1) { _exit(127); }
+    }
 
-        // Change working directory if requested
-        if(request.working_dir) {
-            if(chdir(request.working_dir) != 0) { _exit(127); }
-        }
+    // Change working directory if requested
+    if(request.working_dir) {
+        if(chdir(request.working_dir) != 0) { _exit(127); }
+    }
 
-        // Create new process group if requested
-        if(static_cast<uint32_t>(request.flags) & static_cast<uint32_t>(spawn_flags::new_process_group)) {
-            setpgid(0, 0);
-        }
+    // Create new process group if requested
+    if(has_flag(request.flags, spawn_flags::new_process_group)) { setpgid(0, 0); }
+
+    // Execute process
+    char* const* argv = const_cast<char* const*>(request.args);
+    if(has_flag(request.flags, spawn_flags::search_path)) {
+        execvpe(request.executable, argv, request.env ? const_cast<char* const*>(request.env) : environ);
+    } else if(request.env) {
+        execve(request.executable, argv, const_cast<char* const*>(request.env));
+    } else {
+        execv(request.executable, argv);
+    }
 
-        // Execute process
-        if(request.env) {
-            execve(request.executable, const_cast<char* const*>(request.args), const_cast<char* const*>(request.env));
-        } else {
-            execv(request.executable, const_cast<char* const*>(request.args));
-        }
+    // If we reach here, exec failed
+    _exit(127);
+}
 
-        // If we reach here, exec failed
-        _exit(127);
+}  // namespace
+
+expected<process_handle, process_error> spawn_process_impl(const spawn_request& request, pipe_handle* stdin_pipe,
+                                                             pipe_handle* stdout_pipe,
+                                                             pipe_handle* stderr_pipe) noexcept {
+    if(!request.executable) {
+        return expected<process_handle, process_error>(unexpect, process_error(error_code::invalid_argument));
     }
 
-    // Parent process
-    // Close child ends of pipes
-    if(stdin_fds[0] != -1) { ::close(stdin_fds[0]); }
-    if(stdout_fds[1] != -1) { ::close(stdout_fds[1]); }
-    if(stderr_fds[1] != -1) { ::close(stderr_fds[1]); }
+    // Create pipes if requested
+    child_streams streams(request);
+    if(!streams.valid()) {
+        return expected<process_handle, process_error>(unexpect, process_error(error_code::invalid_argument));
+    }
+    if(!streams.open()) {
+        int err = errno;
+        streams.close_all();
+        return expected<process_handle, process_error>(unexpect, make_system_error(err));
+    }
+
+    // posix_spawn unless the caller asks for fork, or the child must chdir and libc cannot do it
+    bool use_fork = has_flag(request.flags, spawn_flags::use_fork)
+                 || (request.working_dir != nullptr && !PLATFORM_PROCESS_SPAWN_CHDIR);
 
-    // Set parent pipe ends to non-blocking
-    if(stdin_fds[1] != -1) { set_nonblocking(stdin_fds[1]); }
-    if(stdout_fds[0] != -1) { set_nonblocking(stdout_fds[0]); }
-    if(stderr_fds[0] != -1) { set_nonblocking(stderr_fds[0]); }
+    inherited_fds inherited;
+    if(!inherited.open(request)) {
+        int err = errno;
+        inherited.close_copies();
+        streams.close_all();
+        return expected<process_handle, process_error>(unexpect, make_system_error(err));
+    }
+
+    pid_t pid = -1;
+    int   err = use_fork ? spawn_with_fork(request, streams, inherited, pid)
+                         : spawn_with_posix_spawn(request, streams, inherited, pid);
+    inherited.close_copies();
+    if(err != 0) {
+        streams.close_all();
+        return expected<process_handle, process_error>(unexpect, make_system_error(err));
+    }
 
-    // Return handles
-    if(stdin_pipe && stdin_fds[1] != -1) { *stdin_pipe = pipe_handle(stdin_fds[1]); }
-    if(stdout_pipe && stdout_fds[0] != -1) { *stdout_pipe = pipe_handle(stdout_fds[0]); }
-    if(stderr_pipe && stderr_fds[0] != -1) { *stderr_pipe = pipe_handle(stderr_fds[0]); }
+    // Parent process
+    // Close child ends of pipes, set parent ends to non-blocking
+    streams.close_child_ends();
+    pipe_handle* handles[3] = { stdin_pipe, stdout_pipe, stderr_pipe };
+    for(int i = 0; i < 3; ++i) {
+        int fd = streams.parent_end(i);
+        if(fd == -1) continue;
+        set_nonblocking(fd);
+        if(handles[i]) {
+            *handles[i] = pipe_handle(fd);
+        } else {
+            ::close(fd);
+        }
+    }
 
     return expected<process_handle, process_error>(process_handle(pid, static_cast<uint32_t>(request.flags)));
 }
@@ -263,13 +432,28 @@ expected<io_result, process_error> write_pipe_impl(const pipe_handle& pipe, cons
         return expected<io_result, process_error>(unexpect, process_error(error_code::invalid_argument));
     }
 
+    // A child that exited must not kill us with SIGPIPE: block it for this
+    // thread, and discard the one a failed write left pending
+    sigset_t sigpipe, previous;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &previous);
+    bool caller_blocked = sigismember(&previous, SIGPIPE) == 1;  // Then leave its signal state alone
+
     ssize_t result = write(pipe.fd, request.buffer, request.length);
+    int     err    = errno;
+
+    if(result < 0 && err == EPIPE && !caller_blocked) {
+        timespec none {};
+        sigtimedwait(&sigpipe, nullptr, &none);
+    }
+    if(!caller_blocked) pthread_sigmask(SIG_SETMASK, &previous, nullptr);
 
     if(result < 0) {
-        if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        if(err == EAGAIN || err == EWOULDBLOCK) {
             return expected<io_result, process_error>(unexpect, process_error(error_code::would_block));
         }
-        return expected<io_result, process_error>(unexpect, make_system_error(errno));
+        return expected<io_result, process_error>(unexpect, make_system_error(err));
     }
 
     io_result res;
@@ -277,6 +461,20 @@ expected<io_result, process_error> write_pipe_impl(const pipe_handle& pipe, cons
     return expected<io_result, process_error>(res);
 }
 
+expected<bool, process_error> wait_pipe_impl(const pipe_handle& pipe, bool writable, int timeout_ms) noexcept {
+    if(!pipe.is_valid()) { return expected<bool, process_error>(unexpect, process_error(error_code::invalid_argument)); }
+
+    pollfd pfd {};
+    pfd.fd     = pipe.fd;
+    pfd.events = writable ? POLLOUT : POLLIN;
+
+    int result;
+    do { result = ::poll(&pfd, 1, timeout_ms); } while(result < 0 && errno == EINTR);
+
+    if(result < 0) { return expected<bool, process_error>(unexpect, make_system_error(errno)); }
+    return expected<bool, process_error>(result > 0);
+}
+
 expected<void, process_error> close_pipe_impl(pipe_handle& pipe) noexcept {
     if(!pipe.is_valid()) { return expected<void, process_error>(); }
 
@@ -291,10 +489,151 @@ process_caps query_process_caps_impl() noexcept {
     caps.supports_pipes          = true;
     caps.supports_detach         = true;
     caps.supports_process_groups = true;
-    caps.supports_search_path    = false;  // execv doesn't search PATH, use execvp for that
+    caps.supports_search_path    = true;  // spawn_flags::search_path (posix_spawnp / execvpe)
+
+    // pidfd_open needs Linux 5.3; probe once with our own pid
+    static const bool pidfd = [] {
+        long fd = syscall(SYS_pidfd_open, getpid(), 0);
+        if(fd < 0) return false;
+        ::close(static_cast<int>(fd));
+        return true;
+    }();
+    caps.supports_exit_handles = pidfd;
     return caps;
 }
 
+expected<pipe_handle, process_error> open_exit_handle_impl(const process_handle& handle) noexcept {
+    if(!handle.is_valid()) {
+        return expected<pipe_handle, process_error>(unexpect, process_error(error_code::invalid_argument));
+    }
+
+    // pidfd descriptors are always close-on-exec
+    long fd = syscall(SYS_pidfd_open, handle.pid, 0);
+    if(fd < 0) {
+        if(errno == ENOSYS) {
+            return expected<pipe_handle, process_error>(
+              unexpect, process_error(error_domain::feature, error_code::not_supported, ENOSYS));
+        }
+        if(errno == ESRCH) {
+            return expected<pipe_handle, process_error>(
+              unexpect, process_error(error_domain::system, error_code::process_not_found, ESRCH));
+        }
+        return expected<pipe_handle, process_error>(unexpect, make_system_error(errno));
+    }
+    return expected<pipe_handle, process_error>(pipe_handle(static_cast<int32_t>(fd)));
+}
+
+expected<reactor_handle, process_error> create_reactor_impl() noexcept {
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+    if(fd < 0) { return expected<reactor_handle, process_error>(unexpect, make_system_error(errno)); }
+    return expected<reactor_handle, process_error>(reactor_handle(fd));
+}
+
+expected<void, process_error> destroy_reactor_impl(reactor_handle& reactor) noexcept {
+    if(!reactor.is_valid()) { return expected<void, process_error>(); }
+    if(::close(reactor.fd) != 0) { return expected<void, process_error>(unexpect, make_system_error(errno)); }
+    reactor.fd = -1;
+    return expected<void, process_error>();
+}
+
+expected<void, process_error>
+  reactor_control_impl(const reactor_handle& reactor, int op, int32_t fd, uint64_t token, reactor_events interest) noexcept {
+    if(!reactor.is_valid() || fd < 0) {
+        return expected<void, process_error>(unexpect, process_error(error_code::invalid_argument));
+    }
+
+    epoll_event ev {};
+    ev.data.u64 = token;
+    if(has_event(interest, reactor_events::readable)) ev.events |= EPOLLIN | EPOLLRDHUP;
+    if(has_event(interest, reactor_events::writable)) ev.events |= EPOLLOUT;
+    if(has_event(interest, reactor_events::oneshot)) ev.events |= EPOLLONESHOT;
+
+    if(epoll_ctl(reactor.fd, op, fd, &ev) != 0) {
+        return expected<void, process_error>(unexpect, make_system_error(errno));
+    }
+    return expected<void, process_error>();
+}
+
+expected<size_t, process_error>
+  reactor_wait_impl(const reactor_handle& reactor, reactor_event* events, size_t max_count, int timeout_ms) noexcept {
+    if(!reactor.is_valid() || !events || max_count == 0) {
+        return expected<size_t, process_error>(unexpect, process_error(error_code::invalid_argument));
+    }
+
+    // epoll_event is packed on x86-64, so collect into a local batch and translate
+    constexpr size_t batch = 256;
+    epoll_event      ready[batch];
+    int count = epoll_wait(reactor.fd, ready, static_cast<int>(max_count < batch ? max_count : batch), timeout_ms);
+    if(count < 0) {
+        if(errno == EINTR) return expected<size_t, process_error>(size_t { 0 });
+        return expected<size_t, process_error>(unexpect, make_system_error(errno));
+    }
+
+    for(int i = 0; i < count; ++i) {
+        uint32_t       raw  = ready[i].events;
+        reactor_events bits = reactor_events::none;
+        if(raw & EPOLLIN) bits = bits | reactor_events::readable;
+        if(raw & EPOLLOUT) bits = bits | reactor_events::writable;
+        if(raw & (EPOLLHUP | EPOLLRDHUP)) bits = bits | reactor_events::hangup;
+        if(raw & EPOLLERR) bits = bits | reactor_events::error;
+        events[i]        = reactor_event {};
+        events[i].token  = ready[i].data.u64;
+        events[i].events = bits;
+    }
+    return expected<size_t, process_error>(static_cast<size_t>(count));
+}
+
+expected<pipe_handle, process_error> open_wakeup_handle_impl() noexcept {
+    int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(fd < 0) { return expected<pipe_handle, process_error>(unexpect, make_system_error(errno)); }
+    return expected<pipe_handle, process_error>(pipe_handle(fd));
+}
+
+expected<void, process_error> signal_wakeup_impl(const pipe_handle& wakeup) noexcept {
+    if(!wakeup.is_valid()) { return expected<void, process_error>(unexpect, process_error(error_code::invalid_argument)); }
+
+    // EAGAIN means the counter is saturated, which still leaves the handle readable
+    uint64_t one = 1;
+    if(::write(wakeup.fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        return expected<void, process_error>(unexpect, make_system_error(errno));
+    }
+    return expected<void, process_error>();
+}
+
+expected<pipe_handle, process_error> open_timer_handle_impl() noexcept {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if(fd < 0) { return expected<pipe_handle, process_error>(unexpect, make_system_error(errno)); }
+    return expected<pipe_handle, process_error>(pipe_handle(fd));
+}
+
+expected<void, process_error> arm_timer_impl(const pipe_handle& timer, uint64_t deadline_ns) noexcept {
+    if(!timer.is_valid()) { return expected<void, process_error>(unexpect, process_error(error_code::invalid_argument)); }
+
+    // A zero it_value (deadline 0) disarms
+    itimerspec spec {};
+    if(deadline_ns != 0) {
+        spec.it_value.tv_sec  = static_cast<time_t>(deadline_ns / 1000000000u);
+        spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1000000000u);
+    }
+    if(timerfd_settime(timer.fd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+        return expected<void, process_error>(unexpect, make_system_error(errno));
+    }
+    return expected<void, process_error>();
+}
+
+expected<uint64_t, process_error> drain_event_handle_impl(const pipe_handle& handle) noexcept {
+    if(!handle.is_valid()) {
+        return expected<uint64_t, process_error>(unexpect, process_error(error_code::invalid_argument));
+    }
+
+    uint64_t count = 0;
+    if(::read(handle.fd, &count, sizeof(count)) < 0) {
+        if(errno == EAGAIN || errno == EINTR) return expected<uint64_t, process_error>(uint64_t { 0 });
+        return expected<uint64_t, process_error>(unexpect, make_system_error(errno));
+    }
+    return expected<uint64_t, process_error>(count);
+}
+
 }  // namespace platform::process::linux_impl
 
 #endif  // __linux__
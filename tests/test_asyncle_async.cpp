@@ -0,0 +1,338 @@
+#include <asyncle/async/task.hpp>
+#include <asyncle/async/work.hpp>
+#include <asyncle/concurrent/thread_pool.hpp>
+#include <asyncle/format/json_async.hpp>
+#include <asyncle/io/async.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace asyncle;
+using async::task;
+using concurrent::work_stealing_pool;
+
+task<long> leaf(long v) { co_return v * 2; }
+
+task<long> chain(long depth) {
+    long sum = 0;
+    for(int i = 0; i < depth; ++i) sum += co_await leaf(i);
+    co_return sum;
+}
+
+task<void> fail() {
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+void test_tasks() {
+    std::cout << "Testing task composition...\n";
+
+    // Lazy until started, then runs to completion inline (nothing suspends)
+    task<long> t = chain(1000);
+    assert(!t.done());
+    t.start();
+    assert(t.done() && t.result() == 999L * 1000L);
+
+    assert(async::sync_wait(chain(10)) == 90);
+
+    std::vector<task<long>> parts;
+    for(long i = 1; i <= 4; ++i) parts.push_back(chain(i));
+    auto joined = async::sync_wait(async::when_all(std::move(parts)));
+    assert((joined == std::vector<long> { 0, 2, 6, 12 }));
+
+    bool caught = false;
+    try {
+        async::sync_wait(fail());
+    } catch(const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    std::cout << "  ✓ Nested awaits, joins and exceptions\n";
+}
+
+void test_pool_hops() {
+    std::cout << "Testing executor hops and offload...\n";
+
+    work_stealing_pool pool(concurrent::pool_options { .workers = 2 });
+    const auto         caller = std::this_thread::get_id();
+
+    auto hop = [&]() -> task<bool> {
+        bool queued = co_await async::schedule(pool);
+        co_return queued && std::this_thread::get_id() != caller && pool.current_worker() >= 0;
+    };
+    assert(async::sync_wait(hop()));
+
+    auto compute = [&]() -> task<long> {
+        long a = co_await async::offload(pool, [] { return 40L; });
+        long b = co_await async::offload(pool, [] { return 2L; });
+        co_return a + b;
+    };
+    assert(async::sync_wait(compute()) == 42);
+
+    // Completed on a worker each time; sync_wait's frame is gone right after
+    for(int i = 0; i < 2000; ++i) assert(async::sync_wait(async::offload(pool, [i] { return i; })) == i);
+
+    // Fan out to the workers and join
+    auto square = [&](long v) -> task<long> {
+        co_await async::schedule(pool);
+        co_return v * v;
+    };
+    std::vector<task<long>> squares;
+    for(long i = 0; i < 64; ++i) squares.push_back(square(i));
+    auto   results = async::sync_wait(async::when_all(std::move(squares)));
+    long   sum     = 0;
+    for(long v : results) sum += v;
+    assert(results.size() == 64 && sum == 63L * 64 * 127 / 6);
+
+    // Exceptions cross back from the worker
+    bool caught = false;
+    try {
+        async::sync_wait(async::offload(pool, []() -> int { throw std::logic_error("worker"); }));
+    } catch(const std::logic_error&) {
+        caught = true;
+    }
+    assert(caught);
+
+    // A pool that is not running rejects the task, so the work runs inline
+    work_stealing_pool stopped;
+    stopped.stop();
+    assert(async::sync_wait(async::offload(stopped, [] { return 7; })) == 7);
+    assert(!async::sync_wait(async::schedule(stopped)));
+    std::cout << "  ✓ schedule/offload onto workers, inline fallback when rejected\n";
+}
+
+void test_async_work_fallback() {
+    std::cout << "Testing async_work over an executor...\n";
+
+    work_stealing_pool pool(concurrent::pool_options { .workers = 2 });
+    io::file           f;
+    assert(f.create_temp().has_value());
+
+    char            text[] = "offloaded write";
+    io::io_request  req {};
+    req.buffer = text;
+    req.length = sizeof(text) - 1;
+    req.offset = 0;
+
+    // Synchronous work and its offloaded form give the same result type
+    static_assert(std::same_as<decltype(work(f, io::write_command {}, req)), io::file_result<io::io_result>>);
+    auto wrote = async::sync_wait(async::async_work(pool, f, io::write_command {}, req));
+    assert(wrote && wrote->bytes_transferred == req.length);
+
+    char readback[32] = {};
+    req.buffer        = readback;
+    auto got          = async::sync_wait(async::async_work(pool, f, io::read_command {}, req));
+    assert(got && std::memcmp(readback, text, req.length) == 0);
+    std::cout << "  ✓ read_command/write_command offloaded through submit_command\n";
+}
+
+void test_work_batch() {
+    std::cout << "Testing work_batch over file commands...\n";
+
+    io::file f;
+    assert(f.create_temp().has_value());
+
+    // Two contiguous runs (0..12 and 100..104): one pwritev each inside one call
+    std::string                    parts[]   = { "alpha", "beta", "gam", "tail" };
+    uint64_t                       offsets[] = { 0, 5, 9, 100 };
+    io::io_request                 writes[4];
+    io::file_result<io::io_result> done[4];
+    for(int i = 0; i < 4; ++i) {
+        writes[i]        = io::io_request {};
+        writes[i].buffer = parts[i].data();
+        writes[i].length = parts[i].size();
+        writes[i].offset = offsets[i];
+    }
+    assert(work_batch(f, io::write_command {}, writes, done) == 4);
+    for(int i = 0; i < 4; ++i) {
+        assert(done[i] && done[i]->bytes_transferred == parts[i].size());
+        assert(done[i]->new_offset == offsets[i] + parts[i].size());
+    }
+
+    // Reads come back split per request, in the same order
+    char           back[4][8] = {};
+    io::io_request reads[4];
+    for(int i = 0; i < 4; ++i) {
+        reads[i]        = writes[i];
+        reads[i].buffer = back[i];
+    }
+    assert(work_batch(f, io::read_command {}, reads, done) == 4);
+    for(int i = 0; i < 4; ++i) assert(done[i] && std::string(back[i]) == parts[i]);
+
+    // Past the end of file the tail requests get 0 bytes
+    char           over[8]   = {};
+    io::io_request beyond[2] = { reads[3], reads[3] };
+    beyond[1].buffer         = over;
+    beyond[1].offset         = beyond[0].offset + beyond[0].length;
+    assert(work_batch(f, io::read_command {}, beyond, std::span(done, 2)) == 2);
+    assert(done[0]->bytes_transferred == 4 && done[1]->bytes_transferred == 0);
+
+    // A closed file fails every item
+    io::file closed;
+    assert(work_batch(closed, io::write_command {}, writes, done) == 4);
+    for(auto& r : done) assert(!r);
+    std::cout << "  ✓ Vectored batches split per request, short reads and errors\n";
+}
+
+task<size_t> write_then_read(io::ring_scheduler& ring, io::file& f, int index, std::string& out) {
+    std::string line = "record-" + std::to_string(index) + "\n";
+    io::io_request req {};
+    req.buffer = line.data();
+    req.length = line.size();
+    req.offset = static_cast<uint64_t>(index) * 16;
+    auto wrote = co_await async::async_work(ring, f, io::write_command {}, req);
+    if(!wrote) co_return 0;
+
+    out.resize(line.size());
+    req.buffer = out.data();
+    auto got   = co_await ring.read(f, req);
+    co_return got ? got->bytes_transferred : 0;
+}
+
+void test_ring() {
+    std::cout << "Testing ring_scheduler file I/O...\n";
+    if(!io::file::capabilities().supports_async_io) {
+        std::cout << "  - io_uring unavailable, skipped\n";
+        return;
+    }
+
+    io::ring_scheduler ring(64);
+    assert(ring.is_open());
+    io::file f;
+    assert(f.create_temp().has_value());
+
+    // Many tasks in flight on one thread; their requests share submits
+    constexpr int            count = 32;
+    std::vector<std::string> lines(count);
+    auto all = [&]() -> task<size_t> {
+        std::vector<task<size_t>> tasks;
+        for(int i = 0; i < count; ++i) tasks.push_back(write_then_read(ring, f, i, lines[i]));
+        size_t total = 0;
+        for(size_t bytes : co_await async::when_all(std::move(tasks))) total += bytes;
+        co_return total;
+    };
+    size_t total = ring.run(all());
+    assert(ring.in_flight() == 0);
+    for(int i = 0; i < count; ++i) assert(lines[i] == "record-" + std::to_string(i) + "\n");
+    assert(total > 0);
+
+    // I/O, then a CPU stage on the pool, then back to the ring thread
+    work_stealing_pool pool(concurrent::pool_options { .workers = 2 });
+    const auto         ring_thread = std::this_thread::get_id();
+    auto staged = [&]() -> task<bool> {
+        char           buffer[16] = {};
+        io::io_request req {};
+        req.buffer = buffer;
+        req.length = 9;
+        req.offset = 16;
+        auto got   = co_await ring.read(f, req);
+        if(!got) co_return false;
+        co_await async::schedule(pool);
+        size_t digits = 0;
+        for(char c : buffer) digits += c >= '0' && c <= '9';
+        co_await ring.schedule();
+        co_return digits == 1 && std::this_thread::get_id() == ring_thread;
+    };
+    assert(ring.run(staged()));
+    std::cout << "  ✓ " << count << " concurrent write/read tasks, pool round trip\n";
+}
+
+task<std::string> collect(io::pipe_scheduler& pipes, io::process& child) {
+    std::string out;
+    char        buffer[4096];
+    for(;;) {
+        io::process::io_request req {};
+        req.buffer = buffer;
+        req.length = sizeof(buffer);
+        auto got   = co_await async::async_work(pipes, child, io::pipe_read_command {}, req);
+        if(!got || got->bytes_transferred == 0) break;
+        out.append(buffer, got->bytes_transferred);
+    }
+    co_return out;
+}
+
+void test_pipes() {
+    std::cout << "Testing pipe_scheduler process pipes...\n";
+
+    io::pipe_scheduler pipes;
+    assert(pipes.is_open());
+
+    // Two children whose output arrives in bursts, read concurrently from one thread
+    const char* args[] = { "sh", "-c", "for i in 1 2 3; do echo line$i; sleep 0.05; done", nullptr };
+    io::process first("/bin/sh", args, io::pipe_mode::none, io::pipe_mode::pipe, io::pipe_mode::none);
+    io::process second("/bin/sh", args, io::pipe_mode::none, io::pipe_mode::pipe, io::pipe_mode::none);
+    assert(first && second);
+
+    auto both = [&]() -> task<bool> {
+        std::vector<task<std::string>> readers;
+        readers.push_back(collect(pipes, first));
+        readers.push_back(collect(pipes, second));
+        auto outputs = co_await async::when_all(std::move(readers));
+        auto exit    = co_await pipes.exited(first);
+        co_return outputs[0] == "line1\nline2\nline3\n" && outputs[1] == outputs[0] && exit.has_value();
+    };
+    assert(pipes.run(both()));
+    assert(first.wait().value() == 0 && second.wait().value() == 0);
+
+    // Writes go to stdin; cat echoes them back
+    const char* cat_args[] = { "cat", nullptr };
+    io::process cat("/bin/cat", cat_args, io::pipe_mode::pipe, io::pipe_mode::pipe, io::pipe_mode::none);
+    auto echo = [&]() -> task<bool> {
+        char                    text[] = "ping";
+        io::process::io_request req {};
+        req.buffer = text;
+        req.length = 4;
+        auto put   = co_await async::async_work(pipes, cat, io::pipe_write_command {}, req);
+        cat.close_stdin();
+        char back[8] = {};
+        req.buffer   = back;
+        req.length   = sizeof(back);
+        auto got     = co_await pipes.read(cat, req);
+        co_return put && got && got->bytes_transferred == 4 && std::memcmp(back, "ping", 4) == 0;
+    };
+    assert(pipes.run(echo()));
+    cat.wait();
+    assert(pipes.in_flight() == 0);
+    std::cout << "  ✓ Concurrent reads from two children, stdin round trip, exit wait\n";
+}
+
+void test_json() {
+    std::cout << "Testing JSON parse offloaded to the pool...\n";
+
+    work_stealing_pool        pool(concurrent::pool_options { .workers = 2 });
+    asyncle::format::json::parser_pool parsers;
+    std::string               ndjson = "{\"id\":1}\n{\"id\":2}\n{\"id\":3}\n";
+    std::atomic<int>          seen { 0 };
+
+    auto parsed = async::sync_wait(asyncle::format::json::parse_async(
+      pool, parsers, asyncle::format::json::padded_input { ndjson.data(), ndjson.size(), ndjson.size() },
+      [&](auto&) { seen.fetch_add(1); }));
+    if constexpr(asyncle::format::json::has_parser()) {
+        assert(parsed && *parsed == 3 && seen.load() == 3);
+        std::cout << "  ✓ 3 documents parsed on a worker\n";
+    } else {
+        assert(!parsed);
+        std::cout << "  ✓ No parser configured: error reported through the await\n";
+    }
+}
+
+int main() {
+    std::cout << "Running asyncle async tests...\n\n";
+
+    test_tasks();
+    test_pool_hops();
+    test_async_work_fallback();
+    test_work_batch();
+    test_ring();
+    test_pipes();
+    test_json();
+
+    std::cout << "\nAll async tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include <asyncle/async/task.hpp>
+#include <asyncle/async/work.hpp>
+#include <asyncle/concurrent/thread_pool.hpp>
+#include <asyncle/io/event_loop.hpp>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace asyncle;
+using async::task;
+using namespace std::chrono_literals;
+
+task<bool> round_trip(io::event_loop& loop, io::file& f, int index) {
+    std::string    line = "entry-" + std::to_string(index);
+    io::io_request req {};
+    req.buffer = line.data();
+    req.length = line.size();
+    req.offset = static_cast<uint64_t>(index) * 16;
+    auto wrote = co_await async::async_work(loop, f, io::write_command {}, req);
+    if(!wrote) co_return false;
+
+    std::string back(line.size(), '\0');
+    req.buffer = back.data();
+    auto got   = co_await loop.read(f, req);
+    co_return got && back == line;
+}
+
+void test_file_io(const io::event_loop_options& options, const char* label) {
+    std::cout << "Testing file I/O (" << label << ")...\n";
+
+    io::event_loop loop(options);
+    assert(loop.is_open());
+    io::file f;
+    assert(f.create_temp().has_value());
+
+    auto all = [&]() -> task<bool> {
+        std::vector<task<bool>> tasks;
+        for(int i = 0; i < 16; ++i) tasks.push_back(round_trip(loop, f, i));
+        bool ok = true;
+        for(bool passed : co_await async::when_all(std::move(tasks))) ok = ok && passed;
+        auto synced = co_await loop.sync(f);
+        co_return ok && synced.has_value();
+    };
+    assert(loop.run(all()));
+    assert(loop.in_flight() == 0);
+    std::cout << "  ✓ 16 concurrent write/read round trips, " << (loop.has_ring() ? "io_uring" : "inline") << "\n";
+}
+
+void test_timers() {
+    std::cout << "Testing timers...\n";
+
+    io::event_loop   loop;
+    std::vector<int> order;
+    const auto       start = io::event_loop::clock::now();
+
+    auto sleeper = [&](int id, std::chrono::milliseconds delay) -> task<void> {
+        co_await loop.sleep_for(delay);
+        order.push_back(id);
+    };
+    std::vector<task<void>> sleepers;
+    sleepers.push_back(sleeper(3, 30ms));
+    sleepers.push_back(sleeper(1, 10ms));
+    sleepers.push_back(sleeper(2, 20ms));
+    sleepers.push_back(sleeper(0, 0ms));
+    loop.run(async::when_all(std::move(sleepers)));
+
+    auto elapsed = io::event_loop::clock::now() - start;
+    assert((order == std::vector<int> { 0, 1, 2, 3 }));
+    assert(elapsed >= 30ms);
+    assert(loop.timers_pending() == 0);
+    std::cout << "  ✓ Deadlines fire in order through one timerfd\n";
+}
+
+void test_pipes() {
+    std::cout << "Testing process pipes...\n";
+
+    io::event_loop loop;
+    const char*    args[] = { "sh", "-c", "echo one; sleep 0.02; echo two", nullptr };
+    io::process    child("/bin/sh", args, io::pipe_mode::none, io::pipe_mode::pipe, io::pipe_mode::none);
+    assert(child);
+
+    // Reading while a timer ticks on the same loop
+    std::atomic<int> ticks { 0 };
+    auto ticker = [&]() -> task<void> {
+        for(int i = 0; i < 3; ++i) {
+            co_await loop.sleep_for(5ms);
+            ticks.fetch_add(1);
+        }
+    };
+    auto reader = [&]() -> task<void> {
+        std::string out;
+        char        buffer[256];
+        for(;;) {
+            io::process::io_request req {};
+            req.buffer = buffer;
+            req.length = sizeof(buffer);
+            auto got   = co_await async::async_work(loop, child, io::pipe_read_command {}, req);
+            if(!got || got->bytes_transferred == 0) break;
+            out.append(buffer, got->bytes_transferred);
+        }
+        auto exit = co_await loop.exited(child);
+        assert(out == "one\ntwo\n" && exit.has_value());
+    };
+    std::vector<task<void>> both;
+    both.push_back(ticker());
+    both.push_back(reader());
+    loop.run(async::when_all(std::move(both)));
+    assert(ticks.load() == 3);
+    assert(child.wait().value() == 0);
+    std::cout << "  ✓ Pipe reads, exit wait and timers interleaved\n";
+}
+
+void test_timeouts() {
+    std::cout << "Testing operation deadlines...\n";
+
+    io::event_loop loop;
+    const char*    args[] = { "sh", "-c", "sleep 5", nullptr };
+    io::process    child("/bin/sh", args, io::pipe_mode::none, io::pipe_mode::pipe, io::pipe_mode::none);
+    assert(child);
+
+    // A pipe read and the child's exit, both past their deadline; the exit
+    // wait terminates the child by default
+    auto silent = [&]() -> task<void> {
+        char                    buffer[64];
+        io::process::io_request req {};
+        req.buffer = buffer;
+        req.length = sizeof(buffer);
+        auto got   = co_await loop.read(child, req, io::event_loop::clock::now() + 20ms);
+        assert(!got && got.error().code == io::process::error_code::timed_out);
+
+        auto timed = loop.with_timeout(10ms);
+        got        = co_await async::async_work(timed, child, io::pipe_read_command {}, req);
+        assert(!got && got.error().code == io::process::error_code::timed_out);
+
+        auto exit = co_await loop.exited(child, io::event_loop::clock::now() + 20ms);
+        assert(!exit && exit.error().code == io::process::error_code::timed_out);
+    };
+    const auto start = io::event_loop::clock::now();
+    loop.run(silent());
+    assert(io::event_loop::clock::now() - start < 2s);
+    assert(child.wait().has_value());
+    assert(loop.in_flight() == 0 && loop.timers_pending() == 0);
+
+    // A ring read from an empty pipe is cancelled in the kernel
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    io::file reader { io::file_handle(fds[0]) };
+    auto     stalled = [&]() -> task<void> {
+        char           buffer[16];
+        io::io_request req {};
+        req.buffer = buffer;
+        req.length = sizeof(buffer);
+        auto got   = co_await loop.read(reader, req, io::event_loop::clock::now() + 20ms);
+        assert(!got && got.error().code == io::error_code::timed_out);
+
+        // Data in time: the deadline is cancelled with the completion
+        assert(::write(fds[1], "ok", 2) == 2);
+        got = co_await loop.read(reader, req, io::event_loop::clock::now() + 10s);
+        assert(got && got->bytes_transferred == 2);
+    };
+    if(loop.has_ring()) {
+        loop.run(stalled());
+        assert(loop.in_flight() == 0 && loop.timers_pending() == 0);
+    }
+    ::close(fds[1]);
+    std::cout << "  ✓ Pipe, exit and " << (loop.has_ring() ? "ring read" : "(no ring) read")
+              << " deadlines time out; the child is terminated\n";
+}
+
+// Parameters live in the frame, unlike the captures of a temporary lambda
+task<void> count_if_on(std::thread::id expected, std::atomic<int>& count) {
+    if(std::this_thread::get_id() == expected) count.fetch_add(1);
+    co_return;
+}
+
+void test_cross_thread() {
+    std::cout << "Testing cross-thread wakeups...\n";
+
+    io::event_loop loop;
+    std::thread    driver([&] { loop.run(); });
+    const auto     driver_id = driver.get_id();
+
+    // spawn() from this thread; the loop sleeps in epoll until the eventfd fires
+    std::atomic<int> on_loop { 0 };
+    for(int i = 0; i < 100; ++i) loop.spawn(count_if_on(driver_id, on_loop));
+    while(loop.spawned() != 0) std::this_thread::yield();
+    assert(on_loop.load() == 100);
+
+    // Pool → loop hops from worker threads
+    concurrent::work_stealing_pool pool(concurrent::pool_options { .workers = 2 });
+    auto hop = [&]() -> task<bool> {
+        co_await async::schedule(pool);
+        bool on_worker = pool.current_worker() >= 0;
+        co_await loop.schedule();
+        co_return on_worker && std::this_thread::get_id() == driver_id;
+    };
+    for(int i = 0; i < 50; ++i) assert(async::sync_wait(hop()));
+
+    loop.stop();
+    driver.join();
+    std::cout << "  ✓ 100 spawns and 50 pool round trips resumed on the loop thread\n";
+}
+
+void test_group() {
+    std::cout << "Testing loop group...\n";
+
+    io::event_loop_group group(io::event_loop_group_options { .loops = 2 });
+    assert(group.size() == 2);
+
+    std::atomic<int> matched { 0 };
+    for(size_t i = 0; i < group.size(); ++i) {
+        io::event_loop& target = group.at(i);
+        auto on = [&]() -> task<void> {
+            co_await target.schedule();
+            co_await target.sleep_for(1ms);
+            if(io::event_loop_group::current() == &target) matched.fetch_add(1);
+        };
+        async::sync_wait(on());
+    }
+    assert(matched.load() == 2);
+    assert(io::event_loop_group::current() == nullptr);
+
+    assert(&group.next() != &group.next());
+    group.stop();
+    std::cout << "  ✓ Loops on their own threads, timers and hops per loop\n";
+}
+
+int main() {
+    std::cout << "Running asyncle event loop tests...\n\n";
+
+    test_file_io(io::event_loop_options {}, "default");
+    test_file_io(io::event_loop_options { .ring_entries = 0 }, "no ring");
+    test_timers();
+    test_pipes();
+    test_timeouts();
+    test_cross_thread();
+    test_group();
+
+    std::cout << "\nAll event loop tests passed!\n";
+    return 0;
+}
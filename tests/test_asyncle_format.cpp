@@ -12,16 +12,48 @@
 //   platform::file -> asyncle::io::file
 //   format::json   -> asyncle::format::json
 
+#include <asyncle/format/csv.hpp>
 #include <asyncle/format/json.hpp>
+#include <asyncle/format/json_file.hpp>
+#include <asyncle/format/json_parallel.hpp>
 #include <asyncle/format/serialize.hpp>
+#include <asyncle/format/records.hpp>
+#include <asyncle/format/sink.hpp>
+#include <asyncle/io/arena.hpp>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 struct TestConfig {
     int         port;
     std::string host;
 };
 
+// Snapshot record with hand-written adapters, so sinks are testable without Glaze
+struct SnapshotRecord {
+    uint32_t id;
+};
+
+namespace format::serialize {
+inline auto save_impl(SnapshotRecord const& record, json_tag) -> result<std::string> {
+    return result<std::string>("{\"id\":" + std::to_string(record.id) + "}\n");
+}
+
+inline auto save_impl(SnapshotRecord const& record, beve_tag) -> result<std::vector<std::byte>> {
+    std::vector<std::byte> bytes(sizeof(record.id));
+    std::memcpy(bytes.data(), &record.id, sizeof(record.id));
+    return result<std::vector<std::byte>>(std::move(bytes));
+}
+}  // namespace format::serialize
+
 void test_foundation_layer_available() {
     std::cout << "Testing foundation layer availability...\n";
 
@@ -136,6 +168,598 @@ void test_layering_independence() {
     std::cout << "  ✓ Layers are properly separated\n";
 }
 
+void test_padded_sources() {
+    std::cout << "Testing in-place parsing of padded sources...\n";
+
+    using namespace asyncle::format::json;
+
+    std::string       json = R"({"id": 7})";
+    std::vector<char> buffer(json.size() + input_padding, '\0');
+    json.copy(buffer.data(), json.size());
+
+    // Enough slack: parsed in place; too little: copied as before
+    auto in_place = make_parser().padded_source(buffer.data(), json.size(), buffer.size());
+    assert(std::move(in_place).make().in_place());
+    auto copied = make_parser().padded_source(buffer.data(), json.size(), buffer.size() - 1);
+    assert(!std::move(copied).make().in_place());
+    assert(!parser_operation(json).in_place());
+
+    // Mapped files always carry the padding, including when the file ends just before a page boundary
+    const char* path = "/tmp/test_asyncle_mapped.json";
+    size_t      page = asyncle::io::mmap::page_size();
+    for(size_t size : { size_t { 0 }, size_t { 9 }, page - 10, page }) {
+        std::string content = size ? R"({"id": 7})" : "";
+        if(content.size() < size) content.append(size - content.size() - 1, ' ').push_back('\n');
+
+        std::FILE* out = std::fopen(path, "wb");
+        assert(out);
+        std::fwrite(content.data(), 1, content.size(), out);
+        std::fclose(out);
+
+        auto file = mapped_json::open(path);
+        assert(file.has_value() && file->is_valid());
+        assert(file->size() == size);
+        assert(file->view() == content);
+
+        auto input = file->input();
+        assert(input.has_padding());
+        for(size_t i = 0; i < input_padding; ++i) { assert(input.data[size + i] == '\0'); }
+
+#ifdef FORMAT_HAS_SIMDJSON
+        if(size) {
+            auto doc = file->parse();
+            assert(doc.is_zero_copy());
+            auto result = doc.iterate();
+            auto id     = result["id"].get_int64();
+            assert(!id.error() && id.value() == 7);
+        }
+#endif
+    }
+    std::remove(path);
+
+    auto missing = mapped_json::open("/tmp/test_asyncle_mapped_missing.json");
+    assert(!missing.has_value() && missing.error() == error::io_error);
+
+    std::cout << "  ✓ Padded buffers and mapped files skip the copy\n";
+}
+
+void test_document_stream() {
+    std::cout << "Testing NDJSON document streams...\n";
+
+    using namespace asyncle::format::json;
+
+    // Records straddle every read and window boundary; the last one has no newline
+    std::string ndjson;
+    uint64_t    expected = 0;
+    for(int i = 0; i < 2000; ++i) {
+        ndjson += R"({"id": )" + std::to_string(i) + R"(, "msg": "log line"})";
+        if(i != 1999) ndjson += '\n';
+        expected += static_cast<uint64_t>(i);
+    }
+
+    const char* path = "/tmp/test_asyncle_stream.ndjson";
+    std::FILE*  out  = std::fopen(path, "wb");
+    assert(out);
+    std::fwrite(ndjson.data(), 1, ndjson.size(), out);
+    std::fclose(out);
+
+    asyncle::io::file f;
+    assert(f.open(path));
+
+    [[maybe_unused]] uint64_t sum         = 0;
+    auto                      on_document = [&](auto& doc) {
+#ifdef FORMAT_HAS_SIMDJSON
+        sum += static_cast<uint64_t>(doc["id"].get_int64().value());
+#else
+        (void)doc;
+#endif
+    };
+
+    document_stream stream;
+    auto            from_file = stream_documents(f, stream, on_document, 4093);
+
+    asyncle::io::mapped_reader reader(f, asyncle::io::mmap::page_size());
+    auto                       from_window = stream_documents(reader, stream, on_document);
+
+    if constexpr(has_parser()) {
+        assert(from_file.has_value() && *from_file == 2000);
+        assert(from_window.has_value() && *from_window == 2000);
+        assert(sum == 2 * expected);
+        assert(stream.pending() == 0);
+        std::cout << "  ✓ " << stream.documents() << " documents across chunk and window boundaries\n";
+    } else {
+        assert(!from_file.has_value() && from_file.error() == error::uninitialized);
+        std::cout << "  ✓ Streams report uninitialized without a parser\n";
+    }
+    std::remove(path);
+}
+
+void test_sparse_documents() {
+    std::cout << "Testing NDJSON over sparse data extents...\n";
+    using namespace asyncle::format::json;
+
+    // Three runs of records separated by megabyte holes, as a log archive
+    // with preallocated-then-punched segments leaves them
+    std::string run;
+    for(int i = 0; i < 100; ++i) run += R"({"id": )" + std::to_string(i) + R"(, "msg": "kept"})" + "\n";
+
+    asyncle::io::file f;
+    assert(f.create_temp().has_value());
+    for(uint64_t at : { uint64_t { 0 }, uint64_t { 1 } << 20, uint64_t { 5 } << 20 }) {
+        assert(f.write(run.data(), run.size(), at).value() == run.size());
+    }
+    assert(f.truncate((uint64_t { 8 } << 20)).has_value());  // Trailing hole
+
+    [[maybe_unused]] uint64_t sum         = 0;
+    auto                      on_document = [&](auto& doc) {
+#ifdef FORMAT_HAS_SIMDJSON
+        sum += static_cast<uint64_t>(doc["id"].get_int64().value());
+#else
+        (void)doc;
+#endif
+    };
+
+    document_stream stream;
+    auto            parsed = stream_data_documents(f, stream, on_document, asyncle::io::mmap::page_size());
+    if constexpr(has_parser()) {
+        assert(parsed.has_value() && *parsed == 300);
+        assert(sum == 3 * (99 * 100 / 2));
+        std::cout << "  ✓ " << *parsed << " documents, holes and block padding skipped\n";
+    } else {
+        assert(!parsed.has_value());
+        std::cout << "  ✓ Sparse streams report an error without a parser\n";
+    }
+
+    asyncle::io::file closed;
+    assert(!stream_data_documents(closed, stream, on_document));
+}
+
+void test_parallel_documents() {
+    std::cout << "Testing parallel NDJSON ingest...\n";
+
+    using namespace asyncle::format::json;
+
+    std::string ndjson;
+    for(int i = 0; i < 5000; ++i) { ndjson += R"({"id": )" + std::to_string(i) + R"(, "msg": "log line"})" + "\n"; }
+
+    const char* path = "/tmp/test_asyncle_parallel.ndjson";
+    std::FILE*  out  = std::fopen(path, "wb");
+    assert(out);
+    std::fwrite(ndjson.data(), 1, ndjson.size(), out);
+    std::fclose(out);
+
+    auto file = mapped_json::open(path);
+    assert(file.has_value());
+    asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+    parser_pool                             parsers;
+
+    auto id_of = [](auto& doc) -> int64_t {
+#ifdef FORMAT_HAS_SIMDJSON
+        return doc["id"].get_int64().value();
+#else
+        (void)doc;
+        return 0;
+#endif
+    };
+
+    // Small chunks and a narrow window force many chunks to complete out of order
+    std::vector<int64_t> ids;
+    auto                 ordered = parse_parallel(
+      *file,
+      pool,
+      parsers,
+      id_of,
+      [&](int64_t id) { ids.push_back(id); },
+      parallel_options { .chunk_size = 1000, .in_flight = 8 });
+
+    int64_t sum       = 0;
+    auto    unordered = parse_parallel(
+      *file,
+      pool,
+      parsers,
+      id_of,
+      [&](int64_t id) { sum += id; },
+      parallel_options { .chunk_size = 1000, .ordered = false });
+
+    if constexpr(has_parser()) {
+        assert(ordered.has_value() && *ordered == 5000);
+        for(int64_t i = 0; i < 5000; ++i) { assert(ids[static_cast<size_t>(i)] == i); }
+        assert(unordered.has_value() && *unordered == 5000);
+        assert(sum == 4999 * 5000 / 2);
+        assert(parsers.created() <= pool.worker_count());
+        std::cout << "  ✓ 5000 records in order and out of order across " << pool.worker_count() << " workers\n";
+
+        // Back-to-back calls return while workers may still be signalling the last chunk
+        for(int round = 0; round < 200; ++round) {
+            size_t seen = 0;
+            auto   once = parse_parallel(
+              *file, pool, parsers, id_of, [&](int64_t) { ++seen; }, parallel_options { .chunk_size = 64 << 10 });
+            assert(once.has_value() && *once == 5000 && seen == 5000);
+        }
+
+        // A throwing consumer unwinds only after every chunk is back
+        bool thrown = false;
+        try {
+            (void)parse_parallel(
+              *file,
+              pool,
+              parsers,
+              id_of,
+              [](int64_t id) {
+                  if(id == 100) throw std::runtime_error("stop");
+              },
+              parallel_options { .chunk_size = 1000, .in_flight = 8 });
+        } catch(const std::runtime_error&) { thrown = true; }
+        assert(thrown);
+        pool.wait_idle();
+        std::cout << "  ✓ Repeated calls and a throwing consumer leave no task behind\n";
+    } else {
+        assert(!ordered.has_value() && ordered.error() == error::uninitialized);
+        std::cout << "  ✓ Parallel ingest reports uninitialized without a parser\n";
+    }
+    std::remove(path);
+}
+
+struct CsvEvent {
+    int64_t          id;
+    std::string_view kind;
+    std::string      note;
+};
+
+struct CsvNote {
+    std::optional<std::string> text;
+};
+
+void test_parallel_csv() {
+    std::cout << "Testing parallel CSV loading...\n";
+
+    namespace csv = asyncle::format::csv;
+
+    // Quoted notes with newlines and commas straddle the small chunks
+    std::string text = "id,kind,note\n";
+    for(int i = 0; i < 4000; ++i) {
+        text += std::to_string(i) + (i % 2 ? ",odd," : ",even,");
+        text += i % 7 == 0 ? "\"line one\nline, \"\"two\"\"\"\n" : "plain\n";
+    }
+
+    const char* path = "/tmp/test_asyncle_parallel.csv";
+    std::FILE*  out  = std::fopen(path, "wb");
+    assert(out);
+    std::fwrite(text.data(), 1, text.size(), out);
+    std::fclose(out);
+
+    auto file = csv::mapped_csv::open(path);
+    assert(file.has_value() && file->size() == text.size() && file->view() == text);
+    asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+
+    auto events = csv::load_parallel<CsvEvent>(
+      file->view(), pool, { .header = true }, csv::parallel_options { .chunk_size = 700, .in_flight = 8 });
+    assert(events.has_value() && events->size() == 4000);
+    for(int64_t i = 0; i < 4000; ++i) {
+        const CsvEvent& e = (*events)[static_cast<size_t>(i)];
+        assert(e.id == i && e.kind == (i % 2 ? "odd" : "even"));
+        assert(e.note == (i % 7 == 0 ? "line one\nline, \"two\"" : "plain"));
+    }
+
+    // Same rows as the single-threaded loader
+    std::vector<CsvEvent> serial;
+    assert(csv::load_rows(file->view(), serial, { .header = true }).value() == 4000);
+
+    // Completion order through parse_parallel
+    int64_t sum      = 0;
+    auto    consumed = csv::parse_parallel(
+      file->view(),
+      pool,
+      [](const csv::row& r) -> csv::result<int64_t> { return csv::result<int64_t>(r.raw(0).size()); },
+      [&](int64_t width) { sum += width; },
+      { .header = true },
+      csv::parallel_options { .chunk_size = 1000, .ordered = false });
+    assert(consumed.has_value() && *consumed == 4000);
+    int64_t widths = 0;
+    for(int i = 0; i < 4000; ++i) widths += static_cast<int64_t>(std::to_string(i).size());
+    assert(sum == widths);
+
+    // A single optional column keeps its blank lines, as load_rows does
+    auto notes = csv::load_parallel<CsvNote>("\"\"\n\nx\n", pool);
+    assert(notes.has_value() && notes->size() == 3);
+    assert((*notes)[0].text == "" && !(*notes)[1].text && (*notes)[2].text == "x");
+
+    // A bad row fails the whole load
+    auto bad = csv::load_parallel<CsvEvent>("1,a,x\nnope,b,y\n", pool);
+    assert(!bad.has_value() && bad.error() == csv::error::type_mismatch);
+
+    // Loads that return right after the last chunk, and a consumer that throws
+    for(int round = 0; round < 200; ++round) {
+        auto again = csv::load_parallel<CsvEvent>(file->view(), pool, { .header = true });
+        assert(again.has_value() && again->size() == 4000);
+    }
+    bool thrown = false;
+    try {
+        (void)csv::parse_parallel(
+          file->view(),
+          pool,
+          [](const csv::row& r) -> csv::result<int64_t> { return csv::result<int64_t>(r.raw(0).size()); },
+          [](int64_t width) {
+              if(width == 3) throw std::runtime_error("stop");
+          },
+          { .header = true },
+          csv::parallel_options { .chunk_size = 1000, .in_flight = 8 });
+    } catch(const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    pool.wait_idle();
+
+    std::cout << "  ✓ 4000 rows with quoted newlines across " << pool.worker_count() << " workers\n";
+    std::remove(path);
+}
+
+struct RouteInfo {
+    std::string_view    tenant;
+    int64_t             shard = 0;
+    std::string         region;
+    std::optional<bool> trace;
+    std::optional<int>  priority;
+};
+
+void test_field_extraction() {
+    std::cout << "Testing compile-time pointer extraction...\n";
+
+    using namespace asyncle::format::json;
+    using route_tenant   = field<"/meta/tenant", &RouteInfo::tenant>;
+    using route_shard    = field<"/targets/1/shard", &RouteInfo::shard>;
+    using route_region   = field<"/meta/geo~1region", &RouteInfo::region>;
+    using route_trace    = field<"/flags/trace", &RouteInfo::trace>;
+    using route_priority = field<"/priority", &RouteInfo::priority>;
+
+    static_assert(route_shard::pointer.size() == 3 && route_shard::pointer.index[1] == 1);
+    static_assert(route_region::pointer.segment(1) == "geo/region");
+    static_assert(!::format::json::field_set<RouteInfo, route_tenant, field<"/meta", &RouteInfo::tenant>>);
+
+    std::string payload = R"({"body": {"large": [1, 2, {"skip": "me"}], "text": "unrelated"},
+        "meta": {"tenant": "acme", "geo/region": "eu-west", "ignored": true},
+        "targets": [{"shard": 3}, {"shard": 7, "weight": 0.5}],
+        "flags": {"trace": null}})";
+
+    parser      doc(payload);
+    RouteInfo   info;
+    auto        found = extract<route_tenant, route_shard, route_region, route_trace, route_priority>(doc, info);
+    parser_pool parsers;
+    auto        lease   = parsers.acquire();
+    RouteInfo   missing;
+    auto        partial = extract<route_tenant, route_shard>(lease, R"({"meta": {"tenant": "x"}})", missing);
+
+    if constexpr(has_parser()) {
+        assert(found.has_value() && *found == 4);  // priority absent, trace null
+        assert(info.tenant == "acme" && info.shard == 7 && info.region == "eu-west");
+        assert(!info.trace.has_value() && !info.priority.has_value());
+        assert(!partial.has_value() && partial.error() == error::key_not_found);
+        std::cout << "  ✓ Four of five fields read in one pass, unrelated subtrees skipped\n";
+    } else {
+        assert(!found.has_value() && found.error() == error::uninitialized);
+        assert(!partial.has_value());
+        std::cout << "  ✓ Extraction reports uninitialized without a parser\n";
+    }
+}
+
+void test_serialize_sinks() {
+    std::cout << "Testing serialization sinks...\n";
+
+    using asyncle::io::access_mode;
+    auto mode = static_cast<access_mode>(
+      static_cast<uint8_t>(access_mode::read_write) | static_cast<uint8_t>(access_mode::create)
+      | static_cast<uint8_t>(access_mode::truncate));
+
+    // Many small records through a deliberately tiny segment set: several writev() flushes
+    const char* path = "/tmp/test_asyncle_sink.ndjson";
+    std::string expected;
+    {
+        asyncle::io::file out;
+        assert(out.open(path, mode));
+        asyncle::format::file_sink<asyncle::format::json_tag> sink(out, 64, 3);
+        for(uint32_t i = 0; i < 1000; ++i) {
+            auto written = sink.write(SnapshotRecord { i });
+            assert(written.has_value());
+            expected += "{\"id\":" + std::to_string(i) + "}\n";
+        }
+        assert(sink.pending() < 64 * 3);
+        assert(sink.flush().has_value());
+        assert(sink.pending() == 0 && sink.bytes_written() == expected.size());
+    }
+    {
+        asyncle::io::file in;
+        assert(in.open(path));
+        std::string contents(expected.size(), '\0');
+        assert(in.read(contents.data(), contents.size()).value() == expected.size());
+        assert(contents == expected);
+    }
+
+    // Binary records into a mapping that starts at one page and grows
+    const char* mapped_path = "/tmp/test_asyncle_sink.beve";
+    {
+        asyncle::io::file out;
+        assert(out.open(mapped_path, mode));
+        asyncle::format::mapped_sink<asyncle::format::beve_tag> sink(out, asyncle::io::mmap::page_size());
+        for(uint32_t i = 0; i < 10000; ++i) { assert(sink.write(SnapshotRecord { i }).has_value()); }
+        assert(sink.capacity() >= 40000);
+        auto total = sink.finish();
+        assert(total.has_value() && *total == 40000);
+        assert(!sink.write(SnapshotRecord { 0 }).has_value());
+        assert(out.size().value() == 40000);
+
+        uint32_t last = 0;
+        assert(out.read(&last, sizeof(last), 39996).value() == sizeof(last));
+        assert(last == 9999);
+    }
+    std::remove(path);
+    std::remove(mapped_path);
+
+    std::cout << "  ✓ Records streamed through writev() segments and a growing mapping\n";
+}
+
+struct CatalogEntry {
+    uint64_t id;
+    double   price;
+    uint32_t flags;
+    uint32_t region;
+};
+
+struct CatalogEntryV2 {
+    uint64_t id;
+    double   price;
+    uint32_t flags;
+    uint32_t region;
+
+    static constexpr uint64_t schema_version = 2;
+};
+
+// Same size as each other, members reordered; named copies of CatalogEntry
+struct PackedLeft {
+    uint32_t a;
+    uint32_t b;
+    uint64_t c;
+};
+
+struct PackedRight {
+    uint64_t c;
+    uint32_t a;
+    uint32_t b;
+};
+
+struct NamedEntry {
+    uint64_t id;
+    double   price;
+    uint32_t flags;
+    uint32_t region;
+
+    static constexpr std::string_view schema_name = "catalog.entry";
+};
+
+struct NamedEntryCopy {
+    uint64_t id;
+    double   price;
+    uint32_t flags;
+    uint32_t region;
+
+    static constexpr std::string_view schema_name = "catalog.entry";
+};
+
+struct NamedTagged {
+    uint64_t id;
+    char     tag[8];
+
+    static constexpr std::string_view schema_name = "catalog.tagged";
+};
+
+void test_record_files() {
+    std::cout << "Testing mapped record files...\n";
+
+    using asyncle::format::detail::xxh64;
+    assert(xxh64("", 0) == 0xEF46DB3751D8E999ull);
+    assert(xxh64("abc", 3) == 0x44BC2CF5AD770999ull);
+    static_assert(asyncle::format::record_schema_hash<CatalogEntry>()
+                  != asyncle::format::record_schema_hash<CatalogEntryV2>());
+    // The hash follows the name and member layout, not the C++ type
+    using asyncle::format::record_schema_hash;
+    static_assert(sizeof(PackedLeft) == sizeof(PackedRight));
+    static_assert(record_schema_hash<PackedLeft>() != record_schema_hash<PackedRight>());
+    static_assert(record_schema_hash<NamedEntry>() == record_schema_hash<NamedEntryCopy>());
+    static_assert(record_schema_hash<NamedEntry>() != record_schema_hash<CatalogEntry>());
+    static_assert(asyncle::format::detail::count_members<NamedTagged>() == 2);
+
+    using asyncle::io::access_mode;
+    auto mode = static_cast<access_mode>(
+      static_cast<uint8_t>(access_mode::read_write) | static_cast<uint8_t>(access_mode::create)
+      | static_cast<uint8_t>(access_mode::truncate));
+
+    // Single appends and a bulk append across a partial block
+    const char* path = "/tmp/test_asyncle_records.rec";
+    {
+        asyncle::io::file out;
+        assert(out.open(path, mode));
+        asyncle::format::record_writer<CatalogEntry> writer(out, 10000, 256);
+        for(uint32_t i = 0; i < 100; ++i) { assert(writer.append(CatalogEntry { i, i * 0.5, i % 3, i % 7 })); }
+        std::vector<CatalogEntry> bulk;
+        for(uint32_t i = 100; i < 6000; ++i) { bulk.push_back(CatalogEntry { i, i * 0.5, i % 3, i % 7 }); }
+        assert(writer.append(std::span<const CatalogEntry>(bulk).first(2000)).value() == 2100);
+        assert(writer.append(std::span<const CatalogEntry>(bulk).subspan(2000)).value() == 6000);
+
+        // Other ranges: a vector takes the span path, a generated view goes record by record
+        std::vector<CatalogEntry> more { CatalogEntry { 6000, 3000.0, 0, 1 } };
+        assert(writer.append(more).value() == 6001);
+        auto generated = std::views::iota(6001u, 10000u)
+                       | std::views::transform([](uint32_t i) { return CatalogEntry { i, i * 0.5, i % 3, i % 7 }; });
+        assert(writer.append(generated).value() == 10000);
+        assert(writer.finish().value() == 10000);
+        assert(!writer.append(CatalogEntry {}));
+    }
+
+    {
+        auto view = asyncle::format::record_view<CatalogEntry>::open(path);
+        assert(view.has_value() && view->size() == 10000);
+        assert(view->header().block_count == (10000 + 255) / 256);
+        assert(reinterpret_cast<uintptr_t>(view->records().data()) % alignof(CatalogEntry) == 0);
+        uint64_t sum = 0;
+        for(auto const& entry : *view) { sum += entry.id; }
+        assert(sum == 9999ull * 10000 / 2);
+        assert((*view)[4321].price == 4321 * 0.5 && view->at(9999)->region == 9999 % 7);
+        assert(view->at(10000) == nullptr);
+        assert(view->verify().value() == 10000);
+
+        // Same size, different schema version
+        auto other = asyncle::format::record_view<CatalogEntryV2>::open(path);
+        assert(!other && other.error() == asyncle::format::error::type_mismatch);
+    }
+
+    // A flipped data byte fails only its block; a flipped header byte fails open()
+    {
+        asyncle::io::file f;
+        assert(f.open(path, access_mode::read_write));
+        uint32_t flags = 0xFFFF;
+        assert(f.write(&flags, sizeof(flags), 4096 + 3000 * sizeof(CatalogEntry) + 16).value() == sizeof(flags));
+    }
+    {
+        auto view = asyncle::format::record_view<CatalogEntry>::open(path);
+        assert(view.has_value());
+        assert(!view->verify_block(3000 / 256) && view->verify_block(0));
+        assert(!view->verify() && view->verify().error() == asyncle::format::error::invalid_syntax);
+    }
+    {
+        asyncle::io::file f;
+        assert(f.open(path, access_mode::read_write));
+        uint64_t count = 20000;
+        assert(f.write(&count, sizeof(count), offsetof(asyncle::format::record_header, record_count)).value() == 8);
+    }
+    auto corrupt = asyncle::format::record_view<CatalogEntry>::open(path);
+    assert(!corrupt && corrupt.error() == asyncle::format::error::invalid_syntax);
+    std::remove(path);
+
+    std::cout << "  ✓ Records read in place, schema checked, block checksums verified\n";
+}
+
+void test_arena_dom() {
+    std::cout << "Testing mutable DOM in an arena...\n";
+
+    asyncle::io::arena scratch(16 << 20);
+    assert(scratch);
+    const std::string body = R"({"route": {"tenant": "acme", "shard": 7}, "labels": {}, "debug": {"trace": true}})";
+    {
+        asyncle::io::arena_resource             memory(scratch);
+        asyncle::format::json::mutable_document doc(body, &memory);
+        auto                                    root = doc.iterate().value();
+        assert(root["route"]["shard"].set_int64(9));
+        assert(root["labels"].emplace("zone").set_string("eu-west-1b"));
+        assert(root["debug"].erase("trace"));
+
+        // Nodes and patched text live in the arena; untouched strings still point into body
+        assert(scratch.used() > 0 && scratch.owns(root["labels"]["zone"].get_string().value().data()));
+        assert(root["route"]["tenant"].get_string().value().data() == body.data() + body.find("acme"));
+        assert(doc.serialize().value()
+               == R"({"route": {"tenant": "acme", "shard": 9}, "labels": {"zone":"eu-west-1b"}, "debug": {}})");
+    }
+    scratch.reset();
+    assert(scratch.used() == 0);
+    std::cout << "  ✓ Patched in place with nodes bump-allocated from the arena\n";
+}
+
 void test_future_pipeline_design() {
     std::cout << "Testing future pipeline design pattern...\n";
 
@@ -170,6 +794,15 @@ int main() {
 #endif
 
     test_layering_independence();
+    test_padded_sources();
+    test_document_stream();
+    test_sparse_documents();
+    test_parallel_documents();
+    test_parallel_csv();
+    test_field_extraction();
+    test_serialize_sinks();
+    test_record_files();
+    test_arena_dom();
     test_future_pipeline_design();
 
     std::cout << "\n=== Integration tests complete! ===\n";
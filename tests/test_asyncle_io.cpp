@@ -1,9 +1,40 @@
+#include <asyncle/io/arena.hpp>
+#include <asyncle/io/buffer_pool.hpp>
+#include <asyncle/io/buffered_writer.hpp>
+#include <asyncle/io/extents.hpp>
+#include <asyncle/io/capture.hpp>
+#include <asyncle/io/compressed_file.hpp>
+#include <asyncle/io/directory.hpp>
 #include <asyncle/io/file.hpp>
+#include <asyncle/io/growable_mapping.hpp>
+#include <asyncle/io/mapped_reader.hpp>
 #include <asyncle/io/mmap.hpp>
+#include <asyncle/io/process.hpp>
+#include <asyncle/io/read_scheduler.hpp>
+#include <asyncle/io/record_reader.hpp>
+#include <asyncle/io/residency.hpp>
+#include <asyncle/io/snapshot.hpp>
+#include <asyncle/io/stream.hpp>
+#include <asyncle/io/tree_walk.hpp>
+#include <asyncle/system.hpp>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <list>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <poll.h>
+#include <ranges>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace asyncle::io;
 
@@ -100,10 +131,213 @@ int main() {
           << "File capabilities - splice: " << (caps.supports_splice ? "yes" : "no")
           << ", direct_io: " << (caps.supports_direct_io ? "yes" : "no") << "\n";
 
+        // Capabilities are probed once per process; concurrent first calls share one snapshot
+        {
+            const asyncle::system_snapshot* seen[4] = {};
+            std::vector<std::thread>        threads;
+            for(auto& s : seen) threads.emplace_back([&s] { s = &asyncle::system(); });
+            for(auto& t : threads) t.join();
+            for(auto* s : seen) assert(s == &asyncle::system());
+            const auto& sys = asyncle::system();
+            assert(&sys.file == &file::capabilities() && &sys.memory == &mmap::capabilities());
+            assert(&sys.process == &process::capabilities());
+            assert(sys.memory.system_page_size == mmap::page_size() && mmap::align_to_page(1) == mmap::page_size());
+            assert(sys.cache.l1_line_size == asyncle::hardware::detect_cache_line_size());
+            std::cout << "System snapshot - page: " << sys.memory.system_page_size
+                      << ", L1 line: " << sys.cache.l1_line_size << "\n";
+        }
+
+        // Test 7: Asynchronous ring I/O
+        if(caps.supports_async_io) {
+            io_ring ring(16);
+            assert(ring.is_open());
+
+            file f;
+            assert(f.create_temp().has_value());
+
+            char       payload[16];
+            io_request writes[2];
+            std::memcpy(payload, "ring-onering-two", sizeof(payload));
+            for(int i = 0; i < 2; ++i) {
+                writes[i].buffer = payload + i * 8;
+                writes[i].length = 8;
+                writes[i].offset = static_cast<uint64_t>(i) * 8;
+            }
+            assert(f.queue_write(ring, writes, 2, 10).value() == 2);
+            assert(f.queue_sync(ring, 20).value() == 1);
+            assert(ring.queued() == 3);
+
+            io_completion completions[4];
+            auto          drained = ring.drain(completions);
+            assert(drained.has_value() && drained.value() == 3);
+            assert(ring.in_flight() == 0);
+            assert(completions[2].user_data == 20);  // The sync drains behind both writes
+
+            char       readback[16] = {};
+            io_request read_req;
+            read_req.buffer = readback;
+            read_req.length = sizeof(readback);
+            read_req.offset = 0;
+            assert(f.queue_read(ring, &read_req, 1).value() == 1);
+            assert(ring.submit(1).has_value());
+            auto reaped = ring.complete(completions);
+            assert(reaped.has_value() && reaped.value() == 1);
+            assert(completions[0].result.bytes_transferred == 16);
+            assert(std::memcmp(readback, "ring-onering-two", 16) == 0);
+
+            // min_count beyond what is in flight returns instead of blocking
+            assert(f.queue_read(ring, &read_req, 1).value() == 1);
+            auto capped = ring.complete(completions, 4, 4);
+            assert(capped.has_value() && capped.value() == 1 && ring.in_flight() == 0);
+            capped = ring.complete(completions, 4, 4);
+            assert(capped.has_value() && capped.value() == 0);
+
+            // Moved-from ring rejects operations
+            io_ring moved = std::move(ring);
+            assert(moved.is_open() && !ring.is_open());
+            assert(!ring.submit().has_value());
+            std::cout << "Ring I/O - batch write/sync/read completed\n";
+        }
+
+        // Test 8: Direct I/O buffer pool with fixed ring buffers
+        {
+            // A second release of the same buffer leaves the free list intact
+            dio_buffer_pool plain(4096, 2);
+            assert(plain.is_valid());
+            dio_buffer first = plain.acquire();
+            plain.release(first);
+            plain.release(first);
+            assert(plain.available() == 2);
+            dio_buffer x = plain.acquire(), y = plain.acquire();
+            assert(x && y && x.index != y.index && !plain.acquire());
+            plain.release(x);
+            plain.release(y);
+
+            file         direct;
+            file_request dreq {};
+            dreq.access = static_cast<access_mode>(
+              static_cast<uint8_t>(access_mode::read_write) | static_cast<uint8_t>(access_mode::direct));
+            if(direct.create_temp("/tmp", dreq).has_value()) {
+                auto alignment = direct.direct_io_alignment();
+                assert(alignment.has_value() && alignment.value().offset_align > 0);
+
+                auto pool = dio_buffer_pool::for_file(direct, 4000, 4);
+                assert(pool.is_valid() && pool.capacity() == 4 && pool.available() == 4);
+                assert(pool.buffer_size() % pool.alignment() == 0 && pool.buffer_size() >= 4000);
+
+                dio_buffer a = pool.acquire();
+                dio_buffer b = pool.acquire();
+                assert(a && b && a.index != b.index && pool.available() == 2);
+                assert(reinterpret_cast<uintptr_t>(a.data) % pool.alignment() == 0);
+                assert(reinterpret_cast<uintptr_t>(b.data) % pool.alignment() == 0);
+
+                std::memset(a.data, 'd', a.size);
+                auto written = direct.write(a.data, a.size, 0);
+                assert(written.has_value() && written.value() == a.size);
+
+                if(caps.supports_async_io) {
+                    io_ring ring(8);
+                    assert(pool.register_with(ring).has_value());
+
+                    io_request fixed_read = b.request(0);
+                    assert(direct.queue_read_fixed(ring, &fixed_read, 1, 5).value() == 1);
+                    io_completion done[1];
+                    assert(ring.submit(1).has_value());
+                    auto reaped = ring.complete(done, 1);
+                    assert(reaped.has_value() && reaped.value() == 1);
+                    assert(done[0].error.code == error_code::success);
+                    assert(done[0].result.bytes_transferred == b.size);
+                    assert(std::memcmp(a.data, b.data, b.size) == 0);
+                    assert(ring.unregister_buffers().has_value());
+                }
+
+                pool.release(a);
+                pool.release(b);
+                assert(pool.available() == 4);
+
+                // Exhaustion returns an invalid buffer
+                dio_buffer all[4];
+                for(auto& buf: all) { buf = pool.acquire(); }
+                assert(!pool.acquire());
+                for(auto& buf: all) { pool.release(buf); }
+                std::cout << "Direct I/O pool - alignment " << pool.alignment() << ", buffer " << pool.buffer_size()
+                          << " bytes\n";
+            }
+        }
+
         // Cleanup
         std::remove(test_file);
     }
 
+    // Test streaming transfer engine
+    std::cout << "\n=== Testing Stream Transfer ===\n";
+    {
+        // 300 KiB source: larger than a default pipe so the loop runs several rounds
+        const size_t      blob_size = 300 * 1024;
+        std::vector<char> blob(blob_size);
+        for(size_t i = 0; i < blob_size; ++i) { blob[i] = static_cast<char>(i * 31 + 7); }
+
+        file src;
+        assert(src.create_temp().has_value());
+        assert(src.write(blob.data(), blob.size(), 0).value() == blob.size());
+
+        stream_transfer stream;
+
+        // File -> pipe, drained by a reader thread
+        int fds[2];
+        assert(::pipe(fds) == 0);
+        std::vector<char> received;
+        std::thread       reader([&] {
+            char    chunk[8192];
+            ssize_t n;
+            while((n = ::read(fds[0], chunk, sizeof(chunk))) > 0) { received.insert(received.end(), chunk, chunk + n); }
+        });
+        auto sent = stream.send(src, 0, blob_size, fds[1]);
+        ::close(fds[1]);
+        reader.join();
+        ::close(fds[0]);
+        assert(sent.has_value() && sent.value() == blob_size);
+        assert(received == blob);
+        assert(stream.has_pipe() && stream.pipe_size() > 0);
+        std::cout << "File -> pipe: " << sent.value() << " bytes, pipe size " << stream.pipe_size() << "\n";
+
+        // Range past EOF is short, not an error
+        int tail_fds[2];
+        assert(::pipe(tail_fds) == 0);
+        auto tail = stream.send(src, blob_size - 100, 4096, tail_fds[1]);
+        assert(tail.has_value() && tail.value() == 100);
+        ::close(tail_fds[0]);
+        ::close(tail_fds[1]);
+
+        // File -> file at explicit offsets (copy_file_range)
+        file dst;
+        assert(dst.create_temp().has_value());
+        auto copied = stream.copy(src, 1000, dst, 10, 50000);
+        assert(copied.has_value() && copied.value() == 50000);
+        std::vector<char> check(50000);
+        assert(dst.read(check.data(), check.size(), 10).value() == check.size());
+        assert(std::memcmp(check.data(), blob.data() + 1000, check.size()) == 0);
+        std::cout << "File -> file copy: " << copied.value() << " bytes\n";
+
+        // Mapping -> pipe (vmsplice), small enough to sit in the pipe
+        mmap region(4096);
+        assert(region.is_mapped());
+        std::memcpy(region.data(), "mapped-bytes", 12);
+        int map_fds[2];
+        assert(::pipe(map_fds) == 0);
+        auto spliced = stream.send(region, 0, 12, map_fds[1]);
+        assert(spliced.has_value() && spliced.value() == 12);
+        char out[12];
+        assert(::read(map_fds[0], out, sizeof(out)) == 12);
+        assert(std::memcmp(out, "mapped-bytes", 12) == 0);
+        ::close(map_fds[0]);
+        ::close(map_fds[1]);
+
+        // Closed input is rejected
+        file closed;
+        assert(!stream.send(closed, 0, 10, 1).has_value());
+    }
+
     // Test mmap module
     std::cout << "\n=== Testing Mmap Module ===\n";
     {
@@ -192,6 +426,69 @@ int main() {
                 std::cout << "Verified file modification through mmap\n";
             }
 
+            // Dirty ranges: only the written pages are synced
+            {
+                const size_t page = mmap::page_size();
+                file         f(mmap_file, access_mode::read_write);
+                assert(f.truncate(64 * page).has_value());
+                memory_request req {};
+                req.length  = 64 * page;
+                req.backing = backing_type::file_backed;
+                req.access  = mmap_access::access_mode::read_write;
+                req.sharing = sharing_mode::shared;
+                req.sync    = sync_semantics::durable_sync;  // Falls back to a plain mapping off DAX
+                mmap m(f, req);
+                assert(m.is_mapped());
+                assert(!m.is_durable() || mmap::capabilities().supports_durable_sync);
+
+                char* data = m.as<char>();
+                auto  put  = [&](size_t at, const char* text) {
+                    std::memcpy(data + at, text, std::strlen(text));
+                    m.mark_dirty(at, std::strlen(text));
+                };
+                put(10, "first");
+                put(page - 2, "span");  // Crosses into page 1: merges with page 0
+                put(5 * page + 7, "fifth");
+                put(4 * page, "fourth");  // Touches page 5: one range for pages 4-5
+                assert(m.dirty_ranges() == 2);
+
+                // More separate ranges than slots fold into neighbours
+                for(size_t p = 10; p < 60; p += 2) m.mark_dirty(p * page, 1);
+                assert(m.dirty_ranges() == mmap::max_dirty_ranges);
+                m.mark_dirty(0, 0);  // Ignored
+                m.mark_dirty(64 * page, 1);
+                assert(m.dirty_ranges() == mmap::max_dirty_ranges);
+
+                assert(m.flush().has_value() && m.dirty_ranges() == 0);
+                assert(m.flush(flush_mode::async_flush).has_value());
+                assert(m.sync_range(5 * page, 100, flush_mode::async_flush).has_value());
+                assert(!m.sync_range(64 * page, 1));
+
+                char back[8] = {};
+                assert(f.read(back, 5, 5 * page + 7).value() == 5 && std::memcmp(back, "fifth", 5) == 0);
+                assert(f.read(back, 4, page - 2).value() == 4 && std::memcmp(back, "span", 4) == 0);
+
+                mmap moved(std::move(m));
+                moved.mark_dirty(0, 1);
+                assert(moved.dirty_ranges() == 1 && moved.sync().has_value() && moved.dirty_ranges() == 0);
+                // The durable path writes back cache lines instead of calling msync
+                memory_request anon {};
+                anon.length  = 4 * page;
+                anon.backing = backing_type::anonymous;
+                anon.access  = mmap_access::access_mode::read_write;
+                anon.sharing = sharing_mode::private_cow;
+                auto region  = mmap_access::map_memory(-1, anon);
+                assert(region.has_value());
+                region->actual_sync = sync_semantics::durable_sync;
+                mmap pmem(*region);
+                pmem.as<char>()[100] = 'p';
+                pmem.mark_dirty(100, 1);
+                assert(pmem.is_durable() && pmem.flush().has_value() && pmem.sync_range(3, 2 * page).has_value());
+
+                std::cout << "Dirty ranges coalesced and flushed (durable mapping: "
+                          << (moved.is_durable() ? "yes" : "no") << ")\n";
+            }
+
             std::remove(mmap_file);
         }
 
@@ -234,6 +531,891 @@ int main() {
         assert(aligned % mmap::page_size() == 0);
     }
 
+    // Test growable mapping
+    std::cout << "\n=== Testing Growable Mapping ===\n";
+    {
+        const size_t page = mmap::page_size();
+        file         f;
+        assert(f.create_temp().has_value());
+        assert(f.write("header", 6).value() == 6);
+
+        growable_mapping column(f, 64 * page);
+        assert(column && column.size() == 6 && column.capacity() == 64 * page);
+        char* base   = column.as<char>();
+        char* header = base;  // Cached pointers survive every grow
+        assert(std::memcmp(header, "header", 6) == 0);
+
+        for(uint64_t size : { uint64_t { 100 }, uint64_t { page + 1 }, uint64_t { 10 * page },
+                              uint64_t { 40 * page + 3 } }) {
+            assert(column.grow(size).has_value());
+            assert(column.data() == base && column.size() == size && f.size().value() == size);
+            base[size - 1] = 'z';  // The last byte is mapped
+        }
+        assert(std::memcmp(header, "header", 6) == 0);
+
+        // Shrinking is a no-op; growing past the reservation fails and changes nothing
+        assert(column.grow(10).has_value() && column.size() == 40 * page + 3);
+        assert(!column.grow(64 * page + 1) && column.size() == 40 * page + 3);
+
+        // Stores reach the file
+        std::memcpy(base + 20 * page, "grown", 5);
+        assert(column.sync().has_value());
+        assert(column.sync_range(20 * page, 5).has_value());
+        char back[8] = {};
+        assert(f.read(back, 5, 20 * page).value() == 5 && std::memcmp(back, "grown", 5) == 0);
+        assert(f.read(back, 1, 40 * page + 2).value() == 1 && back[0] == 'z');
+
+        growable_mapping moved(std::move(column));
+        assert(!column && moved.data() == base && moved.grow(50 * page).has_value());
+        moved.close();
+        assert(!moved && f.size().value() == 50 * page);
+
+        // An empty file maps nothing until the first grow
+        file empty;
+        assert(empty.create_temp().has_value());
+        growable_mapping fresh(empty, 16 * page);
+        assert(fresh && fresh.size() == 0 && fresh.sync().has_value());
+        assert(fresh.grow(3).has_value());
+        std::memcpy(fresh.data(), "abc", 3);
+        assert(fresh.sync().has_value() && empty.read(back, 3, 0).value() == 3 && std::memcmp(back, "abc", 3) == 0);
+
+        file closed;
+        assert(!growable_mapping(closed));
+        std::cout << "Grew in place to " << 50 * page << " bytes with stable pointers\n";
+    }
+
+    // Test residency queries, prewarm and eviction
+    std::cout << "\n=== Testing Residency ===\n";
+    {
+        const size_t      page = mmap::page_size();
+        file              f;
+        std::vector<char> data(64 * page, 'r');
+        assert(f.create_temp().has_value());
+        assert(f.write(data.data(), data.size()).value() == data.size());
+        assert(f.sync().has_value());  // Clean pages can be evicted
+
+        mmap view;
+        assert(view.map_file(f, data.size()).has_value());
+        assert(view.evict().has_value());
+        const size_t cold = view.resident_bytes().value();  // tmpfs keeps its pages
+        assert(cold <= data.size());
+
+        // One thread, 8-page chunks: every byte is either read or already there
+        auto warmed = prewarm(f, 0, 0, { .concurrency = 1, .bytes_in_flight = 8 * page });
+        assert(warmed && warmed->bytes_read + warmed->bytes_resident == data.size());
+        assert(view.resident_bytes().value() == data.size());
+        unsigned char pages[64] = {};
+        assert(view.residency(pages).value() == 64 && (pages[63] & 1));
+        assert(view.residency(std::span(pages, 4), 10 * page + 1).value() == 4);
+        assert(view.resident_bytes(page / 2, page).value() == page);  // Partial pages count their bytes
+
+        // Resident chunks are skipped without reading
+        auto again = prewarm(f, 0, 0, { .concurrency = 4, .bytes_in_flight = 16 * page });
+        assert(again && again->bytes_read == 0 && again->chunks == 0 && again->bytes_resident == data.size());
+
+        // A sub-range from a mid-page offset: 4 threads of 4-page chunks
+        assert(evict(f).has_value());
+        prewarm_options all { .concurrency = 4, .bytes_in_flight = 16 * page, .skip_resident = false };
+        auto            part = prewarm(f, 3 * page + 5, 20 * page, all);
+        assert(part && part->chunks == 6 && part->bytes_read == 20 * page + 5 && part->bytes_resident == 0);
+        assert(view.resident_bytes(3 * page, 20 * page).value() == 20 * page);
+
+        assert(view.populate(40 * page, page).has_value() && view.resident_bytes(40 * page, page).value() == page);
+        assert(prewarm(f, data.size()).value().chunks == 0);  // Past the end
+        file closed;
+        mmap unmapped;
+        assert(!prewarm(closed) && !evict(closed));
+        assert(!unmapped.resident_bytes() && !unmapped.evict() && !unmapped.populate());
+        assert(!view.resident_bytes(data.size()));
+        std::cout << "Evicted to " << cold << " resident bytes, prewarmed " << warmed->chunks << " chunks back\n";
+    }
+
+    // Test parallel snapshot loading and verification
+    std::cout << "\n=== Testing Snapshot Loader ===\n";
+    {
+        const size_t      page = mmap::page_size();
+        file              f;
+        std::vector<char> data(37 * page + 123);
+        for(size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i * 131 + (i >> 12));
+        assert(f.create_temp().has_value());
+        assert(f.write(data.data(), data.size()).value() == data.size());
+        assert(f.sync().has_value());
+        assert(evict(f).has_value());
+
+        const auto bytes    = std::as_bytes(std::span<const char>(data));
+        const auto manifest = snapshot_checksums(bytes, 4 * page);
+        assert(manifest.size() == 10);
+
+        asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 3 });
+        for(bool running : { true, false }) {
+            if(!running) pool.stop();
+            std::vector<snapshot_progress> reports;
+            auto snap = load_snapshot(f, pool, { .block_size = 4 * page - 100, .expected = manifest },
+                                      [&](const snapshot_progress& p) { reports.push_back(p); });
+            assert(snap && snap->size() == data.size() && snap->block_size() == 4 * page);
+            assert(std::memcmp(snap->data(), data.data(), data.size()) == 0);
+            assert(std::equal(manifest.begin(), manifest.end(), snap->checksums().begin()));
+            assert(snap->mapping().resident_bytes().value() == data.size());
+
+            // Reports never go backwards and the last one covers the whole file
+            assert(!reports.empty());
+            for(size_t i = 1; i < reports.size(); ++i) assert(reports[i].bytes_done >= reports[i - 1].bytes_done);
+            assert(reports.back().bytes_done == data.size() && reports.back().blocks_done == 10);
+            assert(reports.back().blocks_total == 10 && reports.back().bad_blocks == 0);
+        }
+
+        // A flipped byte in block 7 fails the load and is reported
+        asyncle::concurrent::work_stealing_pool workers(asyncle::concurrent::pool_options { .workers = 2 });
+        auto                                    wrong = manifest;
+        wrong[7] ^= 1;
+        snapshot_progress last;
+        auto bad = load_snapshot(f, workers, { .block_size = 4 * page, .expected = wrong },
+                                 [&](const snapshot_progress& p) { last = p; });
+        assert(!bad && bad.error().code == error_code::io_error);
+        assert(last.bad_blocks == 1 && last.first_bad == 7);
+
+        // Compute-only and unverified loads; a manifest of the wrong length is refused
+        auto sums = load_snapshot(f, workers, { .block_size = 4 * page, .concurrency = 8 });
+        assert(sums && sums->checksums().size() == 10 && sums->checksums()[9] == manifest[9]);
+        auto lazy = load_snapshot(f, workers, { .populate = mmap_access::populate_strategy::none, .verify = false });
+        assert(lazy && lazy->checksums().empty() && lazy->bytes()[5] == bytes[5]);
+        assert(!load_snapshot(f, workers, { .block_size = page, .expected = manifest }));
+        file closed;
+        assert(!load_snapshot(closed, workers));
+        std::cout << "Loaded " << data.size() << " bytes in " << manifest.size() << " verified blocks\n";
+    }
+
+    // Test sparse extents, copy and scan
+    std::cout << "\n=== Testing Sparse Extents ===\n";
+    {
+        // Data at 0, 1 MiB and 3 MiB in a 4 MiB file; the rest is holes
+        const uint64_t    mib = 1 << 20;
+        std::vector<char> block(64 * 1024);
+        file              in;
+        assert(in.create_temp().has_value());
+        for(uint64_t at : { uint64_t { 0 }, mib, 3 * mib }) {
+            std::fill(block.begin(), block.end(), static_cast<char>('a' + at / mib));
+            assert(in.write(block.data(), block.size(), at).value() == block.size());
+        }
+        assert(in.truncate(4 * mib).has_value());
+
+        std::vector<file_extent> found;
+        extent_iterator          extents(in);
+        for(auto extent = extents.next(); extent && extent->length; extent = extents.next()) found.push_back(*extent);
+        assert(extents.done());
+        uint64_t data = 0;
+        for(const auto& extent : found) data += extent.length;
+        const bool sparse = data < 4 * mib;  // Filesystems without holes report one extent
+        if(sparse) {
+            assert(found.size() == 3 && found[0].offset == 0 && found[1].offset == mib && found[2].offset == 3 * mib);
+        } else {
+            assert(found.size() == 1 && found[0].length == 4 * mib);
+        }
+
+        // A bounded range starting inside a hole
+        extent_iterator ranged(in, mib / 2, 2 * mib);
+        auto            first = ranged.next();
+        assert(first && first->offset == (sparse ? mib : mib / 2));
+        if(sparse) assert(ranged.next().value().length == 0 && ranged.position() == mib / 2 + 2 * mib);
+
+        // Copying over a dirty destination punches its old data out again
+        file out;
+        assert(out.create_temp().has_value());
+        std::vector<char> junk(5 * mib, 'x');
+        assert(out.write(junk.data(), junk.size(), 0).value() == junk.size());
+        auto copied = sparse_copy(in, out);
+        assert(copied && copied->bytes_copied == data && copied->bytes_copied + copied->bytes_skipped == 4 * mib);
+        assert(out.size().value() == 4 * mib);
+        std::vector<char> a(4 * mib), b(4 * mib);
+        assert(in.read(a.data(), a.size(), 0).value() == a.size());
+        assert(out.read(b.data(), b.size(), 0).value() == b.size());
+        assert(a == b && b[2 * mib] == 0 && b[3 * mib] == 'd');
+
+        // The scan sees only data, in file order, through 64 KiB windows
+        uint64_t last    = 0;
+        uint64_t letters = 0;
+        auto     visited = scan_data(
+          in,
+          [&](uint64_t offset, std::span<const std::byte> bytes) {
+              assert(offset >= last);
+              last = offset + bytes.size();
+              for(auto c : bytes) letters += c != std::byte { 0 };
+          },
+          64 * 1024);
+        assert(visited && *visited == data && letters == 3 * block.size());
+
+        file closed;
+        assert(!extent_iterator(closed).next() && !sparse_copy(closed, out) && !scan_data(closed, [](auto, auto) {}));
+        std::cout << (sparse ? "Found " : "No hole support: ") << found.size() << " extents, copied " << data
+                  << " of " << 4 * mib << " bytes\n";
+    }
+
+    // Test directory listing, batched stat and the parallel tree walk
+    std::cout << "\n=== Testing Directories ===\n";
+    {
+        // root/{f0..f199, sub/{g0..g9, deep/leaf}, link -> f0}
+        char root[] = "/tmp/asyncle_dir_XXXXXX";
+        assert(mkdtemp(root));
+        const std::string base(root);
+        auto              touch = [](const std::string& path, size_t bytes) {
+            file f(path.c_str(),
+                   static_cast<access_mode>(static_cast<uint8_t>(access_mode::read_write)
+                                            | static_cast<uint8_t>(access_mode::create)));
+            assert(f.is_open());
+            std::string fill(bytes, 'x');
+            if(bytes) assert(f.write(fill.data(), fill.size(), 0).value() == bytes);
+        };
+        for(int i = 0; i < 200; ++i) touch(base + "/f" + std::to_string(i), i);
+        assert(mkdir((base + "/sub").c_str(), 0755) == 0 && mkdir((base + "/sub/deep").c_str(), 0755) == 0);
+        for(int i = 0; i < 10; ++i) touch(base + "/sub/g" + std::to_string(i), 1);
+        touch(base + "/sub/deep/leaf", 7);
+        assert(symlink("f0", (base + "/link").c_str()) == 0);
+
+        // A small buffer forces several getdents64 fills; dots are skipped
+        directory dir(root, 4096);
+        assert(dir.is_open() && dir.buffer_size() == 4096);
+        std::set<std::string> names;
+        dir_entry             batch[32];
+        for(auto got = dir.next_batch(batch, 32); got && *got; got = dir.next_batch(batch, 32)) {
+            for(size_t i = 0; i < *got; ++i) names.insert(std::string(batch[i].name));
+        }
+        assert(names.size() == 202 && names.count("sub") && names.count("link") && !names.count("."));
+
+        // Stat a batch with and without a ring; missing names fail alone
+        const char* stat_names[] = { "f5", "sub", "link", "missing" };
+        file_info   infos[4];
+        file_error  errors[4];
+        io_ring     ring(64);
+        for(io_ring* r : { static_cast<io_ring*>(nullptr), &ring }) {
+            auto stated = dir.stat(stat_names, 4, infos, errors, r);
+            assert(stated && *stated == 3);
+            assert(infos[0].type == file_type::regular && infos[0].size == 5);
+            assert(infos[1].type == file_type::directory && infos[2].type == file_type::symlink);
+            assert(errors[0].code == error_code::success && errors[3].code == error_code::file_not_found);
+        }
+        assert(directory(root).next().value().name.size() > 0);
+        assert(!directory("/nonexistent/asyncle").is_open() && !directory((base + "/f1").c_str()).is_open());
+
+        // Walk on a running pool with ring batches, then on a stopped one (runs inline)
+        asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 4 });
+        for(bool running : { true, false }) {
+            if(!running) pool.stop();
+            std::mutex            lock;
+            std::set<std::string> seen;
+            std::atomic<uint64_t> bytes { 0 };
+            auto                  stats = walk_tree(root, pool, [&](const walk_entry& e) {
+                assert(e.error.code == error_code::success && e.path.ends_with(e.name));
+                if(e.info.type == file_type::regular) bytes += e.info.size;
+                std::lock_guard guard(lock);
+                seen.insert(std::string(e.path.substr(base.size())));
+            }, { .use_ring = running });
+            assert(stats && stats->directories == 3 && stats->entries == 214 && stats->errors == 0);
+            assert(seen.size() == 214 && seen.count("/sub/deep/leaf") && seen.count("/link"));
+            assert(bytes == 199 * 200 / 2 + 10 + 7);
+        }
+
+        // Depth limit and type-only listing
+        auto shallow = walk_tree(root, pool, [](const walk_entry& e) { assert(e.depth == 0); }, { .max_depth = 0 });
+        assert(shallow && shallow->directories == 1 && shallow->entries == 202);
+        auto types = walk_tree(root, pool, [](const walk_entry&) {}, { .stat_entries = false });
+        assert(types && types->entries == 214);
+        assert(!walk_tree("/nonexistent/asyncle", pool, [](const walk_entry&) {}));
+
+        std::string cleanup = "rm -rf " + base;
+        assert(std::system(cleanup.c_str()) == 0);
+        std::cout << "Listed " << names.size() << " entries, walked " << types->directories << " directories\n";
+    }
+
+    // Test double-buffered writer
+    std::cout << "\n=== Testing Buffered Writer ===\n";
+    {
+        // Records of 1..29 bytes, so buffer edges fall mid-record
+        std::string expected;
+        for(int i = 0; expected.size() < 100000; ++i) expected.append(std::string(1 + i % 29, 'a' + i % 26));
+        auto read_all = [](file& f) {
+            std::string back(f.size().value(), '\0');
+            assert(f.read(back.data(), back.size(), 0).value() == back.size());
+            return back;
+        };
+
+        for(bool background : { true, false }) {
+            file f;
+            assert(f.create_temp().has_value());
+            buffered_writer out(f, { .buffer_size = 4096, .buffers = 3, .background = background });
+            assert(out.is_open() && out.buffer_size() == 4096);
+            for(size_t at = 0, i = 0; at < expected.size(); at += 1 + i++ % 29) {
+                assert(out.write(expected.data() + at, std::min<size_t>(1 + i % 29, expected.size() - at)));
+            }
+            assert(out.flush() && out.position() == expected.size() && out.buffered() == 0);
+            assert(read_all(f) == expected);
+
+            // A second writer appends after what is there
+            assert(out.close() && !out.is_open());
+            buffered_writer more(f, { .buffer_size = 4096, .background = background });
+            assert(more.position() == expected.size());
+            assert(more.write(std::as_bytes(std::span("tail", 4))) && more.close());
+            assert(read_all(f) == expected + "tail");
+        }
+
+        // O_DIRECT: partial blocks are padded, then trimmed
+        char direct_path[] = "/tmp/asyncle_direct_XXXXXX";
+        int  fd            = mkstemp(direct_path);
+        assert(fd >= 0);
+        ::close(fd);
+        file direct(direct_path,
+                    static_cast<access_mode>(static_cast<uint8_t>(access_mode::read_write)
+                                             | static_cast<uint8_t>(access_mode::direct)));
+        if(direct) {
+            buffered_writer out(direct, { .buffer_size = 64 * 1024, .align_tail = true });
+            assert(out.is_open());
+            assert(out.write(expected.data(), 5000) && out.flush() && direct.size().value() == 5000);
+            assert(out.buffered() > 0 && out.buffered() < 5000);  // Only the partial block stays
+            assert(out.write(expected.data() + 5000, 70000) && out.close());
+            assert(direct.size().value() == 75000);
+
+            // Reopening reads the partial last block back
+            buffered_writer again(direct, { .buffer_size = 64 * 1024, .align_tail = true });
+            assert(again.position() == 75000 && again.buffered() > 0);
+            assert(again.write(expected.data() + 75000, 25000) && again.close());
+            file check(direct_path, access_mode::read_only);
+            assert(read_all(check) == expected.substr(0, 100000));
+            std::cout << "O_DIRECT writer trimmed to " << check.size().value() << " bytes\n";
+        } else {
+            std::cout << "Direct I/O not supported in /tmp; skipped the aligned tail\n";
+        }
+        ::unlink(direct_path);
+
+        file closed;
+        assert(!buffered_writer(closed).is_open() && !buffered_writer().write("x", 1));
+        std::cout << "Wrote " << expected.size() << " bytes through 4 KiB buffers\n";
+
+        // Range writes: one bulk write for contiguous ranges, staged copies otherwise
+        struct sample {
+            uint32_t id;
+            float    value;
+        };
+        std::vector<sample> samples;
+        for(uint32_t i = 0; i < 3000; ++i) samples.push_back(sample { i, i * 0.25f });
+        std::list<sample> listed(samples.begin() + 1000, samples.end());
+
+        file ranged;
+        assert(ranged.create_temp().has_value());
+        assert(ranged.write_range(std::span<const sample>(samples).first(1000), 0).value() == 1000 * sizeof(sample));
+        assert(ranged.write_range(listed, 1000 * sizeof(sample)).value() == 2000 * sizeof(sample));
+        std::vector<sample> back(3000);
+        assert(ranged.read(back.data(), 3000 * sizeof(sample), 0).value() == 3000 * sizeof(sample));
+        assert(back[999].id == 999 && back[1000].id == 1000 && back[2999].value == 2999 * 0.25f);
+
+        file buffered_ranged;
+        assert(buffered_ranged.create_temp().has_value());
+        {
+            buffered_writer out(buffered_ranged, { .buffer_size = 4096, .background = false });
+            assert(out.write_range(samples) && out.write_range(std::views::iota(0u, 100u)) && out.close());
+        }
+        assert(buffered_ranged.size().value() == 3000 * sizeof(sample) + 100 * sizeof(uint32_t));
+        uint32_t tail[100];
+        assert(buffered_ranged.read(tail, sizeof(tail), 3000 * sizeof(sample)).value() == sizeof(tail));
+        assert(tail[0] == 0 && tail[99] == 99);
+        std::cout << "Range writes: " << samples.size() << " records from a span, a list and a view\n";
+    }
+
+    // Test delimited record reader
+    std::cout << "\n=== Testing Record Reader ===\n";
+    {
+        // Lines of 0..299 bytes, one empty line, and a last line without '\n'
+        std::vector<std::string> lines;
+        std::string              text;
+        for(int i = 0; i < 3000; ++i) lines.push_back(std::string(i % 300, 'a' + i % 26));
+        lines.push_back("");
+        lines.push_back("no newline");
+        for(size_t i = 0; i < lines.size(); ++i) text += lines[i] + (i + 1 < lines.size() ? "\n" : "");
+        file f;
+        assert(f.create_temp().has_value());
+        assert(f.write(text.data(), text.size(), 0).value() == text.size());
+
+        // Small blocks and windows so records straddle every edge
+        for(record_source source : { record_source::read, record_source::mapped }) {
+            record_reader reader(f, { .block_size = 4096, .source = source });
+            assert(reader.is_open());
+            size_t           i = 0;
+            std::string_view record;
+            while(reader.next(record).value()) {
+                assert(i < lines.size() && record == lines[i]);
+                ++i;
+            }
+            assert(i == lines.size() && reader.position() == text.size() && !reader.next(record).value());
+
+            // A record longer than max_record fails instead of growing the buffer
+            record_reader bounded(f, { .block_size = 4096, .max_record = 100, .source = source });
+            auto          counted = bounded.for_each([](std::string_view) {});
+            assert(!counted && counted.error().code == error_code::file_too_large);
+        }
+
+        // Other delimiters, and an empty file
+        file csv;
+        assert(csv.create_temp().has_value());
+        assert(csv.write("a,b,,c", 6, 0).value() == 6);
+        std::vector<std::string> fields;
+        record_reader            commas(csv, { .delimiter = ',' });
+        assert(commas.for_each([&](std::string_view v) { fields.emplace_back(v); }).value() == 4);
+        assert(fields == std::vector<std::string>({ "a", "b", "", "c" }));
+        file empty;
+        assert(empty.create_temp().has_value());
+        assert(record_reader(empty).for_each([](std::string_view) { assert(false); }).value() == 0);
+        assert(record_reader(empty, { .source = record_source::mapped }).for_each([](auto) {}).value() == 0);
+
+        file closed;
+        std::string_view none;
+        assert(!record_reader(closed).is_open() && !record_reader().next(none));
+        std::cout << "Split " << lines.size() << " records through 4 KiB blocks and windows\n";
+    }
+
+    // Test budgeted multi-file reads
+    std::cout << "\n=== Testing Read Scheduler ===\n";
+    {
+        // Byte i of file f is (f * 31 + i) % 251, so every chunk can be checked in place
+        const size_t block   = 16 * 1024;
+        const size_t sizes[] = { 0, 1, block - 1, block, block + 1, 5 * block + 77, 300000, 1 << 20 };
+        auto         make    = [&](uint32_t id, size_t size) {
+            std::vector<char> content(size);
+            for(size_t i = 0; i < size; ++i) content[i] = static_cast<char>((id * 31 + i) % 251);
+            file f;
+            assert(f.create_temp().has_value());
+            if(size) assert(f.write(content.data(), size, 0).value() == size);
+            return f;
+        };
+        auto check = [](const read_chunk& chunk) {
+            bool same = chunk.ok();
+            for(size_t i = 0; i < chunk.length; ++i) {
+                same &= chunk.data[i] == static_cast<char>((chunk.file * 31 + chunk.offset + i) % 251);
+            }
+            return same;
+        };
+
+        // Driven by hand: the first fill offers 3 reads to device 1 for every read to device 2
+        {
+            read_scheduler scan({ .block_size = block, .buffers = 8 });
+            assert(scan.is_valid());
+            scan.set_budget(1, { .max_queue_depth = 64, .priority = 3 });
+            scan.set_budget(2, { .max_queue_depth = 64, .priority = 1 });
+            std::vector<uint64_t> expected;
+            for(uint32_t i = 0; i < 16; ++i) {
+                const size_t size = sizes[i % 8];
+                assert(scan.add(make(i, size), i % 2 ? 2 : 1).value() == i);
+                expected.push_back(size);
+            }
+            assert(!scan.finished() && !scan.add("/nonexistent/asyncle_shard"));
+
+            // Peaks are only raised while filling, so after one step they show the first fill's split
+            assert(scan.step().has_value());
+            auto devices = scan.devices();
+            assert(devices.size() == 2 && devices[0].device == 1 && devices[1].device == 2);
+            if(scan.uses_ring()) assert(devices[0].peak_queue_depth == 6 && devices[1].peak_queue_depth == 2);
+
+            std::vector<uint64_t> got(expected.size());
+            bool                  valid = true;
+            read_chunk            chunk;
+            for(;;) {
+                while(scan.try_next(chunk)) {
+                    valid           &= check(chunk);
+                    got[chunk.file] += chunk.length;
+                    scan.release(chunk);
+                }
+                if(scan.finished()) break;
+                assert(scan.step().has_value());
+            }
+            assert(valid && got == expected && !scan.next(chunk));
+            assert(devices[0].bytes + devices[1].bytes == std::accumulate(expected.begin(), expected.end(), 0ull));
+        }
+
+        // Driver thread and three consumers, through the ring and inline; the budgets hold throughout
+        for(bool ring : { true, false }) {
+            read_scheduler scan({ .block_size = block, .buffers = 24, .use_ring = ring });
+            scan.set_budget(1, { .max_bytes_in_flight = 3 * block, .max_queue_depth = 8 });
+            scan.set_budget(2, { .max_bytes_in_flight = 64 * block, .max_queue_depth = 1 });
+            const uint32_t                     files = 64;
+            std::vector<uint64_t>              expected;
+            std::vector<std::atomic<uint64_t>> got(files);
+            for(uint32_t i = 0; i < files; ++i) {
+                expected.push_back(sizes[i % 8]);
+                assert(scan.add(make(i, sizes[i % 8]), i % 3 ? 1 : 2).has_value());
+            }
+
+            std::atomic<bool>        valid { true };
+            std::vector<std::thread> consumers;
+            for(int c = 0; c < 3; ++c) {
+                consumers.emplace_back([&] {
+                    read_chunk chunk;
+                    while(scan.next(chunk)) {
+                        if(!check(chunk)) valid = false;
+                        got[chunk.file] += chunk.length;
+                        scan.release(chunk);
+                    }
+                });
+            }
+            std::thread driver([&] { assert(scan.run().has_value()); });
+            driver.join();
+            for(auto& t : consumers) t.join();
+
+            assert(valid);
+            for(uint32_t i = 0; i < files; ++i) assert(got[i] == expected[i]);
+            auto devices = scan.devices();
+            assert(devices[0].peak_queue_depth <= 8 && devices[0].peak_bytes_in_flight <= 3 * block);
+            assert(devices[1].peak_queue_depth == 1);
+            std::cout << "Read " << files << " files on 2 devices (" << (scan.uses_ring() ? "io_ring" : "pread")
+                      << "), peak depth " << devices[0].peak_queue_depth << " and " << devices[1].peak_queue_depth
+                      << "\n";
+        }
+    }
+
+    // Test framed block compression
+    std::cout << "\n=== Testing Compressed Files ===\n";
+    {
+        // Compressible text with a random tail that must fall back to store
+        std::vector<char> raw;
+        for(int i = 0; raw.size() < 700000; ++i) {
+            auto line = "record " + std::to_string(i % 977) + " status=ok latency=" + std::to_string(i % 13) + "\n";
+            raw.insert(raw.end(), line.begin(), line.end());
+        }
+        uint32_t seed = 12345;
+        for(int i = 0; i < 100000; ++i) raw.push_back(static_cast<char>((seed = seed * 1103515245 + 12345) >> 23));
+
+        // Every block codec round-trips, and zstd answers not_supported without the library
+        for(auto codec : { block_codec::store, block_codec::lz4, block_codec::zstd }) {
+            if(!codec_available(codec)) {
+                char out[64];
+                auto packed = compress_block(codec, 0, raw.data(), 16, out, sizeof(out));
+                assert(!packed && packed.error().code == error_code::not_supported);
+                continue;
+            }
+            for(size_t n : { size_t { 0 }, size_t { 1 }, size_t { 13 }, size_t { 4096 }, raw.size() }) {
+                std::vector<char> packed(compress_bound(codec, n)), back(n);
+                auto              size = compress_block(codec, 0, raw.data(), n, packed.data(), packed.size());
+                assert(size && decompress_block(codec, packed.data(), *size, back.data(), n));
+                assert(n == 0 || std::memcmp(back.data(), raw.data(), n) == 0);
+                if(n > 1 && *size > 0) assert(!decompress_block(codec, packed.data(), *size - 1, back.data(), n));
+            }
+        }
+
+        asyncle::concurrent::work_stealing_pool pool(asyncle::concurrent::pool_options { .workers = 2 });
+        for(bool pooled : { false, true }) {
+            file f;
+            assert(f.create_temp().has_value());
+            {
+                compressed_writer out(f, { .block_size = 64 * 1024 }, pooled ? &pool : nullptr);
+                assert(out && out.write(raw.data(), 1000) && out.flush() && out.blocks_written() == 1);
+                // Uneven writes straddle block boundaries
+                for(size_t at = 1000; at < raw.size(); at += 77777) {
+                    assert(out.write(raw.data() + at, std::min<size_t>(77777, raw.size() - at)));
+                }
+                assert(out.size() == raw.size() && out.finish() && !out.write("x", 1));
+                assert(out.compressed_size() < raw.size());
+            }
+
+            compressed_reader in(f);
+            assert(in && !in.recovered() && in.size() == raw.size() && in.codec() == block_codec::lz4);
+            assert(in.block_count() == 1 + (raw.size() - 1000 + 65535) / 65536);
+            std::vector<char> back(raw.size());
+            assert(in.read(back.data(), back.size(), 0).value() == raw.size() && back == raw);
+
+            // Ranges that start mid-block, straddle blocks and run past the end
+            for(uint64_t at : { uint64_t { 0 }, uint64_t { 999 }, uint64_t { 65000 }, uint64_t { raw.size() - 10 } }) {
+                char part[200000];
+                auto got = in.read(part, sizeof(part), at);
+                assert(got && *got == std::min<uint64_t>(sizeof(part), raw.size() - at));
+                assert(std::memcmp(part, raw.data() + at, *got) == 0);
+            }
+            assert(in.read(back.data(), 10, raw.size()).value() == 0);
+
+            uint64_t expect    = 0;
+            auto     delivered = in.for_each_block(pool, [&](uint64_t at, std::span<const std::byte> block) {
+                assert(at == expect && std::memcmp(block.data(), raw.data() + at, block.size()) == 0);
+                expect += block.size();
+            });
+            assert(delivered && *delivered == raw.size() && expect == raw.size());
+
+            // A throwing callback unwinds only after every decode task is done
+            bool thrown = false;
+            try {
+                (void)in.for_each_block(pool, [](uint64_t at, auto) {
+                    if(at > 0) throw std::runtime_error("stop");
+                });
+            } catch(const std::runtime_error&) { thrown = true; }
+            assert(thrown);
+            std::cout << "Compressed " << raw.size() << " bytes into " << f.size().value() << " in "
+                      << in.block_count() << " blocks (" << (pooled ? "pool" : "inline") << ")\n";
+        }
+
+        // Writers closed right after their last block, while tasks may still be signalling
+        for(int round = 0; round < 100; ++round) {
+            file f;
+            assert(f.create_temp().has_value());
+            compressed_writer out(f, { .block_size = 4096 }, &pool);
+            assert(out.write(raw.data(), 3 * 4096 + 100));
+        }
+
+        // Corruption is detected, and a file without a footer is recovered up to the torn frame
+        {
+            file f;
+            assert(f.create_temp().has_value());
+            compressed_options options { .block_size = 16 * 1024 };
+            {
+                compressed_writer out(f, options);
+                assert(out.write(raw.data(), 100000) && out.flush());
+                const uint64_t frames = out.compressed_size();
+                assert(out.finish());
+                assert(f.truncate(frames - 5));  // Drop the index, footer and end of the last frame
+            }
+            compressed_reader in(f);
+            assert(in && in.recovered() && in.block_count() == 6 && in.size() == 6 * options.block_size);
+            std::vector<char> back(in.size());
+            assert(in.read(back.data(), back.size(), 0).value() == back.size());
+            assert(std::memcmp(back.data(), raw.data(), back.size()) == 0);
+
+            // Flip one payload byte of block 2
+            compressed_frame_header frame;
+            compressed_reader       fresh(f);
+            uint64_t                at   = sizeof(compressed_file_header);
+            for(int k = 0; k < 2; ++k) {
+                assert(f.read(&frame, sizeof(frame), at).value() == sizeof(frame));
+                at += sizeof(frame) + frame.stored_size;
+            }
+            char byte;
+            assert(f.read(&byte, 1, at + sizeof(frame) + 7).value() == 1);
+            byte ^= 0x20;
+            assert(f.write_all(&byte, 1, at + sizeof(frame) + 7));
+            assert(fresh.read_block(1, back.data()) && !fresh.read_block(2, back.data()));
+            auto failed = fresh.read(back.data(), back.size(), 0);
+            assert(!failed && failed.error().code == error_code::io_error);
+            assert(compressed_reader().open(f));  // Frame headers are intact
+
+            // A frame claiming more than a block ends recovery before anything is sized from it
+            assert(f.read(&frame, sizeof(frame), at).value() == sizeof(frame));
+            frame.raw_size   = uint32_t { 1 } << 31;
+            frame.header_crc = asyncle::io::detail::crc_without(frame, &compressed_frame_header::header_crc);
+            assert(f.write_all(&frame, sizeof(frame), at));
+            compressed_reader capped(f);
+            assert(capped && capped.recovered() && capped.block_count() == 2);
+
+            file junk;
+            assert(junk.create_temp().has_value() && junk.write_all("not compressed", 14, 0));
+            assert(!compressed_reader().open(junk));
+            std::cout << "Recovered " << in.block_count() << " blocks without a footer and caught a flipped byte\n";
+        }
+    }
+
+    // Test windowed sequential reader
+    std::cout << "\n=== Testing Mapped Reader ===\n";
+    {
+        const size_t      window    = 64 * 1024;
+        const size_t      file_size = 10 * window + 123;  // Not a window multiple
+        std::vector<char> content(file_size);
+        for(size_t i = 0; i < file_size; ++i) { content[i] = static_cast<char>(i % 251); }
+
+        file f;
+        assert(f.create_temp().has_value());
+        assert(f.write(content.data(), content.size(), 0).value() == content.size());
+
+        mapped_reader reader(f, window);
+        assert(reader.is_open() && reader.size() == file_size && reader.window_size() == window);
+
+        // Full scan: chunks stop at window edges and mapped memory stays bounded
+        size_t total = 0, chunks = 0, max_mapped = 0;
+        for(;;) {
+            auto chunk = reader.next();
+            assert(chunk.has_value());
+            if(chunk.value().empty()) break;
+            assert(std::memcmp(chunk.value().data(), content.data() + total, chunk.value().size()) == 0);
+            total += chunk.value().size();
+            ++chunks;
+            if(reader.mapped_bytes() > max_mapped) max_mapped = reader.mapped_bytes();
+        }
+        assert(total == file_size && reader.eof());
+        assert(chunks == 11);
+        assert(max_mapped <= 2 * window);
+        std::cout << "Scanned " << total << " bytes in " << chunks << " windows, peak mapped " << max_mapped << "\n";
+
+        // Contiguous peek across a window boundary remaps
+        reader.seek(window - 10);
+        auto straddle = reader.peek(20);
+        assert(straddle.has_value() && straddle.value().size() == 20);
+        assert(std::memcmp(straddle.value().data(), content.data() + window - 10, 20) == 0);
+        reader.advance(20);
+        assert(reader.position() == window + 10);
+
+        // Bounded reads and short peek at end of file
+        auto small = reader.next(7);
+        assert(small.has_value() && small.value().size() == 7);
+        reader.seek(file_size - 5);
+        auto tail = reader.peek(100);
+        assert(tail.has_value() && tail.value().size() == 5);
+
+        // Closed file is rejected
+        file          closed;
+        mapped_reader invalid(closed);
+        assert(!invalid.is_open() && !invalid.next().has_value());
+    }
+
+    // Test mmap-backed arena allocator
+    std::cout << "\n=== Testing Arena ===\n";
+    {
+        arena a(64 * 1024 * 1024);
+        assert(a.is_valid());
+        assert(a.capacity() == 64 * 1024 * 1024);
+
+        // Default alignment is a cache line
+        void* first  = a.allocate(10);
+        void* second = a.allocate(10);
+        assert(first && second);
+        assert(reinterpret_cast<uintptr_t>(first) % asyncle::hardware::cache_line_size == 0);
+        assert(reinterpret_cast<uintptr_t>(second) % asyncle::hardware::cache_line_size == 0);
+        assert(static_cast<char*>(second) - static_cast<char*>(first) == asyncle::hardware::cache_line_size);
+        assert(a.owns(first) && !a.owns(&a));
+
+        // Explicit small alignment packs tightly
+        size_t before = a.used();
+        char*  packed = static_cast<char*>(a.allocate(3, 1));
+        assert(packed && a.used() == before + 3);
+
+        // Scoped rollback with mark/rewind
+        size_t    marker = a.mark();
+        uint64_t* values = a.allocate_array<uint64_t>(1000);
+        assert(values);
+        for(size_t i = 0; i < 1000; ++i) { values[i] = i; }
+        a.rewind(marker);
+        assert(a.used() == marker);
+
+        // Requests beyond the reservation fail instead of overrunning
+        assert(a.allocate(a.capacity()) == nullptr);
+
+        // O(1) reset reuses the same addresses
+        a.reset();
+        assert(a.used() == 0);
+        assert(a.allocate(10) == first);
+        std::cout << "Arena bump/rewind/reset: high water " << a.high_water() << " bytes\n";
+
+        // pmr containers on top of the arena; they must be gone before the next reset()
+        a.reset();
+        {
+            arena_resource                     resource(a);
+            std::pmr::vector<int>              numbers(&resource);
+            std::pmr::vector<std::pmr::string> words(&resource);
+            for(int i = 0; i < 10000; ++i) { numbers.push_back(i); }
+            for(int i = 0; i < 100; ++i) { words.emplace_back("a string long enough to skip the small buffer"); }
+            assert(numbers.size() == 10000 && numbers[9999] == 9999);
+            assert(a.owns(numbers.data()) && a.owns(words[42].data()));
+            assert(resource.is_equal(arena_resource(a)));
+            std::cout << "pmr containers allocated " << a.used() << " bytes from the arena\n";
+        }
+
+        // Exhaustion surfaces as std::bad_alloc through memory_resource
+        arena          tiny(mmap::page_size());
+        arena_resource tiny_resource(tiny);
+        bool           threw = false;
+        try {
+            std::pmr::vector<char> big(mmap::page_size() * 2, 'x', &tiny_resource);
+        } catch(const std::bad_alloc&) {
+            threw = true;
+        }
+        assert(threw);
+
+        // trim() returns touched pages beyond the live range to the kernel
+        a.reset();
+        auto trimmed = a.trim();
+        assert(trimmed);
+        assert(a.high_water() == 0);
+        std::cout << "Arena trimmed back to " << a.used() << " bytes\n";
+    }
+
+    std::cout << "\n=== Testing Process Output Capture ===\n";
+    {
+        // 3 MiB of child output: larger than a pipe, wraps a 1 MiB ring
+        const char*  args[] = { "sh", "-c", "head -c 3145728 /dev/zero | tr '\\0' 'x'; echo done >&2", nullptr };
+        const size_t total  = 3 * 1024 * 1024;
+
+        // Redirect: the child writes the file itself, the parent never sees the bytes
+        const char* log_path = "/tmp/test_asyncle_capture.log";
+        {
+            file log(log_path, static_cast<access_mode>(static_cast<uint8_t>(access_mode::write_only)
+                                                        | static_cast<uint8_t>(access_mode::create)
+                                                        | static_cast<uint8_t>(access_mode::truncate)));
+            assert(log);
+
+            spawn_request req {};
+            req.executable = "/bin/sh";
+            req.args       = args;
+            req.redirect_stdout(log.fd());
+            req.redirect_stderr(log.fd());
+
+            process child(req);
+            assert(child && !child.has_stdout() && !child.has_stderr());
+            auto status = child.wait();
+            assert(status && status.value() == 0);
+            assert(log.size() && log.size().value() == total + 5);
+        }
+
+        // Missing descriptor for a redirect is rejected
+        {
+            spawn_request req {};
+            req.executable  = "/bin/sh";
+            req.args        = args;
+            req.stdout_mode = pipe_mode::redirect;
+            assert(!process(req));
+        }
+
+        auto wait_readable = [](const pipe_handle& pipe) {
+            pollfd ready { pipe.fd, POLLIN, 0 };
+            ::poll(&ready, 1, 5000);
+        };
+
+        // Splice a pipe into a file
+        {
+            file sink(log_path, static_cast<access_mode>(static_cast<uint8_t>(access_mode::read_write)
+                                                         | static_cast<uint8_t>(access_mode::truncate)));
+            process  child("/bin/sh", args, pipe_mode::none, pipe_mode::pipe, pipe_mode::none);
+            uint64_t offset = 0;
+            bool     eof    = false;
+            while(!eof) {
+                auto moved = drain_output(child.stdout_pipe(), sink, &offset, eof);
+                assert(moved);
+                if(!eof) wait_readable(child.stdout_pipe());
+            }
+            assert(offset == total);
+            char tail[4] = {};
+            assert(sink.read(tail, 4, total - 4) && std::memcmp(tail, "xxxx", 4) == 0);
+            auto status = child.wait();
+            assert(status && status.value() == 0);
+            std::cout << "Spliced " << offset << " bytes of child output into a file\n";
+        }
+        ::unlink(log_path);
+
+        // Splice a pipe into a shared ring and consume in place
+        {
+            output_ring ring(1024 * 1024);
+            assert(ring && ring.capacity() == 1024 * 1024 && ring.fd() >= 0);
+
+            process child("/bin/sh", args, pipe_mode::none, pipe_mode::pipe, pipe_mode::none);
+            size_t  consumed = 0;
+            bool    all_x    = true;
+            while(!ring.eof() || !ring.empty()) {
+                auto added = ring.fill(child.stdout_pipe());
+                assert(added);
+                if(added.value() == 0 && ring.empty() && !ring.eof()) wait_readable(child.stdout_pipe());
+
+                // Consume in uneven steps so reads straddle the wrap point
+                auto   bytes = ring.readable();
+                size_t step  = std::min<size_t>(bytes.size(), 300000);
+                for(size_t i = 0; i < step; ++i) all_x &= bytes[i] == std::byte { 'x' };
+                ring.consume(step);
+                consumed += step;
+            }
+            assert(all_x && consumed == total);
+            auto status = child.wait();
+            assert(status && status.value() == 0);
+            std::cout << "Consumed " << consumed << " bytes through a " << ring.capacity() << "-byte output ring\n";
+        }
+    }
+
     std::cout << "\n=== All Tests Passed ===\n";
     return 0;
 }
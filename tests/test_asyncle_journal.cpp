@@ -0,0 +1,264 @@
+#include <asyncle/hardware/checksum.hpp>
+#include <asyncle/io/journal.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace asyncle;
+
+// Scratch directory removed with its segments on scope exit
+struct scratch_dir {
+    std::string path;
+
+    scratch_dir() {
+        char name[] = "/tmp/asyncle_journal_XXXXXX";
+        assert(::mkdtemp(name));
+        path = name;
+    }
+
+    ~scratch_dir() {
+        for(uint64_t sequence = 0; sequence < 256; ++sequence) {
+            ::unlink(io::detail::journal_segment_path(path, "wal", sequence).c_str());
+        }
+        ::rmdir(path.c_str());
+    }
+
+    std::string segment(uint64_t sequence) const { return io::detail::journal_segment_path(path, "wal", sequence); }
+};
+
+std::span<const std::byte> bytes_of(const std::string& s) { return std::as_bytes(std::span(s.data(), s.size())); }
+
+struct replayed {
+    std::vector<uint64_t>    lsns;
+    std::vector<std::string> payloads;
+};
+
+replayed replay(const scratch_dir& dir, uint64_t* next = nullptr) {
+    replayed out;
+    auto     end = io::replay_journal(dir.path.c_str(), [&](uint64_t lsn, std::span<const std::byte> payload) {
+        out.lsns.push_back(lsn);
+        out.payloads.emplace_back(reinterpret_cast<const char*>(payload.data()), payload.size());
+    });
+    assert(end.has_value());
+    if(next) *next = *end;
+    return out;
+}
+
+void test_crc32c() {
+    std::cout << "Testing CRC32C...\n";
+
+    const char* check = "123456789";
+    assert(hardware::crc32c(check, 9) == 0xE3069283u);
+    assert(hardware::crc32c(nullptr, 0) == 0);
+
+    // Chaining and the table/instruction variants agree at every length
+    std::vector<unsigned char> data(1000);
+    for(size_t i = 0; i < data.size(); ++i) data[i] = static_cast<unsigned char>(i * 131 + 7);
+    for(size_t n : { 0, 1, 7, 8, 9, 63, 64, 65, 1000 }) {
+        uint32_t whole = hardware::crc32c(data.data(), n);
+        assert(~hardware::detail::crc32c_scalar(~0u, data.data(), n) == whole);
+        for(size_t split : { size_t { 0 }, n / 3, n }) {
+            assert(hardware::crc32c(data.data() + split, n - split, hardware::crc32c(data.data(), split)) == whole);
+        }
+    }
+    std::cout << "  ✓ Check value, chaining, scalar and hardware paths match\n";
+}
+
+void test_append_replay() {
+    std::cout << "Testing append and replay...\n";
+
+    scratch_dir dir;
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str()).has_value());
+        assert(wal.next_lsn() == 1 && wal.durable_lsn() == 0);
+        for(int i = 0; i < 100; ++i) {
+            auto lsn = wal.append(bytes_of("record-" + std::to_string(i)));
+            assert(lsn && *lsn == static_cast<uint64_t>(i + 1));
+        }
+        assert(wal.durable_lsn() == 100 && wal.commits() == 100);  // Nobody to group with
+
+        assert(!wal.append({}));
+        std::vector<std::byte> huge(wal.max_record() + 1);
+        assert(!wal.append(huge));
+    }
+
+    uint64_t next = 0;
+    auto     got  = replay(dir, &next);
+    assert(next == 101 && got.lsns.size() == 100);
+    assert(got.lsns.front() == 1 && got.lsns.back() == 100);
+    assert(got.payloads[42] == "record-42");
+
+    // Reopening continues the LSNs in a fresh segment
+    io::journal wal;
+    assert(wal.open(dir.path.c_str()).has_value());
+    assert(wal.segment() == 1 && wal.next_lsn() == 101);
+    assert(wal.append(bytes_of("after reopen")).value() == 101);
+    assert(replay(dir).payloads.back() == "after reopen");
+    std::cout << "  ✓ Records replay in LSN order across reopen\n";
+}
+
+void test_group_commit() {
+    std::cout << "Testing group commit...\n";
+
+    scratch_dir dir;
+    io::journal wal;
+    assert(wal.open(dir.path.c_str(), io::journal_options { .segment_size = 1 << 20 }).has_value());
+
+    constexpr int            threads    = 8;
+    constexpr int            per_thread = 200;
+    std::atomic<int>         failures { 0 };
+    std::vector<std::thread> appenders;
+    for(int t = 0; t < threads; ++t) {
+        appenders.emplace_back([&, t] {
+            uint64_t last = 0;
+            for(int i = 0; i < per_thread; ++i) {
+                std::string payload = std::to_string(t) + ":" + std::to_string(i);
+                auto        lsn     = wal.append(bytes_of(payload));
+                if(!lsn || *lsn <= last) failures.fetch_add(1);
+                last = lsn ? *lsn : last;
+            }
+        });
+    }
+    for(auto& a : appenders) a.join();
+    assert(failures.load() == 0);
+    assert(wal.durable_lsn() == threads * per_thread);
+    const uint64_t commits = wal.commits();
+    assert(commits >= 1 && commits <= threads * per_thread);
+
+    // Every record once, each thread's in its own order
+    auto             got = replay(dir);
+    std::vector<int> next(threads, 0);
+    assert(got.payloads.size() == threads * per_thread);
+    for(size_t i = 0; i < got.payloads.size(); ++i) {
+        assert(got.lsns[i] == i + 1);
+        auto colon = got.payloads[i].find(':');
+        int  t     = std::stoi(got.payloads[i].substr(0, colon));
+        assert(std::stoi(got.payloads[i].substr(colon + 1)) == next[t]++);
+    }
+    std::cout << "  ✓ " << threads * per_thread << " records from " << threads << " threads in " << commits
+              << " syncs, across " << wal.segment() + 1 << " segments\n";
+}
+
+void test_rolling_and_torn_tail() {
+    std::cout << "Testing segment rolls and torn tails...\n";
+
+    scratch_dir         dir;
+    io::journal_options options { .segment_size = 4200, .sync = io::journal_sync::range };
+    const std::string   block(1000, 'x');
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str(), options).has_value());
+        for(int i = 0; i < 10; ++i) assert(wal.append(bytes_of(block + std::to_string(i))));
+        // 4 records of 1017 bytes fit after the 32-byte header: 1-4, 5-8, 9-10
+        assert(wal.segment() == 2);
+    }
+    uint64_t next = 0;
+    assert(replay(dir, &next).payloads.size() == 10 && next == 11);
+
+    // Tear record 10 (the second in segment 2): the segment ends before it
+    {
+        io::file last(dir.segment(2).c_str(), io::access_mode::read_write);
+        assert(last);
+        char     flip = 0;
+        uint64_t at   = sizeof(io::journal_segment_header) + 1017 + sizeof(io::journal_record_header) + 500;
+        assert(last.read(&flip, 1, at).value() == 1);
+        flip ^= 0x55;
+        assert(last.write(&flip, 1, at).value() == 1);
+    }
+    auto torn = replay(dir, &next);
+    assert(torn.payloads.size() == 9 && next == 10);
+
+    // Recovery resumes at LSN 10 in segment 3; the torn record is never read
+    io::journal wal;
+    assert(wal.open(dir.path.c_str(), options).has_value());
+    assert(wal.segment() == 3 && wal.append(bytes_of("recovered")).value() == 10);
+    auto after = replay(dir);
+    assert(after.lsns.size() == 10 && after.lsns.back() == 10 && after.payloads.back() == "recovered");
+
+    // A damaged segment header is reported, not skipped
+    {
+        io::file first(dir.segment(0).c_str(), io::access_mode::read_write);
+        char     zero = 0;
+        assert(first.write(&zero, 1, 0).value() == 1);
+    }
+    assert(!io::replay_journal(dir.path.c_str(), [](uint64_t, auto) {}));
+    std::cout << "  ✓ Rolls at the segment size, torn records end the segment on recovery\n";
+}
+
+void test_torn_segment_header() {
+    std::cout << "Testing torn segment headers...\n";
+
+    scratch_dir         dir;
+    io::journal_options options { .segment_size = 4096, .sync = io::journal_sync::none };
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str(), options).has_value());
+        for(int i = 0; i < 3; ++i) assert(wal.append(bytes_of("r" + std::to_string(i))));
+    }
+
+    // A crash while open() starts segment 1 leaves it empty: replay ignores it, open() rewrites it
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str(), options).has_value() && wal.segment() == 1);
+    }
+    {
+        io::file newest(dir.segment(1).c_str(), io::access_mode::read_write);
+        assert(newest.truncate(0).has_value());
+    }
+    uint64_t next = 0;
+    assert(replay(dir, &next).payloads.size() == 3 && next == 4);
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str(), options).has_value());
+        assert(wal.segment() == 1 && wal.append(bytes_of("after")).value() == 4);
+    }
+    auto after = replay(dir);
+    assert(after.lsns.size() == 4 && after.payloads.back() == "after");
+
+    // A short header on the newest segment is torn too
+    {
+        io::file newest(dir.segment(2).c_str(), io::access_mode::read_write);
+        assert(!newest);
+        io::file_request request;
+        request.access = static_cast<io::access_mode>(static_cast<uint8_t>(io::access_mode::read_write)
+                                                      | static_cast<uint8_t>(io::access_mode::create));
+        assert(newest.open(dir.segment(2).c_str(), request).has_value());
+        assert(newest.write("AYNC", 4, 0).value() == 4);
+    }
+    {
+        io::journal wal;
+        assert(wal.open(dir.path.c_str(), options).has_value());
+        assert(wal.segment() == 2 && wal.append(bytes_of("again")).value() == 5);
+    }
+    assert(replay(dir).lsns.size() == 5);
+
+    // Only the newest segment may be torn
+    {
+        io::file middle(dir.segment(1).c_str(), io::access_mode::read_write);
+        assert(middle.truncate(0).has_value());
+    }
+    assert(!io::replay_journal(dir.path.c_str(), [](uint64_t, auto) {}));
+    io::journal wal;
+    assert(!wal.open(dir.path.c_str(), options));
+    std::cout << "  ✓ An empty or short newest segment is rewritten; earlier ones stay errors\n";
+}
+
+int main() {
+    std::cout << "=== Journal Tests ===\n\n";
+
+    test_crc32c();
+    test_append_replay();
+    test_group_commit();
+    test_rolling_and_torn_tail();
+    test_torn_segment_header();
+
+    std::cout << "\nAll journal tests passed!\n";
+    return 0;
+}
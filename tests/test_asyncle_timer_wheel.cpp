@@ -0,0 +1,141 @@
+#include <asyncle/io/timer_wheel.hpp>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace asyncle;
+
+struct test_timer: io::timer_node {
+    int      id     = 0;
+    uint64_t wanted = 0;
+    int      fired  = 0;
+};
+
+void test_order_and_cancel() {
+    std::cout << "Testing fire order and cancel...\n";
+
+    io::timer_wheel         wheel(1000);
+    std::vector<test_timer> timers(6);
+    const uint64_t          delays[] = { 5, 1, 64, 63, 4096 + 7, 1 };
+    for(int i = 0; i < 6; ++i) {
+        timers[i].id = i;
+        wheel.schedule(timers[i], 1000 + delays[i]);
+    }
+    assert(wheel.size() == 6);
+    assert(wheel.next_tick() == 1001);
+
+    assert(wheel.cancel(timers[3]));
+    assert(!wheel.cancel(timers[3]));
+    assert(!timers[3].scheduled());
+
+    std::vector<int> order;
+    auto             record = [&](io::timer_node& n) { order.push_back(static_cast<test_timer&>(n).id); };
+    assert(wheel.advance(1000, record) == 0);
+    assert(wheel.advance(1064, record) == 4);
+    // Equal ticks fire together; order within a tick is unspecified
+    assert(order.size() == 4 && order[2] == 0 && order[3] == 2);
+    assert(wheel.size() == 1 && wheel.next_tick() <= 1000 + 4096 + 7);
+
+    assert(wheel.advance(1000 + 4096 + 6, record) == 0);
+    assert(wheel.advance(1000 + 4096 + 7, record) == 1 && order.back() == 4);
+    assert(wheel.empty() && wheel.next_tick() == io::timer_wheel::never);
+    std::cout << "  ✓ Deadlines fire in tick order across levels, cancelled ones never\n";
+}
+
+void test_past_and_far_deadlines() {
+    std::cout << "Testing past and far deadlines...\n";
+
+    io::timer_wheel wheel(500);
+    test_timer      past, far;
+    wheel.schedule(past, 10);                                   // Already due
+    wheel.schedule(far, 500 + io::timer_wheel::span * 3 + 17);  // Beyond the top level
+    int fired = 0;
+    wheel.advance(500, [&](io::timer_node& n) {
+        assert(&n == &past);
+        ++fired;
+    });
+    assert(fired == 1 && past.tick() == 500);
+
+    // Jump straight to each event: the wheel never fires early and skips idle ticks
+    uint64_t steps = 0;
+    while(!wheel.empty()) {
+        uint64_t next = wheel.next_tick();
+        assert(next <= far.tick());
+        wheel.advance(next, [&](io::timer_node& n) {
+            assert(&n == &far && next == far.tick());
+            ++fired;
+        });
+        ++steps;
+    }
+    assert(fired == 2 && steps < 64);
+    std::cout << "  ✓ Past deadlines fire at once, far ones " << steps << " steps later\n";
+}
+
+void test_reschedule_in_fire() {
+    std::cout << "Testing reschedule and cancel from fire...\n";
+
+    io::timer_wheel wheel;
+    test_timer      periodic, victim;
+    wheel.schedule(periodic, 10);
+    wheel.schedule(victim, 10);
+    int runs = 0;
+    for(uint64_t now = 10; now <= 50; now += 10) {
+        wheel.advance(now, [&](io::timer_node& n) {
+            auto& t = static_cast<test_timer&>(n);
+            ++t.fired;
+            if(&t == &periodic) {
+                ++runs;
+                wheel.schedule(periodic, now + 10);
+                wheel.cancel(victim);  // Still pending in the same tick the first time
+            }
+        });
+    }
+    assert(runs == 5 && periodic.fired == 5 && periodic.scheduled());
+    assert(victim.fired <= 1 && !victim.scheduled() && wheel.size() == 1);
+    std::cout << "  ✓ Fire callbacks reschedule themselves and cancel others\n";
+}
+
+void test_random_against_deadlines() {
+    std::cout << "Testing random schedules...\n";
+
+    std::mt19937_64         rng(42);
+    io::timer_wheel         wheel(uint64_t { 1 } << 32);
+    std::vector<test_timer> timers(2000);
+    uint64_t                now = wheel.now();
+    auto                    arm = [&](test_timer& t) {
+        const uint64_t ranges[] = { 64, 5000, uint64_t { 1 } << 22, uint64_t { 1 } << 37 };
+        t.wanted                = now + 1 + rng() % ranges[rng() % 4];
+        wheel.schedule(t, t.wanted);
+    };
+    for(auto& t : timers) arm(t);
+
+    size_t fired = 0;
+    for(int round = 0; round < 4000 && !wheel.empty(); ++round) {
+        now = round % 3 == 0 ? wheel.next_tick() : now + rng() % 1000000;
+        fired += wheel.advance(now, [&](io::timer_node& n) {
+            auto& t = static_cast<test_timer&>(n);
+            assert(t.wanted <= now);  // Never early
+            if(rng() % 4 == 0) arm(t);
+        });
+        if(round % 50 == 0) {
+            for(auto& t : timers) assert(!t.scheduled() || t.wanted > now);  // Never late
+        }
+        wheel.cancel(timers[rng() % timers.size()]);
+    }
+    assert(fired > timers.size() / 2);
+    std::cout << "  ✓ " << fired << " random deadlines fired on time\n";
+}
+
+int main() {
+    std::cout << "Running asyncle timer wheel tests...\n\n";
+
+    test_order_and_cancel();
+    test_past_and_far_deadlines();
+    test_reschedule_in_fire();
+    test_random_against_deadlines();
+
+    std::cout << "\nAll timer wheel tests passed!\n";
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <asyncle/base/command.hpp>
 #include <asyncle/compat.hpp>
+#include <cstddef>
 #include <string>
 
 namespace test_types {
@@ -120,5 +121,24 @@ int main() {
     static_assert(std::same_as<decltype(push_cmd_2), default_push_command>);
     static_assert(std::same_as<decltype(take_cmd_2), default_take_command>);
 
+    // ========== Test flat entry table ==========
+    static_assert(test_command::entry_count == 3);
+    static_assert(test_command::index_of<std::string> == 1);
+    static_assert(test_command::index_of<const double&> == 2);
+    static_assert(test_command::index_of<char> == test_command::entry_count);
+    static_assert(std::same_as<test_command::result_at<1>, expected<PayloadB, TestError>>);
+    static_assert(std::same_as<test_command::result_at<test_command::index_of<int>>, cmd_result_t<test_command, int>>);
+
+    // A runtime entry index reaches the matching instantiation through one table
+    auto entry_size = [](auto index) -> std::size_t {
+        return sizeof(typename test_command::result_at<decltype(index)::value>::value_type);
+    };
+    static_assert(dispatch_entry<test_command>(0, entry_size) == sizeof(PayloadA));
+    static_assert(dispatch_entry<test_command>(2, entry_size) == sizeof(PayloadC));
+    for(std::size_t i = 0; i < test_command::entry_count; ++i) {
+        std::size_t expected_size[] = { sizeof(PayloadA), sizeof(PayloadB), sizeof(PayloadC) };
+        if(dispatch_entry<test_command>(i, entry_size) != expected_size[i]) return 1;
+    }
+
     return 0;
 }
@@ -0,0 +1,215 @@
+#include <asyncle/base/cpo.hpp>
+#include <asyncle/concurrent/hash_map.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace asyncle::concurrent;
+
+// Value whose fields are tied together, to catch torn reads
+struct session {
+    uint64_t id;
+    uint64_t check;
+    uint32_t hits;
+};
+
+static session make_session(uint64_t id, uint32_t hits = 0) { return { id, ~id, hits }; }
+
+// Every key lands in one home bucket, so probe paths get long
+struct collide {
+    size_t operator()(uint64_t) const noexcept { return 0; }
+};
+
+void test_layout() {
+    std::cout << "Testing bucket layout and tag matching...\n";
+
+    // Bit j per matching byte; version bytes included, callers mask them off
+    assert(detail::match_group(0, 0, 0) == 0xffff);
+    assert(detail::match_group(0x8100000000000000ull, 0x81ull, 0x81) == ((1u << 7) | (1u << 8)));
+    assert(detail::match_group(~0ull, ~0ull, 0x80) == 0);
+
+    hash_map<uint64_t, uint64_t> map(1000);
+    assert(map.slot_count() * 7 / 8 >= 1000);
+    assert((map.bucket_count() & (map.bucket_count() - 1)) == 0);
+    assert(map.empty());
+    std::cout << "  ✓ " << map.bucket_count() << " buckets of " << hash_map<uint64_t, uint64_t>::slots_per_bucket
+              << " slots for 1000 entries\n";
+}
+
+void test_single_thread() {
+    std::cout << "Testing insert/find/erase against unordered_map...\n";
+
+    hash_map<uint64_t, session>            map(20000);
+    std::unordered_map<uint64_t, session> reference;
+    uint64_t                              x = 88172645463325252ull;
+    for(int i = 0; i < 200000; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        uint64_t key = x % 30000;
+        switch(x >> 62) {
+        case 0:
+        case 1: {
+            insert_status status = map.insert(key, make_session(key, i));
+            bool          fresh  = reference.emplace(key, make_session(key, i)).second;
+            assert(status == (fresh ? insert_status::inserted : insert_status::exists));
+            break;
+        }
+        case 2: {
+            bool erased = map.erase(key);
+            assert(erased == (reference.erase(key) == 1));
+            break;
+        }
+        default: {
+            auto found = map.get(key);
+            auto it    = reference.find(key);
+            assert(found.has_value() == (it != reference.end()));
+            if(found) assert(found->id == key && found->hits == it->second.hits);
+        }
+        }
+    }
+    assert(map.size() == reference.size());
+
+    // insert_or_assign, update and take
+    map.insert_or_assign(1, make_session(1, 5));
+    assert(map.insert_or_assign(1, make_session(1, 6)) == insert_status::assigned);
+    assert(map.update(1, [](session& s) { ++s.hits; }));
+    assert(map.get(1)->hits == 7);
+    assert(!map.update(1u << 30, [](session&) {}));
+    session out {};
+    assert(map.take(1, out) && out.hits == 7);
+    assert(!map.contains(1));
+
+    size_t visited = 0;
+    map.for_each([&](uint64_t key, const session& s) {
+        assert(s.id == key && s.check == ~key);
+        ++visited;
+    });
+    assert(visited == map.size());
+    std::cout << "  ✓ 200000 random operations match, " << map.size() << " entries left\n";
+}
+
+void test_probe_paths() {
+    std::cout << "Testing colliding keys and tombstones...\n";
+
+    // All keys share one home bucket, so they spill across several buckets
+    hash_map<uint64_t, uint64_t, collide> map(64);
+    for(uint64_t k = 0; k < 40; ++k) assert(map.insert(k, k * 10) == insert_status::inserted);
+    for(uint64_t k = 0; k < 40; ++k) assert(map.get(k).value() == k * 10);
+
+    // Erasing inside a full bucket leaves a tombstone; keys further along stay reachable
+    assert(map.erase(3));
+    for(uint64_t k = 4; k < 40; ++k) assert(map.contains(k));
+    assert(map.insert(100, 1000) == insert_status::inserted);  // Reuses the tombstone
+    assert(map.get(100).value() == 1000);
+
+    // A full table says so
+    hash_map<uint64_t, uint64_t, collide> tiny(1);
+    size_t inserted = 0;
+    while(tiny.insert(inserted, 0) == insert_status::inserted) ++inserted;
+    assert(inserted == tiny.slot_count());
+    assert(tiny.insert(inserted, 0) == insert_status::full);
+    std::cout << "  ✓ " << inserted << " slots filled, then full\n";
+}
+
+void test_cpo() {
+    std::cout << "Testing CPO integration...\n";
+
+    hash_map<uint64_t, uint64_t> map(16);
+    assert(asyncle::try_push(map, std::pair<uint64_t, uint64_t> { 7, 70 }).has_value());
+    assert(!asyncle::try_push(map, std::pair<uint64_t, uint64_t> { 7, 71 }).has_value());
+
+    auto made = asyncle::make(map, uint64_t { 7 });
+    assert(made.has_value() && *made == 70);
+    assert(!asyncle::make(map, 8).has_value());  // Any key-convertible payload
+
+    assert(asyncle::can_take(map) == asyncle::check_status::TRUE);
+    std::pair<uint64_t, uint64_t> kv { 7, 0 };
+    assert(asyncle::try_take(map, kv).has_value() && kv.second == 70);
+    assert(!asyncle::try_take(map, kv).has_value());
+    assert(asyncle::can_take(map) == asyncle::check_status::FALSE);
+    assert(asyncle::can_push(map) == asyncle::check_status::TRUE);
+    std::cout << "  ✓ make/try_push/try_take/can_*\n";
+}
+
+// Readers never see a torn session while writers insert, assign and erase
+void test_concurrent() {
+    std::cout << "Testing concurrent readers and writers...\n";
+
+    constexpr uint64_t keys    = 4096;
+    constexpr int      writers = 3;
+    constexpr int      readers = 3;
+    hash_map<uint64_t, session> map(keys);
+    std::atomic<bool>           done { false };
+    std::atomic<uint64_t>       hits { 0 };
+
+    std::vector<std::thread> threads;
+    for(int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            uint64_t x = 0x9e3779b97f4a7c15ull * (w + 1);
+            for(int i = 0; i < 100000; ++i) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                uint64_t key = x % keys;
+                if(x & 1) {
+                    map.insert_or_assign(key, make_session(key, static_cast<uint32_t>(i)));
+                } else {
+                    map.erase(key);
+                }
+            }
+        });
+    }
+    for(int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            uint64_t local = 0;
+            session  s {};
+            while(!done.load(std::memory_order_acquire)) {
+                for(uint64_t key = 0; key < keys; ++key) {
+                    if(map.find(key, s)) {
+                        assert(s.id == key && s.check == ~key);
+                        ++local;
+                    }
+                }
+            }
+            hits.fetch_add(local);
+        });
+    }
+    for(int w = 0; w < writers; ++w) threads[w].join();
+    done.store(true, std::memory_order_release);
+    for(size_t t = writers; t < threads.size(); ++t) threads[t].join();
+
+    // Counted size agrees with a full walk
+    size_t walked = 0;
+    map.for_each([&](uint64_t, const session&) { ++walked; });
+    assert(walked == map.size());
+
+    // Counters bumped concurrently through update() lose nothing
+    assert(map.insert_or_assign(keys + 1, make_session(keys + 1)) != insert_status::full);
+    std::vector<std::thread> bumpers;
+    for(int t = 0; t < 4; ++t) {
+        bumpers.emplace_back([&] {
+            for(int i = 0; i < 10000; ++i) map.update(keys + 1, [](session& s) { ++s.hits; });
+        });
+    }
+    for(auto& t : bumpers) t.join();
+    assert(map.get(keys + 1)->hits == 40000);
+    std::cout << "  ✓ " << hits.load() << " consistent hits, " << walked << " entries at the end\n";
+}
+
+int main() {
+    std::cout << "Running concurrent::hash_map tests...\n\n";
+
+    test_layout();
+    test_single_thread();
+    test_probe_paths();
+    test_cpo();
+    test_concurrent();
+
+    std::cout << "\nAll hash_map tests passed!\n";
+    return 0;
+}
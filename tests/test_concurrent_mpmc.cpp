@@ -0,0 +1,233 @@
+#include <asyncle/concepts/operation_concepts.hpp>
+#include <asyncle/concurrent/mpmc_queue.hpp>
+#include <asyncle/concurrent/spsc_ring.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace asyncle;
+using asyncle::concurrent::mpmc_queue;
+using asyncle::concurrent::spsc_ring;
+
+// Payload concepts require aggregate objects
+struct message {
+    uint64_t sequence;
+    uint32_t source;
+};
+
+static_assert(pushable<mpmc_queue<message, 8>, message>);
+static_assert(takeable<mpmc_queue<message, 8>, message>);
+
+// Written once against the concepts; accepts either queue
+template <typename Queue>
+requires pushable<Queue, message> && takeable<Queue, message>
+uint64_t round_trip(Queue& queue, uint32_t count) {
+    for(uint32_t i = 0; i < count; ++i) {
+        if(!try_push(queue, message { i, 0 }).has_value()) break;
+    }
+    uint64_t sum = 0;
+    message  received {};
+    while(try_take(queue, received).has_value()) { sum += received.sequence; }
+    return sum;
+}
+
+void test_basic_operations() {
+    std::cout << "Testing basic push/take...\n";
+
+    mpmc_queue<int, 4> queue;
+    assert(queue.empty());
+    assert(queue.capacity() == 4);
+
+    for(int i = 0; i < 4; ++i) { assert(queue.push(i)); }
+    assert(queue.full());
+    assert(!queue.push(99));
+
+    int value = -1;
+    for(int i = 0; i < 4; ++i) {
+        assert(queue.take(value));
+        assert(value == i);
+    }
+    assert(!queue.take(value));
+
+    // Several laps around the slot array
+    for(int round = 0; round < 20; ++round) {
+        assert(queue.push(round));
+        assert(queue.take(value) && value == round);
+    }
+    assert(queue.empty());
+    std::cout << "  ✓ FIFO order, full and empty detection\n";
+}
+
+void test_generic_queue_code() {
+    std::cout << "Testing shared CPO surface...\n";
+
+    mpmc_queue<message, 16> mpmc;
+    spsc_ring<message, 16>  spsc;
+    assert(round_trip(mpmc, 10) == 45);
+    assert(round_trip(spsc, 10) == 45);
+
+    // Rejections surface as error false through the CPOs
+    mpmc_queue<int, 2> small;
+    assert(try_push(small, 1).has_value());
+    assert(try_push(small, 2).has_value());
+    auto rejected = try_push(small, 3);
+    assert(!rejected.has_value() && rejected.error() == false);
+    assert(can_push(small) == check_status::FALSE);
+    assert(can_take(small) == check_status::TRUE);
+    std::cout << "  ✓ Same generic code drives mpmc_queue and spsc_ring\n";
+}
+
+void test_element_lifetime() {
+    std::cout << "Testing non-trivial element lifetime...\n";
+
+    auto tracker = std::make_shared<int>(0);
+    {
+        mpmc_queue<std::shared_ptr<int>, 4> queue;
+        assert(queue.push(tracker));
+        assert(queue.push(tracker));
+        std::shared_ptr<int> out;
+        assert(queue.take(out));
+        out.reset();
+        assert(tracker.use_count() == 2);
+    }
+    assert(tracker.use_count() == 1);
+    std::cout << "  ✓ Remaining elements destroyed with the queue\n";
+}
+
+void test_fan_in_fan_out() {
+    std::cout << "Testing multiple producers and consumers...\n";
+
+    constexpr uint32_t       producers    = 4;
+    constexpr uint32_t       consumers    = 2;
+    constexpr uint64_t       per_producer = 50000;
+    mpmc_queue<message, 256> queue;
+
+    std::atomic<uint64_t> consumed { 0 };
+    std::atomic<uint64_t> total { 0 };
+    std::vector<uint64_t> last_seen(producers * consumers, 0);
+
+    std::vector<std::thread> threads;
+    for(uint32_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            message m {};
+            while(consumed.load(std::memory_order_relaxed) < producers * per_producer) {
+                if(!queue.take(m)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // Per consumer, each producer's sequence numbers arrive in increasing order
+                uint64_t& last = last_seen[c * producers + m.source];
+                assert(m.sequence + 1 > last);
+                last = m.sequence + 1;
+                total.fetch_add(m.sequence, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for(uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for(uint64_t i = 0; i < per_producer;) {
+                if(queue.push(message { i, p })) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(auto& t : threads) { t.join(); }
+
+    assert(consumed.load() == producers * per_producer);
+    assert(total.load() == producers * (per_producer * (per_producer - 1) / 2));
+    assert(queue.empty());
+    std::cout << "  ✓ " << consumed.load() << " messages delivered exactly once\n";
+}
+
+void test_batches() {
+    std::cout << "Testing batch push/take...\n";
+
+    mpmc_queue<message, 8> queue;
+    std::vector<message>   input;
+    for(uint32_t i = 0; i < 10; ++i) input.push_back(message { i, 0 });
+
+    assert(queue.push_batch(input) == 8);  // One claim, capped by capacity
+    assert(queue.full() && queue.push_batch(input) == 0);
+
+    std::vector<message> output(3);
+    assert(queue.take_batch(output) == 3);
+    assert(output[0].sequence == 0 && output[2].sequence == 2);
+
+    // work_batch: claims what fits, the rest report false
+    std::vector<expected<bool, bool>> results(5);
+    assert(work_batch(queue, default_push_command {}, std::span(input).subspan(5), results) == 5);
+    assert(results[2].has_value() && !results[3].has_value() && results[3].error() == false);
+
+    std::vector<message> drained(10);
+    results.resize(10);
+    assert(work_batch(queue, default_take_command {}, drained, results) == 10);
+    assert(results[7].has_value() && !results[8].has_value());
+    assert(drained[0].sequence == 3 && drained[7].sequence == 7);
+    assert(queue.empty());
+    std::cout << "  ✓ Runs claimed with one CAS, wrap-around and per-item results\n";
+
+    // Batches from several producers interleave without losing or splitting a run
+    constexpr uint32_t       producers = 3;
+    constexpr uint64_t       per_batch = 16;
+    constexpr uint64_t       batches   = 2000;
+    mpmc_queue<message, 64>  shared;
+    std::atomic<uint64_t>    consumed { 0 };
+    std::atomic<uint64_t>    total { 0 };
+    std::vector<std::thread> threads;
+    for(uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            std::vector<message> batch(per_batch);
+            for(uint64_t b = 0; b < batches; ++b) {
+                for(uint64_t i = 0; i < per_batch; ++i) batch[i] = message { b * per_batch + i, p };
+                for(size_t done = 0; done < per_batch;) {
+                    size_t pushed = shared.push_batch(std::span<const message>(batch).subspan(done));
+                    if(pushed == 0) std::this_thread::yield();
+                    done += pushed;
+                }
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        std::vector<message>  out(24);
+        std::vector<uint64_t> last(producers, 0);
+        while(consumed.load(std::memory_order_relaxed) < producers * per_batch * batches) {
+            size_t taken = shared.take_batch(out);
+            if(taken == 0) std::this_thread::yield();
+            for(size_t i = 0; i < taken; ++i) {
+                assert(out[i].sequence + 1 > last[out[i].source]);
+                last[out[i].source] = out[i].sequence + 1;
+                total.fetch_add(out[i].sequence, std::memory_order_relaxed);
+            }
+            consumed.fetch_add(taken, std::memory_order_relaxed);
+        }
+    });
+    for(auto& t : threads) { t.join(); }
+
+    constexpr uint64_t per_producer = per_batch * batches;
+    assert(consumed.load() == producers * per_producer);
+    assert(total.load() == producers * (per_producer * (per_producer - 1) / 2));
+    assert(shared.empty());
+    std::cout << "  ✓ " << consumed.load() << " messages batched across threads in producer order\n";
+}
+
+int main() {
+    std::cout << "=== MPMC Queue Tests ===\n\n";
+
+    test_basic_operations();
+    test_generic_queue_code();
+    test_element_lifetime();
+    test_fan_in_fan_out();
+    test_batches();
+
+    std::cout << "\nAll MPMC queue tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <asyncle/concepts/operation_concepts.hpp>
+#include <asyncle/concurrent/object_pool.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace asyncle::concurrent;
+
+// Aggregate payload, as makeable expects
+struct ticket {
+    uint64_t id;
+    uint32_t quantity;
+};
+
+// Counts live objects; check ties the fields together to catch overlapping blocks
+struct order {
+    static inline std::atomic<int64_t> live { 0 };
+
+    uint64_t id;
+    uint64_t check;
+    uint32_t quantity;
+
+    explicit order(uint64_t i, uint32_t q = 1): id(i), check(~i), quantity(q) {
+        if(q == 0) throw std::invalid_argument("empty order");
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    explicit order(const ticket& t): order(t.id, t.quantity) {}
+
+    ~order() { live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+struct alignas(64) wide {
+    char bytes[80];
+};
+
+void test_blocks() {
+    std::cout << "Testing block size, alignment and reuse...\n";
+
+    // Links need two pointers, and strides keep the requested alignment
+    assert(block_pool(1, 1).block_size() == 2 * sizeof(void*));
+    assert(block_pool(24, 8).block_size() == 24);
+    assert(object_pool<wide>().blocks().block_size() == 128);
+
+    object_pool_options options;
+    options.slab_size     = 4096;
+    options.magazine_size = 8;
+    block_pool pool(48, 16, options);
+    assert(pool.capacity() == 0 && pool.slab_count() == 0);  // Slabs are mapped on first use
+
+    std::vector<void*> blocks;
+    std::set<void*>    unique;
+    for(int i = 0; i < 200; ++i) {
+        void* b = pool.allocate();
+        assert(b && reinterpret_cast<uintptr_t>(b) % 16 == 0);
+        blocks.push_back(b);
+        unique.insert(b);
+    }
+    assert(unique.size() == 200);
+    assert(pool.slab_count() == (200 + 4096 / 48 - 1) / (4096 / 48));
+
+    // Freed blocks come back before any new slab is mapped
+    size_t slabs = pool.slab_count();
+    for(void* b : blocks) pool.deallocate(b);
+    for(int i = 0; i < 200; ++i) assert(unique.count(blocks[i] = pool.allocate()) == 1);
+    assert(pool.slab_count() == slabs);
+    for(void* b : blocks) pool.deallocate(b);
+    std::cout << "  ✓ 200 blocks over " << slabs << " slabs, all reused\n";
+}
+
+void test_limit() {
+    std::cout << "Testing max_slabs...\n";
+
+    object_pool_options options;
+    options.slab_size     = 4096;
+    options.max_slabs     = 1;
+    options.magazine_size = 4;
+    options.prefault      = true;
+    object_pool<order> pool(options);
+
+    std::vector<pooled<order>> held;
+    for(;;) {
+        auto made = pool.create(held.size());
+        if(!made) {
+            assert(made.error() == pool_error::no_memory);
+            break;
+        }
+        held.push_back(std::move(*made));
+    }
+    assert(held.size() == pool.blocks().capacity());
+    assert(asyncle::can_make(pool) == asyncle::check_status::FALSE);
+
+    held.pop_back();
+    assert(pool.create(1u).has_value());  // The freed block, released again at once
+    std::cout << "  ✓ " << pool.blocks().capacity() << " objects fit in one 4 KiB slab, then no_memory\n";
+}
+
+void test_objects() {
+    std::cout << "Testing pooled handles and the make CPO...\n";
+
+    static_assert(asyncle::makeable<object_pool<order>, ticket>);
+    object_pool<order> pool;
+    {
+        auto first = pool.create(7u, 3u);
+        assert(first && (*first)->id == 7 && (*first)->quantity == 3);
+        assert(order::live.load() == 1);
+
+        pooled<order> moved = std::move(*first);
+        assert(!*first && moved && moved->check == ~uint64_t(7));
+
+        auto made = asyncle::make(pool, ticket { 9, 2 });
+        assert(made && (*made)->id == 9 && (*made)->quantity == 2);
+        auto from_tuple = asyncle::make(pool, std::tuple { uint64_t { 10 }, uint32_t { 4 } });
+        assert(from_tuple && (*from_tuple)->quantity == 4);
+        assert(order::live.load() == 3);
+
+        // Raw pair, for callers that keep the pointer elsewhere
+        order* raw = pool.construct(11u);
+        assert(raw && order::live.load() == 4);
+        pool.destroy(raw);
+
+        // A throwing constructor hands the block back and rethrows
+        bool thrown = false;
+        try {
+            (void)pool.create(12u, 0u);
+        } catch(const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown && order::live.load() == 3);
+
+        moved.reset();
+        assert(order::live.load() == 2);
+    }
+    assert(order::live.load() == 0);
+    assert(asyncle::can_make(pool) == asyncle::check_status::TRUE);
+    std::cout << "  ✓ create/make/construct, moves and exceptions\n";
+}
+
+// Producers allocate, consumers on other threads free: blocks migrate
+// between caches through the depot without being lost or handed out twice
+void test_cross_thread() {
+    std::cout << "Testing blocks freed on other threads...\n";
+
+    constexpr int       producers  = 3;
+    constexpr int       per_thread = 50000;
+    object_pool_options options;
+    options.slab_size     = 64 << 10;
+    options.magazine_size = 16;
+    object_pool<order>               pool(options);
+    std::vector<std::vector<order*>> batches(producers);
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for(int i = 0; i < per_thread; ++i) {
+                order* o = pool.construct(uint64_t(p) * per_thread + i);
+                assert(o);
+                batches[p].push_back(o);
+            }
+        });
+    }
+    for(auto& t : threads) t.join();
+    assert(order::live.load() == producers * per_thread);
+
+    // Each batch is checked and freed by a thread other than its producer
+    threads.clear();
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for(order* o : batches[(p + 1) % producers]) {
+                assert(o->check == ~o->id);
+                pool.destroy(o);
+            }
+        });
+    }
+    for(auto& t : threads) t.join();
+    assert(order::live.load() == 0);
+
+    // Exited threads left their magazines in the depot, so this thread reuses them
+    size_t capacity = pool.blocks().capacity();
+    assert(pool.blocks().depot_blocks() >= producers * per_thread && pool.blocks().depot_blocks() <= capacity);
+    std::set<order*>    seen;
+    std::vector<order*> again;
+    for(size_t i = 0; i < capacity; ++i) {
+        order* o = pool.construct(i);
+        assert(o && seen.insert(o).second);
+        again.push_back(o);
+    }
+    assert(pool.blocks().capacity() == capacity);
+    for(order* o : again) pool.destroy(o);
+    std::cout << "  ✓ " << producers * per_thread << " objects freed across threads, " << capacity
+              << " blocks reused\n";
+}
+
+// Every thread allocates and frees a working set repeatedly
+void test_stress() {
+    std::cout << "Testing concurrent churn...\n";
+
+    object_pool<order>       pool;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<pooled<order>> live;
+            for(int round = 0; round < 200; ++round) {
+                for(int i = 0; i < 100; ++i) live.push_back(std::move(*pool.create(uint64_t(t) << 32 | i)));
+                for(auto& o : live) assert(o->check == ~o->id);
+                live.resize(round % 3 == 0 ? 0 : 50);
+            }
+        });
+    }
+    for(auto& t : threads) t.join();
+    assert(order::live.load() == 0);
+    std::cout << "  ✓ 4 threads, " << pool.blocks().capacity() << " blocks carved\n";
+}
+
+int main() {
+    std::cout << "Running concurrent::object_pool tests...\n\n";
+
+    test_blocks();
+    test_limit();
+    test_objects();
+    test_cross_thread();
+    test_stress();
+
+    std::cout << "\nAll object_pool tests passed!\n";
+    return 0;
+}
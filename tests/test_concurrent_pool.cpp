@@ -0,0 +1,191 @@
+#include <asyncle/concepts/operation_concepts.hpp>
+#include <asyncle/concurrent/chase_lev_deque.hpp>
+#include <asyncle/concurrent/thread_pool.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace asyncle;
+using namespace asyncle::concurrent;
+
+// Aggregate task so the payload satisfies the workable concept
+struct count_task {
+    std::atomic<int>* counter;
+
+    void operator()() const noexcept { counter->fetch_add(1, std::memory_order_relaxed); }
+};
+
+static_assert(submit_command::accepts<count_task>);
+static_assert(!submit_command::accepts<int>);
+static_assert(workable<work_stealing_pool, submit_command, count_task>);
+
+void test_deque_owner_operations() {
+    std::cout << "Testing Chase-Lev deque owner operations...\n";
+
+    chase_lev_deque<int*> deque(2);
+    int                   values[10];
+    assert(deque.is_valid());
+    assert(deque.capacity() == 2);
+
+    for(auto& v : values) { assert(deque.push(&v)); }
+    assert(deque.size() == 10);
+    assert(deque.capacity() >= 10);  // Grew on demand
+
+    int* out = nullptr;
+    assert(deque.steal(out) && out == &values[0]);  // Thieves take the oldest
+    assert(deque.take(out) && out == &values[9]);   // The owner takes the newest
+    while(deque.take(out)) {}
+    assert(deque.empty());
+    assert(!deque.steal(out));
+    std::cout << "  ✓ LIFO take, FIFO steal, growth\n";
+}
+
+void test_deque_concurrent_steal() {
+    std::cout << "Testing Chase-Lev deque under concurrent stealing...\n";
+
+    constexpr int         count = 100000;
+    chase_lev_deque<int*> deque(64);
+    std::vector<int>      items(count, 0);
+    std::atomic<int>      claimed { 0 };
+    std::atomic<bool>     done { false };
+
+    std::vector<std::thread> thieves;
+    for(int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            int* item = nullptr;
+            while(!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if(deque.steal(item)) {
+                    ++*item;
+                    claimed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int* item = nullptr;
+    for(int i = 0; i < count; ++i) {
+        assert(deque.push(&items[i]));
+        if(i % 3 == 0 && deque.take(item)) {
+            ++*item;
+            claimed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    while(deque.take(item)) {
+        ++*item;
+        claimed.fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    for(auto& t : thieves) { t.join(); }
+
+    // Every element claimed exactly once
+    assert(claimed.load() == count);
+    for(int v : items) { assert(v == 1); }
+    std::cout << "  ✓ " << count << " elements claimed exactly once\n";
+}
+
+void test_pool_submit() {
+    std::cout << "Testing pool submission via CPOs...\n";
+
+    work_stealing_pool pool(pool_options { .workers = 4 });
+    assert(pool.is_running());
+    assert(pool.worker_count() == 4);
+    assert(can_work(pool, submit_command {}) == check_status::TRUE);
+
+    std::atomic<int> counter { 0 };
+    for(int i = 0; i < 1000; ++i) {
+        auto queued = work(pool, submit_command {}, count_task { &counter });
+        assert(queued && *queued);
+    }
+    for(int i = 0; i < 1000; ++i) {
+        auto queued = pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        assert(queued);
+    }
+    pool.wait_idle();
+    assert(counter.load() == 2000);
+    assert(pool.pending() == 0);
+    assert(pool.current_worker() == -1);
+    std::cout << "  ✓ 2000 tasks ran through work() and submit()\n";
+}
+
+// Recursive fan-out: every task submitted from a worker lands on its own deque
+void spawn_tree(work_stealing_pool& pool, std::atomic<int>& leaves, int depth) {
+    if(depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    assert(pool.current_worker() >= 0);
+    for(int i = 0; i < 2; ++i) {
+        auto queued = pool.submit([&pool, &leaves, depth] { spawn_tree(pool, leaves, depth - 1); });
+        assert(queued);
+    }
+}
+
+void test_nested_submission() {
+    std::cout << "Testing nested submission and stealing...\n";
+
+    work_stealing_pool pool(pool_options { .workers = 4, .deque_capacity = 8 });
+    std::atomic<int>   leaves { 0 };
+
+    assert(pool.submit([&] { spawn_tree(pool, leaves, 12); }));
+    pool.wait_idle();
+    assert(leaves.load() == (1 << 12));
+    std::cout << "  ✓ " << leaves.load() << " leaf tasks completed\n";
+}
+
+void test_pinning_and_shutdown() {
+    std::cout << "Testing pinned workers and shutdown...\n";
+
+    std::atomic<int> counter { 0 };
+    {
+        work_stealing_pool pool(pool_options { .workers = 2, .pin_workers = true });
+        assert(pool.is_running());
+        for(int i = 0; i < 100; ++i) { assert(pool.submit(count_task { &counter })); }
+        // Destructor drains queued tasks before joining
+    }
+    assert(counter.load() == 100);
+
+    work_stealing_pool pool(pool_options { .workers = 1 });
+    pool.stop();
+    assert(!pool.is_running());
+    auto rejected = work(pool, submit_command {}, count_task { &counter });
+    assert(!rejected && rejected.error() == executor_error::stopped);
+    assert(can_work(pool, submit_command {}) == check_status::FALSE);
+    std::cout << "  ✓ Queued work finishes on shutdown; stopped pools reject work\n";
+}
+
+void test_numa_node_pool() {
+    std::cout << "Testing NUMA node restricted pool...\n";
+
+    // Node 0 always exists (a single node on non-NUMA machines)
+    std::atomic<int> counter { 0 };
+    {
+        work_stealing_pool pool(pool_options { .workers = 2, .numa_node = 0 });
+        assert(pool.is_running());
+        for(int i = 0; i < 100; ++i) { assert(pool.submit(count_task { &counter })); }
+    }
+    assert(counter.load() == 100);
+
+    // A node that does not exist has no CPUs to run on
+    work_stealing_pool missing(pool_options { .numa_node = 4095 });
+    assert(!missing.is_running());
+    std::cout << "  ✓ Workers run on node 0; unknown nodes fail to start\n";
+}
+
+int main() {
+    std::cout << "=== Work-Stealing Pool Tests ===\n\n";
+
+    test_deque_owner_operations();
+    test_deque_concurrent_steal();
+    test_pool_submit();
+    test_nested_submission();
+    test_pinning_and_shutdown();
+    test_numa_node_pool();
+
+    std::cout << "\nAll work-stealing pool tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <asyncle/concurrent/sharded.hpp>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace asyncle::concurrent;
+
+// Slots sit on distinct cache lines
+void test_layout() {
+    std::cout << "Testing per_cpu layout...\n";
+
+    per_cpu<std::atomic<uint64_t>> slots(shard_by::thread, 8);
+    assert(slots.size() == 8);
+    for(size_t i = 1; i < slots.size(); ++i) {
+        auto gap = reinterpret_cast<uintptr_t>(&slots[i]) - reinterpret_cast<uintptr_t>(&slots[i - 1]);
+        assert(gap >= asyncle::hardware::cache_line_size);
+        assert(reinterpret_cast<uintptr_t>(&slots[i]) % asyncle::hardware::cache_line_size == 0);
+    }
+
+    // A thread keeps its slot; a zero shard count still yields one valid slot
+    assert(slots.index() == slots.index());
+    assert(&slots.local() == &slots[slots.index()]);
+    per_cpu<int> single(shard_by::cpu, 0);
+    assert(single.size() == 1 && single.index() == 0);
+
+    // Default: one slot per CPU number
+    per_cpu<int> by_cpu(shard_by::cpu);
+    assert(by_cpu.size() >= asyncle::hardware::cpu_topology::current().cpu_count());
+    assert(by_cpu.index() < by_cpu.size());
+    std::cout << "  ✓ " << by_cpu.size() << " shard(s) by default\n";
+}
+
+// Distinct threads take distinct slots until the shards run out
+void test_thread_assignment() {
+    std::cout << "Testing per-thread slot assignment...\n";
+
+    per_cpu<int>             slots(shard_by::thread, 64);
+    std::vector<size_t>      seen(4);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < seen.size(); ++t) threads.emplace_back([&, t] { seen[t] = slots.index(); });
+    for(auto& th : threads) th.join();
+    for(size_t a = 0; a < seen.size(); ++a) {
+        for(size_t b = a + 1; b < seen.size(); ++b) assert(seen[a] != seen[b]);
+    }
+    std::cout << "  ✓ Fresh threads got distinct slots\n";
+}
+
+void test_counter(shard_by mode, const char* label) {
+    std::cout << "Testing sharded_counter (" << label << ")...\n";
+
+    sharded_counter counter(mode);
+    assert(counter.value() == 0);
+
+    constexpr int            threads = 8;
+    constexpr int            per     = 100000;
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for(int i = 0; i < per; ++i) counter.add();
+            counter.sub(10);
+        });
+    }
+    for(auto& w : workers) w.join();
+    assert(counter.value() == int64_t(threads) * per - threads * 10);
+
+    // Reset hands back the period's total
+    assert(counter.exchange_reset() == int64_t(threads) * per - threads * 10);
+    assert(counter.value() == 0);
+    counter.add(5);
+    counter.reset();
+    assert(counter.value() == 0);
+    std::cout << "  ✓ " << threads * per << " increments over " << counter.shards() << " shard(s)\n";
+}
+
+void test_stat() {
+    std::cout << "Testing sharded_stat...\n";
+
+    sharded_stat latency(shard_by::thread, 4);
+    stat_summary empty = latency.snapshot();
+    assert(empty.count == 0 && empty.mean() == 0.0);
+
+    std::vector<std::thread> workers;
+    for(int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for(int64_t v = 1; v <= 1000; ++v) latency.record(v + t * 1000);
+        });
+    }
+    for(auto& w : workers) w.join();
+
+    stat_summary s = latency.snapshot();
+    assert(s.count == 4000);
+    assert(s.min == 1);
+    assert(s.max == 4000);
+    assert(s.sum == 4000 * 4001 / 2);
+    assert(s.mean() == 2000.5);
+
+    latency.reset();
+    assert(latency.snapshot().count == 0);
+    latency.record(-7);
+    assert(latency.snapshot().min == -7 && latency.snapshot().max == -7);
+    std::cout << "  ✓ count/sum/min/max aggregated\n";
+}
+
+void test_histogram_layout() {
+    std::cout << "Testing HDR bucket layout...\n";
+
+    using namespace histogram_layout;
+    static_assert(bucket_of(0) == 0 && bucket_of(15) == 15 && bucket_of(31) == 31);
+    static_assert(bucket_of(UINT64_MAX) == bucket_count - 1);
+    static_assert(highest_in(bucket_count - 1) == UINT64_MAX);
+
+    // Buckets tile the range with no gaps and are at most 1/16 of their lower bound wide
+    for(size_t b = 1; b < bucket_count; ++b) {
+        assert(lowest_in(b) == highest_in(b - 1) + 1);
+        assert(bucket_of(lowest_in(b)) == b && bucket_of(highest_in(b)) == b);
+        if(b >= sub_buckets) assert(highest_in(b) - lowest_in(b) <= lowest_in(b) / sub_buckets);
+    }
+    std::cout << "  ✓ " << bucket_count << " contiguous buckets\n";
+}
+
+void test_histogram() {
+    std::cout << "Testing sharded_histogram...\n";
+
+    sharded_histogram latency(shard_by::thread, 4);
+    histogram_snapshot empty = latency.snapshot();
+    assert(empty.count == 0 && empty.counts.empty());
+    assert(empty.percentile(0.99) == 0 && empty.max() == 0);
+
+    // 1..10000 from four threads
+    std::vector<std::thread> workers;
+    for(int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for(uint64_t v = 1; v <= 2500; ++v) latency.record(v + t * 2500);
+        });
+    }
+    for(auto& w : workers) w.join();
+
+    histogram_snapshot s = latency.snapshot();
+    assert(s.count == 10000);
+    assert(s.sum == 10000ull * 10001 / 2);
+    assert(s.mean() == 5000.5);
+    assert(s.min() == 1);
+
+    // Reported values never understate and stay within one bucket width
+    auto near = [](uint64_t reported, uint64_t exact) { return reported >= exact && reported <= exact + exact / 16; };
+    assert(near(s.percentile(0.5), 5000));
+    assert(near(s.percentile(0.99), 9900));
+    assert(near(s.percentile(1.0), 10000));
+    assert(near(s.max(), 10000));
+
+    latency.record(1ull << 40, 3);
+    s = latency.snapshot();
+    assert(s.count == 10003 && s.max() >= (1ull << 40));
+
+    latency.reset();
+    assert(latency.snapshot().count == 0);
+    std::cout << "  ✓ p50=" << s.percentile(0.5) << " p99=" << s.percentile(0.99) << "\n";
+}
+
+int main() {
+    std::cout << "Running concurrent::sharded tests...\n\n";
+
+    test_layout();
+    test_thread_assignment();
+    test_counter(shard_by::thread, "per thread");
+    test_counter(shard_by::cpu, "per cpu");
+    test_stat();
+    test_histogram_layout();
+    test_histogram();
+
+    std::cout << "\nAll sharded tests passed!\n";
+    return 0;
+}
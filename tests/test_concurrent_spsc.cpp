@@ -0,0 +1,234 @@
+#include <asyncle/concepts/operation_concepts.hpp>
+#include <asyncle/concurrent/spsc_ring.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace asyncle;
+using asyncle::concurrent::spsc_ring;
+
+// Payload concepts require aggregate objects
+struct message {
+    uint64_t sequence;
+    uint32_t size;
+};
+
+static_assert(pushable<spsc_ring<message, 8>, message>);
+static_assert(takeable<spsc_ring<message, 8>, message>);
+
+template <typename Ring, typename R>
+constexpr bool accepts_range = requires(Ring& ring, R&& values) { ring.push_range(std::forward<R>(values)); };
+
+void test_basic_operations() {
+    std::cout << "Testing basic push/take...\n";
+
+    spsc_ring<int, 4> ring;
+    assert(ring.empty());
+    assert(ring.capacity() == 4);
+
+    for(int i = 0; i < 4; ++i) { assert(ring.push(i)); }
+    assert(ring.full());
+    assert(!ring.push(99));
+
+    int value = -1;
+    for(int i = 0; i < 4; ++i) {
+        assert(ring.take(value));
+        assert(value == i);
+    }
+    assert(!ring.take(value));
+    assert(ring.empty());
+
+    // Indices keep growing past the capacity; masking must keep FIFO order
+    for(int round = 0; round < 10; ++round) {
+        assert(ring.push(round));
+        assert(ring.front() && *ring.front() == round);
+        assert(ring.take(value) && value == round);
+    }
+    std::cout << "  ✓ FIFO order, full and empty detection\n";
+}
+
+void test_batch_operations() {
+    std::cout << "Testing batch push/take...\n";
+
+    spsc_ring<int, 8> ring;
+    std::vector<int>  input { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    assert(ring.push_batch(input) == 8);  // Only capacity fits
+    assert(ring.full());
+
+    std::vector<int> output(5);
+    assert(ring.take_batch(output) == 5);
+    for(int i = 0; i < 5; ++i) { assert(output[i] == i + 1); }
+
+    assert(ring.push_batch(std::span<const int>(input).subspan(8)) == 2);
+    std::vector<int> rest(16);
+    assert(ring.take_batch(rest) == 5);
+    assert(rest[0] == 6 && rest[2] == 8 && rest[3] == 9 && rest[4] == 10);
+    assert(ring.empty());
+
+    // work_batch routes to the same batch calls; items that did not fit report false
+    std::vector<expected<bool, bool>> results(10);
+    assert(work_batch(ring, default_push_command {}, input, results) == 10);
+    assert(results[7].has_value() && !results[8].has_value() && results[8].error() == false);
+    std::vector<int> drained(10);
+    assert(work_batch(ring, default_take_command {}, drained, results) == 10);
+    assert(results[7].has_value() && !results[8].has_value() && drained[7] == 8);
+    std::cout << "  ✓ Partial batches wrap around the slot array, work_batch reports per item\n";
+}
+
+void test_range_push() {
+    std::cout << "Testing range try_push...\n";
+
+    // Contiguous spans of a trivially copyable type are memcpy'd, across the wrap
+    spsc_ring<message, 8> ring;
+    std::vector<message>  input;
+    for(uint32_t i = 0; i < 12; ++i) input.push_back(message { i, i * 2 });
+    assert(ring.push_batch(std::span<const message>(input).first(5)) == 5);
+    message skipped[5];
+    assert(ring.take_batch(skipped) == 5 && skipped[4].sequence == 4);
+
+    assert(ring.push_range(std::span<const message>(input).subspan(5)) == 7);
+    message out[8];
+    assert(ring.take_batch(out) == 7);
+    for(uint32_t i = 0; i < 7; ++i) { assert(out[i].sequence == 5 + i && out[i].size == (5 + i) * 2); }
+
+    // try_push takes a whole range or nothing
+    auto pushed = try_push(ring, std::span<const message>(input).first(8));
+    assert(pushed.has_value() && *pushed && ring.full());
+    assert(ring.take_batch(std::span<message>(out).first(3)) == 3);
+    auto rejected = try_push(ring, std::span<const message>(input).first(4));
+    assert(!rejected.has_value() && rejected.error() == false && ring.size() == 5);
+    assert(try_push(ring, std::span<const message> {}).has_value());
+
+    // Generic ranges are walked element by element, up to the free space
+    spsc_ring<int, 4> ints;
+    std::list<int>    values { 1, 2, 3, 4, 5, 6 };
+    assert(ints.push_range(values) == 4);
+    int first[4];
+    assert(ints.take_batch(first) == 4 && first[0] == 1 && first[3] == 4);
+    assert(!try_push(ints, values).has_value() && ints.empty());
+    assert(try_push(ints, std::list<int> { 7, 8 }).has_value() && ints.size() == 2);
+
+    // Owning rvalue ranges of non-trivial elements are moved from
+    spsc_ring<std::string, 4> strings;
+    std::vector<std::string>  words { std::string(40, 'a'), std::string(40, 'b') };
+    assert(try_push(strings, std::move(words)).has_value());
+    assert(words[0].empty() && words[1].empty());
+    std::string word;
+    assert(strings.take(word) && word == std::string(40, 'a'));
+    static_assert(!accepts_range<spsc_ring<std::string, 4>, std::vector<std::string>&>);  // Copies may throw
+    static_assert(accepts_range<spsc_ring<std::string, 4>, std::vector<std::string>>);
+    std::cout << "  ✓ Spans bulk-copy across the wrap, lists walk, rvalue containers move\n";
+}
+
+void test_cpo_integration() {
+    std::cout << "Testing CPO integration...\n";
+
+    spsc_ring<int, 2> ring;
+    assert(can_push(ring) == check_status::TRUE);
+    assert(can_take(ring) == check_status::FALSE);
+
+    auto pushed = try_push(ring, 7);
+    assert(pushed.has_value() && *pushed);
+    assert(try_push(ring, 8).has_value());
+
+    auto rejected = try_push(ring, 9);
+    assert(!rejected.has_value() && rejected.error() == false);
+    assert(can_push(ring) == check_status::FALSE);
+
+    int  out   = 0;
+    auto taken = try_take(ring, out);
+    assert(taken.has_value() && out == 7);
+    assert(try_take(ring, out).has_value() && out == 8);
+    assert(!try_take(ring, out).has_value());
+
+    spsc_ring<message, 4> messages;
+    assert(try_push(messages, message { 1, 64 }).has_value());
+    message received {};
+    assert(try_take(messages, received).has_value());
+    assert(received.sequence == 1 && received.size == 64);
+    std::cout << "  ✓ try_push/try_take/can_push/can_take dispatch through tag_invoke\n";
+}
+
+void test_non_trivial_elements() {
+    std::cout << "Testing non-trivial element lifetime...\n";
+
+    auto tracker = std::make_shared<int>(0);
+    {
+        spsc_ring<std::shared_ptr<int>, 4> ring;
+        assert(ring.push(tracker));
+        assert(ring.push(tracker));
+        assert(tracker.use_count() == 3);
+
+        std::shared_ptr<int> out;
+        assert(ring.take(out));
+        out.reset();
+        assert(tracker.use_count() == 2);
+    }
+    // Remaining element destroyed with the ring
+    assert(tracker.use_count() == 1);
+    std::cout << "  ✓ Elements are destroyed on take and on ring destruction\n";
+}
+
+void test_concurrent_transfer() {
+    std::cout << "Testing producer/consumer threads...\n";
+
+    constexpr uint64_t        count = 200000;
+    spsc_ring<uint64_t, 1024> ring;
+    uint64_t                  sum = 0;
+
+    std::thread consumer([&] {
+        uint64_t expected_next = 0;
+        uint64_t batch[64];
+        while(expected_next < count) {
+            size_t got = ring.take_batch(batch);
+            if(got == 0) std::this_thread::yield();
+            for(size_t i = 0; i < got; ++i) {
+                assert(batch[i] == expected_next);
+                sum += batch[i];
+                ++expected_next;
+            }
+        }
+    });
+
+    // A third thread only observes; size() must stay within the capacity
+    std::atomic<bool> done { false };
+    std::thread       observer([&] {
+        while(!done.load(std::memory_order_relaxed)) { assert(ring.size() <= ring.capacity()); }
+    });
+
+    for(uint64_t i = 0; i < count;) {
+        if(ring.push(i)) {
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    done.store(true, std::memory_order_relaxed);
+    observer.join();
+
+    assert(sum == count * (count - 1) / 2);
+    assert(ring.empty());
+    std::cout << "  ✓ " << count << " items transferred in order, observed size in bounds\n";
+}
+
+int main() {
+    std::cout << "=== SPSC Ring Tests ===\n\n";
+
+    test_basic_operations();
+    test_batch_operations();
+    test_range_push();
+    test_cpo_integration();
+    test_non_trivial_elements();
+    test_concurrent_transfer();
+
+    std::cout << "\nAll SPSC ring tests passed!\n";
+    return 0;
+}
@@ -1,8 +1,11 @@
 #include <asyncle/base/cpo.hpp>
 #include <asyncle/compat.hpp>
 #include <asyncle/concepts/operation_concepts.hpp>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <span>
 
 namespace test_types {
 struct TestPayload {
@@ -76,6 +79,23 @@ asyncle::expected<TestPayload, TestError> tag_invoke(asyncle::work_t, BothObject
     ++obj.tag_calls;
     return TestPayload { p.value + 200 };  // Different result
 }
+
+// Object with a batch member: one call for the whole span
+struct BatchObject {
+    int batch_calls = 0;
+
+    asyncle::expected<TestPayload, TestError> work(test_command, TestPayload p) const {
+        return TestPayload { p.value };
+    }
+
+    size_t work_batch(test_command, std::span<TestPayload> items,
+                      std::span<asyncle::expected<TestPayload, TestError>> results) {
+        ++batch_calls;
+        size_t count = std::min(items.size(), results.size()) / 2;  // Stops early to show the count is honoured
+        for(size_t i = 0; i < count; ++i) results[i] = TestPayload { -items[i].value };
+        return count;
+    }
+};
 }  // namespace test_types
 
 int main() {
@@ -93,6 +113,24 @@ int main() {
     // static_assert(workable<TagInvokeObject, test_command, TestPayload>);
     // static_assert(workable<BothObject, test_command, TestPayload>);
 
+    // ========== Test work_batch ==========
+    {
+        using result = expected<TestPayload, TestError>;
+        std::array<TestPayload, 4> items { { { 1 }, { 2 }, { 3 }, { 4 } } };
+        std::array<result, 3>      results {};
+
+        // Falls back to one work() per item, bounded by the shorter range
+        MemberFunctionObject member;
+        assert(work_batch(member, test_command {}, items, results) == 3);
+        assert(member.call_count == 3 && results[2]->value == 6);
+
+        // A work_batch member takes the whole batch
+        BatchObject batched;
+        std::array<result, 4> all {};
+        assert(work_batch(batched, test_command {}, items, all) == 2);
+        assert(batched.batch_calls == 1 && all[0]->value == -1 && all[1]->value == -2);
+    }
+
     std::cout << "CPO concept tests passed!" << std::endl;
     return 0;
 }
@@ -0,0 +1,164 @@
+#include <asyncle/base/dynamic_worker.hpp>
+#include <asyncle/io/commands.hpp>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace asyncle;
+
+struct message {
+    int value;
+};
+
+struct handle_error {
+    int code;
+};
+
+using handle_command = command<handle_error, type_map<message, int>>;
+using worker         = dynamic_worker<handle_command, const message&>;
+
+// Small handler through a work member
+struct scale {
+    int factor;
+
+    expected<int, handle_error> work(handle_command, const message& m) const { return m.value * factor; }
+};
+
+// Handler through tag_invoke, with can_work and a live-object count
+struct counted {
+    static inline int alive = 0;
+    int               calls = 0;
+
+    counted() noexcept { ++alive; }
+    counted(counted&& other) noexcept: calls(other.calls) { ++alive; }
+    ~counted() { --alive; }
+
+    friend expected<int, handle_error> tag_invoke(handle_command, counted& self, const message& m) {
+        ++self.calls;
+        if(m.value < 0) return expected<int, handle_error>(unexpect, handle_error { m.value });
+        return m.value + self.calls;
+    }
+
+    friend check_status tag_invoke(can_work_t, counted& self, handle_command) {
+        return self.calls < 3 ? check_status::TRUE : check_status::FALSE;
+    }
+};
+
+// Too large for the inline buffer
+struct bulky {
+    char padding[256] = {};
+    int  offset       = 0;
+
+    expected<int, handle_error> work(handle_command, const message& m) const { return m.value + offset; }
+};
+
+// Inline-sized but throwing moves go to the heap too
+struct throwing_move {
+    int base = 0;
+
+    throwing_move() = default;
+    throwing_move(throwing_move&& other): base(other.base) {}
+
+    expected<int, handle_error> work(handle_command, const message& m) const { return base - m.value; }
+};
+
+void test_storage() {
+    std::cout << "Testing storage...\n";
+
+    static_assert(sizeof(worker) == hardware::cache_line_size);
+    static_assert(worker::stores_inline<scale> && worker::stores_inline<counted>);
+    static_assert(!worker::stores_inline<bulky> && !worker::stores_inline<throwing_move>);
+
+    worker empty;
+    assert(!empty);
+
+    worker small(scale { 3 });
+    assert(small && small.holds<scale>() && !small.holds<counted>());
+    assert(*work(small, handle_command {}, message { 7 }) == 21);
+    assert(small.can_work(handle_command {}) == check_status::TRUE);  // No can_work of its own
+
+    worker large(bulky { .offset = 5 });
+    assert(large.target<bulky>() && large.target<bulky>()->offset == 5);
+    assert(*work(large, handle_command {}, message { 1 }) == 6);
+
+    worker moved_from_heap(std::in_place_type<throwing_move>);
+    moved_from_heap.target<throwing_move>()->base = 10;
+    worker heap_moved(std::move(moved_from_heap));
+    assert(!moved_from_heap && *work(heap_moved, handle_command {}, message { 4 }) == 6);
+    std::cout << "  ✓ Inline for small nothrow-movable handlers, heap otherwise\n";
+}
+
+void test_lifetime() {
+    std::cout << "Testing lifetime and dispatch...\n";
+    {
+        worker w(std::in_place_type<counted>);
+        assert(counted::alive == 1);
+        assert(*w.work(handle_command {}, message { 10 }) == 11);
+        assert(!w.work(handle_command {}, message { -2 }));
+        assert(can_work(w, handle_command {}) == check_status::TRUE);
+
+        // Relocation carries the state across moves
+        worker other(std::move(w));
+        assert(counted::alive == 1 && other.target<counted>()->calls == 2);
+        assert(*work(other, handle_command {}, message { 0 }) == 3);
+        assert(can_work(other, handle_command {}) == check_status::FALSE);
+
+        other.emplace<scale>(2);
+        assert(counted::alive == 0 && other.holds<scale>());
+
+        w = worker(counted {});
+        assert(counted::alive == 1);
+    }
+    assert(counted::alive == 0);
+
+    // Handlers chosen at runtime behind one type
+    std::vector<worker> plugins;
+    plugins.emplace_back(scale { 2 });
+    plugins.emplace_back(bulky { .offset = 100 });
+    plugins.emplace_back(std::in_place_type<counted>);
+    int sum = 0;
+    for(auto& p : plugins) sum += *work(p, handle_command {}, message { 1 });
+    assert(sum == 2 + 101 + 2);
+
+    // work_as calls the listed types directly and falls back to the table
+    assert(*plugins[0].work_as<scale>(handle_command {}, message { 5 }) == 10);
+    assert((*plugins[1].work_as<scale, counted>(handle_command {}, message { 5 }) == 105));
+    assert((*plugins[2].work_as<scale, counted>(handle_command {}, message { 5 }) == 7));
+    std::cout << "  ✓ Moves relocate, resets destroy, work_as devirtualizes known types\n";
+}
+
+void test_library_objects() {
+    std::cout << "Testing library objects behind a worker...\n";
+
+    io::file f;
+    assert(f.create_temp().has_value());
+    dynamic_worker<io::write_command, const io::io_request&> sink(std::move(f));
+
+    char           text[] = "erased";
+    io::io_request req {};
+    req.buffer = text;
+    req.length = 6;
+    req.offset = 0;
+    auto wrote = work(sink, io::write_command {}, req);
+    assert(wrote && wrote->bytes_transferred == 6);
+
+    char back[8] = {};
+    req.buffer   = back;
+    assert(sink.target<io::file>()->read(req) && std::memcmp(back, text, 6) == 0);
+    std::cout << "  ✓ io::file writes through dynamic_worker\n";
+}
+
+int main() {
+    std::cout << "=== Dynamic Worker Tests ===\n\n";
+
+    test_storage();
+    test_lifetime();
+    test_library_objects();
+
+    std::cout << "\nAll dynamic worker tests passed!\n";
+    return 0;
+}
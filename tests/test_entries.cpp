@@ -1,5 +1,7 @@
 #include <asyncle/meta/entries.hpp>
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace test_types {
@@ -33,6 +35,24 @@ struct is_arithmetic {
     template <class T>
     struct apply: std::bool_constant<std::is_arithmetic_v<T>> {};
 };
+
+// Wide entry lists, as in commands with ~100 type_map entries
+template <std::size_t N>
+struct key {};
+
+template <std::size_t N>
+struct value {};
+
+template <class Seq>
+struct wide_lookup;
+
+template <std::size_t... I>
+struct wide_lookup<std::index_sequence<I...>> {
+    template <class P>
+    using type = asyncle::first_match<P, asyncle::type_map<key<I>, value<I>>...>;
+};
+
+using wide = wide_lookup<std::make_index_sequence<128>>;
 }  // namespace test_types
 
 int main() {
@@ -93,6 +113,22 @@ int main() {
     static_assert(first_match<std::string, map2, pred1, rule1>::found);
     static_assert(std::same_as<first_match<std::string, map2, pred1, rule1>::type, B>);  // matches map2 first
 
+    // ========== Test indexed lookup ==========
+    static_assert(first_match<int, map1, map2, map3>::index == 0);
+    static_assert(first_match<double, map1, map2, map3>::index == 2);
+    static_assert(first_match<char, map1, map2, map3>::index == 3);
+    static_assert(first_match<const int&, map1, map2, map3>::index == 0);  // Payloads decay
+    static_assert(!first_match<int>::found && first_match<int>::index == 0);
+
+    static_assert(std::same_as<pack_element_t<0, int, void, A>, int>);
+    static_assert(std::same_as<pack_element_t<1, int, void, A>, void>);
+    static_assert(std::same_as<pack_element_t<2, int, void, A>, A>);
+
+    static_assert(wide::type<key<0>>::index == 0);
+    static_assert(std::same_as<wide::type<key<127>>::type, value<127>>);
+    static_assert(std::same_as<wide::type<key<64>&>::type, value<64>>);
+    static_assert(!wide::type<key<128>>::found);
+
     // ========== Test legacy aliases ==========
     static_assert(std::same_as<first_match<int, map1, map2>::type, A>);
     static_assert(std::same_as<map_lookup_t<int, map1, map2>, A>);
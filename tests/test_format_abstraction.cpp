@@ -5,11 +5,23 @@
 // 2. Default implementations (simdjson, Glaze) work
 // 3. Custom implementations can be plugged in
 // 4. CPOs dispatch correctly based on tags
+// 5. The schema JSON serializer writes declared structs
+// 6. Parser backends are selected from requirements
 
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <format/json.hpp>
 #include <format/serialize.hpp>
 #include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 // Test structure
 struct TestData {
@@ -18,6 +30,51 @@ struct TestData {
     double      value;
 };
 
+// Structs written by the schema JSON serializer
+struct SchemaRoute {
+    std::string tenant;
+    int32_t     shard;
+
+    using json_schema = format::serialize::json_fields<format::serialize::json_field<"tenant", &SchemaRoute::tenant>,
+                                                       format::serialize::json_field<"shard", &SchemaRoute::shard>>;
+};
+
+struct SchemaMessage {
+    int64_t                  id;
+    std::string              user;
+    std::vector<std::string> roles;
+    SchemaRoute              target;
+    std::vector<double>      samples;
+    std::optional<bool>      trace;
+    std::array<uint8_t, 2>   flags;
+    const char*              note;
+
+    using json_schema = format::serialize::json_fields<
+      format::serialize::json_field<"id", &SchemaMessage::id>,
+      format::serialize::json_field<"us\"er", &SchemaMessage::user>,
+      format::serialize::json_field<"roles", &SchemaMessage::roles>,
+      format::serialize::json_field<"target", &SchemaMessage::target>,
+      format::serialize::json_field<"samples", &SchemaMessage::samples>,
+      format::serialize::json_field<"trace", &SchemaMessage::trace>,
+      format::serialize::json_field<"flags", &SchemaMessage::flags>,
+      format::serialize::json_field<"note", &SchemaMessage::note>>;
+};
+
+// A type that cannot be changed gets its schema from outside
+struct ExternalPoint {
+    float x;
+    float y;
+};
+
+template <>
+struct format::serialize::json_schema_for<ExternalPoint> {
+    using type = json_fields<json_field<"x", &ExternalPoint::x>, json_field<"y", &ExternalPoint::y>>;
+};
+
+struct EmptySchema {
+    using json_schema = format::serialize::json_fields<>;
+};
+
 // Custom minimal parser for testing concept satisfaction
 namespace custom {
 
@@ -59,6 +116,39 @@ struct minimal_parser {
     std::string_view json_;
 };
 
+// Forward-only, in place: the on-demand shape
+struct cursor_parser {
+    using document_type = std::string_view;
+
+    static constexpr format::json::parser_caps caps() noexcept {
+        return {
+            .zero_copy               = true,
+            .lazy_parsing            = true,
+            .lightweight_index       = true,
+            .full_dom                = false,
+            .streaming               = true,
+            .random_access           = false,
+            .multiple_cursors        = false,
+            .simd_optimized          = true,
+            .swar_optimized          = false,
+            .compile_time_reflection = false,
+            .typical_overhead_pct    = 0,
+            .can_use_stack           = true,
+            .requires_mutable        = false,
+            .structured_binding      = false,
+            .validates_utf8          = false,
+            .validates_json          = false
+        };
+    }
+
+    explicit cursor_parser(std::string_view json): json_(json) {}
+
+    format::json::result<document_type> iterate() { return format::json::result<document_type>(json_); }
+
+    private:
+    std::string_view json_;
+};
+
 }  // namespace custom
 
 // Test: Custom parser satisfies concept
@@ -102,6 +192,25 @@ auto load_impl(std::string_view data [[maybe_unused]], custom_format_tag) -> for
     return format::serialize::result<T>(T {});
 }
 
+// Format with a native save_into: writes straight into the caller's buffer
+struct direct_format_tag {};
+
+template <typename T>
+auto save_impl(T const& obj [[maybe_unused]], direct_format_tag) -> format::serialize::result<std::string> {
+    return format::serialize::result<std::string>(std::string("direct"));
+}
+
+template <typename T>
+auto save_into_impl(
+  T const& obj [[maybe_unused]],
+  std::string&                  out,
+  direct_format_tag,
+  format::serialize::write_mode mode) -> format::serialize::result<size_t> {
+    if(mode == format::serialize::write_mode::overwrite) out.clear();
+    out += "direct";
+    return format::serialize::result<size_t>(size_t { 6 });
+}
+
 }  // namespace custom
 
 // Extend format::serialize with custom format
@@ -111,6 +220,9 @@ namespace format::serialize {
 template <>
 struct is_text_format<custom::custom_format_tag>: std::true_type {};
 
+template <>
+struct is_text_format<custom::direct_format_tag>: std::true_type {};
+
 }  // namespace format::serialize
 
 void test_custom_parser() {
@@ -195,6 +307,148 @@ void test_custom_serializer() {
     std::cout << "  ✓ Custom serializer works\n";
 }
 
+void test_save_into() {
+    std::cout << "Testing save_into caller buffers...\n";
+
+    using format::serialize::write_mode;
+    TestData data { 1, "test", 3.14 };
+
+    // Fallback through save_impl: overwrite and append keep the buffer's capacity
+    std::string out;
+    out.reserve(256);
+    const char* storage = out.data();
+    for(int i = 0; i < 3; ++i) {
+        auto written = format::serialize::save_into(data, out, custom::custom_format_tag {});
+        assert(written.has_value() && *written == 17);
+        assert(out == "custom_serialized");
+    }
+    auto appended = format::serialize::save_into(data, out, custom::custom_format_tag {}, write_mode::append);
+    assert(appended.has_value() && *appended == 17);
+    assert(out == "custom_serializedcustom_serialized");
+    assert(out.data() == storage);
+
+    // Native save_into_impl is preferred when the format provides one
+    auto direct = format::serialize::save_into(data, out, custom::direct_format_tag {});
+    assert(direct.has_value() && *direct == 6 && out == "direct");
+
+    // Fixed spans report bytes written, or capacity_exceeded
+    std::byte fixed[32] {};
+    auto      fits = format::serialize::save_into(data, std::span<std::byte>(fixed), custom::custom_format_tag {});
+    assert(fits.has_value() && *fits == 17);
+    assert(std::string_view(reinterpret_cast<const char*>(fixed), *fits) == "custom_serialized");
+    auto overflow = format::serialize::save_into(data, std::span<std::byte>(fixed, 8), custom::custom_format_tag {});
+    assert(!overflow.has_value() && overflow.error() == format::serialize::error::capacity_exceeded);
+
+    std::cout << "  ✓ Overwrite, append and fixed-span writes reuse caller storage\n";
+}
+
+void test_schema_json() {
+    std::cout << "Testing schema JSON serializer...\n";
+
+    using format::serialize::json_tag;
+    static_assert(format::serialize::json_schema_writable<SchemaMessage>);
+    static_assert(format::serialize::is_serializable_v<SchemaMessage, json_tag>);
+    static_assert(!format::serialize::json_schema_type<TestData>);
+
+    SchemaMessage message { 42,
+                            "al\"ice\\\n\x01 and a tail longer than one SIMD block",
+                            { "admin", "ops" },
+                            { "acme", -7 },
+                            { 0.1, 1e300, -2.5, std::nan("") },
+                            std::nullopt,
+                            { 1, 255 },
+                            nullptr };
+    const std::string_view expected =
+      R"({"id":42,"us\"er":"al\"ice\\\n\u0001 and a tail longer than one SIMD block","roles":["admin","ops"],)"
+      R"("target":{"tenant":"acme","shard":-7},"samples":[0.1,1e+300,-2.5,null],"trace":null,"flags":[1,255],)"
+      R"("note":null})";
+
+    auto text = format::serialize::save(message, json_tag {});
+    assert(text.has_value() && *text == expected);
+
+    // Reused buffer: overwrite and append; capacity is kept
+    std::string out;
+    assert(format::serialize::save_into(message, out, json_tag {}).value() == expected.size());
+    const auto* storage = out.data();
+    assert(format::serialize::save_into(message, out, json_tag {}).value() == expected.size() && out == expected);
+    assert(out.data() == storage);
+    auto appended = format::serialize::save_into(message, out, json_tag {}, format::serialize::write_mode::append);
+    assert(appended.value() == expected.size() && out.size() == 2 * expected.size());
+
+    // Fixed span: exact fit and overflow
+    std::vector<std::byte> exact(expected.size());
+    assert(format::serialize::save_into(message, std::span<std::byte>(exact), json_tag {}).value() == expected.size());
+    assert(std::string_view(reinterpret_cast<const char*>(exact.data()), exact.size()) == expected);
+    std::byte small[32];
+    auto      overflow = format::serialize::save_into(message, std::span<std::byte>(small), json_tag {});
+    assert(!overflow.has_value() && overflow.error() == format::serialize::error::capacity_exceeded);
+
+    assert(format::serialize::save(ExternalPoint { 1.5f, -0.25f }, json_tag {}).value() == R"({"x":1.5,"y":-0.25})");
+    assert(format::serialize::save(EmptySchema {}, json_tag {}).value() == "{}");
+
+    std::cout << "  ✓ Precomputed keys, escaping, numbers, nesting and caller buffers\n";
+}
+
+void test_backend_selection() {
+    std::cout << "Testing parser backend selection...\n";
+
+    using format::json::backend_list;
+    using format::json::select_parser_t;
+    using backends = backend_list<custom::cursor_parser, custom::minimal_parser>;
+
+    static_assert(format::json::json_parser<custom::cursor_parser>);
+    static_assert(std::is_same_v<select_parser_t<{}, backends>, custom::cursor_parser>);
+    static_assert(std::is_same_v<select_parser_t<{ .random_access = true }, backends>, custom::minimal_parser>);
+    static_assert(std::is_same_v<select_parser_t<{ .zero_copy = true, .lazy_parsing = true }, backends>,
+                                 custom::cursor_parser>);
+    static_assert(std::is_same_v<select_parser_t<{ .zero_copy = true, .full_dom = true }, backends>,
+                                 format::json::unavailable_parser>);
+    static_assert(!format::json::has_parser_for_v<{ .validates_utf8 = true }, backends>);
+
+#ifdef FORMAT_HAS_SIMDJSON
+    static_assert(std::is_same_v<format::json::parser, format::json::simdjson_document>);
+    static_assert(std::is_same_v<select_parser_t<{ .multiple_cursors = true }>, format::json::simdjson_dom_document>);
+    static_assert(format::json::json_parser<format::json::simdjson_dom_document>);
+#else
+    static_assert(std::is_same_v<format::json::parser, format::json::unavailable_parser>);
+    static_assert(!format::json::has_parser_impl);
+#endif
+
+    // Runtime: large documents queried repeatedly get the DOM backend
+    auto dom_chosen = [](std::string_view json, format::json::size_policy policy) {
+        return format::json::parse_adaptive<custom::cursor_parser, custom::minimal_parser>(
+          json, policy, [](auto& doc) { return doc.caps().full_dom; });
+    };
+    const std::string big(4096, ' ');
+    assert(!dom_chosen("{}", { .dom_threshold = 1024, .queries = 5 }));
+    assert(!dom_chosen(big, { .dom_threshold = 1024, .queries = 1 }));
+    assert(dom_chosen(big, { .dom_threshold = 1024, .queries = 2 }));
+    assert(format::json::prefers_dom(1 << 20, { .queries = 3 }) && !format::json::prefers_dom(10, { .queries = 3 }));
+
+#ifdef FORMAT_HAS_SIMDJSON
+    // Both simdjson backends read the same values
+    const std::string json  = R"({"id": 7, "name": "ann", "tags": ["a", "b"]})";
+    auto              names = [&](size_t threshold) {
+        return format::json::parse_adaptive(json, { .dom_threshold = threshold, .queries = 2 }, [](auto& doc) {
+            std::string_view name;
+            auto             root = doc.iterate();
+            if(root["name"].get(name)) return std::string();
+            return std::string(name);
+        });
+    };
+    assert(names(0) == "ann" && names(1 << 20) == "ann");
+
+    format::json::simdjson_dom_document tree(json);
+    auto                                root = tree.iterate();
+    assert(root["tags"].at(1).get_string().value() == "b" && root["id"].get_int64().value() == 7);
+    assert(tree.iterate()["name"].get_string().value() == "ann");  // Parsed once, read again
+    format::json::simdjson_dom_document broken("{\"id\": ");
+    assert(broken.iterate().error());
+#endif
+
+    std::cout << "  ✓ Requirements pick a backend; size and query count pick on-demand or DOM\n";
+}
+
 int main() {
     std::cout << "=== Format Layer Abstraction Tests ===\n\n";
 
@@ -213,6 +467,9 @@ int main() {
 #endif
 
     test_custom_serializer();
+    test_save_into();
+    test_schema_json();
+    test_backend_selection();
 
     std::cout << "\n=== All tests passed! ===\n";
     return 0;
@@ -0,0 +1,221 @@
+// Test: format::csv tokenizer and row binding
+//
+// This test verifies:
+// 1. Field and row boundaries, with quoted delimiters, newlines and \r\n
+// 2. The SIMD kernels agree with the scalar kernel on random input
+// 3. Quote-aware row boundaries for chunking
+// 4. Binding rows to structs, and the csv_tag serialize CPOs
+
+#include <cassert>
+#include <cstdint>
+#include <format/csv.hpp>
+#include <format/serialize.hpp>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace csv = format::csv;
+
+struct Trade {
+    std::string        symbol;
+    int64_t            qty;
+    double             price;
+    std::optional<int> venue;
+    bool               buy;
+};
+
+struct Label {
+    std::string_view key;
+    char             tag;
+};
+
+struct Note {
+    std::optional<std::string> text;
+};
+
+void test_tokenize() {
+    std::cout << "Testing tokenizer...\n";
+
+    csv::field_index rows;
+    std::string      text = "a,b,\"c,\n\"\"d\"\r\nx,,z\n\nlast";
+    auto             n    = csv::tokenize(text, rows);
+    assert(n.has_value() && *n == 4 && rows.row_count() == 4);
+
+    auto first = rows.row(0);
+    assert(first.size() == 3);
+    assert(first.raw(0) == "a" && first.raw(1) == "b" && first.raw(2) == "\"c,\n\"\"d\"");
+    assert(csv::unquote(first.raw(2)) == "c,\n\"\"d");
+    std::string scratch;
+    csv::unescape(first.raw(2), scratch);
+    assert(scratch == "c,\n\"d");
+
+    auto second = rows.row(1);
+    assert(second.size() == 3 && second.raw(1).empty() && second.raw(2) == "z");
+    assert(rows.row(2).blank());
+    assert(rows.row(3).size() == 1 && rows.row(3).raw(0) == "last");  // No final newline
+
+    // Trailing delimiter, empty text, other dialects
+    assert(csv::tokenize("p,q,\n", rows).value() == 1 && rows.row(0).size() == 3 && rows.row(0).raw(2).empty());
+    assert(csv::tokenize("", rows).value() == 0 && rows.field_count() == 0);
+    assert(csv::tokenize("1;'x;y'\n", rows, { .delimiter = ';', .quote = '\'' }).value() == 1);
+    assert(rows.row(0).raw(1) == "'x;y'");
+
+    // Unterminated quote
+    auto broken = csv::tokenize("a,\"open\nrow\n", rows);
+    assert(!broken.has_value() && broken.error() == csv::error::invalid_syntax);
+
+    std::cout << "  ✓ Fields, quotes, blank lines and \\r\\n (kernel: " << csv::kernel_name() << ")\n";
+}
+
+void test_kernels_agree() {
+    std::cout << "Testing SIMD against scalar kernel...\n";
+
+    std::vector<csv::detail::kernel_table> kernels = { csv::detail::active_kernels() };
+#ifdef FORMAT_CSV_X86
+    if(__builtin_cpu_supports("pclmul")) {
+        kernels.push_back({ csv::detail::split_sse2, csv::detail::row_end_sse2, "sse2" });
+    }
+#endif
+
+    std::mt19937 rng(42);
+    const char   alphabet[] = { 'a', 'b', ',', ',', '"', '\n', 'x', ' ' };
+    for(int round = 0; round < 200; ++round) {
+        std::string  text;
+        const size_t length = rng() % 700;
+        bool         quoted = false;
+        for(size_t i = 0; i < length; ++i) {
+            char c = alphabet[rng() % sizeof(alphabet)];
+            if(c == '"') quoted = !quoted;
+            text.push_back(c);
+        }
+        if(quoted) text.push_back('"');
+
+        csv::field_index slow;
+        auto             b = slow.assign(text, {}, csv::detail::scalar_table);
+        assert(b.has_value());
+        for(const auto& kernel : kernels) {
+            csv::field_index fast;
+            auto             a = fast.assign(text, {}, kernel);
+            assert(a.has_value() && *a == *b && fast.field_count() == slow.field_count());
+            for(size_t r = 0; r < *a; ++r) {
+                auto x = fast.row(r);
+                auto y = slow.row(r);
+                assert(x.size() == y.size());
+                for(size_t i = 0; i < x.size(); ++i) assert(x.raw(i) == y.raw(i));
+            }
+
+            // Row boundaries land after an unquoted newline
+            for(size_t at = 0; at < text.size(); at += 37) {
+                const size_t end = kernel.row_end(text.data(), text.size(), 0, at, {});
+                assert(end == csv::detail::row_end_scalar(text.data(), text.size(), 0, at, {}));
+                assert(end == text.size() || (text[end - 1] == '\n' && end - 1 >= at));
+            }
+        }
+    }
+    std::cout << "  ✓ 200 random texts give identical indexes (" << kernels.size() << " SIMD kernels)\n";
+}
+
+void test_row_end() {
+    std::cout << "Testing row boundaries...\n";
+
+    // The newline inside quotes is not a row end, even 64+ bytes in
+    std::string  text = "id,note\n1,\"" + std::string(100, 'n') + "\nmore\"\n2,plain\n";
+    const size_t quoted_newline = text.find('\n', 12);
+    assert(csv::row_end(text, 0, 0) == 8);
+    assert(csv::row_end(text, 8, quoted_newline) == text.find("2,plain"));
+    assert(csv::row_end(text, 0, text.size() - 1) == text.size());
+    assert(csv::row_end(text, 0, text.size()) == text.size());
+    std::cout << "  ✓ Quoted newlines are skipped across blocks\n";
+}
+
+void test_load_rows() {
+    std::cout << "Testing row binding...\n";
+
+    static_assert(csv::column_count_v<Trade> == 5 && csv::row_type<Trade>);
+    static_assert(csv::column_count_v<Label> == 2 && csv::row_type<Label>);
+
+    std::string_view text =
+      "symbol,qty,price,venue,buy\n"
+      "\"ACME, Inc\",100,12.5,3,true\r\n"
+      "\n"
+      "XYZ,-20,0.25,,0\n";
+    std::vector<Trade> trades;
+    auto               loaded = csv::load_rows(text, trades, { .header = true });
+    assert(loaded.has_value() && *loaded == 2 && trades.size() == 2);
+    assert(trades[0].symbol == "ACME, Inc" && trades[0].qty == 100 && trades[0].price == 12.5);
+    assert(trades[0].venue == 3 && trades[0].buy);
+    assert(trades[1].symbol == "XYZ" && trades[1].qty == -20 && trades[1].price == 0.25);
+    assert(!trades[1].venue && !trades[1].buy);
+
+    // Views into the input, quotes stripped
+    std::vector<Label> labels;
+    assert(csv::load_rows("\"k1\",a\nk2,b,extra\n", labels).value() == 2);
+    assert(labels[0].key == "k1" && labels[0].tag == 'a' && labels[1].key == "k2");
+
+    // Bad fields and short rows
+    std::vector<Trade> bad;
+    assert(csv::load_rows("A,1x,1,,true\n", bad).error() == csv::error::type_mismatch);
+    assert(csv::load_rows("A,1,1\n", bad).error() == csv::error::type_mismatch);
+    assert(csv::load_rows("A,1,1,,maybe\n", bad).error() == csv::error::type_mismatch);
+
+    // Empty strings stay apart from absent ones, also in a single column
+    std::vector<Note> notes = { { "" }, { std::nullopt }, { "x" } }, notes_back;
+    std::string       notes_text;
+    for(const auto& n : notes) csv::append_row(notes_text, n);
+    assert(notes_text == "\"\"\n\nx\n");
+    assert(csv::load_rows(notes_text, notes_back).value() == 3);
+    assert(notes_back[0].text == "" && !notes_back[1].text && notes_back[2].text == "x");
+
+    std::vector<Trade> blank_symbol = { { "", 1, 2, std::nullopt, false } }, blank_back;
+    std::string        trade_text;
+    csv::append_row(trade_text, blank_symbol[0]);
+    assert(trade_text == "\"\",1,2,,false\n");
+    assert(csv::load_rows(trade_text, blank_back).value() == 1 && blank_back[0].symbol.empty());
+    std::cout << "  ✓ Numbers, bools, optionals, strings and views bind by position\n";
+}
+
+void test_serialize_cpo() {
+    std::cout << "Testing csv_tag serialization...\n";
+
+    using format::serialize::csv_tag;
+    std::vector<Trade> trades = {
+        { "plain", 1, 1.5, 7, true },
+        { "with \"quotes\", commas", -2, 1e-3, std::nullopt, false },
+        { "multi\nline", 3, 100, 0, true },
+    };
+    auto text = format::serialize::save(trades, csv_tag {});
+    assert(text.has_value());
+    assert(text->starts_with("plain,1,1.5,7,true\n\"with \"\"quotes\"\", commas\",-2,0.001,,false\n"));
+
+    auto back = format::serialize::load<std::vector<Trade>>(*text, csv_tag {});
+    assert(back.has_value() && back->size() == 3);
+    for(size_t i = 0; i < trades.size(); ++i) {
+        assert((*back)[i].symbol == trades[i].symbol && (*back)[i].qty == trades[i].qty);
+        assert((*back)[i].price == trades[i].price && (*back)[i].venue == trades[i].venue);
+        assert((*back)[i].buy == trades[i].buy);
+    }
+
+    std::string out      = "header\n";
+    auto        appended = format::serialize::save_into(trades, out, csv_tag {}, format::serialize::write_mode::append);
+    assert(appended.has_value() && out.size() == 7 + *appended && out.substr(7) == *text);
+
+    static_assert(format::serialize::is_serializable_v<std::vector<Trade>, csv_tag>);
+    static_assert(format::serialize::is_deserializable_v<std::vector<Trade>, csv_tag>);
+    std::cout << "  ✓ save / save_into / load round trip\n";
+}
+
+int main() {
+    std::cout << "=== format::csv Tests ===\n\n";
+
+    test_tokenize();
+    test_kernels_agree();
+    test_row_end();
+    test_load_rows();
+    test_serialize_cpo();
+
+    std::cout << "\n=== All tests passed! ===\n";
+    return 0;
+}
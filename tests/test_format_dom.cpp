@@ -0,0 +1,233 @@
+// Test: format::json mutable DOM
+//
+// This test verifies:
+// 1. Parsing, lookups, RFC 6901 pointers and syntax errors
+// 2. String escapes are decoded on read and written back escaped
+// 3. Patches splice unchanged spans verbatim, including spacing
+// 4. Inserted and erased members, and containers rewritten compactly
+// 5. Nodes come from the given memory resource and chunks are reused
+
+#include <cassert>
+#include <cstdint>
+#include <format/json/concepts.hpp>
+#include <format/json/dom.hpp>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace json = format::json;
+
+// Counts upstream allocations so chunk reuse can be checked
+class counting_resource: public std::pmr::memory_resource {
+    public:
+    size_t allocations = 0;
+    size_t live        = 0;
+
+    private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+const std::string_view sample = R"({
+    "id": 48213,
+    "price": 12.50,
+    "user": { "name": "alice", "roles": ["admin", "ops"] },
+    "note": "tab\there \"quoted\" \u00e9\ud83d\ude00",
+    "route": {"tenant": "acme", "shard": 7},
+    "trace": false,
+    "parent": null
+})";
+
+void test_parse() {
+    std::cout << "Testing parse and lookups...\n";
+
+    json::mutable_document doc(sample);
+    static_assert(json::json_parser<json::mutable_document>);
+    static_assert(json::mutable_document::caps().zero_copy && json::mutable_document::caps().full_dom);
+
+    auto root = doc.iterate().value();
+    assert(root.is_object() && root.size() == 7 && !doc.modified());
+    assert(root["id"].get_int64().value() == 48213);
+    assert(root["price"].get_double().value() == 12.5);
+    assert(root["price"].get_number_text().value() == "12.50");
+    assert(!root["price"].get_int64() && root["price"].get_int64().error() == json::error::type_mismatch);
+    assert(root["user"]["roles"].at(1).get_string().value() == "ops");
+    assert(root["trace"].get_bool().value() == false && root["parent"].is_null());
+
+    // Unescaped strings are views of the source
+    auto name = root["user"]["name"].get_string().value();
+    assert(name == "alice" && name.data() > sample.data() && name.data() < sample.data() + sample.size());
+
+    // Failed lookups chain to the end
+    assert(root["missing"]["deeper"].get_int64().error() == json::error::key_not_found);
+    assert(root["id"]["x"].status() == json::error::type_mismatch);
+    assert(root["user"]["roles"].at(5).status() == json::error::index_out_of_bounds);
+
+    assert(root.at_pointer("/route/shard").get_int64().value() == 7);
+    assert(root.at_pointer("/user/roles/0").get_string().value() == "admin");
+    assert(root.at_pointer("").is_object() && !root.at_pointer("/user/roles/01"));
+    assert(root.at_pointer("route").status() == json::error::invalid_syntax);
+
+    json::mutable_document escaped_keys(R"({"a/b": {"m~n": 1}, "k\"": 2})");
+    auto                   keys = escaped_keys.root();
+    assert(keys.at_pointer("/a~1b/m~0n").get_int64().value() == 1);
+    assert(keys["k\""].get_int64().value() == 2);
+
+    size_t members = 0;
+    for(auto member : root) {
+        assert(!member.key().empty());
+        ++members;
+    }
+    assert(members == 7);
+
+    // Scalars at the root, and whitespace around them
+    json::mutable_document scalar(" -0.5e+3 ");
+    assert(scalar.root().get_double().value() == -500 && scalar.serialize().value() == "-0.5e+3");
+
+    for(std::string_view bad : { "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "01", "1.", "-", "tru", "\"a",
+                                 "\"\\x\"", "\"\\u12g4\"", "\"a\nb\"", "{} {}", "[1] x", "nul" }) {
+        json::mutable_document broken(bad);
+        assert(!broken.iterate() && broken.iterate().error() == json::error::invalid_syntax);
+        assert(!broken.serialize());
+    }
+
+    const std::string      nested = std::string(2000, '[') + std::string(2000, ']');
+    json::mutable_document deep(nested);
+    assert(deep.iterate().error() == json::error::capacity_exceeded);
+    deep.set_max_depth(4096);
+    assert(deep.parse(deep.source()));
+}
+
+void test_strings() {
+    std::cout << "Testing string escapes...\n";
+
+    json::mutable_document doc(sample);
+    auto                   note = doc.root()["note"];
+    assert(note.get_string().value() == "tab\there \"quoted\" \xC3\xA9\xF0\x9F\x98\x80");
+    assert(note.get_string().value().size() == 24);  // Decoded once, then cached
+    assert(!doc.modified() && doc.serialize().value() == sample);  // Reading does not change the output
+
+    note.set_string("line\nbreak \"q\" \\ \x01");
+    auto out = doc.serialize().value();
+    assert(out.find(R"("note": "line\nbreak \"q\" \\ \u0001",)") != std::string::npos);
+    json::mutable_document again(out);
+    assert(again.root()["note"].get_string().value() == "line\nbreak \"q\" \\ \x01");
+
+    json::mutable_document lone(R"(["\ud800", "\udc00x"])");
+    assert(lone.root().at(0).get_string().error() == json::error::utf8_error);
+    assert(lone.root().at(1).get_string().error() == json::error::utf8_error);
+}
+
+void test_splice() {
+    std::cout << "Testing in-place splicing...\n";
+
+    json::mutable_document doc(sample);
+    auto                   root = doc.root();
+    assert(root["route"]["shard"].set_int64(9) && root["price"].set_double(13.25));
+    assert(root["user"]["roles"].at(0).set_string("root"));
+    assert(doc.modified() && root["route"].modified() && !root["id"].modified());
+
+    // Everything but the three values is the original text, spacing included
+    std::string expect(sample);
+    expect.replace(expect.find("7}"), 1, "9");
+    expect.replace(expect.find("12.50"), 5, "13.25");
+    expect.replace(expect.find("\"admin\""), 7, "\"root\"");
+    assert(doc.serialize().value() == expect);
+
+    // Setting an equal value still rewrites only that value
+    json::mutable_document same(sample);
+    assert(same.root()["trace"].set_bool(false) && same.serialize().value() == sample);
+
+    // Appending keeps what was already in out
+    std::string prefixed = "x";
+    assert(doc.serialize(prefixed) && prefixed == "x" + expect);
+}
+
+void test_reshape() {
+    std::cout << "Testing inserted and erased members...\n";
+
+    json::mutable_document doc(sample);
+    auto                   root = doc.root();
+    assert(root["route"].emplace("zone").set_string("eu-west-1b"));
+    assert(root["route"].emplace("shard").set_uint64(8));  // Existing member: assigned in place
+    assert(root.erase("trace") && root.erase("parent") && !root.erase("parent"));
+    assert(root["user"]["roles"].push_back().set_bool(true));
+    assert(root["user"]["roles"].erase_at(0) && !root["user"]["roles"].erase_at(5));
+    assert(root["id"].emplace("x").status() == json::error::type_mismatch);
+    assert(root.size() == 5 && root["route"].size() == 3);
+
+    // Reshaped containers are compact; their untouched members keep their text
+    auto out = doc.serialize().value();
+    assert(out.starts_with(R"({"id":48213,"price":12.50,"user":{ "name": "alice", "roles": ["ops",true] },)"));
+    assert(out.find(R"("route":{"tenant":"acme","shard":8,"zone":"eu-west-1b"})") != std::string::npos);
+    assert(out.ends_with("}") && out.find("trace") == std::string::npos);
+
+    json::mutable_document reparsed(out);
+    auto                   copy = reparsed.root();
+    assert(copy["route"]["zone"].get_string().value() == "eu-west-1b");
+    assert(copy["route"]["shard"].get_int64().value() == 8 && copy["user"]["roles"].size() == 2);
+    assert(copy["note"].get_string().value() == doc.root()["note"].get_string().value());
+
+    // Values replaced by new containers
+    assert(root["id"].set_object() && root["id"].emplace("a").set_array());
+    assert(root["id"]["a"].push_back().set_double(0.5) && root["id"]["a"].push_back().set_null());
+    assert(!root["id"]["a"].at(0).set_double(1.0 / 0.0));
+    assert(doc.serialize().value().starts_with(R"({"id":{"a":[0.5,null]},)"));
+
+    json::mutable_document empty("{}");
+    assert(empty.root().emplace("k").set_int64(-1) && empty.serialize().value() == R"({"k":-1})");
+}
+
+void test_memory() {
+    std::cout << "Testing memory resource and reuse...\n";
+
+    counting_resource memory;
+    {
+        json::mutable_document doc(&memory);
+        assert(doc.parse(sample) && memory.allocations == 1 && doc.memory_used() > 0);
+        assert(doc.resource() == &memory);
+        const size_t used = doc.memory_used();
+
+        // Re-parsing reuses the chunk chain
+        for(int i = 0; i < 100; ++i) {
+            assert(doc.parse(sample) && doc.memory_used() == used);
+            assert(doc.root()["route"]["shard"].set_int64(i));
+        }
+        assert(memory.allocations == 1);
+
+        std::string big = "[";
+        for(int i = 0; i < 5000; ++i) big += std::to_string(i) + ",";
+        big.back() = ']';
+        assert(doc.parse(big) && doc.root().size() == 5000 && doc.root().at(4999).get_int64().value() == 4999);
+        const size_t chunks = memory.allocations;
+        assert(chunks > 1 && doc.parse(big) && memory.allocations == chunks);
+
+        json::mutable_document moved(std::move(doc));
+        assert(moved.root().size() == 5000 && !doc.serialize());
+    }
+    assert(memory.live == 0);
+}
+
+int main() {
+    std::cout << "=== format::json DOM Tests ===\n\n";
+
+    test_parse();
+    test_strings();
+    test_splice();
+    test_reshape();
+    test_memory();
+
+    std::cout << "\n=== All tests passed! ===\n";
+    return 0;
+}
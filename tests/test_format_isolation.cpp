@@ -13,6 +13,7 @@
 #include <asyncle/format/serialize.hpp>
 #include <cassert>
 #include <iostream>
+#include <string>
 
 // This test file has ZERO mentions of simdjson or Glaze!
 // It only knows about asyncle::format and format::json abstractions
@@ -42,6 +43,14 @@ void test_json_parsing_abstraction() {
 
     // Check if a parser is available (decided by format layer)
     if constexpr(!asyncle::format::json::has_parser()) {
+#if !defined(FORMAT_HAS_SIMDJSON)
+        // Pooled parsing keeps the same shape and fails cleanly without an implementation
+        asyncle::format::json::parser_pool pool;
+        auto                               lease = pool.acquire();
+        assert(!lease.is_valid());
+        assert(!lease.iterate(R"({"name": "test"})").has_value());
+#endif
+
         std::cout << "  ⚠ No JSON parser implementation available\n";
         std::cout << "  ℹ Enable with: -DFORMAT_ENABLE_SIMDJSON=ON or -DFORMAT_ENABLE_GLAZE=ON\n";
         return;
@@ -82,6 +91,17 @@ void test_json_parsing_abstraction() {
     // Alternative: Direct parse (convenience)
     auto doc2 = asyncle::format::json::parse(json);
     std::cout << "  ✓ Direct parse() works\n";
+
+    // Pooled parse - parser and buffers are reused across documents
+    asyncle::format::json::parser_pool pool;
+    for(int i = 0; i < 3; ++i) {
+        auto lease  = pool.acquire();
+        auto pooled = lease.iterate(json);
+        auto pvalue = pooled["value"].get_int64();
+        assert(!pvalue.error() && pvalue.value() == 42);
+    }
+    assert(pool.created() == 1);
+    std::cout << "  ✓ Pooled parse reuses one parser\n";
 #endif
 
     std::cout << "  ✓ JSON parsing abstraction is implementation-agnostic\n";
@@ -113,6 +133,16 @@ void test_serialization_abstraction() {
     auto serializer   = asyncle::format::serializer<TestData>();
     auto json_from_op = serializer.to_json(data);
 
+    // Reused output buffer - same call shape whatever the implementation
+    std::string out;
+    for(int i = 0; i < 2; ++i) {
+        auto written = asyncle::format::to_json_into(data, out);
+        assert(written.has_value() && *written == out.size());
+    }
+    auto appended = asyncle::format::save_into(data, out, json_tag {}, asyncle::format::write_mode::append);
+    assert(appended.has_value() && out.size() == 2 * *appended);
+    std::cout << "  ✓ save_into() reuses caller buffers\n";
+
     std::cout << "  ✓ Serialization abstraction is implementation-agnostic\n";
 }
 
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <format/json.hpp>
 #include <iostream>
+#include <string>
 #include <string_view>
 
 #ifdef FORMAT_HAS_SIMDJSON
@@ -112,6 +113,105 @@ void test_simdjson_capabilities() {
     std::cout << "PASS: simdjson capabilities check\n";
 }
 
+void test_simdjson_parser_pool() {
+    format::json::simdjson_parser_pool pool(2);
+    assert(pool.idle() == 2);
+
+    {
+        auto lease = pool.acquire();
+        assert(lease.is_valid());
+        assert(pool.idle() == 1);
+
+        // The same lease parses many documents, growing its buffer only when needed
+        for(int i = 0; i < 100; ++i) {
+            std::string json   = R"({"id": )" + std::to_string(i) + R"(, "tag": "order"})";
+            auto        result = lease.iterate(json);
+            auto        id     = result["id"].get_int64();
+            if(id.error() || id.value() != i) {
+                std::cerr << "FAIL: simdjson pooled parse " << i << '\n';
+                std::exit(1);
+            }
+        }
+    }
+    assert(pool.idle() == 2);  // Lease returned on destruction
+    assert(pool.created() == 2);
+
+    // Empty pool creates on demand; moved-from leases return nothing
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    auto c = pool.acquire();
+    assert(pool.idle() == 0 && pool.created() == 3);
+    auto moved = std::move(c);
+    assert(!c.is_valid() && moved.is_valid());
+    moved.release();
+    assert(!moved.is_valid() && pool.idle() == 1);
+
+    std::cout << "PASS: simdjson parser pool reuse\n";
+}
+
+void test_simdjson_document_stream() {
+    format::json::simdjson_document_stream stream(4096);
+    int64_t                                sum   = 0;
+    auto                                   on_id = [&](simdjson::ondemand::document_reference& doc) {
+        sum += doc["id"].get_int64().value();
+    };
+
+    // One byte at a time: every document straddles a chunk boundary
+    std::string_view ndjson = "{\"id\": 1}\n{\"id\": 2}\n\n{\"id\": 3}";
+    size_t           parsed = 0;
+    for(char c : ndjson) {
+        auto result = stream.feed(std::string_view(&c, 1), on_id);
+        assert(result.has_value());
+        parsed += *result;
+    }
+    assert(parsed == 2 && stream.pending() > 0);
+    auto last = stream.finish(on_id);
+    assert(last.has_value() && *last == 1);
+    if(sum != 6 || stream.documents() != 3) {
+        std::cerr << "FAIL: simdjson document stream\n";
+        std::exit(1);
+    }
+
+    stream.reset();
+
+    std::cout << "PASS: simdjson document stream\n";
+}
+
+struct ExtractTarget {
+    uint8_t          small = 0;
+    double           ratio = 0;
+    std::string_view name;
+};
+
+void test_simdjson_extract() {
+    using format::json::field;
+    using small_field = field<"/n", &ExtractTarget::small>;
+    using ratio_field = field<"/a/0/r", &ExtractTarget::ratio>;
+    using name_field  = field<"/~0name", &ExtractTarget::name>;
+
+    // Walked directly over a native document; the members after the last field are never visited
+    simdjson::padded_string      json(std::string_view(R"({"a": [{"r": 0.25}], "~name": "x", "n": 200, "junk": [1]})"));
+    simdjson::ondemand::parser   p;
+    simdjson::ondemand::document doc = p.iterate(json).value();
+    ExtractTarget                target;
+    auto found = format::json::simdjson_extract<small_field, ratio_field, name_field>(doc, target);
+    assert(found.has_value() && *found == 3);
+    assert(target.small == 200 && target.ratio == 0.25 && target.name == "x");
+
+    // Out of range for the member and wrong JSON type
+    format::json::simdjson_document overflow(std::string_view(R"({"n": 300})"));
+    auto                            too_big = format::json::extract<small_field>(overflow, target);
+    format::json::simdjson_document wrong(std::string_view(R"({"n": "200"})"));
+    auto                            as_text = format::json::extract<small_field>(wrong, target);
+    if(too_big.has_value() || too_big.error() != format::json::error::type_mismatch || as_text.has_value()
+       || as_text.error() != format::json::error::type_mismatch) {
+        std::cerr << "FAIL: simdjson extract type checks\n";
+        std::exit(1);
+    }
+
+    std::cout << "PASS: simdjson extract\n";
+}
+
 #endif  // FORMAT_HAS_SIMDJSON
 
 #ifdef FORMAT_HAS_GLAZE
@@ -191,6 +291,9 @@ int main() {
     test_simdjson_invalid_json();
     test_simdjson_nested();
     test_simdjson_capabilities();
+    test_simdjson_parser_pool();
+    test_simdjson_document_stream();
+    test_simdjson_extract();
     std::cout << "\n";
 #else
     std::cout << "simdjson tests SKIPPED (not enabled)\n\n";
@@ -0,0 +1,152 @@
+#include <asyncle/hardware/affinity.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace asyncle::hardware;
+
+// Pin the calling thread to each allowed CPU in turn and check where it runs
+void test_pin_current_thread() {
+    std::cout << "Testing current thread pinning...\n";
+
+    std::vector<uint32_t> original = affinity();
+    assert(!original.empty());
+    assert(std::is_sorted(original.begin(), original.end()));
+
+    for(uint32_t cpu : original) {
+        uint32_t one[] = { cpu };
+        assert(pin_to(one));
+        assert(affinity() == std::vector<uint32_t>({ cpu }));
+
+        cpu_position position = where_am_i();
+        assert(position.cpu == cpu);
+        assert(position.node == cpu_topology::current().node_of(cpu));
+        assert(fast_cpu_id() == cpu);
+    }
+
+    // Empty and impossible sets are refused and leave the mask alone
+    assert(!pin_to(std::span<const uint32_t>()));
+    uint32_t bogus[] = { 1u << 20 };
+    assert(!pin_to(bogus));
+
+    assert(pin_to(original));
+    assert(affinity() == original);
+    std::cout << "  ✓ " << original.size() << " CPU(s) pinned and restored\n";
+}
+
+// Pin a running std::thread from outside
+void test_pin_std_thread() {
+    std::cout << "Testing std::thread pinning...\n";
+
+    std::vector<uint32_t> allowed = affinity();
+    std::atomic<bool>     release { false };
+    std::atomic<uint32_t> seen { UINT32_MAX };
+    std::atomic<bool>     pinned { false };
+
+    std::thread worker([&] {
+        while(!pinned.load()) std::this_thread::yield();
+        seen = where_am_i().cpu;
+        while(!release.load()) std::this_thread::yield();
+    });
+
+    uint32_t target[] = { allowed.back() };
+    assert(pin_to(worker, target));
+    assert(affinity(worker) == std::vector<uint32_t>({ allowed.back() }));
+    pinned = true;
+    while(seen.load() == UINT32_MAX) std::this_thread::yield();
+    assert(seen.load() == allowed.back());
+    release = true;
+    worker.join();
+
+    // The calling thread is unaffected
+    assert(affinity() == allowed);
+    std::cout << "  ✓ Worker ran on CPU " << seen.load() << "\n";
+}
+
+void test_node_pinning() {
+    std::cout << "Testing node pinning...\n";
+
+    const auto& topo = cpu_topology::current();
+    for(uint32_t node : topo.node_ids()) {
+        auto cpus = topo.cpus_on_node(node);
+        if(cpus.empty()) continue;
+        scoped_affinity scope(cpus);
+        assert(scope.pinned());
+        assert(affinity() == cpus);
+        assert(where_am_i().node == node);
+    }
+
+    // Scope exit restored the full mask
+    std::vector<uint32_t> all;
+    for(const auto& loc : topo.cpus()) {
+        if(loc.allowed) all.push_back(loc.cpu);
+    }
+    assert(affinity() == all);
+    std::cout << "  ✓ " << topo.node_count() << " node(s)\n";
+}
+
+void test_scheduling() {
+    std::cout << "Testing scheduling class and priority...\n";
+
+    thread_scheduling initial = scheduling();
+    assert(initial.cls == sched_class::normal);
+
+    // Lowering priority never needs privileges
+    std::thread worker([] {
+        assert(set_scheduling(sched_class::batch));
+        assert(scheduling().cls == sched_class::batch);
+        assert(set_scheduling(sched_class::normal, 5));
+        thread_scheduling now = scheduling();
+        assert(now.cls == sched_class::normal);
+        assert(now.priority == 5);
+        assert(set_scheduling(sched_class::idle));
+        assert(scheduling().cls == sched_class::idle);
+    });
+    worker.join();
+
+    // Real-time needs CAP_SYS_NICE or an rtprio limit; check it round-trips when granted
+    std::thread rt([] {
+        if(set_scheduling(sched_class::fifo, 10)) {
+            thread_scheduling now = scheduling();
+            assert(now.cls == sched_class::fifo);
+            assert(now.priority == 10);
+            std::cout << "  ✓ SCHED_FIFO granted\n";
+        } else {
+            std::cout << "  - SCHED_FIFO refused (no privilege)\n";
+        }
+    });
+    rt.join();
+
+    // Nice values of another thread cannot be set, class changes can
+    std::atomic<bool> release { false };
+    std::thread       other([&] {
+        while(!release.load()) std::this_thread::yield();
+    });
+    assert(!set_scheduling(other, sched_class::normal, 3));
+    assert(set_scheduling(other, sched_class::batch));
+    thread_scheduling other_state {};
+    assert(get_thread_scheduling(other.native_handle(), other_state));
+    assert(other_state.cls == sched_class::batch);
+    release = true;
+    other.join();
+
+    // Caller unchanged
+    assert(scheduling().cls == initial.cls);
+    assert(scheduling().priority == initial.priority);
+    std::cout << "  ✓ batch / nice / idle round-trip\n";
+}
+
+int main() {
+    std::cout << "Running hardware::affinity tests...\n\n";
+
+    test_pin_current_thread();
+    test_pin_std_thread();
+    test_node_pinning();
+    test_scheduling();
+
+    std::cout << "\nAll affinity tests passed!\n";
+    return 0;
+}
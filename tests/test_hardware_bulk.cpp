@@ -0,0 +1,176 @@
+#include <asyncle/hardware/bulk.hpp>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace asyncle::hardware;
+
+namespace {
+
+struct copy_variant {
+    const char*               name;
+    bool                      usable;
+    detail::stream_copy_fn*   copy;
+    detail::stream_fill_fn*   fill;
+    detail::find_byte_fn*     find;
+    detail::find_byte_any_fn* find_any;
+};
+
+// Every variant this CPU can run, plus the public dispatchers
+std::vector<copy_variant> variants() {
+    std::vector<copy_variant> out;
+    out.push_back({ "dispatch", true, stream_copy, stream_fill, find_byte, find_byte_any });
+    out.push_back({ "scalar", true, detail::stream_copy_scalar, detail::stream_fill_scalar, detail::find_byte_scalar,
+                    detail::find_byte_any_scalar });
+#if defined(ASYNCLE_BULK_X86)
+    out.push_back({ "sse2/ssse3", has_cpu_feature(cpu_feature::ssse3), detail::stream_copy_sse2,
+                    detail::stream_fill_sse2, detail::find_byte_sse2, detail::find_byte_any_ssse3 });
+    out.push_back({ "avx2", has_cpu_feature(cpu_feature::avx2), detail::stream_copy_avx2, detail::stream_fill_avx2,
+                    detail::find_byte_avx2, detail::find_byte_any_avx2 });
+    out.push_back({ "avx512", cpu_features().has_all(detail::avx512bw_bmi2), detail::stream_copy_avx512,
+                    detail::stream_fill_avx512, detail::find_byte_avx512, detail::find_byte_any_avx2 });
+#elif defined(ASYNCLE_BULK_AARCH64)
+    out.push_back({ "neon", true, detail::stream_copy_neon, detail::stream_fill_neon, detail::find_byte_scalar,
+                    detail::find_byte_any_scalar });
+#endif
+    return out;
+}
+
+uint8_t pattern(size_t i) { return static_cast<uint8_t>(i * 131 + (i >> 8)); }
+
+}  // namespace
+
+// Copies and fills match memcpy/memset for every size and misalignment, without touching neighbours
+void test_copy_fill() {
+    std::cout << "Testing stream_copy / stream_fill...\n";
+
+    const size_t sizes[] = { 0, 1, 63, 64, 255, 4095, 4096, 4097, 65536 + 37, 1 << 20 };
+    std::vector<uint8_t> src((1 << 20) + 128), dst((1 << 20) + 256);
+    for(size_t i = 0; i < src.size(); ++i) src[i] = pattern(i);
+
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        for(size_t n : sizes) {
+            for(size_t dst_off : { 0, 1, 17, 63 }) {
+                size_t src_off = (dst_off * 7) % 61;
+                std::memset(dst.data(), 0xee, dst.size());
+                v.copy(dst.data() + dst_off, src.data() + src_off, n);
+                assert(std::memcmp(dst.data() + dst_off, src.data() + src_off, n) == 0);
+                if(dst_off) assert(dst[dst_off - 1] == 0xee);
+                assert(dst[dst_off + n] == 0xee);
+
+                for(uint8_t value : { 0x00, 0x5a }) {
+                    v.fill(dst.data() + dst_off, value, n);
+                    for(size_t i = 0; i < n; ++i) assert(dst[dst_off + i] == value);
+                    if(dst_off) assert(dst[dst_off - 1] == 0xee);
+                    assert(dst[dst_off + n] == 0xee);
+                }
+            }
+        }
+        std::cout << "  ✓ " << v.name << "\n";
+    }
+}
+
+// find_byte agrees with memchr at every position, including absent needles
+void test_find_byte() {
+    std::cout << "Testing find_byte...\n";
+
+    std::vector<uint8_t> data(1000, 'a');
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        assert(v.find(data.data(), 0, 'a') == nullptr);
+        assert(v.find(data.data(), data.size(), 'b') == nullptr);
+        for(size_t at = 0; at < data.size(); at += 7) {
+            data[at] = 'b';
+            for(size_t start : { 0, 3 }) {
+                if(start > at) continue;
+                const void* expected = std::memchr(data.data() + start, 'b', data.size() - start);
+                assert(v.find(data.data() + start, data.size() - start, 'b') == expected);
+            }
+            // Needle just past the searched range is not reported
+            assert(v.find(data.data(), at, 'b') == nullptr);
+            data[at] = 'a';
+        }
+        std::cout << "  ✓ " << v.name << "\n";
+    }
+}
+
+void test_find_byte_any() {
+    std::cout << "Testing find_byte_any...\n";
+
+    // Sets spanning both halves of the byte range, and every high nibble
+    std::vector<byte_set> sets = { byte_set(",\n\""), byte_set { 0x00, 0x7f, 0x80, 0xff }, byte_set("\r") };
+    byte_set              every_nibble;
+    for(int h = 0; h < 16; ++h) every_nibble.add(static_cast<uint8_t>(h * 16 + (h % 5)));
+    sets.push_back(every_nibble);
+
+    static constexpr byte_set csv(",\n\"");
+    static_assert(csv.contains(',') && csv.contains('"') && !csv.contains('a') && csv.count == 3);
+
+    std::vector<uint8_t> data(777);
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        for(const auto& set : sets) {
+            // Fill with non-members, then plant each byte value at several positions
+            uint8_t filler = 0;
+            while(set.contains(filler)) ++filler;
+            std::memset(data.data(), filler, data.size());
+            assert(v.find_any(data.data(), data.size(), set) == nullptr);
+
+            for(int b = 0; b < 256; ++b) {
+                for(size_t at : { size_t(0), size_t(31), size_t(64), size_t(500), data.size() - 1 }) {
+                    data[at]             = static_cast<uint8_t>(b);
+                    const void* expected = set.contains(static_cast<uint8_t>(b)) ? data.data() + at : nullptr;
+                    assert(v.find_any(data.data(), data.size(), set) == expected);
+                    data[at] = filler;
+                }
+            }
+        }
+        std::cout << "  ✓ " << v.name << "\n";
+    }
+
+    assert(find_byte_any("abc", 3, byte_set()) == nullptr);
+}
+
+// Searches ending right at an unmapped page do not read past the end
+void test_no_overread() {
+#ifdef __linux__
+    std::cout << "Testing search bounds at a guard page...\n";
+
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    void*  area = mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(area != MAP_FAILED);
+    assert(mprotect(static_cast<char*>(area) + page, page, PROT_NONE) == 0);
+    auto* base = static_cast<uint8_t*>(area);
+    std::memset(base, 'x', page);
+
+    byte_set set("yz");
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        for(size_t n = 0; n <= 130; ++n) {
+            const uint8_t* start = base + page - n;
+            assert(v.find(start, n, 'y') == nullptr);
+            assert(v.find_any(start, n, set) == nullptr);
+        }
+    }
+    munmap(area, 2 * page);
+    std::cout << "  ✓ No access past the last byte\n";
+#endif
+}
+
+int main() {
+    std::cout << "Running hardware::bulk tests...\n\n";
+
+    test_copy_fill();
+    test_find_byte();
+    test_find_byte_any();
+    test_no_overread();
+
+    std::cout << "\nAll bulk memory tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <asyncle/hardware/capabilities.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace asyncle::hardware;
+
+namespace {
+
+using sum_fn = uint64_t(const uint32_t*, size_t);
+
+uint64_t sum_scalar(const uint32_t* data, size_t n) {
+    uint64_t total = 0;
+    for(size_t i = 0; i < n; ++i) total += data[i];
+    return total;
+}
+
+#if ASYNCLE_HAS_TARGET_ATTRIBUTE && defined(ASYNCLE_ARCH_X86_64)
+// Same loop, vectorised by the compiler for AVX2 / AVX-512
+ASYNCLE_TARGET(ASYNCLE_TARGET_X86_64_V3) uint64_t sum_v3(const uint32_t* data, size_t n) {
+    uint64_t total = 0;
+    for(size_t i = 0; i < n; ++i) total += data[i];
+    return total;
+}
+
+ASYNCLE_TARGET(ASYNCLE_TARGET_X86_64_V4) uint64_t sum_v4(const uint32_t* data, size_t n) {
+    uint64_t total = 0;
+    for(size_t i = 0; i < n; ++i) total += data[i];
+    return total;
+}
+#endif
+
+}  // namespace
+
+// Test the feature bitset itself
+void test_feature_set() {
+    std::cout << "Testing cpu_feature_set...\n";
+
+    cpu_feature_set empty;
+    assert(empty.empty() && empty.size() == 0);
+
+    cpu_feature_set some { cpu_feature::sse2, cpu_feature::avx2, cpu_feature::lse };
+    assert(some.size() == 3);
+    assert(some.has(cpu_feature::avx2) && some.has(cpu_feature::lse));
+    assert(!some.has(cpu_feature::avx512f));
+    assert(some.has_all({ cpu_feature::sse2, cpu_feature::lse }));
+    assert(!some.has_all({ cpu_feature::sse2, cpu_feature::sve }));
+    assert(some.has_all(empty));
+
+    some.clear(cpu_feature::avx2);
+    assert(!some.has(cpu_feature::avx2) && some.size() == 2);
+    assert((some | cpu_feature_set { cpu_feature::avx2 }).size() == 3);
+    assert((some & cpu_feature_set { cpu_feature::lse }) == cpu_feature_set { cpu_feature::lse });
+
+    // Levels nest
+    static_assert(x86_64_v4.has_all(x86_64_v3));
+    static_assert(!x86_64_v3.has(cpu_feature::avx512f));
+
+    // Every feature has a distinct name that parses back
+    for(size_t i = 0; i < static_cast<size_t>(cpu_feature::count); ++i) {
+        auto        f = static_cast<cpu_feature>(i);
+        cpu_feature parsed;
+        assert(cpu_feature_name(f) != nullptr);
+        assert(detail::parse_cpu_feature(cpu_feature_name(f), parsed) && parsed == f);
+    }
+    assert(cpu_feature_name(cpu_feature::count) == nullptr);
+
+    cpu_feature_set filtered { cpu_feature::avx2, cpu_feature::avx512f, cpu_feature::sse4_2 };
+    detail::remove_cpu_features(filtered, "avx512f,bogus,avx2");
+    assert(filtered == cpu_feature_set { cpu_feature::sse4_2 });
+
+    cpu_feature_set stacked { cpu_feature::avx, cpu_feature::avx2, cpu_feature::avx512f, cpu_feature::avx512bw };
+    detail::remove_cpu_features(stacked, "avx512f");
+    assert((stacked == cpu_feature_set { cpu_feature::avx, cpu_feature::avx2 }));
+    detail::remove_cpu_features(stacked, "avx");
+    assert(stacked.empty());
+    std::cout << "  ✓ set, clear, has_all, names and disable lists work\n";
+}
+
+// Test the runtime probe against what the compiler already guarantees
+void test_detection() {
+    std::cout << "Testing runtime CPU feature detection...\n";
+
+    const cpu_feature_set& features = cpu_features();
+    assert(&features == &cpu_features());  // Probed once
+
+    std::string names;
+    for(size_t i = 0; i < static_cast<size_t>(cpu_feature::count); ++i) {
+        if(!features.has(static_cast<cpu_feature>(i))) continue;
+        names += ' ';
+        names += cpu_feature_name(static_cast<cpu_feature>(i));
+    }
+    std::cout << "  Detected (" << features.size() << "):" << names << "\n";
+
+    // Whatever the build assumes must be present at runtime (unless hidden by ASYNCLE_CPU_DISABLE)
+    if(std::getenv("ASYNCLE_CPU_DISABLE") == nullptr) {
+#if defined(ASYNCLE_ARCH_X86_64)
+        assert(features.has(cpu_feature::sse) && features.has(cpu_feature::sse2));
+#endif
+#if defined(__SSE4_2__)
+        assert(features.has(cpu_feature::sse4_2));
+#endif
+#if defined(__AVX2__)
+        assert(features.has(cpu_feature::avx2));
+#endif
+#if defined(__AVX512F__)
+        assert(features.has(cpu_feature::avx512f));
+#endif
+#if defined(ASYNCLE_ARCH_AARCH64)
+        assert(features.has(cpu_feature::neon));
+#endif
+#if defined(__ARM_FEATURE_SVE)
+        assert(features.has(cpu_feature::sve));
+#endif
+    }
+
+    // Dependent extensions never appear without their base
+    if(features.has(cpu_feature::avx2)) assert(features.has(cpu_feature::avx));
+    if(features.has(cpu_feature::avx512bw)) assert(features.has(cpu_feature::avx512f));
+    if(features.has(cpu_feature::sve2)) assert(features.has(cpu_feature::sve));
+    std::cout << "  ✓ Detection matches compile-time guarantees\n";
+}
+
+// Test variant selection and calling target-attribute code
+void test_dispatch() {
+    std::cout << "Testing select_variant...\n";
+
+    auto v3_only = +[](const uint32_t*, size_t) -> uint64_t { return 3; };
+    auto v4_only = +[](const uint32_t*, size_t) -> uint64_t { return 4; };
+
+    const cpu_variant<sum_fn> table[] = { { x86_64_v4, v4_only }, { x86_64_v3, v3_only } };
+    assert(select_variant<sum_fn>(table, sum_scalar, x86_64_v4) == v4_only);
+    assert(select_variant<sum_fn>(table, sum_scalar, x86_64_v3) == v3_only);
+    assert(select_variant<sum_fn>(table, sum_scalar, cpu_feature_set { cpu_feature::sse2 }) == sum_scalar);
+
+    // One missing feature is enough to skip a variant
+    cpu_feature_set almost_v4 = x86_64_v4;
+    almost_v4.clear(cpu_feature::avx512vl);
+    assert(select_variant<sum_fn>(table, sum_scalar, almost_v4) == v3_only);
+
+    uint32_t data[1000];
+    for(uint32_t i = 0; i < 1000; ++i) data[i] = i * 7 + 1;
+    const uint64_t expected = sum_scalar(data, 1000);
+
+#if ASYNCLE_HAS_TARGET_ATTRIBUTE && defined(ASYNCLE_ARCH_X86_64)
+    sum_fn* best = select_variant<sum_fn>({ { x86_64_v4, sum_v4 }, { x86_64_v3, sum_v3 } }, sum_scalar);
+    const char* level = best == sum_v4 ? "x86-64-v4" : best == sum_v3 ? "x86-64-v3" : "baseline";
+    std::cout << "  Selected sum variant: " << level << "\n";
+#else
+    sum_fn* best = select_variant<sum_fn>({}, sum_scalar);
+    assert(best == sum_scalar);
+#endif
+    assert(best(data, 1000) == expected);
+    std::cout << "  ✓ Best supported variant selected and runs\n";
+}
+
+int main() {
+    std::cout << "Running hardware::capabilities tests...\n\n";
+
+    test_feature_set();
+    test_detection();
+    test_dispatch();
+
+    std::cout << "\nAll capabilities tests passed!\n";
+    return 0;
+}
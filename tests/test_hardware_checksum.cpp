@@ -0,0 +1,151 @@
+#include <asyncle/hardware/checksum.hpp>
+#include <asyncle/io/mmap.hpp>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+using namespace asyncle::hardware;
+
+namespace {
+
+struct crc_variant {
+    const char*        name;
+    bool               usable;
+    detail::crc32c_fn* crc;
+};
+
+// Every variant built for this target, and whether this CPU can run it
+std::vector<crc_variant> variants() {
+    std::vector<crc_variant> out;
+    out.push_back({ "scalar", true, detail::crc32c_scalar });
+#if defined(ASYNCLE_CHECKSUM_X86_64)
+    out.push_back({ "sse4.2", cpu_features().has(cpu_feature::sse4_2), detail::crc32c_sse42 });
+#elif defined(ASYNCLE_CHECKSUM_AARCH64)
+    out.push_back({ "arm-crc32", cpu_features().has(cpu_feature::arm_crc32), detail::crc32c_arm });
+#endif
+    return out;
+}
+
+// One table lookup per byte: the definition the faster kernels must match
+uint32_t crc32c_reference(const void* data, size_t n) {
+    uint32_t    crc = ~0u;
+    const auto* p   = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < n; ++i) crc = detail::crc32c_tables[0][(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+std::vector<unsigned char> pattern(size_t n) {
+    std::vector<unsigned char> data(n);
+    for(size_t i = 0; i < n; ++i) data[i] = static_cast<unsigned char>((i * 2654435761u) >> 11);
+    return data;
+}
+
+}  // namespace
+
+void test_crc32c_vectors() {
+    std::cout << "Testing CRC32C known values...\n";
+
+    unsigned char zeros[32] = {};
+    unsigned char ones[32];
+    std::memset(ones, 0xff, sizeof(ones));
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        auto crc = [&](const void* p, size_t n) { return ~v.crc(~0u, p, n); };
+        assert(crc("123456789", 9) == 0xE3069283u);
+        assert(crc(zeros, 32) == 0x8A9136AAu);  // RFC 3720 B.4
+        assert(crc(ones, 32) == 0x62A8AB43u);
+        assert(crc(nullptr, 0) == 0);
+        std::cout << "  ✓ " << v.name << "\n";
+    }
+    assert(crc32c("123456789", 9) == 0xE3069283u);
+}
+
+void test_crc32c_lanes() {
+    std::cout << "Testing CRC32C across lane boundaries...\n";
+
+    // Sizes around the short (3 x 256) and long (3 x 8192) interleaved blocks,
+    // at every start alignment within a word
+    const size_t short_block = 3 * detail::crc32c_short_lane;
+    const size_t long_block  = 3 * detail::crc32c_long_lane;
+    const auto   data        = pattern(2 * long_block + 64);
+    for(const auto& v : variants()) {
+        if(!v.usable) continue;
+        for(size_t n : { size_t { 0 }, size_t { 7 }, short_block - 1, short_block, short_block + 9, long_block - 1,
+                         long_block, long_block + short_block + 3, 2 * long_block }) {
+            for(size_t offset = 0; offset < 8; ++offset) {
+                assert(~v.crc(~0u, data.data() + offset, n) == crc32c_reference(data.data() + offset, n));
+            }
+        }
+        std::cout << "  ✓ " << v.name << " matches the bytewise definition\n";
+    }
+
+    // Continuing from a previous result splits anywhere, including mid-lane
+    const uint32_t whole = crc32c(data.data(), data.size());
+    for(size_t split : { size_t { 1 }, short_block + 5, long_block, data.size() - 1 }) {
+        assert(crc32c(data.data() + split, data.size() - split, crc32c(data.data(), split)) == whole);
+    }
+    std::cout << "  ✓ Chained results equal the one-shot CRC\n";
+}
+
+void test_zero_shift() {
+    std::cout << "Testing the zero-shift operator...\n";
+
+    // Shifting a register past n zero bytes equals feeding it n zeros
+    const std::vector<unsigned char> zeros(detail::crc32c_long_lane, 0);
+    for(uint32_t reg : { 1u, 0x80000000u, 0xDEADBEEFu }) {
+        assert(detail::crc32c_shift(detail::crc32c_short_shift, reg)
+               == detail::crc32c_scalar(reg, zeros.data(), detail::crc32c_short_lane));
+        assert(detail::crc32c_shift(detail::crc32c_long_shift, reg)
+               == detail::crc32c_scalar(reg, zeros.data(), detail::crc32c_long_lane));
+    }
+    static_assert(detail::crc32c_zeros_tables(0)[1][1] == 1u << 8);  // Identity
+    std::cout << "  ✓ Short and long lane tables\n";
+}
+
+void test_xxh64() {
+    std::cout << "Testing XXH64...\n";
+
+    constexpr std::string_view text = "Nobody inspects the spammish repetition";
+    assert(xxh64("", 0) == 0xEF46DB3751D8E999ull);
+    assert(xxh64("abc", 3) == 0x44BC2CF5AD770999ull);
+    assert(xxh64(text.data(), text.size()) == 0xFBCEA83C8A378BF1ull);
+    assert(xxh64("abc", 3, 1) != xxh64("abc", 3));
+    std::cout << "  ✓ Reference values and seeding\n";
+}
+
+void test_spans_and_mappings() {
+    std::cout << "Testing span and mmap overloads...\n";
+
+    std::vector<uint32_t> words(1000);
+    for(size_t i = 0; i < words.size(); ++i) words[i] = static_cast<uint32_t>(i * 40503u);
+    std::span<const uint32_t> view(words);
+    assert(crc32c(view) == crc32c(words.data(), words.size() * sizeof(uint32_t)));
+    assert(xxh64(view, 7) == xxh64(words.data(), words.size() * sizeof(uint32_t), 7));
+    assert(crc32c(view.subspan(10), crc32c(view.first(10))) == crc32c(view));
+
+    asyncle::io::mmap region;
+    assert(region.map_anonymous(64 * 1024).has_value());
+    const auto data = pattern(region.size());
+    std::memcpy(region.data(), data.data(), data.size());
+    assert(asyncle::io::crc32c(region) == crc32c(data.data(), data.size()));
+    assert(xxh64(region) == xxh64(data.data(), data.size()));  // Found by ADL
+
+    asyncle::io::mmap unmapped;
+    assert(crc32c(unmapped) == 0 && xxh64(unmapped) == xxh64(nullptr, 0));
+    std::cout << "  ✓ Spans hash their bytes, mappings their whole region\n";
+}
+
+int main() {
+    std::cout << "=== Checksum Tests ===\n\n";
+
+    test_crc32c_vectors();
+    test_crc32c_lanes();
+    test_zero_shift();
+    test_xxh64();
+    test_spans_and_mappings();
+
+    std::cout << "\nAll checksum tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <asyncle/concurrent/sharded.hpp>
+#include <asyncle/hardware/clock.hpp>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace asyncle::hardware;
+
+void test_calibration() {
+    std::cout << "Testing calibration...\n";
+
+    const clock_calibration& cal = cycle_clock::calibration();
+    assert(cal.source == cycle_clock::source);
+    assert(cal.ticks_per_ns > 0.0);
+    assert(cal.ns_scale > 0);
+    assert(&cal == &cycle_clock::calibration());
+
+    // A second measurement agrees with the cached one to within a percent
+    clock_calibration again = cycle_clock::calibrate(std::chrono::milliseconds(5));
+    assert(std::fabs(again.ticks_per_ns - cal.ticks_per_ns) / cal.ticks_per_ns < 0.01);
+
+#if defined(ASYNCLE_CLOCK_TSC)
+    assert(cal.source == tick_source::tsc);
+    assert(cal.invariant == has_cpu_feature(cpu_feature::invariant_tsc));
+#endif
+    std::cout << "  ✓ " << cal.ticks_per_ns << " ticks/ns"
+              << (cal.invariant ? "" : " (counter not invariant)") << "\n";
+}
+
+void test_reads() {
+    std::cout << "Testing counter reads...\n";
+
+    // Monotonic within a thread, for every read flavour
+    uint64_t last = cycle_clock::ticks();
+    for(int i = 0; i < 100000; ++i) {
+        uint64_t now = (i % 3 == 0) ? cycle_clock::ticks() : (i % 3 == 1) ? cycle_clock::ticks_begin()
+                                                                           : cycle_clock::ticks_end();
+        assert(now >= last);
+        last = now;
+    }
+
+    uint64_t begin = cycle_clock::ticks_begin();
+    uint64_t end   = cycle_clock::ticks_end();
+    assert(end >= begin);
+    std::cout << "  ✓ Non-decreasing\n";
+}
+
+void test_conversion() {
+    std::cout << "Testing tick conversion...\n";
+
+    // Sleeps measured by both clocks agree within 1%
+    auto     steady_start = std::chrono::steady_clock::now();
+    uint64_t start        = cycle_clock::ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t ticks     = cycle_clock::ticks() - start;
+    auto     steady_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - steady_start)
+                       .count();
+    double   cycle_ns  = static_cast<double>(cycle_clock::to_nanoseconds(ticks));
+    assert(std::fabs(cycle_ns - static_cast<double>(steady_ns)) / static_cast<double>(steady_ns) < 0.01);
+
+    // Round trip, and long intervals do not overflow the fixed-point multiply
+    uint64_t second = cycle_clock::from_nanoseconds(1000000000);
+    assert(std::llabs(static_cast<long long>(cycle_clock::to_nanoseconds(second)) - 1000000000) < 1000);
+    uint64_t year = cycle_clock::from_nanoseconds(365ull * 24 * 3600 * 1000000000);
+    double   back = static_cast<double>(cycle_clock::to_nanoseconds(year));
+    assert(std::fabs(back / (365.0 * 24 * 3600 * 1e9) - 1.0) < 1e-6);
+
+    // std::chrono clock interface
+    static_assert(cycle_clock::is_steady);
+    auto t0 = cycle_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto waited = std::chrono::duration_cast<std::chrono::microseconds>(cycle_clock::now() - t0);
+    assert(waited >= std::chrono::microseconds(1900));
+    std::cout << "  ✓ 20 ms sleep: " << cycle_ns / 1e6 << " ms by cycle_clock\n";
+}
+
+struct last_sample {
+    uint64_t value = 0;
+    int      calls = 0;
+
+    void record(uint64_t v) noexcept {
+        value = v;
+        ++calls;
+    }
+};
+
+void test_scoped_timer() {
+    std::cout << "Testing scoped_timer...\n";
+
+    last_sample sink;
+    {
+        scoped_timer timed(sink);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        assert(timed.elapsed_ns() >= 900000);
+    }
+    assert(sink.calls == 1);
+    assert(sink.value >= 900000 && sink.value < 1000000000);
+
+    asyncle::concurrent::sharded_histogram histogram(asyncle::concurrent::shard_by::thread, 2);
+    asyncle::concurrent::sharded_stat      stat(asyncle::concurrent::shard_by::thread, 2);
+    for(int i = 0; i < 100; ++i) {
+        scoped_timer a(histogram);
+        scoped_timer b(stat);
+    }
+    assert(histogram.snapshot().count == 100);
+    assert(stat.snapshot().count == 100);
+    assert(histogram.snapshot().percentile(0.5) < 1000000);
+    std::cout << "  ✓ Samples recorded into histogram and stat\n";
+}
+
+int main() {
+    std::cout << "Running hardware::clock tests...\n\n";
+
+    test_calibration();
+    test_reads();
+    test_conversion();
+    test_scoped_timer();
+
+    std::cout << "\nAll clock tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <asyncle/hardware/layout.hpp>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace asyncle::hardware;
+
+// Aligned allocators: alignment, rebinding, and use from std::vector
+void test_aligned_allocators() {
+    std::cout << "Testing aligned allocators...\n";
+
+    cache_aligned_vector<char> bytes;
+    for(int round = 0; round < 8; ++round) {
+        bytes.resize(bytes.size() * 2 + 3);
+        assert(is_cache_aligned(bytes.data()));
+    }
+    std::cout << "  ✓ cache_aligned_vector storage starts on a cache line at every size\n";
+
+    std::vector<double, aligned_allocator<double, 4096>> paged(100, 1.5);
+    assert(reinterpret_cast<uintptr_t>(paged.data()) % 4096 == 0);
+    using rebound = std::allocator_traits<aligned_allocator<char, 16>>::rebind_alloc<long double>;
+    static_assert(rebound::alignment >= alignof(long double));
+    static_assert(aligned_allocator<int>() == aligned_allocator<double>());
+    std::cout << "  ✓ Custom alignment and rebinding\n";
+
+    page_allocator<uint64_t> pages;
+    uint64_t*                block = pages.allocate(1000);
+    assert(reinterpret_cast<uintptr_t>(block) % 4096 == 0);
+    for(size_t i = 0; i < 1000; ++i) assert(block[i] == 0);  // Fresh mappings are zero filled
+    block[999] = 7;
+    assert(page_allocator<uint64_t>::mapped_bytes(1000) % 4096 == 0);
+    pages.deallocate(block, 1000);
+
+    // Large pages when granted, normal pages otherwise; the same length is unmapped either way
+    using large = page_allocator<float, platform::mmap::page_preference::prefer_large>;
+    std::vector<float, large> table(1 << 20, 2.0f);
+    assert(reinterpret_cast<uintptr_t>(table.data()) % 4096 == 0);
+    assert(std::accumulate(table.begin(), table.end(), 0.0) == 2.0 * (1 << 20));
+    assert(large::mapped_bytes(1) >= 4096);
+    std::cout << "  ✓ page_allocator maps " << large::mapped_bytes(1) << "-byte granules for large pages\n";
+}
+
+enum field : size_t { id, price, quantity, score };
+
+using table = soa_vector<int64_t, double, int32_t, float>;
+
+// Struct-of-arrays growth, element access and copies
+void test_soa_storage() {
+    std::cout << "Testing soa_vector storage...\n";
+
+    table rows;
+    assert(rows.empty() && rows.capacity() == 0);
+    for(int i = 0; i < 1000; ++i) rows.push_back(i, i * 0.5, i % 7, 0.0f);
+    assert(rows.size() == 1000 && rows.capacity() >= 1000);
+    assert(rows.get<id>(999) == 999 && rows.get<price>(10) == 5.0 && rows.get<quantity>(9) == 2);
+    assert(is_cache_aligned(rows.data<id>()) && is_cache_aligned(rows.data<score>()));
+    assert(rows.column<price>().size() == 1000);
+
+    auto [row_id, row_price, row_quantity, row_score] = rows.row(42);
+    assert(row_id == 42 && row_price == 21.0 && row_quantity == 0 && row_score == 0.0f);
+    row_score = 4.0f;
+    assert(rows.get<score>(42) == 4.0f);
+    rows.set(1, -1, -1.0, -1, -1.0f);
+    assert(rows.get<id>(1) == -1 && rows.get<score>(1) == -1.0f);
+
+    table copy = rows;
+    assert(copy.size() == 1000 && copy.data<price>() != rows.data<price>() && copy.get<score>(42) == 4.0f);
+    table moved = std::move(copy);
+    assert(moved.size() == 1000 && copy.size() == 0 && copy.capacity() == 0);
+
+    rows.resize(1200);
+    assert(rows.get<id>(1100) == 0 && rows.get<price>(1199) == 0.0);  // New rows are zero
+    rows.resize(10);
+    rows.shrink_to_fit();
+    assert(rows.capacity() == 10 && rows.get<id>(9) == 9);
+    rows.pop_back();
+    assert(rows.size() == 9);
+    rows.clear();
+    rows.shrink_to_fit();
+    assert(rows.empty() && rows.capacity() == 0);
+    std::cout << "  ✓ Push, resize, row access, copy, move and shrink\n";
+}
+
+// Zip iteration and for_each
+void test_soa_iteration() {
+    std::cout << "Testing soa_vector iteration...\n";
+
+    table rows(256);
+    for(size_t i = 0; i < rows.size(); ++i) {
+        rows.set(i, static_cast<int64_t>(i), 1.0 + i, static_cast<int32_t>(i % 4), 0.0f);
+    }
+
+    rows.for_each<price, quantity, score>([](double p, int32_t q, float& s) { s = static_cast<float>(p * q); });
+    assert(rows.get<score>(5) == 6.0f * 1 && rows.get<score>(7) == 8.0f * 3);
+
+    double total = 0;
+    for(auto [q, s] : rows.zip<quantity, score>()) total += q * s;
+    double expected = 0;
+    for(size_t i = 0; i < rows.size(); ++i) expected += (i % 4) * (1.0 + i) * (i % 4);
+    assert(total == expected);
+
+    // Writes through the zip references land in the columns
+    for(auto [p, s] : rows.zip<price, score>()) s = static_cast<float>(p);
+    assert(rows.get<score>(200) == 201.0f);
+
+    const table& view = rows;
+    auto         range = view.zip<id>();
+    assert(range.size() == 256 && std::get<0>(*(range.begin() + 17)) == 17);
+    assert(range.end() - range.begin() == 256 && range.begin() < range.end());
+    size_t seen = 0;
+    view.for_each<id>([&](int64_t v) { seen += static_cast<size_t>(v); });
+    assert(seen == 255 * 256 / 2);
+    std::cout << "  ✓ for_each and zip read and write the chosen columns\n";
+}
+
+int main() {
+    std::cout << "Running hardware::layout tests...\n\n";
+
+    test_aligned_allocators();
+    test_soa_storage();
+    test_soa_iteration();
+
+    std::cout << "\n✓ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <asyncle/hardware/prefetch.hpp>
+#include <cassert>
+#include <cstdint>
+#include <forward_list>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace asyncle::hardware;
+
+// Distance heuristic: a quarter of L1 in flight, clamped to [2, max_prefetch_distance]
+void test_distance() {
+    std::cout << "Testing prefetch distance tuning...\n";
+
+    cache_info cache;
+    cache.l1_line_size  = 64;
+    cache.l1_cache_size = 48 * 1024;
+    assert(prefetch_distance_for(64, cache) == max_prefetch_distance);
+    assert(prefetch_distance_for(1, cache) == max_prefetch_distance);
+
+    // Wide elements: 48K / 4 / 1K = 12
+    assert(prefetch_distance_for(1024, cache) == 12);
+    assert(prefetch_distance_for(1000, cache) == 12);  // Rounds up to whole lines
+
+    // Tiny L1 or huge elements never go below 2
+    assert(prefetch_distance_for(1 << 20, cache) == 2);
+    cache.l1_cache_size = 0;
+    assert(prefetch_distance_for(64, cache) == 2);
+
+    size_t d = prefetch_distance();
+    assert(d >= 2 && d <= max_prefetch_distance);
+    assert(prefetch_distance() == d);  // Cached
+    std::cout << "  ✓ Default distance " << d << " elements\n";
+}
+
+void test_for_each_prefetched() {
+    std::cout << "Testing for_each_prefetched...\n";
+
+    std::vector<uint64_t> table(1000);
+    std::iota(table.begin(), table.end(), 0);
+    std::vector<uint32_t> keys;
+    for(uint32_t i = 0; i < 300; ++i) keys.push_back((i * 7919) % 1000);
+
+    for(size_t distance : { 0, 1, 8, 299, 300, 1000 }) {
+        size_t                prefetches = 0;
+        std::vector<uint32_t> visited;
+        for_each_prefetched(
+          keys,
+          [&](uint32_t key) {
+              ++prefetches;
+              return &table[key];
+          },
+          [&](uint32_t key) { visited.push_back(key); }, distance);
+        assert(visited == keys);
+        assert(prefetches == (distance ? keys.size() : 0));  // Each element prefetched once
+    }
+
+    // Forward-only ranges and empty ranges
+    std::forward_list<int> list = { 5, 4, 3, 2, 1 };
+    int                    sum  = 0;
+    for_each_prefetched(list, [](int& v) { return &v; }, [&](int v) { sum += v; }, 2);
+    assert(sum == 15);
+    std::vector<int> empty;
+    for_each_prefetched(empty, [](int& v) { return &v; }, [](int) { assert(false); });
+    std::cout << "  ✓ Order preserved, one prefetch per element\n";
+}
+
+void test_gather() {
+    std::cout << "Testing prefetch_gather...\n";
+
+    struct row {
+        uint64_t id;
+        uint64_t amount;
+        char     payload[48];
+    };
+    std::vector<row> rows(512);
+    for(size_t i = 0; i < rows.size(); ++i) rows[i] = { i, i * 3, {} };
+
+    std::vector<uint32_t> ids;
+    for(uint32_t i = 0; i < 200; ++i) ids.push_back((i * 37) % 512);
+
+    uint64_t expected = 0;
+    for(uint32_t id : ids) expected += id * 3;
+
+    uint64_t total = 0;
+    size_t   next  = 0;
+    prefetch_gather(std::span<const uint32_t>(ids), rows.data(), [&](row& r, size_t i) {
+        assert(i == next++);
+        assert(r.id == ids[i]);
+        total += r.amount;
+    });
+    assert(total == expected && next == ids.size());
+
+    // Explicit byte stride: the amount fields viewed as a strided column
+    const uint64_t* column = &rows[0].amount;
+    total                  = 0;
+    prefetch_gather(
+      std::span<const uint32_t>(ids), column, [&](const uint64_t& amount, size_t) { total += amount; }, sizeof(row),
+      4);
+    assert(total == expected);
+    std::cout << "  ✓ Gathered " << ids.size() << " rows\n";
+}
+
+void test_view() {
+    std::cout << "Testing prefetched view...\n";
+
+    struct node {
+        int value;
+    };
+    std::vector<node>  nodes = { { 1 }, { 2 }, { 3 }, { 4 } };
+    std::vector<node*> refs;
+    for(auto& n : nodes) refs.push_back(&n);
+
+    int    sum        = 0;
+    size_t prefetches = 0;
+    for(node* n : prefetched(refs, [&](node* p) {
+            ++prefetches;
+            return p;
+        })) {
+        sum += n->value;
+    }
+    assert(sum == 10);
+    assert(prefetches == refs.size());
+
+    // Elements are references into the underlying range
+    for(node*& n : prefetched(refs, [](node* p) { return p; }, 1)) n = nullptr;
+    for(node* n : refs) assert(n == nullptr);
+    std::cout << "  ✓ Iterates the underlying range\n";
+}
+
+int main() {
+    std::cout << "Running hardware::prefetch tests...\n\n";
+
+    test_distance();
+    test_for_each_prefetched();
+    test_gather();
+    test_view();
+
+    std::cout << "\nAll prefetch tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <asyncle/hardware/memory.hpp>
+#include <asyncle/hardware/topology.hpp>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace asyncle::hardware;
+
+// Test the raw platform detection
+void test_platform_detection() {
+    std::cout << "Testing platform topology detection...\n";
+
+    size_t total = detect_cpu_topology(nullptr, 0);
+    assert(total > 0);
+    std::vector<cpu_location> cpus(total);
+    assert(detect_cpu_topology(cpus.data(), cpus.size()) == total);
+
+    // Ascending CPU numbers, SMT index 0 present on every core
+    std::set<uint32_t> cores_with_primary;
+    for(size_t i = 0; i < cpus.size(); ++i) {
+        if(i > 0) assert(cpus[i].cpu > cpus[i - 1].cpu);
+        if(cpus[i].smt_index == 0) cores_with_primary.insert(cpus[i].core);
+    }
+    for(const auto& loc : cpus) assert(cores_with_primary.count(loc.core) == 1);
+
+    // The affinity mask and the topology agree on the allowed CPUs
+    std::vector<size_t> allowed(1024);
+    size_t              allowed_count = platform::hardware::available_cpus(allowed.data(), allowed.size());
+    size_t              marked        = 0;
+    for(const auto& loc : cpus) marked += loc.allowed;
+    assert(marked == std::min(allowed_count, allowed.size()));
+
+    size_t nodes = detect_numa_nodes(nullptr, 0);
+    assert(nodes > 0);
+    std::vector<numa_node_info> node_info(nodes);
+    detect_numa_nodes(node_info.data(), nodes);
+    assert(numa_distance(node_info[0].node, node_info[0].node) == 10);
+    std::cout << "  ✓ " << total << " CPUs on " << nodes << " node(s)\n";
+}
+
+// Test the cached snapshot and its queries
+void test_topology_queries() {
+    std::cout << "Testing cpu_topology queries...\n";
+
+    const cpu_topology& topo = cpu_topology::current();
+    assert(&topo == &cpu_topology::current());
+    assert(topo.cpu_count() > 0 && topo.core_count() > 0 && topo.package_count() > 0);
+    assert(topo.core_count() <= topo.cpu_count());
+
+    std::cout << "  Packages: " << topo.package_count() << ", cores: " << topo.core_count()
+              << ", CPUs: " << topo.cpu_count() << ", nodes: " << topo.node_count() << "\n";
+    for(const auto& node : topo.nodes()) {
+        std::cout << "    node " << node.node << ": " << node.cpu_count << " CPUs, " << (node.total_memory >> 20)
+                  << " MiB (" << (node.free_memory >> 20) << " MiB free)\n";
+    }
+
+    // Every CPU belongs to exactly one node and its own sharing groups
+    size_t on_nodes = 0;
+    for(uint32_t node : topo.node_ids()) {
+        on_nodes += topo.cpus_on_node(node, false).size();
+        assert(topo.distance(node, node) == 10);
+    }
+    assert(on_nodes == topo.cpu_count());
+
+    for(const auto& loc : topo.cpus()) {
+        assert(topo.find(loc.cpu) == &loc);
+        assert(topo.node_of(loc.cpu) == loc.node);
+        auto siblings = topo.smt_siblings(loc.cpu);
+        auto l2       = topo.sharing_l2(loc.cpu);
+        auto l3       = topo.sharing_l3(loc.cpu);
+        assert(std::find(siblings.begin(), siblings.end(), loc.cpu) != siblings.end());
+        assert(std::find(l2.begin(), l2.end(), loc.cpu) != l2.end());
+        assert(std::find(l3.begin(), l3.end(), loc.cpu) != l3.end());
+    }
+    assert(topo.find(1u << 30) == nullptr);
+
+    const cpu_location& first = topo.cpus()[0];
+    std::cout << "  cpu" << first.cpu << ": core " << first.core << ", package " << first.package << ", L2 "
+              << first.l2_kib << " KiB shared by " << topo.sharing_l2(first.cpu).size() << ", L3 "
+              << first.l3_kib << " KiB shared by " << topo.sharing_l3(first.cpu).size() << "\n";
+    std::cout << "  ✓ Node, core and cache sharing queries are consistent\n";
+}
+
+// Test worker placement order
+void test_placement_order() {
+    std::cout << "Testing placement order...\n";
+
+    const cpu_topology& topo  = cpu_topology::current();
+    auto                order = topo.placement_order();
+
+    size_t allowed = 0;
+    for(const auto& loc : topo.cpus()) allowed += loc.allowed;
+    assert(order.size() == allowed);
+
+    // Within a node no SMT sibling precedes a first hardware thread
+    for(size_t i = 1; i < order.size(); ++i) {
+        const cpu_location* prev = topo.find(order[i - 1]);
+        const cpu_location* next = topo.find(order[i]);
+        assert(prev->node <= next->node);
+        if(prev->node == next->node) assert(prev->smt_index <= next->smt_index);
+    }
+    std::cout << "  ✓ Physical cores first, node by node\n";
+}
+
+int main() {
+    std::cout << "Running hardware::topology tests...\n\n";
+
+    test_platform_detection();
+    test_topology_queries();
+    test_placement_order();
+
+    std::cout << "\nAll topology tests passed!\n";
+    return 0;
+}
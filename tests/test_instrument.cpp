@@ -0,0 +1,164 @@
+// Built twice: with ASYNCLE_ENABLE_INSTRUMENTATION (hooks record) and without
+// (hooks compile away and every snapshot stays empty)
+#include <asyncle/format/json.hpp>
+#include <asyncle/format/serialize.hpp>
+#include <asyncle/instrument.hpp>
+#include <asyncle/io/file.hpp>
+#include <asyncle/io/mmap.hpp>
+#include <asyncle/io/process.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+namespace io         = asyncle::io;
+namespace instrument = asyncle::instrument;
+
+// Disabled hooks leave nothing behind in the caller's frame
+static_assert(std::is_empty_v<instrument::scope> == !instrument::enabled);
+
+namespace sample {
+
+struct point {
+    int x = 0;
+    int y = 0;
+};
+
+// ADL-found JSON implementation so the test does not depend on Glaze
+inline auto save_impl(point const& p, ::format::serialize::json_tag) -> ::format::serialize::result<std::string> {
+    return ::format::serialize::result<std::string>(
+      "{\"x\":" + std::to_string(p.x) + ",\"y\":" + std::to_string(p.y) + "}");
+}
+
+}  // namespace sample
+
+// load_impl<T> is found through the tag's namespace only
+namespace format::serialize {
+
+template <typename T>
+requires std::same_as<T, sample::point>
+auto load_impl(std::string_view data, json_tag) -> result<T> {
+    if(data.empty()) return result<T>(unexpect, error::invalid_syntax);
+    return result<T>(T { 1, 2 });
+}
+
+}  // namespace format::serialize
+
+// Run one of each instrumented operation
+void exercise() {
+    char block[4096];
+    std::memset(block, 'x', sizeof(block));
+
+    io::file tmp;
+    assert(tmp.create_temp());
+    for(int i = 0; i < 3; ++i) assert(tmp.write(block, sizeof(block), static_cast<uint64_t>(i) * sizeof(block)));
+    assert(tmp.read(block, sizeof(block), 0).value() == sizeof(block));
+
+    // Writing through a read-only descriptor fails inside the platform call
+    io::file read_only("/proc/self/exe");
+    assert(read_only.is_open());
+    assert(!read_only.write(block, sizeof(block), 0));
+
+    io::mmap region(1 << 20);
+    assert(region.is_mapped());
+    assert(region.prefetch());
+
+    const char* args[] = { "/bin/true", nullptr };
+    io::process child("/bin/true", args, io::pipe_mode::none, io::pipe_mode::none, io::pipe_mode::none);
+    assert(child.is_running());
+    assert(child.wait().value() == 0);
+
+    auto json = asyncle::format::to_json(sample::point { 3, 4 });
+    assert(json.has_value() && *json == "{\"x\":3,\"y\":4}");
+    assert(asyncle::format::from_json<sample::point>(*json).has_value());
+    assert(!asyncle::format::from_json<sample::point>("").has_value());
+
+    std::string out;
+    assert(asyncle::format::to_json_into(sample::point { 5, 6 }, out).value() == out.size());
+
+    auto doc = asyncle::format::json::parse(std::string_view(*json));
+    (void)doc;
+}
+
+void test_enabled() {
+    std::cout << "Testing instrumented operations...\n";
+
+    instrument::reset();
+    exercise();
+
+    auto writes = instrument::snapshot(instrument::op::file_write);
+    assert(writes.name == "file.write");
+    assert(writes.calls == 4);
+    assert(writes.errors == 1);
+    assert(writes.bytes == 3 * 4096);
+    assert(writes.latency.count == 4);
+    assert(writes.latency.percentile(1.0) >= writes.latency.percentile(0.5));
+    assert(writes.latency.max() > 0);
+
+    auto reads = instrument::snapshot(instrument::op::file_read);
+    assert(reads.calls == 1 && reads.errors == 0 && reads.bytes == 4096);
+
+    auto maps = instrument::snapshot(instrument::op::mmap_map);
+    assert(maps.calls == 1 && maps.bytes == (1 << 20));
+
+    auto faults = instrument::snapshot(instrument::op::mmap_fault);
+    assert(faults.calls == 1 && faults.bytes == (1 << 20));
+
+    auto spawns = instrument::snapshot(instrument::op::process_spawn);
+    assert(spawns.calls == 1 && spawns.errors == 0 && spawns.bytes == 0);
+
+    // to_json and to_json_into serialize; from_json twice (one failure) and parse() parse
+    auto serialized = instrument::snapshot(instrument::op::json_serialize);
+    assert(serialized.calls == 2);
+    assert(serialized.bytes == 2 * std::strlen("{\"x\":3,\"y\":4}"));
+
+    auto parsed = instrument::snapshot(instrument::op::json_parse);
+    assert(parsed.calls == 3);
+    assert(parsed.errors == 1);
+    assert(parsed.bytes == 2 * std::strlen("{\"x\":3,\"y\":4}"));
+
+    // Early returns before the platform call are not operations
+    io::file closed;
+    assert(!closed.read(nullptr, 0));
+    assert(instrument::snapshot(instrument::op::file_read).calls == 1);
+
+    std::string text = instrument::report();
+    assert(text.find("file.write") != std::string::npos);
+    assert(text.find("process.spawn") != std::string::npos);
+    assert(text.find("page.faults") != std::string::npos);
+
+    instrument::reset();
+    for(const auto& s : instrument::snapshot_all()) assert(s.calls == 0 && s.bytes == 0 && s.errors == 0);
+
+    std::cout << "  ✓ Counts, bytes, errors and latencies recorded\n";
+}
+
+void test_disabled() {
+    std::cout << "Testing disabled instrumentation...\n";
+
+    exercise();
+    for(const auto& s : instrument::snapshot_all()) {
+        assert(s.calls == 0 && s.bytes == 0 && s.errors == 0);
+        assert(s.latency.counts.empty());
+    }
+    assert(instrument::report().find("file.write") == std::string::npos);
+    std::cout << "  ✓ Hooks compiled out\n";
+}
+
+int main() {
+    std::cout << "Running instrument tests (" << (instrument::enabled ? "enabled" : "disabled") << ")...\n\n";
+
+    if constexpr(instrument::enabled) {
+        test_enabled();
+    } else {
+        test_disabled();
+    }
+
+    // Process-wide faults are reported either way
+    assert(instrument::page_faults().minor > 0);
+
+    std::cout << "\nAll instrument tests passed!\n";
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <cstdio>
+#include <climits>
 #include <cstring>
 #include <iostream>
 #include <platform/file.hpp>
@@ -252,6 +253,77 @@ int main() {
                 std::cout << "Vectored write failed: " << error_to_string(writev_result.error().code) << "\n";
             }
 
+            // Positional scatter read honoring per-request offsets (no shared file position)
+            char       part_a[6] = {}, part_b[5] = {};
+            io_request scatter[2];
+            scatter[0].buffer = part_b;
+            scatter[0].length = 5;
+            scatter[0].offset = 13;  // "Third"
+            scatter[1].buffer = part_a;
+            scatter[1].length = 6;
+            scatter[1].offset = 6;  // "Second"
+            auto seek_before  = seek_file(handle, 2, seek_origin::begin);
+            assert(seek_before);
+            auto scatter_result = read_vectored(handle, scatter, 2);
+            assert(scatter_result && scatter_result.value().bytes_transferred == 11);
+            assert(scatter_result.value().new_offset == 12);
+            assert(std::memcmp(part_b, "Third", 5) == 0 && std::memcmp(part_a, "Second", 6) == 0);
+            assert(tell_file(handle).value() == 2);
+            std::cout << "Positional vectored read: " << scatter_result.value().bytes_transferred << " bytes\n";
+
+            // More than IOV_MAX contiguous requests are chunked instead of rejected
+            const size_t            many = IOV_MAX + 10;
+            std::vector<char>       bytes(many);
+            std::vector<io_request> gather(many);
+            for(size_t i = 0; i < many; ++i) {
+                bytes[i]         = static_cast<char>('A' + i % 26);
+                gather[i].buffer = &bytes[i];
+                gather[i].length = 1;
+                gather[i].offset = 100 + i;
+            }
+            auto many_result = write_vectored(handle, gather.data(), many);
+            assert(many_result && many_result.value().bytes_transferred == many);
+            assert(many_result.value().new_offset == 100 + many);
+
+            std::vector<char> check(many, 0);
+            for(size_t i = 0; i < many; ++i) { gather[i].buffer = &check[i]; }
+            auto many_read = read_vectored(handle, gather.data(), many);
+            assert(many_read && many_read.value().bytes_transferred == many);
+            assert(check == bytes);
+
+            // An error after progress returns the bytes so far; resubmitting the rest reports it
+            file_handle pipe_read, pipe_write;
+            assert(create_pipe(pipe_read, pipe_write));
+            char       pipe_bytes[8] = {};
+            io_request pipe_reqs[2];
+            pipe_reqs[0].buffer = const_cast<char*>("pipe");
+            pipe_reqs[0].length = 4;
+            pipe_reqs[1]        = pipe_reqs[0];
+            pipe_reqs[1].offset = 0;  // Positional on a pipe: ESPIPE
+            auto partial        = write_vectored(pipe_write, pipe_reqs, 2);
+            assert(partial && partial.value().bytes_transferred == 4);
+            assert(!write_vectored(pipe_write, pipe_reqs + 1, 1));
+            pipe_reqs[0].buffer = pipe_bytes;
+            assert(read_vectored(pipe_read, pipe_reqs, 1).value().bytes_transferred == 4);
+            assert(std::memcmp(pipe_bytes, "pipe", 4) == 0);
+            close_file(pipe_read);
+            close_file(pipe_write);
+
+#ifdef RWF_DSYNC
+            // RWF_* flags pass through io_request::flags (preadv2/pwritev2)
+            io_request dsync_req;
+            dsync_req.buffer = const_cast<char*>("sync");
+            dsync_req.length = 4;
+            dsync_req.offset = 50;
+            dsync_req.flags  = RWF_DSYNC;
+            auto dsync_write = write_vectored(handle, &dsync_req, 1);
+            if(dsync_write) {
+                assert(dsync_write.value().bytes_transferred == 4);
+            } else {
+                std::cout << "RWF_DSYNC write: " << error_to_string(dsync_write.error().code) << "\n";
+            }
+#endif
+
             close_file(handle);
             std::remove(vec_filename);
         }
@@ -354,6 +426,142 @@ int main() {
         }
     }
 
+    // Test asynchronous I/O ring (if supported)
+    if(caps.supports_async_io) {
+        std::cout << "\nTesting asynchronous I/O ring...\n";
+        assert(sizeof(ring_request) == 16);
+        assert(sizeof(ring_handle) == 16);
+        assert(sizeof(io_completion) == 32);
+
+        auto ring_result = create_ring(ring_request(8));
+        assert(ring_result);
+        ring_handle ring = ring_result.value();
+        assert(ring.is_valid());
+        std::cout << "Ring created: entries=" << ring.entries << ", cq_entries=" << ring.cq_entries << "\n";
+
+        auto temp_result = create_temp(nullptr, file_request {});
+        assert(temp_result);
+        file_handle handle = temp_result.value();
+
+        // Batch of positional writes submitted with a single call
+        char        blocks[4][16];
+        io_request  writes[4];
+        for(int i = 0; i < 4; ++i) {
+            std::memset(blocks[i], 'a' + i, sizeof(blocks[i]));
+            writes[i].buffer = blocks[i];
+            writes[i].length = sizeof(blocks[i]);
+            writes[i].offset = static_cast<uint64_t>(i) * sizeof(blocks[i]);
+        }
+
+        auto queued = queue_ring(ring, handle, ring_op::write, writes, 4, 100);
+        assert(queued && queued.value() == 4);
+        assert(query_ring(ring).queued == 4);
+
+        auto submitted = submit_ring(ring);
+        assert(submitted && submitted.value() == 4);
+        assert(query_ring(ring).queued == 0);
+        assert(query_ring(ring).in_flight == 4);
+
+        io_completion completions[8];
+        auto          reaped = reap_ring(ring, completions, 8, 4);
+        assert(reaped && reaped.value() == 4);
+        for(size_t i = 0; i < reaped.value(); ++i) {
+            assert(completions[i].error.code == error_code::success);
+            assert(completions[i].user_data >= 100 && completions[i].user_data < 104);
+            uint64_t index = completions[i].user_data - 100;
+            assert(completions[i].result.bytes_transferred == 16);
+            assert(completions[i].result.new_offset == (index + 1) * 16);
+        }
+        assert(query_ring(ring).in_flight == 0);
+        std::cout << "Ring batch write: " << reaped.value() << " completions\n";
+
+        // Read back in reverse order, plus a sync, reaped in one blocking call
+        char       readback[4][16] = {};
+        io_request reads[4];
+        for(int i = 0; i < 4; ++i) {
+            reads[i].buffer = readback[i];
+            reads[i].length = sizeof(readback[i]);
+            reads[i].offset = static_cast<uint64_t>(3 - i) * sizeof(readback[i]);
+        }
+        assert(queue_ring(ring, handle, ring_op::read, reads, 4, 0).value() == 4);
+        io_request sync_req;
+        sync_req.flags = static_cast<uint32_t>(sync_flags::full_sync);
+        assert(queue_ring(ring, handle, ring_op::sync, &sync_req, 1, 42).value() == 1);
+
+        auto waited = submit_ring(ring, 5);
+        assert(waited && waited.value() == 5);
+        reaped = reap_ring(ring, completions, 8);
+        assert(reaped && reaped.value() == 5);
+        for(int i = 0; i < 4; ++i) { assert(readback[i][0] == 'a' + (3 - i) && readback[i][15] == 'a' + (3 - i)); }
+        std::cout << "Ring batch read + sync: " << reaped.value() << " completions\n";
+
+        // Errors are reported per completion, not per submission
+        file_handle bad;
+        bad.fd = 12345;
+        char       scratch[8];
+        io_request bad_req;
+        bad_req.buffer = scratch;
+        bad_req.length = sizeof(scratch);
+        bad_req.offset = 0;
+        assert(queue_ring(ring, bad, ring_op::read, &bad_req, 1, 7).value() == 1);
+        assert(submit_ring(ring, 1));
+        reaped = reap_ring(ring, completions, 1);
+        assert(reaped && reaped.value() == 1);
+        assert(completions[0].user_data == 7);
+        assert(completions[0].error.code != error_code::success);
+
+        // A length past the 32-bit SQE field is refused, and nothing is queued
+        io_request huge[2] = { bad_req, bad_req };
+        huge[1].length     = (size_t { 1 } << 32) + 8;
+        auto refused       = queue_ring(ring, handle, ring_op::read, huge, 2, 0);
+        assert(!refused && refused.error().code == error_code::invalid_argument);
+        assert(query_ring(ring).queued == 0);
+
+        // Queue stops short once the in-flight budget is exhausted
+        std::vector<io_request> nops(ring.cq_entries + 4);
+        auto                    partial = queue_ring(ring, handle, ring_op::nop, nops.data(), nops.size(), 0);
+        assert(partial && partial.value() <= ring.entries);
+        assert(submit_ring(ring, partial.value()));
+        std::vector<io_completion> drained(partial.value());
+        assert(reap_ring(ring, drained.data(), drained.size(), drained.size()).value() == partial.value());
+
+        // Fixed buffers: register one buffer and read into it by index
+        char        fixed[16] = {};
+        ring_buffer registered(fixed, sizeof(fixed));
+        auto        reg = register_ring_buffers(ring, &registered, 1);
+        assert(reg);
+        io_request fixed_req;
+        fixed_req.buffer       = fixed;
+        fixed_req.length       = sizeof(fixed);
+        fixed_req.offset       = 16;
+        fixed_req.buffer_index = 0;
+        assert(queue_ring(ring, handle, ring_op::read_fixed, &fixed_req, 1, 9).value() == 1);
+        assert(submit_ring(ring, 1));
+        reaped = reap_ring(ring, completions, 1);
+        assert(reaped && completions[0].result.bytes_transferred == 16 && fixed[0] == 'b');
+        assert(unregister_ring_buffers(ring));
+
+        // Cancelling a request that is not in flight completes with ENOENT
+        io_request cancel_req;
+        cancel_req.offset = 12345;
+        assert(queue_ring(ring, handle, ring_op::cancel, &cancel_req, 1, 11).value() == 1);
+        assert(submit_ring(ring, 1));
+        reaped = reap_ring(ring, completions, 1);
+        assert(reaped && completions[0].user_data == 11);
+        assert(completions[0].error.code == error_code::file_not_found);
+
+        // Direct I/O alignment is always reported (page size as the fallback)
+        auto alignment = query_dio_alignment(handle);
+        assert(alignment && alignment.value().offset_align > 0 && alignment.value().memory_align > 0);
+        std::cout << "Direct I/O alignment: memory=" << alignment.value().memory_align
+                  << ", offset=" << alignment.value().offset_align << "\n";
+
+        close_file(handle);
+        destroy_ring(ring);
+        assert(!ring.is_valid());
+        std::cout << "Ring destroyed\n";
+    }
+
     std::cout << "\nAll cross-platform file tests completed!\n";
     return 0;
 }
@@ -229,6 +229,7 @@ int main() {
             case page_preference::system_default: std::cout << "system default\n"; break;
             case page_preference::prefer_large  : std::cout << "large pages (preferred)\n"; break;
             case page_preference::require_large : std::cout << "large pages (required)\n"; break;
+            case page_preference::transparent_large: std::cout << "transparent large pages\n"; break;
             }
 
             unmap_memory(region);
@@ -237,6 +238,115 @@ int main() {
         }
     }
 
+    // Tiered large pages: explicit HugeTLB, then THP, then normal pages
+    std::cout << "\nTesting tiered large page fallback...\n";
+    {
+        memory_request request;
+        request.length    = 3 * 1024 * 1024;
+        request.backing   = backing_type::anonymous;
+        request.access    = access_mode::read_write;
+        request.sharing   = sharing_mode::private_cow;
+        request.page_pref = page_preference::prefer_large;
+
+        // prefer_large never fails just because no huge pages are reserved
+        auto result = map_memory(-1, request);
+        assert(result);
+        const auto& region = *result;
+        assert(region.length >= request.length);
+        std::memset(region.address, 0x5a, request.length);
+        switch(region.actual_pages) {
+        case page_preference::require_large:
+            assert(region.actual_page_size > caps.system_page_size);
+            assert(reinterpret_cast<uintptr_t>(region.address) % region.actual_page_size == 0);
+            std::cout << "Tier: explicit large pages (" << region.actual_page_size << " bytes)\n";
+            break;
+        case page_preference::transparent_large:
+            assert(caps.supports_transparent_pages);
+            assert(reinterpret_cast<uintptr_t>(region.address) % region.actual_page_size == 0);
+            assert(region.length % region.actual_page_size == 0);
+            std::cout << "Tier: transparent large pages (" << region.actual_page_size << " bytes)\n";
+            break;
+        default:
+            assert(region.actual_page_size == caps.system_page_size);
+            std::cout << "Tier: normal pages\n";
+            break;
+        }
+        unmap_memory(region);
+
+        // transparent_large skips HugeTLB entirely
+        request.page_pref = page_preference::transparent_large;
+        auto thp          = map_memory(-1, request);
+        assert(thp);
+        assert(thp->actual_pages != page_preference::require_large);
+        if(caps.supports_transparent_pages) { assert(thp->actual_pages == page_preference::transparent_large); }
+        unmap_memory(*thp);
+
+        // require_large reports large_pages_unavailable instead of silently degrading
+        request.page_pref = page_preference::require_large;
+        auto strict       = map_memory(-1, request);
+        if(strict) {
+            assert(strict->actual_pages == page_preference::require_large);
+            unmap_memory(*strict);
+        } else {
+            assert(strict.error().code == error_code::large_pages_unavailable);
+            std::cout << "require_large unavailable (no reserved huge pages)\n";
+        }
+    }
+
+    // NUMA placement is applied before prefault and reported back
+    std::cout << "\nTesting NUMA placement policy...\n";
+    {
+        memory_request request;
+        request.length   = 4 * 1024 * 1024;
+        request.access   = access_mode::read_write;
+        request.backing  = backing_type::anonymous;
+        request.populate = populate_strategy::prefault;
+
+        // No policy: nothing reported
+        auto plain = map_memory(-1, request);
+        assert(plain);
+        assert(plain->actual_numa == numa_policy::default_policy);
+        assert(plain->actual_nodes == 0);
+        unmap_memory(*plain);
+
+        // A policy that needs nodes rejects an empty mask without touching the kernel
+        request.numa       = numa_policy::bind;
+        request.numa_nodes = 0;
+        auto empty         = map_memory(-1, request);
+        assert(!empty);
+        assert(empty.error().code == error_code::invalid_argument);
+
+        if(!caps.supports_numa_policy) {
+            std::cout << "NUMA policy unavailable (no mbind support)\n";
+        } else {
+            // Node 0 always exists
+            for(numa_policy policy : { numa_policy::bind, numa_policy::preferred, numa_policy::interleave }) {
+                request.numa       = policy;
+                request.numa_nodes = 1;
+                auto placed        = map_memory(-1, request);
+                assert(placed);
+                assert(placed->actual_numa == policy);
+                assert(placed->actual_nodes == 1);
+                static_cast<volatile char*>(placed->address)[request.length - 1] = 1;
+                unmap_memory(*placed);
+            }
+
+            request.numa       = numa_policy::local;
+            request.numa_nodes = 0;
+            auto local         = map_memory(-1, request);
+            assert(local);
+            assert(local->actual_numa == numa_policy::local);
+            unmap_memory(*local);
+
+            // A node that does not exist fails the mapping
+            request.numa       = numa_policy::bind;
+            request.numa_nodes = uint64_t(1) << 63;
+            auto missing       = map_memory(-1, request);
+            assert(!missing);
+            std::cout << "bind/preferred/interleave/local on node 0 OK\n";
+        }
+    }
+
     std::cout << "\nAll cross-platform mmap tests completed!\n";
     return 0;
 }
@@ -1,8 +1,16 @@
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <asyncle/io/process_pool.hpp>
+#include <asyncle/io/process_reactor.hpp>
+#include <asyncle/io/shm_ring.hpp>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <platform/process.hpp>
 #include <string>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 using namespace platform::process;
@@ -29,7 +37,59 @@ const char* error_to_string(error_code code) {
     }
 }
 
-int main() {
+// Worker loop for the process pool test (this binary run with --pool-worker):
+// answers each frame with its bytes upper-cased, prefixed by the worker's pid.
+// "crash" exits without answering, "sleep" stalls past the pool's timeout.
+int run_pool_worker() {
+    std::vector<std::byte> request;
+    while(asyncle::io::read_frame(request)) {
+        std::string text(reinterpret_cast<const char*>(request.data()), request.size());
+        if(text == "crash") _exit(3);
+        if(text == "sleep") sleep(5);
+        std::string reply = std::to_string(getpid()) + ":";
+        for(char c : text) reply += static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        if(!asyncle::io::write_frame(std::as_bytes(std::span<const char>(reply.data(), reply.size())))) return 1;
+    }
+    return 0;
+}
+
+// True when a shm_ring wait succeeded and the ring is ready
+bool ring_ready(const asyncle::io::mmap_result<bool>& r) { return r && *r; }
+
+// Worker for the shared-memory ring test (--shm-worker <request fd> <reply fd>):
+// replies to each message with its bytes upper-cased until the request ring closes
+int run_shm_worker(int request_fd, int reply_fd) {
+    asyncle::io::shm_ring requests, replies;
+    if(!requests.attach(request_fd) || !replies.attach(reply_fd)) return 2;
+    while(ring_ready(requests.wait_readable())) {
+        auto message = requests.peek();
+        auto out     = replies.prepare(message.size());
+        if(!out.data()) {
+            if(!ring_ready(replies.wait_writable(message.size()))) return 3;
+            out = replies.prepare(message.size());
+        }
+        for(size_t i = 0; i < message.size(); ++i) {
+            auto c = static_cast<char>(message[i]);
+            out[i] = static_cast<std::byte>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        }
+        replies.commit(message.size());
+        requests.release();
+    }
+    replies.close_writing();
+    return 0;
+}
+
+// Split a pool worker reply into pid and payload
+std::pair<std::string, std::string> split_reply(const std::string& reply) {
+    auto colon = reply.find(':');
+    assert(colon != std::string::npos);
+    return { reply.substr(0, colon), reply.substr(colon + 1) };
+}
+
+int main(int argc, char** argv) {
+    if(argc > 1 && std::strcmp(argv[1], "--pool-worker") == 0) return run_pool_worker();
+    if(argc > 3 && std::strcmp(argv[1], "--shm-worker") == 0) return run_shm_worker(atoi(argv[2]), atoi(argv[3]));
+
     std::cout << "Testing cross-platform process module...\n\n";
 
     // Query capabilities
@@ -290,6 +350,354 @@ int main() {
         close_pipe(stdout_pipe);
     }
 
+    // Test 5: PATH search and exec failure reporting
+    std::cout << "Test 5: PATH search and exec failures\n";
+    {
+        const char* args[] = { "true", nullptr };
+
+        spawn_request req {};
+        req.executable = "true";
+        req.args       = args;
+        req.flags      = spawn_flags::search_path;
+
+        auto result = spawn_process(req, nullptr, nullptr, nullptr);
+        if(!result) {
+            std::cout << "  FAILED: PATH search - " << error_to_string(result.error().code) << "\n\n";
+            return 1;
+        }
+        auto handle = result.value();
+        auto status = wait_process(handle, false);
+        assert(status && status.value() == 0);
+
+        // posix_spawn reports a missing executable to the caller
+        const char* missing_args[] = { "/nonexistent/asyncle-helper", nullptr };
+        req.executable             = missing_args[0];
+        req.args                   = missing_args;
+        req.flags                  = spawn_flags::none;
+        auto missing               = spawn_process(req, nullptr, nullptr, nullptr);
+        assert(!missing && missing.error().code == error_code::not_found);
+
+        // fork()+exec reports it as the child exiting with 127
+        req.flags   = spawn_flags::use_fork;
+        auto forked = spawn_process(req, nullptr, nullptr, nullptr);
+        assert(forked);
+        auto forked_handle = forked.value();
+        auto forked_status = wait_process(forked_handle, false);
+        assert(forked_status && forked_status.value() == 127);
+
+        std::cout << "  PASSED\n\n";
+    }
+
+    // Test 6: Same redirections, working directory and process group on both spawn paths
+    std::cout << "Test 6: posix_spawn and fork paths\n";
+    {
+        const char* args[] = { "/bin/sh", "-c", "pwd; echo err >&2", nullptr };
+
+        for(spawn_flags path : { spawn_flags::none, spawn_flags::use_fork }) {
+            spawn_request req {};
+            req.executable  = "/bin/sh";
+            req.args        = args;
+            req.working_dir = "/tmp";
+            req.stdin_mode  = pipe_mode::none;
+            req.stdout_mode = pipe_mode::pipe;
+            req.stderr_mode = pipe_mode::pipe;
+            req.flags = static_cast<spawn_flags>(static_cast<uint32_t>(path)
+                                                 | static_cast<uint32_t>(spawn_flags::new_process_group));
+
+            pipe_handle stdin_pipe, stdout_pipe, stderr_pipe;
+            auto        result = spawn_process(req, &stdin_pipe, &stdout_pipe, &stderr_pipe);
+            if(!result) {
+                std::cout << "  FAILED: Could not spawn process\n\n";
+                return 1;
+            }
+            auto handle = result.value();
+            assert(!stdin_pipe.is_valid() && stdout_pipe.is_valid() && stderr_pipe.is_valid());
+
+            // The child leads its own process group (readable until it is reaped)
+            assert(getpgid(handle.pid) == handle.pid);
+
+            auto status = wait_process(handle, false);
+            assert(status && status.value() == 0);
+
+            char       out[256] = {};
+            char       err[64]  = {};
+            io_request out_req {};
+            out_req.buffer = out;
+            out_req.length = sizeof(out) - 1;
+            io_request err_req {};
+            err_req.buffer = err;
+            err_req.length = sizeof(err) - 1;
+            auto out_read  = read_pipe(stdout_pipe, out_req);
+            auto err_read  = read_pipe(stderr_pipe, err_req);
+            assert(out_read && strstr(out, "/tmp"));
+            assert(err_read && strstr(err, "err"));
+
+            close_pipe(stdout_pipe);
+            close_pipe(stderr_pipe);
+        }
+        std::cout << "  PASSED\n\n";
+    }
+
+    // Test 7: One reactor supervising several children
+    std::cout << "Test 7: Process reactor\n";
+    if(!query_process_caps().supports_exit_handles) {
+        std::cout << "  SKIPPED: no pidfd support\n\n";
+    } else {
+        using asyncle::io::process_event;
+        using asyncle::io::process_reactor;
+        using asyncle::io::process_ready;
+
+        constexpr int            children = 8;
+        std::vector<std::string> codes;
+        for(int i = 0; i < children; ++i) codes.push_back(std::to_string(i));
+
+        std::vector<asyncle::io::process> procs;
+        process_reactor                   reactor(children);
+        assert(reactor.is_open());
+        for(int i = 0; i < children; ++i) {
+            const char* args[] = { "sh", "-c", "echo out-$0; echo err-$0 >&2; exit $0", codes[i].c_str(), nullptr };
+            procs.emplace_back("/bin/sh", args, pipe_mode::none, pipe_mode::pipe, pipe_mode::pipe);
+            assert(procs.back());
+        }
+        std::vector<uint32_t> ids;
+        for(int i = 0; i < children; ++i) {
+            auto id = reactor.watch(procs[i], static_cast<uint64_t>(i));
+            assert(id);
+            ids.push_back(id.value());
+        }
+        assert(reactor.size() == children);
+
+        std::vector<std::string> out(children), err(children);
+        std::vector<int>         exit_codes(children, -1);
+        std::vector<int>         open_streams(children, 2);
+        process_event            events[16];
+        while(!reactor.empty()) {
+            auto n = reactor.wait(events, 5000);
+            assert(n && n.value() > 0);
+            for(size_t e = 0; e < n.value(); ++e) {
+                const process_event& ev = events[e];
+                size_t               i  = ev.user_data;
+                if(!reactor.watching(ev.id)) continue;  // Unwatched earlier in this batch
+                auto& child = procs[i];
+
+                if(ev.source == process_ready::exited) {
+                    auto status = child.wait();
+                    assert(status);
+                    exit_codes[i] = status.value();
+                } else {
+                    bool is_out = ev.source == process_ready::stdout_data;
+                    char buffer[64];
+                    for(;;) {
+                        auto got = is_out ? child.read_stdout(buffer, sizeof(buffer))
+                                          : child.read_stderr(buffer, sizeof(buffer));
+                        if(!got) {
+                            assert(got.error().code == error_code::would_block);
+                            break;
+                        }
+                        if(got.value() == 0) {
+                            reactor.unwatch(ev.id, ev.source);
+                            auto closed = is_out ? child.close_stdout() : child.close_stderr();
+                            assert(closed);
+                            --open_streams[i];
+                            break;
+                        }
+                        (is_out ? out[i] : err[i]).append(buffer, got.value());
+                    }
+                }
+                if(exit_codes[i] != -1 && open_streams[i] == 0) reactor.unwatch(ev.id);
+            }
+        }
+
+        for(int i = 0; i < children; ++i) {
+            assert(exit_codes[i] == i);
+            assert(out[i] == "out-" + codes[i] + "\n");
+            assert(err[i] == "err-" + codes[i] + "\n");
+        }
+
+        // Timeout with nothing watched
+        auto idle = reactor.wait(events, 0);
+        assert(idle && idle.value() == 0);
+        std::cout << "  PASSED\n\n";
+    }
+
+    // Test 8: Warm worker pool with framed dispatch and respawn
+    std::cout << "Test 8: Process pool\n";
+    {
+        const char* worker_args[] = { "/proc/self/exe", "--pool-worker", nullptr };
+        asyncle::io::process_pool pool({ .executable = "/proc/self/exe", .args = worker_args, .workers = 3 });
+        assert(pool.ready());
+        assert(pool.size() == 3 && pool.idle() == 3);
+
+        // Sequential calls reuse the same warm children (no spawn per call)
+        std::string reply;
+        auto        n = pool.call("hello", reply);
+        assert(n && n.value() == reply.size());
+        auto [first_pid, text] = split_reply(reply);
+        assert(text == "HELLO");
+
+        // Empty payloads and payloads larger than a pipe buffer
+        assert(pool.call("", reply));
+        assert(split_reply(reply).second.empty());
+        std::string big(256 * 1024, 'x');
+        assert(pool.call(big, reply));
+        assert(split_reply(reply).second == std::string(big.size(), 'X'));
+
+        // Concurrent callers share the workers
+        constexpr int            threads = 6;
+        constexpr int            rounds  = 50;
+        std::atomic<int>         failures { 0 };
+        std::vector<std::thread> callers;
+        for(int t = 0; t < threads; ++t) {
+            callers.emplace_back([&, t] {
+                std::string out;
+                for(int r = 0; r < rounds; ++r) {
+                    std::string msg = "t" + std::to_string(t) + "r" + std::to_string(r);
+                    std::string up  = "T" + std::to_string(t) + "R" + std::to_string(r);
+                    if(!pool.call(msg, out) || split_reply(out).second != up) ++failures;
+                }
+            });
+        }
+        for(auto& c : callers) c.join();
+        assert(failures == 0);
+        assert(pool.respawns() == 0);
+        assert(pool.idle() == 3);
+
+        // A worker that dies mid-call fails that call and is replaced
+        auto crashed = pool.call("crash", reply);
+        assert(!crashed);
+        assert(crashed.error().code == error_code::process_terminated);
+        assert(pool.respawns() == 1);
+        assert(pool.ready());
+        for(int i = 0; i < 6; ++i) {
+            assert(pool.call("after", reply));
+            assert(split_reply(reply).second == "AFTER");
+        }
+
+        pool.shutdown();
+        assert(!pool.call("late", reply));
+        std::cout << "  PASSED\n\n";
+    }
+
+    // Test 9: Pool call timeout kills and replaces the stalled worker
+    std::cout << "Test 9: Process pool timeout\n";
+    {
+        const char* worker_args[] = { "/proc/self/exe", "--pool-worker", nullptr };
+        asyncle::io::process_pool pool(
+          { .executable = "/proc/self/exe", .args = worker_args, .workers = 1, .timeout_ms = 200 });
+        assert(pool.ready());
+
+        std::string reply;
+        auto        stalled = pool.call("sleep", reply);
+        assert(!stalled);
+        assert(stalled.error().code == error_code::would_block);
+        assert(pool.respawns() == 1);
+        assert(pool.call("ok", reply));
+        assert(split_reply(reply).second == "OK");
+        std::cout << "  PASSED\n\n";
+    }
+
+    // Test 10: Shared-memory rings handed to a spawned child on both spawn paths
+    std::cout << "Test 10: Shared-memory ring\n";
+    {
+        // Descriptor slots: the child sees them as 3, 4, ...; a full table refuses more
+        spawn_request slots {};
+        assert(slots.inherit_fd(0) == 3 && slots.inherit_fd(1) == 4);
+        assert(slots.inherit_fd(2) == 5 && slots.inherit_fd(2) == 6);
+        assert(slots.inherit_fd(2) == -1);
+
+        // Futex wait returns at once when the word already moved, false on timeout
+        uint32_t word = 1;
+        assert(platform::mmap::wait_shared_word(&word, 0, 10).value());
+        assert(!platform::mmap::wait_shared_word(&word, 1, 10).value());
+
+        for(spawn_flags path : { spawn_flags::none, spawn_flags::use_fork }) {
+            asyncle::io::shm_ring requests, replies;
+            assert(requests.create(4096) && replies.create(4096));
+            assert(requests.capacity() == 4096 && requests.max_message_size() == 2040);
+
+            spawn_request req {};
+            req.executable      = "/proc/self/exe";
+            req.flags           = path;
+            auto request_fd     = std::to_string(requests.share_with(req));
+            auto reply_fd       = std::to_string(replies.share_with(req));
+            const char* args[]  = { "/proc/self/exe", "--shm-worker", request_fd.c_str(), reply_fd.c_str(), nullptr };
+            req.args            = args;
+            asyncle::io::process worker(req);
+            assert(worker.is_running());
+
+            // Many more messages than fit at once, so both sides wrap and wait
+            int received = 0;
+            for(int i = 0; i < 400; ++i) {
+                std::string msg = "message " + std::to_string(i) + std::string(static_cast<size_t>(i % 97), 'x');
+                auto        sent = requests.send(std::as_bytes(std::span<const char>(msg.data(), msg.size())), 5000);
+                assert(sent && *sent);
+                while(replies.peek().data()) {
+                    auto reply = replies.peek();
+                    std::string text(reinterpret_cast<const char*>(reply.data()), reply.size());
+                    assert(text.rfind("MESSAGE " + std::to_string(received), 0) == 0);
+                    replies.release();
+                    ++received;
+                }
+            }
+            requests.close_writing();
+            while(ring_ready(replies.wait_readable(5000))) {
+                auto reply = replies.peek();
+                std::string text(reinterpret_cast<const char*>(reply.data()), reply.size());
+                assert(text.rfind("MESSAGE " + std::to_string(received), 0) == 0);
+                replies.release();
+                ++received;
+            }
+            assert(received == 400);
+            auto status = worker.wait();
+            assert(status && status.value() == 0);
+        }
+
+        // Oversized messages are refused, a bad descriptor does not attach
+        asyncle::io::shm_ring ring;
+        assert(ring.create(4096, asyncle::io::shm_backing::anonymous));
+        assert(ring.fd() == -1);
+        std::string huge(4096, 'y');
+        assert(!ring.try_send(std::as_bytes(std::span<const char>(huge.data(), huge.size()))));
+        assert(!asyncle::io::shm_ring().attach(-1));
+
+        // A header claiming more capacity than the memory file holds does not attach
+        asyncle::io::shm_ring shared;
+        assert(shared.create(4096));
+        int      copy    = ::dup(shared.fd());
+        uint64_t claimed = uint64_t { 1 } << 30;
+        assert(::pwrite(copy, &claimed, sizeof(claimed), sizeof(uint64_t)) == sizeof(claimed));
+        assert(!asyncle::io::shm_ring().attach(copy));
+
+        // A record length past what was published closes the ring for reading
+        asyncle::io::shm_ring bad;
+        assert(bad.create(4096, asyncle::io::shm_backing::anonymous));
+        auto room = bad.prepare(16);
+        assert(room.data());
+        bad.commit(16);
+        uint32_t length = 100000;
+        std::memcpy(room.data() - sizeof(uint64_t), &length, sizeof(length));
+        assert(!bad.peek().data() && bad.reader_closed());
+        auto waited = bad.wait_readable(0);
+        assert(!waited && waited.error().code == platform::mmap::error_code::io_error);
+
+        // close_reading() wakes a producer waiting forever for room
+        asyncle::io::shm_ring full;
+        assert(full.create(4096, asyncle::io::shm_backing::anonymous));
+        std::string block(1000, 'z');
+        auto        bytes = std::as_bytes(std::span<const char>(block.data(), block.size()));
+        while(full.try_send(bytes)) {}
+        std::atomic<bool> gave_up { false };
+        std::thread       producer([&] {
+            auto sent = full.send(bytes, -1);
+            gave_up   = sent && !*sent;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        full.close_reading();
+        producer.join();
+        assert(gave_up && !full.try_send(bytes));
+        std::cout << "  PASSED\n\n";
+    }
+
     std::cout << "All tests completed successfully!\n";
     return 0;
 }
@@ -1,5 +1,9 @@
+#include <asyncle/meta/dispatch.hpp>
 #include <asyncle/meta/predicates.hpp>
+#include <array>
+#include <list>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -60,6 +64,16 @@ int main() {
     static_assert(pred_sized_range<std::vector<int>>::value);
     static_assert(pred_sized_range<std::string>::value);
 
+    static_assert(pred_range<std::list<int>>::value);
+    static_assert(pred_contig_range<std::span<const int>>::value);
+    static_assert(pred_contig_range<std::array<int, 4>>::value);
+    static_assert(pred_contig_range<const std::vector<int>&>::value);
+    static_assert(!pred_contig_range<std::list<int>>::value);
+    static_assert(pred_contig_range<int[4]>::value && pred_contig_range<int (&)[4]>::value);
+    static_assert(pred_sized_range<const int (&)[4]>::value);
+    static_assert(pred_view<std::span<int>>::value);
+    static_assert(!pred_view<std::vector<int>>::value);
+
     // Container-like predicates
     static_assert(pred_optional<std::optional<int>>::value);
     static_assert(!pred_optional<int>::value);
@@ -127,5 +141,27 @@ int main() {
     // Note: Testing non-range types causes SFINAE errors, so commenting out
     // static_assert(!range_of_ints::apply<int>::value); // not a range
 
+    // ========== Test implementation dispatch ==========
+    static_assert(dispatches_to<element_dispatch, int, trivial_copy_path>);
+    static_assert(dispatches_to<element_dispatch, const MyClass&, trivial_copy_path>);
+    static_assert(dispatches_to<element_dispatch, std::string, move_path>);
+
+    static_assert(dispatches_to<range_dispatch, std::span<const int>, contiguous_path>);
+    static_assert(dispatches_to<range_dispatch, std::vector<int>&, contiguous_path>);
+    static_assert(dispatches_to<range_dispatch, std::list<int>, generic_path>);
+    static_assert(!range_dispatch::handles<int>);
+    static_assert(std::same_as<dispatch_path_t<range_dispatch, int>, void>);
+
+    static_assert(bulk_copyable_range<std::vector<MyClass>>);
+    static_assert(!bulk_copyable_range<std::vector<std::string>>);
+    static_assert(!bulk_copyable_range<std::list<int>>);
+    static_assert(!bulk_copyable_range<int>);
+
+    // Custom policies take any entry kind; the first match wins
+    using custom = dispatch_by<type_map<bool, move_path>, pred_map<pred_integral, trivial_copy_path>>;
+    static_assert(dispatches_to<custom, bool, move_path>);
+    static_assert(dispatches_to<custom, long, trivial_copy_path>);
+    static_assert(!custom::handles<double>);
+
     return 0;
 }